@@ -77,6 +77,8 @@ typedef struct Refresh_ComputePipeline Refresh_ComputePipeline;
 typedef struct Refresh_GraphicsPipeline Refresh_GraphicsPipeline;
 typedef struct Refresh_CommandBuffer Refresh_CommandBuffer;
 typedef struct Refresh_Fence Refresh_Fence;
+typedef struct Refresh_UploadRegion Refresh_UploadRegion;
+typedef struct Refresh_Readback Refresh_Readback;
 
 typedef enum Refresh_PresentMode
 {
@@ -152,15 +154,38 @@ typedef enum Refresh_TextureFormat
 	REFRESH_TEXTUREFORMAT_D16_UNORM,
 	REFRESH_TEXTUREFORMAT_D32_SFLOAT,
 	REFRESH_TEXTUREFORMAT_D16_UNORM_S8_UINT,
-	REFRESH_TEXTUREFORMAT_D32_SFLOAT_S8_UINT
+	REFRESH_TEXTUREFORMAT_D32_SFLOAT_S8_UINT,
+	/* Multi-planar Y'CbCr Formats, see Refresh_SupportsYCbCrFormat */
+	REFRESH_TEXTUREFORMAT_G8_B8_R8_3PLANE_420,
+	REFRESH_TEXTUREFORMAT_G8_B8R8_2PLANE_420
 } Refresh_TextureFormat;
 
+/* REFRESH_TEXTUREUSAGE_TRANSIENT_BIT and REFRESH_BUFFERUSAGE_TRANSIENT_BIT:
+ * Transient buffers and textures are bump allocated out of a ring of memory
+ * blocks instead of the general purpose allocator, and are never defragmented.
+ * A block is recycled once every transient resource in it has been destroyed,
+ * so these should be queued for destroy within a frame or so of creation.
+ * A long-lived transient resource keeps its whole block from being reused.
+ * Transient render targets, including their multisample images, share these
+ * blocks too. Empty blocks are released like other empty memory.
+ *
+ * REFRESH_TEXTUREUSAGE_LAZILY_ALLOCATED_BIT:
+ * For render targets whose contents never leave the render pass, i.e. depth
+ * buffers and multisample color targets that are only used with
+ * REFRESH_STOREOP_DONT_CARE. On tiled GPUs such textures may never get backing
+ * memory at all. For a multisample color texture only the hidden multisample
+ * image is affected, the resolve texture is allocated as usual. Otherwise the
+ * texture can only be used as a render pass attachment, and the flag is ignored
+ * when it is combined with SAMPLER or COMPUTE.
+ */
 typedef enum Refresh_TextureUsageFlagBits
 {
 	REFRESH_TEXTUREUSAGE_SAMPLER_BIT              = 0x00000001,
 	REFRESH_TEXTUREUSAGE_COLOR_TARGET_BIT         = 0x00000002,
 	REFRESH_TEXTUREUSAGE_DEPTH_STENCIL_TARGET_BIT = 0x00000004,
-	REFRESH_TEXTUREUSAGE_COMPUTE_BIT              = 0X00000008
+	REFRESH_TEXTUREUSAGE_COMPUTE_BIT              = 0X00000008,
+	REFRESH_TEXTUREUSAGE_TRANSIENT_BIT            = 0x00000010,
+	REFRESH_TEXTUREUSAGE_LAZILY_ALLOCATED_BIT     = 0x00000020
 } Refresh_TextureUsageFlagBits;
 
 typedef uint32_t Refresh_TextureUsageFlags;
@@ -183,12 +208,35 @@ typedef enum Refresh_CubeMapFace
 	REFRESH_CUBEMAPFACE_NEGATIVEZ
 } Refresh_CubeMapFace;
 
+/* REFRESH_BUFFERUSAGE_SUBALLOCATE_BIT:
+ * Buffers of 64KB or less with this bit are carved out of large shared buffers
+ * instead of getting their own, which makes creating thousands of small buffers cheap.
+ * Sizes are rounded up to a power of two of at least 256 bytes.
+ * Ignored for transient buffers and larger sizes.
+ *
+ * REFRESH_BUFFERUSAGE_DYNAMIC_BIT:
+ * For data rewritten by the CPU every frame, like streamed vertices or instance data.
+ * The buffer lives in host-visible memory, preferably device-local, and is written
+ * through the pointer returned by Refresh_MapDynamicBuffer instead of SetBufferData,
+ * so no staging copy or barriers are recorded. Overrides TRANSIENT and SUBALLOCATE.
+ *
+ * REFRESH_BUFFERUSAGE_READBACK_BIT:
+ * For buffers the CPU reads with Refresh_GetBufferData. The buffer lives in
+ * host-cached memory when the device has it, which CPUs read many times faster
+ * than the write-combined memory host-visible buffers otherwise get.
+ * Overrides TRANSIENT and SUBALLOCATE. Combined with DYNAMIC the buffer stays in
+ * host-coherent memory, which is only cached if the device has such a type.
+ */
 typedef enum Refresh_BufferUsageFlagBits
 {
 	REFRESH_BUFFERUSAGE_VERTEX_BIT 	 = 0x00000001,
 	REFRESH_BUFFERUSAGE_INDEX_BIT  	 = 0x00000002,
 	REFRESH_BUFFERUSAGE_COMPUTE_BIT  = 0x00000004,
-	REFRESH_BUFFERUSAGE_INDIRECT_BIT = 0x00000008
+	REFRESH_BUFFERUSAGE_INDIRECT_BIT = 0x00000008,
+	REFRESH_BUFFERUSAGE_TRANSIENT_BIT = 0x00000010,
+	REFRESH_BUFFERUSAGE_SUBALLOCATE_BIT = 0x00000020,
+	REFRESH_BUFFERUSAGE_DYNAMIC_BIT = 0x00000040,
+	REFRESH_BUFFERUSAGE_READBACK_BIT = 0x00000080
 } Refresh_BufferUsageFlagBits;
 
 typedef uint32_t Refresh_BufferUsageFlags;
@@ -377,6 +425,55 @@ typedef struct Refresh_TextureSlice
 	uint32_t level;
 } Refresh_TextureSlice;
 
+typedef struct Refresh_BufferCopy
+{
+	uint32_t sourceOffset;
+	uint32_t destinationOffset;
+	uint32_t size;
+} Refresh_BufferCopy;
+
+typedef struct Refresh_BufferImageCopy
+{
+	uint32_t bufferOffset;
+	uint32_t bufferRowLength; /* in texels, 0 if rows are tightly packed */
+	Refresh_TextureSlice textureSlice;
+} Refresh_BufferImageCopy;
+
+typedef struct Refresh_DefragmentationProgress
+{
+	uint8_t inProgress; /* 1 while a memory block is being emptied */
+	uint64_t bytesRemaining; /* left to move out of the current block */
+	uint32_t resourcesRemaining;
+	uint64_t totalBytesMoved; /* since device creation */
+	uint32_t totalResourcesMoved;
+} Refresh_DefragmentationProgress;
+
+typedef struct Refresh_MemoryHeapBudget
+{
+	uint64_t budget; /* how much the process can use before the driver starts paging */
+	uint64_t usage; /* current usage by the process */
+	uint64_t size;
+	uint8_t isDeviceLocal;
+} Refresh_MemoryHeapBudget;
+
+typedef struct Refresh_MemoryTypeStatistics
+{
+	uint32_t heapIndex;
+	uint8_t isDeviceLocal;
+	uint8_t isHostVisible;
+	uint32_t blockCount; /* memory objects, including dedicated and transient blocks */
+	uint32_t dedicatedBlockCount;
+	uint32_t transientBlockCount;
+	uint64_t blockBytes;
+	uint64_t usedBytes;
+	uint64_t freeBytes;
+	uint64_t largestFreeRegion; /* much smaller than freeBytes means fragmented */
+	uint32_t usedRegionCount;
+	uint32_t freeRegionCount;
+	uint64_t defragBytesMoved; /* since device creation */
+	uint32_t defragResourcesMoved;
+} Refresh_MemoryTypeStatistics;
+
 typedef struct Refresh_IndirectDrawCommand
 {
 	uint32_t vertexCount;
@@ -469,6 +566,13 @@ typedef struct Refresh_TextureCreateInfo
 	Refresh_TextureUsageFlags usageFlags;
 } Refresh_TextureCreateInfo;
 
+typedef struct Refresh_AliasedTextureCreateInfo
+{
+	Refresh_TextureCreateInfo textureCreateInfo;
+	uint32_t firstUse; /* index of the first pass in the frame that uses the texture */
+	uint32_t lastUse; /* index of the last pass, inclusive */
+} Refresh_AliasedTextureCreateInfo;
+
 /* Pipeline state structures */
 
 typedef struct Refresh_GraphicsShaderInfo
@@ -543,6 +647,13 @@ typedef struct Refresh_GraphicsPipelineCreateInfo
 	Refresh_DepthStencilState depthStencilState;
 	Refresh_GraphicsPipelineAttachmentInfo attachmentInfo;
 	float blendConstants[4];
+	/* Bit N marks fragment sampler binding N as sampling a multi-planar
+	 * texture of fragmentYCbCrFormat. Such bindings get the device's
+	 * Y'CbCr conversion sampler baked into the pipeline, so shaders read
+	 * RGB from them directly. Leave the mask at 0 otherwise.
+	 */
+	uint32_t fragmentYCbCrSamplerMask;
+	Refresh_TextureFormat fragmentYCbCrFormat;
 } Refresh_GraphicsPipelineCreateInfo;
 
 /* Render pass structures */
@@ -745,6 +856,42 @@ REFRESHAPI Refresh_Texture* Refresh_CreateTexture(
 	Refresh_TextureCreateInfo *textureCreateInfo
 );
 
+/* Returns 1 if textures of the given multi-planar Y'CbCr format can be
+ * created and sampled with conversion to RGB. This needs
+ * VK_KHR_sampler_ycbcr_conversion, or its equivalent on other backends.
+ * When it returns 0, upload the planes to three R8 textures instead.
+ *
+ * Multi-planar textures are 2D, have a single level, even dimensions, and
+ * REFRESH_TEXTUREUSAGE_SAMPLER_BIT as their only usage. They are filled with
+ * SetTextureDataYUV and converted as BT.601 narrow range when sampled.
+ */
+REFRESHAPI uint8_t Refresh_SupportsYCbCrFormat(
+	Refresh_Device *device,
+	Refresh_TextureFormat format
+);
+
+/* Creates a set of textures that share memory. Textures whose
+ * [firstUse, lastUse] intervals don't overlap may be placed in the same
+ * memory range, so each frame's intermediate render targets can fit in
+ * a fraction of the memory they would need on their own.
+ *
+ * Pass indices are yours to define, they only need to be consistent
+ * within the set. The contents of an aliased texture are lost outside
+ * its interval, so the first use in each frame must be a render pass
+ * that clears or doesn't care about the previous contents.
+ * Multisample color textures only alias their resolve texture.
+ *
+ * createInfos:     An array of createInfoCount texture descriptions.
+ * createInfoCount: The number of textures to create.
+ * pTextures:       An array of createInfoCount textures that will be filled in.
+ */
+REFRESHAPI void Refresh_CreateAliasedTextures(
+	Refresh_Device *device,
+	Refresh_AliasedTextureCreateInfo *createInfos,
+	uint32_t createInfoCount,
+	Refresh_Texture **pTextures
+);
+
 /* Creates a buffer.
  *
  * usageFlags:	Specifies how the buffer will be used.
@@ -777,9 +924,64 @@ REFRESHAPI void Refresh_SetTextureData(
 	uint32_t dataLengthInBytes
 );
 
-/* Uploads YUV image data to three R8 texture objects.
+/* Uploads a region of a larger client image to a texture object, reading
+ * rows at the client's pitch so padded or atlas-sized source images do not
+ * need to be repacked first.
+ *
+ * NOTE:
+ *	The same ordering caveats as SetTextureData apply.
+ *	For block compressed formats, positions and pitch are in whole blocks.
+ *
+ * 	textureSlice:		The texture slice to be updated. Its rectangle size is the size of the region.
+ * 	data:				A pointer to the first row of the client image.
+ * 	dataLengthInBytes:	The size of the client image data.
+ * 	sourceX:			The left edge of the region in the client image, in texels.
+ * 	sourceY:			The top edge of the region in the client image, in texels.
+ * 	rowPitchInBytes:	The distance between the starts of two client image rows.
+ */
+REFRESHAPI void Refresh_SetTextureDataPitched(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlice,
+	void *data,
+	uint32_t dataLengthInBytes,
+	uint32_t sourceX,
+	uint32_t sourceY,
+	uint32_t rowPitchInBytes
+);
+
+/* Uploads image data to many texture slices at once, for example every
+ * level and face of a cube map. Consecutive slices of the same texture are
+ * staged together and copied with a single transition in and out of the
+ * transfer layout, which is much cheaper than one SetTextureData per slice.
+ *
+ * NOTE:
+ *	The same ordering caveats as SetTextureData apply.
+ *
+ * 	textureSlices:		An array of texture slices to be updated.
+ * 	pData:				An array of pointers to the image data of each slice.
+ * 	pDataLengthsInBytes:	An array of the image data sizes of each slice.
+ * 	sliceCount:			The number of slices.
+ */
+REFRESHAPI void Refresh_SetTextureDataBatch(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlices,
+	void **pData,
+	uint32_t *pDataLengthsInBytes,
+	uint32_t sliceCount
+);
+
+/* Uploads YUV image data to three R8 texture objects, or to a single
+ * multi-planar texture. The planes are staged together and share one
+ * transition in and out of the transfer layout.
  *
- * y:            The texture storing the Y data.
+ * With R8 textures color conversion is up to your shaders. If y is a
+ * multi-planar texture, all planes go to it and u and v are ignored. For
+ * REFRESH_TEXTUREFORMAT_G8_B8R8_2PLANE_420, uData holds interleaved CbCr
+ * samples, so its rows are twice as long, and vData is ignored.
+ *
+ * y:            The texture storing the Y data, or the multi-planar texture.
  * u:            The texture storing the U (Cb) data.
  * v:            The texture storing the V (Cr) data.
  * yWidth:       The width of the Y plane.
@@ -843,6 +1045,45 @@ REFRESHAPI void Refresh_CopyTextureToBuffer(
 	Refresh_Buffer *buffer
 );
 
+/* Copies regions of one buffer into another on the GPU, for example to
+ * move compute output into a vertex buffer without a CPU round-trip.
+ *
+ * NOTE:
+ * 	Must be recorded on a graphics command buffer, outside of a render pass.
+ * 	Source and destination may be the same buffer if the regions do not overlap.
+ *
+ * source:			The buffer to copy from.
+ * destination:		The buffer to copy into.
+ * regions:			An array of byte ranges to copy.
+ * regionCount:		The number of regions.
+ */
+REFRESHAPI void Refresh_CopyBufferToBuffer(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *source,
+	Refresh_Buffer *destination,
+	Refresh_BufferCopy *regions,
+	uint32_t regionCount
+);
+
+/* Copies image data from a buffer into texture slices on the GPU.
+ *
+ * NOTE:
+ * 	Must be recorded on a graphics command buffer, outside of a render pass.
+ * 	Each bufferOffset must be a multiple of the texture format's block size in bytes.
+ *
+ * buffer:			The buffer holding the image data.
+ * regions:			An array of buffer ranges and the texture slices they fill.
+ * regionCount:		The number of regions.
+ */
+REFRESHAPI void Refresh_CopyBufferToTexture(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	Refresh_BufferImageCopy *regions,
+	uint32_t regionCount
+);
+
 /* Sets a region of the buffer with client data.
  *
  * NOTE:
@@ -863,12 +1104,58 @@ REFRESHAPI void Refresh_SetBufferData(
 	uint32_t dataLength
 );
 
+/* Reserves staging memory that the client can write into directly,
+ * avoiding the copy that Refresh_SetBufferData/Refresh_SetTextureData make.
+ * Commit the region to copy it into a buffer or texture.
+ *
+ * NOTE:
+ * 	The region belongs to the command buffer. The pointer and the
+ * 	region are invalid once the command buffer is submitted.
+ * 	The memory is write-combined, write it sequentially and do not read from it.
+ *
+ * sizeInBytes:	The number of bytes to reserve.
+ * pRegion:		Filled with a handle to pass to a commit function.
+ *
+ * Returns a writable pointer, or NULL on failure.
+ */
+REFRESHAPI void* Refresh_MapUploadRegion(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	uint32_t sizeInBytes,
+	Refresh_UploadRegion **pRegion
+);
+
+/* Copies the whole contents of an upload region into a buffer.
+ *
+ * offsetInBytes:	The starting offset of the buffer to write into.
+ */
+REFRESHAPI void Refresh_CommitUploadRegionToBuffer(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_UploadRegion *region,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes
+);
+
+/* Copies an upload region into a texture slice.
+ * The region must hold tightly packed texels, as for Refresh_SetTextureData.
+ */
+REFRESHAPI void Refresh_CommitUploadRegionToTexture(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_UploadRegion *region,
+	Refresh_TextureSlice *textureSlice
+);
+
 /* Pushes vertex shader params to the device.
  * Returns a starting offset value to be used with draw calls.
  *
  * NOTE:
  * 		A pipeline must be bound.
  * 		Will use the block size of the currently bound vertex shader.
+ * 		If the shader declares its block as push_constant, the data is
+ * 		recorded directly into the command buffer and 0 is returned.
+ * 		A vertex push_constant block may be at most 64 bytes.
  *
  * data: 				The client data to write into the buffer.
  * dataLengthInBytes: 	The length of the data to write.
@@ -886,6 +1173,11 @@ REFRESHAPI uint32_t Refresh_PushVertexShaderUniforms(
  * NOTE:
  * 		A graphics pipeline must be bound.
  * 		Will use the block size of the currently bound fragment shader.
+ * 		If the shader declares its block as push_constant, the data is
+ * 		recorded directly into the command buffer and 0 is returned.
+ * 		A fragment push_constant block always starts at byte 64, after
+ * 		the space reserved for the vertex block, so its first member must
+ * 		use layout(offset = 64).
  *
  * data: 				The client data to write into the buffer.
  * dataLengthInBytes: 	The length of the data to write.
@@ -930,6 +1222,90 @@ REFRESHAPI void Refresh_GetBufferData(
 	uint32_t dataLengthInBytes
 );
 
+/* Returns the persistently mapped memory of a buffer created with
+ * REFRESH_BUFFERUSAGE_DYNAMIC_BIT. There is no unmap call.
+ * Returns NULL for any other buffer.
+ *
+ * If cycle is nonzero and a command buffer still references the buffer,
+ * the buffer is first switched to another copy of its memory that the GPU is
+ * done with, so the new data never overwrites what in-flight work is reading.
+ * The previous contents are not carried over when this happens.
+ * If cycle is zero, you must not overwrite data the GPU is still reading.
+ *
+ * The pointer stays valid until the next cycling map or the buffer is destroyed.
+ *
+ * buffer:	The dynamic buffer to map.
+ * cycle:	Whether the buffer may be switched to unused memory first.
+ */
+REFRESHAPI void* Refresh_MapDynamicBuffer(
+	Refresh_Device *device,
+	Refresh_Buffer *buffer,
+	uint8_t cycle
+);
+
+/* Records a copy of a buffer range into readback memory.
+ * Returns a ticket that can be polled or waited on after the command buffer
+ * is submitted, so results can be picked up frames later without stalling.
+ * Returns NULL on failure.
+ *
+ * NOTE:
+ * 	Must be recorded on a command buffer from AcquireCommandBuffer.
+ *
+ * buffer:			The buffer to read from.
+ * offsetInBytes:	The starting offset of the range to read.
+ * sizeInBytes:		The size of the range to read.
+ */
+REFRESHAPI Refresh_Readback* Refresh_DownloadBuffer(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t sizeInBytes
+);
+
+/* Records a copy of a texture slice into readback memory.
+ * Works like DownloadBuffer. The data is tightly packed.
+ *
+ * textureSlice: The texture slice to read from.
+ */
+REFRESHAPI Refresh_Readback* Refresh_DownloadTexture(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlice
+);
+
+/* Check the status of a readback. 1 means the data is ready. */
+REFRESHAPI int Refresh_QueryReadback(
+	Refresh_Device *device,
+	Refresh_Readback *readback
+);
+
+/* Blocks until the data of a readback is ready.
+ * The command buffer it was recorded on must have been submitted.
+ */
+REFRESHAPI void Refresh_WaitForReadback(
+	Refresh_Device *device,
+	Refresh_Readback *readback
+);
+
+/* Returns a pointer to the data of a readback.
+ * Call this once the readback is ready, the contents are not valid before.
+ * The pointer is valid until the readback is released.
+ */
+REFRESHAPI void* Refresh_GetReadbackData(
+	Refresh_Device *device,
+	Refresh_Readback *readback
+);
+
+/* Returns the readback memory to the renderer.
+ * Release readbacks promptly, a readback that is held onto keeps
+ * the readback memory after it from being reused.
+ */
+REFRESHAPI void Refresh_ReleaseReadback(
+	Refresh_Device *device,
+	Refresh_Readback *readback
+);
+
 /* Disposal */
 
 /* Sends a texture to be destroyed by the renderer. Note that we call it
@@ -1092,6 +1468,8 @@ REFRESHAPI void Refresh_BindVertexSamplers(
  * NOTE:
  *		The length of the passed arrays must be equal to the number
  * 		of sampler bindings specified by the pipeline.
+ *		Bindings in the pipeline's fragmentYCbCrSamplerMask take a
+ *		multi-planar texture, and their sampler entry may be NULL.
  *
  * textures: 	A pointer to an array of textures.
  * samplers:	A pointer to an array of samplers.
@@ -1184,6 +1562,28 @@ REFRESHAPI Refresh_CommandBuffer* Refresh_AcquireCommandBuffer(
 	Refresh_Device *device
 );
 
+/* Returns a command buffer for asynchronous uploads.
+ * It is submitted to a transfer-only queue when the device has one,
+ * so large uploads can run while rendering continues.
+ * Only Refresh_SetTextureData, Refresh_SetTextureDataYUV and
+ * Refresh_SetBufferData may be recorded into it.
+ *
+ * Submit it as usual. Uploaded resources become available to command
+ * buffers acquired with Refresh_AcquireCommandBuffer after the submit,
+ * which wait for the transfer on the GPU.
+ *
+ * NOTE:
+ * 	Textures and buffers that have already been used by other command
+ * 	buffers are handed over from the graphics queue when this is submitted,
+ * 	after all work submitted before it, so their other contents are kept.
+ * 	They must not be used by command buffers that are submitted later but
+ * 	were recorded before this one is submitted.
+ * 	The same threading rules as Refresh_AcquireCommandBuffer apply.
+ */
+REFRESHAPI Refresh_CommandBuffer* Refresh_AcquireTransferCommandBuffer(
+	Refresh_Device *device
+);
+
 /* Acquires a texture to use for presentation.
  * May return NULL under certain conditions.
  * If NULL, the user must ensure to not use the texture.
@@ -1251,6 +1651,134 @@ REFRESHAPI void Refresh_ReleaseFence(
 	Refresh_Fence *fence
 );
 
+/* Memory Management */
+
+/* Limits how much work memory defragmentation may do per submission.
+ * Defragmentation moves resources out of one memory block at a time
+ * and resumes on the next submission until the block is empty.
+ * At least one resource is always moved per submission.
+ *
+ * maxBytesPerSubmit:     The maximum number of bytes copied per submission. 0 means unlimited.
+ * maxResourcesPerSubmit: The maximum number of resources moved per submission. 0 means unlimited.
+ */
+REFRESHAPI void Refresh_SetDefragmentationBudget(
+	Refresh_Device *device,
+	uint64_t maxBytesPerSubmit,
+	uint32_t maxResourcesPerSubmit
+);
+
+/* Fills in the current state of memory defragmentation.
+ *
+ * progress: A pointer to a struct that will be filled in.
+ */
+REFRESHAPI void Refresh_GetDefragmentationProgress(
+	Refresh_Device *device,
+	Refresh_DefragmentationProgress *progress
+);
+
+/* Queries the memory budget of each memory heap.
+ * Uses VK_EXT_memory_budget when available, otherwise
+ * the budget is estimated from the heap size and Refresh's own allocations.
+ *
+ * heapBudgets:     An array that will be filled in, may be NULL.
+ * heapBudgetCount: The number of elements in heapBudgets.
+ *
+ * Returns the number of memory heaps on the device.
+ */
+REFRESHAPI uint32_t Refresh_GetMemoryBudget(
+	Refresh_Device *device,
+	Refresh_MemoryHeapBudget *heapBudgets,
+	uint32_t heapBudgetCount
+);
+
+/* pressureLevel is the number of thresholds that usage is at or above,
+ * so 0 means usage has dropped below every threshold.
+ */
+typedef void (REFRESHCALL * Refresh_MemoryPressureFunc)(
+	uint32_t heapIndex,
+	uint32_t pressureLevel,
+	uint64_t usage,
+	uint64_t budget,
+	void *userdata
+);
+
+/* Sets a callback that is invoked when the usage of a memory heap
+ * crosses one of the given thresholds, in either direction.
+ * Budgets are checked during Refresh_Submit and the callback
+ * is invoked from the submitting thread once the submission is done,
+ * so it may destroy resources or wait on threads that submit.
+ *
+ * callback:       The function to call, NULL to disable.
+ * thresholds:     Fractions of the heap budget in ascending order, i.e. 0.75f, 0.9f.
+ * thresholdCount: The number of thresholds. At most 8 are used.
+ * userdata:       Passed to the callback.
+ */
+REFRESHAPI void Refresh_SetMemoryPressureCallback(
+	Refresh_Device *device,
+	Refresh_MemoryPressureFunc callback,
+	const float *thresholds,
+	uint32_t thresholdCount,
+	void *userdata
+);
+
+/* Keeps empty memory blocks around for reuse instead of freeing them
+ * as soon as their last resource is destroyed, which avoids reallocating
+ * whole blocks when usage dips for a few frames.
+ * Retained blocks are always released when their heap goes over budget.
+ *
+ * maxRetainedBlocks:        Empty blocks kept per memory type. 0 frees every empty block, the default.
+ * releaseAfterSubmits:      Release a retained block once it has been empty for this many submissions. 0 means no limit.
+ * releaseAfterMilliseconds: Release a retained block once it has been empty for this long. 0 means no limit.
+ */
+REFRESHAPI void Refresh_SetMemoryRetentionPolicy(
+	Refresh_Device *device,
+	uint32_t maxRetainedBlocks,
+	uint32_t releaseAfterSubmits,
+	uint32_t releaseAfterMilliseconds
+);
+
+/* Gathers allocator statistics for each memory type.
+ *
+ * statistics:      An array that will be filled in, may be NULL.
+ * statisticsCount: The number of elements in statistics.
+ *
+ * Returns the number of memory types on the device.
+ */
+REFRESHAPI uint32_t Refresh_GetMemoryStatistics(
+	Refresh_Device *device,
+	Refresh_MemoryTypeStatistics *statistics,
+	uint32_t statisticsCount
+);
+
+/* Builds a JSON document describing every memory block
+ * and all of its used and free regions.
+ *
+ * Be sure to free the string with Refresh_FreeMemoryStatisticsString after use!
+ *
+ * Returns a null-terminated string, or NULL on failure.
+ */
+REFRESHAPI char* Refresh_BuildMemoryStatisticsString(
+	Refresh_Device *device
+);
+
+/* Frees a string returned by Refresh_BuildMemoryStatisticsString. */
+REFRESHAPI void Refresh_FreeMemoryStatisticsString(
+	char *string
+);
+
+/* Sets the size of the persistently mapped ring that SetData calls
+ * stage their uploads in. The ring is reused frame to frame, so uploads
+ * only fall back to separate transfer buffers when it is full or an
+ * upload is larger than the whole ring.
+ * The new size takes effect once all work using the old ring completes.
+ *
+ * sizeInBytes: The ring size. 0 disables the ring. The default is 32MB.
+ */
+REFRESHAPI void Refresh_SetUploadRingSize(
+	Refresh_Device *device,
+	uint32_t sizeInBytes
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
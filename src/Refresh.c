@@ -398,6 +398,32 @@ Refresh_Texture* Refresh_CreateTexture(
 	);
 }
 
+uint8_t Refresh_SupportsYCbCrFormat(
+	Refresh_Device *device,
+	Refresh_TextureFormat format
+) {
+	if (device == NULL) { return 0; }
+	return device->SupportsYCbCrFormat(
+		device->driverData,
+		format
+	);
+}
+
+void Refresh_CreateAliasedTextures(
+	Refresh_Device *device,
+	Refresh_AliasedTextureCreateInfo *createInfos,
+	uint32_t createInfoCount,
+	Refresh_Texture **pTextures
+) {
+	NULL_RETURN(device);
+	device->CreateAliasedTextures(
+		device->driverData,
+		createInfos,
+		createInfoCount,
+		pTextures
+	);
+}
+
 Refresh_Buffer* Refresh_CreateBuffer(
 	Refresh_Device *device,
 	Refresh_BufferUsageFlags usageFlags,
@@ -428,6 +454,48 @@ void Refresh_SetTextureData(
 	);
 }
 
+void Refresh_SetTextureDataPitched(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlice,
+	void *data,
+	uint32_t dataLengthInBytes,
+	uint32_t sourceX,
+	uint32_t sourceY,
+	uint32_t rowPitchInBytes
+) {
+	NULL_RETURN(device);
+	device->SetTextureDataPitched(
+		device->driverData,
+		commandBuffer,
+		textureSlice,
+		data,
+		dataLengthInBytes,
+		sourceX,
+		sourceY,
+		rowPitchInBytes
+	);
+}
+
+void Refresh_SetTextureDataBatch(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlices,
+	void **pData,
+	uint32_t *pDataLengthsInBytes,
+	uint32_t sliceCount
+) {
+	NULL_RETURN(device);
+	device->SetTextureDataBatch(
+		device->driverData,
+		commandBuffer,
+		textureSlices,
+		pData,
+		pDataLengthsInBytes,
+		sliceCount
+	);
+}
+
 void Refresh_SetTextureDataYUV(
 	Refresh_Device *device,
 	Refresh_CommandBuffer* commandBuffer,
@@ -499,6 +567,42 @@ void Refresh_CopyTextureToBuffer(
 	);
 }
 
+void Refresh_CopyBufferToBuffer(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *source,
+	Refresh_Buffer *destination,
+	Refresh_BufferCopy *regions,
+	uint32_t regionCount
+) {
+	NULL_RETURN(device);
+	device->CopyBufferToBuffer(
+		device->driverData,
+		commandBuffer,
+		source,
+		destination,
+		regions,
+		regionCount
+	);
+}
+
+void Refresh_CopyBufferToTexture(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	Refresh_BufferImageCopy *regions,
+	uint32_t regionCount
+) {
+	NULL_RETURN(device);
+	device->CopyBufferToTexture(
+		device->driverData,
+		commandBuffer,
+		buffer,
+		regions,
+		regionCount
+	);
+}
+
 void Refresh_SetBufferData(
 	Refresh_Device *device,
 	Refresh_CommandBuffer *commandBuffer,
@@ -518,6 +622,53 @@ void Refresh_SetBufferData(
 	);
 }
 
+void* Refresh_MapUploadRegion(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	uint32_t sizeInBytes,
+	Refresh_UploadRegion **pRegion
+) {
+	NULL_RETURN_NULL(device);
+	return device->MapUploadRegion(
+		device->driverData,
+		commandBuffer,
+		sizeInBytes,
+		pRegion
+	);
+}
+
+void Refresh_CommitUploadRegionToBuffer(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_UploadRegion *region,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes
+) {
+	NULL_RETURN(device);
+	device->CommitUploadRegionToBuffer(
+		device->driverData,
+		commandBuffer,
+		region,
+		buffer,
+		offsetInBytes
+	);
+}
+
+void Refresh_CommitUploadRegionToTexture(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_UploadRegion *region,
+	Refresh_TextureSlice *textureSlice
+) {
+	NULL_RETURN(device);
+	device->CommitUploadRegionToTexture(
+		device->driverData,
+		commandBuffer,
+		region,
+		textureSlice
+	);
+}
+
 uint32_t Refresh_PushVertexShaderUniforms(
 	Refresh_Device *device,
 	Refresh_CommandBuffer *commandBuffer,
@@ -608,6 +759,96 @@ void Refresh_GetBufferData(
 	);
 }
 
+void* Refresh_MapDynamicBuffer(
+	Refresh_Device *device,
+	Refresh_Buffer *buffer,
+	uint8_t cycle
+) {
+	NULL_RETURN_NULL(device);
+	return device->MapDynamicBuffer(
+		device->driverData,
+		buffer,
+		cycle
+	);
+}
+
+Refresh_Readback* Refresh_DownloadBuffer(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t sizeInBytes
+) {
+	NULL_RETURN_NULL(device);
+	return device->DownloadBuffer(
+		device->driverData,
+		commandBuffer,
+		buffer,
+		offsetInBytes,
+		sizeInBytes
+	);
+}
+
+Refresh_Readback* Refresh_DownloadTexture(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlice
+) {
+	NULL_RETURN_NULL(device);
+	return device->DownloadTexture(
+		device->driverData,
+		commandBuffer,
+		textureSlice
+	);
+}
+
+int Refresh_QueryReadback(
+	Refresh_Device *device,
+	Refresh_Readback *readback
+) {
+	if (device == NULL) {
+		return 0;
+	}
+
+	return device->QueryReadback(
+		device->driverData,
+		readback
+	);
+}
+
+void Refresh_WaitForReadback(
+	Refresh_Device *device,
+	Refresh_Readback *readback
+) {
+	NULL_RETURN(device);
+	device->WaitForReadback(
+		device->driverData,
+		readback
+	);
+}
+
+void* Refresh_GetReadbackData(
+	Refresh_Device *device,
+	Refresh_Readback *readback
+) {
+	NULL_RETURN_NULL(device);
+	return device->GetReadbackData(
+		device->driverData,
+		readback
+	);
+}
+
+void Refresh_ReleaseReadback(
+	Refresh_Device *device,
+	Refresh_Readback *readback
+) {
+	NULL_RETURN(device);
+	device->ReleaseReadback(
+		device->driverData,
+		readback
+	);
+}
+
 void Refresh_QueueDestroyTexture(
 	Refresh_Device *device,
 	Refresh_Texture *texture
@@ -849,6 +1090,15 @@ Refresh_CommandBuffer* Refresh_AcquireCommandBuffer(
 	);
 }
 
+Refresh_CommandBuffer* Refresh_AcquireTransferCommandBuffer(
+	Refresh_Device *device
+) {
+	NULL_RETURN_NULL(device);
+	return device->AcquireTransferCommandBuffer(
+		device->driverData
+	);
+}
+
 Refresh_Texture* Refresh_AcquireSwapchainTexture(
 	Refresh_Device *device,
 	Refresh_CommandBuffer *commandBuffer,
@@ -961,4 +1211,121 @@ void Refresh_ReleaseFence(
 	);
 }
 
+void Refresh_SetDefragmentationBudget(
+	Refresh_Device *device,
+	uint64_t maxBytesPerSubmit,
+	uint32_t maxResourcesPerSubmit
+) {
+	NULL_RETURN(device);
+	device->SetDefragmentationBudget(
+		device->driverData,
+		maxBytesPerSubmit,
+		maxResourcesPerSubmit
+	);
+}
+
+void Refresh_GetDefragmentationProgress(
+	Refresh_Device *device,
+	Refresh_DefragmentationProgress *progress
+) {
+	NULL_RETURN(device);
+	device->GetDefragmentationProgress(
+		device->driverData,
+		progress
+	);
+}
+
+uint32_t Refresh_GetMemoryBudget(
+	Refresh_Device *device,
+	Refresh_MemoryHeapBudget *heapBudgets,
+	uint32_t heapBudgetCount
+) {
+	if (device == NULL) {
+		return 0;
+	}
+
+	return device->GetMemoryBudget(
+		device->driverData,
+		heapBudgets,
+		heapBudgetCount
+	);
+}
+
+void Refresh_SetMemoryPressureCallback(
+	Refresh_Device *device,
+	Refresh_MemoryPressureFunc callback,
+	const float *thresholds,
+	uint32_t thresholdCount,
+	void *userdata
+) {
+	NULL_RETURN(device);
+	device->SetMemoryPressureCallback(
+		device->driverData,
+		callback,
+		thresholds,
+		thresholdCount,
+		userdata
+	);
+}
+
+void Refresh_SetMemoryRetentionPolicy(
+	Refresh_Device *device,
+	uint32_t maxRetainedBlocks,
+	uint32_t releaseAfterSubmits,
+	uint32_t releaseAfterMilliseconds
+) {
+	NULL_RETURN(device);
+	device->SetMemoryRetentionPolicy(
+		device->driverData,
+		maxRetainedBlocks,
+		releaseAfterSubmits,
+		releaseAfterMilliseconds
+	);
+}
+
+uint32_t Refresh_GetMemoryStatistics(
+	Refresh_Device *device,
+	Refresh_MemoryTypeStatistics *statistics,
+	uint32_t statisticsCount
+) {
+	if (device == NULL) {
+		return 0;
+	}
+
+	return device->GetMemoryStatistics(
+		device->driverData,
+		statistics,
+		statisticsCount
+	);
+}
+
+char* Refresh_BuildMemoryStatisticsString(
+	Refresh_Device *device
+) {
+	if (device == NULL) {
+		return NULL;
+	}
+
+	return device->BuildMemoryStatisticsString(
+		device->driverData
+	);
+}
+
+void Refresh_FreeMemoryStatisticsString(
+	char *string
+) {
+	SDL_free(string);
+}
+
+void Refresh_SetUploadRingSize(
+	Refresh_Device *device,
+	uint32_t sizeInBytes
+) {
+	NULL_RETURN(device);
+	device->SetUploadRingSize(
+		device->driverData,
+		sizeInBytes
+	);
+}
+
 /* vim: set noexpandtab shiftwidth=8 tabstop=8: */
@@ -260,6 +260,18 @@ struct Refresh_Device
 		Refresh_TextureCreateInfo *textureCreateInfo
 	);
 
+	uint8_t (*SupportsYCbCrFormat)(
+		Refresh_Renderer *driverData,
+		Refresh_TextureFormat format
+	);
+
+	void (*CreateAliasedTextures)(
+		Refresh_Renderer *driverData,
+		Refresh_AliasedTextureCreateInfo *createInfos,
+		uint32_t createInfoCount,
+		Refresh_Texture **pTextures
+	);
+
 	Refresh_Buffer* (*CreateBuffer)(
 		Refresh_Renderer *driverData,
 		Refresh_BufferUsageFlags usageFlags,
@@ -276,6 +288,26 @@ struct Refresh_Device
 		uint32_t dataLengthInBytes
 	);
 
+	void (*SetTextureDataPitched)(
+		Refresh_Renderer *driverData,
+		Refresh_CommandBuffer *commandBuffer,
+		Refresh_TextureSlice *textureSlice,
+		void *data,
+		uint32_t dataLengthInBytes,
+		uint32_t sourceX,
+		uint32_t sourceY,
+		uint32_t rowPitchInBytes
+	);
+
+	void (*SetTextureDataBatch)(
+		Refresh_Renderer *driverData,
+		Refresh_CommandBuffer *commandBuffer,
+		Refresh_TextureSlice *textureSlices,
+		void **pData,
+		uint32_t *pDataLengthsInBytes,
+		uint32_t sliceCount
+	);
+
 	void (*SetTextureDataYUV)(
 		Refresh_Renderer *driverData,
 		Refresh_CommandBuffer* commandBuffer,
@@ -310,6 +342,23 @@ struct Refresh_Device
 		Refresh_Buffer *buffer
 	);
 
+	void (*CopyBufferToBuffer)(
+		Refresh_Renderer *driverData,
+		Refresh_CommandBuffer *commandBuffer,
+		Refresh_Buffer *source,
+		Refresh_Buffer *destination,
+		Refresh_BufferCopy *regions,
+		uint32_t regionCount
+	);
+
+	void (*CopyBufferToTexture)(
+		Refresh_Renderer *driverData,
+		Refresh_CommandBuffer *commandBuffer,
+		Refresh_Buffer *buffer,
+		Refresh_BufferImageCopy *regions,
+		uint32_t regionCount
+	);
+
 	void (*SetBufferData)(
 		Refresh_Renderer *driverData,
 		Refresh_CommandBuffer *commandBuffer,
@@ -319,6 +368,28 @@ struct Refresh_Device
 		uint32_t dataLength
 	);
 
+	void* (*MapUploadRegion)(
+		Refresh_Renderer *driverData,
+		Refresh_CommandBuffer *commandBuffer,
+		uint32_t sizeInBytes,
+		Refresh_UploadRegion **pRegion
+	);
+
+	void (*CommitUploadRegionToBuffer)(
+		Refresh_Renderer *driverData,
+		Refresh_CommandBuffer *commandBuffer,
+		Refresh_UploadRegion *region,
+		Refresh_Buffer *buffer,
+		uint32_t offsetInBytes
+	);
+
+	void (*CommitUploadRegionToTexture)(
+		Refresh_Renderer *driverData,
+		Refresh_CommandBuffer *commandBuffer,
+		Refresh_UploadRegion *region,
+		Refresh_TextureSlice *textureSlice
+	);
+
 	uint32_t (*PushVertexShaderUniforms)(
 		Refresh_Renderer *driverData,
 		Refresh_CommandBuffer *commandBuffer,
@@ -363,6 +434,46 @@ struct Refresh_Device
 		uint32_t dataLengthInBytes
 	);
 
+	void* (*MapDynamicBuffer)(
+		Refresh_Renderer *driverData,
+		Refresh_Buffer *buffer,
+		uint8_t cycle
+	);
+
+	Refresh_Readback* (*DownloadBuffer)(
+		Refresh_Renderer *driverData,
+		Refresh_CommandBuffer *commandBuffer,
+		Refresh_Buffer *buffer,
+		uint32_t offsetInBytes,
+		uint32_t sizeInBytes
+	);
+
+	Refresh_Readback* (*DownloadTexture)(
+		Refresh_Renderer *driverData,
+		Refresh_CommandBuffer *commandBuffer,
+		Refresh_TextureSlice *textureSlice
+	);
+
+	int (*QueryReadback)(
+		Refresh_Renderer *driverData,
+		Refresh_Readback *readback
+	);
+
+	void (*WaitForReadback)(
+		Refresh_Renderer *driverData,
+		Refresh_Readback *readback
+	);
+
+	void* (*GetReadbackData)(
+		Refresh_Renderer *driverData,
+		Refresh_Readback *readback
+	);
+
+	void (*ReleaseReadback)(
+		Refresh_Renderer *driverData,
+		Refresh_Readback *readback
+	);
+
 	/* Disposal */
 
 	void (*QueueDestroyTexture)(
@@ -478,6 +589,10 @@ struct Refresh_Device
 		Refresh_Renderer *driverData
 	);
 
+	Refresh_CommandBuffer* (*AcquireTransferCommandBuffer)(
+		Refresh_Renderer *driverData
+	);
+
 	Refresh_Texture* (*AcquireSwapchainTexture)(
 		Refresh_Renderer *driverData,
 		Refresh_CommandBuffer *commandBuffer,
@@ -528,6 +643,55 @@ struct Refresh_Device
 		Refresh_Fence *fence
 	);
 
+	/* Memory Management */
+
+	void (*SetDefragmentationBudget)(
+		Refresh_Renderer *driverData,
+		uint64_t maxBytesPerSubmit,
+		uint32_t maxResourcesPerSubmit
+	);
+
+	void (*GetDefragmentationProgress)(
+		Refresh_Renderer *driverData,
+		Refresh_DefragmentationProgress *progress
+	);
+
+	uint32_t (*GetMemoryBudget)(
+		Refresh_Renderer *driverData,
+		Refresh_MemoryHeapBudget *heapBudgets,
+		uint32_t heapBudgetCount
+	);
+
+	void (*SetMemoryPressureCallback)(
+		Refresh_Renderer *driverData,
+		Refresh_MemoryPressureFunc callback,
+		const float *thresholds,
+		uint32_t thresholdCount,
+		void *userdata
+	);
+
+	void (*SetMemoryRetentionPolicy)(
+		Refresh_Renderer *driverData,
+		uint32_t maxRetainedBlocks,
+		uint32_t releaseAfterSubmits,
+		uint32_t releaseAfterMilliseconds
+	);
+
+	uint32_t (*GetMemoryStatistics)(
+		Refresh_Renderer *driverData,
+		Refresh_MemoryTypeStatistics *statistics,
+		uint32_t statisticsCount
+	);
+
+	char* (*BuildMemoryStatisticsString)(
+		Refresh_Renderer *driverData
+	);
+
+	void (*SetUploadRingSize)(
+		Refresh_Renderer *driverData,
+		uint32_t sizeInBytes
+	);
+
 	/* Opaque pointer for the Driver */
 	Refresh_Renderer *driverData;
 };
@@ -546,18 +710,34 @@ struct Refresh_Device
 	ASSIGN_DRIVER_FUNC(CreateSampler, name) \
 	ASSIGN_DRIVER_FUNC(CreateShaderModule, name) \
 	ASSIGN_DRIVER_FUNC(CreateTexture, name) \
+	ASSIGN_DRIVER_FUNC(SupportsYCbCrFormat, name) \
+	ASSIGN_DRIVER_FUNC(CreateAliasedTextures, name) \
 	ASSIGN_DRIVER_FUNC(CreateBuffer, name) \
 	ASSIGN_DRIVER_FUNC(SetTextureData, name) \
+	ASSIGN_DRIVER_FUNC(SetTextureDataPitched, name) \
+	ASSIGN_DRIVER_FUNC(SetTextureDataBatch, name) \
 	ASSIGN_DRIVER_FUNC(SetTextureDataYUV, name) \
 	ASSIGN_DRIVER_FUNC(CopyTextureToTexture, name) \
 	ASSIGN_DRIVER_FUNC(CopyTextureToBuffer, name) \
+	ASSIGN_DRIVER_FUNC(CopyBufferToBuffer, name) \
+	ASSIGN_DRIVER_FUNC(CopyBufferToTexture, name) \
 	ASSIGN_DRIVER_FUNC(SetBufferData, name) \
+	ASSIGN_DRIVER_FUNC(MapUploadRegion, name) \
+	ASSIGN_DRIVER_FUNC(CommitUploadRegionToBuffer, name) \
+	ASSIGN_DRIVER_FUNC(CommitUploadRegionToTexture, name) \
 	ASSIGN_DRIVER_FUNC(PushVertexShaderUniforms, name) \
 	ASSIGN_DRIVER_FUNC(PushFragmentShaderUniforms, name) \
 	ASSIGN_DRIVER_FUNC(PushComputeShaderUniforms, name) \
 	ASSIGN_DRIVER_FUNC(BindVertexSamplers, name) \
 	ASSIGN_DRIVER_FUNC(BindFragmentSamplers, name) \
 	ASSIGN_DRIVER_FUNC(GetBufferData, name) \
+	ASSIGN_DRIVER_FUNC(MapDynamicBuffer, name) \
+	ASSIGN_DRIVER_FUNC(DownloadBuffer, name) \
+	ASSIGN_DRIVER_FUNC(DownloadTexture, name) \
+	ASSIGN_DRIVER_FUNC(QueryReadback, name) \
+	ASSIGN_DRIVER_FUNC(WaitForReadback, name) \
+	ASSIGN_DRIVER_FUNC(GetReadbackData, name) \
+	ASSIGN_DRIVER_FUNC(ReleaseReadback, name) \
 	ASSIGN_DRIVER_FUNC(QueueDestroyTexture, name) \
 	ASSIGN_DRIVER_FUNC(QueueDestroySampler, name) \
 	ASSIGN_DRIVER_FUNC(QueueDestroyBuffer, name) \
@@ -577,6 +757,7 @@ struct Refresh_Device
 	ASSIGN_DRIVER_FUNC(ClaimWindow, name) \
 	ASSIGN_DRIVER_FUNC(UnclaimWindow, name) \
 	ASSIGN_DRIVER_FUNC(AcquireCommandBuffer, name) \
+	ASSIGN_DRIVER_FUNC(AcquireTransferCommandBuffer, name) \
 	ASSIGN_DRIVER_FUNC(AcquireSwapchainTexture, name) \
 	ASSIGN_DRIVER_FUNC(GetSwapchainFormat, name) \
 	ASSIGN_DRIVER_FUNC(SetSwapchainPresentMode, name) \
@@ -585,7 +766,15 @@ struct Refresh_Device
 	ASSIGN_DRIVER_FUNC(Wait, name) \
 	ASSIGN_DRIVER_FUNC(WaitForFences, name) \
 	ASSIGN_DRIVER_FUNC(QueryFence, name) \
-	ASSIGN_DRIVER_FUNC(ReleaseFence, name)
+	ASSIGN_DRIVER_FUNC(ReleaseFence, name) \
+	ASSIGN_DRIVER_FUNC(SetDefragmentationBudget, name) \
+	ASSIGN_DRIVER_FUNC(GetDefragmentationProgress, name) \
+	ASSIGN_DRIVER_FUNC(GetMemoryBudget, name) \
+	ASSIGN_DRIVER_FUNC(SetMemoryPressureCallback, name) \
+	ASSIGN_DRIVER_FUNC(SetMemoryRetentionPolicy, name) \
+	ASSIGN_DRIVER_FUNC(GetMemoryStatistics, name) \
+	ASSIGN_DRIVER_FUNC(BuildMemoryStatisticsString, name) \
+	ASSIGN_DRIVER_FUNC(SetUploadRingSize, name)
 
 typedef struct Refresh_Driver
 {
@@ -37,6 +37,11 @@
 #include <SDL.h>
 #include <SDL_vulkan.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define VULKAN_STREAMING_COPY 1
+#include <emmintrin.h>
+#endif
+
 #define VULKAN_INTERNAL_clamp(val, min, max) SDL_max(min, SDL_min(val, max))
 
 /* Global Vulkan Loader Entry Points */
@@ -62,11 +67,14 @@ typedef struct VulkanExtensions
 	/* Core since 1.1 */
 	uint8_t KHR_maintenance1;
 	uint8_t KHR_get_memory_requirements2;
+	uint8_t KHR_bind_memory2;
+	uint8_t KHR_sampler_ycbcr_conversion;
 
 	/* Core since 1.2 */
 	uint8_t KHR_driver_properties;
 	/* EXT, probably not going to be Core */
 	uint8_t EXT_vertex_attribute_divisor;
+	uint8_t EXT_memory_budget;
 	/* Only required for special implementations (i.e. MoltenVK) */
 	uint8_t KHR_portability_subset;
 } VulkanExtensions;
@@ -76,12 +84,29 @@ typedef struct VulkanExtensions
 #define STARTING_ALLOCATION_SIZE 64000000 	    /* 64MB */
 #define MAX_ALLOCATION_SIZE 256000000 		    /* 256MB */
 #define ALLOCATION_INCREMENT 16000000           /* 16MB */
+#define TRANSIENT_BLOCK_SIZE 16000000           /* 16MB */
+#define BUFFER_SLAB_SIZE 4194304                /* 4MB */
+#define BUFFER_SLAB_MIN_SLOT_SIZE 256           /* covers every offset alignment limit */
+#define BUFFER_SLAB_MAX_SLOT_SIZE 65536         /* 64KB */
+#define BUFFER_SLAB_CLASS_COUNT 9               /* 256B to 64KB in powers of two */
 #define TRANSFER_BUFFER_STARTING_SIZE 8000000 	/* 8MB */
 #define POOLED_TRANSFER_BUFFER_SIZE 16000000    /* 16MB */
+#define UPLOAD_RING_SIZE 33554432               /* 32MB */
+#define READBACK_RING_SIZE 16777216             /* 16MB */
+#define READBACK_WAIT_SLICE 1000000             /* 1ms, in nanoseconds */
+#define STREAMING_COPY_THRESHOLD 16384          /* 16KB */
 #define UBO_BUFFER_SIZE 16777216 				/* 16MB */
-#define UBO_SECTION_SIZE 4096 			        /* 4KB */
+#define UBO_SECTION_SIZE 65536                  /* 64KB, claimed per command buffer */
+#define UBO_MAX_BLOCK_SIZE 4096                 /* 4KB, range of the uniform descriptor */
+#define FRAGMENT_PUSH_CONSTANT_OFFSET 64        /* vertex push constants get the bytes before */
 #define DESCRIPTOR_POOL_STARTING_SIZE 128
 #define DEFRAG_TIME 200
+#define DEFRAG_BYTES_PER_SUBMIT 4000000         /* 4MB */
+#define DEFRAG_RESOURCES_PER_SUBMIT 16
+#define FREE_LIST_FIRST_LEVEL_COUNT 64
+#define FREE_LIST_SECOND_LEVEL_BITS 4
+#define FREE_LIST_SECOND_LEVEL_COUNT (1 << FREE_LIST_SECOND_LEVEL_BITS)
+#define MAX_MEMORY_PRESSURE_THRESHOLDS 8
 #define WINDOW_DATA "Refresh_VulkanWindowData"
 
 #define IDENTITY_SWIZZLE 		\
@@ -220,7 +245,18 @@ static VkFormat RefreshToVK_SurfaceFormat[] =
 	VK_FORMAT_D16_UNORM,				/* D16_UNORM */
 	VK_FORMAT_D32_SFLOAT,				/* D32_SFLOAT */
 	VK_FORMAT_D16_UNORM_S8_UINT,		/* D16_UNORM_S8_UINT */
-	VK_FORMAT_D32_SFLOAT_S8_UINT		/* D32_SFLOAT_S8_UINT */
+	VK_FORMAT_D32_SFLOAT_S8_UINT,		/* D32_SFLOAT_S8_UINT */
+	VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM,	/* G8_B8_R8_3PLANE_420 */
+	VK_FORMAT_G8_B8R8_2PLANE_420_UNORM	/* G8_B8R8_2PLANE_420 */
+};
+
+/* Multi-planar formats, in the order of the renderer's Y'CbCr tables */
+#define YCBCR_FORMAT_COUNT 2
+
+static VkFormat YCbCrFormats[YCBCR_FORMAT_COUNT] =
+{
+	VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM,
+	VK_FORMAT_G8_B8R8_2PLANE_420_UNORM
 };
 
 static VkFormat RefreshToVK_VertexFormat[] =
@@ -395,16 +431,22 @@ static VkBorderColor RefreshToVK_BorderColor[] =
 
 typedef struct VulkanMemoryAllocation VulkanMemoryAllocation;
 typedef struct VulkanBuffer VulkanBuffer;
+typedef struct VulkanBufferSlab VulkanBufferSlab;
 typedef struct VulkanTexture VulkanTexture;
 
-typedef struct VulkanMemoryFreeRegion
+typedef struct VulkanMemoryFreeRegion VulkanMemoryFreeRegion;
+
+struct VulkanMemoryFreeRegion
 {
 	VulkanMemoryAllocation *allocation;
 	VkDeviceSize offset;
 	VkDeviceSize size;
 	uint32_t allocationIndex;
-	uint32_t sortedIndex;
-} VulkanMemoryFreeRegion;
+	uint32_t firstLevelIndex;
+	uint32_t secondLevelIndex;
+	VulkanMemoryFreeRegion *prev; /* links within the size class free list */
+	VulkanMemoryFreeRegion *next;
+};
 
 typedef struct VulkanMemoryUsedRegion
 {
@@ -415,6 +457,7 @@ typedef struct VulkanMemoryUsedRegion
 	VkDeviceSize resourceSize; /* differs from size based on alignment */
 	VkDeviceSize alignment;
 	uint8_t isBuffer;
+	uint8_t defragMoved; /* a copy was recorded and the old resource is queued for destroy */
 	REFRESHNAMELESS union
 	{
 		VulkanBuffer *vulkanBuffer;
@@ -428,9 +471,28 @@ typedef struct VulkanMemorySubAllocator
 	VkDeviceSize nextAllocationSize;
 	VulkanMemoryAllocation **allocations;
 	uint32_t allocationCount;
-	VulkanMemoryFreeRegion **sortedFreeRegions;
-	uint32_t sortedFreeRegionCount;
-	uint32_t sortedFreeRegionCapacity;
+	/* Two-level segregated free lists, TLSF style.
+	 * The first level is the power of two size class,
+	 * the second level linearly subdivides each power of two.
+	 * The bitmasks mark which lists are non-empty.
+	 */
+	uint64_t freeListFirstLevelBitmask;
+	uint32_t freeListSecondLevelBitmasks[FREE_LIST_FIRST_LEVEL_COUNT];
+	VulkanMemoryFreeRegion *freeLists[FREE_LIST_FIRST_LEVEL_COUNT][FREE_LIST_SECOND_LEVEL_COUNT];
+	uint32_t freeRegionCount;
+	/* Ring of blocks that transient resources bump allocate from.
+	 * These blocks are also in allocations but never enter the free lists.
+	 */
+	VulkanMemoryAllocation **transientBlocks;
+	uint32_t transientBlockCount;
+	uint32_t currentTransientBlock;
+	VkDeviceSize defragBytesMoved;
+	uint32_t defragResourcesMoved;
+	/* Guards everything above plus the regions of every allocation in this type,
+	 * so threads creating resources in different memory types don't contend.
+	 * Take it before the renderer's allocatorLock, never after.
+	 */
+	SDL_mutex *lock;
 } VulkanMemorySubAllocator;
 
 struct VulkanMemoryAllocation
@@ -446,6 +508,13 @@ struct VulkanMemoryAllocation
 	uint32_t freeRegionCapacity;
 	uint8_t dedicated;
 	uint8_t availableForAllocation;
+	uint8_t transient; /* regions are bump allocated and not tracked in usedRegions */
+	VkDeviceSize transientOffset; /* next free byte, reset when the block empties */
+	uint8_t aliased; /* regions overlap and are not tracked in usedRegions either */
+	uint8_t empty; /* set by the submit sweep, cleared when a region is used again */
+	uint8_t defragSkipped; /* a replacement resource failed to create, never picked again */
+	uint64_t emptyTimestamp;
+	uint64_t emptySubmitIndex;
 	VkDeviceSize freeSpace;
 	VkDeviceSize usedSpace;
 	uint8_t *mapPointer;
@@ -457,6 +526,18 @@ typedef struct VulkanMemoryAllocator
 	VulkanMemorySubAllocator subAllocators[VK_MAX_MEMORY_TYPES];
 } VulkanMemoryAllocator;
 
+/* Collected under the submit lock, reported once it is released */
+typedef struct VulkanMemoryPressureReport
+{
+	Refresh_MemoryPressureFunc callback;
+	void *userdata;
+	uint32_t heapIndices[VK_MAX_MEMORY_HEAPS];
+	uint32_t levels[VK_MAX_MEMORY_HEAPS];
+	VkDeviceSize usages[VK_MAX_MEMORY_HEAPS];
+	VkDeviceSize budgets[VK_MAX_MEMORY_HEAPS];
+	uint32_t heapCount;
+} VulkanMemoryPressureReport;
+
 /* Memory Barriers */
 
 typedef struct VulkanResourceAccessInfo
@@ -697,22 +778,48 @@ static const VulkanResourceAccessInfo AccessMap[RESOURCE_ACCESS_TYPES_COUNT] =
 typedef struct VulkanBufferContainer /* cast from Refresh_Buffer */
 {
 	VulkanBuffer *vulkanBuffer;
+
+	/* Dynamic buffers rename between these instead of waiting on the GPU.
+	 * vulkanBuffer is always one of them.
+	 */
+	VulkanBuffer **versions;
+	uint32_t versionCount;
+	uint8_t dynamic;
 } VulkanBufferContainer;
 
 struct VulkanBuffer
 {
 	VkBuffer buffer;
+	VkDeviceSize offset; /* into the VkBuffer, nonzero when carved out of a slab */
 	VkDeviceSize size;
-	VulkanMemoryUsedRegion *usedRegion;
+	VulkanMemoryUsedRegion *usedRegion; /* the slab's region when carved out of a slab */
 	VulkanResourceAccessType resourceAccessType;
 	VkBufferUsageFlags usage;
 
 	uint8_t requireHostVisible;
 	uint8_t preferDeviceLocal;
+	uint8_t preferHostCached;
+	uint8_t usedOnGraphicsQueue; /* transfer queue writes must take ownership first */
 
 	SDL_atomic_t referenceCount; /* Tracks command buffer usage */
 
 	VulkanBufferContainer *container;
+
+	VulkanBufferSlab *slab; /* NULL unless suballocated */
+	uint32_t slabSlot;
+};
+
+/* Small buffers with the same usage share one VkBuffer split into equal slots.
+ * The slab buffer is a dedicated allocation so defrag never moves it out from
+ * under the buffers that point into it.
+ */
+struct VulkanBufferSlab
+{
+	VulkanBuffer *buffer;
+	VkDeviceSize slotSize;
+	uint32_t slotCount;
+	uint32_t *freeSlots; /* stack of free slot indices */
+	uint32_t freeSlotCount;
 };
 
 typedef struct VulkanUniformBufferPool VulkanUniformBufferPool;
@@ -720,9 +827,10 @@ typedef struct VulkanUniformBufferPool VulkanUniformBufferPool;
 typedef struct VulkanUniformBuffer
 {
 	VulkanUniformBufferPool *pool;
-	VkDeviceSize poolOffset; /* memory offset relative to the pool buffer */
+	VulkanBuffer *buffer; /* the pool buffer this section is carved from */
+	VkDeviceSize poolOffset; /* memory offset relative to that buffer */
 	VkDeviceSize offset; /* based on uniform pushes */
-	VkDescriptorSet descriptorSet;
+	VkDescriptorSet descriptorSet; /* shared by every section of that buffer */
 } VulkanUniformBuffer;
 
 typedef enum VulkanUniformBufferType
@@ -732,28 +840,27 @@ typedef enum VulkanUniformBufferType
 	UNIFORM_BUFFER_COMPUTE
 } VulkanUniformBufferType;
 
-/* Yes, the pool is made of multiple pools.
- * For some reason it was considered a good idea to make VkDescriptorPool fixed-size.
+/* Sections are carved out of UBO_BUFFER_SIZE buffers, and another buffer
+ * is added when the last one runs out. Each buffer gets a single dynamic
+ * descriptor covering UBO_MAX_BLOCK_SIZE, written once at creation, and
+ * pushes select their block with the dynamic offset.
+ * Command buffers keep their section until they are submitted and get
+ * it back when they are cleaned, so the pool lock is only taken when
+ * a section fills up.
  */
-typedef struct VulkanUniformDescriptorPool
-{
-	VkDescriptorPool* descriptorPools;
-	uint32_t descriptorPoolCount;
-
-	/* Decremented whenever a descriptor set is allocated and
-	 * incremented whenever a descriptor pool is allocated.
-	 * This lets us keep track of when we need a new pool.
-	 */
-	uint32_t availableDescriptorSetCount;
-} VulkanUniformDescriptorPool;
-
-/* This is actually just one buffer that we carve slices out of. */
 struct VulkanUniformBufferPool
 {
 	VulkanUniformBufferType type;
-	VulkanUniformDescriptorPool descriptorPool;
-	VulkanBuffer *buffer;
-	VkDeviceSize nextAvailableOffset;
+	VulkanResourceAccessType resourceAccessType;
+	VkDescriptorSetLayout descriptorSetLayout;
+
+	VulkanBuffer **buffers;
+	VkDescriptorPool *descriptorPools; /* one set each, matching buffers */
+	VkDescriptorSet *descriptorSets;
+	uint32_t bufferCount;
+	uint32_t bufferCapacity;
+
+	VkDeviceSize nextAvailableOffset; /* within the last buffer */
 	SDL_mutex *lock;
 
 	VulkanUniformBuffer **availableBuffers;
@@ -780,6 +887,7 @@ typedef struct VulkanSampler
 typedef struct VulkanShaderModule
 {
 	VkShaderModule shaderModule;
+	uint8_t usesPushConstants; /* SPIR-V declares a PushConstant variable */
 	SDL_atomic_t referenceCount;
 } VulkanShaderModule;
 
@@ -804,10 +912,11 @@ struct VulkanTexture
 	uint32_t levelCount;
 	Refresh_SampleCount sampleCount;
 	VkFormat format;
-	VulkanResourceAccessType resourceAccessType;
+	VulkanResourceAccessType *subresourceAccessTypes; /* layerCount * levelCount, layer-major */
 	VkImageUsageFlags usageFlags;
 
 	VkImageAspectFlags aspectFlags;
+	uint8_t usedOnGraphicsQueue; /* transfer queue writes must take ownership first */
 
 	struct VulkanTexture *msaaTex;
 
@@ -878,6 +987,10 @@ typedef struct VulkanGraphicsPipelineLayout
 	VkPipelineLayout pipelineLayout;
 	DescriptorSetCache *vertexSamplerDescriptorSetCache;
 	DescriptorSetCache *fragmentSamplerDescriptorSetCache;
+
+	/* Fragment bindings with an immutable Y'CbCr conversion sampler */
+	uint32_t fragmentYCbCrSamplerMask;
+	VkSampler fragmentYCbCrSampler;
 } VulkanGraphicsPipelineLayout;
 
 typedef struct VulkanGraphicsPipeline
@@ -888,6 +1001,10 @@ typedef struct VulkanGraphicsPipeline
 	VkDeviceSize vertexUniformBlockSize;
 	VkDeviceSize fragmentUniformBlockSize;
 
+	/* Nonzero when the stage's uniforms are push constants instead of a UBO */
+	uint32_t vertexPushConstantSize;
+	uint32_t fragmentPushConstantSize;
+
 	VulkanShaderModule *vertexShaderModule;
 	VulkanShaderModule *fragmentShaderModule;
 
@@ -922,6 +1039,8 @@ typedef struct DescriptorSetLayoutHash
 	VkDescriptorType descriptorType;
 	uint32_t bindingCount;
 	VkShaderStageFlagBits stageFlag;
+	uint32_t immutableSamplerMask;
+	VkSampler immutableSampler;
 } DescriptorSetLayoutHash;
 
 typedef struct DescriptorSetLayoutHashMap
@@ -949,6 +1068,8 @@ static inline uint64_t DescriptorSetLayoutHashTable_GetHashCode(DescriptorSetLay
 	result = result * HASH_FACTOR + key.descriptorType;
 	result = result * HASH_FACTOR + key.bindingCount;
 	result = result * HASH_FACTOR + key.stageFlag;
+	result = result * HASH_FACTOR + key.immutableSamplerMask;
+	result = result * HASH_FACTOR + (uint64_t) key.immutableSampler;
 	return result;
 }
 
@@ -965,7 +1086,9 @@ static inline VkDescriptorSetLayout DescriptorSetLayoutHashTable_Fetch(
 		const DescriptorSetLayoutHash *e = &arr->elements[i].key;
 		if (	key.descriptorType == e->descriptorType &&
 			key.bindingCount == e->bindingCount &&
-			key.stageFlag == e->stageFlag	)
+			key.stageFlag == e->stageFlag &&
+			key.immutableSamplerMask == e->immutableSamplerMask &&
+			key.immutableSampler == e->immutableSampler	)
 		{
 			return arr->elements[i].value;
 		}
@@ -1345,6 +1468,7 @@ struct DescriptorSetCache
 	SDL_mutex *lock;
 	VkDescriptorSetLayout descriptorSetLayout;
 	uint32_t bindingCount;
+	uint32_t descriptorCount; /* per set, Y'CbCr samplers can take several */
 	VkDescriptorType descriptorType;
 
 	VkDescriptorPool *descriptorPools;
@@ -1366,6 +1490,8 @@ typedef struct GraphicsPipelineLayoutHash
 	VkDescriptorSetLayout fragmentSamplerLayout;
 	VkDescriptorSetLayout vertexUniformLayout;
 	VkDescriptorSetLayout fragmentUniformLayout;
+	uint32_t vertexPushConstantSize;
+	uint32_t fragmentPushConstantSize;
 } GraphicsPipelineLayoutHash;
 
 typedef struct GraphicsPipelineLayoutHashMap
@@ -1394,6 +1520,8 @@ static inline uint64_t GraphicsPipelineLayoutHashTable_GetHashCode(GraphicsPipel
 	result = result * HASH_FACTOR + (uint64_t) key.fragmentSamplerLayout;
 	result = result * HASH_FACTOR + (uint64_t) key.vertexUniformLayout;
 	result = result * HASH_FACTOR + (uint64_t) key.fragmentUniformLayout;
+	result = result * HASH_FACTOR + (uint64_t) key.vertexPushConstantSize;
+	result = result * HASH_FACTOR + (uint64_t) key.fragmentPushConstantSize;
 	return result;
 }
 
@@ -1411,7 +1539,9 @@ static inline VulkanGraphicsPipelineLayout* GraphicsPipelineLayoutHashArray_Fetc
 		if (	key.vertexSamplerLayout == e->vertexSamplerLayout &&
 			key.fragmentSamplerLayout == e->fragmentSamplerLayout &&
 			key.vertexUniformLayout == e->vertexUniformLayout &&
-			key.fragmentUniformLayout == e->fragmentUniformLayout	)
+			key.fragmentUniformLayout == e->fragmentUniformLayout &&
+			key.vertexPushConstantSize == e->vertexPushConstantSize &&
+			key.fragmentPushConstantSize == e->fragmentPushConstantSize	)
 		{
 			return arr->elements[i].value;
 		}
@@ -1546,7 +1676,22 @@ typedef struct VulkanFencePool
 	uint32_t availableFenceCapacity;
 } VulkanFencePool;
 
+typedef struct VulkanUploadRegion
+{
+	VulkanBuffer *buffer;
+	VkDeviceSize offset;
+	VkDeviceSize size;
+} VulkanUploadRegion;
+
+typedef struct VulkanBufferUpload
+{
+	VulkanBuffer *srcBuffer;
+	VulkanBuffer *dstBuffer;
+	VkBufferCopy region; /* offsets are relative to the VkBuffers */
+} VulkanBufferUpload;
+
 typedef struct VulkanCommandPool VulkanCommandPool;
+typedef struct VulkanReadback VulkanReadback;
 
 typedef struct VulkanCommandBuffer
 {
@@ -1558,6 +1703,7 @@ typedef struct VulkanCommandBuffer
 	uint32_t presentDataCapacity;
 
 	VkSemaphore *waitSemaphores;
+	VkPipelineStageFlags *waitSemaphoreStages;
 	uint32_t waitSemaphoreCount;
 	uint32_t waitSemaphoreCapacity;
 
@@ -1565,12 +1711,45 @@ typedef struct VulkanCommandBuffer
 	uint32_t signalSemaphoreCount;
 	uint32_t signalSemaphoreCapacity;
 
+	/* Semaphores from transfer submissions, destroyed once this completes */
+	VkSemaphore *transferSemaphores;
+	uint32_t transferSemaphoreCount;
+	uint32_t transferSemaphoreCapacity;
+
+	/* Transfer command buffers only: resources handed to the graphics queue on submit */
+
+	uint8_t isTransfer;
+
+	VulkanBuffer **releaseBuffers;
+	VulkanResourceAccessType *releaseBufferAccessTypes;
+	uint32_t releaseBufferCount;
+	uint32_t releaseBufferCapacity;
+
+	VulkanTexture **releaseTextures;
+	uint32_t releaseTextureCount;
+	uint32_t releaseTextureCapacity;
+
+	/* Graphics-side halves of ownership transfers for resources the graphics
+	 * queue has used, recorded on a graphics command buffer on submit
+	 */
+	VkBufferMemoryBarrier *graphicsReleaseBufferBarriers;
+	uint32_t graphicsReleaseBufferBarrierCount;
+	uint32_t graphicsReleaseBufferBarrierCapacity;
+
+	VkImageMemoryBarrier *graphicsReleaseImageBarriers;
+	uint32_t graphicsReleaseImageBarrierCount;
+	uint32_t graphicsReleaseImageBarrierCapacity;
+
 	VulkanComputePipeline *currentComputePipeline;
 	VulkanGraphicsPipeline *currentGraphicsPipeline;
 
 	VulkanTexture *renderPassColorTargetTextures[MAX_COLOR_TARGET_BINDINGS];
+	uint32_t renderPassColorTargetLayers[MAX_COLOR_TARGET_BINDINGS];
+	uint32_t renderPassColorTargetLevels[MAX_COLOR_TARGET_BINDINGS];
 	uint32_t renderPassColorTargetCount;
 	VulkanTexture *renderPassDepthTexture; /* can be NULL */
+	uint32_t renderPassDepthLayer;
+	uint32_t renderPassDepthLevel;
 
 	VulkanUniformBuffer *vertexUniformBuffer;
 	VulkanUniformBuffer *fragmentUniformBuffer;
@@ -1581,10 +1760,33 @@ typedef struct VulkanCommandBuffer
 	VkDescriptorSet bufferDescriptorSet; /* updated by BindComputeBuffers */
 	VkDescriptorSet imageDescriptorSet; /* updated by BindComputeTextures */
 
+	/* Last graphics sets bound, so redundant binds between draws are skipped */
+	VkDescriptorSet boundGraphicsDescriptorSets[4];
+	uint32_t boundGraphicsDynamicOffsets[2];
+	uint8_t graphicsDescriptorSetsBound;
+
 	VulkanTransferBuffer** transferBuffers;
 	uint32_t transferBufferCount;
 	uint32_t transferBufferCapacity;
 
+	VulkanTransferBuffer uploadRingTransferBuffer; /* views the upload ring, never freed */
+	uint8_t usedUploadRing;
+
+	/* Handed out by MapUploadRegion. Entries are reused, never moved. */
+	VulkanUploadRegion **uploadRegions;
+	uint32_t uploadRegionCount;
+	uint32_t uploadRegionCapacity;
+
+	/* SetBufferData copies, recorded together by FlushBufferUploads */
+	VulkanBufferUpload *pendingBufferUploads;
+	uint32_t pendingBufferUploadCount;
+	uint32_t pendingBufferUploadCapacity;
+
+	/* Readbacks recorded here, they complete when this is cleaned */
+	VulkanReadback **readbacks;
+	uint32_t readbackCount;
+	uint32_t readbackCapacity;
+
 	VulkanUniformBuffer **boundUniformBuffers;
 	uint32_t boundUniformBufferCount;
 	uint32_t boundUniformBufferCapacity;
@@ -1640,9 +1842,76 @@ typedef struct VulkanCommandBuffer
 	uint8_t autoReleaseFence;
 } VulkanCommandBuffer;
 
+typedef struct VulkanUploadRingRange
+{
+	VulkanCommandBuffer *commandBuffer; /* NULL once the work using it has completed */
+	VkFence fence; /* VK_NULL_HANDLE until the command buffer is submitted */
+	uint64_t end;
+} VulkanUploadRingRange;
+
+/* Staging memory for uploads is bump allocated out of one persistently
+ * mapped buffer. Positions only ever grow, the buffer offset is the
+ * position modulo the size. Ranges are retired in allocation order,
+ * so the tail only moves once the oldest in-flight range completes.
+ */
+typedef struct VulkanUploadRing
+{
+	SDL_mutex *lock;
+
+	VulkanBuffer *buffer;
+	VkDeviceSize size;
+	VkDeviceSize requestedSize; /* applied once the ring is idle */
+	uint64_t head;
+	uint64_t tail;
+
+	VulkanUploadRingRange *ranges; /* circular, oldest first */
+	uint32_t rangeStart;
+	uint32_t rangeCount;
+	uint32_t rangeCapacity;
+} VulkanUploadRing;
+
+struct VulkanReadback /* cast from Refresh_Readback */
+{
+	VulkanBuffer *buffer; /* the readback ring's buffer, or a dedicated one */
+	VkDeviceSize offset;
+	VkDeviceSize size;
+	uint8_t fromRing;
+	uint64_t ringEnd;
+
+	VulkanCommandBuffer *commandBuffer; /* NULL once the copy has completed */
+	VkFence fence; /* VK_NULL_HANDLE until the command buffer is submitted */
+	uint8_t released;
+};
+
+/* Readback destinations are bump allocated like the upload ring, but the
+ * client decides when each one is done with. The tail only moves past the
+ * oldest readback once it has both completed and been released, and a
+ * readback that doesn't fit gets a dedicated buffer instead.
+ */
+typedef struct VulkanReadbackRing
+{
+	SDL_mutex *lock;
+
+	VulkanBuffer *buffer;
+	VkDeviceSize size;
+	uint64_t head;
+	uint64_t tail;
+
+	VulkanReadback **readbacks; /* circular, oldest first */
+	uint32_t readbackStart;
+	uint32_t readbackCount;
+	uint32_t readbackCapacity;
+
+	/* Readbacks that didn't fit, so they can be freed at shutdown */
+	VulkanReadback **dedicatedReadbacks;
+	uint32_t dedicatedReadbackCount;
+	uint32_t dedicatedReadbackCapacity;
+} VulkanReadbackRing;
+
 struct VulkanCommandPool
 {
 	SDL_threadID threadID;
+	uint8_t isTransfer;
 	VkCommandPool commandPool;
 
 	VulkanCommandBuffer **inactiveCommandBuffers;
@@ -1655,6 +1924,7 @@ struct VulkanCommandPool
 typedef struct CommandPoolHash
 {
 	SDL_threadID threadID;
+	uint8_t isTransfer;
 } CommandPoolHash;
 
 typedef struct CommandPoolHashMap
@@ -1680,6 +1950,7 @@ static inline uint64_t CommandPoolHashTable_GetHashCode(CommandPoolHash key)
 	const uint64_t HASH_FACTOR = 97;
 	uint64_t result = 1;
 	result = result * HASH_FACTOR + (uint64_t) key.threadID;
+	result = result * HASH_FACTOR + (uint64_t) key.isTransfer;
 	return result;
 }
 
@@ -1694,7 +1965,7 @@ static inline VulkanCommandPool* CommandPoolHashTable_Fetch(
 	for (i = 0; i < arr->count; i += 1)
 	{
 		const CommandPoolHash *e = &arr->elements[i].key;
-		if (key.threadID == e->threadID)
+		if (key.threadID == e->threadID && key.isTransfer == e->isTransfer)
 		{
 			return arr->elements[i].value;
 		}
@@ -1739,6 +2010,23 @@ typedef struct VulkanRenderer
 	VulkanMemoryAllocator *memoryAllocator;
 	VkPhysicalDeviceMemoryProperties memoryProperties;
 
+	VulkanBufferSlab **bufferSlabs[BUFFER_SLAB_CLASS_COUNT];
+	uint32_t bufferSlabCounts[BUFFER_SLAB_CLASS_COUNT];
+
+	/* Heap usage is the driver's figure at the last budget query
+	 * plus whatever we allocated or freed since then.
+	 */
+	VkDeviceSize heapAllocatedBytes[VK_MAX_MEMORY_HEAPS];
+	VkDeviceSize heapAllocatedBytesAtBudgetQuery[VK_MAX_MEMORY_HEAPS];
+	VkDeviceSize heapUsageAtBudgetQuery[VK_MAX_MEMORY_HEAPS];
+	VkDeviceSize heapBudget[VK_MAX_MEMORY_HEAPS];
+
+	Refresh_MemoryPressureFunc memoryPressureCallback;
+	void *memoryPressureUserdata;
+	float memoryPressureThresholds[MAX_MEMORY_PRESSURE_THRESHOLDS];
+	uint32_t memoryPressureThresholdCount;
+	uint32_t memoryPressureLevels[VK_MAX_MEMORY_HEAPS];
+
 	WindowData **claimedWindows;
 	uint32_t claimedWindowCount;
 	uint32_t claimedWindowCapacity;
@@ -1746,13 +2034,40 @@ typedef struct VulkanRenderer
 	uint32_t queueFamilyIndex;
 	VkQueue unifiedQueue;
 
+	/* Same as the unified queue when there is no transfer-only family */
+	uint32_t transferQueueFamilyIndex;
+	VkQueue transferQueue;
+
+	/* Ownership acquires for the next graphics command buffer */
+	SDL_mutex *pendingTransferLock;
+	VkSemaphore *pendingTransferSemaphores;
+	uint32_t pendingTransferSemaphoreCount;
+	uint32_t pendingTransferSemaphoreCapacity;
+	VkBufferMemoryBarrier *pendingAcquireBufferBarriers;
+	uint32_t pendingAcquireBufferBarrierCount;
+	uint32_t pendingAcquireBufferBarrierCapacity;
+	VkImageMemoryBarrier *pendingAcquireImageBarriers;
+	uint32_t pendingAcquireImageBarrierCount;
+	uint32_t pendingAcquireImageBarrierCapacity;
+	VkPipelineStageFlags pendingAcquireStages;
+
 	VulkanCommandBuffer **submittedCommandBuffers;
 	uint32_t submittedCommandBufferCount;
 	uint32_t submittedCommandBufferCapacity;
 
 	VulkanTransferBufferPool transferBufferPool;
+	VulkanUploadRing uploadRing;
+	VulkanReadbackRing readbackRing;
 	VulkanFencePool fencePool;
 
+	/* Guarded by submitLock. While anyone is waiting on a readback, fences
+	 * that signalled readbacks are held here instead of being recycled.
+	 */
+	uint32_t readbackWaiterCount;
+	VkFence *deferredReadbackFences;
+	uint32_t deferredReadbackFenceCount;
+	uint32_t deferredReadbackFenceCapacity;
+
 	CommandPoolHashTable commandPoolHashTable;
 	DescriptorSetLayoutHashTable descriptorSetLayoutHashTable;
 	GraphicsPipelineLayoutHashTable graphicsPipelineLayoutHashTable;
@@ -1792,6 +2107,11 @@ typedef struct VulkanRenderer
 	VkFormat D16Format;
 	VkFormat D16S8Format;
 
+	/* Indexed like YCbCrFormats, null handles if the format is unsupported */
+	VkSamplerYcbcrConversion ycbcrConversions[YCBCR_FORMAT_COUNT];
+	VkSampler ycbcrSamplers[YCBCR_FORMAT_COUNT];
+	uint32_t ycbcrDescriptorCounts[YCBCR_FORMAT_COUNT];
+
 	VulkanTexture **texturesToDestroy;
 	uint32_t texturesToDestroyCount;
 	uint32_t texturesToDestroyCapacity;
@@ -1820,7 +2140,8 @@ typedef struct VulkanRenderer
 	uint32_t framebuffersToDestroyCount;
 	uint32_t framebuffersToDestroyCapacity;
 
-	SDL_mutex *allocatorLock;
+	SDL_mutex *allocatorLock; /* heap accounting, budgets and defrag state only */
+	SDL_mutex *bufferSlabLock;
 	SDL_mutex *disposeLock;
 	SDL_mutex *submitLock;
 	SDL_mutex *acquireCommandBufferLock;
@@ -1831,6 +2152,19 @@ typedef struct VulkanRenderer
 	uint8_t needDefrag;
 	uint64_t defragTimestamp;
 	uint8_t defragInProgress;
+	VulkanMemoryAllocation *defragAllocation; /* block being emptied across submits, may be NULL */
+	VkDeviceSize defragBytesPerSubmit;
+	uint32_t defragResourcesPerSubmit;
+	VkDeviceSize defragBytesRemaining;
+	uint32_t defragResourcesRemaining;
+	uint64_t defragTotalBytesMoved;
+	uint32_t defragTotalResourcesMoved;
+
+	/* Empty blocks kept around instead of being freed on the next submit */
+	uint32_t retainedEmptyBlocksPerType;
+	uint32_t emptyBlockReleaseSubmits;
+	uint32_t emptyBlockReleaseMilliseconds;
+	uint64_t submitIndex;
 
 #define VULKAN_INSTANCE_FUNCTION(ext, ret, func, params) \
 		vkfntype_##func func;
@@ -1847,6 +2181,7 @@ static void VULKAN_UnclaimWindow(Refresh_Renderer *driverData, void *windowHandl
 static void VULKAN_Wait(Refresh_Renderer *driverData);
 static void VULKAN_Submit(Refresh_Renderer *driverData, Refresh_CommandBuffer *commandBuffer);
 static void VULKAN_INTERNAL_DestroyRenderTarget(VulkanRenderer *renderer, VulkanRenderTarget *renderTarget);
+static void VULKAN_INTERNAL_QueueDestroyBuffer(VulkanRenderer *renderer, VulkanBuffer *vulkanBuffer);
 
 /* Error Handling */
 
@@ -1975,6 +2310,34 @@ static inline uint8_t IsStencilFormat(VkFormat format)
 	}
 }
 
+static inline int32_t VULKAN_INTERNAL_YCbCrFormatIndex(VkFormat format)
+{
+	int32_t i;
+
+	for (i = 0; i < YCBCR_FORMAT_COUNT; i += 1)
+	{
+		if (YCbCrFormats[i] == format)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static inline uint32_t VULKAN_INTERNAL_PlaneCount(VkFormat format)
+{
+	switch (format)
+	{
+		case VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM:
+			return 3;
+		case VK_FORMAT_G8_B8R8_2PLANE_420_UNORM:
+			return 2;
+		default:
+			return 1;
+	}
+}
+
 static inline uint32_t VULKAN_INTERNAL_BytesPerPixel(VkFormat format)
 {
 	switch (format)
@@ -2110,32 +2473,207 @@ static inline VkDeviceSize VULKAN_INTERNAL_NextHighestAlignment(
 	return align * ((n + align - 1) / align);
 }
 
+/* n must be non-zero */
+static inline uint32_t VULKAN_INTERNAL_MostSignificantBit(uint64_t n)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 63 - __builtin_clzll(n);
+#else
+	uint32_t index = 0;
+	while (n >>= 1)
+	{
+		index += 1;
+	}
+	return index;
+#endif
+}
+
+/* n must be non-zero */
+static inline uint32_t VULKAN_INTERNAL_LeastSignificantBit(uint64_t n)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(n);
+#else
+	uint32_t index = 0;
+	while ((n & 1) == 0)
+	{
+		n >>= 1;
+		index += 1;
+	}
+	return index;
+#endif
+}
+
+static inline void VULKAN_INTERNAL_GetFreeListIndices(
+	VkDeviceSize size,
+	uint32_t *firstLevelIndex,
+	uint32_t *secondLevelIndex
+) {
+	uint32_t msb;
+
+	if (size < FREE_LIST_SECOND_LEVEL_COUNT)
+	{
+		/* tiny sizes map linearly into the first list */
+		*firstLevelIndex = 0;
+		*secondLevelIndex = (uint32_t) size;
+	}
+	else
+	{
+		msb = VULKAN_INTERNAL_MostSignificantBit(size);
+		*firstLevelIndex = msb - FREE_LIST_SECOND_LEVEL_BITS + 1;
+		*secondLevelIndex = (uint32_t) (size >> (msb - FREE_LIST_SECOND_LEVEL_BITS)) ^ FREE_LIST_SECOND_LEVEL_COUNT;
+	}
+}
+
+static void VULKAN_INTERNAL_InsertFreeListRegion(
+	VulkanMemorySubAllocator *allocator,
+	VulkanMemoryFreeRegion *freeRegion
+) {
+	uint32_t firstLevelIndex, secondLevelIndex;
+
+	VULKAN_INTERNAL_GetFreeListIndices(
+		freeRegion->size,
+		&firstLevelIndex,
+		&secondLevelIndex
+	);
+
+	freeRegion->firstLevelIndex = firstLevelIndex;
+	freeRegion->secondLevelIndex = secondLevelIndex;
+	freeRegion->prev = NULL;
+	freeRegion->next = allocator->freeLists[firstLevelIndex][secondLevelIndex];
+
+	if (freeRegion->next != NULL)
+	{
+		freeRegion->next->prev = freeRegion;
+	}
+
+	allocator->freeLists[firstLevelIndex][secondLevelIndex] = freeRegion;
+	allocator->freeListFirstLevelBitmask |= (uint64_t) 1 << firstLevelIndex;
+	allocator->freeListSecondLevelBitmasks[firstLevelIndex] |= 1u << secondLevelIndex;
+	allocator->freeRegionCount += 1;
+}
+
+static void VULKAN_INTERNAL_RemoveFreeListRegion(
+	VulkanMemorySubAllocator *allocator,
+	VulkanMemoryFreeRegion *freeRegion
+) {
+	uint32_t firstLevelIndex = freeRegion->firstLevelIndex;
+	uint32_t secondLevelIndex = freeRegion->secondLevelIndex;
+
+	if (freeRegion->prev != NULL)
+	{
+		freeRegion->prev->next = freeRegion->next;
+	}
+	else
+	{
+		allocator->freeLists[firstLevelIndex][secondLevelIndex] = freeRegion->next;
+	}
+
+	if (freeRegion->next != NULL)
+	{
+		freeRegion->next->prev = freeRegion->prev;
+	}
+
+	/* the size class is now empty, clear its bits */
+	if (allocator->freeLists[firstLevelIndex][secondLevelIndex] == NULL)
+	{
+		allocator->freeListSecondLevelBitmasks[firstLevelIndex] &= ~(1u << secondLevelIndex);
+
+		if (allocator->freeListSecondLevelBitmasks[firstLevelIndex] == 0)
+		{
+			allocator->freeListFirstLevelBitmask &= ~((uint64_t) 1 << firstLevelIndex);
+		}
+	}
+
+	freeRegion->prev = NULL;
+	freeRegion->next = NULL;
+	allocator->freeRegionCount -= 1;
+}
+
+/* Returns the head of the smallest non-empty size class
+ * whose regions are all at least size bytes, or NULL.
+ */
+static VulkanMemoryFreeRegion* VULKAN_INTERNAL_FindFreeListRegion(
+	VulkanMemorySubAllocator *allocator,
+	VkDeviceSize size
+) {
+	uint32_t firstLevelIndex, secondLevelIndex;
+	uint32_t secondLevelBitmask;
+	uint64_t firstLevelBitmask;
+
+	/* round up to the next size class boundary so any region in the class fits */
+	if (size >= FREE_LIST_SECOND_LEVEL_COUNT)
+	{
+		size += ((VkDeviceSize) 1 << (VULKAN_INTERNAL_MostSignificantBit(size) - FREE_LIST_SECOND_LEVEL_BITS)) - 1;
+	}
+
+	VULKAN_INTERNAL_GetFreeListIndices(
+		size,
+		&firstLevelIndex,
+		&secondLevelIndex
+	);
+
+	secondLevelBitmask =
+		allocator->freeListSecondLevelBitmasks[firstLevelIndex] &
+		(~0u << secondLevelIndex);
+
+	if (secondLevelBitmask == 0)
+	{
+		/* nothing big enough at this level, take the next non-empty level */
+		if (firstLevelIndex + 1 >= FREE_LIST_FIRST_LEVEL_COUNT)
+		{
+			return NULL;
+		}
+
+		firstLevelBitmask =
+			allocator->freeListFirstLevelBitmask &
+			(~((uint64_t) 0) << (firstLevelIndex + 1));
+
+		if (firstLevelBitmask == 0)
+		{
+			return NULL;
+		}
+
+		firstLevelIndex = VULKAN_INTERNAL_LeastSignificantBit(firstLevelBitmask);
+		secondLevelBitmask = allocator->freeListSecondLevelBitmasks[firstLevelIndex];
+	}
+
+	secondLevelIndex = VULKAN_INTERNAL_LeastSignificantBit(secondLevelBitmask);
+
+	return allocator->freeLists[firstLevelIndex][secondLevelIndex];
+}
+
 static void VULKAN_INTERNAL_MakeMemoryUnavailable(
 	VulkanRenderer* renderer,
 	VulkanMemoryAllocation *allocation
 ) {
-	uint32_t i, j;
-	VulkanMemoryFreeRegion *freeRegion;
+	uint32_t i;
 
 	allocation->availableForAllocation = 0;
 
 	for (i = 0; i < allocation->freeRegionCount; i += 1)
 	{
-		freeRegion = allocation->freeRegions[i];
+		VULKAN_INTERNAL_RemoveFreeListRegion(
+			allocation->allocator,
+			allocation->freeRegions[i]
+		);
+	}
+}
 
-		/* close the gap in the sorted list */
-		if (allocation->allocator->sortedFreeRegionCount > 1)
-		{
-			for (j = freeRegion->sortedIndex; j < allocation->allocator->sortedFreeRegionCount - 1; j += 1)
-			{
-				allocation->allocator->sortedFreeRegions[j] =
-					allocation->allocator->sortedFreeRegions[j + 1];
+static void VULKAN_INTERNAL_MakeMemoryAvailable(
+	VulkanRenderer* renderer,
+	VulkanMemoryAllocation *allocation
+) {
+	uint32_t i;
 
-				allocation->allocator->sortedFreeRegions[j]->sortedIndex = j;
-			}
-		}
+	allocation->availableForAllocation = 1;
 
-		allocation->allocator->sortedFreeRegionCount -= 1;
+	for (i = 0; i < allocation->freeRegionCount; i += 1)
+	{
+		VULKAN_INTERNAL_InsertFreeListRegion(
+			allocation->allocator,
+			allocation->freeRegions[i]
+		);
 	}
 }
 
@@ -2143,25 +2681,16 @@ static void VULKAN_INTERNAL_RemoveMemoryFreeRegion(
 	VulkanRenderer *renderer,
 	VulkanMemoryFreeRegion *freeRegion
 ) {
-	uint32_t i;
+	SDL_mutex *lock = freeRegion->allocation->allocator->lock;
 
-	SDL_LockMutex(renderer->allocatorLock);
+	SDL_LockMutex(lock);
 
 	if (freeRegion->allocation->availableForAllocation)
 	{
-		/* close the gap in the sorted list */
-		if (freeRegion->allocation->allocator->sortedFreeRegionCount > 1)
-		{
-			for (i = freeRegion->sortedIndex; i < freeRegion->allocation->allocator->sortedFreeRegionCount - 1; i += 1)
-			{
-				freeRegion->allocation->allocator->sortedFreeRegions[i] =
-					freeRegion->allocation->allocator->sortedFreeRegions[i + 1];
-
-				freeRegion->allocation->allocator->sortedFreeRegions[i]->sortedIndex = i;
-			}
-		}
-
-		freeRegion->allocation->allocator->sortedFreeRegionCount -= 1;
+		VULKAN_INTERNAL_RemoveFreeListRegion(
+			freeRegion->allocation->allocator,
+			freeRegion
+		);
 	}
 
 	/* close the gap in the buffer list */
@@ -2180,7 +2709,7 @@ static void VULKAN_INTERNAL_RemoveMemoryFreeRegion(
 
 	SDL_free(freeRegion);
 
-	SDL_UnlockMutex(renderer->allocatorLock);
+	SDL_UnlockMutex(lock);
 }
 
 static void VULKAN_INTERNAL_NewMemoryFreeRegion(
@@ -2191,10 +2720,9 @@ static void VULKAN_INTERNAL_NewMemoryFreeRegion(
 ) {
 	VulkanMemoryFreeRegion *newFreeRegion;
 	VkDeviceSize newOffset, newSize;
-	int32_t insertionIndex = 0;
 	int32_t i;
 
-	SDL_LockMutex(renderer->allocatorLock);
+	SDL_LockMutex(allocation->allocator->lock);
 
 	/* look for an adjacent region to merge */
 	for (i = allocation->freeRegionCount - 1; i >= 0; i -= 1)
@@ -2208,7 +2736,7 @@ static void VULKAN_INTERNAL_NewMemoryFreeRegion(
 			VULKAN_INTERNAL_RemoveMemoryFreeRegion(renderer, allocation->freeRegions[i]);
 			VULKAN_INTERNAL_NewMemoryFreeRegion(renderer, allocation, newOffset, newSize);
 
-			SDL_UnlockMutex(renderer->allocatorLock);
+			SDL_UnlockMutex(allocation->allocator->lock);
 			return;
 		}
 
@@ -2221,7 +2749,7 @@ static void VULKAN_INTERNAL_NewMemoryFreeRegion(
 			VULKAN_INTERNAL_RemoveMemoryFreeRegion(renderer, allocation->freeRegions[i]);
 			VULKAN_INTERNAL_NewMemoryFreeRegion(renderer, allocation, newOffset, newSize);
 
-			SDL_UnlockMutex(renderer->allocatorLock);
+			SDL_UnlockMutex(allocation->allocator->lock);
 			return;
 		}
 	}
@@ -2247,44 +2775,18 @@ static void VULKAN_INTERNAL_NewMemoryFreeRegion(
 	allocation->freeRegions[allocation->freeRegionCount - 1] = newFreeRegion;
 	newFreeRegion->allocationIndex = allocation->freeRegionCount - 1;
 
+	newFreeRegion->prev = NULL;
+	newFreeRegion->next = NULL;
+
 	if (allocation->availableForAllocation)
 	{
-		for (i = 0; i < allocation->allocator->sortedFreeRegionCount; i += 1)
-		{
-			if (allocation->allocator->sortedFreeRegions[i]->size < size)
-			{
-				/* this is where the new region should go */
-				break;
-			}
-
-			insertionIndex += 1;
-		}
-
-		if (allocation->allocator->sortedFreeRegionCount + 1 > allocation->allocator->sortedFreeRegionCapacity)
-		{
-			allocation->allocator->sortedFreeRegionCapacity *= 2;
-			allocation->allocator->sortedFreeRegions = SDL_realloc(
-				allocation->allocator->sortedFreeRegions,
-				sizeof(VulkanMemoryFreeRegion*) * allocation->allocator->sortedFreeRegionCapacity
-			);
-		}
-
-		/* perform insertion sort */
-		if (allocation->allocator->sortedFreeRegionCount > 0 && insertionIndex != allocation->allocator->sortedFreeRegionCount)
-		{
-			for (i = allocation->allocator->sortedFreeRegionCount; i > insertionIndex && i > 0; i -= 1)
-			{
-				allocation->allocator->sortedFreeRegions[i] = allocation->allocator->sortedFreeRegions[i - 1];
-				allocation->allocator->sortedFreeRegions[i]->sortedIndex = i;
-			}
-		}
-
-		allocation->allocator->sortedFreeRegionCount += 1;
-		allocation->allocator->sortedFreeRegions[insertionIndex] = newFreeRegion;
-		newFreeRegion->sortedIndex = insertionIndex;
+		VULKAN_INTERNAL_InsertFreeListRegion(
+			allocation->allocator,
+			newFreeRegion
+		);
 	}
 
-	SDL_UnlockMutex(renderer->allocatorLock);
+	SDL_UnlockMutex(allocation->allocator->lock);
 }
 
 static VulkanMemoryUsedRegion* VULKAN_INTERNAL_NewMemoryUsedRegion(
@@ -2298,7 +2800,7 @@ static VulkanMemoryUsedRegion* VULKAN_INTERNAL_NewMemoryUsedRegion(
 ) {
 	VulkanMemoryUsedRegion *memoryUsedRegion;
 
-	SDL_LockMutex(renderer->allocatorLock);
+	SDL_LockMutex(allocation->allocator->lock);
 
 	if (allocation->usedRegionCount == allocation->usedRegionCapacity)
 	{
@@ -2316,13 +2818,15 @@ static VulkanMemoryUsedRegion* VULKAN_INTERNAL_NewMemoryUsedRegion(
 	memoryUsedRegion->resourceOffset = resourceOffset;
 	memoryUsedRegion->resourceSize = resourceSize;
 	memoryUsedRegion->alignment = alignment;
+	memoryUsedRegion->defragMoved = 0;
 
 	allocation->usedSpace += size;
+	allocation->empty = 0;
 
 	allocation->usedRegions[allocation->usedRegionCount] = memoryUsedRegion;
 	allocation->usedRegionCount += 1;
 
-	SDL_UnlockMutex(renderer->allocatorLock);
+	SDL_UnlockMutex(allocation->allocator->lock);
 
 	return memoryUsedRegion;
 }
@@ -2331,9 +2835,29 @@ static void VULKAN_INTERNAL_RemoveMemoryUsedRegion(
 	VulkanRenderer *renderer,
 	VulkanMemoryUsedRegion *usedRegion
 ) {
+	SDL_mutex *lock = usedRegion->allocation->allocator->lock;
 	uint32_t i;
 
-	SDL_LockMutex(renderer->allocatorLock);
+	SDL_LockMutex(lock);
+
+	/* arena and aliased memory is never handed back piecemeal,
+	 * the block resets or gets freed once it is empty
+	 */
+	if (usedRegion->allocation->transient || usedRegion->allocation->aliased)
+	{
+		usedRegion->allocation->usedSpace -= usedRegion->size;
+		usedRegion->allocation->usedRegionCount -= 1;
+
+		if (usedRegion->allocation->usedRegionCount == 0)
+		{
+			usedRegion->allocation->transientOffset = 0;
+		}
+
+		SDL_free(usedRegion);
+
+		SDL_UnlockMutex(lock);
+		return;
+	}
 
 	for (i = 0; i < usedRegion->allocation->usedRegionCount; i += 1)
 	{
@@ -2362,13 +2886,16 @@ static void VULKAN_INTERNAL_RemoveMemoryUsedRegion(
 
 	if (!usedRegion->allocation->dedicated)
 	{
+		/* renderer-wide, so the type lock alone doesn't cover these */
+		SDL_LockMutex(renderer->allocatorLock);
 		renderer->needDefrag = 1;
 		renderer->defragTimestamp = SDL_GetTicks64() + DEFRAG_TIME; /* reset timer so we batch defrags */
+		SDL_UnlockMutex(renderer->allocatorLock);
 	}
 
 	SDL_free(usedRegion);
 
-	SDL_UnlockMutex(renderer->allocatorLock);
+	SDL_UnlockMutex(lock);
 }
 
 static uint8_t VULKAN_INTERNAL_FindMemoryType(
@@ -2452,8 +2979,132 @@ static uint8_t VULKAN_INTERNAL_FindImageMemoryRequirements(
 	);
 }
 
-static void VULKAN_INTERNAL_DeallocateMemory(
-	VulkanRenderer *renderer,
+/* Memory Budget */
+
+/* Call with allocatorLock held */
+static void VULKAN_INTERNAL_QueryMemoryBudget(
+	VulkanRenderer *renderer
+) {
+	VkPhysicalDeviceMemoryProperties2KHR memoryProperties;
+	VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties;
+	uint32_t i;
+
+	if (renderer->supports.EXT_memory_budget)
+	{
+		budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+		budgetProperties.pNext = NULL;
+
+		memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+		memoryProperties.pNext = &budgetProperties;
+
+		renderer->vkGetPhysicalDeviceMemoryProperties2KHR(
+			renderer->physicalDevice,
+			&memoryProperties
+		);
+
+		for (i = 0; i < renderer->memoryProperties.memoryHeapCount; i += 1)
+		{
+			renderer->heapBudget[i] = budgetProperties.heapBudget[i];
+			renderer->heapUsageAtBudgetQuery[i] = budgetProperties.heapUsage[i];
+			renderer->heapAllocatedBytesAtBudgetQuery[i] = renderer->heapAllocatedBytes[i];
+		}
+	}
+	else
+	{
+		/* No driver figures, so assume we get most of the heap and nobody else uses it */
+		for (i = 0; i < renderer->memoryProperties.memoryHeapCount; i += 1)
+		{
+			renderer->heapBudget[i] = renderer->memoryProperties.memoryHeaps[i].size / 10 * 8;
+			renderer->heapUsageAtBudgetQuery[i] = renderer->heapAllocatedBytes[i];
+			renderer->heapAllocatedBytesAtBudgetQuery[i] = renderer->heapAllocatedBytes[i];
+		}
+	}
+}
+
+static VkDeviceSize VULKAN_INTERNAL_GetHeapUsage(
+	VulkanRenderer *renderer,
+	uint32_t heapIndex
+) {
+	VkDeviceSize usage =
+		renderer->heapUsageAtBudgetQuery[heapIndex] +
+		renderer->heapAllocatedBytes[heapIndex];
+
+	if (usage < renderer->heapAllocatedBytesAtBudgetQuery[heapIndex])
+	{
+		return 0;
+	}
+
+	return usage - renderer->heapAllocatedBytesAtBudgetQuery[heapIndex];
+}
+
+static void VULKAN_INTERNAL_UpdateMemoryPressure(
+	VulkanRenderer *renderer,
+	VulkanMemoryPressureReport *report
+) {
+	VkDeviceSize usage;
+	uint32_t i, level;
+
+	report->heapCount = 0;
+
+	SDL_LockMutex(renderer->allocatorLock);
+
+	VULKAN_INTERNAL_QueryMemoryBudget(renderer);
+
+	for (i = 0; i < renderer->memoryProperties.memoryHeapCount; i += 1)
+	{
+		usage = VULKAN_INTERNAL_GetHeapUsage(renderer, i);
+
+		level = 0;
+		while (	level < renderer->memoryPressureThresholdCount &&
+			usage >= (VkDeviceSize) (renderer->memoryPressureThresholds[level] * renderer->heapBudget[i])	)
+		{
+			level += 1;
+		}
+
+		if (level != renderer->memoryPressureLevels[i])
+		{
+			renderer->memoryPressureLevels[i] = level;
+			report->heapIndices[report->heapCount] = i;
+			report->levels[report->heapCount] = level;
+			report->usages[report->heapCount] = usage;
+			report->budgets[report->heapCount] = renderer->heapBudget[i];
+			report->heapCount += 1;
+		}
+	}
+
+	report->callback = renderer->memoryPressureCallback;
+	report->userdata = renderer->memoryPressureUserdata;
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+}
+
+/* The callback may well destroy resources or wait on threads that submit,
+ * so call this without holding the allocator or submit locks.
+ */
+static void VULKAN_INTERNAL_ReportMemoryPressure(
+	VulkanMemoryPressureReport *report
+) {
+	uint32_t i;
+
+	if (report->callback == NULL)
+	{
+		return;
+	}
+
+	for (i = 0; i < report->heapCount; i += 1)
+	{
+		report->callback(
+			report->heapIndices[i],
+			report->levels[i],
+			report->usages[i],
+			report->budgets[i],
+			report->userdata
+		);
+	}
+}
+
+static void VULKAN_INTERNAL_DeallocateMemory(
+	VulkanRenderer *renderer,
 	VulkanMemorySubAllocator *allocator,
 	uint32_t allocationIndex
 ) {
@@ -2461,13 +3112,40 @@ static void VULKAN_INTERNAL_DeallocateMemory(
 
 	VulkanMemoryAllocation *allocation = allocator->allocations[allocationIndex];
 
+	SDL_LockMutex(allocator->lock);
 	SDL_LockMutex(renderer->allocatorLock);
 
-	for (i = 0; i < allocation->freeRegionCount; i += 1)
+	/* the block emptied out before incremental defrag finished with it */
+	if (renderer->defragAllocation == allocation)
+	{
+		renderer->defragAllocation = NULL;
+		renderer->defragBytesRemaining = 0;
+		renderer->defragResourcesRemaining = 0;
+	}
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	if (allocation->transient)
+	{
+		for (i = 0; i < allocator->transientBlockCount; i += 1)
+		{
+			if (allocator->transientBlocks[i] == allocation)
+			{
+				allocator->transientBlocks[i] = allocator->transientBlocks[allocator->transientBlockCount - 1];
+				allocator->transientBlockCount -= 1;
+				break;
+			}
+		}
+
+		allocator->currentTransientBlock = 0;
+	}
+
+	/* iterate backwards, removal moves the last region into the hole */
+	for (i = allocation->freeRegionCount; i > 0; i -= 1)
 	{
 		VULKAN_INTERNAL_RemoveMemoryFreeRegion(
 			renderer,
-			allocation->freeRegions[i]
+			allocation->freeRegions[i - 1]
 		);
 	}
 	SDL_free(allocation->freeRegions);
@@ -2483,6 +3161,12 @@ static void VULKAN_INTERNAL_DeallocateMemory(
 		NULL
 	);
 
+	SDL_LockMutex(renderer->allocatorLock);
+	renderer->heapAllocatedBytes[
+		renderer->memoryProperties.memoryTypes[allocator->memoryTypeIndex].heapIndex
+	] -= allocation->size;
+	SDL_UnlockMutex(renderer->allocatorLock);
+
 	SDL_DestroyMutex(allocation->memoryLock);
 	SDL_free(allocation);
 
@@ -2493,7 +3177,87 @@ static void VULKAN_INTERNAL_DeallocateMemory(
 
 	allocator->allocationCount -= 1;
 
+	SDL_UnlockMutex(allocator->lock);
+}
+
+/* Frees empty blocks, except that up to retainedEmptyBlocksPerType
+ * blocks per type may be kept for reuse until their release delay passes
+ * or their heap goes over budget. This avoids freeing and reallocating
+ * whole blocks when usage dips for a few frames.
+ */
+static void VULKAN_INTERNAL_ReleaseEmptyMemory(
+	VulkanRenderer *renderer
+) {
+	VulkanMemorySubAllocator *allocator;
+	VulkanMemoryAllocation *allocation;
+	uint32_t retainLimit, releaseSubmits, releaseMilliseconds;
+	uint32_t retainedCount, heapIndex;
+	uint64_t now = SDL_GetTicks64();
+	uint8_t overBudget, expired;
+	int32_t i, j;
+
+	SDL_LockMutex(renderer->allocatorLock);
+	retainLimit = renderer->retainedEmptyBlocksPerType;
+	releaseSubmits = renderer->emptyBlockReleaseSubmits;
+	releaseMilliseconds = renderer->emptyBlockReleaseMilliseconds;
 	SDL_UnlockMutex(renderer->allocatorLock);
+
+	for (i = 0; i < VK_MAX_MEMORY_TYPES; i += 1)
+	{
+		allocator = &renderer->memoryAllocator->subAllocators[i];
+		retainedCount = 0;
+
+		SDL_LockMutex(allocator->lock);
+
+		for (j = allocator->allocationCount - 1; j >= 0; j -= 1)
+		{
+			allocation = allocator->allocations[j];
+
+			if (allocation->usedRegionCount > 0)
+			{
+				continue;
+			}
+
+			if (!allocation->empty)
+			{
+				allocation->empty = 1;
+				allocation->emptyTimestamp = now;
+				allocation->emptySubmitIndex = renderer->submitIndex;
+			}
+
+			/* dedicated and defragmented blocks can't take new resources,
+			 * empty transient blocks can be reused by the arena
+			 */
+			if (	retainedCount < retainLimit &&
+				(	allocation->transient ||
+					(!allocation->dedicated && allocation->availableForAllocation)	)	)
+			{
+				heapIndex = renderer->memoryProperties.memoryTypes[i].heapIndex;
+
+				SDL_LockMutex(renderer->allocatorLock);
+				overBudget = VULKAN_INTERNAL_GetHeapUsage(renderer, heapIndex) > renderer->heapBudget[heapIndex];
+				SDL_UnlockMutex(renderer->allocatorLock);
+
+				expired =
+					(releaseSubmits > 0 && renderer->submitIndex - allocation->emptySubmitIndex >= releaseSubmits) ||
+					(releaseMilliseconds > 0 && now - allocation->emptyTimestamp >= releaseMilliseconds);
+
+				if (!overBudget && !expired)
+				{
+					retainedCount += 1;
+					continue;
+				}
+			}
+
+			VULKAN_INTERNAL_DeallocateMemory(
+				renderer,
+				allocator,
+				j
+			);
+		}
+
+		SDL_UnlockMutex(allocator->lock);
+	}
 }
 
 static uint8_t VULKAN_INTERNAL_AllocateMemory(
@@ -2520,6 +3284,13 @@ static uint8_t VULKAN_INTERNAL_AllocateMemory(
 	allocation->size = allocationSize;
 	allocation->freeSpace = 0; /* added by FreeRegions */
 	allocation->usedSpace = 0; /* added by UsedRegions */
+	allocation->transient = 0;
+	allocation->transientOffset = 0;
+	allocation->aliased = 0;
+	allocation->empty = 0;
+	allocation->defragSkipped = 0;
+	allocation->emptyTimestamp = 0;
+	allocation->emptySubmitIndex = 0;
 	allocation->memoryLock = SDL_CreateMutex();
 
 	allocator->allocationCount += 1;
@@ -2577,6 +3348,12 @@ static uint8_t VULKAN_INTERNAL_AllocateMemory(
 		return 0;
 	}
 
+	SDL_LockMutex(renderer->allocatorLock);
+	renderer->heapAllocatedBytes[
+		renderer->memoryProperties.memoryTypes[memoryTypeIndex].heapIndex
+	] += allocationSize;
+	SDL_UnlockMutex(renderer->allocatorLock);
+
 	/* persistent mapping for host memory */
 	if (isHostVisible)
 	{
@@ -2606,6 +3383,98 @@ static uint8_t VULKAN_INTERNAL_AllocateMemory(
 	return 1;
 }
 
+/* Transient resources bump allocate out of a ring of blocks.
+ * A block is recycled as a whole once every resource in it has been destroyed,
+ * which only happens after the command buffers using them have completed.
+ * Call with the sub-allocator lock held.
+ */
+static VulkanMemoryUsedRegion* VULKAN_INTERNAL_NewTransientMemoryUsedRegion(
+	VulkanRenderer *renderer,
+	uint32_t memoryTypeIndex,
+	VkMemoryRequirements2KHR *memoryRequirements,
+	VkDeviceSize resourceSize,
+	uint8_t isHostVisible
+) {
+	VulkanMemorySubAllocator *allocator = &renderer->memoryAllocator->subAllocators[memoryTypeIndex];
+	VulkanMemoryAllocation *allocation = NULL;
+	VulkanMemoryUsedRegion *usedRegion;
+	VkDeviceSize requiredSize = memoryRequirements->memoryRequirements.size;
+	VkDeviceSize alignment = memoryRequirements->memoryRequirements.alignment;
+	VkDeviceSize alignedOffset = 0;
+	VkDeviceSize blockSize;
+	uint32_t i, blockIndex;
+
+	/* try the current block first, then any block that has emptied out */
+	for (i = 0; i < allocator->transientBlockCount; i += 1)
+	{
+		blockIndex = (allocator->currentTransientBlock + i) % allocator->transientBlockCount;
+
+		alignedOffset = VULKAN_INTERNAL_NextHighestAlignment(
+			allocator->transientBlocks[blockIndex]->transientOffset,
+			alignment
+		);
+
+		if (alignedOffset + requiredSize <= allocator->transientBlocks[blockIndex]->size)
+		{
+			allocation = allocator->transientBlocks[blockIndex];
+			allocator->currentTransientBlock = blockIndex;
+			break;
+		}
+	}
+
+	if (allocation == NULL)
+	{
+		blockSize = TRANSIENT_BLOCK_SIZE;
+		if (requiredSize > blockSize)
+		{
+			blockSize = VULKAN_INTERNAL_NextHighestAlignment(requiredSize, ALLOCATION_INCREMENT);
+		}
+
+		/* allocate as dedicated so the block stays out of the free lists */
+		if (!VULKAN_INTERNAL_AllocateMemory(
+			renderer,
+			VK_NULL_HANDLE,
+			VK_NULL_HANDLE,
+			memoryTypeIndex,
+			blockSize,
+			1,
+			isHostVisible,
+			&allocation
+		)) {
+			return NULL;
+		}
+
+		/* the arena keeps its own offset instead of free regions */
+		VULKAN_INTERNAL_RemoveMemoryFreeRegion(renderer, allocation->freeRegions[0]);
+		allocation->transient = 1;
+
+		allocator->transientBlocks = SDL_realloc(
+			allocator->transientBlocks,
+			sizeof(VulkanMemoryAllocation*) * (allocator->transientBlockCount + 1)
+		);
+		allocator->transientBlocks[allocator->transientBlockCount] = allocation;
+		allocator->currentTransientBlock = allocator->transientBlockCount;
+		allocator->transientBlockCount += 1;
+
+		alignedOffset = 0;
+	}
+
+	usedRegion = SDL_malloc(sizeof(VulkanMemoryUsedRegion));
+	usedRegion->allocation = allocation;
+	usedRegion->offset = allocation->transientOffset;
+	usedRegion->size = (alignedOffset + requiredSize) - allocation->transientOffset;
+	usedRegion->resourceOffset = alignedOffset;
+	usedRegion->resourceSize = resourceSize;
+	usedRegion->alignment = alignment;
+	usedRegion->defragMoved = 0;
+
+	allocation->transientOffset = alignedOffset + requiredSize;
+	allocation->usedSpace += usedRegion->size;
+	allocation->usedRegionCount += 1;
+
+	return usedRegion;
+}
+
 static uint8_t VULKAN_INTERNAL_BindBufferMemory(
 	VulkanRenderer *renderer,
 	VulkanMemoryUsedRegion *usedRegion,
@@ -2659,6 +3528,7 @@ static uint8_t VULKAN_INTERNAL_BindResourceMemory(
 	uint32_t memoryTypeIndex,
 	VkMemoryRequirements2KHR* memoryRequirements,
 	uint8_t forceDedicated,
+	uint8_t transient,
 	VkDeviceSize resourceSize, /* may be different from requirements size! */
 	VkBuffer buffer, /* may be VK_NULL_HANDLE */
 	VkImage image, /* may be VK_NULL_HANDLE */
@@ -2672,6 +3542,7 @@ static uint8_t VULKAN_INTERNAL_BindResourceMemory(
 	VkDeviceSize requiredSize, allocationSize;
 	VkDeviceSize alignedOffset;
 	uint32_t newRegionSize, newRegionOffset;
+	uint32_t heapIndex;
 	uint8_t shouldAllocDedicated = forceDedicated;
 	uint8_t isHostVisible, allocationResult;
 
@@ -2689,21 +3560,99 @@ static uint8_t VULKAN_INTERNAL_BindResourceMemory(
 		return 0;
 	}
 
-	SDL_LockMutex(renderer->allocatorLock);
+	SDL_LockMutex(allocator->lock);
 
-	/* find the largest free region and use it */
-	if (!shouldAllocDedicated && allocator->sortedFreeRegionCount > 0)
+	/* Transient resources skip the free lists entirely. This wins over
+	 * forceDedicated: render targets are dedicated so defrag never moves
+	 * them, and arena blocks are never defragmented either. Without
+	 * KHR_dedicated_allocation the driver cannot require a dedicated block.
+	 */
+	if (transient)
 	{
-		region = allocator->sortedFreeRegions[0];
-		allocation = region->allocation;
-
-		alignedOffset = VULKAN_INTERNAL_NextHighestAlignment(
-			region->offset,
-			memoryRequirements->memoryRequirements.alignment
+		usedRegion = VULKAN_INTERNAL_NewTransientMemoryUsedRegion(
+			renderer,
+			memoryTypeIndex,
+			memoryRequirements,
+			resourceSize,
+			isHostVisible
 		);
 
-		if (alignedOffset + requiredSize <= region->offset + region->size)
+		SDL_UnlockMutex(allocator->lock);
+
+		/* Responsibility of the caller to handle being out of memory */
+		if (usedRegion == NULL)
+		{
+			return 2;
+		}
+
+		usedRegion->isBuffer = buffer != VK_NULL_HANDLE;
+
+		if (buffer != VK_NULL_HANDLE)
+		{
+			if (!VULKAN_INTERNAL_BindBufferMemory(
+				renderer,
+				usedRegion,
+				usedRegion->resourceOffset,
+				buffer
+			)) {
+				VULKAN_INTERNAL_RemoveMemoryUsedRegion(
+					renderer,
+					usedRegion
+				);
+
+				return 0;
+			}
+		}
+		else if (image != VK_NULL_HANDLE)
+		{
+			if (!VULKAN_INTERNAL_BindImageMemory(
+				renderer,
+				usedRegion,
+				usedRegion->resourceOffset,
+				image
+			)) {
+				VULKAN_INTERNAL_RemoveMemoryUsedRegion(
+					renderer,
+					usedRegion
+				);
+
+				return 0;
+			}
+		}
+
+		*pMemoryUsedRegion = usedRegion;
+		return 1;
+	}
+
+	/* find a good-fit free region and use it */
+	if (!shouldAllocDedicated)
+	{
+		region = VULKAN_INTERNAL_FindFreeListRegion(allocator, requiredSize);
+
+		/* the size class guarantees the size but not the alignment padding,
+		 * so retry with the worst case padding which always fits
+		 */
+		if (	region != NULL &&
+			VULKAN_INTERNAL_NextHighestAlignment(
+				region->offset,
+				memoryRequirements->memoryRequirements.alignment
+			) + requiredSize > region->offset + region->size	)
+		{
+			region = VULKAN_INTERNAL_FindFreeListRegion(
+				allocator,
+				requiredSize + memoryRequirements->memoryRequirements.alignment - 1
+			);
+		}
+
+		if (region != NULL)
 		{
+			allocation = region->allocation;
+
+			alignedOffset = VULKAN_INTERNAL_NextHighestAlignment(
+				region->offset,
+				memoryRequirements->memoryRequirements.alignment
+			);
+
 			usedRegion = VULKAN_INTERNAL_NewMemoryUsedRegion(
 				renderer,
 				allocation,
@@ -2719,7 +3668,7 @@ static uint8_t VULKAN_INTERNAL_BindResourceMemory(
 			newRegionSize = region->size - ((alignedOffset - region->offset) + requiredSize);
 			newRegionOffset = alignedOffset + requiredSize;
 
-			/* remove and add modified region to re-sort */
+			/* remove and add modified region to move it to its new size class */
 			VULKAN_INTERNAL_RemoveMemoryFreeRegion(renderer, region);
 
 			/* if size is 0, no need to re-insert */
@@ -2733,7 +3682,7 @@ static uint8_t VULKAN_INTERNAL_BindResourceMemory(
 				);
 			}
 
-			SDL_UnlockMutex(renderer->allocatorLock);
+			SDL_UnlockMutex(allocator->lock);
 
 			if (buffer != VK_NULL_HANDLE)
 			{
@@ -2790,6 +3739,16 @@ static uint8_t VULKAN_INTERNAL_BindResourceMemory(
 		allocationSize = allocator->nextAllocationSize;
 	}
 
+	/* don't reserve a whole block we may never fill if it would put the heap over budget */
+	heapIndex = renderer->memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+	SDL_LockMutex(renderer->allocatorLock);
+	if (	!shouldAllocDedicated &&
+		VULKAN_INTERNAL_GetHeapUsage(renderer, heapIndex) + allocationSize > renderer->heapBudget[heapIndex]	)
+	{
+		allocationSize = VULKAN_INTERNAL_NextHighestAlignment(requiredSize, ALLOCATION_INCREMENT);
+	}
+	SDL_UnlockMutex(renderer->allocatorLock);
+
 	allocationResult = VULKAN_INTERNAL_AllocateMemory(
 		renderer,
 		buffer,
@@ -2804,7 +3763,7 @@ static uint8_t VULKAN_INTERNAL_BindResourceMemory(
 	/* Uh oh, we're out of memory */
 	if (allocationResult == 0)
 	{
-		SDL_UnlockMutex(renderer->allocatorLock);
+		SDL_UnlockMutex(allocator->lock);
 
 		/* Responsibility of the caller to handle being out of memory */
 		return 2;
@@ -2839,7 +3798,7 @@ static uint8_t VULKAN_INTERNAL_BindResourceMemory(
 		);
 	}
 
-	SDL_UnlockMutex(renderer->allocatorLock);
+	SDL_UnlockMutex(allocator->lock);
 
 	if (buffer != VK_NULL_HANDLE)
 	{
@@ -2882,6 +3841,8 @@ static uint8_t VULKAN_INTERNAL_BindMemoryForImage(
 	VulkanRenderer* renderer,
 	VkImage image,
 	uint8_t isRenderTarget,
+	uint8_t transient,
+	uint8_t lazilyAllocated,
 	VulkanMemoryUsedRegion** usedRegion
 ) {
 	uint8_t bindResult = 0;
@@ -2894,6 +3855,43 @@ static uint8_t VULKAN_INTERNAL_BindMemoryForImage(
 		NULL
 	};
 
+	/* Tilers may never commit lazily allocated memory. It gets its own
+	 * allocation so the commitment isn't tied to other resources.
+	 * Most desktop GPUs have no such memory type, which is fine.
+	 */
+	if (lazilyAllocated)
+	{
+		while (VULKAN_INTERNAL_FindImageMemoryRequirements(
+			renderer,
+			image,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT,
+			0,
+			&memoryRequirements,
+			&memoryTypeIndex
+		)) {
+			bindResult = VULKAN_INTERNAL_BindResourceMemory(
+				renderer,
+				memoryTypeIndex,
+				&memoryRequirements,
+				1,
+				0,
+				memoryRequirements.memoryRequirements.size,
+				VK_NULL_HANDLE,
+				image,
+				usedRegion
+			);
+
+			if (bindResult == 1)
+			{
+				return 1;
+			}
+
+			memoryTypeIndex += 1;
+		}
+
+		memoryTypeIndex = 0;
+	}
+
 	/* Prefer GPU allocation */
 	requiredMemoryPropertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 	ignoredMemoryPropertyFlags = 0;
@@ -2911,6 +3909,7 @@ static uint8_t VULKAN_INTERNAL_BindMemoryForImage(
 			memoryTypeIndex,
 			&memoryRequirements,
 			isRenderTarget,
+			transient,
 			memoryRequirements.memoryRequirements.size,
 			VK_NULL_HANDLE,
 			image,
@@ -2954,6 +3953,7 @@ static uint8_t VULKAN_INTERNAL_BindMemoryForImage(
 				memoryTypeIndex,
 				&memoryRequirements,
 				isRenderTarget,
+				transient,
 				memoryRequirements.memoryRequirements.size,
 				VK_NULL_HANDLE,
 				image,
@@ -2980,7 +3980,9 @@ static uint8_t VULKAN_INTERNAL_BindMemoryForBuffer(
 	VkDeviceSize size,
 	uint8_t requireHostVisible,
 	uint8_t preferDeviceLocal,
+	uint8_t preferHostCached,
 	uint8_t dedicatedAllocation,
+	uint8_t transient,
 	VulkanMemoryUsedRegion** usedRegion
 ) {
 	uint8_t bindResult = 0;
@@ -2993,6 +3995,43 @@ static uint8_t VULKAN_INTERNAL_BindMemoryForBuffer(
 		NULL
 	};
 
+	/* CPU reads from uncached memory are very slow, so readback memory
+	 * takes any cached type, coherent or not. Non-coherent ranges are
+	 * invalidated before reading.
+	 */
+	if (requireHostVisible && preferHostCached)
+	{
+		while (VULKAN_INTERNAL_FindBufferMemoryRequirements(
+			renderer,
+			buffer,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+			0,
+			&memoryRequirements,
+			&memoryTypeIndex
+		)) {
+			bindResult = VULKAN_INTERNAL_BindResourceMemory(
+				renderer,
+				memoryTypeIndex,
+				&memoryRequirements,
+				dedicatedAllocation,
+				transient,
+				size,
+				buffer,
+				VK_NULL_HANDLE,
+				usedRegion
+			);
+
+			if (bindResult == 1)
+			{
+				return 1;
+			}
+
+			memoryTypeIndex += 1;
+		}
+
+		memoryTypeIndex = 0;
+	}
+
 	if (requireHostVisible)
 	{
 		requiredMemoryPropertyFlags =
@@ -3025,6 +4064,7 @@ static uint8_t VULKAN_INTERNAL_BindMemoryForBuffer(
 			memoryTypeIndex,
 			&memoryRequirements,
 			dedicatedAllocation,
+			transient,
 			size,
 			buffer,
 			VK_NULL_HANDLE,
@@ -3070,6 +4110,7 @@ static uint8_t VULKAN_INTERNAL_BindMemoryForBuffer(
 				memoryTypeIndex,
 				&memoryRequirements,
 				dedicatedAllocation,
+				transient,
 				size,
 				buffer,
 				VK_NULL_HANDLE,
@@ -3092,23 +4133,30 @@ static uint8_t VULKAN_INTERNAL_BindMemoryForBuffer(
 
 static uint8_t VULKAN_INTERNAL_FindAllocationToDefragment(
 	VulkanRenderer *renderer,
-	VulkanMemorySubAllocator *allocator,
-	uint32_t *allocationIndexToDefrag
+	VulkanMemoryAllocation **allocationToDefrag
 ) {
+	VulkanMemorySubAllocator *allocator;
 	uint32_t i, j;
 
 	for (i = 0; i < VK_MAX_MEMORY_TYPES; i += 1)
 	{
-		*allocator = renderer->memoryAllocator->subAllocators[i];
+		allocator = &renderer->memoryAllocator->subAllocators[i];
+
+		SDL_LockMutex(allocator->lock);
 
 		for (j = 0; j < allocator->allocationCount; j += 1)
 		{
-			if (allocator->allocations[j]->availableForAllocation == 1 && allocator->allocations[j]->freeRegionCount > 1)
+			if (	allocator->allocations[j]->availableForAllocation == 1 &&
+				!allocator->allocations[j]->defragSkipped &&
+				allocator->allocations[j]->freeRegionCount > 1	)
 			{
-				*allocationIndexToDefrag = j;
+				*allocationToDefrag = allocator->allocations[j];
+				SDL_UnlockMutex(allocator->lock);
 				return 1;
 			}
 		}
+
+		SDL_UnlockMutex(allocator->lock);
 	}
 
 	return 0;
@@ -3116,48 +4164,67 @@ static uint8_t VULKAN_INTERNAL_FindAllocationToDefragment(
 
 /* Memory Barriers */
 
-static void VULKAN_INTERNAL_BufferMemoryBarrier(
-	VulkanRenderer *renderer,
-	VkCommandBuffer commandBuffer,
+static void VULKAN_INTERNAL_BuildBufferMemoryBarrier(
 	VulkanResourceAccessType nextResourceAccessType,
-	VulkanBuffer *buffer
+	VulkanBuffer *buffer,
+	VkBufferMemoryBarrier *memoryBarrier,
+	VkPipelineStageFlags *srcStages,
+	VkPipelineStageFlags *dstStages
 ) {
-	VkPipelineStageFlags srcStages = 0;
-	VkPipelineStageFlags dstStages = 0;
-	VkBufferMemoryBarrier memoryBarrier;
 	VulkanResourceAccessType prevAccess, nextAccess;
 	const VulkanResourceAccessInfo *prevAccessInfo, *nextAccessInfo;
 
-	memoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-	memoryBarrier.pNext = NULL;
-	memoryBarrier.srcAccessMask = 0;
-	memoryBarrier.dstAccessMask = 0;
-	memoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	memoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	memoryBarrier.buffer = buffer->buffer;
-	memoryBarrier.offset = 0;
-	memoryBarrier.size = buffer->size;
+	memoryBarrier->sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	memoryBarrier->pNext = NULL;
+	memoryBarrier->srcAccessMask = 0;
+	memoryBarrier->dstAccessMask = 0;
+	memoryBarrier->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	memoryBarrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	memoryBarrier->buffer = buffer->buffer;
+	memoryBarrier->offset = buffer->offset;
+	memoryBarrier->size = buffer->size;
 
 	prevAccess = buffer->resourceAccessType;
 	prevAccessInfo = &AccessMap[prevAccess];
 
-	srcStages |= prevAccessInfo->stageMask;
+	*srcStages |= prevAccessInfo->stageMask;
 
 	if (prevAccess > RESOURCE_ACCESS_END_OF_READ)
 	{
-		memoryBarrier.srcAccessMask |= prevAccessInfo->accessMask;
+		memoryBarrier->srcAccessMask |= prevAccessInfo->accessMask;
 	}
 
 	nextAccess = nextResourceAccessType;
 	nextAccessInfo = &AccessMap[nextAccess];
 
-	dstStages |= nextAccessInfo->stageMask;
+	*dstStages |= nextAccessInfo->stageMask;
 
-	if (memoryBarrier.srcAccessMask != 0)
+	if (memoryBarrier->srcAccessMask != 0)
 	{
-		memoryBarrier.dstAccessMask |= nextAccessInfo->accessMask;
+		memoryBarrier->dstAccessMask |= nextAccessInfo->accessMask;
 	}
 
+	buffer->resourceAccessType = nextResourceAccessType;
+}
+
+static void VULKAN_INTERNAL_BufferMemoryBarrier(
+	VulkanRenderer *renderer,
+	VkCommandBuffer commandBuffer,
+	VulkanResourceAccessType nextResourceAccessType,
+	VulkanBuffer *buffer
+) {
+	VkPipelineStageFlags srcStages = 0;
+	VkPipelineStageFlags dstStages = 0;
+	VkBufferMemoryBarrier memoryBarrier;
+
+	VULKAN_INTERNAL_BuildBufferMemoryBarrier(
+		nextResourceAccessType,
+		buffer,
+		&memoryBarrier,
+		&srcStages,
+		&dstStages
+	);
+
 	if (srcStages == 0)
 	{
 		srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
@@ -3179,13 +4246,34 @@ static void VULKAN_INTERNAL_BufferMemoryBarrier(
 		0,
 		NULL
 	);
+}
 
-	buffer->resourceAccessType = nextResourceAccessType;
+static inline VulkanResourceAccessType* VULKAN_INTERNAL_SubresourceAccessType(
+	VulkanTexture *texture,
+	uint32_t layer,
+	uint32_t level
+) {
+	return &texture->subresourceAccessTypes[layer * texture->levelCount + level];
 }
 
-static void VULKAN_INTERNAL_ImageMemoryBarrier(
-	VulkanRenderer *renderer,
-	VkCommandBuffer commandBuffer,
+static void VULKAN_INTERNAL_SetTextureAccessType(
+	VulkanTexture *texture,
+	VulkanResourceAccessType accessType
+) {
+	uint32_t i;
+
+	for (i = 0; i < texture->layerCount * texture->levelCount; i += 1)
+	{
+		texture->subresourceAccessTypes[i] = accessType;
+	}
+}
+
+/* Writes one barrier per run of levels in a layer that share a previous
+ * access, folding identical runs on consecutive layers together.
+ * Subresources already in a read-only nextAccess are left alone.
+ * Returns the barrier count; barriers must hold layerCount * levelCount.
+ */
+static uint32_t VULKAN_INTERNAL_BuildImageMemoryBarriers(
 	VulkanResourceAccessType nextAccess,
 	VkImageAspectFlags aspectMask,
 	uint32_t baseLayer,
@@ -3193,1963 +4281,2413 @@ static void VULKAN_INTERNAL_ImageMemoryBarrier(
 	uint32_t baseLevel,
 	uint32_t levelCount,
 	uint8_t discardContents,
-	VkImage image,
-	VulkanResourceAccessType *resourceAccessType
+	VulkanTexture *texture,
+	VkImageMemoryBarrier *barriers,
+	VkPipelineStageFlags *srcStages
 ) {
-	VkPipelineStageFlags srcStages = 0;
-	VkPipelineStageFlags dstStages = 0;
-	VkImageMemoryBarrier memoryBarrier;
+	const VulkanResourceAccessInfo *pPrevAccessInfo;
+	const VulkanResourceAccessInfo *pNextAccessInfo = &AccessMap[nextAccess];
+	VulkanResourceAccessType *accessTypes;
 	VulkanResourceAccessType prevAccess;
-	const VulkanResourceAccessInfo *pPrevAccessInfo, *pNextAccessInfo;
+	VkImageMemoryBarrier *memoryBarrier;
+	VkImageMemoryBarrier *lastBarrier;
+	uint32_t barrierCount = 0;
+	uint32_t layer, level, runStart;
 
-	memoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	memoryBarrier.pNext = NULL;
-	memoryBarrier.srcAccessMask = 0;
-	memoryBarrier.dstAccessMask = 0;
-	memoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	memoryBarrier.newLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	memoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	memoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	memoryBarrier.image = image;
-	memoryBarrier.subresourceRange.aspectMask = aspectMask;
-	memoryBarrier.subresourceRange.baseArrayLayer = baseLayer;
-	memoryBarrier.subresourceRange.layerCount = layerCount;
-	memoryBarrier.subresourceRange.baseMipLevel = baseLevel;
-	memoryBarrier.subresourceRange.levelCount = levelCount;
+	for (layer = baseLayer; layer < baseLayer + layerCount; layer += 1)
+	{
+		accessTypes = VULKAN_INTERNAL_SubresourceAccessType(texture, layer, 0);
+		level = baseLevel;
 
-	prevAccess = *resourceAccessType;
-	pPrevAccessInfo = &AccessMap[prevAccess];
+		while (level < baseLevel + levelCount)
+		{
+			runStart = level;
+			prevAccess = accessTypes[level];
 
-	srcStages |= pPrevAccessInfo->stageMask;
+			while (level < baseLevel + levelCount && accessTypes[level] == prevAccess)
+			{
+				accessTypes[level] = nextAccess;
+				level += 1;
+			}
 
-	if (prevAccess > RESOURCE_ACCESS_END_OF_READ)
-	{
-		memoryBarrier.srcAccessMask |= pPrevAccessInfo->accessMask;
-	}
+			/* Reads after the same read need neither a layout change nor a dependency */
+			if (	prevAccess == nextAccess &&
+				nextAccess < RESOURCE_ACCESS_END_OF_READ &&
+				!discardContents	)
+			{
+				continue;
+			}
 
-	if (discardContents)
-	{
-		memoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	}
-	else
-	{
-		memoryBarrier.oldLayout = pPrevAccessInfo->imageLayout;
-	}
+			pPrevAccessInfo = &AccessMap[prevAccess];
+			*srcStages |= pPrevAccessInfo->stageMask;
+
+			memoryBarrier = &barriers[barrierCount];
+			memoryBarrier->sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			memoryBarrier->pNext = NULL;
+			memoryBarrier->srcAccessMask = 0;
+			memoryBarrier->dstAccessMask = pNextAccessInfo->accessMask;
+			memoryBarrier->newLayout = pNextAccessInfo->imageLayout;
+			memoryBarrier->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			memoryBarrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			memoryBarrier->image = texture->image;
+			memoryBarrier->subresourceRange.aspectMask = aspectMask;
+			memoryBarrier->subresourceRange.baseArrayLayer = layer;
+			memoryBarrier->subresourceRange.layerCount = 1;
+			memoryBarrier->subresourceRange.baseMipLevel = runStart;
+			memoryBarrier->subresourceRange.levelCount = level - runStart;
+
+			if (prevAccess > RESOURCE_ACCESS_END_OF_READ)
+			{
+				memoryBarrier->srcAccessMask = pPrevAccessInfo->accessMask;
+			}
 
-	pNextAccessInfo = &AccessMap[nextAccess];
+			if (discardContents)
+			{
+				memoryBarrier->oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			}
+			else
+			{
+				memoryBarrier->oldLayout = pPrevAccessInfo->imageLayout;
+			}
 
-	dstStages |= pNextAccessInfo->stageMask;
+			if (barrierCount > 0)
+			{
+				lastBarrier = &barriers[barrierCount - 1];
 
-	memoryBarrier.dstAccessMask |= pNextAccessInfo->accessMask;
-	memoryBarrier.newLayout = pNextAccessInfo->imageLayout;
+				if (	lastBarrier->subresourceRange.baseArrayLayer + lastBarrier->subresourceRange.layerCount == layer &&
+					lastBarrier->subresourceRange.baseMipLevel == runStart &&
+					lastBarrier->subresourceRange.levelCount == level - runStart &&
+					lastBarrier->oldLayout == memoryBarrier->oldLayout &&
+					lastBarrier->srcAccessMask == memoryBarrier->srcAccessMask	)
+				{
+					lastBarrier->subresourceRange.layerCount += 1;
+					continue;
+				}
+			}
 
-	if (srcStages == 0)
-	{
-		srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+			barrierCount += 1;
+		}
 	}
-	if (dstStages == 0)
+
+	return barrierCount;
+}
+
+/* Samplers bind a view of the whole image in the sampled layout, so any
+ * subresource of a sampled texture that has never been written is moved
+ * to that layout along with the first barrier on the texture.
+ * Returns the barrier count and adds to dstStages when there is one.
+ */
+static uint32_t VULKAN_INTERNAL_BuildUntouchedSampledBarriers(
+	VulkanTexture *texture,
+	VkImageMemoryBarrier *barriers,
+	VkPipelineStageFlags *dstStages
+) {
+	const VulkanResourceAccessInfo *pNextAccessInfo = &AccessMap[RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE];
+	VulkanResourceAccessType *accessTypes;
+	VkImageMemoryBarrier *memoryBarrier;
+	uint32_t barrierCount = 0;
+	uint32_t layer, level, runStart;
+
+	if (!(texture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT))
 	{
-		dstStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+		return 0;
 	}
 
-	renderer->vkCmdPipelineBarrier(
-		commandBuffer,
-		srcStages,
-		dstStages,
-		0,
-		0,
-		NULL,
-		0,
-		NULL,
-		1,
-		&memoryBarrier
-	);
+	for (layer = 0; layer < texture->layerCount; layer += 1)
+	{
+		accessTypes = VULKAN_INTERNAL_SubresourceAccessType(texture, layer, 0);
+		level = 0;
 
-	*resourceAccessType = nextAccess;
-}
+		while (level < texture->levelCount)
+		{
+			if (accessTypes[level] != RESOURCE_ACCESS_NONE)
+			{
+				level += 1;
+				continue;
+			}
 
-/* Resource tracking */
+			runStart = level;
 
-#define TRACK_RESOURCE(resource, type, array, count, capacity) \
-	uint32_t i; \
-	\
-	for (i = 0; i < commandBuffer->count; i += 1) \
-	{ \
-		if (commandBuffer->array[i] == resource) \
-		{ \
-			return; \
-		} \
-	} \
-	\
-	if (commandBuffer->count == commandBuffer->capacity) \
-	{ \
-		commandBuffer->capacity += 1; \
-		commandBuffer->array = SDL_realloc( \
-			commandBuffer->array, \
-			commandBuffer->capacity * sizeof(type) \
-		); \
-	} \
-	commandBuffer->array[commandBuffer->count] = resource; \
-	commandBuffer->count += 1; \
-	\
-	SDL_AtomicIncRef(&resource->referenceCount);
+			while (level < texture->levelCount && accessTypes[level] == RESOURCE_ACCESS_NONE)
+			{
+				accessTypes[level] = RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE;
+				level += 1;
+			}
+
+			memoryBarrier = &barriers[barrierCount];
+			memoryBarrier->sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			memoryBarrier->pNext = NULL;
+			memoryBarrier->srcAccessMask = 0;
+			memoryBarrier->dstAccessMask = pNextAccessInfo->accessMask;
+			memoryBarrier->oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			memoryBarrier->newLayout = pNextAccessInfo->imageLayout;
+			memoryBarrier->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			memoryBarrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			memoryBarrier->image = texture->image;
+			memoryBarrier->subresourceRange.aspectMask = texture->aspectFlags;
+			memoryBarrier->subresourceRange.baseArrayLayer = layer;
+			memoryBarrier->subresourceRange.layerCount = 1;
+			memoryBarrier->subresourceRange.baseMipLevel = runStart;
+			memoryBarrier->subresourceRange.levelCount = level - runStart;
+
+			barrierCount += 1;
+		}
+	}
 
+	if (barrierCount > 0)
+	{
+		*dstStages |= pNextAccessInfo->stageMask;
+	}
 
-static void VULKAN_INTERNAL_TrackBuffer(
-	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
-	VulkanBuffer *buffer
-) {
-	TRACK_RESOURCE(
-		buffer,
-		VulkanBuffer*,
-		usedBuffers,
-		usedBufferCount,
-		usedBufferCapacity
-	)
+	return barrierCount;
 }
 
-static void VULKAN_INTERNAL_TrackTexture(
+static void VULKAN_INTERNAL_ImageMemoryBarrier(
 	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
+	VkCommandBuffer commandBuffer,
+	VulkanResourceAccessType nextAccess,
+	VkImageAspectFlags aspectMask,
+	uint32_t baseLayer,
+	uint32_t layerCount,
+	uint32_t baseLevel,
+	uint32_t levelCount,
+	uint8_t discardContents,
 	VulkanTexture *texture
 ) {
-	TRACK_RESOURCE(
+	VkPipelineStageFlags srcStages = 0;
+	VkPipelineStageFlags dstStages = AccessMap[nextAccess].stageMask;
+	VkImageMemoryBarrier *memoryBarriers;
+	uint32_t barrierCount;
+
+	memoryBarriers = SDL_stack_alloc(VkImageMemoryBarrier, texture->layerCount * texture->levelCount);
+
+	barrierCount = VULKAN_INTERNAL_BuildImageMemoryBarriers(
+		nextAccess,
+		aspectMask,
+		baseLayer,
+		layerCount,
+		baseLevel,
+		levelCount,
+		discardContents,
 		texture,
-		VulkanTexture*,
-		usedTextures,
-		usedTextureCount,
-		usedTextureCapacity
-	)
-}
+		memoryBarriers,
+		&srcStages
+	);
 
-static void VULKAN_INTERNAL_TrackSampler(
-	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
-	VulkanSampler *sampler
-) {
-	TRACK_RESOURCE(
-		sampler,
-		VulkanSampler*,
-		usedSamplers,
-		usedSamplerCount,
-		usedSamplerCapacity
-	)
+	barrierCount += VULKAN_INTERNAL_BuildUntouchedSampledBarriers(
+		texture,
+		&memoryBarriers[barrierCount],
+		&dstStages
+	);
+
+	if (barrierCount > 0)
+	{
+		if (srcStages == 0)
+		{
+			srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+		}
+		if (dstStages == 0)
+		{
+			dstStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+		}
+
+		renderer->vkCmdPipelineBarrier(
+			commandBuffer,
+			srcStages,
+			dstStages,
+			0,
+			0,
+			NULL,
+			0,
+			NULL,
+			barrierCount,
+			memoryBarriers
+		);
+	}
+
+	SDL_stack_free(memoryBarriers);
 }
 
-static void VULKAN_INTERNAL_TrackGraphicsPipeline(
+/* Moves the base subresource of several textures with one pipeline barrier */
+static void VULKAN_INTERNAL_BaseSubresourceBarriers(
 	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
-	VulkanGraphicsPipeline *graphicsPipeline
+	VkCommandBuffer commandBuffer,
+	VulkanResourceAccessType nextAccess,
+	VulkanTexture **textures,
+	uint32_t textureCount
 ) {
-	TRACK_RESOURCE(
-		graphicsPipeline,
-		VulkanGraphicsPipeline*,
-		usedGraphicsPipelines,
-		usedGraphicsPipelineCount,
-		usedGraphicsPipelineCapacity
-	)
-}
+	VkPipelineStageFlags srcStages = 0;
+	VkPipelineStageFlags dstStages = AccessMap[nextAccess].stageMask;
+	VkImageMemoryBarrier *memoryBarriers;
+	uint32_t barrierCapacity = 0;
+	uint32_t barrierCount = 0;
+	uint32_t i;
 
-static void VULKAN_INTERNAL_TrackComputePipeline(
-	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
-	VulkanComputePipeline *computePipeline
-) {
-	TRACK_RESOURCE(
-		computePipeline,
-		VulkanComputePipeline*,
-		usedComputePipelines,
-		usedComputePipelineCount,
-		usedComputePipelineCapacity
-	)
-}
+	if (textureCount == 0)
+	{
+		return;
+	}
 
-static void VULKAN_INTERNAL_TrackFramebuffer(
-	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
-	VulkanFramebuffer *framebuffer
-) {
-	TRACK_RESOURCE(
-		framebuffer,
-		VulkanFramebuffer*,
-		usedFramebuffers,
-		usedFramebufferCount,
-		usedFramebufferCapacity
-	);
-}
+	for (i = 0; i < textureCount; i += 1)
+	{
+		barrierCapacity += textures[i]->layerCount * textures[i]->levelCount;
+	}
 
-#undef TRACK_RESOURCE
+	memoryBarriers = SDL_stack_alloc(VkImageMemoryBarrier, barrierCapacity);
 
-/* Resource Disposal */
+	for (i = 0; i < textureCount; i += 1)
+	{
+		barrierCount += VULKAN_INTERNAL_BuildImageMemoryBarriers(
+			nextAccess,
+			textures[i]->aspectFlags,
+			0,
+			1,
+			0,
+			1,
+			0,
+			textures[i],
+			&memoryBarriers[barrierCount],
+			&srcStages
+		);
 
-static void VULKAN_INTERNAL_QueueDestroyFramebuffer(
-	VulkanRenderer *renderer,
-	VulkanFramebuffer *framebuffer
-) {
-	SDL_LockMutex(renderer->disposeLock);
+		barrierCount += VULKAN_INTERNAL_BuildUntouchedSampledBarriers(
+			textures[i],
+			&memoryBarriers[barrierCount],
+			&dstStages
+		);
+	}
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->framebuffersToDestroy,
-		VulkanFramebuffer*,
-		renderer->framebuffersToDestroyCount + 1,
-		renderer->framebuffersToDestroyCapacity,
-		renderer->framebuffersToDestroyCapacity * 2
-	)
+	if (barrierCount > 0)
+	{
+		if (srcStages == 0)
+		{
+			srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+		}
+		if (dstStages == 0)
+		{
+			dstStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+		}
 
-	renderer->framebuffersToDestroy[renderer->framebuffersToDestroyCount] = framebuffer;
-	renderer->framebuffersToDestroyCount += 1;
+		renderer->vkCmdPipelineBarrier(
+			commandBuffer,
+			srcStages,
+			dstStages,
+			0,
+			0,
+			NULL,
+			0,
+			NULL,
+			barrierCount,
+			memoryBarriers
+		);
+	}
 
-	SDL_UnlockMutex(renderer->disposeLock);
+	SDL_stack_free(memoryBarriers);
 }
 
-static void VULKAN_INTERNAL_DestroyFramebuffer(
+/* Queue ownership transfers */
+
+static inline uint8_t VULKAN_INTERNAL_IsAsyncTransfer(
 	VulkanRenderer *renderer,
-	VulkanFramebuffer *framebuffer
+	VulkanCommandBuffer *commandBuffer
 ) {
-	renderer->vkDestroyFramebuffer(
-		renderer->logicalDevice,
-		framebuffer->framebuffer,
-		NULL
+	/* Without a separate family, transfer command buffers behave like any other */
+	return (
+		commandBuffer->isTransfer &&
+		renderer->transferQueueFamilyIndex != renderer->queueFamilyIndex
 	);
+}
 
-	SDL_free(framebuffer);
+/* Slab buffers share one VkBuffer, so queue ownership follows the slab */
+static inline VulkanBuffer* VULKAN_INTERNAL_OwnershipBuffer(
+	VulkanBuffer *buffer
+) {
+	return (buffer->slab != NULL) ? buffer->slab->buffer : buffer;
 }
 
-static void VULKAN_INTERNAL_RemoveFramebuffersContainingView(
+/* Graphics access masks and stages are not valid on a transfer-only
+ * queue, so writes there start from TOP_OF_PIPE and the resource is
+ * handed back to the graphics queue when the command buffer is submitted.
+ * A resource the graphics queue has already used is first released by
+ * the graphics queue, see VULKAN_INTERNAL_SubmitGraphicsRelease.
+ */
+
+static void VULKAN_INTERNAL_BeginTransferQueueBufferWrite(
 	VulkanRenderer *renderer,
-	VkImageView view
+	VulkanCommandBuffer *commandBuffer,
+	VulkanBuffer *buffer
 ) {
-	FramebufferHash *hash;
-	int32_t i, j;
+	VkBufferMemoryBarrier memoryBarrier;
+	VkPipelineStageFlags srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	uint32_t i;
 
-	for (i = renderer->framebufferHashArray.count - 1; i >= 0; i -= 1)
+	memoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	memoryBarrier.pNext = NULL;
+	memoryBarrier.srcAccessMask = 0;
+	memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	memoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	memoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	memoryBarrier.buffer = buffer->buffer;
+	memoryBarrier.offset = buffer->offset;
+	memoryBarrier.size = buffer->size;
+
+	for (i = 0; i < commandBuffer->releaseBufferCount; i += 1)
 	{
-		hash = &renderer->framebufferHashArray.elements[i].key;
+		if (commandBuffer->releaseBuffers[i] == buffer)
+		{
+			/* Written earlier in this command buffer */
+			srcStages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+			memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			break;
+		}
+	}
 
-		for (j = 0; j < hash->colorAttachmentCount; j += 1)
+	if (i == commandBuffer->releaseBufferCount)
+	{
+		if (commandBuffer->releaseBufferCount == commandBuffer->releaseBufferCapacity)
 		{
-			if (hash->colorAttachmentViews[j] == view)
-			{
-				VULKAN_INTERNAL_QueueDestroyFramebuffer(
-					renderer,
-					renderer->framebufferHashArray.elements[i].value
-				);
+			commandBuffer->releaseBufferCapacity += 1;
+			commandBuffer->releaseBuffers = SDL_realloc(
+				commandBuffer->releaseBuffers,
+				commandBuffer->releaseBufferCapacity * sizeof(VulkanBuffer*)
+			);
+			commandBuffer->releaseBufferAccessTypes = SDL_realloc(
+				commandBuffer->releaseBufferAccessTypes,
+				commandBuffer->releaseBufferCapacity * sizeof(VulkanResourceAccessType)
+			);
+		}
 
-				FramebufferHashArray_Remove(
-					&renderer->framebufferHashArray,
-					i
-				);
+		commandBuffer->releaseBuffers[commandBuffer->releaseBufferCount] = buffer;
+		commandBuffer->releaseBufferAccessTypes[commandBuffer->releaseBufferCount] = buffer->resourceAccessType;
+		commandBuffer->releaseBufferCount += 1;
 
-				break;
-			}
+		if (VULKAN_INTERNAL_OwnershipBuffer(buffer)->usedOnGraphicsQueue)
+		{
+			/* Acquire half here, the release is recorded on the graphics queue */
+			memoryBarrier.srcQueueFamilyIndex = renderer->queueFamilyIndex;
+			memoryBarrier.dstQueueFamilyIndex = renderer->transferQueueFamilyIndex;
+
+			EXPAND_ARRAY_IF_NEEDED(
+				commandBuffer->graphicsReleaseBufferBarriers,
+				VkBufferMemoryBarrier,
+				commandBuffer->graphicsReleaseBufferBarrierCount + 1,
+				commandBuffer->graphicsReleaseBufferBarrierCapacity,
+				commandBuffer->graphicsReleaseBufferBarrierCapacity + 4
+			)
+
+			commandBuffer->graphicsReleaseBufferBarriers[commandBuffer->graphicsReleaseBufferBarrierCount] = memoryBarrier;
+			commandBuffer->graphicsReleaseBufferBarriers[commandBuffer->graphicsReleaseBufferBarrierCount].srcAccessMask =
+				AccessMap[buffer->resourceAccessType].accessMask;
+			commandBuffer->graphicsReleaseBufferBarriers[commandBuffer->graphicsReleaseBufferBarrierCount].dstAccessMask = 0;
+			commandBuffer->graphicsReleaseBufferBarrierCount += 1;
 		}
 	}
+
+	renderer->vkCmdPipelineBarrier(
+		commandBuffer->commandBuffer,
+		srcStages,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0,
+		0,
+		NULL,
+		1,
+		&memoryBarrier,
+		0,
+		NULL
+	);
 }
 
-static void VULKAN_INTERNAL_RemoveRenderTargetsContainingTexture(
+static void VULKAN_INTERNAL_BeginTransferQueueTextureWrite(
 	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
 	VulkanTexture *texture
 ) {
-	RenderTargetHash *hash;
-	VkImageView *viewsToCheck;
-	int32_t viewsToCheckCount;
-	int32_t viewsToCheckCapacity;
-	int32_t i;
-
-	viewsToCheckCapacity = 16;
-	viewsToCheckCount = 0;
-	viewsToCheck = SDL_malloc(sizeof(VkImageView) * viewsToCheckCapacity);
-
-	SDL_LockMutex(renderer->renderTargetFetchLock);
+	VkImageMemoryBarrier *memoryBarriers;
+	VkPipelineStageFlags srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	VkAccessFlags srcAccessMask = 0;
+	VkPipelineStageFlags unusedStages = 0;
+	uint8_t acquireOwnership = 0;
+	uint32_t barrierCount;
+	uint32_t i;
 
-	for (i = renderer->renderTargetHashArray.count - 1; i >= 0; i -= 1)
+	for (i = 0; i < commandBuffer->releaseTextureCount; i += 1)
 	{
-		hash = &renderer->renderTargetHashArray.elements[i].key;
+		if (commandBuffer->releaseTextures[i] == texture)
+		{
+			/* Written earlier in this command buffer */
+			srcStages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+			srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			break;
+		}
+	}
 
-		if (hash->texture == texture)
+	if (i == commandBuffer->releaseTextureCount)
+	{
+		if (commandBuffer->releaseTextureCount == commandBuffer->releaseTextureCapacity)
 		{
-			EXPAND_ARRAY_IF_NEEDED(
-				viewsToCheck,
-				VkImageView,
-				viewsToCheckCount + 1,
-				viewsToCheckCapacity,
-				viewsToCheckCapacity * 2
+			commandBuffer->releaseTextureCapacity += 1;
+			commandBuffer->releaseTextures = SDL_realloc(
+				commandBuffer->releaseTextures,
+				commandBuffer->releaseTextureCapacity * sizeof(VulkanTexture*)
 			);
+		}
 
-			viewsToCheck[viewsToCheckCount] = renderer->renderTargetHashArray.elements[i].value->view;
-			viewsToCheckCount += 1;
-
-			VULKAN_INTERNAL_DestroyRenderTarget(
-				renderer,
-				renderer->renderTargetHashArray.elements[i].value
-			);
+		commandBuffer->releaseTextures[commandBuffer->releaseTextureCount] = texture;
+		commandBuffer->releaseTextureCount += 1;
 
-			RenderTargetHash_Remove(
-				&renderer->renderTargetHashArray,
-				i
-			);
-		}
+		acquireOwnership = texture->usedOnGraphicsQueue;
 	}
 
-	SDL_UnlockMutex(renderer->renderTargetFetchLock);
+	/* Subresources may sit in different layouts, so build per-run barriers
+	 * and replace the graphics-side source scope.
+	 */
+	memoryBarriers = SDL_stack_alloc(VkImageMemoryBarrier, texture->layerCount * texture->levelCount);
 
-	SDL_LockMutex(renderer->framebufferFetchLock);
+	barrierCount = VULKAN_INTERNAL_BuildImageMemoryBarriers(
+		RESOURCE_ACCESS_TRANSFER_WRITE,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		0,
+		texture->layerCount,
+		0,
+		texture->levelCount,
+		0,
+		texture,
+		memoryBarriers,
+		&unusedStages
+	);
 
-	for (i = 0; i < viewsToCheckCount; i += 1)
+	if (acquireOwnership)
 	{
-		VULKAN_INTERNAL_RemoveFramebuffersContainingView(
-			renderer,
-			viewsToCheck[i]
-		);
+		/* Acquire half here, the release is recorded on the graphics queue
+		 * with the same layouts so contents are kept
+		 */
+		EXPAND_ARRAY_IF_NEEDED(
+			commandBuffer->graphicsReleaseImageBarriers,
+			VkImageMemoryBarrier,
+			commandBuffer->graphicsReleaseImageBarrierCount + barrierCount,
+			commandBuffer->graphicsReleaseImageBarrierCapacity,
+			commandBuffer->graphicsReleaseImageBarrierCount + barrierCount + 4
+		)
+
+		for (i = 0; i < barrierCount; i += 1)
+		{
+			memoryBarriers[i].srcQueueFamilyIndex = renderer->queueFamilyIndex;
+			memoryBarriers[i].dstQueueFamilyIndex = renderer->transferQueueFamilyIndex;
+
+			commandBuffer->graphicsReleaseImageBarriers[commandBuffer->graphicsReleaseImageBarrierCount] = memoryBarriers[i];
+			commandBuffer->graphicsReleaseImageBarriers[commandBuffer->graphicsReleaseImageBarrierCount].dstAccessMask = 0;
+			commandBuffer->graphicsReleaseImageBarrierCount += 1;
+		}
 	}
 
-	SDL_UnlockMutex(renderer->framebufferFetchLock);
+	for (i = 0; i < barrierCount; i += 1)
+	{
+		memoryBarriers[i].srcAccessMask = srcAccessMask;
+	}
 
-	SDL_free(viewsToCheck);
+	renderer->vkCmdPipelineBarrier(
+		commandBuffer->commandBuffer,
+		srcStages,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0,
+		0,
+		NULL,
+		0,
+		NULL,
+		barrierCount,
+		memoryBarriers
+	);
+
+	SDL_stack_free(memoryBarriers);
 }
 
-static void VULKAN_INTERNAL_DestroyTexture(
-	VulkanRenderer* renderer,
-	VulkanTexture* texture
+/* Records the release half of each ownership transfer and queues the
+ * matching acquire for the next graphics command buffer.
+ * Caller must hold pendingTransferLock.
+ */
+static void VULKAN_INTERNAL_ReleaseToGraphicsQueue(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer
 ) {
-	VULKAN_INTERNAL_RemoveRenderTargetsContainingTexture(
-		renderer,
-		texture
-	);
+	VkBufferMemoryBarrier *bufferBarriers;
+	VkImageMemoryBarrier *imageBarriers;
+	VkBufferMemoryBarrier *acquireBufferBarrier;
+	VkImageMemoryBarrier *acquireImageBarrier;
+	VkSemaphoreCreateInfo semaphoreCreateInfo;
+	VkSemaphore semaphore;
+	VulkanResourceAccessType nextAccess;
+	VulkanBuffer *buffer;
+	VulkanTexture *texture;
+	VkResult vulkanResult;
+	uint32_t i;
 
-	renderer->vkDestroyImageView(
-		renderer->logicalDevice,
-		texture->view,
-		NULL
-	);
+	bufferBarriers = SDL_stack_alloc(VkBufferMemoryBarrier, SDL_max(1, commandBuffer->releaseBufferCount));
+	imageBarriers = SDL_stack_alloc(VkImageMemoryBarrier, SDL_max(1, commandBuffer->releaseTextureCount));
 
-	renderer->vkDestroyImage(
-		renderer->logicalDevice,
-		texture->image,
-		NULL
-	);
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->pendingAcquireBufferBarriers,
+		VkBufferMemoryBarrier,
+		renderer->pendingAcquireBufferBarrierCount + commandBuffer->releaseBufferCount,
+		renderer->pendingAcquireBufferBarrierCapacity,
+		renderer->pendingAcquireBufferBarrierCount + commandBuffer->releaseBufferCount + 1
+	)
 
-	VULKAN_INTERNAL_RemoveMemoryUsedRegion(
-		renderer,
-		texture->usedRegion
-	);
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->pendingAcquireImageBarriers,
+		VkImageMemoryBarrier,
+		renderer->pendingAcquireImageBarrierCount + commandBuffer->releaseTextureCount,
+		renderer->pendingAcquireImageBarrierCapacity,
+		renderer->pendingAcquireImageBarrierCount + commandBuffer->releaseTextureCount + 1
+	)
 
-	/* destroy the msaa texture, if there is one */
-	if (texture->msaaTex != NULL)
+	for (i = 0; i < commandBuffer->releaseBufferCount; i += 1)
 	{
-		VULKAN_INTERNAL_DestroyTexture(
-			renderer,
-			texture->msaaTex
-		);
-	}
+		buffer = commandBuffer->releaseBuffers[i];
+		nextAccess = commandBuffer->releaseBufferAccessTypes[i];
 
-	SDL_free(texture);
-}
-
-static void VULKAN_INTERNAL_DestroyRenderTarget(
-	VulkanRenderer *renderer,
-	VulkanRenderTarget *renderTarget
-) {
-	renderer->vkDestroyImageView(
-		renderer->logicalDevice,
-		renderTarget->view,
-		NULL
-	);
-
-	SDL_free(renderTarget);
-}
-
-static void VULKAN_INTERNAL_DestroyBuffer(
-	VulkanRenderer* renderer,
-	VulkanBuffer* buffer
-) {
-	renderer->vkDestroyBuffer(
-		renderer->logicalDevice,
-		buffer->buffer,
-		NULL
-	);
-
-	VULKAN_INTERNAL_RemoveMemoryUsedRegion(
-		renderer,
-		buffer->usedRegion
-	);
-
-	SDL_free(buffer);
-}
+		bufferBarriers[i].sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		bufferBarriers[i].pNext = NULL;
+		bufferBarriers[i].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		bufferBarriers[i].dstAccessMask = 0;
+		bufferBarriers[i].srcQueueFamilyIndex = renderer->transferQueueFamilyIndex;
+		bufferBarriers[i].dstQueueFamilyIndex = renderer->queueFamilyIndex;
+		bufferBarriers[i].buffer = buffer->buffer;
+		bufferBarriers[i].offset = buffer->offset;
+		bufferBarriers[i].size = buffer->size;
 
-static void VULKAN_INTERNAL_DestroyCommandPool(
-	VulkanRenderer *renderer,
-	VulkanCommandPool *commandPool
-) {
-	uint32_t i;
-	VulkanCommandBuffer* commandBuffer;
+		acquireBufferBarrier = &renderer->pendingAcquireBufferBarriers[renderer->pendingAcquireBufferBarrierCount];
+		*acquireBufferBarrier = bufferBarriers[i];
+		acquireBufferBarrier->srcAccessMask = 0;
+		acquireBufferBarrier->dstAccessMask = AccessMap[nextAccess].accessMask;
+		renderer->pendingAcquireBufferBarrierCount += 1;
+		renderer->pendingAcquireStages |= AccessMap[nextAccess].stageMask;
 
-	renderer->vkDestroyCommandPool(
-		renderer->logicalDevice,
-		commandPool->commandPool,
-		NULL
-	);
+		buffer->resourceAccessType = nextAccess;
+		VULKAN_INTERNAL_OwnershipBuffer(buffer)->usedOnGraphicsQueue = 1;
+	}
 
-	for (i = 0; i < commandPool->inactiveCommandBufferCount; i += 1)
+	for (i = 0; i < commandBuffer->releaseTextureCount; i += 1)
 	{
-		commandBuffer = commandPool->inactiveCommandBuffers[i];
+		texture = commandBuffer->releaseTextures[i];
 
-		SDL_free(commandBuffer->presentDatas);
-		SDL_free(commandBuffer->waitSemaphores);
-		SDL_free(commandBuffer->signalSemaphores);
-		SDL_free(commandBuffer->transferBuffers);
-		SDL_free(commandBuffer->boundUniformBuffers);
-		SDL_free(commandBuffer->boundDescriptorSetDatas);
-		SDL_free(commandBuffer->boundComputeBuffers);
-		SDL_free(commandBuffer->boundComputeTextures);
-		SDL_free(commandBuffer->usedBuffers);
-		SDL_free(commandBuffer->usedTextures);
-		SDL_free(commandBuffer->usedSamplers);
-		SDL_free(commandBuffer->usedGraphicsPipelines);
-		SDL_free(commandBuffer->usedComputePipelines);
-		SDL_free(commandBuffer->usedFramebuffers);
+		/* Matches the state SetTextureData leaves on the graphics queue */
+		if (texture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+		{
+			nextAccess = RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE;
+		}
+		else
+		{
+			nextAccess = RESOURCE_ACCESS_TRANSFER_WRITE;
+		}
 
-		SDL_free(commandBuffer);
+		imageBarriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		imageBarriers[i].pNext = NULL;
+		imageBarriers[i].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		imageBarriers[i].dstAccessMask = 0;
+		imageBarriers[i].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		imageBarriers[i].newLayout = AccessMap[nextAccess].imageLayout;
+		imageBarriers[i].srcQueueFamilyIndex = renderer->transferQueueFamilyIndex;
+		imageBarriers[i].dstQueueFamilyIndex = renderer->queueFamilyIndex;
+		imageBarriers[i].image = texture->image;
+		imageBarriers[i].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		imageBarriers[i].subresourceRange.baseArrayLayer = 0;
+		imageBarriers[i].subresourceRange.layerCount = texture->layerCount;
+		imageBarriers[i].subresourceRange.baseMipLevel = 0;
+		imageBarriers[i].subresourceRange.levelCount = texture->levelCount;
+
+		acquireImageBarrier = &renderer->pendingAcquireImageBarriers[renderer->pendingAcquireImageBarrierCount];
+		*acquireImageBarrier = imageBarriers[i];
+		acquireImageBarrier->srcAccessMask = 0;
+		acquireImageBarrier->dstAccessMask = AccessMap[nextAccess].accessMask;
+		renderer->pendingAcquireImageBarrierCount += 1;
+		renderer->pendingAcquireStages |= AccessMap[nextAccess].stageMask;
+
+		VULKAN_INTERNAL_SetTextureAccessType(texture, nextAccess);
+		texture->usedOnGraphicsQueue = 1;
+	}
+
+	if (commandBuffer->releaseBufferCount > 0 || commandBuffer->releaseTextureCount > 0)
+	{
+		renderer->vkCmdPipelineBarrier(
+			commandBuffer->commandBuffer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+			0,
+			0,
+			NULL,
+			commandBuffer->releaseBufferCount,
+			bufferBarriers,
+			commandBuffer->releaseTextureCount,
+			imageBarriers
+		);
 	}
 
-	SDL_free(commandPool->inactiveCommandBuffers);
-	SDL_free(commandPool);
-}
+	SDL_stack_free(bufferBarriers);
+	SDL_stack_free(imageBarriers);
 
-static void VULKAN_INTERNAL_DestroyGraphicsPipeline(
-	VulkanRenderer *renderer,
-	VulkanGraphicsPipeline *graphicsPipeline
-) {
-	renderer->vkDestroyPipeline(
-		renderer->logicalDevice,
-		graphicsPipeline->pipeline,
-		NULL
-	);
+	commandBuffer->releaseBufferCount = 0;
+	commandBuffer->releaseTextureCount = 0;
 
-	SDL_AtomicDecRef(&graphicsPipeline->vertexShaderModule->referenceCount);
-	SDL_AtomicDecRef(&graphicsPipeline->fragmentShaderModule->referenceCount);
+	/* The graphics queue waits on this before acquiring */
 
-	SDL_free(graphicsPipeline);
-}
+	semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	semaphoreCreateInfo.pNext = NULL;
+	semaphoreCreateInfo.flags = 0;
 
-static void VULKAN_INTERNAL_DestroyComputePipeline(
-	VulkanRenderer *renderer,
-	VulkanComputePipeline *computePipeline
-) {
-	renderer->vkDestroyPipeline(
+	vulkanResult = renderer->vkCreateSemaphore(
 		renderer->logicalDevice,
-		computePipeline->pipeline,
-		NULL
+		&semaphoreCreateInfo,
+		NULL,
+		&semaphore
 	);
 
-	SDL_AtomicDecRef(&computePipeline->computeShaderModule->referenceCount);
-
-	SDL_free(computePipeline);
-}
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkCreateSemaphore", vulkanResult);
+		return;
+	}
 
-static void VULKAN_INTERNAL_DestroyShaderModule(
-	VulkanRenderer *renderer,
-	VulkanShaderModule *vulkanShaderModule
-) {
-	renderer->vkDestroyShaderModule(
-		renderer->logicalDevice,
-		vulkanShaderModule->shaderModule,
-		NULL
-	);
+	if (commandBuffer->signalSemaphoreCount == commandBuffer->signalSemaphoreCapacity)
+	{
+		commandBuffer->signalSemaphoreCapacity += 1;
+		commandBuffer->signalSemaphores = SDL_realloc(
+			commandBuffer->signalSemaphores,
+			commandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore)
+		);
+	}
 
-	SDL_free(vulkanShaderModule);
-}
+	commandBuffer->signalSemaphores[commandBuffer->signalSemaphoreCount] = semaphore;
+	commandBuffer->signalSemaphoreCount += 1;
 
-static void VULKAN_INTERNAL_DestroySampler(
-	VulkanRenderer *renderer,
-	VulkanSampler *vulkanSampler
-) {
-	renderer->vkDestroySampler(
-		renderer->logicalDevice,
-		vulkanSampler->sampler,
-		NULL
-	);
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->pendingTransferSemaphores,
+		VkSemaphore,
+		renderer->pendingTransferSemaphoreCount + 1,
+		renderer->pendingTransferSemaphoreCapacity,
+		renderer->pendingTransferSemaphoreCapacity * 2 + 1
+	)
 
-	SDL_free(vulkanSampler);
+	renderer->pendingTransferSemaphores[renderer->pendingTransferSemaphoreCount] = semaphore;
+	renderer->pendingTransferSemaphoreCount += 1;
 }
 
-static void VULKAN_INTERNAL_DestroySwapchain(
-	VulkanRenderer* renderer,
-	WindowData *windowData
+/* Makes every submitted transfer visible to a graphics command buffer */
+static void VULKAN_INTERNAL_AcquireFromTransferQueue(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer
 ) {
+	VkPipelineStageFlags stages;
 	uint32_t i;
-	VulkanSwapchainData *swapchainData;
 
-	if (windowData == NULL)
+	SDL_LockMutex(renderer->pendingTransferLock);
+
+	if (renderer->pendingTransferSemaphoreCount == 0)
 	{
+		SDL_UnlockMutex(renderer->pendingTransferLock);
 		return;
 	}
 
-	swapchainData = windowData->swapchainData;
+	stages = renderer->pendingAcquireStages;
 
-	if (swapchainData == NULL)
+	if (stages == 0)
 	{
-		return;
+		stages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
 	}
 
-	for (i = 0; i < swapchainData->imageCount; i += 1)
+	if (	renderer->pendingAcquireBufferBarrierCount > 0 ||
+		renderer->pendingAcquireImageBarrierCount > 0	)
 	{
-		VULKAN_INTERNAL_RemoveRenderTargetsContainingTexture(
-			renderer,
-			swapchainData->textureContainers[i].vulkanTexture
-		);
-
-		renderer->vkDestroyImageView(
-			renderer->logicalDevice,
-			swapchainData->textureContainers[i].vulkanTexture->view,
-			NULL
+		/* The semaphore wait covers these stages, so the barrier can chain from them */
+		renderer->vkCmdPipelineBarrier(
+			commandBuffer->commandBuffer,
+			stages,
+			stages,
+			0,
+			0,
+			NULL,
+			renderer->pendingAcquireBufferBarrierCount,
+			renderer->pendingAcquireBufferBarriers,
+			renderer->pendingAcquireImageBarrierCount,
+			renderer->pendingAcquireImageBarriers
 		);
-
-		SDL_free(swapchainData->textureContainers[i].vulkanTexture);
 	}
 
-	SDL_free(swapchainData->textureContainers);
+	for (i = 0; i < renderer->pendingTransferSemaphoreCount; i += 1)
+	{
+		if (commandBuffer->waitSemaphoreCount == commandBuffer->waitSemaphoreCapacity)
+		{
+			commandBuffer->waitSemaphoreCapacity += 1;
+			commandBuffer->waitSemaphores = SDL_realloc(
+				commandBuffer->waitSemaphores,
+				commandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore)
+			);
+			commandBuffer->waitSemaphoreStages = SDL_realloc(
+				commandBuffer->waitSemaphoreStages,
+				commandBuffer->waitSemaphoreCapacity * sizeof(VkPipelineStageFlags)
+			);
+		}
 
-	renderer->vkDestroySwapchainKHR(
-		renderer->logicalDevice,
-		swapchainData->swapchain,
-		NULL
-	);
+		commandBuffer->waitSemaphores[commandBuffer->waitSemaphoreCount] = renderer->pendingTransferSemaphores[i];
+		commandBuffer->waitSemaphoreStages[commandBuffer->waitSemaphoreCount] = stages;
+		commandBuffer->waitSemaphoreCount += 1;
 
-	renderer->vkDestroySurfaceKHR(
-		renderer->instance,
-		swapchainData->surface,
-		NULL
-	);
+		if (commandBuffer->transferSemaphoreCount == commandBuffer->transferSemaphoreCapacity)
+		{
+			commandBuffer->transferSemaphoreCapacity += 1;
+			commandBuffer->transferSemaphores = SDL_realloc(
+				commandBuffer->transferSemaphores,
+				commandBuffer->transferSemaphoreCapacity * sizeof(VkSemaphore)
+			);
+		}
 
-	renderer->vkDestroySemaphore(
-		renderer->logicalDevice,
-		swapchainData->imageAvailableSemaphore,
-		NULL
-	);
+		commandBuffer->transferSemaphores[commandBuffer->transferSemaphoreCount] = renderer->pendingTransferSemaphores[i];
+		commandBuffer->transferSemaphoreCount += 1;
+	}
 
-	renderer->vkDestroySemaphore(
-		renderer->logicalDevice,
-		swapchainData->renderFinishedSemaphore,
-		NULL
-	);
+	renderer->pendingTransferSemaphoreCount = 0;
+	renderer->pendingAcquireBufferBarrierCount = 0;
+	renderer->pendingAcquireImageBarrierCount = 0;
+	renderer->pendingAcquireStages = 0;
 
-	windowData->swapchainData = NULL;
-	SDL_free(swapchainData);
+	SDL_UnlockMutex(renderer->pendingTransferLock);
 }
 
-static void VULKAN_INTERNAL_DestroyDescriptorSetCache(
+/* Buffer upload batching */
+
+static void VULKAN_INTERNAL_FlushBufferUploads(
 	VulkanRenderer *renderer,
-	DescriptorSetCache *cache
+	VulkanCommandBuffer *commandBuffer
 ) {
-	uint32_t i;
+	VulkanBufferUpload *uploads = commandBuffer->pendingBufferUploads;
+	uint32_t uploadCount = commandBuffer->pendingBufferUploadCount;
+	uint8_t asyncTransfer = VULKAN_INTERNAL_IsAsyncTransfer(renderer, commandBuffer);
+	VulkanBuffer **srcBuffers;
+	VulkanBuffer **dstBuffers;
+	VulkanResourceAccessType *dstAccessTypes;
+	VkBufferMemoryBarrier *memoryBarriers;
+	VkBufferCopy *regions;
+	uint8_t *recorded;
+	VkPipelineStageFlags srcStages = 0;
+	VkPipelineStageFlags dstStages = 0;
+	uint32_t srcBufferCount = 0;
+	uint32_t dstBufferCount = 0;
+	uint32_t barrierCount = 0;
+	uint32_t regionCount;
+	uint32_t i, j;
 
-	if (cache == NULL)
+	if (uploadCount == 0)
 	{
 		return;
 	}
 
-	for (i = 0; i < cache->descriptorPoolCount; i += 1)
+	/* Uploads can number in the thousands, keep this off the stack */
+	srcBuffers = SDL_malloc(uploadCount * sizeof(VulkanBuffer*));
+	dstBuffers = SDL_malloc(uploadCount * sizeof(VulkanBuffer*));
+	dstAccessTypes = SDL_malloc(uploadCount * sizeof(VulkanResourceAccessType));
+	memoryBarriers = SDL_malloc(uploadCount * 2 * sizeof(VkBufferMemoryBarrier));
+	regions = SDL_malloc(uploadCount * sizeof(VkBufferCopy));
+	recorded = SDL_calloc(uploadCount, sizeof(uint8_t));
+
+	for (i = 0; i < uploadCount; i += 1)
 	{
-		renderer->vkDestroyDescriptorPool(
-			renderer->logicalDevice,
-			cache->descriptorPools[i],
-			NULL
-		);
+		for (j = 0; j < srcBufferCount; j += 1)
+		{
+			if (srcBuffers[j] == uploads[i].srcBuffer)
+			{
+				break;
+			}
+		}
+		if (j == srcBufferCount)
+		{
+			srcBuffers[srcBufferCount] = uploads[i].srcBuffer;
+			srcBufferCount += 1;
+		}
+
+		for (j = 0; j < dstBufferCount; j += 1)
+		{
+			if (dstBuffers[j] == uploads[i].dstBuffer)
+			{
+				break;
+			}
+		}
+		if (j == dstBufferCount)
+		{
+			dstBuffers[dstBufferCount] = uploads[i].dstBuffer;
+			dstAccessTypes[dstBufferCount] = uploads[i].dstBuffer->resourceAccessType;
+			dstBufferCount += 1;
+		}
 	}
 
-	SDL_free(cache->descriptorPools);
-	SDL_free(cache->inactiveDescriptorSets);
-	SDL_DestroyMutex(cache->lock);
-	SDL_free(cache);
-}
+	/* One barrier for every buffer involved */
 
-/* Descriptor cache stuff */
+	for (i = 0; i < srcBufferCount; i += 1)
+	{
+		VULKAN_INTERNAL_BuildBufferMemoryBarrier(
+			RESOURCE_ACCESS_TRANSFER_READ,
+			srcBuffers[i],
+			&memoryBarriers[barrierCount],
+			&srcStages,
+			&dstStages
+		);
+		barrierCount += 1;
+	}
 
-static uint8_t VULKAN_INTERNAL_CreateDescriptorPool(
-	VulkanRenderer *renderer,
-	VkDescriptorType descriptorType,
-	uint32_t descriptorSetCount,
-	uint32_t descriptorCount,
-	VkDescriptorPool *pDescriptorPool
-) {
-	VkResult vulkanResult;
+	if (!asyncTransfer)
+	{
+		for (i = 0; i < dstBufferCount; i += 1)
+		{
+			VULKAN_INTERNAL_BuildBufferMemoryBarrier(
+				RESOURCE_ACCESS_TRANSFER_WRITE,
+				dstBuffers[i],
+				&memoryBarriers[barrierCount],
+				&srcStages,
+				&dstStages
+			);
+			barrierCount += 1;
+		}
+	}
 
-	VkDescriptorPoolSize descriptorPoolSize;
-	VkDescriptorPoolCreateInfo descriptorPoolInfo;
+	renderer->vkCmdPipelineBarrier(
+		commandBuffer->commandBuffer,
+		srcStages == 0 ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : srcStages,
+		dstStages == 0 ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : dstStages,
+		0,
+		0,
+		NULL,
+		barrierCount,
+		memoryBarriers,
+		0,
+		NULL
+	);
 
-	descriptorPoolSize.type = descriptorType;
-	descriptorPoolSize.descriptorCount = descriptorCount;
-
-	descriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-	descriptorPoolInfo.pNext = NULL;
-	descriptorPoolInfo.flags = 0;
-	descriptorPoolInfo.maxSets = descriptorSetCount;
-	descriptorPoolInfo.poolSizeCount = 1;
-	descriptorPoolInfo.pPoolSizes = &descriptorPoolSize;
-
-	vulkanResult = renderer->vkCreateDescriptorPool(
-		renderer->logicalDevice,
-		&descriptorPoolInfo,
-		NULL,
-		pDescriptorPool
-	);
-
-	if (vulkanResult != VK_SUCCESS)
+	if (asyncTransfer)
 	{
-		LogVulkanResultAsError("vkCreateDescriptorPool", vulkanResult);
-		return 0;
+		for (i = 0; i < dstBufferCount; i += 1)
+		{
+			VULKAN_INTERNAL_BeginTransferQueueBufferWrite(
+				renderer,
+				commandBuffer,
+				dstBuffers[i]
+			);
+		}
 	}
 
-	return 1;
-}
-
-static uint8_t VULKAN_INTERNAL_AllocateDescriptorSets(
-	VulkanRenderer *renderer,
-	VkDescriptorPool descriptorPool,
-	VkDescriptorSetLayout descriptorSetLayout,
-	uint32_t descriptorSetCount,
-	VkDescriptorSet *descriptorSetArray
-) {
-	VkResult vulkanResult;
-	uint32_t i;
-	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo;
-	VkDescriptorSetLayout *descriptorSetLayouts = SDL_stack_alloc(VkDescriptorSetLayout, descriptorSetCount);
+	/* One copy per source and destination pair. Regions for the same
+	 * destination never overlap, QueueBufferUpload flushes first.
+	 */
 
-	for (i = 0; i < descriptorSetCount; i += 1)
+	for (i = 0; i < uploadCount; i += 1)
 	{
-		descriptorSetLayouts[i] = descriptorSetLayout;
-	}
+		if (recorded[i])
+		{
+			continue;
+		}
 
-	descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-	descriptorSetAllocateInfo.pNext = NULL;
-	descriptorSetAllocateInfo.descriptorPool = descriptorPool;
-	descriptorSetAllocateInfo.descriptorSetCount = descriptorSetCount;
-	descriptorSetAllocateInfo.pSetLayouts = descriptorSetLayouts;
+		regionCount = 0;
 
-	vulkanResult = renderer->vkAllocateDescriptorSets(
-		renderer->logicalDevice,
-		&descriptorSetAllocateInfo,
-		descriptorSetArray
-	);
+		for (j = i; j < uploadCount; j += 1)
+		{
+			if (	!recorded[j] &&
+				uploads[j].srcBuffer->buffer == uploads[i].srcBuffer->buffer &&
+				uploads[j].dstBuffer->buffer == uploads[i].dstBuffer->buffer	)
+			{
+				regions[regionCount] = uploads[j].region;
+				regionCount += 1;
+				recorded[j] = 1;
+			}
+		}
 
-	if (vulkanResult != VK_SUCCESS)
-	{
-		LogVulkanResultAsError("vkAllocateDescriptorSets", vulkanResult);
-		SDL_stack_free(descriptorSetLayouts);
-		return 0;
+		renderer->vkCmdCopyBuffer(
+			commandBuffer->commandBuffer,
+			uploads[i].srcBuffer->buffer,
+			uploads[i].dstBuffer->buffer,
+			regionCount,
+			regions
+		);
 	}
 
-	SDL_stack_free(descriptorSetLayouts);
-	return 1;
-}
-
-static DescriptorSetCache* VULKAN_INTERNAL_CreateDescriptorSetCache(
-	VulkanRenderer *renderer,
-	VkDescriptorType descriptorType,
-	VkDescriptorSetLayout descriptorSetLayout,
-	uint32_t bindingCount
-) {
-	DescriptorSetCache *descriptorSetCache = SDL_malloc(sizeof(DescriptorSetCache));
-
-	descriptorSetCache->lock = SDL_CreateMutex();
-
-	descriptorSetCache->descriptorSetLayout = descriptorSetLayout;
-	descriptorSetCache->bindingCount = bindingCount;
-	descriptorSetCache->descriptorType = descriptorType;
+	/* Restore each destination. Async transfers do this on release. */
 
-	descriptorSetCache->descriptorPools = SDL_malloc(sizeof(VkDescriptorPool));
-	descriptorSetCache->descriptorPoolCount = 1;
-	descriptorSetCache->nextPoolSize = DESCRIPTOR_POOL_STARTING_SIZE * 2;
+	if (!asyncTransfer)
+	{
+		srcStages = 0;
+		dstStages = 0;
 
-	VULKAN_INTERNAL_CreateDescriptorPool(
-		renderer,
-		descriptorType,
-		DESCRIPTOR_POOL_STARTING_SIZE,
-		DESCRIPTOR_POOL_STARTING_SIZE * bindingCount,
-		&descriptorSetCache->descriptorPools[0]
-	);
+		for (i = 0; i < dstBufferCount; i += 1)
+		{
+			VULKAN_INTERNAL_BuildBufferMemoryBarrier(
+				dstAccessTypes[i],
+				dstBuffers[i],
+				&memoryBarriers[i],
+				&srcStages,
+				&dstStages
+			);
+		}
 
-	descriptorSetCache->inactiveDescriptorSetCapacity = DESCRIPTOR_POOL_STARTING_SIZE;
-	descriptorSetCache->inactiveDescriptorSetCount = DESCRIPTOR_POOL_STARTING_SIZE;
-	descriptorSetCache->inactiveDescriptorSets = SDL_malloc(
-		sizeof(VkDescriptorSet) * DESCRIPTOR_POOL_STARTING_SIZE
-	);
+		renderer->vkCmdPipelineBarrier(
+			commandBuffer->commandBuffer,
+			srcStages == 0 ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : srcStages,
+			dstStages == 0 ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : dstStages,
+			0,
+			0,
+			NULL,
+			dstBufferCount,
+			memoryBarriers,
+			0,
+			NULL
+		);
+	}
 
-	VULKAN_INTERNAL_AllocateDescriptorSets(
-		renderer,
-		descriptorSetCache->descriptorPools[0],
-		descriptorSetCache->descriptorSetLayout,
-		DESCRIPTOR_POOL_STARTING_SIZE,
-		descriptorSetCache->inactiveDescriptorSets
-	);
+	SDL_free(srcBuffers);
+	SDL_free(dstBuffers);
+	SDL_free(dstAccessTypes);
+	SDL_free(memoryBarriers);
+	SDL_free(regions);
+	SDL_free(recorded);
 
-	return descriptorSetCache;
+	commandBuffer->pendingBufferUploadCount = 0;
 }
 
-static VkDescriptorSetLayout VULKAN_INTERNAL_FetchDescriptorSetLayout(
+static void VULKAN_INTERNAL_QueueBufferUpload(
 	VulkanRenderer *renderer,
-	VkDescriptorType descriptorType,
-	uint32_t bindingCount,
-	VkShaderStageFlagBits shaderStageFlagBit
+	VulkanCommandBuffer *commandBuffer,
+	VulkanBuffer *srcBuffer,
+	VkDeviceSize srcOffset,
+	VulkanBuffer *dstBuffer,
+	VkDeviceSize dstOffset,
+	VkDeviceSize size
 ) {
-	DescriptorSetLayoutHash descriptorSetLayoutHash;
-	VkDescriptorSetLayout descriptorSetLayout;
-
-	VkDescriptorSetLayoutBinding setLayoutBindings[MAX_TEXTURE_SAMPLERS];
-	VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo;
-
-	VkResult vulkanResult;
+	VulkanBufferUpload *upload;
 	uint32_t i;
 
-	if (bindingCount == 0)
+	/* Overlapping regions in one copy have no defined order */
+	for (i = 0; i < commandBuffer->pendingBufferUploadCount; i += 1)
 	{
-		if (shaderStageFlagBit == VK_SHADER_STAGE_VERTEX_BIT)
-		{
-			return renderer->emptyVertexSamplerLayout;
-		}
-		else if (shaderStageFlagBit == VK_SHADER_STAGE_FRAGMENT_BIT)
-		{
-			return renderer->emptyFragmentSamplerLayout;
-		}
-		else if (shaderStageFlagBit == VK_SHADER_STAGE_COMPUTE_BIT)
-		{
-			if (descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
-			{
-				return renderer->emptyComputeBufferDescriptorSetLayout;
-			}
-			else if (descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE)
-			{
-				return renderer->emptyComputeImageDescriptorSetLayout;
-			}
-			else
-			{
-				Refresh_LogError("Invalid descriptor type for compute shader: ", descriptorType);
-				return NULL_DESC_LAYOUT;
-			}
-		}
-		else
+		upload = &commandBuffer->pendingBufferUploads[i];
+
+		if (	upload->dstBuffer->buffer == dstBuffer->buffer &&
+			upload->region.dstOffset < dstOffset + size &&
+			dstOffset < upload->region.dstOffset + upload->region.size	)
 		{
-			Refresh_LogError("Invalid shader stage flag bit: ", shaderStageFlagBit);
-			return NULL_DESC_LAYOUT;
+			VULKAN_INTERNAL_FlushBufferUploads(renderer, commandBuffer);
+			break;
 		}
 	}
 
-	descriptorSetLayoutHash.descriptorType = descriptorType;
-	descriptorSetLayoutHash.bindingCount = bindingCount;
-	descriptorSetLayoutHash.stageFlag = shaderStageFlagBit;
-
-	descriptorSetLayout = DescriptorSetLayoutHashTable_Fetch(
-		&renderer->descriptorSetLayoutHashTable,
-		descriptorSetLayoutHash
-	);
-
-	if (descriptorSetLayout != VK_NULL_HANDLE)
+	if (commandBuffer->pendingBufferUploadCount == commandBuffer->pendingBufferUploadCapacity)
 	{
-		return descriptorSetLayout;
+		commandBuffer->pendingBufferUploadCapacity *= 2;
+		commandBuffer->pendingBufferUploads = SDL_realloc(
+			commandBuffer->pendingBufferUploads,
+			commandBuffer->pendingBufferUploadCapacity * sizeof(VulkanBufferUpload)
+		);
 	}
 
-	for (i = 0; i < bindingCount; i += 1)
-	{
-		setLayoutBindings[i].binding = i;
-		setLayoutBindings[i].descriptorCount = 1;
-		setLayoutBindings[i].descriptorType = descriptorType;
-		setLayoutBindings[i].stageFlags = shaderStageFlagBit;
-		setLayoutBindings[i].pImmutableSamplers = NULL;
-	}
+	upload = &commandBuffer->pendingBufferUploads[commandBuffer->pendingBufferUploadCount];
+	upload->srcBuffer = srcBuffer;
+	upload->dstBuffer = dstBuffer;
+	upload->region.srcOffset = srcOffset;
+	upload->region.dstOffset = dstOffset;
+	upload->region.size = size;
+	commandBuffer->pendingBufferUploadCount += 1;
+}
 
-	setLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-	setLayoutCreateInfo.pNext = NULL;
-	setLayoutCreateInfo.flags = 0;
-	setLayoutCreateInfo.bindingCount = bindingCount;
-	setLayoutCreateInfo.pBindings = setLayoutBindings;
+/* Resource tracking */
 
-	vulkanResult = renderer->vkCreateDescriptorSetLayout(
-		renderer->logicalDevice,
-		&setLayoutCreateInfo,
-		NULL,
-		&descriptorSetLayout
-	);
+#define TRACK_RESOURCE(resource, type, array, count, capacity) \
+	uint32_t i; \
+	\
+	for (i = 0; i < commandBuffer->count; i += 1) \
+	{ \
+		if (commandBuffer->array[i] == resource) \
+		{ \
+			return; \
+		} \
+	} \
+	\
+	if (commandBuffer->count == commandBuffer->capacity) \
+	{ \
+		commandBuffer->capacity += 1; \
+		commandBuffer->array = SDL_realloc( \
+			commandBuffer->array, \
+			commandBuffer->capacity * sizeof(type) \
+		); \
+	} \
+	commandBuffer->array[commandBuffer->count] = resource; \
+	commandBuffer->count += 1; \
+	\
+	SDL_AtomicIncRef(&resource->referenceCount);
 
-	if (vulkanResult != VK_SUCCESS)
+
+static void VULKAN_INTERNAL_TrackBuffer(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VulkanBuffer *buffer
+) {
+	if (!VULKAN_INTERNAL_IsAsyncTransfer(renderer, commandBuffer))
 	{
-		LogVulkanResultAsError("vkCreateDescriptorSetLayout", vulkanResult);
-		return NULL_DESC_LAYOUT;
+		VULKAN_INTERNAL_OwnershipBuffer(buffer)->usedOnGraphicsQueue = 1;
 	}
 
-	DescriptorSetLayoutHashTable_Insert(
-		&renderer->descriptorSetLayoutHashTable,
-		descriptorSetLayoutHash,
-		descriptorSetLayout
-	);
-
-	return descriptorSetLayout;
+	TRACK_RESOURCE(
+		buffer,
+		VulkanBuffer*,
+		usedBuffers,
+		usedBufferCount,
+		usedBufferCapacity
+	)
 }
 
-static VulkanGraphicsPipelineLayout* VULKAN_INTERNAL_FetchGraphicsPipelineLayout(
+static void VULKAN_INTERNAL_TrackTexture(
 	VulkanRenderer *renderer,
-	uint32_t vertexSamplerBindingCount,
-	uint32_t fragmentSamplerBindingCount
+	VulkanCommandBuffer *commandBuffer,
+	VulkanTexture *texture
 ) {
-	VkDescriptorSetLayout setLayouts[4];
-
-	GraphicsPipelineLayoutHash pipelineLayoutHash;
-	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
-	VkResult vulkanResult;
+	if (!VULKAN_INTERNAL_IsAsyncTransfer(renderer, commandBuffer))
+	{
+		texture->usedOnGraphicsQueue = 1;
+	}
 
-	VulkanGraphicsPipelineLayout *vulkanGraphicsPipelineLayout;
+	TRACK_RESOURCE(
+		texture,
+		VulkanTexture*,
+		usedTextures,
+		usedTextureCount,
+		usedTextureCapacity
+	)
+}
 
-	pipelineLayoutHash.vertexSamplerLayout = VULKAN_INTERNAL_FetchDescriptorSetLayout(
-		renderer,
-		VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-		vertexSamplerBindingCount,
-		VK_SHADER_STAGE_VERTEX_BIT
-	);
+static void VULKAN_INTERNAL_TrackSampler(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VulkanSampler *sampler
+) {
+	TRACK_RESOURCE(
+		sampler,
+		VulkanSampler*,
+		usedSamplers,
+		usedSamplerCount,
+		usedSamplerCapacity
+	)
+}
 
-	pipelineLayoutHash.fragmentSamplerLayout = VULKAN_INTERNAL_FetchDescriptorSetLayout(
-		renderer,
-		VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-		fragmentSamplerBindingCount,
-		VK_SHADER_STAGE_FRAGMENT_BIT
-	);
+static void VULKAN_INTERNAL_TrackGraphicsPipeline(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VulkanGraphicsPipeline *graphicsPipeline
+) {
+	TRACK_RESOURCE(
+		graphicsPipeline,
+		VulkanGraphicsPipeline*,
+		usedGraphicsPipelines,
+		usedGraphicsPipelineCount,
+		usedGraphicsPipelineCapacity
+	)
+}
 
-	pipelineLayoutHash.vertexUniformLayout = renderer->vertexUniformDescriptorSetLayout;
-	pipelineLayoutHash.fragmentUniformLayout = renderer->fragmentUniformDescriptorSetLayout;
+static void VULKAN_INTERNAL_TrackComputePipeline(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VulkanComputePipeline *computePipeline
+) {
+	TRACK_RESOURCE(
+		computePipeline,
+		VulkanComputePipeline*,
+		usedComputePipelines,
+		usedComputePipelineCount,
+		usedComputePipelineCapacity
+	)
+}
 
-	vulkanGraphicsPipelineLayout = GraphicsPipelineLayoutHashArray_Fetch(
-		&renderer->graphicsPipelineLayoutHashTable,
-		pipelineLayoutHash
+static void VULKAN_INTERNAL_TrackFramebuffer(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VulkanFramebuffer *framebuffer
+) {
+	TRACK_RESOURCE(
+		framebuffer,
+		VulkanFramebuffer*,
+		usedFramebuffers,
+		usedFramebufferCount,
+		usedFramebufferCapacity
 	);
+}
 
-	if (vulkanGraphicsPipelineLayout != NULL)
-	{
-		return vulkanGraphicsPipelineLayout;
-	}
+#undef TRACK_RESOURCE
 
-	vulkanGraphicsPipelineLayout = SDL_malloc(sizeof(VulkanGraphicsPipelineLayout));
+/* Resource Disposal */
 
-	setLayouts[0] = pipelineLayoutHash.vertexSamplerLayout;
-	setLayouts[1] = pipelineLayoutHash.fragmentSamplerLayout;
-	setLayouts[2] = renderer->vertexUniformDescriptorSetLayout;
-	setLayouts[3] = renderer->fragmentUniformDescriptorSetLayout;
+static void VULKAN_INTERNAL_QueueDestroyFramebuffer(
+	VulkanRenderer *renderer,
+	VulkanFramebuffer *framebuffer
+) {
+	SDL_LockMutex(renderer->disposeLock);
 
-	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-	pipelineLayoutCreateInfo.pNext = NULL;
-	pipelineLayoutCreateInfo.flags = 0;
-	pipelineLayoutCreateInfo.setLayoutCount = 4;
-	pipelineLayoutCreateInfo.pSetLayouts = setLayouts;
-	pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-	pipelineLayoutCreateInfo.pPushConstantRanges = NULL;
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->framebuffersToDestroy,
+		VulkanFramebuffer*,
+		renderer->framebuffersToDestroyCount + 1,
+		renderer->framebuffersToDestroyCapacity,
+		renderer->framebuffersToDestroyCapacity * 2
+	)
 
-	vulkanResult = renderer->vkCreatePipelineLayout(
+	renderer->framebuffersToDestroy[renderer->framebuffersToDestroyCount] = framebuffer;
+	renderer->framebuffersToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_INTERNAL_DestroyFramebuffer(
+	VulkanRenderer *renderer,
+	VulkanFramebuffer *framebuffer
+) {
+	renderer->vkDestroyFramebuffer(
 		renderer->logicalDevice,
-		&pipelineLayoutCreateInfo,
-		NULL,
-		&vulkanGraphicsPipelineLayout->pipelineLayout
+		framebuffer->framebuffer,
+		NULL
 	);
 
-	if (vulkanResult != VK_SUCCESS)
+	SDL_free(framebuffer);
+}
+
+static void VULKAN_INTERNAL_RemoveFramebuffersContainingView(
+	VulkanRenderer *renderer,
+	VkImageView view
+) {
+	FramebufferHash *hash;
+	int32_t i, j;
+
+	for (i = renderer->framebufferHashArray.count - 1; i >= 0; i -= 1)
 	{
-		LogVulkanResultAsError("vkCreatePipelineLayout", vulkanResult);
-		return NULL;
-	}
+		hash = &renderer->framebufferHashArray.elements[i].key;
 
-	GraphicsPipelineLayoutHashArray_Insert(
-		&renderer->graphicsPipelineLayoutHashTable,
-		pipelineLayoutHash,
-		vulkanGraphicsPipelineLayout
-	);
+		for (j = 0; j < hash->colorAttachmentCount; j += 1)
+		{
+			if (hash->colorAttachmentViews[j] == view)
+			{
+				VULKAN_INTERNAL_QueueDestroyFramebuffer(
+					renderer,
+					renderer->framebufferHashArray.elements[i].value
+				);
 
-	/* If the binding count is 0
-	 * we can just bind the same descriptor set
-	 * so no cache is needed
-	 */
+				FramebufferHashArray_Remove(
+					&renderer->framebufferHashArray,
+					i
+				);
 
-	if (vertexSamplerBindingCount == 0)
-	{
-		vulkanGraphicsPipelineLayout->vertexSamplerDescriptorSetCache = NULL;
+				break;
+			}
+		}
 	}
-	else
+}
+
+static void VULKAN_INTERNAL_RemoveRenderTargetsContainingTexture(
+	VulkanRenderer *renderer,
+	VulkanTexture *texture
+) {
+	RenderTargetHash *hash;
+	VkImageView *viewsToCheck;
+	int32_t viewsToCheckCount;
+	int32_t viewsToCheckCapacity;
+	int32_t i;
+
+	viewsToCheckCapacity = 16;
+	viewsToCheckCount = 0;
+	viewsToCheck = SDL_malloc(sizeof(VkImageView) * viewsToCheckCapacity);
+
+	SDL_LockMutex(renderer->renderTargetFetchLock);
+
+	for (i = renderer->renderTargetHashArray.count - 1; i >= 0; i -= 1)
 	{
-		vulkanGraphicsPipelineLayout->vertexSamplerDescriptorSetCache =
-			VULKAN_INTERNAL_CreateDescriptorSetCache(
+		hash = &renderer->renderTargetHashArray.elements[i].key;
+
+		if (hash->texture == texture)
+		{
+			EXPAND_ARRAY_IF_NEEDED(
+				viewsToCheck,
+				VkImageView,
+				viewsToCheckCount + 1,
+				viewsToCheckCapacity,
+				viewsToCheckCapacity * 2
+			);
+
+			viewsToCheck[viewsToCheckCount] = renderer->renderTargetHashArray.elements[i].value->view;
+			viewsToCheckCount += 1;
+
+			VULKAN_INTERNAL_DestroyRenderTarget(
 				renderer,
-				VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-				pipelineLayoutHash.vertexSamplerLayout,
-				vertexSamplerBindingCount
+				renderer->renderTargetHashArray.elements[i].value
 			);
-	}
 
-	if (fragmentSamplerBindingCount == 0)
-	{
-		vulkanGraphicsPipelineLayout->fragmentSamplerDescriptorSetCache = NULL;
+			RenderTargetHash_Remove(
+				&renderer->renderTargetHashArray,
+				i
+			);
+		}
 	}
-	else
+
+	SDL_UnlockMutex(renderer->renderTargetFetchLock);
+
+	SDL_LockMutex(renderer->framebufferFetchLock);
+
+	for (i = 0; i < viewsToCheckCount; i += 1)
 	{
-		vulkanGraphicsPipelineLayout->fragmentSamplerDescriptorSetCache =
-			VULKAN_INTERNAL_CreateDescriptorSetCache(
-				renderer,
-				VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-				pipelineLayoutHash.fragmentSamplerLayout,
-				fragmentSamplerBindingCount
-			);
+		VULKAN_INTERNAL_RemoveFramebuffersContainingView(
+			renderer,
+			viewsToCheck[i]
+		);
 	}
 
-	return vulkanGraphicsPipelineLayout;
-}
+	SDL_UnlockMutex(renderer->framebufferFetchLock);
 
-/* Data Buffer */
+	SDL_free(viewsToCheck);
+}
 
-static VulkanBuffer* VULKAN_INTERNAL_CreateBuffer(
-	VulkanRenderer *renderer,
-	VkDeviceSize size,
-	VulkanResourceAccessType resourceAccessType,
-	VkBufferUsageFlags usage,
-	uint8_t requireHostVisible,
-	uint8_t preferDeviceLocal,
-	uint8_t dedicatedAllocation
+static void VULKAN_INTERNAL_DestroyTexture(
+	VulkanRenderer* renderer,
+	VulkanTexture* texture
 ) {
-	VulkanBuffer* buffer;
-	VkResult vulkanResult;
-	VkBufferCreateInfo bufferCreateInfo;
-	uint8_t bindResult;
+	VULKAN_INTERNAL_RemoveRenderTargetsContainingTexture(
+		renderer,
+		texture
+	);
 
-	buffer = SDL_malloc(sizeof(VulkanBuffer));
+	renderer->vkDestroyImageView(
+		renderer->logicalDevice,
+		texture->view,
+		NULL
+	);
 
-	buffer->size = size;
-	buffer->resourceAccessType = resourceAccessType;
-	buffer->usage = usage;
-	buffer->requireHostVisible = requireHostVisible;
-	buffer->preferDeviceLocal = preferDeviceLocal;
-
-	bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-	bufferCreateInfo.pNext = NULL;
-	bufferCreateInfo.flags = 0;
-	bufferCreateInfo.size = size;
-	bufferCreateInfo.usage = usage;
-	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-	bufferCreateInfo.queueFamilyIndexCount = 1;
-	bufferCreateInfo.pQueueFamilyIndices = &renderer->queueFamilyIndex;
-
-	vulkanResult = renderer->vkCreateBuffer(
+	renderer->vkDestroyImage(
 		renderer->logicalDevice,
-		&bufferCreateInfo,
-		NULL,
-		&buffer->buffer
+		texture->image,
+		NULL
 	);
-	VULKAN_ERROR_CHECK(vulkanResult, vkCreateBuffer, 0)
 
-	bindResult = VULKAN_INTERNAL_BindMemoryForBuffer(
+	VULKAN_INTERNAL_RemoveMemoryUsedRegion(
 		renderer,
-		buffer->buffer,
-		buffer->size,
-		buffer->requireHostVisible,
-		buffer->preferDeviceLocal,
-		dedicatedAllocation,
-		&buffer->usedRegion
+		texture->usedRegion
 	);
 
-	if (bindResult != 1)
+	/* destroy the msaa texture, if there is one */
+	if (texture->msaaTex != NULL)
 	{
-		renderer->vkDestroyBuffer(
-			renderer->logicalDevice,
-			buffer->buffer,
-			NULL);
-
-		return NULL;
+		VULKAN_INTERNAL_DestroyTexture(
+			renderer,
+			texture->msaaTex
+		);
 	}
 
-	buffer->usedRegion->vulkanBuffer = buffer; /* lol */
-	buffer->container = NULL;
-
-	buffer->resourceAccessType = resourceAccessType;
-
-	SDL_AtomicSet(&buffer->referenceCount, 0);
-
-	return buffer;
+	SDL_free(texture->subresourceAccessTypes);
+	SDL_free(texture);
 }
 
-/* Uniform buffer functions */
-
-static uint8_t VULKAN_INTERNAL_AddUniformDescriptorPool(
+static void VULKAN_INTERNAL_DestroyRenderTarget(
 	VulkanRenderer *renderer,
-	VulkanUniformDescriptorPool *vulkanUniformDescriptorPool
+	VulkanRenderTarget *renderTarget
 ) {
-	vulkanUniformDescriptorPool->descriptorPools = SDL_realloc(
-		vulkanUniformDescriptorPool->descriptorPools,
-		sizeof(VkDescriptorPool) * (vulkanUniformDescriptorPool->descriptorPoolCount + 1)
+	renderer->vkDestroyImageView(
+		renderer->logicalDevice,
+		renderTarget->view,
+		NULL
 	);
 
-	if (!VULKAN_INTERNAL_CreateDescriptorPool(
-		renderer,
-		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
-		DESCRIPTOR_POOL_STARTING_SIZE,
-		DESCRIPTOR_POOL_STARTING_SIZE,
-		&vulkanUniformDescriptorPool->descriptorPools[vulkanUniformDescriptorPool->descriptorPoolCount]
-	)) {
-		Refresh_LogError("Failed to create descriptor pool!");
-		return 0;
-	}
-
-	vulkanUniformDescriptorPool->descriptorPoolCount += 1;
-	vulkanUniformDescriptorPool->availableDescriptorSetCount += DESCRIPTOR_POOL_STARTING_SIZE;
-
-	return 1;
+	SDL_free(renderTarget);
 }
 
-static VulkanUniformBufferPool* VULKAN_INTERNAL_CreateUniformBufferPool(
+/* Returns the slab if it emptied out and should be destroyed, otherwise NULL */
+static VulkanBufferSlab* VULKAN_INTERNAL_ReleaseBufferSlabSlot(
 	VulkanRenderer *renderer,
-	VulkanUniformBufferType uniformBufferType
+	VulkanBuffer *buffer
 ) {
-	VulkanUniformBufferPool* uniformBufferPool = SDL_malloc(sizeof(VulkanUniformBufferPool));
-	VulkanResourceAccessType resourceAccessType;
+	VulkanBufferSlab *slab = buffer->slab;
+	uint32_t classIndex =
+		VULKAN_INTERNAL_MostSignificantBit(slab->slotSize) -
+		VULKAN_INTERNAL_MostSignificantBit(BUFFER_SLAB_MIN_SLOT_SIZE);
+	uint32_t i, sameUsageCount = 0;
 
-	if (uniformBufferType == UNIFORM_BUFFER_VERTEX)
+	SDL_LockMutex(renderer->bufferSlabLock);
+
+	slab->freeSlots[slab->freeSlotCount] = buffer->slabSlot;
+	slab->freeSlotCount += 1;
+
+	if (slab->freeSlotCount < slab->slotCount)
 	{
-		resourceAccessType = RESOURCE_ACCESS_VERTEX_SHADER_READ_UNIFORM_BUFFER;
+		SDL_UnlockMutex(renderer->bufferSlabLock);
+		return NULL;
 	}
-	else if (uniformBufferType == UNIFORM_BUFFER_FRAGMENT)
+
+	/* keep the last slab of its kind around so we don't thrash */
+	for (i = 0; i < renderer->bufferSlabCounts[classIndex]; i += 1)
 	{
-		resourceAccessType = RESOURCE_ACCESS_FRAGMENT_SHADER_READ_UNIFORM_BUFFER;
+		if (renderer->bufferSlabs[classIndex][i]->buffer->usage == slab->buffer->usage)
+		{
+			sameUsageCount += 1;
+		}
 	}
-	else if (uniformBufferType == UNIFORM_BUFFER_COMPUTE)
+
+	if (sameUsageCount == 1)
 	{
-		resourceAccessType = RESOURCE_ACCESS_COMPUTE_SHADER_READ_UNIFORM_BUFFER;
+		SDL_UnlockMutex(renderer->bufferSlabLock);
+		return NULL;
 	}
-	else
+
+	for (i = 0; i < renderer->bufferSlabCounts[classIndex]; i += 1)
 	{
-		Refresh_LogError("Unrecognized uniform buffer type!");
-		return 0;
+		if (renderer->bufferSlabs[classIndex][i] == slab)
+		{
+			renderer->bufferSlabs[classIndex][i] = renderer->bufferSlabs[classIndex][renderer->bufferSlabCounts[classIndex] - 1];
+			renderer->bufferSlabCounts[classIndex] -= 1;
+			break;
+		}
 	}
 
-	uniformBufferPool->buffer = VULKAN_INTERNAL_CreateBuffer(
-		renderer,
-		UBO_BUFFER_SIZE,
-		resourceAccessType,
-		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-		1,
-		0,
-		1
-	);
+	SDL_UnlockMutex(renderer->bufferSlabLock);
+	return slab;
+}
 
-	uniformBufferPool->nextAvailableOffset = 0;
+static void VULKAN_INTERNAL_DestroyBuffer(
+	VulkanRenderer* renderer,
+	VulkanBuffer* buffer
+) {
+	VulkanBufferSlab *emptySlab;
 
-	uniformBufferPool->type = uniformBufferType;
-	uniformBufferPool->lock = SDL_CreateMutex();
+	/* suballocated buffers just hand their slot back */
+	if (buffer->slab != NULL)
+	{
+		emptySlab = VULKAN_INTERNAL_ReleaseBufferSlabSlot(renderer, buffer);
 
-	uniformBufferPool->availableBufferCapacity = 16;
-	uniformBufferPool->availableBufferCount = 0;
-	uniformBufferPool->availableBuffers = SDL_malloc(uniformBufferPool->availableBufferCapacity * sizeof(VulkanUniformBuffer*));
+		if (emptySlab != NULL)
+		{
+			VULKAN_INTERNAL_DestroyBuffer(renderer, emptySlab->buffer);
+			SDL_free(emptySlab->freeSlots);
+			SDL_free(emptySlab);
+		}
 
-	uniformBufferPool->descriptorPool.availableDescriptorSetCount = 0;
-	uniformBufferPool->descriptorPool.descriptorPoolCount = 0;
-	uniformBufferPool->descriptorPool.descriptorPools = NULL;
+		SDL_free(buffer);
+		return;
+	}
 
-	VULKAN_INTERNAL_AddUniformDescriptorPool(renderer, &uniformBufferPool->descriptorPool);
+	renderer->vkDestroyBuffer(
+		renderer->logicalDevice,
+		buffer->buffer,
+		NULL
+	);
 
-	return uniformBufferPool;
+	VULKAN_INTERNAL_RemoveMemoryUsedRegion(
+		renderer,
+		buffer->usedRegion
+	);
+
+	SDL_free(buffer);
 }
 
-static void VULKAN_INTERNAL_BindUniformBuffer(
+static void VULKAN_INTERNAL_DestroyCommandPool(
 	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
-	VulkanUniformBuffer *uniformBuffer
+	VulkanCommandPool *commandPool
 ) {
-	if (commandBuffer->boundUniformBufferCount >= commandBuffer->boundUniformBufferCapacity)
+	uint32_t i, j;
+	VulkanCommandBuffer* commandBuffer;
+
+	renderer->vkDestroyCommandPool(
+		renderer->logicalDevice,
+		commandPool->commandPool,
+		NULL
+	);
+
+	for (i = 0; i < commandPool->inactiveCommandBufferCount; i += 1)
 	{
-		commandBuffer->boundUniformBufferCapacity *= 2;
-		commandBuffer->boundUniformBuffers = SDL_realloc(
-			commandBuffer->boundUniformBuffers,
-			sizeof(VulkanUniformBuffer*) * commandBuffer->boundUniformBufferCapacity
-		);
+		commandBuffer = commandPool->inactiveCommandBuffers[i];
+
+		SDL_free(commandBuffer->presentDatas);
+		SDL_free(commandBuffer->waitSemaphores);
+		SDL_free(commandBuffer->waitSemaphoreStages);
+		SDL_free(commandBuffer->signalSemaphores);
+		SDL_free(commandBuffer->transferSemaphores);
+		SDL_free(commandBuffer->releaseBuffers);
+		SDL_free(commandBuffer->releaseBufferAccessTypes);
+		SDL_free(commandBuffer->releaseTextures);
+		SDL_free(commandBuffer->graphicsReleaseBufferBarriers);
+		SDL_free(commandBuffer->graphicsReleaseImageBarriers);
+		SDL_free(commandBuffer->transferBuffers);
+		SDL_free(commandBuffer->pendingBufferUploads);
+
+		for (j = 0; j < commandBuffer->uploadRegionCapacity; j += 1)
+		{
+			SDL_free(commandBuffer->uploadRegions[j]);
+		}
+		SDL_free(commandBuffer->uploadRegions);
+
+		SDL_free(commandBuffer->readbacks);
+		SDL_free(commandBuffer->boundUniformBuffers);
+		SDL_free(commandBuffer->boundDescriptorSetDatas);
+		SDL_free(commandBuffer->boundComputeBuffers);
+		SDL_free(commandBuffer->boundComputeTextures);
+		SDL_free(commandBuffer->usedBuffers);
+		SDL_free(commandBuffer->usedTextures);
+		SDL_free(commandBuffer->usedSamplers);
+		SDL_free(commandBuffer->usedGraphicsPipelines);
+		SDL_free(commandBuffer->usedComputePipelines);
+		SDL_free(commandBuffer->usedFramebuffers);
+
+		SDL_free(commandBuffer);
 	}
 
-	commandBuffer->boundUniformBuffers[commandBuffer->boundUniformBufferCount] = uniformBuffer;
-	commandBuffer->boundUniformBufferCount += 1;
+	SDL_free(commandPool->inactiveCommandBuffers);
+	SDL_free(commandPool);
 }
 
-/* Buffer indirection so we can cleanly defrag */
-static VulkanBufferContainer* VULKAN_INTERNAL_CreateBufferContainer(
+static void VULKAN_INTERNAL_DestroyGraphicsPipeline(
 	VulkanRenderer *renderer,
-	uint32_t sizeInBytes,
-	VulkanResourceAccessType resourceAccessType,
-	VkBufferUsageFlags usageFlags
+	VulkanGraphicsPipeline *graphicsPipeline
 ) {
-	VulkanBufferContainer* bufferContainer;
-	VulkanBuffer* buffer;
+	renderer->vkDestroyPipeline(
+		renderer->logicalDevice,
+		graphicsPipeline->pipeline,
+		NULL
+	);
 
-	/* always set transfer bits so we can defrag */
-	usageFlags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+	SDL_AtomicDecRef(&graphicsPipeline->vertexShaderModule->referenceCount);
+	SDL_AtomicDecRef(&graphicsPipeline->fragmentShaderModule->referenceCount);
 
-	buffer = VULKAN_INTERNAL_CreateBuffer(
-		renderer,
-		sizeInBytes,
-		resourceAccessType,
-		usageFlags,
-		0,
-		1,
-		0
+	SDL_free(graphicsPipeline);
+}
+
+static void VULKAN_INTERNAL_DestroyComputePipeline(
+	VulkanRenderer *renderer,
+	VulkanComputePipeline *computePipeline
+) {
+	renderer->vkDestroyPipeline(
+		renderer->logicalDevice,
+		computePipeline->pipeline,
+		NULL
 	);
 
-	if (buffer == NULL)
-	{
-		Refresh_LogError("Failed to create buffer!");
-		return NULL;
-	}
+	SDL_AtomicDecRef(&computePipeline->computeShaderModule->referenceCount);
 
-	bufferContainer = SDL_malloc(sizeof(VulkanBufferContainer));
-	bufferContainer->vulkanBuffer = buffer;
-	buffer->container = bufferContainer;
+	SDL_free(computePipeline);
+}
 
-	return (VulkanBufferContainer*) bufferContainer;
+static void VULKAN_INTERNAL_DestroyShaderModule(
+	VulkanRenderer *renderer,
+	VulkanShaderModule *vulkanShaderModule
+) {
+	renderer->vkDestroyShaderModule(
+		renderer->logicalDevice,
+		vulkanShaderModule->shaderModule,
+		NULL
+	);
+
+	SDL_free(vulkanShaderModule);
 }
 
-static uint8_t VULKAN_INTERNAL_CreateUniformBuffer(
+static void VULKAN_INTERNAL_DestroySampler(
 	VulkanRenderer *renderer,
-	VulkanUniformBufferPool *bufferPool
+	VulkanSampler *vulkanSampler
 ) {
-	VkDescriptorSetLayout descriptorSetLayout;
+	renderer->vkDestroySampler(
+		renderer->logicalDevice,
+		vulkanSampler->sampler,
+		NULL
+	);
+
+	SDL_free(vulkanSampler);
+}
+
+static void VULKAN_INTERNAL_DestroySwapchain(
+	VulkanRenderer* renderer,
+	WindowData *windowData
+) {
+	uint32_t i;
+	VulkanSwapchainData *swapchainData;
 
-	if (bufferPool->type == UNIFORM_BUFFER_VERTEX)
+	if (windowData == NULL)
 	{
-		descriptorSetLayout = renderer->vertexUniformDescriptorSetLayout;
+		return;
 	}
-	else if (bufferPool->type == UNIFORM_BUFFER_FRAGMENT)
-	{
-		descriptorSetLayout = renderer->fragmentUniformDescriptorSetLayout;
-	}
-	else if (bufferPool->type == UNIFORM_BUFFER_COMPUTE)
-	{
-		descriptorSetLayout = renderer->computeUniformDescriptorSetLayout;
-	}
-	else
-	{
-		Refresh_LogError("Unrecognized uniform buffer type!");
-		return 0;
-	}
-
-	VulkanUniformBuffer *uniformBuffer = SDL_malloc(sizeof(VulkanUniformBuffer));
-	uniformBuffer->pool = bufferPool;
-	uniformBuffer->poolOffset = bufferPool->nextAvailableOffset;
-	uniformBuffer->offset = 0;
 
-	bufferPool->nextAvailableOffset += VULKAN_INTERNAL_NextHighestAlignment(UBO_SECTION_SIZE, renderer->minUBOAlignment);
+	swapchainData = windowData->swapchainData;
 
-	if (bufferPool->nextAvailableOffset >= UBO_BUFFER_SIZE)
+	if (swapchainData == NULL)
 	{
-		Refresh_LogError("Uniform buffer overflow!");
-		SDL_free(uniformBuffer);
-		return 0;
+		return;
 	}
 
-	/* Allocate a descriptor set for the uniform buffer */
-
-	if (bufferPool->descriptorPool.availableDescriptorSetCount == 0)
+	for (i = 0; i < swapchainData->imageCount; i += 1)
 	{
-		if (!VULKAN_INTERNAL_AddUniformDescriptorPool(
+		VULKAN_INTERNAL_RemoveRenderTargetsContainingTexture(
 			renderer,
-			&bufferPool->descriptorPool
-		)) {
-			Refresh_LogError("Failed to add uniform descriptor pool!");
-			SDL_free(uniformBuffer);
-			return 0;
-		}
-	}
+			swapchainData->textureContainers[i].vulkanTexture
+		);
 
-	if (!VULKAN_INTERNAL_AllocateDescriptorSets(
-		renderer,
-		bufferPool->descriptorPool.descriptorPools[bufferPool->descriptorPool.descriptorPoolCount - 1],
-		descriptorSetLayout,
-		1,
-		&uniformBuffer->descriptorSet
-	)) {
-		Refresh_LogError("Failed to allocate uniform descriptor set!");
-		return 0;
+		renderer->vkDestroyImageView(
+			renderer->logicalDevice,
+			swapchainData->textureContainers[i].vulkanTexture->view,
+			NULL
+		);
+
+		SDL_free(swapchainData->textureContainers[i].vulkanTexture->subresourceAccessTypes);
+		SDL_free(swapchainData->textureContainers[i].vulkanTexture);
 	}
 
-	bufferPool->descriptorPool.availableDescriptorSetCount -= 1;
+	SDL_free(swapchainData->textureContainers);
 
-	if (bufferPool->availableBufferCount >= bufferPool->availableBufferCapacity)
-	{
-		bufferPool->availableBufferCapacity *= 2;
+	renderer->vkDestroySwapchainKHR(
+		renderer->logicalDevice,
+		swapchainData->swapchain,
+		NULL
+	);
 
-		bufferPool->availableBuffers = SDL_realloc(
-			bufferPool->availableBuffers,
-			sizeof(VulkanUniformBuffer*) * bufferPool->availableBufferCapacity
-		);
-	}
+	renderer->vkDestroySurfaceKHR(
+		renderer->instance,
+		swapchainData->surface,
+		NULL
+	);
 
-	bufferPool->availableBuffers[bufferPool->availableBufferCount] = uniformBuffer;
-	bufferPool->availableBufferCount += 1;
+	renderer->vkDestroySemaphore(
+		renderer->logicalDevice,
+		swapchainData->imageAvailableSemaphore,
+		NULL
+	);
 
-	return 1;
+	renderer->vkDestroySemaphore(
+		renderer->logicalDevice,
+		swapchainData->renderFinishedSemaphore,
+		NULL
+	);
+
+	windowData->swapchainData = NULL;
+	SDL_free(swapchainData);
 }
 
-static VulkanUniformBuffer* VULKAN_INTERNAL_CreateDummyUniformBuffer(
+static void VULKAN_INTERNAL_DestroyDescriptorSetCache(
 	VulkanRenderer *renderer,
-	VulkanUniformBufferType uniformBufferType
+	DescriptorSetCache *cache
 ) {
-	VkDescriptorSetLayout descriptorSetLayout;
-	VkWriteDescriptorSet writeDescriptorSet;
-	VkDescriptorBufferInfo descriptorBufferInfo;
+	uint32_t i;
 
-	if (uniformBufferType == UNIFORM_BUFFER_VERTEX)
-	{
-		descriptorSetLayout = renderer->vertexUniformDescriptorSetLayout;
-	}
-	else if (uniformBufferType == UNIFORM_BUFFER_FRAGMENT)
-	{
-		descriptorSetLayout = renderer->fragmentUniformDescriptorSetLayout;
-	}
-	else if (uniformBufferType == UNIFORM_BUFFER_COMPUTE)
+	if (cache == NULL)
 	{
-		descriptorSetLayout = renderer->computeUniformDescriptorSetLayout;
+		return;
 	}
-	else
+
+	for (i = 0; i < cache->descriptorPoolCount; i += 1)
 	{
-		Refresh_LogError("Unrecognized uniform buffer type!");
-		return NULL;
+		renderer->vkDestroyDescriptorPool(
+			renderer->logicalDevice,
+			cache->descriptorPools[i],
+			NULL
+		);
 	}
 
-	VulkanUniformBuffer *uniformBuffer = SDL_malloc(sizeof(VulkanUniformBuffer));
-	uniformBuffer->poolOffset = 0;
-	uniformBuffer->offset = 0;
+	SDL_free(cache->descriptorPools);
+	SDL_free(cache->inactiveDescriptorSets);
+	SDL_DestroyMutex(cache->lock);
+	SDL_free(cache);
+}
 
-	/* Allocate a descriptor set for the uniform buffer */
+/* Descriptor cache stuff */
 
-	VULKAN_INTERNAL_AllocateDescriptorSets(
-		renderer,
-		renderer->defaultDescriptorPool,
-		descriptorSetLayout,
-		1,
-		&uniformBuffer->descriptorSet
-	);
+static uint8_t VULKAN_INTERNAL_CreateDescriptorPool(
+	VulkanRenderer *renderer,
+	VkDescriptorType descriptorType,
+	uint32_t descriptorSetCount,
+	uint32_t descriptorCount,
+	VkDescriptorPool *pDescriptorPool
+) {
+	VkResult vulkanResult;
 
-	/* Update the descriptor set for the first and last time! */
+	VkDescriptorPoolSize descriptorPoolSize;
+	VkDescriptorPoolCreateInfo descriptorPoolInfo;
 
-	descriptorBufferInfo.buffer = renderer->dummyBuffer->buffer;
-	descriptorBufferInfo.offset = 0;
-	descriptorBufferInfo.range = VK_WHOLE_SIZE;
+	descriptorPoolSize.type = descriptorType;
+	descriptorPoolSize.descriptorCount = descriptorCount;
 
-	writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-	writeDescriptorSet.pNext = NULL;
-	writeDescriptorSet.descriptorCount = 1;
-	writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-	writeDescriptorSet.dstArrayElement = 0;
-	writeDescriptorSet.dstBinding = 0;
-	writeDescriptorSet.dstSet = uniformBuffer->descriptorSet;
-	writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
-	writeDescriptorSet.pImageInfo = NULL;
-	writeDescriptorSet.pTexelBufferView = NULL;
+	descriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolInfo.pNext = NULL;
+	descriptorPoolInfo.flags = 0;
+	descriptorPoolInfo.maxSets = descriptorSetCount;
+	descriptorPoolInfo.poolSizeCount = 1;
+	descriptorPoolInfo.pPoolSizes = &descriptorPoolSize;
 
-	renderer->vkUpdateDescriptorSets(
+	vulkanResult = renderer->vkCreateDescriptorPool(
 		renderer->logicalDevice,
-		1,
-		&writeDescriptorSet,
-		0,
-		NULL
+		&descriptorPoolInfo,
+		NULL,
+		pDescriptorPool
 	);
 
-	uniformBuffer->pool = NULL; /* No pool because this is a dummy */
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkCreateDescriptorPool", vulkanResult);
+		return 0;
+	}
 
-	return uniformBuffer;
+	return 1;
 }
 
-static void VULKAN_INTERNAL_DestroyUniformBufferPool(
+static uint8_t VULKAN_INTERNAL_AllocateDescriptorSets(
 	VulkanRenderer *renderer,
-	VulkanUniformBufferPool *uniformBufferPool
+	VkDescriptorPool descriptorPool,
+	VkDescriptorSetLayout descriptorSetLayout,
+	uint32_t descriptorSetCount,
+	VkDescriptorSet *descriptorSetArray
 ) {
+	VkResult vulkanResult;
 	uint32_t i;
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo;
+	VkDescriptorSetLayout *descriptorSetLayouts = SDL_stack_alloc(VkDescriptorSetLayout, descriptorSetCount);
 
-	for (i = 0; i < uniformBufferPool->descriptorPool.descriptorPoolCount; i += 1)
+	for (i = 0; i < descriptorSetCount; i += 1)
 	{
-		renderer->vkDestroyDescriptorPool(
-			renderer->logicalDevice,
-			uniformBufferPool->descriptorPool.descriptorPools[i],
-			NULL
-		);
+		descriptorSetLayouts[i] = descriptorSetLayout;
 	}
-	SDL_free(uniformBufferPool->descriptorPool.descriptorPools);
 
-	/* This is always destroyed after submissions, so all buffers are available */
-	for (i = 0; i < uniformBufferPool->availableBufferCount; i += 1)
+	descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorSetAllocateInfo.pNext = NULL;
+	descriptorSetAllocateInfo.descriptorPool = descriptorPool;
+	descriptorSetAllocateInfo.descriptorSetCount = descriptorSetCount;
+	descriptorSetAllocateInfo.pSetLayouts = descriptorSetLayouts;
+
+	vulkanResult = renderer->vkAllocateDescriptorSets(
+		renderer->logicalDevice,
+		&descriptorSetAllocateInfo,
+		descriptorSetArray
+	);
+
+	if (vulkanResult != VK_SUCCESS)
 	{
-		SDL_free(uniformBufferPool->availableBuffers[i]);
+		LogVulkanResultAsError("vkAllocateDescriptorSets", vulkanResult);
+		SDL_stack_free(descriptorSetLayouts);
+		return 0;
 	}
 
-	VULKAN_INTERNAL_DestroyBuffer(renderer, uniformBufferPool->buffer);
-
-	SDL_DestroyMutex(uniformBufferPool->lock);
-	SDL_free(uniformBufferPool->availableBuffers);
-	SDL_free(uniformBufferPool);
+	SDL_stack_free(descriptorSetLayouts);
+	return 1;
 }
 
-static VulkanUniformBuffer* VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+static DescriptorSetCache* VULKAN_INTERNAL_CreateDescriptorSetCache(
 	VulkanRenderer *renderer,
-	VulkanUniformBufferPool *bufferPool,
-	VkDeviceSize blockSize
+	VkDescriptorType descriptorType,
+	VkDescriptorSetLayout descriptorSetLayout,
+	uint32_t bindingCount,
+	uint32_t descriptorCount
 ) {
-	VkWriteDescriptorSet writeDescriptorSet;
-	VkDescriptorBufferInfo descriptorBufferInfo;
-
-	SDL_LockMutex(bufferPool->lock);
+	DescriptorSetCache *descriptorSetCache = SDL_malloc(sizeof(DescriptorSetCache));
 
-	if (bufferPool->availableBufferCount == 0)
-	{
-		if (!VULKAN_INTERNAL_CreateUniformBuffer(renderer, bufferPool))
-		{
-			SDL_UnlockMutex(bufferPool->lock);
-			Refresh_LogError("Failed to create uniform buffer!");
-			return NULL;
-		}
-	}
+	descriptorSetCache->lock = SDL_CreateMutex();
 
-	VulkanUniformBuffer *uniformBuffer = bufferPool->availableBuffers[bufferPool->availableBufferCount - 1];
-	bufferPool->availableBufferCount -= 1;
+	descriptorSetCache->descriptorSetLayout = descriptorSetLayout;
+	descriptorSetCache->bindingCount = bindingCount;
+	descriptorSetCache->descriptorCount = descriptorCount;
+	descriptorSetCache->descriptorType = descriptorType;
 
-	SDL_UnlockMutex(bufferPool->lock);
+	descriptorSetCache->descriptorPools = SDL_malloc(sizeof(VkDescriptorPool));
+	descriptorSetCache->descriptorPoolCount = 1;
+	descriptorSetCache->nextPoolSize = DESCRIPTOR_POOL_STARTING_SIZE * 2;
 
-	uniformBuffer->offset = 0;
+	VULKAN_INTERNAL_CreateDescriptorPool(
+		renderer,
+		descriptorType,
+		DESCRIPTOR_POOL_STARTING_SIZE,
+		DESCRIPTOR_POOL_STARTING_SIZE * descriptorCount,
+		&descriptorSetCache->descriptorPools[0]
+	);
 
-	/* Update the descriptor set with the correct range */
+	descriptorSetCache->inactiveDescriptorSetCapacity = DESCRIPTOR_POOL_STARTING_SIZE;
+	descriptorSetCache->inactiveDescriptorSetCount = DESCRIPTOR_POOL_STARTING_SIZE;
+	descriptorSetCache->inactiveDescriptorSets = SDL_malloc(
+		sizeof(VkDescriptorSet) * DESCRIPTOR_POOL_STARTING_SIZE
+	);
 
-	descriptorBufferInfo.buffer = uniformBuffer->pool->buffer->buffer;
-	descriptorBufferInfo.offset = uniformBuffer->poolOffset;
-	descriptorBufferInfo.range = blockSize;
-
-	writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-	writeDescriptorSet.pNext = NULL;
-	writeDescriptorSet.descriptorCount = 1;
-	writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-	writeDescriptorSet.dstArrayElement = 0;
-	writeDescriptorSet.dstBinding = 0;
-	writeDescriptorSet.dstSet = uniformBuffer->descriptorSet;
-	writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
-	writeDescriptorSet.pImageInfo = NULL;
-	writeDescriptorSet.pTexelBufferView = NULL;
-
-	renderer->vkUpdateDescriptorSets(
-		renderer->logicalDevice,
-		1,
-		&writeDescriptorSet,
-		0,
-		NULL
+	VULKAN_INTERNAL_AllocateDescriptorSets(
+		renderer,
+		descriptorSetCache->descriptorPools[0],
+		descriptorSetCache->descriptorSetLayout,
+		DESCRIPTOR_POOL_STARTING_SIZE,
+		descriptorSetCache->inactiveDescriptorSets
 	);
 
-	return uniformBuffer;
+	return descriptorSetCache;
 }
 
-/* Swapchain */
-
-static uint8_t VULKAN_INTERNAL_QuerySwapChainSupport(
+static VkDescriptorSetLayout VULKAN_INTERNAL_FetchDescriptorSetLayout(
 	VulkanRenderer *renderer,
-	VkPhysicalDevice physicalDevice,
-	VkSurfaceKHR surface,
-	SwapChainSupportDetails *outputDetails
+	VkDescriptorType descriptorType,
+	uint32_t bindingCount,
+	VkShaderStageFlagBits shaderStageFlagBit,
+	uint32_t immutableSamplerMask,
+	VkSampler immutableSampler
 ) {
-	VkResult result;
-	VkBool32 supportsPresent;
+	DescriptorSetLayoutHash descriptorSetLayoutHash;
+	VkDescriptorSetLayout descriptorSetLayout;
 
-	renderer->vkGetPhysicalDeviceSurfaceSupportKHR(
-		physicalDevice,
-		renderer->queueFamilyIndex,
-		surface,
-		&supportsPresent
-	);
+	VkDescriptorSetLayoutBinding setLayoutBindings[MAX_TEXTURE_SAMPLERS];
+	VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo;
 
-	if (!supportsPresent)
+	VkResult vulkanResult;
+	uint32_t i;
+
+	if (bindingCount == 0)
 	{
-		Refresh_LogWarn("This surface does not support presenting!");
-		return 0;
+		if (shaderStageFlagBit == VK_SHADER_STAGE_VERTEX_BIT)
+		{
+			return renderer->emptyVertexSamplerLayout;
+		}
+		else if (shaderStageFlagBit == VK_SHADER_STAGE_FRAGMENT_BIT)
+		{
+			return renderer->emptyFragmentSamplerLayout;
+		}
+		else if (shaderStageFlagBit == VK_SHADER_STAGE_COMPUTE_BIT)
+		{
+			if (descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+			{
+				return renderer->emptyComputeBufferDescriptorSetLayout;
+			}
+			else if (descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE)
+			{
+				return renderer->emptyComputeImageDescriptorSetLayout;
+			}
+			else
+			{
+				Refresh_LogError("Invalid descriptor type for compute shader: ", descriptorType);
+				return NULL_DESC_LAYOUT;
+			}
+		}
+		else
+		{
+			Refresh_LogError("Invalid shader stage flag bit: ", shaderStageFlagBit);
+			return NULL_DESC_LAYOUT;
+		}
 	}
 
-	/* Initialize these in case anything fails */
-	outputDetails->formatsLength = 0;
-	outputDetails->presentModesLength = 0;
+	descriptorSetLayoutHash.descriptorType = descriptorType;
+	descriptorSetLayoutHash.bindingCount = bindingCount;
+	descriptorSetLayoutHash.stageFlag = shaderStageFlagBit;
+	descriptorSetLayoutHash.immutableSamplerMask = immutableSamplerMask;
+	descriptorSetLayoutHash.immutableSampler = immutableSampler;
 
-	/* Run the device surface queries */
-	result = renderer->vkGetPhysicalDeviceSurfaceCapabilitiesKHR(
-		physicalDevice,
-		surface,
-		&outputDetails->capabilities
+	descriptorSetLayout = DescriptorSetLayoutHashTable_Fetch(
+		&renderer->descriptorSetLayoutHashTable,
+		descriptorSetLayoutHash
 	);
-	VULKAN_ERROR_CHECK(result, vkGetPhysicalDeviceSurfaceCapabilitiesKHR, 0)
 
-	if (!(outputDetails->capabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR))
+	if (descriptorSetLayout != VK_NULL_HANDLE)
 	{
-		Refresh_LogWarn("Opaque presentation unsupported! Expect weird transparency bugs!");
+		return descriptorSetLayout;
 	}
 
-	result = renderer->vkGetPhysicalDeviceSurfaceFormatsKHR(
-		physicalDevice,
-		surface,
-		&outputDetails->formatsLength,
-		NULL
-	);
-	VULKAN_ERROR_CHECK(result, vkGetPhysicalDeviceSurfaceFormatsKHR, 0)
-	result = renderer->vkGetPhysicalDeviceSurfacePresentModesKHR(
-		physicalDevice,
-		surface,
-		&outputDetails->presentModesLength,
-		NULL
-	);
-	VULKAN_ERROR_CHECK(result, vkGetPhysicalDeviceSurfacePresentModesKHR, 0)
-
-	/* Generate the arrays, if applicable */
-	if (outputDetails->formatsLength != 0)
+	for (i = 0; i < bindingCount; i += 1)
 	{
-		outputDetails->formats = (VkSurfaceFormatKHR*) SDL_malloc(
-			sizeof(VkSurfaceFormatKHR) * outputDetails->formatsLength
-		);
-
-		if (!outputDetails->formats)
-		{
-			SDL_OutOfMemory();
-			return 0;
-		}
-
-		result = renderer->vkGetPhysicalDeviceSurfaceFormatsKHR(
-			physicalDevice,
-			surface,
-			&outputDetails->formatsLength,
-			outputDetails->formats
-		);
-		if (result != VK_SUCCESS)
-		{
-			Refresh_LogError(
-				"vkGetPhysicalDeviceSurfaceFormatsKHR: %s",
-				VkErrorMessages(result)
-			);
-
-			SDL_free(outputDetails->formats);
-			return 0;
-		}
+		setLayoutBindings[i].binding = i;
+		setLayoutBindings[i].descriptorCount = 1;
+		setLayoutBindings[i].descriptorType = descriptorType;
+		setLayoutBindings[i].stageFlags = shaderStageFlagBit;
+		setLayoutBindings[i].pImmutableSamplers =
+			(immutableSamplerMask & (1u << i)) ? &immutableSampler : NULL;
 	}
-	if (outputDetails->presentModesLength != 0)
-	{
-		outputDetails->presentModes = (VkPresentModeKHR*) SDL_malloc(
-			sizeof(VkPresentModeKHR) * outputDetails->presentModesLength
-		);
 
-		if (!outputDetails->presentModes)
-		{
-			SDL_OutOfMemory();
-			return 0;
-		}
+	setLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	setLayoutCreateInfo.pNext = NULL;
+	setLayoutCreateInfo.flags = 0;
+	setLayoutCreateInfo.bindingCount = bindingCount;
+	setLayoutCreateInfo.pBindings = setLayoutBindings;
 
-		result = renderer->vkGetPhysicalDeviceSurfacePresentModesKHR(
-			physicalDevice,
-			surface,
-			&outputDetails->presentModesLength,
-			outputDetails->presentModes
-		);
-		if (result != VK_SUCCESS)
-		{
-			Refresh_LogError(
-				"vkGetPhysicalDeviceSurfacePresentModesKHR: %s",
-				VkErrorMessages(result)
-			);
+	vulkanResult = renderer->vkCreateDescriptorSetLayout(
+		renderer->logicalDevice,
+		&setLayoutCreateInfo,
+		NULL,
+		&descriptorSetLayout
+	);
 
-			SDL_free(outputDetails->formats);
-			SDL_free(outputDetails->presentModes);
-			return 0;
-		}
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkCreateDescriptorSetLayout", vulkanResult);
+		return NULL_DESC_LAYOUT;
 	}
 
-	/* If we made it here, all the queries were successfull. This does NOT
-	 * necessarily mean there are any supported formats or present modes!
-	 */
-	return 1;
+	DescriptorSetLayoutHashTable_Insert(
+		&renderer->descriptorSetLayoutHashTable,
+		descriptorSetLayoutHash,
+		descriptorSetLayout
+	);
+
+	return descriptorSetLayout;
 }
 
-static uint8_t VULKAN_INTERNAL_ChooseSwapSurfaceFormat(
-	VkFormat desiredFormat,
-	VkSurfaceFormatKHR *availableFormats,
-	uint32_t availableFormatsLength,
-	VkSurfaceFormatKHR *outputFormat
+static VulkanGraphicsPipelineLayout* VULKAN_INTERNAL_FetchGraphicsPipelineLayout(
+	VulkanRenderer *renderer,
+	uint32_t vertexSamplerBindingCount,
+	uint32_t fragmentSamplerBindingCount,
+	uint32_t vertexPushConstantSize,
+	uint32_t fragmentPushConstantSize,
+	uint32_t fragmentYCbCrSamplerMask,
+	int32_t ycbcrFormatIndex
 ) {
+	VkDescriptorSetLayout setLayouts[4];
+	VkPushConstantRange pushConstantRanges[2];
+	uint32_t pushConstantRangeCount = 0;
+	VkSampler fragmentYCbCrSampler = VK_NULL_HANDLE;
+	uint32_t fragmentDescriptorCount = fragmentSamplerBindingCount;
 	uint32_t i;
-	for (i = 0; i < availableFormatsLength; i += 1)
+
+	GraphicsPipelineLayoutHash pipelineLayoutHash;
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
+	VkResult vulkanResult;
+
+	VulkanGraphicsPipelineLayout *vulkanGraphicsPipelineLayout;
+
+	if (fragmentYCbCrSamplerMask != 0)
 	{
-		if (	availableFormats[i].format == desiredFormat &&
-			availableFormats[i].colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR	)
+		fragmentYCbCrSampler = renderer->ycbcrSamplers[ycbcrFormatIndex];
+
+		for (i = 0; i < fragmentSamplerBindingCount; i += 1)
 		{
-			*outputFormat = availableFormats[i];
-			return 1;
+			if (fragmentYCbCrSamplerMask & (1u << i))
+			{
+				fragmentDescriptorCount += renderer->ycbcrDescriptorCounts[ycbcrFormatIndex] - 1;
+			}
 		}
 	}
 
-	return 0;
-}
+	pipelineLayoutHash.vertexSamplerLayout = VULKAN_INTERNAL_FetchDescriptorSetLayout(
+		renderer,
+		VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+		vertexSamplerBindingCount,
+		VK_SHADER_STAGE_VERTEX_BIT,
+		0,
+		VK_NULL_HANDLE
+	);
 
-static uint8_t VULKAN_INTERNAL_ChooseSwapPresentMode(
-	Refresh_PresentMode desiredPresentInterval,
-	VkPresentModeKHR *availablePresentModes,
-	uint32_t availablePresentModesLength,
-	VkPresentModeKHR *outputPresentMode
-) {
-	#define CHECK_MODE(m) \
-		for (i = 0; i < availablePresentModesLength; i += 1) \
-		{ \
-			if (availablePresentModes[i] == m) \
-			{ \
-				*outputPresentMode = m; \
-				return 1; \
-			} \
-		} \
+	pipelineLayoutHash.fragmentSamplerLayout = VULKAN_INTERNAL_FetchDescriptorSetLayout(
+		renderer,
+		VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+		fragmentSamplerBindingCount,
+		VK_SHADER_STAGE_FRAGMENT_BIT,
+		fragmentYCbCrSamplerMask,
+		fragmentYCbCrSampler
+	);
 
-	uint32_t i;
-	if (desiredPresentInterval == REFRESH_PRESENTMODE_IMMEDIATE)
+	pipelineLayoutHash.vertexUniformLayout = renderer->vertexUniformDescriptorSetLayout;
+	pipelineLayoutHash.fragmentUniformLayout = renderer->fragmentUniformDescriptorSetLayout;
+	pipelineLayoutHash.vertexPushConstantSize = vertexPushConstantSize;
+	pipelineLayoutHash.fragmentPushConstantSize = fragmentPushConstantSize;
+
+	vulkanGraphicsPipelineLayout = GraphicsPipelineLayoutHashArray_Fetch(
+		&renderer->graphicsPipelineLayoutHashTable,
+		pipelineLayoutHash
+	);
+
+	if (vulkanGraphicsPipelineLayout != NULL)
 	{
-		CHECK_MODE(VK_PRESENT_MODE_IMMEDIATE_KHR)
+		return vulkanGraphicsPipelineLayout;
 	}
-	else if (desiredPresentInterval == REFRESH_PRESENTMODE_MAILBOX)
+
+	vulkanGraphicsPipelineLayout = SDL_malloc(sizeof(VulkanGraphicsPipelineLayout));
+	vulkanGraphicsPipelineLayout->fragmentYCbCrSamplerMask = fragmentYCbCrSamplerMask;
+	vulkanGraphicsPipelineLayout->fragmentYCbCrSampler = fragmentYCbCrSampler;
+
+	setLayouts[0] = pipelineLayoutHash.vertexSamplerLayout;
+	setLayouts[1] = pipelineLayoutHash.fragmentSamplerLayout;
+	setLayouts[2] = renderer->vertexUniformDescriptorSetLayout;
+	setLayouts[3] = renderer->fragmentUniformDescriptorSetLayout;
+
+	/* Fixed split, so shaders can hardcode the fragment block's offset */
+	if (vertexPushConstantSize > 0)
 	{
-		CHECK_MODE(VK_PRESENT_MODE_MAILBOX_KHR)
+		pushConstantRanges[pushConstantRangeCount].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		pushConstantRanges[pushConstantRangeCount].offset = 0;
+		pushConstantRanges[pushConstantRangeCount].size = vertexPushConstantSize;
+		pushConstantRangeCount += 1;
 	}
-	else if (desiredPresentInterval == REFRESH_PRESENTMODE_FIFO)
+
+	if (fragmentPushConstantSize > 0)
 	{
-		CHECK_MODE(VK_PRESENT_MODE_FIFO_KHR)
+		pushConstantRanges[pushConstantRangeCount].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstantRanges[pushConstantRangeCount].offset = FRAGMENT_PUSH_CONSTANT_OFFSET;
+		pushConstantRanges[pushConstantRangeCount].size = fragmentPushConstantSize;
+		pushConstantRangeCount += 1;
 	}
-	else if (desiredPresentInterval == REFRESH_PRESENTMODE_FIFO_RELAXED)
+
+	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.pNext = NULL;
+	pipelineLayoutCreateInfo.flags = 0;
+	pipelineLayoutCreateInfo.setLayoutCount = 4;
+	pipelineLayoutCreateInfo.pSetLayouts = setLayouts;
+	pipelineLayoutCreateInfo.pushConstantRangeCount = pushConstantRangeCount;
+	pipelineLayoutCreateInfo.pPushConstantRanges = pushConstantRanges;
+
+	vulkanResult = renderer->vkCreatePipelineLayout(
+		renderer->logicalDevice,
+		&pipelineLayoutCreateInfo,
+		NULL,
+		&vulkanGraphicsPipelineLayout->pipelineLayout
+	);
+
+	if (vulkanResult != VK_SUCCESS)
 	{
-		CHECK_MODE(VK_PRESENT_MODE_FIFO_RELAXED_KHR)
+		LogVulkanResultAsError("vkCreatePipelineLayout", vulkanResult);
+		return NULL;
+	}
+
+	GraphicsPipelineLayoutHashArray_Insert(
+		&renderer->graphicsPipelineLayoutHashTable,
+		pipelineLayoutHash,
+		vulkanGraphicsPipelineLayout
+	);
+
+	/* If the binding count is 0
+	 * we can just bind the same descriptor set
+	 * so no cache is needed
+	 */
+
+	if (vertexSamplerBindingCount == 0)
+	{
+		vulkanGraphicsPipelineLayout->vertexSamplerDescriptorSetCache = NULL;
 	}
 	else
 	{
-		Refresh_LogError(
-			"Unrecognized PresentInterval: %d",
-			desiredPresentInterval
-		);
-		return 0;
+		vulkanGraphicsPipelineLayout->vertexSamplerDescriptorSetCache =
+			VULKAN_INTERNAL_CreateDescriptorSetCache(
+				renderer,
+				VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+				pipelineLayoutHash.vertexSamplerLayout,
+				vertexSamplerBindingCount,
+				vertexSamplerBindingCount
+			);
 	}
 
-	#undef CHECK_MODE
+	if (fragmentSamplerBindingCount == 0)
+	{
+		vulkanGraphicsPipelineLayout->fragmentSamplerDescriptorSetCache = NULL;
+	}
+	else
+	{
+		vulkanGraphicsPipelineLayout->fragmentSamplerDescriptorSetCache =
+			VULKAN_INTERNAL_CreateDescriptorSetCache(
+				renderer,
+				VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+				pipelineLayoutHash.fragmentSamplerLayout,
+				fragmentSamplerBindingCount,
+				fragmentDescriptorCount
+			);
+	}
 
-	*outputPresentMode = VK_PRESENT_MODE_FIFO_KHR;
-	return 1;
+	return vulkanGraphicsPipelineLayout;
 }
 
-static uint8_t VULKAN_INTERNAL_CreateSwapchain(
+/* Data Buffer */
+
+static VulkanBuffer* VULKAN_INTERNAL_CreateBuffer(
 	VulkanRenderer *renderer,
-	WindowData *windowData
+	VkDeviceSize size,
+	VulkanResourceAccessType resourceAccessType,
+	VkBufferUsageFlags usage,
+	uint8_t requireHostVisible,
+	uint8_t preferDeviceLocal,
+	uint8_t preferHostCached,
+	uint8_t dedicatedAllocation,
+	uint8_t transient
 ) {
+	VulkanBuffer* buffer;
 	VkResult vulkanResult;
-	VulkanSwapchainData *swapchainData;
-	VkSwapchainCreateInfoKHR swapchainCreateInfo;
-	VkImage *swapchainImages;
-	VkImageViewCreateInfo imageViewCreateInfo;
-	VkSemaphoreCreateInfo semaphoreCreateInfo;
-	SwapChainSupportDetails swapchainSupportDetails;
-	int32_t drawableWidth, drawableHeight;
-	uint32_t i;
+	VkBufferCreateInfo bufferCreateInfo;
+	uint32_t queueFamilyIndices[2];
+	uint8_t bindResult;
 
-	swapchainData = SDL_malloc(sizeof(VulkanSwapchainData));
+	buffer = SDL_malloc(sizeof(VulkanBuffer));
 
-	/* Each swapchain must have its own surface. */
+	buffer->offset = 0;
+	buffer->size = size;
+	buffer->slab = NULL;
+	buffer->slabSlot = 0;
+	buffer->usedOnGraphicsQueue = 0;
+	buffer->resourceAccessType = resourceAccessType;
+	buffer->usage = usage;
+	buffer->requireHostVisible = requireHostVisible;
+	buffer->preferDeviceLocal = preferDeviceLocal;
+	buffer->preferHostCached = preferHostCached;
 
-	if (!SDL_Vulkan_CreateSurface(
-		(SDL_Window*) windowData->windowHandle,
-		renderer->instance,
-		&swapchainData->surface
-	)) {
-		SDL_free(swapchainData);
-		Refresh_LogError(
-			"SDL_Vulkan_CreateSurface failed: %s",
-			SDL_GetError()
-		);
-		return 0;
+	bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferCreateInfo.pNext = NULL;
+	bufferCreateInfo.flags = 0;
+	bufferCreateInfo.size = size;
+	bufferCreateInfo.usage = usage;
+	/* Staging buffers are read by both queues, so skip ownership transfers for them */
+	if (	renderer->transferQueueFamilyIndex != renderer->queueFamilyIndex &&
+		(usage & ~(VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)) == 0	)
+	{
+		queueFamilyIndices[0] = renderer->queueFamilyIndex;
+		queueFamilyIndices[1] = renderer->transferQueueFamilyIndex;
+
+		bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+		bufferCreateInfo.queueFamilyIndexCount = 2;
+		bufferCreateInfo.pQueueFamilyIndices = queueFamilyIndices;
+	}
+	else
+	{
+		bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bufferCreateInfo.queueFamilyIndexCount = 1;
+		bufferCreateInfo.pQueueFamilyIndices = &renderer->queueFamilyIndex;
 	}
 
-	if (!VULKAN_INTERNAL_QuerySwapChainSupport(
+	vulkanResult = renderer->vkCreateBuffer(
+		renderer->logicalDevice,
+		&bufferCreateInfo,
+		NULL,
+		&buffer->buffer
+	);
+	VULKAN_ERROR_CHECK(vulkanResult, vkCreateBuffer, 0)
+
+	bindResult = VULKAN_INTERNAL_BindMemoryForBuffer(
 		renderer,
-		renderer->physicalDevice,
-		swapchainData->surface,
-		&swapchainSupportDetails
-	)) {
-		renderer->vkDestroySurfaceKHR(
-			renderer->instance,
-			swapchainData->surface,
-			NULL
-		);
-		if (swapchainSupportDetails.formatsLength > 0)
-		{
-			SDL_free(swapchainSupportDetails.formats);
-		}
-		if (swapchainSupportDetails.presentModesLength > 0)
+		buffer->buffer,
+		buffer->size,
+		buffer->requireHostVisible,
+		buffer->preferDeviceLocal,
+		buffer->preferHostCached,
+		dedicatedAllocation,
+		transient,
+		&buffer->usedRegion
+	);
+
+	if (bindResult != 1)
+	{
+		renderer->vkDestroyBuffer(
+			renderer->logicalDevice,
+			buffer->buffer,
+			NULL);
+
+		return NULL;
+	}
+
+	buffer->usedRegion->vulkanBuffer = buffer; /* lol */
+	buffer->container = NULL;
+
+	buffer->resourceAccessType = resourceAccessType;
+
+	SDL_AtomicSet(&buffer->referenceCount, 0);
+
+	return buffer;
+}
+
+static VulkanBuffer* VULKAN_INTERNAL_CreateSlabBuffer(
+	VulkanRenderer *renderer,
+	VkDeviceSize size,
+	VulkanResourceAccessType resourceAccessType,
+	VkBufferUsageFlags usage
+) {
+	VulkanBufferSlab *slab = NULL;
+	VulkanBuffer *buffer;
+	VkDeviceSize slotSize = BUFFER_SLAB_MIN_SLOT_SIZE;
+	uint32_t classIndex = 0;
+	uint32_t i;
+
+	while (slotSize < size)
+	{
+		slotSize *= 2;
+		classIndex += 1;
+	}
+
+	SDL_LockMutex(renderer->bufferSlabLock);
+
+	for (i = 0; i < renderer->bufferSlabCounts[classIndex]; i += 1)
+	{
+		if (	renderer->bufferSlabs[classIndex][i]->buffer->usage == usage &&
+			renderer->bufferSlabs[classIndex][i]->freeSlotCount > 0	)
 		{
-			SDL_free(swapchainSupportDetails.presentModes);
+			slab = renderer->bufferSlabs[classIndex][i];
+			break;
 		}
-		SDL_free(swapchainData);
-		Refresh_LogError("Device does not support swap chain creation");
-		return 0;
 	}
 
-	if (	swapchainSupportDetails.capabilities.currentExtent.width == 0 ||
-		swapchainSupportDetails.capabilities.currentExtent.height == 0)
+	if (slab == NULL)
 	{
-		/* Not an error, just minimize behavior! */
-		renderer->vkDestroySurfaceKHR(
-			renderer->instance,
-			swapchainData->surface,
-			NULL
+		slab = SDL_malloc(sizeof(VulkanBufferSlab));
+
+		/* dedicated, the slab must never be moved by defrag */
+		slab->buffer = VULKAN_INTERNAL_CreateBuffer(
+			renderer,
+			BUFFER_SLAB_SIZE,
+			RESOURCE_ACCESS_NONE,
+			usage,
+			0,
+			1,
+			0,
+			1,
+			0
 		);
-		if (swapchainSupportDetails.formatsLength > 0)
+
+		if (slab->buffer == NULL)
 		{
-			SDL_free(swapchainSupportDetails.formats);
+			SDL_UnlockMutex(renderer->bufferSlabLock);
+			SDL_free(slab);
+			return NULL;
 		}
-		if (swapchainSupportDetails.presentModesLength > 0)
+
+		slab->slotSize = slotSize;
+		slab->slotCount = (uint32_t) (BUFFER_SLAB_SIZE / slotSize);
+		slab->freeSlots = SDL_malloc(sizeof(uint32_t) * slab->slotCount);
+		slab->freeSlotCount = slab->slotCount;
+
+		/* hand out low slots first */
+		for (i = 0; i < slab->slotCount; i += 1)
 		{
-			SDL_free(swapchainSupportDetails.presentModes);
+			slab->freeSlots[i] = slab->slotCount - 1 - i;
 		}
-		SDL_free(swapchainData);
-		return 0;
+
+		renderer->bufferSlabs[classIndex] = SDL_realloc(
+			renderer->bufferSlabs[classIndex],
+			sizeof(VulkanBufferSlab*) * (renderer->bufferSlabCounts[classIndex] + 1)
+		);
+		renderer->bufferSlabs[classIndex][renderer->bufferSlabCounts[classIndex]] = slab;
+		renderer->bufferSlabCounts[classIndex] += 1;
 	}
 
-	swapchainData->swapchainFormat = VK_FORMAT_R8G8B8A8_UNORM;
-	swapchainData->swapchainSwizzle.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-	swapchainData->swapchainSwizzle.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-	swapchainData->swapchainSwizzle.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-	swapchainData->swapchainSwizzle.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+	buffer = SDL_malloc(sizeof(VulkanBuffer));
 
-	if (!VULKAN_INTERNAL_ChooseSwapSurfaceFormat(
-		swapchainData->swapchainFormat,
-		swapchainSupportDetails.formats,
-		swapchainSupportDetails.formatsLength,
-		&swapchainData->surfaceFormat
-	)) {
-		swapchainData->swapchainFormat = VK_FORMAT_B8G8R8A8_UNORM;
-		swapchainData->swapchainSwizzle.r = VK_COMPONENT_SWIZZLE_B;
-		swapchainData->swapchainSwizzle.g = VK_COMPONENT_SWIZZLE_G;
-		swapchainData->swapchainSwizzle.b = VK_COMPONENT_SWIZZLE_R;
-		swapchainData->swapchainSwizzle.a = VK_COMPONENT_SWIZZLE_A;
+	slab->freeSlotCount -= 1;
+	buffer->slab = slab;
+	buffer->slabSlot = slab->freeSlots[slab->freeSlotCount];
 
-		if (!VULKAN_INTERNAL_ChooseSwapSurfaceFormat(
-			swapchainData->swapchainFormat,
-			swapchainSupportDetails.formats,
-			swapchainSupportDetails.formatsLength,
-			&swapchainData->surfaceFormat
-		)) {
-			renderer->vkDestroySurfaceKHR(
-				renderer->instance,
-				swapchainData->surface,
-				NULL
-			);
-			if (swapchainSupportDetails.formatsLength > 0)
-			{
-				SDL_free(swapchainSupportDetails.formats);
-			}
-			if (swapchainSupportDetails.presentModesLength > 0)
-			{
-				SDL_free(swapchainSupportDetails.presentModes);
-			}
-			SDL_free(swapchainData);
-			Refresh_LogError("Device does not support swap chain format");
-			return 0;
-		}
+	SDL_UnlockMutex(renderer->bufferSlabLock);
+
+	buffer->buffer = slab->buffer->buffer;
+	buffer->offset = buffer->slabSlot * slotSize;
+	buffer->size = size;
+	buffer->usedOnGraphicsQueue = 0; /* tracked on the slab's buffer */
+	buffer->usedRegion = slab->buffer->usedRegion;
+	buffer->resourceAccessType = resourceAccessType;
+	buffer->usage = usage;
+	buffer->requireHostVisible = 0;
+	buffer->preferDeviceLocal = 1;
+	buffer->preferHostCached = 0;
+	buffer->container = NULL;
+
+	SDL_AtomicSet(&buffer->referenceCount, 0);
+
+	return buffer;
+}
+
+/* Uniform buffer functions */
+
+static uint8_t VULKAN_INTERNAL_AddUniformBufferPoolBuffer(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *uniformBufferPool
+) {
+	VulkanBuffer *buffer;
+	VkDescriptorPool descriptorPool;
+	VkDescriptorSet descriptorSet;
+	VkWriteDescriptorSet writeDescriptorSet;
+	VkDescriptorBufferInfo descriptorBufferInfo;
+
+	/* Padded so a block at the end of the last section
+	 * still has the full descriptor range behind it
+	 */
+	buffer = VULKAN_INTERNAL_CreateBuffer(
+		renderer,
+		UBO_BUFFER_SIZE + UBO_MAX_BLOCK_SIZE,
+		uniformBufferPool->resourceAccessType,
+		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+		1,
+		0,
+		0,
+		1,
+		0
+	);
+
+	if (buffer == NULL)
+	{
+		Refresh_LogError("Failed to create uniform buffer!");
+		return 0;
 	}
 
-	if (!VULKAN_INTERNAL_ChooseSwapPresentMode(
-		windowData->preferredPresentMode,
-		swapchainSupportDetails.presentModes,
-		swapchainSupportDetails.presentModesLength,
-		&swapchainData->presentMode
+	if (!VULKAN_INTERNAL_CreateDescriptorPool(
+		renderer,
+		VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+		1,
+		1,
+		&descriptorPool
 	)) {
-		renderer->vkDestroySurfaceKHR(
-			renderer->instance,
-			swapchainData->surface,
+		Refresh_LogError("Failed to create uniform descriptor pool!");
+		VULKAN_INTERNAL_DestroyBuffer(renderer, buffer);
+		return 0;
+	}
+
+	if (!VULKAN_INTERNAL_AllocateDescriptorSets(
+		renderer,
+		descriptorPool,
+		uniformBufferPool->descriptorSetLayout,
+		1,
+		&descriptorSet
+	)) {
+		Refresh_LogError("Failed to allocate uniform descriptor set!");
+		renderer->vkDestroyDescriptorPool(
+			renderer->logicalDevice,
+			descriptorPool,
 			NULL
 		);
-		if (swapchainSupportDetails.formatsLength > 0)
-		{
-			SDL_free(swapchainSupportDetails.formats);
-		}
-		if (swapchainSupportDetails.presentModesLength > 0)
-		{
-			SDL_free(swapchainSupportDetails.presentModes);
-		}
-		SDL_free(swapchainData);
-		Refresh_LogError("Device does not support swap chain present mode");
+		VULKAN_INTERNAL_DestroyBuffer(renderer, buffer);
 		return 0;
 	}
 
-	SDL_Vulkan_GetDrawableSize(
-		(SDL_Window*) windowData->windowHandle,
-		&drawableWidth,
-		&drawableHeight
-	);
+	/* The only write this descriptor set will ever get */
 
-	if (	drawableWidth < swapchainSupportDetails.capabilities.minImageExtent.width ||
-		drawableWidth > swapchainSupportDetails.capabilities.maxImageExtent.width ||
-		drawableHeight < swapchainSupportDetails.capabilities.minImageExtent.height ||
-		drawableHeight > swapchainSupportDetails.capabilities.maxImageExtent.height	)
-	{
-		if (swapchainSupportDetails.capabilities.currentExtent.width != UINT32_MAX)
-		{
-			drawableWidth = VULKAN_INTERNAL_clamp(
-				drawableWidth,
-				swapchainSupportDetails.capabilities.minImageExtent.width,
-				swapchainSupportDetails.capabilities.maxImageExtent.width
-			);
-			drawableHeight = VULKAN_INTERNAL_clamp(
-				drawableHeight,
-				swapchainSupportDetails.capabilities.minImageExtent.height,
-				swapchainSupportDetails.capabilities.maxImageExtent.height
-			);
-		}
-		else
-		{
-			renderer->vkDestroySurfaceKHR(
-				renderer->instance,
-				swapchainData->surface,
-				NULL
-			);
-			if (swapchainSupportDetails.formatsLength > 0)
-			{
-				SDL_free(swapchainSupportDetails.formats);
-			}
-			if (swapchainSupportDetails.presentModesLength > 0)
-			{
-				SDL_free(swapchainSupportDetails.presentModes);
-			}
-			SDL_free(swapchainData);
-			Refresh_LogError("No fallback swapchain size available!");
-			return 0;
-		}
-	}
+	descriptorBufferInfo.buffer = buffer->buffer;
+	descriptorBufferInfo.offset = 0;
+	descriptorBufferInfo.range = UBO_MAX_BLOCK_SIZE;
 
-	swapchainData->extent.width = drawableWidth;
-	swapchainData->extent.height = drawableHeight;
+	writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	writeDescriptorSet.pNext = NULL;
+	writeDescriptorSet.descriptorCount = 1;
+	writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	writeDescriptorSet.dstArrayElement = 0;
+	writeDescriptorSet.dstBinding = 0;
+	writeDescriptorSet.dstSet = descriptorSet;
+	writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+	writeDescriptorSet.pImageInfo = NULL;
+	writeDescriptorSet.pTexelBufferView = NULL;
 
-	swapchainData->imageCount = swapchainSupportDetails.capabilities.minImageCount + 1;
+	renderer->vkUpdateDescriptorSets(
+		renderer->logicalDevice,
+		1,
+		&writeDescriptorSet,
+		0,
+		NULL
+	);
 
-	if (	swapchainSupportDetails.capabilities.maxImageCount > 0 &&
-		swapchainData->imageCount > swapchainSupportDetails.capabilities.maxImageCount	)
+	if (uniformBufferPool->bufferCount == uniformBufferPool->bufferCapacity)
 	{
-		swapchainData->imageCount = swapchainSupportDetails.capabilities.maxImageCount;
-	}
+		uniformBufferPool->bufferCapacity *= 2;
 
-	if (swapchainData->presentMode == VK_PRESENT_MODE_MAILBOX_KHR)
-	{
-		/* Required for proper triple-buffering.
-		 * Note that this is below the above maxImageCount check!
-		 * If the driver advertises MAILBOX but does not support 3 swap
-		 * images, it's not real mailbox support, so let it fail hard.
-		 * -flibit
-		 */
-		swapchainData->imageCount = SDL_max(swapchainData->imageCount, 3);
+		uniformBufferPool->buffers = SDL_realloc(
+			uniformBufferPool->buffers,
+			sizeof(VulkanBuffer*) * uniformBufferPool->bufferCapacity
+		);
+		uniformBufferPool->descriptorPools = SDL_realloc(
+			uniformBufferPool->descriptorPools,
+			sizeof(VkDescriptorPool) * uniformBufferPool->bufferCapacity
+		);
+		uniformBufferPool->descriptorSets = SDL_realloc(
+			uniformBufferPool->descriptorSets,
+			sizeof(VkDescriptorSet) * uniformBufferPool->bufferCapacity
+		);
 	}
 
-	swapchainCreateInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-	swapchainCreateInfo.pNext = NULL;
-	swapchainCreateInfo.flags = 0;
-	swapchainCreateInfo.surface = swapchainData->surface;
-	swapchainCreateInfo.minImageCount = swapchainData->imageCount;
-	swapchainCreateInfo.imageFormat = swapchainData->surfaceFormat.format;
-	swapchainCreateInfo.imageColorSpace = swapchainData->surfaceFormat.colorSpace;
-	swapchainCreateInfo.imageExtent = swapchainData->extent;
-	swapchainCreateInfo.imageArrayLayers = 1;
-	swapchainCreateInfo.imageUsage =
-		VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
-		VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
-		VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-	swapchainCreateInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
-	swapchainCreateInfo.queueFamilyIndexCount = 0;
-	swapchainCreateInfo.pQueueFamilyIndices = NULL;
-	swapchainCreateInfo.preTransform = swapchainSupportDetails.capabilities.currentTransform;
-	swapchainCreateInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-	swapchainCreateInfo.presentMode = swapchainData->presentMode;
-	swapchainCreateInfo.clipped = VK_TRUE;
-	swapchainCreateInfo.oldSwapchain = VK_NULL_HANDLE;
+	uniformBufferPool->buffers[uniformBufferPool->bufferCount] = buffer;
+	uniformBufferPool->descriptorPools[uniformBufferPool->bufferCount] = descriptorPool;
+	uniformBufferPool->descriptorSets[uniformBufferPool->bufferCount] = descriptorSet;
+	uniformBufferPool->bufferCount += 1;
 
-	vulkanResult = renderer->vkCreateSwapchainKHR(
-		renderer->logicalDevice,
-		&swapchainCreateInfo,
-		NULL,
-		&swapchainData->swapchain
-	);
+	uniformBufferPool->nextAvailableOffset = 0;
 
-	if (swapchainSupportDetails.formatsLength > 0)
+	return 1;
+}
+
+static VulkanUniformBufferPool* VULKAN_INTERNAL_CreateUniformBufferPool(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferType uniformBufferType
+) {
+	VulkanUniformBufferPool* uniformBufferPool;
+	VulkanResourceAccessType resourceAccessType;
+	VkDescriptorSetLayout descriptorSetLayout;
+
+	if (uniformBufferType == UNIFORM_BUFFER_VERTEX)
 	{
-		SDL_free(swapchainSupportDetails.formats);
+		resourceAccessType = RESOURCE_ACCESS_VERTEX_SHADER_READ_UNIFORM_BUFFER;
+		descriptorSetLayout = renderer->vertexUniformDescriptorSetLayout;
 	}
-	if (swapchainSupportDetails.presentModesLength > 0)
+	else if (uniformBufferType == UNIFORM_BUFFER_FRAGMENT)
 	{
-		SDL_free(swapchainSupportDetails.presentModes);
+		resourceAccessType = RESOURCE_ACCESS_FRAGMENT_SHADER_READ_UNIFORM_BUFFER;
+		descriptorSetLayout = renderer->fragmentUniformDescriptorSetLayout;
 	}
-
-	if (vulkanResult != VK_SUCCESS)
+	else if (uniformBufferType == UNIFORM_BUFFER_COMPUTE)
 	{
-		renderer->vkDestroySurfaceKHR(
-			renderer->instance,
-			swapchainData->surface,
-			NULL
-		);
-		SDL_free(swapchainData);
-		LogVulkanResultAsError("vkCreateSwapchainKHR", vulkanResult);
+		resourceAccessType = RESOURCE_ACCESS_COMPUTE_SHADER_READ_UNIFORM_BUFFER;
+		descriptorSetLayout = renderer->computeUniformDescriptorSetLayout;
+	}
+	else
+	{
+		Refresh_LogError("Unrecognized uniform buffer type!");
 		return 0;
 	}
 
-	renderer->vkGetSwapchainImagesKHR(
-		renderer->logicalDevice,
-		swapchainData->swapchain,
-		&swapchainData->imageCount,
-		NULL
-	);
+	uniformBufferPool = SDL_malloc(sizeof(VulkanUniformBufferPool));
 
-	swapchainData->textureContainers = SDL_malloc(
-		sizeof(VulkanTextureContainer) * swapchainData->imageCount
-	);
+	uniformBufferPool->type = uniformBufferType;
+	uniformBufferPool->resourceAccessType = resourceAccessType;
+	uniformBufferPool->descriptorSetLayout = descriptorSetLayout;
 
-	if (!swapchainData->textureContainers)
+	uniformBufferPool->bufferCapacity = 1;
+	uniformBufferPool->bufferCount = 0;
+	uniformBufferPool->buffers = SDL_malloc(sizeof(VulkanBuffer*));
+	uniformBufferPool->descriptorPools = SDL_malloc(sizeof(VkDescriptorPool));
+	uniformBufferPool->descriptorSets = SDL_malloc(sizeof(VkDescriptorSet));
+
+	if (!VULKAN_INTERNAL_AddUniformBufferPoolBuffer(renderer, uniformBufferPool))
 	{
-		SDL_OutOfMemory();
-		renderer->vkDestroySurfaceKHR(
-			renderer->instance,
-			swapchainData->surface,
-			NULL
-		);
-		SDL_free(swapchainData);
-		return 0;
+		SDL_free(uniformBufferPool->buffers);
+		SDL_free(uniformBufferPool->descriptorPools);
+		SDL_free(uniformBufferPool->descriptorSets);
+		SDL_free(uniformBufferPool);
+		return NULL;
 	}
 
-	swapchainImages = SDL_stack_alloc(VkImage, swapchainData->imageCount);
+	uniformBufferPool->lock = SDL_CreateMutex();
 
-	renderer->vkGetSwapchainImagesKHR(
-		renderer->logicalDevice,
-		swapchainData->swapchain,
-		&swapchainData->imageCount,
-		swapchainImages
-	);
+	uniformBufferPool->availableBufferCapacity = 16;
+	uniformBufferPool->availableBufferCount = 0;
+	uniformBufferPool->availableBuffers = SDL_malloc(uniformBufferPool->availableBufferCapacity * sizeof(VulkanUniformBuffer*));
 
-	imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-	imageViewCreateInfo.pNext = NULL;
-	imageViewCreateInfo.flags = 0;
-	imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-	imageViewCreateInfo.format = swapchainData->surfaceFormat.format;
-	imageViewCreateInfo.components = swapchainData->swapchainSwizzle;
-	imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
-	imageViewCreateInfo.subresourceRange.levelCount = 1;
-	imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
-	imageViewCreateInfo.subresourceRange.layerCount = 1;
+	return uniformBufferPool;
+}
 
-	for (i = 0; i < swapchainData->imageCount; i += 1)
+static void VULKAN_INTERNAL_BindUniformBuffer(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VulkanUniformBuffer *uniformBuffer
+) {
+	if (commandBuffer->boundUniformBufferCount >= commandBuffer->boundUniformBufferCapacity)
 	{
-		swapchainData->textureContainers[i].vulkanTexture = SDL_malloc(sizeof(VulkanTexture));
-
-		swapchainData->textureContainers[i].vulkanTexture->image = swapchainImages[i];
-
-		imageViewCreateInfo.image = swapchainImages[i];
-
-		vulkanResult = renderer->vkCreateImageView(
-			renderer->logicalDevice,
-			&imageViewCreateInfo,
-			NULL,
-			&swapchainData->textureContainers[i].vulkanTexture->view
+		commandBuffer->boundUniformBufferCapacity *= 2;
+		commandBuffer->boundUniformBuffers = SDL_realloc(
+			commandBuffer->boundUniformBuffers,
+			sizeof(VulkanUniformBuffer*) * commandBuffer->boundUniformBufferCapacity
 		);
-
-		if (vulkanResult != VK_SUCCESS)
-		{
-			renderer->vkDestroySurfaceKHR(
-				renderer->instance,
-				swapchainData->surface,
-				NULL
-			);
-			SDL_stack_free(swapchainImages);
-			SDL_free(swapchainData->textureContainers);
-			SDL_free(swapchainData);
-			LogVulkanResultAsError("vkCreateImageView", vulkanResult);
-			return 0;
-		}
-
-		swapchainData->textureContainers[i].vulkanTexture->resourceAccessType = RESOURCE_ACCESS_NONE;
-
-		/* Swapchain memory is managed by the driver */
-		swapchainData->textureContainers[i].vulkanTexture->usedRegion = NULL;
-
-		swapchainData->textureContainers[i].vulkanTexture->dimensions = swapchainData->extent;
-		swapchainData->textureContainers[i].vulkanTexture->format = swapchainData->swapchainFormat;
-		swapchainData->textureContainers[i].vulkanTexture->is3D = 0;
-		swapchainData->textureContainers[i].vulkanTexture->isCube = 0;
-		swapchainData->textureContainers[i].vulkanTexture->layerCount = 1;
-		swapchainData->textureContainers[i].vulkanTexture->levelCount = 1;
-		swapchainData->textureContainers[i].vulkanTexture->sampleCount = REFRESH_SAMPLECOUNT_1;
-		swapchainData->textureContainers[i].vulkanTexture->usageFlags =
-			VK_IMAGE_USAGE_TRANSFER_DST_BIT |
-			VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-		swapchainData->textureContainers[i].vulkanTexture->aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT;
-		swapchainData->textureContainers[i].vulkanTexture->resourceAccessType = RESOURCE_ACCESS_NONE;
-		swapchainData->textureContainers[i].vulkanTexture->msaaTex = NULL;
 	}
 
-	SDL_stack_free(swapchainImages);
-
-	semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-	semaphoreCreateInfo.pNext = NULL;
-	semaphoreCreateInfo.flags = 0;
-
-	renderer->vkCreateSemaphore(
-		renderer->logicalDevice,
-		&semaphoreCreateInfo,
-		NULL,
-		&swapchainData->imageAvailableSemaphore
-	);
-
-	renderer->vkCreateSemaphore(
-		renderer->logicalDevice,
-		&semaphoreCreateInfo,
-		NULL,
-		&swapchainData->renderFinishedSemaphore
-	);
-
-	windowData->swapchainData = swapchainData;
-	return 1;
-}
-
-static void VULKAN_INTERNAL_RecreateSwapchain(
-	VulkanRenderer* renderer,
-	WindowData *windowData
-) {
-	VULKAN_Wait((Refresh_Renderer*) renderer);
-	VULKAN_INTERNAL_DestroySwapchain(renderer, windowData);
-	VULKAN_INTERNAL_CreateSwapchain(renderer, windowData);
+	commandBuffer->boundUniformBuffers[commandBuffer->boundUniformBufferCount] = uniformBuffer;
+	commandBuffer->boundUniformBufferCount += 1;
 }
 
-/* Command Buffers */
-
-static void VULKAN_INTERNAL_BeginCommandBuffer(
+/* Hands the command buffer's current sections back for reuse after it completes */
+static void VULKAN_INTERNAL_ReleaseUniformBuffers(
 	VulkanRenderer *renderer,
 	VulkanCommandBuffer *commandBuffer
 ) {
-	VkCommandBufferBeginInfo beginInfo;
-	VkResult result;
-
-	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-	beginInfo.pNext = NULL;
-	beginInfo.flags = 0;
-	beginInfo.pInheritanceInfo = NULL;
-	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-	result = renderer->vkBeginCommandBuffer(
-		commandBuffer->commandBuffer,
-		&beginInfo
-	);
-
-	if (result != VK_SUCCESS)
-	{
-		LogVulkanResultAsError("vkBeginCommandBuffer", result);
+	if (	commandBuffer->vertexUniformBuffer != renderer->dummyVertexUniformBuffer &&
+		commandBuffer->vertexUniformBuffer != NULL
+	) {
+		VULKAN_INTERNAL_BindUniformBuffer(
+			renderer,
+			commandBuffer,
+			commandBuffer->vertexUniformBuffer
+		);
 	}
-}
+	commandBuffer->vertexUniformBuffer = NULL;
 
-static void VULKAN_INTERNAL_EndCommandBuffer(
-	VulkanRenderer* renderer,
-	VulkanCommandBuffer *commandBuffer
-) {
-	VkResult result;
+	if (	commandBuffer->fragmentUniformBuffer != renderer->dummyFragmentUniformBuffer &&
+		commandBuffer->fragmentUniformBuffer != NULL
+	) {
+		VULKAN_INTERNAL_BindUniformBuffer(
+			renderer,
+			commandBuffer,
+			commandBuffer->fragmentUniformBuffer
+		);
+	}
+	commandBuffer->fragmentUniformBuffer = NULL;
 
-	/* Compute pipelines are not explicitly unbound so we have to clean up here */
 	if (	commandBuffer->computeUniformBuffer != renderer->dummyComputeUniformBuffer &&
 		commandBuffer->computeUniformBuffer != NULL
 	) {
@@ -5160,2140 +6698,6159 @@ static void VULKAN_INTERNAL_EndCommandBuffer(
 		);
 	}
 	commandBuffer->computeUniformBuffer = NULL;
-	commandBuffer->currentComputePipeline = NULL;
-
-	result = renderer->vkEndCommandBuffer(
-		commandBuffer->commandBuffer
-	);
-
-	if (result != VK_SUCCESS)
-	{
-		LogVulkanResultAsError("vkEndCommandBuffer", result);
-	}
 }
 
-static void VULKAN_DestroyDevice(
-	Refresh_Device *device
+/* Buffer indirection so we can cleanly defrag */
+static VulkanBufferContainer* VULKAN_INTERNAL_CreateBufferContainer(
+	VulkanRenderer *renderer,
+	uint32_t sizeInBytes,
+	VulkanResourceAccessType resourceAccessType,
+	VkBufferUsageFlags usageFlags,
+	uint8_t transient,
+	uint8_t suballocate,
+	uint8_t dynamic,
+	uint8_t readback
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) device->driverData;
-	CommandPoolHashArray commandPoolHashArray;
-	GraphicsPipelineLayoutHashArray graphicsPipelineLayoutHashArray;
-	ComputePipelineLayoutHashArray computePipelineLayoutHashArray;
-	VulkanMemorySubAllocator *allocator;
-	int32_t i, j, k;
+	VulkanBufferContainer* bufferContainer;
+	VulkanBuffer* buffer;
 
-	VULKAN_Wait(device->driverData);
+	/* always set transfer bits so we can defrag */
+	usageFlags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
-	for (i = renderer->claimedWindowCount - 1; i >= 0; i -= 1)
+	if (dynamic)
 	{
-		VULKAN_UnclaimWindow(device->driverData, renderer->claimedWindows[i]->windowHandle);
+		/* dedicated, defrag must never move memory the client has a pointer to.
+		 * The client writes through the mapping without an unmap to flush on,
+		 * so READBACK can't pull this into non-coherent cached memory.
+		 */
+		buffer = VULKAN_INTERNAL_CreateBuffer(
+			renderer,
+			sizeInBytes,
+			resourceAccessType,
+			usageFlags,
+			1,
+			!readback,
+			0,
+			1,
+			0
+		);
+	}
+	else if (readback)
+	{
+		buffer = VULKAN_INTERNAL_CreateBuffer(
+			renderer,
+			sizeInBytes,
+			resourceAccessType,
+			usageFlags,
+			1,
+			0,
+			1,
+			0,
+			0
+		);
+	}
+	else if (suballocate && !transient && sizeInBytes <= BUFFER_SLAB_MAX_SLOT_SIZE)
+	{
+		buffer = VULKAN_INTERNAL_CreateSlabBuffer(
+			renderer,
+			sizeInBytes,
+			resourceAccessType,
+			usageFlags
+		);
+	}
+	else
+	{
+		buffer = VULKAN_INTERNAL_CreateBuffer(
+			renderer,
+			sizeInBytes,
+			resourceAccessType,
+			usageFlags,
+			0,
+			1,
+			0,
+			0,
+			transient
+		);
 	}
 
-	SDL_free(renderer->claimedWindows);
-
-	VULKAN_Wait(device->driverData);
-
-	SDL_free(renderer->submittedCommandBuffers);
-
-	VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->dummyBuffer);
-
-	SDL_free(renderer->dummyVertexUniformBuffer);
-	SDL_free(renderer->dummyFragmentUniformBuffer);
-	SDL_free(renderer->dummyComputeUniformBuffer);
-
-	for (i = 0; i < renderer->transferBufferPool.availableBufferCount; i += 1)
+	if (buffer == NULL)
 	{
-		VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->transferBufferPool.availableBuffers[i]->buffer);
-		SDL_free(renderer->transferBufferPool.availableBuffers[i]);
+		Refresh_LogError("Failed to create buffer!");
+		return NULL;
 	}
 
-	SDL_free(renderer->transferBufferPool.availableBuffers);
-	SDL_DestroyMutex(renderer->transferBufferPool.lock);
+	bufferContainer = SDL_malloc(sizeof(VulkanBufferContainer));
+	bufferContainer->vulkanBuffer = buffer;
+	bufferContainer->dynamic = dynamic;
+	buffer->container = bufferContainer;
 
-	for (i = 0; i < renderer->fencePool.availableFenceCount; i += 1)
+	if (dynamic)
 	{
-		renderer->vkDestroyFence(renderer->logicalDevice, renderer->fencePool.availableFences[i], NULL);
+		bufferContainer->versions = SDL_malloc(sizeof(VulkanBuffer*));
+		bufferContainer->versions[0] = buffer;
+		bufferContainer->versionCount = 1;
+	}
+	else
+	{
+		bufferContainer->versions = NULL;
+		bufferContainer->versionCount = 0;
 	}
 
-	SDL_free(renderer->fencePool.availableFences);
-	SDL_DestroyMutex(renderer->fencePool.lock);
+	return (VulkanBufferContainer*) bufferContainer;
+}
 
-	for (i = 0; i < NUM_COMMAND_POOL_BUCKETS; i += 1)
-	{
-		commandPoolHashArray = renderer->commandPoolHashTable.buckets[i];
-		for (j = 0; j < commandPoolHashArray.count; j += 1)
-		{
-			VULKAN_INTERNAL_DestroyCommandPool(
-				renderer,
-				commandPoolHashArray.elements[j].value
-			);
-		}
+static uint8_t VULKAN_INTERNAL_CreateUniformBuffer(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *bufferPool
+) {
+	VkDeviceSize sectionSize = VULKAN_INTERNAL_NextHighestAlignment(UBO_SECTION_SIZE, renderer->minUBOAlignment);
 
-		if (commandPoolHashArray.elements != NULL)
+	if (bufferPool->nextAvailableOffset + sectionSize > UBO_BUFFER_SIZE)
+	{
+		if (!VULKAN_INTERNAL_AddUniformBufferPoolBuffer(renderer, bufferPool))
 		{
-			SDL_free(commandPoolHashArray.elements);
+			return 0;
 		}
 	}
 
-	for (i = 0; i < NUM_PIPELINE_LAYOUT_BUCKETS; i += 1)
-	{
-		graphicsPipelineLayoutHashArray = renderer->graphicsPipelineLayoutHashTable.buckets[i];
-		for (j = 0; j < graphicsPipelineLayoutHashArray.count; j += 1)
-		{
-			VULKAN_INTERNAL_DestroyDescriptorSetCache(
-				renderer,
-				graphicsPipelineLayoutHashArray.elements[j].value->vertexSamplerDescriptorSetCache
-			);
-
-			VULKAN_INTERNAL_DestroyDescriptorSetCache(
-				renderer,
-				graphicsPipelineLayoutHashArray.elements[j].value->fragmentSamplerDescriptorSetCache
-			);
-
-			renderer->vkDestroyPipelineLayout(
-				renderer->logicalDevice,
-				graphicsPipelineLayoutHashArray.elements[j].value->pipelineLayout,
-				NULL
-			);
+	VulkanUniformBuffer *uniformBuffer = SDL_malloc(sizeof(VulkanUniformBuffer));
+	uniformBuffer->pool = bufferPool;
+	uniformBuffer->buffer = bufferPool->buffers[bufferPool->bufferCount - 1];
+	uniformBuffer->poolOffset = bufferPool->nextAvailableOffset;
+	uniformBuffer->offset = 0;
+	uniformBuffer->descriptorSet = bufferPool->descriptorSets[bufferPool->bufferCount - 1];
 
-			SDL_free(graphicsPipelineLayoutHashArray.elements[j].value);
-		}
+	bufferPool->nextAvailableOffset += sectionSize;
 
-		if (graphicsPipelineLayoutHashArray.elements != NULL)
-		{
-			SDL_free(graphicsPipelineLayoutHashArray.elements);
-		}
+	if (bufferPool->availableBufferCount >= bufferPool->availableBufferCapacity)
+	{
+		bufferPool->availableBufferCapacity *= 2;
 
-		computePipelineLayoutHashArray = renderer->computePipelineLayoutHashTable.buckets[i];
-		for (j = 0; j < computePipelineLayoutHashArray.count; j += 1)
-		{
-			VULKAN_INTERNAL_DestroyDescriptorSetCache(
-				renderer,
-				computePipelineLayoutHashArray.elements[j].value->bufferDescriptorSetCache
-			);
+		bufferPool->availableBuffers = SDL_realloc(
+			bufferPool->availableBuffers,
+			sizeof(VulkanUniformBuffer*) * bufferPool->availableBufferCapacity
+		);
+	}
 
-			VULKAN_INTERNAL_DestroyDescriptorSetCache(
-				renderer,
-				computePipelineLayoutHashArray.elements[j].value->imageDescriptorSetCache
-			);
+	bufferPool->availableBuffers[bufferPool->availableBufferCount] = uniformBuffer;
+	bufferPool->availableBufferCount += 1;
 
-			renderer->vkDestroyPipelineLayout(
-				renderer->logicalDevice,
-				computePipelineLayoutHashArray.elements[j].value->pipelineLayout,
-				NULL
-			);
+	return 1;
+}
 
-			SDL_free(computePipelineLayoutHashArray.elements[j].value);
-		}
+static VulkanUniformBuffer* VULKAN_INTERNAL_CreateDummyUniformBuffer(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferType uniformBufferType
+) {
+	VkDescriptorSetLayout descriptorSetLayout;
+	VkWriteDescriptorSet writeDescriptorSet;
+	VkDescriptorBufferInfo descriptorBufferInfo;
 
-		if (computePipelineLayoutHashArray.elements != NULL)
-		{
-			SDL_free(computePipelineLayoutHashArray.elements);
-		}
+	if (uniformBufferType == UNIFORM_BUFFER_VERTEX)
+	{
+		descriptorSetLayout = renderer->vertexUniformDescriptorSetLayout;
 	}
-
-	renderer->vkDestroyDescriptorPool(
-		renderer->logicalDevice,
-		renderer->defaultDescriptorPool,
-		NULL
-	);
-
-	for (i = 0; i < NUM_DESCRIPTOR_SET_LAYOUT_BUCKETS; i += 1)
+	else if (uniformBufferType == UNIFORM_BUFFER_FRAGMENT)
 	{
-		for (j = 0; j < renderer->descriptorSetLayoutHashTable.buckets[i].count; j += 1)
-		{
-			renderer->vkDestroyDescriptorSetLayout(
-				renderer->logicalDevice,
-				renderer->descriptorSetLayoutHashTable.buckets[i].elements[j].value,
-				NULL
-			);
-		}
-
-		SDL_free(renderer->descriptorSetLayoutHashTable.buckets[i].elements);
+		descriptorSetLayout = renderer->fragmentUniformDescriptorSetLayout;
+	}
+	else if (uniformBufferType == UNIFORM_BUFFER_COMPUTE)
+	{
+		descriptorSetLayout = renderer->computeUniformDescriptorSetLayout;
+	}
+	else
+	{
+		Refresh_LogError("Unrecognized uniform buffer type!");
+		return NULL;
 	}
 
-	renderer->vkDestroyDescriptorSetLayout(
-		renderer->logicalDevice,
-		renderer->emptyVertexSamplerLayout,
-		NULL
-	);
+	VulkanUniformBuffer *uniformBuffer = SDL_malloc(sizeof(VulkanUniformBuffer));
+	uniformBuffer->buffer = renderer->dummyBuffer;
+	uniformBuffer->poolOffset = 0;
+	uniformBuffer->offset = 0;
 
-	renderer->vkDestroyDescriptorSetLayout(
-		renderer->logicalDevice,
-		renderer->emptyFragmentSamplerLayout,
-		NULL
-	);
+	/* Allocate a descriptor set for the uniform buffer */
 
-	renderer->vkDestroyDescriptorSetLayout(
-		renderer->logicalDevice,
-		renderer->emptyComputeBufferDescriptorSetLayout,
-		NULL
+	VULKAN_INTERNAL_AllocateDescriptorSets(
+		renderer,
+		renderer->defaultDescriptorPool,
+		descriptorSetLayout,
+		1,
+		&uniformBuffer->descriptorSet
 	);
 
-	renderer->vkDestroyDescriptorSetLayout(
-		renderer->logicalDevice,
-		renderer->emptyComputeImageDescriptorSetLayout,
-		NULL
-	);
+	/* Update the descriptor set for the first and last time! */
 
-	renderer->vkDestroyDescriptorSetLayout(
-		renderer->logicalDevice,
-		renderer->vertexUniformDescriptorSetLayout,
-		NULL
-	);
+	descriptorBufferInfo.buffer = renderer->dummyBuffer->buffer;
+	descriptorBufferInfo.offset = 0;
+	descriptorBufferInfo.range = VK_WHOLE_SIZE;
 
-	renderer->vkDestroyDescriptorSetLayout(
-		renderer->logicalDevice,
-		renderer->fragmentUniformDescriptorSetLayout,
-		NULL
-	);
+	writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	writeDescriptorSet.pNext = NULL;
+	writeDescriptorSet.descriptorCount = 1;
+	writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	writeDescriptorSet.dstArrayElement = 0;
+	writeDescriptorSet.dstBinding = 0;
+	writeDescriptorSet.dstSet = uniformBuffer->descriptorSet;
+	writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+	writeDescriptorSet.pImageInfo = NULL;
+	writeDescriptorSet.pTexelBufferView = NULL;
 
-	renderer->vkDestroyDescriptorSetLayout(
+	renderer->vkUpdateDescriptorSets(
 		renderer->logicalDevice,
-		renderer->computeUniformDescriptorSetLayout,
+		1,
+		&writeDescriptorSet,
+		0,
 		NULL
 	);
 
-	VULKAN_INTERNAL_DestroyUniformBufferPool(renderer, renderer->vertexUniformBufferPool);
-	VULKAN_INTERNAL_DestroyUniformBufferPool(renderer, renderer->fragmentUniformBufferPool);
-	VULKAN_INTERNAL_DestroyUniformBufferPool(renderer, renderer->computeUniformBufferPool);
+	uniformBuffer->pool = NULL; /* No pool because this is a dummy */
 
-	for (i = 0; i < renderer->framebufferHashArray.count; i += 1)
-	{
-		VULKAN_INTERNAL_DestroyFramebuffer(
-			renderer,
-			renderer->framebufferHashArray.elements[i].value
-		);
-	}
+	return uniformBuffer;
+}
 
-	SDL_free(renderer->framebufferHashArray.elements);
+static void VULKAN_INTERNAL_DestroyUniformBufferPool(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *uniformBufferPool
+) {
+	uint32_t i;
 
-	for (i = 0; i < renderer->renderPassHashArray.count; i += 1)
+	for (i = 0; i < uniformBufferPool->bufferCount; i += 1)
 	{
-		renderer->vkDestroyRenderPass(
+		renderer->vkDestroyDescriptorPool(
 			renderer->logicalDevice,
-			renderer->renderPassHashArray.elements[i].value,
+			uniformBufferPool->descriptorPools[i],
 			NULL
 		);
-	}
 
-	SDL_free(renderer->renderPassHashArray.elements);
-
-	SDL_free(renderer->renderTargetHashArray.elements);
+		VULKAN_INTERNAL_DestroyBuffer(renderer, uniformBufferPool->buffers[i]);
+	}
 
-	for (i = 0; i < VK_MAX_MEMORY_TYPES; i += 1)
+	/* This is always destroyed after submissions, so all buffers are available */
+	for (i = 0; i < uniformBufferPool->availableBufferCount; i += 1)
 	{
-		allocator = &renderer->memoryAllocator->subAllocators[i];
+		SDL_free(uniformBufferPool->availableBuffers[i]);
+	}
 
-		for (j = allocator->allocationCount - 1; j >= 0; j -= 1)
-		{
-			for (k = allocator->allocations[j]->usedRegionCount - 1; k >= 0; k -= 1)
-			{
-				VULKAN_INTERNAL_RemoveMemoryUsedRegion(
-					renderer,
-					allocator->allocations[j]->usedRegions[k]
-				);
-			}
+	SDL_DestroyMutex(uniformBufferPool->lock);
+	SDL_free(uniformBufferPool->buffers);
+	SDL_free(uniformBufferPool->descriptorPools);
+	SDL_free(uniformBufferPool->descriptorSets);
+	SDL_free(uniformBufferPool->availableBuffers);
+	SDL_free(uniformBufferPool);
+}
 
-			VULKAN_INTERNAL_DeallocateMemory(
-				renderer,
-				allocator,
-				j
-			);
-		}
+static VulkanUniformBuffer* VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *bufferPool
+) {
+	SDL_LockMutex(bufferPool->lock);
 
-		if (renderer->memoryAllocator->subAllocators[i].allocations != NULL)
+	if (bufferPool->availableBufferCount == 0)
+	{
+		if (!VULKAN_INTERNAL_CreateUniformBuffer(renderer, bufferPool))
 		{
-			SDL_free(renderer->memoryAllocator->subAllocators[i].allocations);
+			SDL_UnlockMutex(bufferPool->lock);
+			Refresh_LogError("Failed to create uniform buffer!");
+			return NULL;
 		}
-
-		SDL_free(renderer->memoryAllocator->subAllocators[i].sortedFreeRegions);
 	}
 
-	SDL_free(renderer->memoryAllocator);
-
-	SDL_free(renderer->texturesToDestroy);
-	SDL_free(renderer->buffersToDestroy);
-	SDL_free(renderer->graphicsPipelinesToDestroy);
-	SDL_free(renderer->computePipelinesToDestroy);
-	SDL_free(renderer->shaderModulesToDestroy);
-	SDL_free(renderer->samplersToDestroy);
-	SDL_free(renderer->framebuffersToDestroy);
+	VulkanUniformBuffer *uniformBuffer = bufferPool->availableBuffers[bufferPool->availableBufferCount - 1];
+	bufferPool->availableBufferCount -= 1;
 
-	SDL_DestroyMutex(renderer->allocatorLock);
-	SDL_DestroyMutex(renderer->disposeLock);
-	SDL_DestroyMutex(renderer->submitLock);
-	SDL_DestroyMutex(renderer->acquireCommandBufferLock);
-	SDL_DestroyMutex(renderer->renderPassFetchLock);
-	SDL_DestroyMutex(renderer->framebufferFetchLock);
-	SDL_DestroyMutex(renderer->renderTargetFetchLock);
+	SDL_UnlockMutex(bufferPool->lock);
 
-	renderer->vkDestroyDevice(renderer->logicalDevice, NULL);
-	renderer->vkDestroyInstance(renderer->instance, NULL);
+	uniformBuffer->offset = 0;
 
-	SDL_free(renderer);
-	SDL_free(device);
+	return uniformBuffer;
 }
 
-static void VULKAN_DrawInstancedPrimitives(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	uint32_t baseVertex,
-	uint32_t startIndex,
-	uint32_t primitiveCount,
-	uint32_t instanceCount,
-	uint32_t vertexParamOffset,
-	uint32_t fragmentParamOffset
-) {
+/* Swapchain */
+
+static uint8_t VULKAN_INTERNAL_QuerySwapChainSupport(
+	VulkanRenderer *renderer,
+	VkPhysicalDevice physicalDevice,
+	VkSurfaceKHR surface,
+	SwapChainSupportDetails *outputDetails
+) {
+	VkResult result;
+	VkBool32 supportsPresent;
+
+	renderer->vkGetPhysicalDeviceSurfaceSupportKHR(
+		physicalDevice,
+		renderer->queueFamilyIndex,
+		surface,
+		&supportsPresent
+	);
+
+	if (!supportsPresent)
+	{
+		Refresh_LogWarn("This surface does not support presenting!");
+		return 0;
+	}
+
+	/* Initialize these in case anything fails */
+	outputDetails->formatsLength = 0;
+	outputDetails->presentModesLength = 0;
+
+	/* Run the device surface queries */
+	result = renderer->vkGetPhysicalDeviceSurfaceCapabilitiesKHR(
+		physicalDevice,
+		surface,
+		&outputDetails->capabilities
+	);
+	VULKAN_ERROR_CHECK(result, vkGetPhysicalDeviceSurfaceCapabilitiesKHR, 0)
+
+	if (!(outputDetails->capabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR))
+	{
+		Refresh_LogWarn("Opaque presentation unsupported! Expect weird transparency bugs!");
+	}
+
+	result = renderer->vkGetPhysicalDeviceSurfaceFormatsKHR(
+		physicalDevice,
+		surface,
+		&outputDetails->formatsLength,
+		NULL
+	);
+	VULKAN_ERROR_CHECK(result, vkGetPhysicalDeviceSurfaceFormatsKHR, 0)
+	result = renderer->vkGetPhysicalDeviceSurfacePresentModesKHR(
+		physicalDevice,
+		surface,
+		&outputDetails->presentModesLength,
+		NULL
+	);
+	VULKAN_ERROR_CHECK(result, vkGetPhysicalDeviceSurfacePresentModesKHR, 0)
+
+	/* Generate the arrays, if applicable */
+	if (outputDetails->formatsLength != 0)
+	{
+		outputDetails->formats = (VkSurfaceFormatKHR*) SDL_malloc(
+			sizeof(VkSurfaceFormatKHR) * outputDetails->formatsLength
+		);
+
+		if (!outputDetails->formats)
+		{
+			SDL_OutOfMemory();
+			return 0;
+		}
+
+		result = renderer->vkGetPhysicalDeviceSurfaceFormatsKHR(
+			physicalDevice,
+			surface,
+			&outputDetails->formatsLength,
+			outputDetails->formats
+		);
+		if (result != VK_SUCCESS)
+		{
+			Refresh_LogError(
+				"vkGetPhysicalDeviceSurfaceFormatsKHR: %s",
+				VkErrorMessages(result)
+			);
+
+			SDL_free(outputDetails->formats);
+			return 0;
+		}
+	}
+	if (outputDetails->presentModesLength != 0)
+	{
+		outputDetails->presentModes = (VkPresentModeKHR*) SDL_malloc(
+			sizeof(VkPresentModeKHR) * outputDetails->presentModesLength
+		);
+
+		if (!outputDetails->presentModes)
+		{
+			SDL_OutOfMemory();
+			return 0;
+		}
+
+		result = renderer->vkGetPhysicalDeviceSurfacePresentModesKHR(
+			physicalDevice,
+			surface,
+			&outputDetails->presentModesLength,
+			outputDetails->presentModes
+		);
+		if (result != VK_SUCCESS)
+		{
+			Refresh_LogError(
+				"vkGetPhysicalDeviceSurfacePresentModesKHR: %s",
+				VkErrorMessages(result)
+			);
+
+			SDL_free(outputDetails->formats);
+			SDL_free(outputDetails->presentModes);
+			return 0;
+		}
+	}
+
+	/* If we made it here, all the queries were successfull. This does NOT
+	 * necessarily mean there are any supported formats or present modes!
+	 */
+	return 1;
+}
+
+static uint8_t VULKAN_INTERNAL_ChooseSwapSurfaceFormat(
+	VkFormat desiredFormat,
+	VkSurfaceFormatKHR *availableFormats,
+	uint32_t availableFormatsLength,
+	VkSurfaceFormatKHR *outputFormat
+) {
+	uint32_t i;
+	for (i = 0; i < availableFormatsLength; i += 1)
+	{
+		if (	availableFormats[i].format == desiredFormat &&
+			availableFormats[i].colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR	)
+		{
+			*outputFormat = availableFormats[i];
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static uint8_t VULKAN_INTERNAL_ChooseSwapPresentMode(
+	Refresh_PresentMode desiredPresentInterval,
+	VkPresentModeKHR *availablePresentModes,
+	uint32_t availablePresentModesLength,
+	VkPresentModeKHR *outputPresentMode
+) {
+	#define CHECK_MODE(m) \
+		for (i = 0; i < availablePresentModesLength; i += 1) \
+		{ \
+			if (availablePresentModes[i] == m) \
+			{ \
+				*outputPresentMode = m; \
+				return 1; \
+			} \
+		} \
+
+	uint32_t i;
+	if (desiredPresentInterval == REFRESH_PRESENTMODE_IMMEDIATE)
+	{
+		CHECK_MODE(VK_PRESENT_MODE_IMMEDIATE_KHR)
+	}
+	else if (desiredPresentInterval == REFRESH_PRESENTMODE_MAILBOX)
+	{
+		CHECK_MODE(VK_PRESENT_MODE_MAILBOX_KHR)
+	}
+	else if (desiredPresentInterval == REFRESH_PRESENTMODE_FIFO)
+	{
+		CHECK_MODE(VK_PRESENT_MODE_FIFO_KHR)
+	}
+	else if (desiredPresentInterval == REFRESH_PRESENTMODE_FIFO_RELAXED)
+	{
+		CHECK_MODE(VK_PRESENT_MODE_FIFO_RELAXED_KHR)
+	}
+	else
+	{
+		Refresh_LogError(
+			"Unrecognized PresentInterval: %d",
+			desiredPresentInterval
+		);
+		return 0;
+	}
+
+	#undef CHECK_MODE
+
+	*outputPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+	return 1;
+}
+
+static uint8_t VULKAN_INTERNAL_CreateSwapchain(
+	VulkanRenderer *renderer,
+	WindowData *windowData
+) {
+	VkResult vulkanResult;
+	VulkanSwapchainData *swapchainData;
+	VkSwapchainCreateInfoKHR swapchainCreateInfo;
+	VkImage *swapchainImages;
+	VkImageViewCreateInfo imageViewCreateInfo;
+	VkSemaphoreCreateInfo semaphoreCreateInfo;
+	SwapChainSupportDetails swapchainSupportDetails;
+	int32_t drawableWidth, drawableHeight;
+	uint32_t i;
+
+	swapchainData = SDL_malloc(sizeof(VulkanSwapchainData));
+
+	/* Each swapchain must have its own surface. */
+
+	if (!SDL_Vulkan_CreateSurface(
+		(SDL_Window*) windowData->windowHandle,
+		renderer->instance,
+		&swapchainData->surface
+	)) {
+		SDL_free(swapchainData);
+		Refresh_LogError(
+			"SDL_Vulkan_CreateSurface failed: %s",
+			SDL_GetError()
+		);
+		return 0;
+	}
+
+	if (!VULKAN_INTERNAL_QuerySwapChainSupport(
+		renderer,
+		renderer->physicalDevice,
+		swapchainData->surface,
+		&swapchainSupportDetails
+	)) {
+		renderer->vkDestroySurfaceKHR(
+			renderer->instance,
+			swapchainData->surface,
+			NULL
+		);
+		if (swapchainSupportDetails.formatsLength > 0)
+		{
+			SDL_free(swapchainSupportDetails.formats);
+		}
+		if (swapchainSupportDetails.presentModesLength > 0)
+		{
+			SDL_free(swapchainSupportDetails.presentModes);
+		}
+		SDL_free(swapchainData);
+		Refresh_LogError("Device does not support swap chain creation");
+		return 0;
+	}
+
+	if (	swapchainSupportDetails.capabilities.currentExtent.width == 0 ||
+		swapchainSupportDetails.capabilities.currentExtent.height == 0)
+	{
+		/* Not an error, just minimize behavior! */
+		renderer->vkDestroySurfaceKHR(
+			renderer->instance,
+			swapchainData->surface,
+			NULL
+		);
+		if (swapchainSupportDetails.formatsLength > 0)
+		{
+			SDL_free(swapchainSupportDetails.formats);
+		}
+		if (swapchainSupportDetails.presentModesLength > 0)
+		{
+			SDL_free(swapchainSupportDetails.presentModes);
+		}
+		SDL_free(swapchainData);
+		return 0;
+	}
+
+	swapchainData->swapchainFormat = VK_FORMAT_R8G8B8A8_UNORM;
+	swapchainData->swapchainSwizzle.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+	swapchainData->swapchainSwizzle.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+	swapchainData->swapchainSwizzle.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+	swapchainData->swapchainSwizzle.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+
+	if (!VULKAN_INTERNAL_ChooseSwapSurfaceFormat(
+		swapchainData->swapchainFormat,
+		swapchainSupportDetails.formats,
+		swapchainSupportDetails.formatsLength,
+		&swapchainData->surfaceFormat
+	)) {
+		swapchainData->swapchainFormat = VK_FORMAT_B8G8R8A8_UNORM;
+		swapchainData->swapchainSwizzle.r = VK_COMPONENT_SWIZZLE_B;
+		swapchainData->swapchainSwizzle.g = VK_COMPONENT_SWIZZLE_G;
+		swapchainData->swapchainSwizzle.b = VK_COMPONENT_SWIZZLE_R;
+		swapchainData->swapchainSwizzle.a = VK_COMPONENT_SWIZZLE_A;
+
+		if (!VULKAN_INTERNAL_ChooseSwapSurfaceFormat(
+			swapchainData->swapchainFormat,
+			swapchainSupportDetails.formats,
+			swapchainSupportDetails.formatsLength,
+			&swapchainData->surfaceFormat
+		)) {
+			renderer->vkDestroySurfaceKHR(
+				renderer->instance,
+				swapchainData->surface,
+				NULL
+			);
+			if (swapchainSupportDetails.formatsLength > 0)
+			{
+				SDL_free(swapchainSupportDetails.formats);
+			}
+			if (swapchainSupportDetails.presentModesLength > 0)
+			{
+				SDL_free(swapchainSupportDetails.presentModes);
+			}
+			SDL_free(swapchainData);
+			Refresh_LogError("Device does not support swap chain format");
+			return 0;
+		}
+	}
+
+	if (!VULKAN_INTERNAL_ChooseSwapPresentMode(
+		windowData->preferredPresentMode,
+		swapchainSupportDetails.presentModes,
+		swapchainSupportDetails.presentModesLength,
+		&swapchainData->presentMode
+	)) {
+		renderer->vkDestroySurfaceKHR(
+			renderer->instance,
+			swapchainData->surface,
+			NULL
+		);
+		if (swapchainSupportDetails.formatsLength > 0)
+		{
+			SDL_free(swapchainSupportDetails.formats);
+		}
+		if (swapchainSupportDetails.presentModesLength > 0)
+		{
+			SDL_free(swapchainSupportDetails.presentModes);
+		}
+		SDL_free(swapchainData);
+		Refresh_LogError("Device does not support swap chain present mode");
+		return 0;
+	}
+
+	SDL_Vulkan_GetDrawableSize(
+		(SDL_Window*) windowData->windowHandle,
+		&drawableWidth,
+		&drawableHeight
+	);
+
+	if (	drawableWidth < swapchainSupportDetails.capabilities.minImageExtent.width ||
+		drawableWidth > swapchainSupportDetails.capabilities.maxImageExtent.width ||
+		drawableHeight < swapchainSupportDetails.capabilities.minImageExtent.height ||
+		drawableHeight > swapchainSupportDetails.capabilities.maxImageExtent.height	)
+	{
+		if (swapchainSupportDetails.capabilities.currentExtent.width != UINT32_MAX)
+		{
+			drawableWidth = VULKAN_INTERNAL_clamp(
+				drawableWidth,
+				swapchainSupportDetails.capabilities.minImageExtent.width,
+				swapchainSupportDetails.capabilities.maxImageExtent.width
+			);
+			drawableHeight = VULKAN_INTERNAL_clamp(
+				drawableHeight,
+				swapchainSupportDetails.capabilities.minImageExtent.height,
+				swapchainSupportDetails.capabilities.maxImageExtent.height
+			);
+		}
+		else
+		{
+			renderer->vkDestroySurfaceKHR(
+				renderer->instance,
+				swapchainData->surface,
+				NULL
+			);
+			if (swapchainSupportDetails.formatsLength > 0)
+			{
+				SDL_free(swapchainSupportDetails.formats);
+			}
+			if (swapchainSupportDetails.presentModesLength > 0)
+			{
+				SDL_free(swapchainSupportDetails.presentModes);
+			}
+			SDL_free(swapchainData);
+			Refresh_LogError("No fallback swapchain size available!");
+			return 0;
+		}
+	}
+
+	swapchainData->extent.width = drawableWidth;
+	swapchainData->extent.height = drawableHeight;
+
+	swapchainData->imageCount = swapchainSupportDetails.capabilities.minImageCount + 1;
+
+	if (	swapchainSupportDetails.capabilities.maxImageCount > 0 &&
+		swapchainData->imageCount > swapchainSupportDetails.capabilities.maxImageCount	)
+	{
+		swapchainData->imageCount = swapchainSupportDetails.capabilities.maxImageCount;
+	}
+
+	if (swapchainData->presentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+	{
+		/* Required for proper triple-buffering.
+		 * Note that this is below the above maxImageCount check!
+		 * If the driver advertises MAILBOX but does not support 3 swap
+		 * images, it's not real mailbox support, so let it fail hard.
+		 * -flibit
+		 */
+		swapchainData->imageCount = SDL_max(swapchainData->imageCount, 3);
+	}
+
+	swapchainCreateInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+	swapchainCreateInfo.pNext = NULL;
+	swapchainCreateInfo.flags = 0;
+	swapchainCreateInfo.surface = swapchainData->surface;
+	swapchainCreateInfo.minImageCount = swapchainData->imageCount;
+	swapchainCreateInfo.imageFormat = swapchainData->surfaceFormat.format;
+	swapchainCreateInfo.imageColorSpace = swapchainData->surfaceFormat.colorSpace;
+	swapchainCreateInfo.imageExtent = swapchainData->extent;
+	swapchainCreateInfo.imageArrayLayers = 1;
+	swapchainCreateInfo.imageUsage =
+		VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+		VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+		VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	swapchainCreateInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	swapchainCreateInfo.queueFamilyIndexCount = 0;
+	swapchainCreateInfo.pQueueFamilyIndices = NULL;
+	swapchainCreateInfo.preTransform = swapchainSupportDetails.capabilities.currentTransform;
+	swapchainCreateInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+	swapchainCreateInfo.presentMode = swapchainData->presentMode;
+	swapchainCreateInfo.clipped = VK_TRUE;
+	swapchainCreateInfo.oldSwapchain = VK_NULL_HANDLE;
+
+	vulkanResult = renderer->vkCreateSwapchainKHR(
+		renderer->logicalDevice,
+		&swapchainCreateInfo,
+		NULL,
+		&swapchainData->swapchain
+	);
+
+	if (swapchainSupportDetails.formatsLength > 0)
+	{
+		SDL_free(swapchainSupportDetails.formats);
+	}
+	if (swapchainSupportDetails.presentModesLength > 0)
+	{
+		SDL_free(swapchainSupportDetails.presentModes);
+	}
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		renderer->vkDestroySurfaceKHR(
+			renderer->instance,
+			swapchainData->surface,
+			NULL
+		);
+		SDL_free(swapchainData);
+		LogVulkanResultAsError("vkCreateSwapchainKHR", vulkanResult);
+		return 0;
+	}
+
+	renderer->vkGetSwapchainImagesKHR(
+		renderer->logicalDevice,
+		swapchainData->swapchain,
+		&swapchainData->imageCount,
+		NULL
+	);
+
+	swapchainData->textureContainers = SDL_malloc(
+		sizeof(VulkanTextureContainer) * swapchainData->imageCount
+	);
+
+	if (!swapchainData->textureContainers)
+	{
+		SDL_OutOfMemory();
+		renderer->vkDestroySurfaceKHR(
+			renderer->instance,
+			swapchainData->surface,
+			NULL
+		);
+		SDL_free(swapchainData);
+		return 0;
+	}
+
+	swapchainImages = SDL_stack_alloc(VkImage, swapchainData->imageCount);
+
+	renderer->vkGetSwapchainImagesKHR(
+		renderer->logicalDevice,
+		swapchainData->swapchain,
+		&swapchainData->imageCount,
+		swapchainImages
+	);
+
+	imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	imageViewCreateInfo.pNext = NULL;
+	imageViewCreateInfo.flags = 0;
+	imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	imageViewCreateInfo.format = swapchainData->surfaceFormat.format;
+	imageViewCreateInfo.components = swapchainData->swapchainSwizzle;
+	imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+	imageViewCreateInfo.subresourceRange.levelCount = 1;
+	imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+	imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+	for (i = 0; i < swapchainData->imageCount; i += 1)
+	{
+		swapchainData->textureContainers[i].vulkanTexture = SDL_malloc(sizeof(VulkanTexture));
+		swapchainData->textureContainers[i].vulkanTexture->usedOnGraphicsQueue = 1;
+
+		swapchainData->textureContainers[i].vulkanTexture->image = swapchainImages[i];
+
+		imageViewCreateInfo.image = swapchainImages[i];
+
+		vulkanResult = renderer->vkCreateImageView(
+			renderer->logicalDevice,
+			&imageViewCreateInfo,
+			NULL,
+			&swapchainData->textureContainers[i].vulkanTexture->view
+		);
+
+		if (vulkanResult != VK_SUCCESS)
+		{
+			renderer->vkDestroySurfaceKHR(
+				renderer->instance,
+				swapchainData->surface,
+				NULL
+			);
+			SDL_stack_free(swapchainImages);
+			SDL_free(swapchainData->textureContainers);
+			SDL_free(swapchainData);
+			LogVulkanResultAsError("vkCreateImageView", vulkanResult);
+			return 0;
+		}
+
+		/* Swapchain memory is managed by the driver */
+		swapchainData->textureContainers[i].vulkanTexture->usedRegion = NULL;
+
+		swapchainData->textureContainers[i].vulkanTexture->dimensions = swapchainData->extent;
+		swapchainData->textureContainers[i].vulkanTexture->format = swapchainData->swapchainFormat;
+		swapchainData->textureContainers[i].vulkanTexture->is3D = 0;
+		swapchainData->textureContainers[i].vulkanTexture->isCube = 0;
+		swapchainData->textureContainers[i].vulkanTexture->layerCount = 1;
+		swapchainData->textureContainers[i].vulkanTexture->levelCount = 1;
+		swapchainData->textureContainers[i].vulkanTexture->sampleCount = REFRESH_SAMPLECOUNT_1;
+		swapchainData->textureContainers[i].vulkanTexture->usageFlags =
+			VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+			VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		swapchainData->textureContainers[i].vulkanTexture->aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT;
+		swapchainData->textureContainers[i].vulkanTexture->subresourceAccessTypes = SDL_malloc(
+			sizeof(VulkanResourceAccessType)
+		);
+		swapchainData->textureContainers[i].vulkanTexture->subresourceAccessTypes[0] = RESOURCE_ACCESS_NONE;
+		swapchainData->textureContainers[i].vulkanTexture->msaaTex = NULL;
+	}
+
+	SDL_stack_free(swapchainImages);
+
+	semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	semaphoreCreateInfo.pNext = NULL;
+	semaphoreCreateInfo.flags = 0;
+
+	renderer->vkCreateSemaphore(
+		renderer->logicalDevice,
+		&semaphoreCreateInfo,
+		NULL,
+		&swapchainData->imageAvailableSemaphore
+	);
+
+	renderer->vkCreateSemaphore(
+		renderer->logicalDevice,
+		&semaphoreCreateInfo,
+		NULL,
+		&swapchainData->renderFinishedSemaphore
+	);
+
+	windowData->swapchainData = swapchainData;
+	return 1;
+}
+
+static void VULKAN_INTERNAL_RecreateSwapchain(
+	VulkanRenderer* renderer,
+	WindowData *windowData
+) {
+	VULKAN_Wait((Refresh_Renderer*) renderer);
+	VULKAN_INTERNAL_DestroySwapchain(renderer, windowData);
+	VULKAN_INTERNAL_CreateSwapchain(renderer, windowData);
+}
+
+/* Command Buffers */
+
+static void VULKAN_INTERNAL_BeginCommandBuffer(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer
+) {
+	VkCommandBufferBeginInfo beginInfo;
+	VkResult result;
+
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.pNext = NULL;
+	beginInfo.flags = 0;
+	beginInfo.pInheritanceInfo = NULL;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	result = renderer->vkBeginCommandBuffer(
+		commandBuffer->commandBuffer,
+		&beginInfo
+	);
+
+	if (result != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkBeginCommandBuffer", result);
+	}
+}
+
+static void VULKAN_INTERNAL_EndCommandBuffer(
+	VulkanRenderer* renderer,
+	VulkanCommandBuffer *commandBuffer
+) {
+	VkResult result;
+
+	/* Compute pipelines are not explicitly unbound so we have to clean up here */
+	if (	commandBuffer->computeUniformBuffer != renderer->dummyComputeUniformBuffer &&
+		commandBuffer->computeUniformBuffer != NULL
+	) {
+		VULKAN_INTERNAL_BindUniformBuffer(
+			renderer,
+			commandBuffer,
+			commandBuffer->computeUniformBuffer
+		);
+	}
+	commandBuffer->computeUniformBuffer = NULL;
+	commandBuffer->currentComputePipeline = NULL;
+
+	result = renderer->vkEndCommandBuffer(
+		commandBuffer->commandBuffer
+	);
+
+	if (result != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkEndCommandBuffer", result);
+	}
+}
+
+static void VULKAN_DestroyDevice(
+	Refresh_Device *device
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) device->driverData;
+	CommandPoolHashArray commandPoolHashArray;
+	GraphicsPipelineLayoutHashArray graphicsPipelineLayoutHashArray;
+	ComputePipelineLayoutHashArray computePipelineLayoutHashArray;
+	VulkanMemorySubAllocator *allocator;
+	int32_t i, j, k;
+
+	VULKAN_Wait(device->driverData);
+
+	for (i = renderer->claimedWindowCount - 1; i >= 0; i -= 1)
+	{
+		VULKAN_UnclaimWindow(device->driverData, renderer->claimedWindows[i]->windowHandle);
+	}
+
+	SDL_free(renderer->claimedWindows);
+
+	VULKAN_Wait(device->driverData);
+
+	SDL_free(renderer->submittedCommandBuffers);
+
+	/* Transfers no graphics command buffer was acquired after */
+	for (i = 0; i < renderer->pendingTransferSemaphoreCount; i += 1)
+	{
+		renderer->vkDestroySemaphore(
+			renderer->logicalDevice,
+			renderer->pendingTransferSemaphores[i],
+			NULL
+		);
+	}
+
+	SDL_free(renderer->pendingTransferSemaphores);
+	SDL_free(renderer->pendingAcquireBufferBarriers);
+	SDL_free(renderer->pendingAcquireImageBarriers);
+
+	VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->dummyBuffer);
+
+	for (i = 0; i < BUFFER_SLAB_CLASS_COUNT; i += 1)
+	{
+		for (j = 0; j < renderer->bufferSlabCounts[i]; j += 1)
+		{
+			VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->bufferSlabs[i][j]->buffer);
+			SDL_free(renderer->bufferSlabs[i][j]->freeSlots);
+			SDL_free(renderer->bufferSlabs[i][j]);
+		}
+
+		SDL_free(renderer->bufferSlabs[i]);
+	}
+
+	SDL_free(renderer->dummyVertexUniformBuffer);
+	SDL_free(renderer->dummyFragmentUniformBuffer);
+	SDL_free(renderer->dummyComputeUniformBuffer);
+
+	for (i = 0; i < renderer->transferBufferPool.availableBufferCount; i += 1)
+	{
+		VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->transferBufferPool.availableBuffers[i]->buffer);
+		SDL_free(renderer->transferBufferPool.availableBuffers[i]);
+	}
+
+	SDL_free(renderer->transferBufferPool.availableBuffers);
+	SDL_DestroyMutex(renderer->transferBufferPool.lock);
+
+	if (renderer->uploadRing.buffer != NULL)
+	{
+		VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->uploadRing.buffer);
+	}
+
+	SDL_free(renderer->uploadRing.ranges);
+	SDL_DestroyMutex(renderer->uploadRing.lock);
+
+	if (renderer->readbackRing.buffer != NULL)
+	{
+		VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->readbackRing.buffer);
+	}
+
+	/* Readbacks the client never released */
+	for (i = 0; i < renderer->readbackRing.readbackCount; i += 1)
+	{
+		SDL_free(renderer->readbackRing.readbacks[
+			(renderer->readbackRing.readbackStart + i) % renderer->readbackRing.readbackCapacity
+		]);
+	}
+
+	for (i = 0; i < renderer->readbackRing.dedicatedReadbackCount; i += 1)
+	{
+		VULKAN_INTERNAL_DestroyBuffer(
+			renderer,
+			renderer->readbackRing.dedicatedReadbacks[i]->buffer
+		);
+		SDL_free(renderer->readbackRing.dedicatedReadbacks[i]);
+	}
+
+	SDL_free(renderer->readbackRing.readbacks);
+	SDL_free(renderer->readbackRing.dedicatedReadbacks);
+	SDL_DestroyMutex(renderer->readbackRing.lock);
+
+	for (i = 0; i < renderer->deferredReadbackFenceCount; i += 1)
+	{
+		renderer->vkDestroyFence(renderer->logicalDevice, renderer->deferredReadbackFences[i], NULL);
+	}
+
+	SDL_free(renderer->deferredReadbackFences);
+
+	for (i = 0; i < renderer->fencePool.availableFenceCount; i += 1)
+	{
+		renderer->vkDestroyFence(renderer->logicalDevice, renderer->fencePool.availableFences[i], NULL);
+	}
+
+	SDL_free(renderer->fencePool.availableFences);
+	SDL_DestroyMutex(renderer->fencePool.lock);
+
+	for (i = 0; i < NUM_COMMAND_POOL_BUCKETS; i += 1)
+	{
+		commandPoolHashArray = renderer->commandPoolHashTable.buckets[i];
+		for (j = 0; j < commandPoolHashArray.count; j += 1)
+		{
+			VULKAN_INTERNAL_DestroyCommandPool(
+				renderer,
+				commandPoolHashArray.elements[j].value
+			);
+		}
+
+		if (commandPoolHashArray.elements != NULL)
+		{
+			SDL_free(commandPoolHashArray.elements);
+		}
+	}
+
+	for (i = 0; i < NUM_PIPELINE_LAYOUT_BUCKETS; i += 1)
+	{
+		graphicsPipelineLayoutHashArray = renderer->graphicsPipelineLayoutHashTable.buckets[i];
+		for (j = 0; j < graphicsPipelineLayoutHashArray.count; j += 1)
+		{
+			VULKAN_INTERNAL_DestroyDescriptorSetCache(
+				renderer,
+				graphicsPipelineLayoutHashArray.elements[j].value->vertexSamplerDescriptorSetCache
+			);
+
+			VULKAN_INTERNAL_DestroyDescriptorSetCache(
+				renderer,
+				graphicsPipelineLayoutHashArray.elements[j].value->fragmentSamplerDescriptorSetCache
+			);
+
+			renderer->vkDestroyPipelineLayout(
+				renderer->logicalDevice,
+				graphicsPipelineLayoutHashArray.elements[j].value->pipelineLayout,
+				NULL
+			);
+
+			SDL_free(graphicsPipelineLayoutHashArray.elements[j].value);
+		}
+
+		if (graphicsPipelineLayoutHashArray.elements != NULL)
+		{
+			SDL_free(graphicsPipelineLayoutHashArray.elements);
+		}
+
+		computePipelineLayoutHashArray = renderer->computePipelineLayoutHashTable.buckets[i];
+		for (j = 0; j < computePipelineLayoutHashArray.count; j += 1)
+		{
+			VULKAN_INTERNAL_DestroyDescriptorSetCache(
+				renderer,
+				computePipelineLayoutHashArray.elements[j].value->bufferDescriptorSetCache
+			);
+
+			VULKAN_INTERNAL_DestroyDescriptorSetCache(
+				renderer,
+				computePipelineLayoutHashArray.elements[j].value->imageDescriptorSetCache
+			);
+
+			renderer->vkDestroyPipelineLayout(
+				renderer->logicalDevice,
+				computePipelineLayoutHashArray.elements[j].value->pipelineLayout,
+				NULL
+			);
+
+			SDL_free(computePipelineLayoutHashArray.elements[j].value);
+		}
+
+		if (computePipelineLayoutHashArray.elements != NULL)
+		{
+			SDL_free(computePipelineLayoutHashArray.elements);
+		}
+	}
+
+	renderer->vkDestroyDescriptorPool(
+		renderer->logicalDevice,
+		renderer->defaultDescriptorPool,
+		NULL
+	);
+
+	for (i = 0; i < NUM_DESCRIPTOR_SET_LAYOUT_BUCKETS; i += 1)
+	{
+		for (j = 0; j < renderer->descriptorSetLayoutHashTable.buckets[i].count; j += 1)
+		{
+			renderer->vkDestroyDescriptorSetLayout(
+				renderer->logicalDevice,
+				renderer->descriptorSetLayoutHashTable.buckets[i].elements[j].value,
+				NULL
+			);
+		}
+
+		SDL_free(renderer->descriptorSetLayoutHashTable.buckets[i].elements);
+	}
+
+	renderer->vkDestroyDescriptorSetLayout(
+		renderer->logicalDevice,
+		renderer->emptyVertexSamplerLayout,
+		NULL
+	);
+
+	renderer->vkDestroyDescriptorSetLayout(
+		renderer->logicalDevice,
+		renderer->emptyFragmentSamplerLayout,
+		NULL
+	);
+
+	renderer->vkDestroyDescriptorSetLayout(
+		renderer->logicalDevice,
+		renderer->emptyComputeBufferDescriptorSetLayout,
+		NULL
+	);
+
+	renderer->vkDestroyDescriptorSetLayout(
+		renderer->logicalDevice,
+		renderer->emptyComputeImageDescriptorSetLayout,
+		NULL
+	);
+
+	renderer->vkDestroyDescriptorSetLayout(
+		renderer->logicalDevice,
+		renderer->vertexUniformDescriptorSetLayout,
+		NULL
+	);
+
+	renderer->vkDestroyDescriptorSetLayout(
+		renderer->logicalDevice,
+		renderer->fragmentUniformDescriptorSetLayout,
+		NULL
+	);
+
+	renderer->vkDestroyDescriptorSetLayout(
+		renderer->logicalDevice,
+		renderer->computeUniformDescriptorSetLayout,
+		NULL
+	);
+
+	/* Only after the layouts that use them as immutable samplers */
+	for (i = 0; i < YCBCR_FORMAT_COUNT; i += 1)
+	{
+		if (renderer->ycbcrSamplers[i] != VK_NULL_HANDLE)
+		{
+			renderer->vkDestroySampler(
+				renderer->logicalDevice,
+				renderer->ycbcrSamplers[i],
+				NULL
+			);
+		}
+
+		if (renderer->ycbcrConversions[i] != VK_NULL_HANDLE)
+		{
+			renderer->vkDestroySamplerYcbcrConversionKHR(
+				renderer->logicalDevice,
+				renderer->ycbcrConversions[i],
+				NULL
+			);
+		}
+	}
+
+	VULKAN_INTERNAL_DestroyUniformBufferPool(renderer, renderer->vertexUniformBufferPool);
+	VULKAN_INTERNAL_DestroyUniformBufferPool(renderer, renderer->fragmentUniformBufferPool);
+	VULKAN_INTERNAL_DestroyUniformBufferPool(renderer, renderer->computeUniformBufferPool);
+
+	for (i = 0; i < renderer->framebufferHashArray.count; i += 1)
+	{
+		VULKAN_INTERNAL_DestroyFramebuffer(
+			renderer,
+			renderer->framebufferHashArray.elements[i].value
+		);
+	}
+
+	SDL_free(renderer->framebufferHashArray.elements);
+
+	for (i = 0; i < renderer->renderPassHashArray.count; i += 1)
+	{
+		renderer->vkDestroyRenderPass(
+			renderer->logicalDevice,
+			renderer->renderPassHashArray.elements[i].value,
+			NULL
+		);
+	}
+
+	SDL_free(renderer->renderPassHashArray.elements);
+
+	SDL_free(renderer->renderTargetHashArray.elements);
+
+	for (i = 0; i < VK_MAX_MEMORY_TYPES; i += 1)
+	{
+		allocator = &renderer->memoryAllocator->subAllocators[i];
+
+		for (j = allocator->allocationCount - 1; j >= 0; j -= 1)
+		{
+			/* transient and aliased regions are owned by their resources, not the block */
+			if (!allocator->allocations[j]->transient && !allocator->allocations[j]->aliased)
+			{
+				for (k = allocator->allocations[j]->usedRegionCount - 1; k >= 0; k -= 1)
+				{
+					VULKAN_INTERNAL_RemoveMemoryUsedRegion(
+						renderer,
+						allocator->allocations[j]->usedRegions[k]
+					);
+				}
+			}
+
+			VULKAN_INTERNAL_DeallocateMemory(
+				renderer,
+				allocator,
+				j
+			);
+		}
+
+		if (renderer->memoryAllocator->subAllocators[i].allocations != NULL)
+		{
+			SDL_free(renderer->memoryAllocator->subAllocators[i].allocations);
+		}
+
+		if (renderer->memoryAllocator->subAllocators[i].transientBlocks != NULL)
+		{
+			SDL_free(renderer->memoryAllocator->subAllocators[i].transientBlocks);
+		}
+
+		SDL_DestroyMutex(renderer->memoryAllocator->subAllocators[i].lock);
+	}
+
+	SDL_free(renderer->memoryAllocator);
+
+	SDL_free(renderer->texturesToDestroy);
+	SDL_free(renderer->buffersToDestroy);
+	SDL_free(renderer->graphicsPipelinesToDestroy);
+	SDL_free(renderer->computePipelinesToDestroy);
+	SDL_free(renderer->shaderModulesToDestroy);
+	SDL_free(renderer->samplersToDestroy);
+	SDL_free(renderer->framebuffersToDestroy);
+
+	SDL_DestroyMutex(renderer->allocatorLock);
+	SDL_DestroyMutex(renderer->bufferSlabLock);
+	SDL_DestroyMutex(renderer->disposeLock);
+	SDL_DestroyMutex(renderer->submitLock);
+	SDL_DestroyMutex(renderer->acquireCommandBufferLock);
+	SDL_DestroyMutex(renderer->pendingTransferLock);
+	SDL_DestroyMutex(renderer->renderPassFetchLock);
+	SDL_DestroyMutex(renderer->framebufferFetchLock);
+	SDL_DestroyMutex(renderer->renderTargetFetchLock);
+
+	renderer->vkDestroyDevice(renderer->logicalDevice, NULL);
+	renderer->vkDestroyInstance(renderer->instance, NULL);
+
+	SDL_free(renderer);
+	SDL_free(device);
+}
+
+/* Skips the bind when nothing changed since the previous draw,
+ * which is the common case for pipelines that use push constants.
+ */
+static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *vulkanCommandBuffer,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+) {
+	VkDescriptorSet descriptorSets[4];
+	uint32_t dynamicOffsets[2];
+
+	descriptorSets[0] = vulkanCommandBuffer->vertexSamplerDescriptorSet;
+	descriptorSets[1] = vulkanCommandBuffer->fragmentSamplerDescriptorSet;
+	descriptorSets[2] = vulkanCommandBuffer->vertexUniformBuffer->descriptorSet;
+	descriptorSets[3] = vulkanCommandBuffer->fragmentUniformBuffer->descriptorSet;
+
+	dynamicOffsets[0] = vertexParamOffset;
+	dynamicOffsets[1] = fragmentParamOffset;
+
+	if (	vulkanCommandBuffer->graphicsDescriptorSetsBound &&
+		SDL_memcmp(descriptorSets, vulkanCommandBuffer->boundGraphicsDescriptorSets, sizeof(descriptorSets)) == 0 &&
+		SDL_memcmp(dynamicOffsets, vulkanCommandBuffer->boundGraphicsDynamicOffsets, sizeof(dynamicOffsets)) == 0	)
+	{
+		return;
+	}
+
+	renderer->vkCmdBindDescriptorSets(
+		vulkanCommandBuffer->commandBuffer,
+		VK_PIPELINE_BIND_POINT_GRAPHICS,
+		vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->pipelineLayout,
+		0,
+		4,
+		descriptorSets,
+		2,
+		dynamicOffsets
+	);
+
+	SDL_memcpy(vulkanCommandBuffer->boundGraphicsDescriptorSets, descriptorSets, sizeof(descriptorSets));
+	SDL_memcpy(vulkanCommandBuffer->boundGraphicsDynamicOffsets, dynamicOffsets, sizeof(dynamicOffsets));
+	vulkanCommandBuffer->graphicsDescriptorSetsBound = 1;
+}
+
+static void VULKAN_DrawInstancedPrimitives(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	uint32_t baseVertex,
+	uint32_t startIndex,
+	uint32_t primitiveCount,
+	uint32_t instanceCount,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+
+	VULKAN_INTERNAL_BindGraphicsDescriptorSets(
+		renderer,
+		vulkanCommandBuffer,
+		vertexParamOffset,
+		fragmentParamOffset
+	);
+
+	renderer->vkCmdDrawIndexed(
+		vulkanCommandBuffer->commandBuffer,
+		PrimitiveVerts(
+			vulkanCommandBuffer->currentGraphicsPipeline->primitiveType,
+			primitiveCount
+		),
+		instanceCount,
+		startIndex,
+		baseVertex,
+		0
+	);
+}
+
+static void VULKAN_DrawIndexedPrimitives(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	uint32_t baseVertex,
+	uint32_t startIndex,
+	uint32_t primitiveCount,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+) {
+	VULKAN_DrawInstancedPrimitives(
+		driverData,
+		commandBuffer,
+		baseVertex,
+		startIndex,
+		primitiveCount,
+		1,
+		vertexParamOffset,
+		fragmentParamOffset
+	);
+}
+
+static void VULKAN_DrawPrimitives(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	uint32_t vertexStart,
+	uint32_t primitiveCount,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+
+	VULKAN_INTERNAL_BindGraphicsDescriptorSets(
+		renderer,
+		vulkanCommandBuffer,
+		vertexParamOffset,
+		fragmentParamOffset
+	);
+
+	renderer->vkCmdDraw(
+		vulkanCommandBuffer->commandBuffer,
+		PrimitiveVerts(
+			vulkanCommandBuffer->currentGraphicsPipeline->primitiveType,
+			primitiveCount
+		),
+		1,
+		vertexStart,
+		0
+	);
+}
+
+static void VULKAN_DrawPrimitivesIndirect(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t drawCount,
+	uint32_t stride,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
+
+	VULKAN_INTERNAL_BindGraphicsDescriptorSets(
+		renderer,
+		vulkanCommandBuffer,
+		vertexParamOffset,
+		fragmentParamOffset
+	);
+
+	renderer->vkCmdDrawIndirect(
+		vulkanCommandBuffer->commandBuffer,
+		vulkanBuffer->buffer,
+		vulkanBuffer->offset + offsetInBytes,
+		drawCount,
+		stride
+	);
+
+	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
+}
+
+static void VULKAN_DispatchCompute(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	uint32_t groupCountX,
+	uint32_t groupCountY,
+	uint32_t groupCountZ,
+	uint32_t computeParamOffset
+) {
 	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
 	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
+	VkDescriptorSet descriptorSets[3];
+	VulkanResourceAccessType resourceAccessType = RESOURCE_ACCESS_NONE;
+	VulkanBuffer *currentComputeBuffer;
+	VulkanTexture *currentComputeTexture;
+	uint32_t i;
+
+	VULKAN_INTERNAL_FlushBufferUploads(renderer, vulkanCommandBuffer);
+
+	descriptorSets[0] = vulkanCommandBuffer->bufferDescriptorSet;
+	descriptorSets[1] = vulkanCommandBuffer->imageDescriptorSet;
+	descriptorSets[2] = vulkanCommandBuffer->computeUniformBuffer->descriptorSet;
+
+	renderer->vkCmdBindDescriptorSets(
+		vulkanCommandBuffer->commandBuffer,
+		VK_PIPELINE_BIND_POINT_COMPUTE,
+		computePipeline->pipelineLayout->pipelineLayout,
+		0,
+		3,
+		descriptorSets,
+		1,
+		&computeParamOffset
+	);
+
+	renderer->vkCmdDispatch(
+		vulkanCommandBuffer->commandBuffer,
+		groupCountX,
+		groupCountY,
+		groupCountZ
+	);
+
+	/* Re-transition buffers after dispatch */
+	for (i = 0; i < vulkanCommandBuffer->boundComputeBufferCount; i += 1)
+	{
+		currentComputeBuffer = vulkanCommandBuffer->boundComputeBuffers[i];
+
+		if (currentComputeBuffer->usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+		{
+			resourceAccessType = RESOURCE_ACCESS_VERTEX_BUFFER;
+		}
+		else if (currentComputeBuffer->usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+		{
+			resourceAccessType = RESOURCE_ACCESS_INDEX_BUFFER;
+		}
+		else if (currentComputeBuffer->usage & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT)
+		{
+			resourceAccessType = RESOURCE_ACCESS_INDIRECT_BUFFER;
+		}
+
+		if (resourceAccessType != RESOURCE_ACCESS_NONE)
+		{
+			VULKAN_INTERNAL_BufferMemoryBarrier(
+				renderer,
+				vulkanCommandBuffer->commandBuffer,
+				resourceAccessType,
+				currentComputeBuffer
+			);
+		}
+	}
+
+	vulkanCommandBuffer->boundComputeBufferCount = 0;
+
+	/* Re-transition sampler images after dispatch */
+	for (i = 0; i < vulkanCommandBuffer->boundComputeTextureCount; i += 1)
+	{
+		currentComputeTexture = vulkanCommandBuffer->boundComputeTextures[i];
+
+		if (currentComputeTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+		{
+			resourceAccessType = RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE;
+
+			VULKAN_INTERNAL_ImageMemoryBarrier(
+				renderer,
+				vulkanCommandBuffer->commandBuffer,
+				resourceAccessType,
+				currentComputeTexture->aspectFlags,
+				0,
+				currentComputeTexture->layerCount,
+				0,
+				currentComputeTexture->levelCount,
+				0,
+				currentComputeTexture
+			);
+		}
+	}
+
+	vulkanCommandBuffer->boundComputeTextureCount = 0;
+}
+
+static inline uint8_t VULKAN_INTERNAL_IsAliasedTexture(
+	VulkanTexture *texture
+) {
+	/* swapchain textures don't own any memory */
+	return	texture->usedRegion != NULL &&
+		texture->usedRegion->allocation->aliased;
+}
+
+/* Creates the image without binding any memory or creating a view */
+static VulkanTexture* VULKAN_INTERNAL_CreateTextureImage(
+	VulkanRenderer *renderer,
+	uint32_t width,
+	uint32_t height,
+	uint32_t depth,
+	uint32_t isCube,
+	uint32_t levelCount,
+	Refresh_SampleCount sampleCount,
+	VkFormat format,
+	VkImageAspectFlags aspectMask,
+	VkImageUsageFlags imageUsageFlags
+) {
+	VkResult vulkanResult;
+	VkImageCreateInfo imageCreateInfo;
+	VkImageCreateFlags imageCreateFlags = 0;
+	uint8_t is3D = depth > 1 ? 1 : 0;
+	uint8_t layerCount = isCube ? 6 : 1;
+
+	VulkanTexture *texture = SDL_malloc(sizeof(VulkanTexture));
+
+	texture->isCube = 0;
+	texture->is3D = 0;
+
+	if (isCube)
+	{
+		imageCreateFlags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+		texture->isCube = 1;
+	}
+	else if (is3D)
+	{
+		imageCreateFlags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
+		texture->is3D = 1;
+	}
+
+	imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageCreateInfo.pNext = NULL;
+	imageCreateInfo.flags = imageCreateFlags;
+	imageCreateInfo.imageType = is3D ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
+	imageCreateInfo.format = format;
+	imageCreateInfo.extent.width = width;
+	imageCreateInfo.extent.height = height;
+	imageCreateInfo.extent.depth = depth;
+	imageCreateInfo.mipLevels = levelCount;
+	imageCreateInfo.arrayLayers = layerCount;
+	imageCreateInfo.samples = RefreshToVK_SampleCount[sampleCount];
+	imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageCreateInfo.usage = imageUsageFlags;
+	imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageCreateInfo.queueFamilyIndexCount = 0;
+	imageCreateInfo.pQueueFamilyIndices = NULL;
+	imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	vulkanResult = renderer->vkCreateImage(
+		renderer->logicalDevice,
+		&imageCreateInfo,
+		NULL,
+		&texture->image
+	);
+	VULKAN_ERROR_CHECK(vulkanResult, vkCreateImage, 0)
+
+	texture->usedRegion = NULL;
+	texture->view = VK_NULL_HANDLE;
+	texture->dimensions.width = width;
+	texture->dimensions.height = height;
+	texture->depth = depth;
+	texture->format = format;
+	texture->levelCount = levelCount;
+	texture->layerCount = layerCount;
+	texture->sampleCount = sampleCount;
+	texture->subresourceAccessTypes = SDL_malloc(
+		layerCount * levelCount * sizeof(VulkanResourceAccessType)
+	);
+	VULKAN_INTERNAL_SetTextureAccessType(texture, RESOURCE_ACCESS_NONE);
+	texture->usageFlags = imageUsageFlags;
+	texture->aspectFlags = aspectMask;
+	texture->usedOnGraphicsQueue = 0;
+	texture->msaaTex = NULL;
+
+	SDL_AtomicSet(&texture->referenceCount, 0);
+
+	return texture;
+}
+
+/* Call once the image has memory bound */
+static uint8_t VULKAN_INTERNAL_CreateTextureView(
+	VulkanRenderer *renderer,
+	VulkanTexture *texture
+) {
+	VkResult vulkanResult;
+	VkImageViewCreateInfo imageViewCreateInfo;
+	VkSamplerYcbcrConversionInfo conversionInfo;
+	VkComponentMapping swizzle = IDENTITY_SWIZZLE;
+	int32_t ycbcrFormatIndex = VULKAN_INTERNAL_YCbCrFormatIndex(texture->format);
+
+	imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	imageViewCreateInfo.pNext = NULL;
+	imageViewCreateInfo.flags = 0;
+	imageViewCreateInfo.image = texture->image;
+	imageViewCreateInfo.format = texture->format;
+	imageViewCreateInfo.components = swizzle;
+	imageViewCreateInfo.subresourceRange.aspectMask = texture->aspectFlags;
+
+	/* Multi-planar views must carry the same conversion as their sampler */
+	if (ycbcrFormatIndex >= 0)
+	{
+		conversionInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_YCBCR_CONVERSION_INFO;
+		conversionInfo.pNext = NULL;
+		conversionInfo.conversion = renderer->ycbcrConversions[ycbcrFormatIndex];
+		imageViewCreateInfo.pNext = &conversionInfo;
+	}
+	imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+	imageViewCreateInfo.subresourceRange.levelCount = texture->levelCount;
+	imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+	imageViewCreateInfo.subresourceRange.layerCount = texture->layerCount;
+
+	if (texture->isCube)
+	{
+		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_CUBE;
+	}
+	else if (texture->is3D)
+	{
+		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_3D;
+	}
+	else
+	{
+		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	}
+
+	vulkanResult = renderer->vkCreateImageView(
+		renderer->logicalDevice,
+		&imageViewCreateInfo,
+		NULL,
+		&texture->view
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkCreateImageView", vulkanResult);
+		Refresh_LogError("Failed to create texture image view");
+		return 0;
+	}
+
+	return 1;
+}
+
+static VulkanTexture* VULKAN_INTERNAL_CreateTexture(
+	VulkanRenderer *renderer,
+	uint32_t width,
+	uint32_t height,
+	uint32_t depth,
+	uint32_t isCube,
+	uint32_t levelCount,
+	Refresh_SampleCount sampleCount,
+	VkFormat format,
+	VkImageAspectFlags aspectMask,
+	VkImageUsageFlags imageUsageFlags,
+	uint8_t transient
+) {
+	uint8_t bindResult;
+	uint8_t isRenderTarget =
+		((imageUsageFlags & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) != 0) ||
+		((imageUsageFlags & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0);
+
+	VulkanTexture *texture = VULKAN_INTERNAL_CreateTextureImage(
+		renderer,
+		width,
+		height,
+		depth,
+		isCube,
+		levelCount,
+		sampleCount,
+		format,
+		aspectMask,
+		imageUsageFlags
+	);
+
+	if (texture == NULL)
+	{
+		return NULL;
+	}
+
+	bindResult = VULKAN_INTERNAL_BindMemoryForImage(
+		renderer,
+		texture->image,
+		isRenderTarget,
+		transient,
+		(imageUsageFlags & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) != 0,
+		&texture->usedRegion
+	);
+
+	if (bindResult != 1)
+	{
+		renderer->vkDestroyImage(
+			renderer->logicalDevice,
+			texture->image,
+			NULL);
+
+		Refresh_LogError("Unable to bind memory for texture!");
+		return NULL;
+	}
+
+	texture->usedRegion->vulkanTexture = texture; /* lol */
+
+	if (!VULKAN_INTERNAL_CreateTextureView(renderer, texture))
+	{
+		return NULL;
+	}
+
+	return texture;
+}
+
+static VulkanRenderTarget* VULKAN_INTERNAL_CreateRenderTarget(
+	VulkanRenderer *renderer,
+	VulkanTexture *texture,
+	uint32_t depth,
+	uint32_t layer,
+	uint32_t level
+) {
+	VkResult vulkanResult;
+	VulkanRenderTarget *renderTarget = (VulkanRenderTarget*) SDL_malloc(sizeof(VulkanRenderTarget));
+	VkImageViewCreateInfo imageViewCreateInfo;
+	VkComponentMapping swizzle = IDENTITY_SWIZZLE;
+	VkImageAspectFlags aspectFlags = 0;
+
+	if (IsDepthFormat(texture->format))
+	{
+		aspectFlags |= VK_IMAGE_ASPECT_DEPTH_BIT;
+
+		if (IsStencilFormat(texture->format))
+		{
+			aspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
+		}
+	}
+	else
+	{
+		aspectFlags |= VK_IMAGE_ASPECT_COLOR_BIT;
+	}
+
+	/* create framebuffer compatible views for RenderTarget */
+	imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	imageViewCreateInfo.pNext = NULL;
+	imageViewCreateInfo.flags = 0;
+	imageViewCreateInfo.image = texture->image;
+	imageViewCreateInfo.format = texture->format;
+	imageViewCreateInfo.components = swizzle;
+	imageViewCreateInfo.subresourceRange.aspectMask = aspectFlags;
+	imageViewCreateInfo.subresourceRange.baseMipLevel = level;
+	imageViewCreateInfo.subresourceRange.levelCount = 1;
+	imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+	if (texture->is3D)
+	{
+		imageViewCreateInfo.subresourceRange.baseArrayLayer = depth;
+	}
+	else if (texture->isCube)
+	{
+		imageViewCreateInfo.subresourceRange.baseArrayLayer = layer;
+	}
+	imageViewCreateInfo.subresourceRange.layerCount = 1;
+	imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+
+	vulkanResult = renderer->vkCreateImageView(
+		renderer->logicalDevice,
+		&imageViewCreateInfo,
+		NULL,
+		&renderTarget->view
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError(
+			"vkCreateImageView",
+			vulkanResult
+		);
+		Refresh_LogError("Failed to create color attachment image view");
+		return NULL;
+	}
+
+	return renderTarget;
+}
+
+static VulkanRenderTarget* VULKAN_INTERNAL_FetchRenderTarget(
+	VulkanRenderer *renderer,
+	VulkanTexture *texture,
+	uint32_t depth,
+	uint32_t layer,
+	uint32_t level
+) {
+	RenderTargetHash hash;
+	VulkanRenderTarget *renderTarget;
+
+	hash.texture = texture;
+	hash.depth = depth;
+	hash.layer = layer;
+	hash.level = level;
+
+	SDL_LockMutex(renderer->renderTargetFetchLock);
+
+	renderTarget = RenderTargetHash_Fetch(
+		&renderer->renderTargetHashArray,
+		&hash
+	);
+
+	if (renderTarget == NULL)
+	{
+		renderTarget = VULKAN_INTERNAL_CreateRenderTarget(
+			renderer,
+			texture,
+			depth,
+			layer,
+			level
+		);
+
+		RenderTargetHash_Insert(
+			&renderer->renderTargetHashArray,
+			hash,
+			renderTarget
+		);
+	}
+
+	SDL_UnlockMutex(renderer->renderTargetFetchLock);
+
+	return renderTarget;
+}
+
+static VkRenderPass VULKAN_INTERNAL_CreateRenderPass(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+	uint32_t colorAttachmentCount,
+	Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo
+) {
+	VkResult vulkanResult;
+	VkAttachmentDescription attachmentDescriptions[2 * MAX_COLOR_TARGET_BINDINGS + 1];
+	VkAttachmentReference colorAttachmentReferences[MAX_COLOR_TARGET_BINDINGS];
+	VkAttachmentReference resolveReferences[MAX_COLOR_TARGET_BINDINGS + 1];
+	VkAttachmentReference depthStencilAttachmentReference;
+	VkRenderPassCreateInfo renderPassCreateInfo;
+	VkSubpassDescription subpass;
+	VkRenderPass renderPass;
+	uint32_t i;
+
+	uint32_t attachmentDescriptionCount = 0;
+	uint32_t colorAttachmentReferenceCount = 0;
+	uint32_t resolveReferenceCount = 0;
+
+	VulkanTexture *texture;
+	VulkanTexture *msaaTexture = NULL;
+
+	for (i = 0; i < colorAttachmentCount; i += 1)
+	{
+		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
+
+		if (texture->msaaTex != NULL)
+		{
+			msaaTexture = texture->msaaTex;
+
+			/* Transition the multisample attachment */
+
+			VULKAN_INTERNAL_ImageMemoryBarrier(
+				renderer,
+				commandBuffer->commandBuffer,
+				RESOURCE_ACCESS_COLOR_ATTACHMENT_WRITE,
+				VK_IMAGE_ASPECT_COLOR_BIT,
+				0,
+				msaaTexture->layerCount,
+				0,
+				msaaTexture->levelCount,
+				0,
+				msaaTexture
+			);
+
+			/* Resolve attachment and multisample attachment */
+
+			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
+			attachmentDescriptions[attachmentDescriptionCount].format = texture->format;
+			attachmentDescriptions[attachmentDescriptionCount].samples =
+				VK_SAMPLE_COUNT_1_BIT;
+			attachmentDescriptions[attachmentDescriptionCount].loadOp = RefreshToVK_LoadOp[
+				colorAttachmentInfos[i].loadOp
+			];
+			attachmentDescriptions[attachmentDescriptionCount].storeOp =
+				VK_ATTACHMENT_STORE_OP_STORE; /* Always store the resolve texture */
+			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp =
+				VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp =
+				VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].initialLayout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			attachmentDescriptions[attachmentDescriptionCount].finalLayout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			resolveReferences[resolveReferenceCount].attachment =
+				attachmentDescriptionCount;
+			resolveReferences[resolveReferenceCount].layout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			attachmentDescriptionCount += 1;
+			resolveReferenceCount += 1;
+
+			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
+			attachmentDescriptions[attachmentDescriptionCount].format = msaaTexture->format;
+			attachmentDescriptions[attachmentDescriptionCount].samples = RefreshToVK_SampleCount[
+				msaaTexture->sampleCount
+			];
+			attachmentDescriptions[attachmentDescriptionCount].loadOp = RefreshToVK_LoadOp[
+				colorAttachmentInfos[i].loadOp
+			];
+			attachmentDescriptions[attachmentDescriptionCount].storeOp = RefreshToVK_StoreOp[
+				colorAttachmentInfos[i].storeOp
+			];
+			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp =
+				VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp =
+				VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].initialLayout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			attachmentDescriptions[attachmentDescriptionCount].finalLayout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			colorAttachmentReferences[colorAttachmentReferenceCount].attachment =
+				attachmentDescriptionCount;
+			colorAttachmentReferences[colorAttachmentReferenceCount].layout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			attachmentDescriptionCount += 1;
+			colorAttachmentReferenceCount += 1;
+		}
+		else
+		{
+			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
+			attachmentDescriptions[attachmentDescriptionCount].format = texture->format;
+			attachmentDescriptions[attachmentDescriptionCount].samples =
+				VK_SAMPLE_COUNT_1_BIT;
+			attachmentDescriptions[attachmentDescriptionCount].loadOp = RefreshToVK_LoadOp[
+				colorAttachmentInfos[i].loadOp
+			];
+			attachmentDescriptions[attachmentDescriptionCount].storeOp =
+				VK_ATTACHMENT_STORE_OP_STORE; /* Always store non-MSAA textures */
+			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp =
+				VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp =
+				VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].initialLayout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			attachmentDescriptions[attachmentDescriptionCount].finalLayout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+
+			colorAttachmentReferences[colorAttachmentReferenceCount].attachment = attachmentDescriptionCount;
+			colorAttachmentReferences[colorAttachmentReferenceCount].layout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			attachmentDescriptionCount += 1;
+			colorAttachmentReferenceCount += 1;
+		}
+	}
+
+	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	subpass.flags = 0;
+	subpass.inputAttachmentCount = 0;
+	subpass.pInputAttachments = NULL;
+	subpass.colorAttachmentCount = colorAttachmentCount;
+	subpass.pColorAttachments = colorAttachmentReferences;
+	subpass.preserveAttachmentCount = 0;
+	subpass.pPreserveAttachments = NULL;
+
+	if (depthStencilAttachmentInfo == NULL)
+	{
+		subpass.pDepthStencilAttachment = NULL;
+	}
+	else
+	{
+		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
+
+		attachmentDescriptions[attachmentDescriptionCount].flags = 0;
+		attachmentDescriptions[attachmentDescriptionCount].format = texture->format;
+		attachmentDescriptions[attachmentDescriptionCount].samples = RefreshToVK_SampleCount[
+			texture->sampleCount
+		];
+		attachmentDescriptions[attachmentDescriptionCount].loadOp = RefreshToVK_LoadOp[
+			depthStencilAttachmentInfo->loadOp
+		];
+		attachmentDescriptions[attachmentDescriptionCount].storeOp = RefreshToVK_StoreOp[
+			depthStencilAttachmentInfo->storeOp
+		];
+		attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp = RefreshToVK_LoadOp[
+			depthStencilAttachmentInfo->stencilLoadOp
+		];
+		attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp = RefreshToVK_StoreOp[
+			depthStencilAttachmentInfo->stencilStoreOp
+		];
+		attachmentDescriptions[attachmentDescriptionCount].initialLayout =
+			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		attachmentDescriptions[attachmentDescriptionCount].finalLayout =
+			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		depthStencilAttachmentReference.attachment =
+			attachmentDescriptionCount;
+		depthStencilAttachmentReference.layout =
+			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		subpass.pDepthStencilAttachment =
+			&depthStencilAttachmentReference;
+
+		attachmentDescriptionCount += 1;
+	}
+
+	if (msaaTexture != NULL)
+	{
+		subpass.pResolveAttachments = resolveReferences;
+	}
+	else
+	{
+		subpass.pResolveAttachments = NULL;
+	}
+
+	renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassCreateInfo.pNext = NULL;
+	renderPassCreateInfo.flags = 0;
+	renderPassCreateInfo.pAttachments = attachmentDescriptions;
+	renderPassCreateInfo.attachmentCount = attachmentDescriptionCount;
+	renderPassCreateInfo.subpassCount = 1;
+	renderPassCreateInfo.pSubpasses = &subpass;
+	renderPassCreateInfo.dependencyCount = 0;
+	renderPassCreateInfo.pDependencies = NULL;
+
+	vulkanResult = renderer->vkCreateRenderPass(
+		renderer->logicalDevice,
+		&renderPassCreateInfo,
+		NULL,
+		&renderPass
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		renderPass = VK_NULL_HANDLE;
+		LogVulkanResultAsError("vkCreateRenderPass", vulkanResult);
+	}
+
+	return renderPass;
+}
+
+static VkRenderPass VULKAN_INTERNAL_CreateTransientRenderPass(
+	VulkanRenderer *renderer,
+	Refresh_GraphicsPipelineAttachmentInfo attachmentInfo,
+	Refresh_SampleCount sampleCount
+) {
+	VkAttachmentDescription attachmentDescriptions[2 * MAX_COLOR_TARGET_BINDINGS + 1];
+	VkAttachmentReference colorAttachmentReferences[MAX_COLOR_TARGET_BINDINGS];
+	VkAttachmentReference resolveReferences[MAX_COLOR_TARGET_BINDINGS + 1];
+	VkAttachmentReference depthStencilAttachmentReference;
+	Refresh_ColorAttachmentDescription attachmentDescription;
+	VkSubpassDescription subpass;
+	VkRenderPassCreateInfo renderPassCreateInfo;
+	VkRenderPass renderPass;
+	VkResult result;
+
+	uint32_t multisampling = 0;
+	uint32_t attachmentDescriptionCount = 0;
+	uint32_t colorAttachmentReferenceCount = 0;
+	uint32_t resolveReferenceCount = 0;
+	uint32_t i;
+
+	for (i = 0; i < attachmentInfo.colorAttachmentCount; i += 1)
+	{
+		attachmentDescription = attachmentInfo.colorAttachmentDescriptions[i];
+
+		if (sampleCount > REFRESH_SAMPLECOUNT_1)
+		{
+			multisampling = 1;
+
+			/* Resolve attachment and multisample attachment */
+
+			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
+			attachmentDescriptions[attachmentDescriptionCount].format = RefreshToVK_SurfaceFormat[
+				attachmentDescription.format
+			];
+			attachmentDescriptions[attachmentDescriptionCount].samples = VK_SAMPLE_COUNT_1_BIT;
+			attachmentDescriptions[attachmentDescriptionCount].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			attachmentDescriptions[attachmentDescriptionCount].finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			resolveReferences[resolveReferenceCount].attachment = attachmentDescriptionCount;
+			resolveReferences[resolveReferenceCount].layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			attachmentDescriptionCount += 1;
+			resolveReferenceCount += 1;
+
+			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
+			attachmentDescriptions[attachmentDescriptionCount].format = RefreshToVK_SurfaceFormat[
+				attachmentDescription.format
+			];
+			attachmentDescriptions[attachmentDescriptionCount].samples = RefreshToVK_SampleCount[
+				sampleCount
+			];
+			attachmentDescriptions[attachmentDescriptionCount].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			attachmentDescriptions[attachmentDescriptionCount].finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			colorAttachmentReferences[colorAttachmentReferenceCount].attachment =
+				attachmentDescriptionCount;
+			colorAttachmentReferences[colorAttachmentReferenceCount].layout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			attachmentDescriptionCount += 1;
+			colorAttachmentReferenceCount += 1;
+		}
+		else
+		{
+			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
+			attachmentDescriptions[attachmentDescriptionCount].format = RefreshToVK_SurfaceFormat[
+				attachmentDescription.format
+			];
+			attachmentDescriptions[attachmentDescriptionCount].samples =
+				VK_SAMPLE_COUNT_1_BIT;
+			attachmentDescriptions[attachmentDescriptionCount].loadOp =
+				VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].storeOp =
+				VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp =
+				VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp =
+				VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDescriptions[attachmentDescriptionCount].initialLayout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			attachmentDescriptions[attachmentDescriptionCount].finalLayout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+
+			colorAttachmentReferences[colorAttachmentReferenceCount].attachment = attachmentDescriptionCount;
+			colorAttachmentReferences[colorAttachmentReferenceCount].layout =
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			attachmentDescriptionCount += 1;
+			colorAttachmentReferenceCount += 1;
+		}
+	}
+
+	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	subpass.flags = 0;
+	subpass.inputAttachmentCount = 0;
+	subpass.pInputAttachments = NULL;
+	subpass.colorAttachmentCount = attachmentInfo.colorAttachmentCount;
+	subpass.pColorAttachments = colorAttachmentReferences;
+	subpass.preserveAttachmentCount = 0;
+	subpass.pPreserveAttachments = NULL;
+
+	if (attachmentInfo.hasDepthStencilAttachment)
+	{
+		attachmentDescriptions[attachmentDescriptionCount].flags = 0;
+		attachmentDescriptions[attachmentDescriptionCount].format = RefreshToVK_DepthFormat(
+			renderer,
+			attachmentInfo.depthStencilFormat
+		);
+		attachmentDescriptions[attachmentDescriptionCount].samples = RefreshToVK_SampleCount[
+			sampleCount
+		];
+		attachmentDescriptions[attachmentDescriptionCount].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		attachmentDescriptions[attachmentDescriptionCount].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		attachmentDescriptions[attachmentDescriptionCount].initialLayout =
+			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		attachmentDescriptions[attachmentDescriptionCount].finalLayout =
+			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		depthStencilAttachmentReference.attachment =
+			attachmentDescriptionCount;
+		depthStencilAttachmentReference.layout =
+			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		subpass.pDepthStencilAttachment =
+			&depthStencilAttachmentReference;
+
+		attachmentDescriptionCount += 1;
+	}
+	else
+	{
+		subpass.pDepthStencilAttachment = NULL;
+	}
+
+	if (multisampling)
+	{
+		subpass.pResolveAttachments = resolveReferences;
+	}
+	else
+	{
+		subpass.pResolveAttachments = NULL;
+	}
+
+	renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassCreateInfo.pNext = NULL;
+	renderPassCreateInfo.flags = 0;
+	renderPassCreateInfo.pAttachments = attachmentDescriptions;
+	renderPassCreateInfo.attachmentCount = attachmentDescriptionCount;
+	renderPassCreateInfo.subpassCount = 1;
+	renderPassCreateInfo.pSubpasses = &subpass;
+	renderPassCreateInfo.dependencyCount = 0;
+	renderPassCreateInfo.pDependencies = NULL;
+
+	result = renderer->vkCreateRenderPass(
+		renderer->logicalDevice,
+		&renderPassCreateInfo,
+		NULL,
+		&renderPass
+	);
+
+	if (result != VK_SUCCESS)
+	{
+		renderPass = VK_NULL_HANDLE;
+		LogVulkanResultAsError("vkCreateRenderPass", result);
+	}
+
+	return renderPass;
+}
+
+static Refresh_GraphicsPipeline* VULKAN_CreateGraphicsPipeline(
+	Refresh_Renderer *driverData,
+	Refresh_GraphicsPipelineCreateInfo *pipelineCreateInfo
+) {
+	VkResult vulkanResult;
+	uint32_t i;
+	Refresh_SampleCount actualSampleCount;
+	uint8_t pipelineLayoutInvalid = 0;
+	int32_t ycbcrFormatIndex = -1;
+
+	VulkanGraphicsPipeline *graphicsPipeline = (VulkanGraphicsPipeline*) SDL_malloc(sizeof(VulkanGraphicsPipeline));
+	VkGraphicsPipelineCreateInfo vkPipelineCreateInfo;
+
+	VkPipelineShaderStageCreateInfo shaderStageCreateInfos[2];
+
+	VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo;
+	VkVertexInputBindingDescription *vertexInputBindingDescriptions = SDL_stack_alloc(VkVertexInputBindingDescription, pipelineCreateInfo->vertexInputState.vertexBindingCount);
+	VkVertexInputAttributeDescription *vertexInputAttributeDescriptions = SDL_stack_alloc(VkVertexInputAttributeDescription, pipelineCreateInfo->vertexInputState.vertexAttributeCount);
+
+	VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCreateInfo;
+
+	VkPipelineViewportStateCreateInfo viewportStateCreateInfo;
+
+	VkPipelineRasterizationStateCreateInfo rasterizationStateCreateInfo;
+
+	VkPipelineMultisampleStateCreateInfo multisampleStateCreateInfo;
+
+	VkPipelineDepthStencilStateCreateInfo depthStencilStateCreateInfo;
+	VkStencilOpState frontStencilState;
+	VkStencilOpState backStencilState;
+
+	VkPipelineColorBlendStateCreateInfo colorBlendStateCreateInfo;
+	VkPipelineColorBlendAttachmentState *colorBlendAttachmentStates = SDL_stack_alloc(
+		VkPipelineColorBlendAttachmentState,
+		pipelineCreateInfo->attachmentInfo.colorAttachmentCount
+	);
+
+	static const VkDynamicState dynamicStates[] =
+	{
+		VK_DYNAMIC_STATE_VIEWPORT,
+		VK_DYNAMIC_STATE_SCISSOR
+	};
+	VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo;
+
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+
+	/* Find a compatible sample count to use */
+
+	actualSampleCount = VULKAN_INTERNAL_GetMaxMultiSampleCount(
+		renderer,
+		pipelineCreateInfo->multisampleState.multisampleCount
+	);
+
+	/* Create a "compatible" render pass */
+
+	VkRenderPass transientRenderPass = VULKAN_INTERNAL_CreateTransientRenderPass(
+		renderer,
+		pipelineCreateInfo->attachmentInfo,
+		actualSampleCount
+	);
+
+	/* Dynamic state */
+
+	dynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamicStateCreateInfo.pNext = NULL;
+	dynamicStateCreateInfo.flags = 0;
+	dynamicStateCreateInfo.dynamicStateCount = SDL_arraysize(dynamicStates);
+	dynamicStateCreateInfo.pDynamicStates = dynamicStates;
+
+	/* Shader stages */
+
+	graphicsPipeline->vertexShaderModule = (VulkanShaderModule*) pipelineCreateInfo->vertexShaderInfo.shaderModule;
+	SDL_AtomicIncRef(&graphicsPipeline->vertexShaderModule->referenceCount);
+
+	shaderStageCreateInfos[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	shaderStageCreateInfos[0].pNext = NULL;
+	shaderStageCreateInfos[0].flags = 0;
+	shaderStageCreateInfos[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+	shaderStageCreateInfos[0].module = graphicsPipeline->vertexShaderModule->shaderModule;
+	shaderStageCreateInfos[0].pName = pipelineCreateInfo->vertexShaderInfo.entryPointName;
+	shaderStageCreateInfos[0].pSpecializationInfo = NULL;
+
+	graphicsPipeline->vertexUniformBlockSize =
+		VULKAN_INTERNAL_NextHighestAlignment(
+			pipelineCreateInfo->vertexShaderInfo.uniformBufferSize,
+			renderer->minUBOAlignment
+		);
+
+	graphicsPipeline->vertexPushConstantSize = 0;
+	if (	graphicsPipeline->vertexShaderModule->usesPushConstants &&
+		pipelineCreateInfo->vertexShaderInfo.uniformBufferSize > 0	)
+	{
+		graphicsPipeline->vertexPushConstantSize = (uint32_t) VULKAN_INTERNAL_NextHighestAlignment(
+			pipelineCreateInfo->vertexShaderInfo.uniformBufferSize,
+			4
+		);
+		graphicsPipeline->vertexUniformBlockSize = 0;
+	}
+
+	graphicsPipeline->fragmentShaderModule = (VulkanShaderModule*) pipelineCreateInfo->fragmentShaderInfo.shaderModule;
+	SDL_AtomicIncRef(&graphicsPipeline->fragmentShaderModule->referenceCount);
+
+	shaderStageCreateInfos[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	shaderStageCreateInfos[1].pNext = NULL;
+	shaderStageCreateInfos[1].flags = 0;
+	shaderStageCreateInfos[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+	shaderStageCreateInfos[1].module = graphicsPipeline->fragmentShaderModule->shaderModule;
+	shaderStageCreateInfos[1].pName = pipelineCreateInfo->fragmentShaderInfo.entryPointName;
+	shaderStageCreateInfos[1].pSpecializationInfo = NULL;
+
+	graphicsPipeline->fragmentUniformBlockSize =
+		VULKAN_INTERNAL_NextHighestAlignment(
+			pipelineCreateInfo->fragmentShaderInfo.uniformBufferSize,
+			renderer->minUBOAlignment
+		);
+
+	graphicsPipeline->fragmentPushConstantSize = 0;
+	if (	graphicsPipeline->fragmentShaderModule->usesPushConstants &&
+		pipelineCreateInfo->fragmentShaderInfo.uniformBufferSize > 0	)
+	{
+		graphicsPipeline->fragmentPushConstantSize = (uint32_t) VULKAN_INTERNAL_NextHighestAlignment(
+			pipelineCreateInfo->fragmentShaderInfo.uniformBufferSize,
+			4
+		);
+		graphicsPipeline->fragmentUniformBlockSize = 0;
+	}
+
+	/* Vertex input */
+
+	for (i = 0; i < pipelineCreateInfo->vertexInputState.vertexBindingCount; i += 1)
+	{
+		vertexInputBindingDescriptions[i].binding = pipelineCreateInfo->vertexInputState.vertexBindings[i].binding;
+		vertexInputBindingDescriptions[i].inputRate = RefreshToVK_VertexInputRate[
+			pipelineCreateInfo->vertexInputState.vertexBindings[i].inputRate
+		];
+		vertexInputBindingDescriptions[i].stride = pipelineCreateInfo->vertexInputState.vertexBindings[i].stride;
+	}
+
+	for (i = 0; i < pipelineCreateInfo->vertexInputState.vertexAttributeCount; i += 1)
+	{
+		vertexInputAttributeDescriptions[i].binding = pipelineCreateInfo->vertexInputState.vertexAttributes[i].binding;
+		vertexInputAttributeDescriptions[i].format = RefreshToVK_VertexFormat[
+			pipelineCreateInfo->vertexInputState.vertexAttributes[i].format
+		];
+		vertexInputAttributeDescriptions[i].location = pipelineCreateInfo->vertexInputState.vertexAttributes[i].location;
+		vertexInputAttributeDescriptions[i].offset = pipelineCreateInfo->vertexInputState.vertexAttributes[i].offset;
+	}
+
+	vertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	vertexInputStateCreateInfo.pNext = NULL;
+	vertexInputStateCreateInfo.flags = 0;
+	vertexInputStateCreateInfo.vertexBindingDescriptionCount = pipelineCreateInfo->vertexInputState.vertexBindingCount;
+	vertexInputStateCreateInfo.pVertexBindingDescriptions = vertexInputBindingDescriptions;
+	vertexInputStateCreateInfo.vertexAttributeDescriptionCount = pipelineCreateInfo->vertexInputState.vertexAttributeCount;
+	vertexInputStateCreateInfo.pVertexAttributeDescriptions = vertexInputAttributeDescriptions;
+
+	/* Topology */
+
+	inputAssemblyStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	inputAssemblyStateCreateInfo.pNext = NULL;
+	inputAssemblyStateCreateInfo.flags = 0;
+	inputAssemblyStateCreateInfo.primitiveRestartEnable = VK_FALSE;
+	inputAssemblyStateCreateInfo.topology = RefreshToVK_PrimitiveType[
+		pipelineCreateInfo->primitiveType
+	];
+
+	graphicsPipeline->primitiveType = pipelineCreateInfo->primitiveType;
+
+	/* Viewport */
+
+	/* NOTE: viewport and scissor are dynamic, and must be set using the command buffer */
+
+	viewportStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	viewportStateCreateInfo.pNext = NULL;
+	viewportStateCreateInfo.flags = 0;
+	viewportStateCreateInfo.viewportCount = 1;
+	viewportStateCreateInfo.pViewports = NULL;
+	viewportStateCreateInfo.scissorCount = 1;
+	viewportStateCreateInfo.pScissors = NULL;
+
+	/* Rasterization */
+
+	rasterizationStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	rasterizationStateCreateInfo.pNext = NULL;
+	rasterizationStateCreateInfo.flags = 0;
+	rasterizationStateCreateInfo.depthClampEnable = VK_FALSE;
+	rasterizationStateCreateInfo.rasterizerDiscardEnable = VK_FALSE;
+	rasterizationStateCreateInfo.polygonMode = RefreshToVK_PolygonMode[
+		pipelineCreateInfo->rasterizerState.fillMode
+	];
+	rasterizationStateCreateInfo.cullMode = RefreshToVK_CullMode[
+		pipelineCreateInfo->rasterizerState.cullMode
+	];
+	rasterizationStateCreateInfo.frontFace = RefreshToVK_FrontFace[
+		pipelineCreateInfo->rasterizerState.frontFace
+	];
+	rasterizationStateCreateInfo.depthBiasEnable =
+		pipelineCreateInfo->rasterizerState.depthBiasEnable;
+	rasterizationStateCreateInfo.depthBiasConstantFactor =
+		pipelineCreateInfo->rasterizerState.depthBiasConstantFactor;
+	rasterizationStateCreateInfo.depthBiasClamp =
+		pipelineCreateInfo->rasterizerState.depthBiasClamp;
+	rasterizationStateCreateInfo.depthBiasSlopeFactor =
+		pipelineCreateInfo->rasterizerState.depthBiasSlopeFactor;
+	rasterizationStateCreateInfo.lineWidth = 1.0f;
+
+	/* Multisample */
+
+	multisampleStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	multisampleStateCreateInfo.pNext = NULL;
+	multisampleStateCreateInfo.flags = 0;
+	multisampleStateCreateInfo.rasterizationSamples = RefreshToVK_SampleCount[actualSampleCount];
+	multisampleStateCreateInfo.sampleShadingEnable = VK_FALSE;
+	multisampleStateCreateInfo.minSampleShading = 1.0f;
+	multisampleStateCreateInfo.pSampleMask =
+		&pipelineCreateInfo->multisampleState.sampleMask;
+	multisampleStateCreateInfo.alphaToCoverageEnable = VK_FALSE;
+	multisampleStateCreateInfo.alphaToOneEnable = VK_FALSE;
+
+	/* Depth Stencil State */
+
+	frontStencilState.failOp = RefreshToVK_StencilOp[
+		pipelineCreateInfo->depthStencilState.frontStencilState.failOp
+	];
+	frontStencilState.passOp = RefreshToVK_StencilOp[
+		pipelineCreateInfo->depthStencilState.frontStencilState.passOp
+	];
+	frontStencilState.depthFailOp = RefreshToVK_StencilOp[
+		pipelineCreateInfo->depthStencilState.frontStencilState.depthFailOp
+	];
+	frontStencilState.compareOp = RefreshToVK_CompareOp[
+		pipelineCreateInfo->depthStencilState.frontStencilState.compareOp
+	];
+	frontStencilState.compareMask =
+		pipelineCreateInfo->depthStencilState.frontStencilState.compareMask;
+	frontStencilState.writeMask =
+		pipelineCreateInfo->depthStencilState.frontStencilState.writeMask;
+	frontStencilState.reference =
+		pipelineCreateInfo->depthStencilState.frontStencilState.reference;
+
+	backStencilState.failOp = RefreshToVK_StencilOp[
+		pipelineCreateInfo->depthStencilState.backStencilState.failOp
+	];
+	backStencilState.passOp = RefreshToVK_StencilOp[
+		pipelineCreateInfo->depthStencilState.backStencilState.passOp
+	];
+	backStencilState.depthFailOp = RefreshToVK_StencilOp[
+		pipelineCreateInfo->depthStencilState.backStencilState.depthFailOp
+	];
+	backStencilState.compareOp = RefreshToVK_CompareOp[
+		pipelineCreateInfo->depthStencilState.backStencilState.compareOp
+	];
+	backStencilState.compareMask =
+		pipelineCreateInfo->depthStencilState.backStencilState.compareMask;
+	backStencilState.writeMask =
+		pipelineCreateInfo->depthStencilState.backStencilState.writeMask;
+	backStencilState.reference =
+		pipelineCreateInfo->depthStencilState.backStencilState.reference;
+
+
+	depthStencilStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depthStencilStateCreateInfo.pNext = NULL;
+	depthStencilStateCreateInfo.flags = 0;
+	depthStencilStateCreateInfo.depthTestEnable =
+		pipelineCreateInfo->depthStencilState.depthTestEnable;
+	depthStencilStateCreateInfo.depthWriteEnable =
+		pipelineCreateInfo->depthStencilState.depthWriteEnable;
+	depthStencilStateCreateInfo.depthCompareOp = RefreshToVK_CompareOp[
+		pipelineCreateInfo->depthStencilState.compareOp
+	];
+	depthStencilStateCreateInfo.depthBoundsTestEnable =
+		pipelineCreateInfo->depthStencilState.depthBoundsTestEnable;
+	depthStencilStateCreateInfo.stencilTestEnable =
+		pipelineCreateInfo->depthStencilState.stencilTestEnable;
+	depthStencilStateCreateInfo.front = frontStencilState;
+	depthStencilStateCreateInfo.back = backStencilState;
+	depthStencilStateCreateInfo.minDepthBounds =
+		pipelineCreateInfo->depthStencilState.minDepthBounds;
+	depthStencilStateCreateInfo.maxDepthBounds =
+		pipelineCreateInfo->depthStencilState.maxDepthBounds;
+
+	/* Color Blend */
+
+	for (i = 0; i < pipelineCreateInfo->attachmentInfo.colorAttachmentCount; i += 1)
+	{
+		Refresh_ColorAttachmentBlendState blendState = pipelineCreateInfo->attachmentInfo.colorAttachmentDescriptions[i].blendState;
+
+		colorBlendAttachmentStates[i].blendEnable =
+			blendState.blendEnable;
+		colorBlendAttachmentStates[i].srcColorBlendFactor = RefreshToVK_BlendFactor[
+			blendState.srcColorBlendFactor
+		];
+		colorBlendAttachmentStates[i].dstColorBlendFactor = RefreshToVK_BlendFactor[
+			blendState.dstColorBlendFactor
+		];
+		colorBlendAttachmentStates[i].colorBlendOp = RefreshToVK_BlendOp[
+			blendState.colorBlendOp
+		];
+		colorBlendAttachmentStates[i].srcAlphaBlendFactor = RefreshToVK_BlendFactor[
+			blendState.srcAlphaBlendFactor
+		];
+		colorBlendAttachmentStates[i].dstAlphaBlendFactor = RefreshToVK_BlendFactor[
+			blendState.dstAlphaBlendFactor
+		];
+		colorBlendAttachmentStates[i].alphaBlendOp = RefreshToVK_BlendOp[
+			blendState.alphaBlendOp
+		];
+		colorBlendAttachmentStates[i].colorWriteMask =
+			blendState.colorWriteMask;
+	}
+
+	colorBlendStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	colorBlendStateCreateInfo.pNext = NULL;
+	colorBlendStateCreateInfo.flags = 0;
+	colorBlendStateCreateInfo.attachmentCount =
+		pipelineCreateInfo->attachmentInfo.colorAttachmentCount;
+	colorBlendStateCreateInfo.pAttachments =
+		colorBlendAttachmentStates;
+	colorBlendStateCreateInfo.blendConstants[0] =
+		pipelineCreateInfo->blendConstants[0];
+	colorBlendStateCreateInfo.blendConstants[1] =
+		pipelineCreateInfo->blendConstants[1];
+	colorBlendStateCreateInfo.blendConstants[2] =
+		pipelineCreateInfo->blendConstants[2];
+	colorBlendStateCreateInfo.blendConstants[3] =
+		pipelineCreateInfo->blendConstants[3];
+
+	/* We don't support LogicOp, so this is easy. */
+	colorBlendStateCreateInfo.logicOpEnable = VK_FALSE;
+	colorBlendStateCreateInfo.logicOp = 0;
+
+	/* Pipeline Layout */
+
+	if (	graphicsPipeline->vertexUniformBlockSize > UBO_MAX_BLOCK_SIZE ||
+		graphicsPipeline->fragmentUniformBlockSize > UBO_MAX_BLOCK_SIZE	)
+	{
+		Refresh_LogError("Uniform blocks larger than %u bytes are not supported!", UBO_MAX_BLOCK_SIZE);
+		pipelineLayoutInvalid = 1;
+	}
+
+	if (graphicsPipeline->vertexPushConstantSize > FRAGMENT_PUSH_CONSTANT_OFFSET)
+	{
+		Refresh_LogError(
+			"Vertex push constant blocks larger than %u bytes are not supported!",
+			FRAGMENT_PUSH_CONSTANT_OFFSET
+		);
+		pipelineLayoutInvalid = 1;
+	}
+
+	if (	graphicsPipeline->fragmentPushConstantSize > 0 &&
+		FRAGMENT_PUSH_CONSTANT_OFFSET + graphicsPipeline->fragmentPushConstantSize >
+		renderer->physicalDeviceProperties.properties.limits.maxPushConstantsSize	)
+	{
+		Refresh_LogError(
+			"Fragment push constant block ends at %u bytes, device limit is %u!",
+			FRAGMENT_PUSH_CONSTANT_OFFSET + graphicsPipeline->fragmentPushConstantSize,
+			renderer->physicalDeviceProperties.properties.limits.maxPushConstantsSize
+		);
+		pipelineLayoutInvalid = 1;
+	}
+
+	if (pipelineCreateInfo->fragmentYCbCrSamplerMask != 0)
+	{
+		ycbcrFormatIndex = VULKAN_INTERNAL_YCbCrFormatIndex(
+			RefreshToVK_SurfaceFormat[pipelineCreateInfo->fragmentYCbCrFormat]
+		);
+
+		if (	ycbcrFormatIndex < 0 ||
+			renderer->ycbcrSamplers[ycbcrFormatIndex] == VK_NULL_HANDLE	)
+		{
+			Refresh_LogError("Y'CbCr samplers need a multi-planar format the device supports!");
+			pipelineLayoutInvalid = 1;
+		}
+		else if (pipelineCreateInfo->fragmentYCbCrSamplerMask >> pipelineCreateInfo->fragmentShaderInfo.samplerBindingCount)
+		{
+			Refresh_LogError("Y'CbCr sampler mask names bindings past the fragment sampler count!");
+			pipelineLayoutInvalid = 1;
+		}
+	}
+
+	if (pipelineLayoutInvalid)
+	{
+		SDL_stack_free(vertexInputBindingDescriptions);
+		SDL_stack_free(vertexInputAttributeDescriptions);
+		SDL_stack_free(colorBlendAttachmentStates);
+
+		renderer->vkDestroyRenderPass(
+			renderer->logicalDevice,
+			transientRenderPass,
+			NULL
+		);
+
+		Refresh_LogError("Failed to create graphics pipeline!");
+
+		SDL_AtomicDecRef(&graphicsPipeline->vertexShaderModule->referenceCount);
+		SDL_AtomicDecRef(&graphicsPipeline->fragmentShaderModule->referenceCount);
+		SDL_free(graphicsPipeline);
+		return NULL;
+	}
+
+	graphicsPipeline->pipelineLayout = VULKAN_INTERNAL_FetchGraphicsPipelineLayout(
+		renderer,
+		pipelineCreateInfo->vertexShaderInfo.samplerBindingCount,
+		pipelineCreateInfo->fragmentShaderInfo.samplerBindingCount,
+		graphicsPipeline->vertexPushConstantSize,
+		graphicsPipeline->fragmentPushConstantSize,
+		pipelineCreateInfo->fragmentYCbCrSamplerMask,
+		ycbcrFormatIndex
+	);
+
+	/* Pipeline */
+
+	vkPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	vkPipelineCreateInfo.pNext = NULL;
+	vkPipelineCreateInfo.flags = 0;
+	vkPipelineCreateInfo.stageCount = 2;
+	vkPipelineCreateInfo.pStages = shaderStageCreateInfos;
+	vkPipelineCreateInfo.pVertexInputState = &vertexInputStateCreateInfo;
+	vkPipelineCreateInfo.pInputAssemblyState = &inputAssemblyStateCreateInfo;
+	vkPipelineCreateInfo.pTessellationState = VK_NULL_HANDLE;
+	vkPipelineCreateInfo.pViewportState = &viewportStateCreateInfo;
+	vkPipelineCreateInfo.pRasterizationState = &rasterizationStateCreateInfo;
+	vkPipelineCreateInfo.pMultisampleState = &multisampleStateCreateInfo;
+	vkPipelineCreateInfo.pDepthStencilState = &depthStencilStateCreateInfo;
+	vkPipelineCreateInfo.pColorBlendState = &colorBlendStateCreateInfo;
+	vkPipelineCreateInfo.pDynamicState = &dynamicStateCreateInfo;
+	vkPipelineCreateInfo.layout = graphicsPipeline->pipelineLayout->pipelineLayout;
+	vkPipelineCreateInfo.renderPass = transientRenderPass;
+	vkPipelineCreateInfo.subpass = 0;
+	vkPipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+	vkPipelineCreateInfo.basePipelineIndex = 0;
+
+	/* TODO: enable pipeline caching */
+	vulkanResult = renderer->vkCreateGraphicsPipelines(
+		renderer->logicalDevice,
+		VK_NULL_HANDLE,
+		1,
+		&vkPipelineCreateInfo,
+		NULL,
+		&graphicsPipeline->pipeline
+	);
+
+	SDL_stack_free(vertexInputBindingDescriptions);
+	SDL_stack_free(vertexInputAttributeDescriptions);
+	SDL_stack_free(colorBlendAttachmentStates);
+
+	renderer->vkDestroyRenderPass(
+		renderer->logicalDevice,
+		transientRenderPass,
+		NULL
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		SDL_free(graphicsPipeline);
+		LogVulkanResultAsError("vkCreateGraphicsPipelines", vulkanResult);
+		Refresh_LogError("Failed to create graphics pipeline!");
+		return NULL;
+	}
+
+	SDL_AtomicSet(&graphicsPipeline->referenceCount, 0);
+
+	return (Refresh_GraphicsPipeline*) graphicsPipeline;
+}
+
+static VulkanComputePipelineLayout* VULKAN_INTERNAL_FetchComputePipelineLayout(
+	VulkanRenderer *renderer,
+	uint32_t bufferBindingCount,
+	uint32_t imageBindingCount
+) {
+	VkResult vulkanResult;
+	VkDescriptorSetLayout setLayouts[3];
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
+	ComputePipelineLayoutHash pipelineLayoutHash;
+	VulkanComputePipelineLayout *vulkanComputePipelineLayout;
+
+	pipelineLayoutHash.bufferLayout = VULKAN_INTERNAL_FetchDescriptorSetLayout(
+		renderer,
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		bufferBindingCount,
+		VK_SHADER_STAGE_COMPUTE_BIT,
+		0,
+		VK_NULL_HANDLE
+	);
+
+	pipelineLayoutHash.imageLayout = VULKAN_INTERNAL_FetchDescriptorSetLayout(
+		renderer,
+		VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+		imageBindingCount,
+		VK_SHADER_STAGE_COMPUTE_BIT,
+		0,
+		VK_NULL_HANDLE
+	);
+
+	pipelineLayoutHash.uniformLayout = renderer->computeUniformDescriptorSetLayout;
+
+	vulkanComputePipelineLayout = ComputePipelineLayoutHashArray_Fetch(
+		&renderer->computePipelineLayoutHashTable,
+		pipelineLayoutHash
+	);
+
+	if (vulkanComputePipelineLayout != NULL)
+	{
+		return vulkanComputePipelineLayout;
+	}
+
+	vulkanComputePipelineLayout = SDL_malloc(sizeof(VulkanComputePipelineLayout));
+
+	setLayouts[0] = pipelineLayoutHash.bufferLayout;
+	setLayouts[1] = pipelineLayoutHash.imageLayout;
+	setLayouts[2] = pipelineLayoutHash.uniformLayout;
+
+	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.pNext = NULL;
+	pipelineLayoutCreateInfo.flags = 0;
+	pipelineLayoutCreateInfo.setLayoutCount = 3;
+	pipelineLayoutCreateInfo.pSetLayouts = setLayouts;
+	pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
+	pipelineLayoutCreateInfo.pPushConstantRanges = NULL;
+
+	vulkanResult = renderer->vkCreatePipelineLayout(
+		renderer->logicalDevice,
+		&pipelineLayoutCreateInfo,
+		NULL,
+		&vulkanComputePipelineLayout->pipelineLayout
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkCreatePipelineLayout", vulkanResult);
+		return NULL;
+	}
+
+	ComputePipelineLayoutHashArray_Insert(
+		&renderer->computePipelineLayoutHashTable,
+		pipelineLayoutHash,
+		vulkanComputePipelineLayout
+	);
+
+	/* If the binding count is 0
+	 * we can just bind the same descriptor set
+	 * so no cache is needed
+	 */
+
+	if (bufferBindingCount == 0)
+	{
+		vulkanComputePipelineLayout->bufferDescriptorSetCache = NULL;
+	}
+	else
+	{
+		vulkanComputePipelineLayout->bufferDescriptorSetCache =
+			VULKAN_INTERNAL_CreateDescriptorSetCache(
+				renderer,
+				VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				pipelineLayoutHash.bufferLayout,
+				bufferBindingCount,
+				bufferBindingCount
+			);
+	}
+
+	if (imageBindingCount == 0)
+	{
+		vulkanComputePipelineLayout->imageDescriptorSetCache = NULL;
+	}
+	else
+	{
+		vulkanComputePipelineLayout->imageDescriptorSetCache =
+			VULKAN_INTERNAL_CreateDescriptorSetCache(
+				renderer,
+				VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+				pipelineLayoutHash.imageLayout,
+				imageBindingCount,
+				imageBindingCount
+			);
+	}
+
+	return vulkanComputePipelineLayout;
+}
+
+static Refresh_ComputePipeline* VULKAN_CreateComputePipeline(
+	Refresh_Renderer *driverData,
+	Refresh_ComputeShaderInfo *computeShaderInfo
+) {
+	VkComputePipelineCreateInfo computePipelineCreateInfo;
+	VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo;
+
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanComputePipeline *vulkanComputePipeline;
+
+	if (computeShaderInfo->uniformBufferSize > UBO_MAX_BLOCK_SIZE)
+	{
+		Refresh_LogError("Uniform blocks larger than %u bytes are not supported!", UBO_MAX_BLOCK_SIZE);
+		return NULL;
+	}
+
+	vulkanComputePipeline = SDL_malloc(sizeof(VulkanComputePipeline));
+
+	vulkanComputePipeline->computeShaderModule = (VulkanShaderModule*) computeShaderInfo->shaderModule;
+	SDL_AtomicIncRef(&vulkanComputePipeline->computeShaderModule->referenceCount);
+
+	pipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	pipelineShaderStageCreateInfo.pNext = NULL;
+	pipelineShaderStageCreateInfo.flags = 0;
+	pipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	pipelineShaderStageCreateInfo.module = vulkanComputePipeline->computeShaderModule->shaderModule;
+	pipelineShaderStageCreateInfo.pName = computeShaderInfo->entryPointName;
+	pipelineShaderStageCreateInfo.pSpecializationInfo = NULL;
+
+	vulkanComputePipeline->pipelineLayout = VULKAN_INTERNAL_FetchComputePipelineLayout(
+		renderer,
+		computeShaderInfo->bufferBindingCount,
+		computeShaderInfo->imageBindingCount
+	);
+
+	computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	computePipelineCreateInfo.pNext = NULL;
+	computePipelineCreateInfo.flags = 0;
+	computePipelineCreateInfo.stage = pipelineShaderStageCreateInfo;
+	computePipelineCreateInfo.layout =
+		vulkanComputePipeline->pipelineLayout->pipelineLayout;
+	computePipelineCreateInfo.basePipelineHandle = NULL;
+	computePipelineCreateInfo.basePipelineIndex = 0;
+
+	renderer->vkCreateComputePipelines(
+		renderer->logicalDevice,
+		NULL,
+		1,
+		&computePipelineCreateInfo,
+		NULL,
+		&vulkanComputePipeline->pipeline
+	);
+
+	vulkanComputePipeline->uniformBlockSize =
+		VULKAN_INTERNAL_NextHighestAlignment(
+			computeShaderInfo->uniformBufferSize,
+			renderer->minUBOAlignment
+		);
+
+	SDL_AtomicSet(&vulkanComputePipeline->referenceCount, 0);
+
+	return (Refresh_ComputePipeline*) vulkanComputePipeline;
+}
+
+static Refresh_Sampler* VULKAN_CreateSampler(
+	Refresh_Renderer *driverData,
+	Refresh_SamplerStateCreateInfo *samplerStateCreateInfo
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
+	VulkanSampler *vulkanSampler = SDL_malloc(sizeof(VulkanSampler));
+	VkResult vulkanResult;
+
+	VkSamplerCreateInfo vkSamplerCreateInfo;
+	vkSamplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	vkSamplerCreateInfo.pNext = NULL;
+	vkSamplerCreateInfo.flags = 0;
+	vkSamplerCreateInfo.magFilter = RefreshToVK_Filter[
+		samplerStateCreateInfo->magFilter
+	];
+	vkSamplerCreateInfo.minFilter = RefreshToVK_Filter[
+		samplerStateCreateInfo->minFilter
+	];
+	vkSamplerCreateInfo.mipmapMode = RefreshToVK_SamplerMipmapMode[
+		samplerStateCreateInfo->mipmapMode
+	];
+	vkSamplerCreateInfo.addressModeU = RefreshToVK_SamplerAddressMode[
+		samplerStateCreateInfo->addressModeU
+	];
+	vkSamplerCreateInfo.addressModeV = RefreshToVK_SamplerAddressMode[
+		samplerStateCreateInfo->addressModeV
+	];
+	vkSamplerCreateInfo.addressModeW = RefreshToVK_SamplerAddressMode[
+		samplerStateCreateInfo->addressModeW
+	];
+	vkSamplerCreateInfo.mipLodBias = samplerStateCreateInfo->mipLodBias;
+	vkSamplerCreateInfo.anisotropyEnable = samplerStateCreateInfo->anisotropyEnable;
+	vkSamplerCreateInfo.maxAnisotropy = samplerStateCreateInfo->maxAnisotropy;
+	vkSamplerCreateInfo.compareEnable = samplerStateCreateInfo->compareEnable;
+	vkSamplerCreateInfo.compareOp = RefreshToVK_CompareOp[
+		samplerStateCreateInfo->compareOp
+	];
+	vkSamplerCreateInfo.minLod = samplerStateCreateInfo->minLod;
+	vkSamplerCreateInfo.maxLod = samplerStateCreateInfo->maxLod;
+	vkSamplerCreateInfo.borderColor = RefreshToVK_BorderColor[
+		samplerStateCreateInfo->borderColor
+	];
+	vkSamplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+
+	vulkanResult = renderer->vkCreateSampler(
+		renderer->logicalDevice,
+		&vkSamplerCreateInfo,
+		NULL,
+		&vulkanSampler->sampler
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		SDL_free(vulkanSampler);
+		LogVulkanResultAsError("vkCreateSampler", vulkanResult);
+		return NULL;
+	}
+
+	SDL_AtomicSet(&vulkanSampler->referenceCount, 0);
+
+	return (Refresh_Sampler*) vulkanSampler;
+}
+
+/* Walks the SPIR-V instruction stream looking for
+ * an OpVariable in the PushConstant storage class.
+ */
+static uint8_t VULKAN_INTERNAL_SPIRVUsesPushConstants(
+	const uint32_t *code,
+	size_t codeSize
+) {
+	const uint32_t SPIRV_MAGIC = 0x07230203;
+	const uint32_t SPIRV_HEADER_WORDS = 5;
+	const uint16_t SPIRV_OP_VARIABLE = 59;
+	const uint32_t SPIRV_STORAGE_CLASS_PUSH_CONSTANT = 9;
+
+	size_t wordCount = codeSize / sizeof(uint32_t);
+	size_t i = SPIRV_HEADER_WORDS;
+	uint16_t instructionWordCount;
+
+	if (wordCount < SPIRV_HEADER_WORDS || code[0] != SPIRV_MAGIC)
+	{
+		return 0;
+	}
+
+	while (i < wordCount)
+	{
+		instructionWordCount = (uint16_t) (code[i] >> 16);
+
+		if (instructionWordCount == 0 || i + instructionWordCount > wordCount)
+		{
+			break;
+		}
+
+		if (	(code[i] & 0xFFFF) == SPIRV_OP_VARIABLE &&
+			instructionWordCount >= 4 &&
+			code[i + 3] == SPIRV_STORAGE_CLASS_PUSH_CONSTANT	)
+		{
+			return 1;
+		}
+
+		i += instructionWordCount;
+	}
+
+	return 0;
+}
+
+static Refresh_ShaderModule* VULKAN_CreateShaderModule(
+	Refresh_Renderer *driverData,
+	Refresh_ShaderModuleCreateInfo *shaderModuleCreateInfo
+) {
+	VulkanShaderModule *vulkanShaderModule = SDL_malloc(sizeof(VulkanShaderModule));
+	VkResult vulkanResult;
+	VkShaderModuleCreateInfo vkShaderModuleCreateInfo;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+
+	vkShaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	vkShaderModuleCreateInfo.pNext = NULL;
+	vkShaderModuleCreateInfo.flags = 0;
+	vkShaderModuleCreateInfo.codeSize = shaderModuleCreateInfo->codeSize;
+	vkShaderModuleCreateInfo.pCode = (uint32_t*) shaderModuleCreateInfo->byteCode;
+
+	vulkanResult = renderer->vkCreateShaderModule(
+		renderer->logicalDevice,
+		&vkShaderModuleCreateInfo,
+		NULL,
+		&vulkanShaderModule->shaderModule
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		SDL_free(vulkanShaderModule);
+		LogVulkanResultAsError("vkCreateShaderModule", vulkanResult);
+		Refresh_LogError("Failed to create shader module!");
+		return NULL;
+	}
+
+	vulkanShaderModule->usesPushConstants = VULKAN_INTERNAL_SPIRVUsesPushConstants(
+		(uint32_t*) shaderModuleCreateInfo->byteCode,
+		shaderModuleCreateInfo->codeSize
+	);
+
+	SDL_AtomicSet(&vulkanShaderModule->referenceCount, 0);
+
+	return (Refresh_ShaderModule*) vulkanShaderModule;
+}
+
+static void VULKAN_INTERNAL_GetTextureCreateParameters(
+	VulkanRenderer *renderer,
+	Refresh_TextureCreateInfo *textureCreateInfo,
+	VkFormat *pFormat,
+	VkImageUsageFlags *pImageUsageFlags,
+	VkImageUsageFlags *pMultisampleUsageFlags,
+	VkImageAspectFlags *pImageAspectFlags
+) {
+	VkImageUsageFlags imageUsageFlags = (
+		VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+		VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+	);
+	VkImageUsageFlags multisampleUsageFlags;
+	VkImageAspectFlags imageAspectFlags;
+	uint8_t isDepthFormat = IsRefreshDepthFormat(textureCreateInfo->format);
+	uint8_t hasMultisampleTexture = !isDepthFormat && textureCreateInfo->sampleCount > REFRESH_SAMPLECOUNT_1;
+	VkFormat format;
+
+	if (isDepthFormat)
+	{
+		format = RefreshToVK_DepthFormat(renderer, textureCreateInfo->format);
+	}
+	else
+	{
+		format = RefreshToVK_SurfaceFormat[textureCreateInfo->format];
+	}
+
+	if (textureCreateInfo->usageFlags & REFRESH_TEXTUREUSAGE_SAMPLER_BIT)
+	{
+		imageUsageFlags |= VK_IMAGE_USAGE_SAMPLED_BIT;
+	}
+
+	if (textureCreateInfo->usageFlags & REFRESH_TEXTUREUSAGE_COLOR_TARGET_BIT)
+	{
+		imageUsageFlags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+	}
+
+	if (textureCreateInfo->usageFlags & REFRESH_TEXTUREUSAGE_DEPTH_STENCIL_TARGET_BIT)
+	{
+		imageUsageFlags |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+	}
+
+	if (textureCreateInfo->usageFlags & REFRESH_TEXTUREUSAGE_COMPUTE_BIT)
+	{
+		imageUsageFlags |= VK_IMAGE_USAGE_STORAGE_BIT;
+	}
+
+	multisampleUsageFlags = imageUsageFlags;
+
+	/* Transient attachments can't be copied, sampled or written by compute */
+	if (textureCreateInfo->usageFlags & REFRESH_TEXTUREUSAGE_LAZILY_ALLOCATED_BIT)
+	{
+		if (hasMultisampleTexture)
+		{
+			multisampleUsageFlags =
+				VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+				VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+		}
+		else if (textureCreateInfo->usageFlags & (REFRESH_TEXTUREUSAGE_SAMPLER_BIT | REFRESH_TEXTUREUSAGE_COMPUTE_BIT))
+		{
+			Refresh_LogWarn("Lazily allocated textures can only be render targets, ignoring the flag");
+		}
+		else
+		{
+			imageUsageFlags &=
+				VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+				VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+			imageUsageFlags |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+		}
+	}
+
+	if (isDepthFormat)
+	{
+		imageAspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+		if (IsStencilFormat(format))
+		{
+			imageAspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
+		}
+	}
+	else
+	{
+		imageAspectFlags = VK_IMAGE_ASPECT_COLOR_BIT;
+	}
+
+	*pFormat = format;
+	*pImageUsageFlags = imageUsageFlags;
+	*pMultisampleUsageFlags = multisampleUsageFlags;
+	*pImageAspectFlags = imageAspectFlags;
+}
+
+static uint8_t VULKAN_SupportsYCbCrFormat(
+	Refresh_Renderer *driverData,
+	Refresh_TextureFormat format
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	int32_t ycbcrFormatIndex = VULKAN_INTERNAL_YCbCrFormatIndex(
+		RefreshToVK_SurfaceFormat[format]
+	);
+
+	return (	ycbcrFormatIndex >= 0 &&
+			renderer->ycbcrConversions[ycbcrFormatIndex] != VK_NULL_HANDLE	);
+}
+
+static uint8_t VULKAN_INTERNAL_IsValidYCbCrTexture(
+	VulkanRenderer *renderer,
+	Refresh_TextureCreateInfo *textureCreateInfo
+) {
+	if (!VULKAN_SupportsYCbCrFormat((Refresh_Renderer*) renderer, textureCreateInfo->format))
+	{
+		Refresh_LogError("Multi-planar format not supported, use R8 planes instead!");
+		return 0;
+	}
+
+	if (	textureCreateInfo->depth > 1 ||
+		textureCreateInfo->isCube ||
+		textureCreateInfo->levelCount != 1 ||
+		textureCreateInfo->sampleCount != REFRESH_SAMPLECOUNT_1 ||
+		textureCreateInfo->usageFlags != REFRESH_TEXTUREUSAGE_SAMPLER_BIT	)
+	{
+		Refresh_LogError("Multi-planar textures must be single level 2D textures only used for sampling!");
+		return 0;
+	}
+
+	/* 4:2:0 chroma planes are half size */
+	if ((textureCreateInfo->width | textureCreateInfo->height) & 1)
+	{
+		Refresh_LogError("Multi-planar textures must have even dimensions!");
+		return 0;
+	}
+
+	return 1;
+}
+
+static Refresh_Texture* VULKAN_CreateTexture(
+	Refresh_Renderer *driverData,
+	Refresh_TextureCreateInfo *textureCreateInfo
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VkImageUsageFlags imageUsageFlags;
+	VkImageUsageFlags multisampleUsageFlags;
+	VkImageAspectFlags imageAspectFlags;
+	uint8_t isDepthFormat = IsRefreshDepthFormat(textureCreateInfo->format);
+	uint8_t transient = (textureCreateInfo->usageFlags & REFRESH_TEXTUREUSAGE_TRANSIENT_BIT) != 0;
+	VkFormat format;
+	VulkanTextureContainer *container;
+	VulkanTexture *vulkanTexture;
+
+	if (	VULKAN_INTERNAL_YCbCrFormatIndex(RefreshToVK_SurfaceFormat[textureCreateInfo->format]) >= 0 &&
+		!VULKAN_INTERNAL_IsValidYCbCrTexture(renderer, textureCreateInfo)	)
+	{
+		return NULL;
+	}
+
+	VULKAN_INTERNAL_GetTextureCreateParameters(
+		renderer,
+		textureCreateInfo,
+		&format,
+		&imageUsageFlags,
+		&multisampleUsageFlags,
+		&imageAspectFlags
+	);
+
+	vulkanTexture = VULKAN_INTERNAL_CreateTexture(
+		renderer,
+		textureCreateInfo->width,
+		textureCreateInfo->height,
+		textureCreateInfo->depth,
+		textureCreateInfo->isCube,
+		textureCreateInfo->levelCount,
+		isDepthFormat ?
+			textureCreateInfo->sampleCount : /* depth textures do not have a separate msaaTex */
+			REFRESH_SAMPLECOUNT_1,
+		format,
+		imageAspectFlags,
+		imageUsageFlags,
+		transient
+	);
+
+	/* create the MSAA texture for color attachments, if needed */
+	if (	vulkanTexture != NULL &&
+		!isDepthFormat &&
+		textureCreateInfo->sampleCount > REFRESH_SAMPLECOUNT_1	)
+	{
+		vulkanTexture->msaaTex = VULKAN_INTERNAL_CreateTexture(
+			renderer,
+			textureCreateInfo->width,
+			textureCreateInfo->height,
+			textureCreateInfo->depth,
+			textureCreateInfo->isCube,
+			textureCreateInfo->levelCount,
+			textureCreateInfo->sampleCount,
+			format,
+			imageAspectFlags,
+			multisampleUsageFlags,
+			transient
+		);
+	}
+
+	container = SDL_malloc(sizeof(VulkanTextureContainer));
+	container->vulkanTexture = vulkanTexture;
+	vulkanTexture->container = container;
+
+	return (Refresh_Texture*) container;
+}
+
+/* Greedy interval packing: biggest textures first, each at the lowest
+ * offset that doesn't collide with a placed texture whose lifetime overlaps.
+ * Returns the size of the memory block needed.
+ */
+static VkDeviceSize VULKAN_INTERNAL_PlaceAliasedTextures(
+	Refresh_AliasedTextureCreateInfo *createInfos,
+	VkMemoryRequirements2KHR *memoryRequirements,
+	uint32_t count,
+	VkDeviceSize *offsets
+) {
+	uint32_t *order = SDL_stack_alloc(uint32_t, count);
+	VkDeviceSize blockSize = 0;
+	VkDeviceSize size, placedEnd;
+	uint32_t i, j, current, placed;
+	uint8_t moved;
+
+	for (i = 0; i < count; i += 1)
+	{
+		order[i] = i;
+	}
+
+	/* there are only ever a handful of these, insertion sort is fine */
+	for (i = 1; i < count; i += 1)
+	{
+		current = order[i];
+		for (j = i; j > 0 && memoryRequirements[order[j - 1]].memoryRequirements.size < memoryRequirements[current].memoryRequirements.size; j -= 1)
+		{
+			order[j] = order[j - 1];
+		}
+		order[j] = current;
+	}
+
+	for (i = 0; i < count; i += 1)
+	{
+		current = order[i];
+		size = memoryRequirements[current].memoryRequirements.size;
+		offsets[current] = 0;
+
+		/* the offset only ever grows, so this terminates */
+		do
+		{
+			moved = 0;
+
+			for (j = 0; j < i; j += 1)
+			{
+				placed = order[j];
+				placedEnd = offsets[placed] + memoryRequirements[placed].memoryRequirements.size;
+
+				if (	createInfos[current].firstUse <= createInfos[placed].lastUse &&
+					createInfos[placed].firstUse <= createInfos[current].lastUse &&
+					offsets[current] < placedEnd &&
+					offsets[placed] < offsets[current] + size	)
+				{
+					offsets[current] = VULKAN_INTERNAL_NextHighestAlignment(
+						placedEnd,
+						memoryRequirements[current].memoryRequirements.alignment
+					);
+					moved = 1;
+				}
+			}
+		} while (moved);
+
+		blockSize = SDL_max(blockSize, offsets[current] + size);
+	}
+
+	SDL_stack_free(order);
+
+	return blockSize;
+}
+
+static void VULKAN_CreateAliasedTextures(
+	Refresh_Renderer *driverData,
+	Refresh_AliasedTextureCreateInfo *createInfos,
+	uint32_t createInfoCount,
+	Refresh_Texture **pTextures
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	Refresh_TextureCreateInfo *textureCreateInfo;
+	VkImageUsageFlags imageUsageFlags;
+	VkImageUsageFlags *multisampleUsageFlags;
+	VkImageAspectFlags imageAspectFlags;
+	VkFormat format;
+	VkImageMemoryRequirementsInfo2KHR imageRequirementsInfo;
+	VkMemoryRequirements2KHR *memoryRequirements;
+	VkDeviceSize *offsets;
+	VkDeviceSize blockSize;
+	VulkanTexture **textures;
+	VulkanTextureContainer *container;
+	VulkanMemorySubAllocator *allocator;
+	VulkanMemoryAllocation *allocation = NULL;
+	VulkanMemoryUsedRegion *usedRegion;
+	uint32_t memoryTypeBits = 0xFFFFFFFF;
+	uint32_t memoryTypeIndex = 0;
+	uint8_t isDepthFormat;
+	uint8_t isRenderTarget;
+	uint32_t i;
 
-	VkDescriptorSet descriptorSets[4];
-	uint32_t dynamicOffsets[2];
+	if (createInfoCount == 0)
+	{
+		return;
+	}
 
-	descriptorSets[0] = vulkanCommandBuffer->vertexSamplerDescriptorSet;
-	descriptorSets[1] = vulkanCommandBuffer->fragmentSamplerDescriptorSet;
-	descriptorSets[2] = vulkanCommandBuffer->vertexUniformBuffer->descriptorSet;
-	descriptorSets[3] = vulkanCommandBuffer->fragmentUniformBuffer->descriptorSet;
+	for (i = 0; i < createInfoCount; i += 1)
+	{
+		if (VULKAN_INTERNAL_YCbCrFormatIndex(RefreshToVK_SurfaceFormat[createInfos[i].textureCreateInfo.format]) >= 0)
+		{
+			Refresh_LogError("Multi-planar textures cannot be aliased!");
+			SDL_memset(pTextures, '\0', sizeof(Refresh_Texture*) * createInfoCount);
+			return;
+		}
+	}
 
-	dynamicOffsets[0] = vertexParamOffset;
-	dynamicOffsets[1] = fragmentParamOffset;
+	textures = SDL_malloc(sizeof(VulkanTexture*) * createInfoCount);
+	memoryRequirements = SDL_malloc(sizeof(VkMemoryRequirements2KHR) * createInfoCount);
+	offsets = SDL_malloc(sizeof(VkDeviceSize) * createInfoCount);
+	multisampleUsageFlags = SDL_malloc(sizeof(VkImageUsageFlags) * createInfoCount);
 
-	renderer->vkCmdBindDescriptorSets(
-		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,
-		vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->pipelineLayout,
+	for (i = 0; i < createInfoCount; i += 1)
+	{
+		textureCreateInfo = &createInfos[i].textureCreateInfo;
+		isDepthFormat = IsRefreshDepthFormat(textureCreateInfo->format);
+
+		VULKAN_INTERNAL_GetTextureCreateParameters(
+			renderer,
+			textureCreateInfo,
+			&format,
+			&imageUsageFlags,
+			&multisampleUsageFlags[i],
+			&imageAspectFlags
+		);
+
+		textures[i] = VULKAN_INTERNAL_CreateTextureImage(
+			renderer,
+			textureCreateInfo->width,
+			textureCreateInfo->height,
+			textureCreateInfo->depth,
+			textureCreateInfo->isCube,
+			textureCreateInfo->levelCount,
+			isDepthFormat ?
+				textureCreateInfo->sampleCount :
+				REFRESH_SAMPLECOUNT_1,
+			format,
+			imageAspectFlags,
+			imageUsageFlags
+		);
+
+		memoryRequirements[i].sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2_KHR;
+		memoryRequirements[i].pNext = NULL;
+		memoryRequirements[i].memoryRequirements.size = 0;
+		memoryRequirements[i].memoryRequirements.alignment = 1;
+
+		if (textures[i] == NULL)
+		{
+			continue;
+		}
+
+		imageRequirementsInfo.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2_KHR;
+		imageRequirementsInfo.pNext = NULL;
+		imageRequirementsInfo.image = textures[i]->image;
+
+		renderer->vkGetImageMemoryRequirements2KHR(
+			renderer->logicalDevice,
+			&imageRequirementsInfo,
+			&memoryRequirements[i]
+		);
+
+		memoryTypeBits &= memoryRequirements[i].memoryRequirements.memoryTypeBits;
+	}
+
+	/* Everything has to live in one device local memory type,
+	 * otherwise fall back to giving each texture its own memory.
+	 */
+	if (VULKAN_INTERNAL_FindMemoryType(
+		renderer,
+		memoryTypeBits,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
 		0,
-		4,
-		descriptorSets,
-		2,
-		dynamicOffsets
-	);
+		&memoryTypeIndex
+	)) {
+		blockSize = VULKAN_INTERNAL_PlaceAliasedTextures(
+			createInfos,
+			memoryRequirements,
+			createInfoCount,
+			offsets
+		);
 
-	renderer->vkCmdDrawIndexed(
-		vulkanCommandBuffer->commandBuffer,
-		PrimitiveVerts(
-			vulkanCommandBuffer->currentGraphicsPipeline->primitiveType,
-			primitiveCount
-		),
-		instanceCount,
-		startIndex,
-		baseVertex,
-		0
-	);
-}
+		allocator = &renderer->memoryAllocator->subAllocators[memoryTypeIndex];
 
-static void VULKAN_DrawIndexedPrimitives(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	uint32_t baseVertex,
-	uint32_t startIndex,
-	uint32_t primitiveCount,
-	uint32_t vertexParamOffset,
-	uint32_t fragmentParamOffset
-) {
-	VULKAN_DrawInstancedPrimitives(
-		driverData,
-		commandBuffer,
-		baseVertex,
-		startIndex,
-		primitiveCount,
-		1,
-		vertexParamOffset,
-		fragmentParamOffset
-	);
+		SDL_LockMutex(allocator->lock);
+
+		/* dedicated, so defrag and the free lists leave it alone */
+		if (VULKAN_INTERNAL_AllocateMemory(
+			renderer,
+			VK_NULL_HANDLE,
+			VK_NULL_HANDLE,
+			memoryTypeIndex,
+			blockSize,
+			1,
+			0,
+			&allocation
+		)) {
+			VULKAN_INTERNAL_RemoveMemoryFreeRegion(renderer, allocation->freeRegions[0]);
+			allocation->aliased = 1;
+		}
+		else
+		{
+			allocation = NULL;
+		}
+
+		SDL_UnlockMutex(allocator->lock);
+	}
+
+	if (allocation == NULL)
+	{
+		Refresh_LogWarn("Could not allocate aliased texture memory, textures will not share memory");
+	}
+
+	for (i = 0; i < createInfoCount; i += 1)
+	{
+		textureCreateInfo = &createInfos[i].textureCreateInfo;
+		pTextures[i] = NULL;
+
+		if (textures[i] == NULL)
+		{
+			Refresh_LogError("Failed to create aliased texture!");
+			continue;
+		}
+
+		if (allocation != NULL)
+		{
+			usedRegion = SDL_malloc(sizeof(VulkanMemoryUsedRegion));
+			usedRegion->allocation = allocation;
+			usedRegion->offset = offsets[i];
+			usedRegion->size = memoryRequirements[i].memoryRequirements.size;
+			usedRegion->resourceOffset = offsets[i];
+			usedRegion->resourceSize = memoryRequirements[i].memoryRequirements.size;
+			usedRegion->alignment = memoryRequirements[i].memoryRequirements.alignment;
+			usedRegion->defragMoved = 0;
+			usedRegion->isBuffer = 0;
+
+			SDL_LockMutex(allocation->allocator->lock);
+			allocation->usedSpace += usedRegion->size;
+			allocation->usedRegionCount += 1;
+			SDL_UnlockMutex(allocation->allocator->lock);
+
+			textures[i]->usedRegion = usedRegion;
+
+			if (!VULKAN_INTERNAL_BindImageMemory(
+				renderer,
+				usedRegion,
+				offsets[i],
+				textures[i]->image
+			)) {
+				VULKAN_INTERNAL_RemoveMemoryUsedRegion(renderer, usedRegion);
+				renderer->vkDestroyImage(renderer->logicalDevice, textures[i]->image, NULL);
+				SDL_free(textures[i]->subresourceAccessTypes);
+				SDL_free(textures[i]);
+				continue;
+			}
+		}
+		else
+		{
+			isRenderTarget =
+				(textures[i]->usageFlags & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)) != 0;
+
+			if (VULKAN_INTERNAL_BindMemoryForImage(
+				renderer,
+				textures[i]->image,
+				isRenderTarget,
+				0,
+				(textures[i]->usageFlags & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) != 0,
+				&textures[i]->usedRegion
+			) != 1) {
+				Refresh_LogError("Unable to bind memory for texture!");
+				renderer->vkDestroyImage(renderer->logicalDevice, textures[i]->image, NULL);
+				SDL_free(textures[i]->subresourceAccessTypes);
+				SDL_free(textures[i]);
+				continue;
+			}
+		}
+
+		textures[i]->usedRegion->vulkanTexture = textures[i];
+
+		/* Memory is bound from here on, so DestroyTexture can undo everything */
+		if (!VULKAN_INTERNAL_CreateTextureView(renderer, textures[i]))
+		{
+			Refresh_LogError("Failed to create aliased texture view!");
+			VULKAN_INTERNAL_DestroyTexture(renderer, textures[i]);
+			continue;
+		}
+
+		/* the multisample companion only lives inside render passes, give it its own memory */
+		if (	!IsRefreshDepthFormat(textureCreateInfo->format) &&
+			textureCreateInfo->sampleCount > REFRESH_SAMPLECOUNT_1	)
+		{
+			textures[i]->msaaTex = VULKAN_INTERNAL_CreateTexture(
+				renderer,
+				textureCreateInfo->width,
+				textureCreateInfo->height,
+				textureCreateInfo->depth,
+				textureCreateInfo->isCube,
+				textureCreateInfo->levelCount,
+				textureCreateInfo->sampleCount,
+				textures[i]->format,
+				textures[i]->aspectFlags,
+				multisampleUsageFlags[i],
+				0
+			);
+
+			if (textures[i]->msaaTex == NULL)
+			{
+				Refresh_LogError("Failed to create aliased texture multisample image!");
+				VULKAN_INTERNAL_DestroyTexture(renderer, textures[i]);
+				continue;
+			}
+		}
+
+		container = SDL_malloc(sizeof(VulkanTextureContainer));
+		container->vulkanTexture = textures[i];
+		textures[i]->container = container;
+
+		pTextures[i] = (Refresh_Texture*) container;
+	}
+
+	SDL_free(textures);
+	SDL_free(memoryRequirements);
+	SDL_free(offsets);
+	SDL_free(multisampleUsageFlags);
 }
 
-static void VULKAN_DrawPrimitives(
+static Refresh_Buffer* VULKAN_CreateBuffer(
 	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	uint32_t vertexStart,
-	uint32_t primitiveCount,
-	uint32_t vertexParamOffset,
-	uint32_t fragmentParamOffset
+	Refresh_BufferUsageFlags usageFlags,
+	uint32_t sizeInBytes
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanResourceAccessType resourceAccessType;
+	VkBufferUsageFlags vulkanUsageFlags =
+		VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
-	VkDescriptorSet descriptorSets[4];
-	uint32_t dynamicOffsets[2];
+	if ((usageFlags & ~(REFRESH_BUFFERUSAGE_TRANSIENT_BIT | REFRESH_BUFFERUSAGE_SUBALLOCATE_BIT | REFRESH_BUFFERUSAGE_DYNAMIC_BIT | REFRESH_BUFFERUSAGE_READBACK_BIT)) == 0)
+	{
+		resourceAccessType = RESOURCE_ACCESS_TRANSFER_READ_WRITE;
+	}
 
-	descriptorSets[0] = vulkanCommandBuffer->vertexSamplerDescriptorSet;
-	descriptorSets[1] = vulkanCommandBuffer->fragmentSamplerDescriptorSet;
-	descriptorSets[2] = vulkanCommandBuffer->vertexUniformBuffer->descriptorSet;
-	descriptorSets[3] = vulkanCommandBuffer->fragmentUniformBuffer->descriptorSet;
+	if (usageFlags & REFRESH_BUFFERUSAGE_VERTEX_BIT)
+	{
+		vulkanUsageFlags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+		resourceAccessType = RESOURCE_ACCESS_VERTEX_BUFFER;
+	}
 
-	dynamicOffsets[0] = vertexParamOffset;
-	dynamicOffsets[1] = fragmentParamOffset;
+	if (usageFlags & REFRESH_BUFFERUSAGE_INDEX_BIT)
+	{
+		vulkanUsageFlags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+		resourceAccessType = RESOURCE_ACCESS_INDEX_BUFFER;
+	}
 
-	renderer->vkCmdBindDescriptorSets(
-		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,
-		vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->pipelineLayout,
-		0,
-		4,
-		descriptorSets,
-		2,
-		dynamicOffsets
-	);
+	if (usageFlags & REFRESH_BUFFERUSAGE_COMPUTE_BIT)
+	{
+		vulkanUsageFlags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+		resourceAccessType = RESOURCE_ACCESS_COMPUTE_SHADER_BUFFER_READ_WRITE;
+	}
 
-	renderer->vkCmdDraw(
-		vulkanCommandBuffer->commandBuffer,
-		PrimitiveVerts(
-			vulkanCommandBuffer->currentGraphicsPipeline->primitiveType,
-			primitiveCount
-		),
-		1,
-		vertexStart,
-		0
+	if (usageFlags & REFRESH_BUFFERUSAGE_INDIRECT_BIT)
+	{
+		vulkanUsageFlags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+		resourceAccessType = RESOURCE_ACCESS_INDIRECT_BUFFER;
+	}
+
+	return (Refresh_Buffer*) VULKAN_INTERNAL_CreateBufferContainer(
+		(VulkanRenderer*) driverData,
+		sizeInBytes,
+		resourceAccessType,
+		vulkanUsageFlags,
+		(usageFlags & REFRESH_BUFFERUSAGE_TRANSIENT_BIT) != 0,
+		(usageFlags & REFRESH_BUFFERUSAGE_SUBALLOCATE_BIT) != 0,
+		(usageFlags & REFRESH_BUFFERUSAGE_DYNAMIC_BIT) != 0,
+		(usageFlags & REFRESH_BUFFERUSAGE_READBACK_BIT) != 0
 	);
 }
 
-static void VULKAN_DrawPrimitivesIndirect(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Buffer *buffer,
-	uint32_t offsetInBytes,
-	uint32_t drawCount,
-	uint32_t stride,
-	uint32_t vertexParamOffset,
-	uint32_t fragmentParamOffset
+/* Setters */
+
+static void VULKAN_INTERNAL_RetireUploadRingRanges(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
-	VkDescriptorSet descriptorSets[4];
-	uint32_t dynamicOffsets[2];
+	VulkanUploadRing *ring = &renderer->uploadRing;
+	VulkanUploadRingRange *range;
+	uint32_t i;
 
-	descriptorSets[0] = vulkanCommandBuffer->vertexSamplerDescriptorSet;
-	descriptorSets[1] = vulkanCommandBuffer->fragmentSamplerDescriptorSet;
-	descriptorSets[2] = vulkanCommandBuffer->vertexUniformBuffer->descriptorSet;
-	descriptorSets[3] = vulkanCommandBuffer->fragmentUniformBuffer->descriptorSet;
+	/* Caller must hold the ring lock */
+
+	if (commandBuffer != NULL)
+	{
+		for (i = 0; i < ring->rangeCount; i += 1)
+		{
+			range = &ring->ranges[(ring->rangeStart + i) % ring->rangeCapacity];
+
+			if (range->commandBuffer == commandBuffer)
+			{
+				range->commandBuffer = NULL;
+			}
+		}
+	}
+
+	while (ring->rangeCount > 0)
+	{
+		range = &ring->ranges[ring->rangeStart];
+
+		if (range->commandBuffer != NULL)
+		{
+			break;
+		}
+
+		ring->tail = range->end;
+		ring->rangeStart = (ring->rangeStart + 1) % ring->rangeCapacity;
+		ring->rangeCount -= 1;
+	}
 
-	dynamicOffsets[0] = vertexParamOffset;
-	dynamicOffsets[1] = fragmentParamOffset;
+	/* Resizes are deferred until nothing references the old buffer */
 
-	renderer->vkCmdBindDescriptorSets(
-		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,
-		vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->pipelineLayout,
-		0,
-		4,
-		descriptorSets,
-		2,
-		dynamicOffsets
-	);
+	if (ring->rangeCount == 0 && ring->requestedSize != ring->size)
+	{
+		if (ring->buffer != NULL)
+		{
+			VULKAN_INTERNAL_QueueDestroyBuffer(renderer, ring->buffer);
+			ring->buffer = NULL;
+		}
 
-	renderer->vkCmdDrawIndirect(
-		vulkanCommandBuffer->commandBuffer,
-		vulkanBuffer->buffer,
-		offsetInBytes,
-		drawCount,
-		stride
-	);
+		ring->size = 0;
+		ring->head = 0;
+		ring->tail = 0;
 
-	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
+		if (ring->requestedSize > 0)
+		{
+			ring->buffer = VULKAN_INTERNAL_CreateBuffer(
+				renderer,
+				ring->requestedSize,
+				RESOURCE_ACCESS_TRANSFER_READ,
+				VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				1,
+				0,
+				0,
+				1,
+				0
+			);
+
+			if (ring->buffer == NULL)
+			{
+				Refresh_LogWarn("Failed to allocate upload ring, falling back to transfer buffers");
+				ring->requestedSize = 0;
+			}
+			else
+			{
+				ring->size = ring->requestedSize;
+			}
+		}
+	}
 }
 
-static void VULKAN_DispatchCompute(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	uint32_t groupCountX,
-	uint32_t groupCountY,
-	uint32_t groupCountZ,
-	uint32_t computeParamOffset
+static VulkanTransferBuffer* VULKAN_INTERNAL_AcquireUploadRingSpace(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VkDeviceSize requiredSize,
+	VkDeviceSize alignment
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
-	VkDescriptorSet descriptorSets[3];
-	VulkanResourceAccessType resourceAccessType = RESOURCE_ACCESS_NONE;
-	VulkanBuffer *currentComputeBuffer;
-	VulkanTexture *currentComputeTexture;
-	uint32_t i;
+	VulkanUploadRing *ring = &renderer->uploadRing;
+	VulkanUploadRingRange *range;
+	uint64_t start;
+	uint64_t end;
+	VkResult fenceStatus;
 
-	descriptorSets[0] = vulkanCommandBuffer->bufferDescriptorSet;
-	descriptorSets[1] = vulkanCommandBuffer->imageDescriptorSet;
-	descriptorSets[2] = vulkanCommandBuffer->computeUniformBuffer->descriptorSet;
+	SDL_LockMutex(ring->lock);
 
-	renderer->vkCmdBindDescriptorSets(
-		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_COMPUTE,
-		computePipeline->pipelineLayout->pipelineLayout,
-		0,
-		3,
-		descriptorSets,
-		1,
-		&computeParamOffset
-	);
+	if (ring->buffer == NULL || requiredSize > ring->size)
+	{
+		SDL_UnlockMutex(ring->lock);
+		return NULL;
+	}
 
-	renderer->vkCmdDispatch(
-		vulkanCommandBuffer->commandBuffer,
-		groupCountX,
-		groupCountY,
-		groupCountZ
-	);
+	start = ring->head + alignment - 1;
+	start -= start % alignment;
 
-	/* Re-transition buffers after dispatch */
-	for (i = 0; i < vulkanCommandBuffer->boundComputeBufferCount; i += 1)
+	/* Allocations never straddle the end of the buffer */
+
+	if ((start % ring->size) + requiredSize > ring->size)
 	{
-		currentComputeBuffer = vulkanCommandBuffer->boundComputeBuffers[i];
+		start += ring->size - (start % ring->size);
+	}
 
-		if (currentComputeBuffer->usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+	end = start + requiredSize;
+
+	/* Reclaim completed work, oldest first. We never block the
+	 * recording thread here: if the oldest range is still in flight
+	 * the caller falls back to a transfer buffer instead.
+	 */
+
+	while (end - ring->tail > ring->size)
+	{
+		if (ring->rangeCount == 0)
 		{
-			resourceAccessType = RESOURCE_ACCESS_VERTEX_BUFFER;
+			/* Nothing is in flight, only skipped space remains */
+			ring->tail = start;
+			continue;
 		}
-		else if (currentComputeBuffer->usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+
+		range = &ring->ranges[ring->rangeStart];
+
+		if (range->commandBuffer != NULL)
 		{
-			resourceAccessType = RESOURCE_ACCESS_INDEX_BUFFER;
+			if (range->fence == VK_NULL_HANDLE)
+			{
+				SDL_UnlockMutex(ring->lock);
+				return NULL;
+			}
+
+			fenceStatus = renderer->vkGetFenceStatus(
+				renderer->logicalDevice,
+				range->fence
+			);
+
+			if (fenceStatus != VK_SUCCESS)
+			{
+				SDL_UnlockMutex(ring->lock);
+				return NULL;
+			}
 		}
-		else if (currentComputeBuffer->usage & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT)
+
+		ring->tail = range->end;
+		ring->rangeStart = (ring->rangeStart + 1) % ring->rangeCapacity;
+		ring->rangeCount -= 1;
+	}
+
+	/* Consecutive uploads from one command buffer share a range */
+
+	range = NULL;
+
+	if (ring->rangeCount > 0)
+	{
+		range = &ring->ranges[(ring->rangeStart + ring->rangeCount - 1) % ring->rangeCapacity];
+
+		if (range->commandBuffer != commandBuffer || range->fence != VK_NULL_HANDLE)
 		{
-			resourceAccessType = RESOURCE_ACCESS_INDIRECT_BUFFER;
+			range = NULL;
 		}
+	}
 
-		if (resourceAccessType != RESOURCE_ACCESS_NONE)
+	if (range == NULL)
+	{
+		if (ring->rangeCount == ring->rangeCapacity)
 		{
-			VULKAN_INTERNAL_BufferMemoryBarrier(
-				renderer,
-				vulkanCommandBuffer->commandBuffer,
-				resourceAccessType,
-				currentComputeBuffer
+			ring->ranges = SDL_realloc(
+				ring->ranges,
+				ring->rangeCapacity * 2 * sizeof(VulkanUploadRingRange)
+			);
+
+			/* Unwrap the entries that sat before the old end */
+			SDL_memcpy(
+				ring->ranges + ring->rangeCapacity,
+				ring->ranges,
+				ring->rangeStart * sizeof(VulkanUploadRingRange)
 			);
+
+			ring->rangeCapacity *= 2;
 		}
+
+		range = &ring->ranges[(ring->rangeStart + ring->rangeCount) % ring->rangeCapacity];
+		range->commandBuffer = commandBuffer;
+		range->fence = VK_NULL_HANDLE;
+		ring->rangeCount += 1;
 	}
 
-	vulkanCommandBuffer->boundComputeBufferCount = 0;
+	range->end = end;
+	ring->head = end;
 
-	/* Re-transition sampler images after dispatch */
-	for (i = 0; i < vulkanCommandBuffer->boundComputeTextureCount; i += 1)
+	commandBuffer->uploadRingTransferBuffer.buffer = ring->buffer;
+	commandBuffer->uploadRingTransferBuffer.offset = start % ring->size;
+	commandBuffer->usedUploadRing = 1;
+
+	SDL_UnlockMutex(ring->lock);
+
+	return &commandBuffer->uploadRingTransferBuffer;
+}
+
+/* Mapped upload memory is usually write-combined. Large copies into it
+ * bypass the cache with non-temporal stores so they neither pollute it
+ * nor read the destination lines back in.
+ */
+static void VULKAN_INTERNAL_CopyToMappedMemory(
+	uint8_t *dst,
+	const uint8_t *src,
+	size_t size
+) {
+#ifdef VULKAN_STREAMING_COPY
+	__m128i a, b, c, d;
+	size_t head;
+
+	if (size >= STREAMING_COPY_THRESHOLD)
 	{
-		currentComputeTexture = vulkanCommandBuffer->boundComputeTextures[i];
+		head = (16 - ((uintptr_t) dst & 15)) & 15;
+		SDL_memcpy(dst, src, head);
+		dst += head;
+		src += head;
+		size -= head;
 
-		if (currentComputeTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+		while (size >= 64)
 		{
-			resourceAccessType = RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE;
-
-			VULKAN_INTERNAL_ImageMemoryBarrier(
-				renderer,
-				vulkanCommandBuffer->commandBuffer,
-				resourceAccessType,
-				currentComputeTexture->aspectFlags,
-				0,
-				currentComputeTexture->layerCount,
-				0,
-				currentComputeTexture->levelCount,
-				0,
-				currentComputeTexture->image,
-				&currentComputeTexture->resourceAccessType
-			);
+			a = _mm_loadu_si128((const __m128i*) (src + 0));
+			b = _mm_loadu_si128((const __m128i*) (src + 16));
+			c = _mm_loadu_si128((const __m128i*) (src + 32));
+			d = _mm_loadu_si128((const __m128i*) (src + 48));
+			_mm_stream_si128((__m128i*) (dst + 0), a);
+			_mm_stream_si128((__m128i*) (dst + 16), b);
+			_mm_stream_si128((__m128i*) (dst + 32), c);
+			_mm_stream_si128((__m128i*) (dst + 48), d);
+
+			dst += 64;
+			src += 64;
+			size -= 64;
 		}
+
+		/* Streaming stores are weakly ordered */
+		_mm_sfence();
 	}
+#endif
 
-	vulkanCommandBuffer->boundComputeTextureCount = 0;
+	SDL_memcpy(dst, src, size);
 }
 
-static VulkanTexture* VULKAN_INTERNAL_CreateTexture(
+static VulkanTransferBuffer* VULKAN_INTERNAL_AcquireTransferBuffer(
 	VulkanRenderer *renderer,
-	uint32_t width,
-	uint32_t height,
-	uint32_t depth,
-	uint32_t isCube,
-	uint32_t levelCount,
-	Refresh_SampleCount sampleCount,
-	VkFormat format,
-	VkImageAspectFlags aspectMask,
-	VkImageUsageFlags imageUsageFlags
+	VulkanCommandBuffer *commandBuffer,
+	VkDeviceSize requiredSize,
+	VkDeviceSize alignment
 ) {
-	VkResult vulkanResult;
-	VkImageCreateInfo imageCreateInfo;
-	VkImageCreateFlags imageCreateFlags = 0;
-	VkImageViewCreateInfo imageViewCreateInfo;
-	uint8_t bindResult;
-	uint8_t is3D = depth > 1 ? 1 : 0;
-	uint8_t layerCount = isCube ? 6 : 1;
-	uint8_t isRenderTarget =
-		((imageUsageFlags & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) != 0) ||
-		((imageUsageFlags & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0);
-	VkComponentMapping swizzle = IDENTITY_SWIZZLE;
+	VkDeviceSize size;
+	VkDeviceSize offset;
+	uint32_t i;
+	VulkanTransferBuffer *transferBuffer;
 
-	VulkanTexture *texture = SDL_malloc(sizeof(VulkanTexture));
+	/* The upload ring is the fast path */
 
-	texture->isCube = 0;
-	texture->is3D = 0;
+	transferBuffer = VULKAN_INTERNAL_AcquireUploadRingSpace(
+		renderer,
+		commandBuffer,
+		requiredSize,
+		alignment
+	);
 
-	if (isCube)
+	if (transferBuffer != NULL)
 	{
-		imageCreateFlags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
-		texture->isCube = 1;
+		return transferBuffer;
 	}
-	else if (is3D)
+
+	/* Search the command buffer's current transfer buffers */
+
+	for (i = 0; i < commandBuffer->transferBufferCount; i += 1)
 	{
-		imageCreateFlags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
-		texture->is3D = 1;
+		transferBuffer = commandBuffer->transferBuffers[i];
+		offset = transferBuffer->offset + alignment - (transferBuffer->offset % alignment);
+
+		if (offset + requiredSize <= transferBuffer->buffer->size)
+		{
+			transferBuffer->offset = offset;
+			return transferBuffer;
+		}
 	}
 
-	imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-	imageCreateInfo.pNext = NULL;
-	imageCreateInfo.flags = imageCreateFlags;
-	imageCreateInfo.imageType = is3D ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
-	imageCreateInfo.format = format;
-	imageCreateInfo.extent.width = width;
-	imageCreateInfo.extent.height = height;
-	imageCreateInfo.extent.depth = depth;
-	imageCreateInfo.mipLevels = levelCount;
-	imageCreateInfo.arrayLayers = layerCount;
-	imageCreateInfo.samples = RefreshToVK_SampleCount[sampleCount];
-	imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-	imageCreateInfo.usage = imageUsageFlags;
-	imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-	imageCreateInfo.queueFamilyIndexCount = 0;
-	imageCreateInfo.pQueueFamilyIndices = NULL;
-	imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	/* Nothing fits, can we get a transfer buffer from the pool? */
+
+	SDL_LockMutex(renderer->transferBufferPool.lock);
+
+	for (i = 0; i < renderer->transferBufferPool.availableBufferCount; i += 1)
+	{
+		transferBuffer = renderer->transferBufferPool.availableBuffers[i];
+		offset = transferBuffer->offset + alignment - (transferBuffer->offset % alignment);
+
+		if (offset + requiredSize <= transferBuffer->buffer->size)
+		{
+			if (commandBuffer->transferBufferCount == commandBuffer->transferBufferCapacity)
+			{
+				commandBuffer->transferBufferCapacity *= 2;
+				commandBuffer->transferBuffers = SDL_realloc(
+					commandBuffer->transferBuffers,
+					commandBuffer->transferBufferCapacity * sizeof(VulkanTransferBuffer*)
+				);
+			}
+
+			commandBuffer->transferBuffers[commandBuffer->transferBufferCount] = transferBuffer;
+			commandBuffer->transferBufferCount += 1;
+
+			renderer->transferBufferPool.availableBuffers[i] = renderer->transferBufferPool.availableBuffers[renderer->transferBufferPool.availableBufferCount - 1];
+			renderer->transferBufferPool.availableBufferCount -= 1;
+			SDL_UnlockMutex(renderer->transferBufferPool.lock);
+
+			transferBuffer->offset = offset;
+			return transferBuffer;
+		}
+	}
+
+	SDL_UnlockMutex(renderer->transferBufferPool.lock);
+
+	/* Nothing fits, so let's create a new transfer buffer */
+
+	size = TRANSFER_BUFFER_STARTING_SIZE;
 
-	vulkanResult = renderer->vkCreateImage(
-		renderer->logicalDevice,
-		&imageCreateInfo,
-		NULL,
-		&texture->image
-	);
-	VULKAN_ERROR_CHECK(vulkanResult, vkCreateImage, 0)
+	while (size < requiredSize)
+	{
+		size *= 2;
+	}
 
-	bindResult = VULKAN_INTERNAL_BindMemoryForImage(
+	transferBuffer = SDL_malloc(sizeof(VulkanTransferBuffer));
+	transferBuffer->offset = 0;
+	transferBuffer->buffer = VULKAN_INTERNAL_CreateBuffer(
 		renderer,
-		texture->image,
-		isRenderTarget,
-		&texture->usedRegion
+		size,
+		RESOURCE_ACCESS_TRANSFER_READ_WRITE,
+		VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		1,
+		0,
+		0,
+		1,
+		0
 	);
+	transferBuffer->fromPool = 0;
 
-	if (bindResult != 1)
+	if (transferBuffer->buffer == NULL)
 	{
-		renderer->vkDestroyImage(
-			renderer->logicalDevice,
-			texture->image,
-			NULL);
-
-		Refresh_LogError("Unable to bind memory for texture!");
+		Refresh_LogError("Failed to allocate transfer buffer!");
+		SDL_free(transferBuffer);
 		return NULL;
 	}
 
-	texture->usedRegion->vulkanTexture = texture; /* lol */
+	if (commandBuffer->transferBufferCount == commandBuffer->transferBufferCapacity)
+	{
+		commandBuffer->transferBufferCapacity *= 2;
+		commandBuffer->transferBuffers = SDL_realloc(
+			commandBuffer->transferBuffers,
+			commandBuffer->transferBufferCapacity * sizeof(VulkanTransferBuffer*)
+		);
+	}
 
-	imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-	imageViewCreateInfo.pNext = NULL;
-	imageViewCreateInfo.flags = 0;
-	imageViewCreateInfo.image = texture->image;
-	imageViewCreateInfo.format = format;
-	imageViewCreateInfo.components = swizzle;
-	imageViewCreateInfo.subresourceRange.aspectMask = aspectMask;
-	imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
-	imageViewCreateInfo.subresourceRange.levelCount = levelCount;
-	imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
-	imageViewCreateInfo.subresourceRange.layerCount = layerCount;
+	commandBuffer->transferBuffers[commandBuffer->transferBufferCount] = transferBuffer;
+	commandBuffer->transferBufferCount += 1;
 
-	if (isCube)
+	return transferBuffer;
+}
+
+/* All slices must belong to the same texture. They share one copy command
+ * and one transition in and out of the transfer layout, covering only the
+ * layers and levels the slices touch.
+ */
+static void VULKAN_INTERNAL_CopyStagingToTexture(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VulkanBuffer *stagingBuffer,
+	VkDeviceSize *stagingOffsets,
+	uint32_t *stagingRowLengths, /* can be NULL if every slice is tightly packed */
+	Refresh_TextureSlice *textureSlices,
+	uint32_t sliceCount
+) {
+	VulkanTexture *vulkanTexture = ((VulkanTextureContainer*) textureSlices[0].texture)->vulkanTexture;
+	VkBufferImageCopy *imageCopies = SDL_stack_alloc(VkBufferImageCopy, sliceCount);
+	uint32_t blockSize = VULKAN_INTERNAL_TextureBlockSize(vulkanTexture->format);
+	uint32_t minLayer = textureSlices[0].layer;
+	uint32_t maxLayer = textureSlices[0].layer;
+	uint32_t minLevel = textureSlices[0].level;
+	uint32_t maxLevel = textureSlices[0].level;
+	uint32_t i;
+
+	for (i = 1; i < sliceCount; i += 1)
 	{
-		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_CUBE;
+		minLayer = SDL_min(minLayer, textureSlices[i].layer);
+		maxLayer = SDL_max(maxLayer, textureSlices[i].layer);
+		minLevel = SDL_min(minLevel, textureSlices[i].level);
+		maxLevel = SDL_max(maxLevel, textureSlices[i].level);
 	}
-	else if (is3D)
+
+	if (VULKAN_INTERNAL_IsAsyncTransfer(renderer, commandBuffer))
 	{
-		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_3D;
+		VULKAN_INTERNAL_BeginTransferQueueTextureWrite(
+			renderer,
+			commandBuffer,
+			vulkanTexture
+		);
 	}
 	else
 	{
-		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			commandBuffer->commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_WRITE,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			minLayer,
+			maxLayer - minLayer + 1,
+			minLevel,
+			maxLevel - minLevel + 1,
+			0,
+			vulkanTexture
+		);
 	}
 
-	vulkanResult = renderer->vkCreateImageView(
-		renderer->logicalDevice,
-		&imageViewCreateInfo,
-		NULL,
-		&texture->view
+	for (i = 0; i < sliceCount; i += 1)
+	{
+		imageCopies[i].imageExtent.width = textureSlices[i].rectangle.w;
+		imageCopies[i].imageExtent.height = textureSlices[i].rectangle.h;
+		imageCopies[i].imageExtent.depth = 1;
+		imageCopies[i].imageOffset.x = textureSlices[i].rectangle.x;
+		imageCopies[i].imageOffset.y = textureSlices[i].rectangle.y;
+		imageCopies[i].imageOffset.z = textureSlices[i].depth;
+		imageCopies[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		imageCopies[i].imageSubresource.baseArrayLayer = textureSlices[i].layer;
+		imageCopies[i].imageSubresource.layerCount = 1;
+		imageCopies[i].imageSubresource.mipLevel = textureSlices[i].level;
+		imageCopies[i].bufferOffset = stagingOffsets[i];
+		imageCopies[i].bufferRowLength = SDL_max(blockSize, textureSlices[i].rectangle.w);
+		if (stagingRowLengths != NULL && stagingRowLengths[i] != 0)
+		{
+			imageCopies[i].bufferRowLength = stagingRowLengths[i];
+		}
+		imageCopies[i].bufferImageHeight = SDL_max(blockSize, textureSlices[i].rectangle.h);
+	}
+
+	renderer->vkCmdCopyBufferToImage(
+		commandBuffer->commandBuffer,
+		stagingBuffer->buffer,
+		vulkanTexture->image,
+		AccessMap[RESOURCE_ACCESS_TRANSFER_WRITE].imageLayout,
+		sliceCount,
+		imageCopies
 	);
 
-	if (vulkanResult != VK_SUCCESS)
+	SDL_stack_free(imageCopies);
+
+	/* Async transfers are made readable when handed to the graphics queue */
+	if (	!VULKAN_INTERNAL_IsAsyncTransfer(renderer, commandBuffer) &&
+		(vulkanTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)	)
 	{
-		LogVulkanResultAsError("vkCreateImageView", vulkanResult);
-		Refresh_LogError("Failed to create texture image view");
-		return NULL;
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			commandBuffer->commandBuffer,
+			RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			minLayer,
+			maxLayer - minLayer + 1,
+			minLevel,
+			maxLevel - minLevel + 1,
+			0,
+			vulkanTexture
+		);
 	}
 
-	texture->dimensions.width = width;
-	texture->dimensions.height = height;
-	texture->depth = depth;
-	texture->format = format;
-	texture->levelCount = levelCount;
-	texture->layerCount = layerCount;
-	texture->sampleCount = sampleCount;
-	texture->resourceAccessType = RESOURCE_ACCESS_NONE;
-	texture->usageFlags = imageUsageFlags;
-	texture->aspectFlags = aspectMask;
-	texture->msaaTex = NULL;
+	VULKAN_INTERNAL_TrackTexture(renderer, commandBuffer, vulkanTexture);
+}
 
-	SDL_AtomicSet(&texture->referenceCount, 0);
+static void VULKAN_SetTextureData(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlice,
+	void *data,
+	uint32_t dataLengthInBytes
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanTexture *vulkanTexture = ((VulkanTextureContainer*) textureSlice->texture)->vulkanTexture;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanTransferBuffer *transferBuffer;
+	uint8_t *stagingBufferPointer;
 
-	return texture;
+	transferBuffer = VULKAN_INTERNAL_AcquireTransferBuffer(
+		renderer,
+		vulkanCommandBuffer,
+		VULKAN_INTERNAL_BytesPerImage(
+			textureSlice->rectangle.w,
+			textureSlice->rectangle.h,
+			vulkanTexture->format
+		),
+		VULKAN_INTERNAL_BytesPerPixel(vulkanTexture->format)
+	);
+
+	if (transferBuffer == NULL)
+	{
+		return;
+	}
+
+	stagingBufferPointer =
+		transferBuffer->buffer->usedRegion->allocation->mapPointer +
+		transferBuffer->buffer->usedRegion->resourceOffset +
+		transferBuffer->offset;
+
+	VULKAN_INTERNAL_CopyToMappedMemory(
+		stagingBufferPointer,
+		data,
+		dataLengthInBytes
+	);
+
+	VULKAN_INTERNAL_CopyStagingToTexture(
+		renderer,
+		vulkanCommandBuffer,
+		transferBuffer->buffer,
+		&transferBuffer->offset,
+		NULL,
+		textureSlice,
+		1
+	);
+
+	transferBuffer->offset += dataLengthInBytes;
 }
 
-static VulkanRenderTarget* VULKAN_INTERNAL_CreateRenderTarget(
-	VulkanRenderer *renderer,
-	VulkanTexture *texture,
-	uint32_t depth,
-	uint32_t layer,
-	uint32_t level
+static void VULKAN_SetTextureDataPitched(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlice,
+	void *data,
+	uint32_t dataLengthInBytes,
+	uint32_t sourceX,
+	uint32_t sourceY,
+	uint32_t rowPitchInBytes
 ) {
-	VkResult vulkanResult;
-	VulkanRenderTarget *renderTarget = (VulkanRenderTarget*) SDL_malloc(sizeof(VulkanRenderTarget));
-	VkImageViewCreateInfo imageViewCreateInfo;
-	VkComponentMapping swizzle = IDENTITY_SWIZZLE;
-	VkImageAspectFlags aspectFlags = 0;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanTexture *vulkanTexture = ((VulkanTextureContainer*) textureSlice->texture)->vulkanTexture;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanTransferBuffer *transferBuffer;
+	uint8_t *stagingBufferPointer;
+	uint8_t *sourcePointer;
+	uint32_t blockSize = VULKAN_INTERNAL_TextureBlockSize(vulkanTexture->format);
+	uint32_t bytesPerBlock = VULKAN_INTERNAL_BytesPerPixel(vulkanTexture->format);
+	uint32_t rowLengthInBytes, rowCount, row;
+	VkDeviceSize sourceOffset, sourceEnd;
 
-	if (IsDepthFormat(texture->format))
+	if (blockSize == 0 || bytesPerBlock == 0)
 	{
-		aspectFlags |= VK_IMAGE_ASPECT_DEPTH_BIT;
+		return;
+	}
 
-		if (IsStencilFormat(texture->format))
-		{
-			aspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
-		}
+	/* Rows of compressed formats are rows of blocks */
+	rowLengthInBytes = ((textureSlice->rectangle.w + blockSize - 1) / blockSize) * bytesPerBlock;
+	rowCount = (textureSlice->rectangle.h + blockSize - 1) / blockSize;
+
+	if (rowCount == 0)
+	{
+		return;
 	}
-	else
+
+	if (rowPitchInBytes < rowLengthInBytes)
 	{
-		aspectFlags |= VK_IMAGE_ASPECT_COLOR_BIT;
+		Refresh_LogError("Row pitch is smaller than the uploaded region!");
+		return;
 	}
 
-	/* create framebuffer compatible views for RenderTarget */
-	imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-	imageViewCreateInfo.pNext = NULL;
-	imageViewCreateInfo.flags = 0;
-	imageViewCreateInfo.image = texture->image;
-	imageViewCreateInfo.format = texture->format;
-	imageViewCreateInfo.components = swizzle;
-	imageViewCreateInfo.subresourceRange.aspectMask = aspectFlags;
-	imageViewCreateInfo.subresourceRange.baseMipLevel = level;
-	imageViewCreateInfo.subresourceRange.levelCount = 1;
-	imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
-	if (texture->is3D)
+	sourceOffset =
+		(VkDeviceSize) (sourceY / blockSize) * rowPitchInBytes +
+		(sourceX / blockSize) * bytesPerBlock;
+	sourceEnd = sourceOffset + (VkDeviceSize) (rowCount - 1) * rowPitchInBytes + rowLengthInBytes;
+
+	if (sourceEnd > dataLengthInBytes)
 	{
-		imageViewCreateInfo.subresourceRange.baseArrayLayer = depth;
+		Refresh_LogError("Uploaded region exceeds the client image data!");
+		return;
 	}
-	else if (texture->isCube)
+
+	transferBuffer = VULKAN_INTERNAL_AcquireTransferBuffer(
+		renderer,
+		vulkanCommandBuffer,
+		(VkDeviceSize) rowLengthInBytes * rowCount,
+		bytesPerBlock
+	);
+
+	if (transferBuffer == NULL)
 	{
-		imageViewCreateInfo.subresourceRange.baseArrayLayer = layer;
+		return;
 	}
-	imageViewCreateInfo.subresourceRange.layerCount = 1;
-	imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
 
-	vulkanResult = renderer->vkCreateImageView(
-		renderer->logicalDevice,
-		&imageViewCreateInfo,
+	stagingBufferPointer =
+		transferBuffer->buffer->usedRegion->allocation->mapPointer +
+		transferBuffer->buffer->usedRegion->resourceOffset +
+		transferBuffer->offset;
+
+	sourcePointer = (uint8_t*) data + sourceOffset;
+
+	/* The pitch is resolved while staging, so the copy command sees tightly packed rows */
+	if (rowPitchInBytes == rowLengthInBytes)
+	{
+		VULKAN_INTERNAL_CopyToMappedMemory(
+			stagingBufferPointer,
+			sourcePointer,
+			(size_t) rowLengthInBytes * rowCount
+		);
+	}
+	else
+	{
+		for (row = 0; row < rowCount; row += 1)
+		{
+			VULKAN_INTERNAL_CopyToMappedMemory(
+				stagingBufferPointer + (size_t) row * rowLengthInBytes,
+				sourcePointer + (size_t) row * rowPitchInBytes,
+				rowLengthInBytes
+			);
+		}
+	}
+
+	VULKAN_INTERNAL_CopyStagingToTexture(
+		renderer,
+		vulkanCommandBuffer,
+		transferBuffer->buffer,
+		&transferBuffer->offset,
 		NULL,
-		&renderTarget->view
+		textureSlice,
+		1
 	);
 
-	if (vulkanResult != VK_SUCCESS)
+	transferBuffer->offset += (VkDeviceSize) rowLengthInBytes * rowCount;
+}
+
+static void VULKAN_SetTextureDataBatch(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlices,
+	void **pData,
+	uint32_t *pDataLengthsInBytes,
+	uint32_t sliceCount
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanTexture *vulkanTexture;
+	VulkanTransferBuffer *transferBuffer;
+	VkDeviceSize *stagingOffsets;
+	VkDeviceSize alignment, runSize, offset;
+	uint8_t *stagingBufferPointer;
+	uint32_t runStart, runEnd, i;
+
+	if (sliceCount == 0)
 	{
-		LogVulkanResultAsError(
-			"vkCreateImageView",
-			vulkanResult
-		);
-		Refresh_LogError("Failed to create color attachment image view");
-		return NULL;
+		return;
 	}
 
-	return renderTarget;
-}
+	stagingOffsets = SDL_stack_alloc(VkDeviceSize, sliceCount);
 
-static VulkanRenderTarget* VULKAN_INTERNAL_FetchRenderTarget(
-	VulkanRenderer *renderer,
-	VulkanTexture *texture,
-	uint32_t depth,
-	uint32_t layer,
-	uint32_t level
-) {
-	RenderTargetHash hash;
-	VulkanRenderTarget *renderTarget;
+	for (runStart = 0; runStart < sliceCount; runStart = runEnd)
+	{
+		vulkanTexture = ((VulkanTextureContainer*) textureSlices[runStart].texture)->vulkanTexture;
+		alignment = VULKAN_INTERNAL_BytesPerPixel(vulkanTexture->format);
 
-	hash.texture = texture;
-	hash.depth = depth;
-	hash.layer = layer;
-	hash.level = level;
+		/* Consecutive slices of one texture are staged contiguously */
 
-	SDL_LockMutex(renderer->renderTargetFetchLock);
+		runSize = 0;
 
-	renderTarget = RenderTargetHash_Fetch(
-		&renderer->renderTargetHashArray,
-		&hash
-	);
+		for (runEnd = runStart; runEnd < sliceCount; runEnd += 1)
+		{
+			if (textureSlices[runEnd].texture != textureSlices[runStart].texture)
+			{
+				break;
+			}
 
-	if (renderTarget == NULL)
-	{
-		renderTarget = VULKAN_INTERNAL_CreateRenderTarget(
+			runSize += (pDataLengthsInBytes[runEnd] + alignment - 1) / alignment * alignment;
+		}
+
+		transferBuffer = VULKAN_INTERNAL_AcquireTransferBuffer(
 			renderer,
-			texture,
-			depth,
-			layer,
-			level
+			vulkanCommandBuffer,
+			runSize,
+			alignment
 		);
 
-		RenderTargetHash_Insert(
-			&renderer->renderTargetHashArray,
-			hash,
-			renderTarget
+		if (transferBuffer == NULL)
+		{
+			break;
+		}
+
+		stagingBufferPointer =
+			transferBuffer->buffer->usedRegion->allocation->mapPointer +
+			transferBuffer->buffer->usedRegion->resourceOffset;
+
+		offset = transferBuffer->offset;
+
+		for (i = runStart; i < runEnd; i += 1)
+		{
+			stagingOffsets[i] = offset;
+
+			VULKAN_INTERNAL_CopyToMappedMemory(
+				stagingBufferPointer + offset,
+				pData[i],
+				pDataLengthsInBytes[i]
+			);
+
+			offset += (pDataLengthsInBytes[i] + alignment - 1) / alignment * alignment;
+		}
+
+		VULKAN_INTERNAL_CopyStagingToTexture(
+			renderer,
+			vulkanCommandBuffer,
+			transferBuffer->buffer,
+			&stagingOffsets[runStart],
+			NULL,
+			&textureSlices[runStart],
+			runEnd - runStart
 		);
-	}
 
-	SDL_UnlockMutex(renderer->renderTargetFetchLock);
+		transferBuffer->offset = offset;
+	}
 
-	return renderTarget;
+	SDL_stack_free(stagingOffsets);
 }
 
-static VkRenderPass VULKAN_INTERNAL_CreateRenderPass(
+/* All planes go into the one image, so there is a single transition */
+static void VULKAN_INTERNAL_SetYCbCrTextureData(
 	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
-	Refresh_ColorAttachmentInfo *colorAttachmentInfos,
-	uint32_t colorAttachmentCount,
-	Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo
+	VulkanCommandBuffer *vulkanCommandBuffer,
+	VulkanTexture *texture,
+	uint32_t yWidth,
+	uint32_t yHeight,
+	uint32_t uvWidth,
+	uint32_t uvHeight,
+	void *yDataPtr,
+	void *uDataPtr,
+	void *vDataPtr,
+	uint32_t yDataLength,
+	uint32_t uvDataLength,
+	uint32_t yStride,
+	uint32_t uvStride
 ) {
-	VkResult vulkanResult;
-	VkAttachmentDescription attachmentDescriptions[2 * MAX_COLOR_TARGET_BINDINGS + 1];
-	VkAttachmentReference colorAttachmentReferences[MAX_COLOR_TARGET_BINDINGS];
-	VkAttachmentReference resolveReferences[MAX_COLOR_TARGET_BINDINGS + 1];
-	VkAttachmentReference depthStencilAttachmentReference;
-	VkRenderPassCreateInfo renderPassCreateInfo;
-	VkSubpassDescription subpass;
-	VkRenderPass renderPass;
+	static const VkImageAspectFlagBits planeAspects[3] =
+	{
+		VK_IMAGE_ASPECT_PLANE_0_BIT,
+		VK_IMAGE_ASPECT_PLANE_1_BIT,
+		VK_IMAGE_ASPECT_PLANE_2_BIT
+	};
+	VulkanTransferBuffer *transferBuffer;
+	void *planeData[3];
+	uint32_t planeDataLengths[3];
+	VkDeviceSize planeOffsets[3];
+	VkBufferImageCopy imageCopies[3];
+	VkDeviceSize stagingSize = 0;
+	uint8_t *stagingBufferPointer;
+	uint32_t planeCount = VULKAN_INTERNAL_PlaneCount(texture->format);
+	uint8_t asyncTransfer = VULKAN_INTERNAL_IsAsyncTransfer(renderer, vulkanCommandBuffer);
 	uint32_t i;
 
-	uint32_t attachmentDescriptionCount = 0;
-	uint32_t colorAttachmentReferenceCount = 0;
-	uint32_t resolveReferenceCount = 0;
+	planeData[0] = yDataPtr;
+	planeData[1] = uDataPtr;
+	planeData[2] = vDataPtr;
+	planeDataLengths[0] = yDataLength;
+	planeDataLengths[1] = uvDataLength;
+	planeDataLengths[2] = uvDataLength;
 
-	VulkanTexture *texture;
-	VulkanTexture *msaaTexture = NULL;
+	/* Transfer queues want every plane's buffer offset 4 byte aligned */
+	for (i = 0; i < planeCount; i += 1)
+	{
+		planeOffsets[i] = stagingSize;
+		stagingSize += (planeDataLengths[i] + 3) & ~((VkDeviceSize) 3);
+	}
 
-	for (i = 0; i < colorAttachmentCount; i += 1)
+	transferBuffer = VULKAN_INTERNAL_AcquireTransferBuffer(
+		renderer,
+		vulkanCommandBuffer,
+		stagingSize,
+		4
+	);
+
+	if (transferBuffer == NULL)
 	{
-		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
+		return;
+	}
 
-		if (texture->msaaTex != NULL)
+	stagingBufferPointer =
+		transferBuffer->buffer->usedRegion->allocation->mapPointer +
+		transferBuffer->buffer->usedRegion->resourceOffset +
+		transferBuffer->offset;
+
+	for (i = 0; i < planeCount; i += 1)
+	{
+		VULKAN_INTERNAL_CopyToMappedMemory(
+			stagingBufferPointer + planeOffsets[i],
+			planeData[i],
+			planeDataLengths[i]
+		);
+
+		imageCopies[i].imageExtent.width = (i == 0) ? yWidth : uvWidth;
+		imageCopies[i].imageExtent.height = (i == 0) ? yHeight : uvHeight;
+		imageCopies[i].imageExtent.depth = 1;
+		imageCopies[i].imageOffset.x = 0;
+		imageCopies[i].imageOffset.y = 0;
+		imageCopies[i].imageOffset.z = 0;
+		imageCopies[i].imageSubresource.aspectMask = planeAspects[i];
+		imageCopies[i].imageSubresource.baseArrayLayer = 0;
+		imageCopies[i].imageSubresource.layerCount = 1;
+		imageCopies[i].imageSubresource.mipLevel = 0;
+		imageCopies[i].bufferOffset = transferBuffer->offset + planeOffsets[i];
+		imageCopies[i].bufferImageHeight = imageCopies[i].imageExtent.height;
+
+		/* Row length is in texels, and the 2-plane chroma texels are CbCr pairs */
+		if (i == 0)
 		{
-			msaaTexture = texture->msaaTex;
+			imageCopies[i].bufferRowLength = yStride;
+		}
+		else if (planeCount == 2)
+		{
+			imageCopies[i].bufferRowLength = uvStride / 2;
+		}
+		else
+		{
+			imageCopies[i].bufferRowLength = uvStride;
+		}
+	}
 
-			/* Transition the multisample attachment */
+	if (asyncTransfer)
+	{
+		VULKAN_INTERNAL_BeginTransferQueueTextureWrite(
+			renderer,
+			vulkanCommandBuffer,
+			texture
+		);
+	}
+	else
+	{
+		VULKAN_INTERNAL_BaseSubresourceBarriers(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_WRITE,
+			&texture,
+			1
+		);
+	}
 
-			VULKAN_INTERNAL_ImageMemoryBarrier(
-				renderer,
-				commandBuffer->commandBuffer,
-				RESOURCE_ACCESS_COLOR_ATTACHMENT_WRITE,
-				VK_IMAGE_ASPECT_COLOR_BIT,
-				0,
-				msaaTexture->layerCount,
-				0,
-				msaaTexture->levelCount,
-				0,
-				msaaTexture->image,
-				&msaaTexture->resourceAccessType
-			);
+	renderer->vkCmdCopyBufferToImage(
+		vulkanCommandBuffer->commandBuffer,
+		transferBuffer->buffer->buffer,
+		texture->image,
+		AccessMap[RESOURCE_ACCESS_TRANSFER_WRITE].imageLayout,
+		planeCount,
+		imageCopies
+	);
 
-			/* Resolve attachment and multisample attachment */
+	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, texture);
 
-			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
-			attachmentDescriptions[attachmentDescriptionCount].format = texture->format;
-			attachmentDescriptions[attachmentDescriptionCount].samples =
-				VK_SAMPLE_COUNT_1_BIT;
-			attachmentDescriptions[attachmentDescriptionCount].loadOp = RefreshToVK_LoadOp[
-				colorAttachmentInfos[i].loadOp
-			];
-			attachmentDescriptions[attachmentDescriptionCount].storeOp =
-				VK_ATTACHMENT_STORE_OP_STORE; /* Always store the resolve texture */
-			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp =
-				VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp =
-				VK_ATTACHMENT_STORE_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].initialLayout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-			attachmentDescriptions[attachmentDescriptionCount].finalLayout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	transferBuffer->offset += stagingSize;
 
-			resolveReferences[resolveReferenceCount].attachment =
-				attachmentDescriptionCount;
-			resolveReferences[resolveReferenceCount].layout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	/* Async transfers are made readable when handed to the graphics queue */
+	if (!asyncTransfer)
+	{
+		VULKAN_INTERNAL_BaseSubresourceBarriers(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
+			&texture,
+			1
+		);
+	}
+}
 
-			attachmentDescriptionCount += 1;
-			resolveReferenceCount += 1;
+static void VULKAN_SetTextureDataYUV(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer* commandBuffer,
+	Refresh_Texture *y,
+	Refresh_Texture *u,
+	Refresh_Texture *v,
+	uint32_t yWidth,
+	uint32_t yHeight,
+	uint32_t uvWidth,
+	uint32_t uvHeight,
+	void *yDataPtr,
+	void *uDataPtr,
+	void *vDataPtr,
+	uint32_t yDataLength,
+	uint32_t uvDataLength,
+	uint32_t yStride,
+	uint32_t uvStride
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*)commandBuffer;
+	VulkanTransferBuffer *transferBuffer;
+	VulkanTexture *planes[3];
+	VulkanTexture *sampledPlanes[3];
+	void *planeData[3];
+	uint32_t planeDataLengths[3];
+	VkBufferImageCopy imageCopies[3];
+	VkDeviceSize planeOffset;
+	uint8_t *stagingBufferPointer;
+	uint8_t asyncTransfer = VULKAN_INTERNAL_IsAsyncTransfer(renderer, vulkanCommandBuffer);
+	uint32_t sampledPlaneCount = 0;
+	uint32_t i;
 
-			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
-			attachmentDescriptions[attachmentDescriptionCount].format = msaaTexture->format;
-			attachmentDescriptions[attachmentDescriptionCount].samples = RefreshToVK_SampleCount[
-				msaaTexture->sampleCount
-			];
-			attachmentDescriptions[attachmentDescriptionCount].loadOp = RefreshToVK_LoadOp[
-				colorAttachmentInfos[i].loadOp
-			];
-			attachmentDescriptions[attachmentDescriptionCount].storeOp = RefreshToVK_StoreOp[
-				colorAttachmentInfos[i].storeOp
-			];
-			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp =
-				VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp =
-				VK_ATTACHMENT_STORE_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].initialLayout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-			attachmentDescriptions[attachmentDescriptionCount].finalLayout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	planes[0] = ((VulkanTextureContainer*) y)->vulkanTexture;
 
-			colorAttachmentReferences[colorAttachmentReferenceCount].attachment =
-				attachmentDescriptionCount;
-			colorAttachmentReferences[colorAttachmentReferenceCount].layout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	if (VULKAN_INTERNAL_PlaneCount(planes[0]->format) > 1)
+	{
+		VULKAN_INTERNAL_SetYCbCrTextureData(
+			renderer,
+			vulkanCommandBuffer,
+			planes[0],
+			yWidth,
+			yHeight,
+			uvWidth,
+			uvHeight,
+			yDataPtr,
+			uDataPtr,
+			vDataPtr,
+			yDataLength,
+			uvDataLength,
+			yStride,
+			uvStride
+		);
+		return;
+	}
+
+	planes[1] = ((VulkanTextureContainer*) u)->vulkanTexture;
+	planes[2] = ((VulkanTextureContainer*) v)->vulkanTexture;
+	planeData[0] = yDataPtr;
+	planeData[1] = uDataPtr;
+	planeData[2] = vDataPtr;
+	planeDataLengths[0] = yDataLength;
+	planeDataLengths[1] = uvDataLength;
+	planeDataLengths[2] = uvDataLength;
+
+	/* All three planes share one staging allocation */
+	transferBuffer = VULKAN_INTERNAL_AcquireTransferBuffer(
+		renderer,
+		vulkanCommandBuffer,
+		yDataLength + uvDataLength * 2,
+		VULKAN_INTERNAL_BytesPerPixel(planes[0]->format)
+	);
+
+	if (transferBuffer == NULL)
+	{
+		return;
+	}
 
-			attachmentDescriptionCount += 1;
-			colorAttachmentReferenceCount += 1;
-		}
-		else
-		{
-			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
-			attachmentDescriptions[attachmentDescriptionCount].format = texture->format;
-			attachmentDescriptions[attachmentDescriptionCount].samples =
-				VK_SAMPLE_COUNT_1_BIT;
-			attachmentDescriptions[attachmentDescriptionCount].loadOp = RefreshToVK_LoadOp[
-				colorAttachmentInfos[i].loadOp
-			];
-			attachmentDescriptions[attachmentDescriptionCount].storeOp =
-				VK_ATTACHMENT_STORE_OP_STORE; /* Always store non-MSAA textures */
-			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp =
-				VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp =
-				VK_ATTACHMENT_STORE_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].initialLayout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-			attachmentDescriptions[attachmentDescriptionCount].finalLayout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	stagingBufferPointer =
+		transferBuffer->buffer->usedRegion->allocation->mapPointer +
+		transferBuffer->buffer->usedRegion->resourceOffset +
+		transferBuffer->offset;
 
+	planeOffset = 0;
 
-			colorAttachmentReferences[colorAttachmentReferenceCount].attachment = attachmentDescriptionCount;
-			colorAttachmentReferences[colorAttachmentReferenceCount].layout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	for (i = 0; i < 3; i += 1)
+	{
+		VULKAN_INTERNAL_CopyToMappedMemory(
+			stagingBufferPointer + planeOffset,
+			planeData[i],
+			planeDataLengths[i]
+		);
 
-			attachmentDescriptionCount += 1;
-			colorAttachmentReferenceCount += 1;
-		}
+		imageCopies[i].imageExtent.width = (i == 0) ? yWidth : uvWidth;
+		imageCopies[i].imageExtent.height = (i == 0) ? yHeight : uvHeight;
+		imageCopies[i].imageExtent.depth = 1;
+		imageCopies[i].imageOffset.x = 0;
+		imageCopies[i].imageOffset.y = 0;
+		imageCopies[i].imageOffset.z = 0;
+		imageCopies[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		imageCopies[i].imageSubresource.baseArrayLayer = 0;
+		imageCopies[i].imageSubresource.layerCount = 1;
+		imageCopies[i].imageSubresource.mipLevel = 0;
+		imageCopies[i].bufferOffset = transferBuffer->offset + planeOffset;
+		imageCopies[i].bufferRowLength = (i == 0) ? yStride : uvStride;
+		imageCopies[i].bufferImageHeight = imageCopies[i].imageExtent.height;
+
+		planeOffset += planeDataLengths[i];
 	}
 
-	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-	subpass.flags = 0;
-	subpass.inputAttachmentCount = 0;
-	subpass.pInputAttachments = NULL;
-	subpass.colorAttachmentCount = colorAttachmentCount;
-	subpass.pColorAttachments = colorAttachmentReferences;
-	subpass.preserveAttachmentCount = 0;
-	subpass.pPreserveAttachments = NULL;
+	/* One transition in and one out for all planes, rather than a pair per plane */
 
-	if (depthStencilAttachmentInfo == NULL)
+	if (asyncTransfer)
 	{
-		subpass.pDepthStencilAttachment = NULL;
+		for (i = 0; i < 3; i += 1)
+		{
+			VULKAN_INTERNAL_BeginTransferQueueTextureWrite(
+				renderer,
+				vulkanCommandBuffer,
+				planes[i]
+			);
+		}
 	}
 	else
 	{
-		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
-
-		attachmentDescriptions[attachmentDescriptionCount].flags = 0;
-		attachmentDescriptions[attachmentDescriptionCount].format = texture->format;
-		attachmentDescriptions[attachmentDescriptionCount].samples = RefreshToVK_SampleCount[
-			texture->sampleCount
-		];
-		attachmentDescriptions[attachmentDescriptionCount].loadOp = RefreshToVK_LoadOp[
-			depthStencilAttachmentInfo->loadOp
-		];
-		attachmentDescriptions[attachmentDescriptionCount].storeOp = RefreshToVK_StoreOp[
-			depthStencilAttachmentInfo->storeOp
-		];
-		attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp = RefreshToVK_LoadOp[
-			depthStencilAttachmentInfo->stencilLoadOp
-		];
-		attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp = RefreshToVK_StoreOp[
-			depthStencilAttachmentInfo->stencilStoreOp
-		];
-		attachmentDescriptions[attachmentDescriptionCount].initialLayout =
-			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-		attachmentDescriptions[attachmentDescriptionCount].finalLayout =
-			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		VULKAN_INTERNAL_BaseSubresourceBarriers(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_WRITE,
+			planes,
+			3
+		);
+	}
 
-		depthStencilAttachmentReference.attachment =
-			attachmentDescriptionCount;
-		depthStencilAttachmentReference.layout =
-			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+	for (i = 0; i < 3; i += 1)
+	{
+		renderer->vkCmdCopyBufferToImage(
+			vulkanCommandBuffer->commandBuffer,
+			transferBuffer->buffer->buffer,
+			planes[i]->image,
+			AccessMap[RESOURCE_ACCESS_TRANSFER_WRITE].imageLayout,
+			1,
+			&imageCopies[i]
+		);
 
-		subpass.pDepthStencilAttachment =
-			&depthStencilAttachmentReference;
+		if (planes[i]->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+		{
+			sampledPlanes[sampledPlaneCount] = planes[i];
+			sampledPlaneCount += 1;
+		}
 
-		attachmentDescriptionCount += 1;
+		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, planes[i]);
 	}
 
-	if (msaaTexture != NULL)
+	transferBuffer->offset += planeOffset;
+
+	/* Async transfers are made readable when handed to the graphics queue */
+	if (!asyncTransfer)
 	{
-		subpass.pResolveAttachments = resolveReferences;
+		VULKAN_INTERNAL_BaseSubresourceBarriers(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
+			sampledPlanes,
+			sampledPlaneCount
+		);
 	}
-	else
+}
+
+static void VULKAN_INTERNAL_BlitImage(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	Refresh_TextureSlice *sourceTextureSlice,
+	Refresh_TextureSlice *destinationTextureSlice,
+	VkFilter filter
+) {
+	VkImageBlit blit;
+	VulkanTexture *sourceTexture = ((VulkanTextureContainer*) sourceTextureSlice->texture)->vulkanTexture;
+	VulkanTexture *destinationTexture = ((VulkanTextureContainer*) destinationTextureSlice->texture)->vulkanTexture;
+
+	VulkanResourceAccessType originalSourceAccessType = *VULKAN_INTERNAL_SubresourceAccessType(
+		sourceTexture,
+		sourceTextureSlice->layer,
+		sourceTextureSlice->level
+	);
+	VulkanResourceAccessType originalDestinationAccessType = *VULKAN_INTERNAL_SubresourceAccessType(
+		destinationTexture,
+		destinationTextureSlice->layer,
+		destinationTextureSlice->level
+	);
+
+	if (originalDestinationAccessType == RESOURCE_ACCESS_NONE)
 	{
-		subpass.pResolveAttachments = NULL;
+		originalDestinationAccessType = RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE;
 	}
 
-	renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-	renderPassCreateInfo.pNext = NULL;
-	renderPassCreateInfo.flags = 0;
-	renderPassCreateInfo.pAttachments = attachmentDescriptions;
-	renderPassCreateInfo.attachmentCount = attachmentDescriptionCount;
-	renderPassCreateInfo.subpassCount = 1;
-	renderPassCreateInfo.pSubpasses = &subpass;
-	renderPassCreateInfo.dependencyCount = 0;
-	renderPassCreateInfo.pDependencies = NULL;
+	VULKAN_INTERNAL_ImageMemoryBarrier(
+		renderer,
+		commandBuffer->commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_READ,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		sourceTextureSlice->layer,
+		1,
+		sourceTextureSlice->level,
+		1,
+		0,
+		sourceTexture
+	);
 
-	vulkanResult = renderer->vkCreateRenderPass(
-		renderer->logicalDevice,
-		&renderPassCreateInfo,
-		NULL,
-		&renderPass
+	VULKAN_INTERNAL_ImageMemoryBarrier(
+		renderer,
+		commandBuffer->commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_WRITE,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		destinationTextureSlice->layer,
+		1,
+		destinationTextureSlice->level,
+		1,
+		0,
+		destinationTexture
+	);
+
+	blit.srcOffsets[0].x = sourceTextureSlice->rectangle.x;
+	blit.srcOffsets[0].y = sourceTextureSlice->rectangle.y;
+	blit.srcOffsets[0].z = sourceTextureSlice->depth;
+	blit.srcOffsets[1].x = sourceTextureSlice->rectangle.x + sourceTextureSlice->rectangle.w;
+	blit.srcOffsets[1].y = sourceTextureSlice->rectangle.y + sourceTextureSlice->rectangle.h;
+	blit.srcOffsets[1].z = 1;
+
+	blit.srcSubresource.mipLevel = sourceTextureSlice->level;
+	blit.srcSubresource.baseArrayLayer = sourceTextureSlice->layer;
+	blit.srcSubresource.layerCount = 1;
+	blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+
+	blit.dstOffsets[0].x = destinationTextureSlice->rectangle.x;
+	blit.dstOffsets[0].y = destinationTextureSlice->rectangle.y;
+	blit.dstOffsets[0].z = destinationTextureSlice->depth;
+	blit.dstOffsets[1].x = destinationTextureSlice->rectangle.x + destinationTextureSlice->rectangle.w;
+	blit.dstOffsets[1].y = destinationTextureSlice->rectangle.y + destinationTextureSlice->rectangle.h;
+	blit.dstOffsets[1].z = 1;
+
+	blit.dstSubresource.mipLevel = destinationTextureSlice->level;
+	blit.dstSubresource.baseArrayLayer = destinationTextureSlice->layer;
+	blit.dstSubresource.layerCount = 1;
+	blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+
+	renderer->vkCmdBlitImage(
+		commandBuffer->commandBuffer,
+		sourceTexture->image,
+		VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		destinationTexture->image,
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		1,
+		&blit,
+		filter
+	);
+
+	VULKAN_INTERNAL_ImageMemoryBarrier(
+		renderer,
+		commandBuffer->commandBuffer,
+		originalSourceAccessType,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		sourceTextureSlice->layer,
+		1,
+		sourceTextureSlice->level,
+		1,
+		0,
+		sourceTexture
+	);
+
+	VULKAN_INTERNAL_ImageMemoryBarrier(
+		renderer,
+		commandBuffer->commandBuffer,
+		originalDestinationAccessType,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		destinationTextureSlice->layer,
+		1,
+		destinationTextureSlice->level,
+		1,
+		0,
+		destinationTexture
+	);
+
+	VULKAN_INTERNAL_TrackTexture(renderer, commandBuffer, sourceTexture);
+	VULKAN_INTERNAL_TrackTexture(renderer, commandBuffer, destinationTexture);
+}
+
+REFRESHAPI void VULKAN_CopyTextureToTexture(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *sourceTextureSlice,
+	Refresh_TextureSlice *destinationTextureSlice,
+	Refresh_Filter filter
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*)driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+
+	VULKAN_INTERNAL_BlitImage(
+		renderer,
+		vulkanCommandBuffer,
+		sourceTextureSlice,
+		destinationTextureSlice,
+		RefreshToVK_Filter[filter]
+	);
+}
+
+/* Used for uniform pushes. Blocks are at most UBO_MAX_BLOCK_SIZE, which is
+ * under STREAMING_COPY_THRESHOLD, so these are always plain copies.
+ */
+static void VULKAN_INTERNAL_SetBufferData(
+	VulkanBuffer* vulkanBuffer,
+	VkDeviceSize offsetInBytes,
+	void* data,
+	uint32_t dataLength
+) {
+	VULKAN_INTERNAL_CopyToMappedMemory(
+		vulkanBuffer->usedRegion->allocation->mapPointer + vulkanBuffer->usedRegion->resourceOffset + vulkanBuffer->offset + offsetInBytes,
+		data,
+		dataLength
+	);
+}
+
+static void VULKAN_SetBufferData(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	void* data,
+	uint32_t dataLength
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer* vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer* vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
+	VulkanTransferBuffer* transferBuffer;
+	uint8_t* transferBufferPointer;
+
+	transferBuffer = VULKAN_INTERNAL_AcquireTransferBuffer(
+		renderer,
+		vulkanCommandBuffer,
+		dataLength,
+		renderer->physicalDeviceProperties.properties.limits.optimalBufferCopyOffsetAlignment
 	);
 
-	if (vulkanResult != VK_SUCCESS)
+	if (transferBuffer == NULL)
 	{
-		renderPass = VK_NULL_HANDLE;
-		LogVulkanResultAsError("vkCreateRenderPass", vulkanResult);
+		return;
 	}
 
-	return renderPass;
+	transferBufferPointer =
+		transferBuffer->buffer->usedRegion->allocation->mapPointer +
+		transferBuffer->buffer->usedRegion->resourceOffset +
+		transferBuffer->offset;
+
+	VULKAN_INTERNAL_CopyToMappedMemory(
+		transferBufferPointer,
+		data,
+		dataLength
+	);
+
+	/* The copy and its barriers are recorded with the rest of the batch */
+	VULKAN_INTERNAL_QueueBufferUpload(
+		renderer,
+		vulkanCommandBuffer,
+		transferBuffer->buffer,
+		transferBuffer->offset,
+		vulkanBuffer,
+		vulkanBuffer->offset + offsetInBytes,
+		(VkDeviceSize) dataLength
+	);
+
+	transferBuffer->offset += dataLength;
+
+	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
 }
 
-static VkRenderPass VULKAN_INTERNAL_CreateTransientRenderPass(
-	VulkanRenderer *renderer,
-	Refresh_GraphicsPipelineAttachmentInfo attachmentInfo,
-	Refresh_SampleCount sampleCount
+static void* VULKAN_MapUploadRegion(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	uint32_t sizeInBytes,
+	Refresh_UploadRegion **pRegion
 ) {
-	VkAttachmentDescription attachmentDescriptions[2 * MAX_COLOR_TARGET_BINDINGS + 1];
-	VkAttachmentReference colorAttachmentReferences[MAX_COLOR_TARGET_BINDINGS];
-	VkAttachmentReference resolveReferences[MAX_COLOR_TARGET_BINDINGS + 1];
-	VkAttachmentReference depthStencilAttachmentReference;
-	Refresh_ColorAttachmentDescription attachmentDescription;
-	VkSubpassDescription subpass;
-	VkRenderPassCreateInfo renderPassCreateInfo;
-	VkRenderPass renderPass;
-	VkResult result;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanTransferBuffer *transferBuffer;
+	VulkanUploadRegion *region;
+	uint8_t *mapPointer;
 
-	uint32_t multisampling = 0;
-	uint32_t attachmentDescriptionCount = 0;
-	uint32_t colorAttachmentReferenceCount = 0;
-	uint32_t resolveReferenceCount = 0;
-	uint32_t i;
+	/* The region's use is not known yet, so satisfy both buffer and texel block alignment */
+	transferBuffer = VULKAN_INTERNAL_AcquireTransferBuffer(
+		renderer,
+		vulkanCommandBuffer,
+		sizeInBytes,
+		SDL_max(
+			renderer->physicalDeviceProperties.properties.limits.optimalBufferCopyOffsetAlignment,
+			16
+		)
+	);
 
-	for (i = 0; i < attachmentInfo.colorAttachmentCount; i += 1)
+	if (transferBuffer == NULL)
 	{
-		attachmentDescription = attachmentInfo.colorAttachmentDescriptions[i];
+		*pRegion = NULL;
+		return NULL;
+	}
 
-		if (sampleCount > REFRESH_SAMPLECOUNT_1)
-		{
-			multisampling = 1;
+	if (vulkanCommandBuffer->uploadRegionCount == vulkanCommandBuffer->uploadRegionCapacity)
+	{
+		vulkanCommandBuffer->uploadRegionCapacity += 1;
+		vulkanCommandBuffer->uploadRegions = SDL_realloc(
+			vulkanCommandBuffer->uploadRegions,
+			vulkanCommandBuffer->uploadRegionCapacity * sizeof(VulkanUploadRegion*)
+		);
+		vulkanCommandBuffer->uploadRegions[vulkanCommandBuffer->uploadRegionCount] =
+			SDL_malloc(sizeof(VulkanUploadRegion));
+	}
 
-			/* Resolve attachment and multisample attachment */
+	region = vulkanCommandBuffer->uploadRegions[vulkanCommandBuffer->uploadRegionCount];
+	vulkanCommandBuffer->uploadRegionCount += 1;
 
-			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
-			attachmentDescriptions[attachmentDescriptionCount].format = RefreshToVK_SurfaceFormat[
-				attachmentDescription.format
-			];
-			attachmentDescriptions[attachmentDescriptionCount].samples = VK_SAMPLE_COUNT_1_BIT;
-			attachmentDescriptions[attachmentDescriptionCount].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-			attachmentDescriptions[attachmentDescriptionCount].finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	region->buffer = transferBuffer->buffer;
+	region->offset = transferBuffer->offset;
+	region->size = sizeInBytes;
 
-			resolveReferences[resolveReferenceCount].attachment = attachmentDescriptionCount;
-			resolveReferences[resolveReferenceCount].layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	mapPointer =
+		transferBuffer->buffer->usedRegion->allocation->mapPointer +
+		transferBuffer->buffer->usedRegion->resourceOffset +
+		transferBuffer->offset;
 
-			attachmentDescriptionCount += 1;
-			resolveReferenceCount += 1;
+	transferBuffer->offset += sizeInBytes;
 
-			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
-			attachmentDescriptions[attachmentDescriptionCount].format = RefreshToVK_SurfaceFormat[
-				attachmentDescription.format
-			];
-			attachmentDescriptions[attachmentDescriptionCount].samples = RefreshToVK_SampleCount[
-				sampleCount
-			];
-			attachmentDescriptions[attachmentDescriptionCount].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-			attachmentDescriptions[attachmentDescriptionCount].finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	*pRegion = (Refresh_UploadRegion*) region;
+	return mapPointer;
+}
 
-			colorAttachmentReferences[colorAttachmentReferenceCount].attachment =
-				attachmentDescriptionCount;
-			colorAttachmentReferences[colorAttachmentReferenceCount].layout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+static void VULKAN_CommitUploadRegionToBuffer(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_UploadRegion *region,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanUploadRegion *vulkanRegion = (VulkanUploadRegion*) region;
+	VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
 
-			attachmentDescriptionCount += 1;
-			colorAttachmentReferenceCount += 1;
-		}
-		else
-		{
-			attachmentDescriptions[attachmentDescriptionCount].flags = 0;
-			attachmentDescriptions[attachmentDescriptionCount].format = RefreshToVK_SurfaceFormat[
-				attachmentDescription.format
-			];
-			attachmentDescriptions[attachmentDescriptionCount].samples =
-				VK_SAMPLE_COUNT_1_BIT;
-			attachmentDescriptions[attachmentDescriptionCount].loadOp =
-				VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].storeOp =
-				VK_ATTACHMENT_STORE_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp =
-				VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp =
-				VK_ATTACHMENT_STORE_OP_DONT_CARE;
-			attachmentDescriptions[attachmentDescriptionCount].initialLayout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-			attachmentDescriptions[attachmentDescriptionCount].finalLayout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	VULKAN_INTERNAL_QueueBufferUpload(
+		renderer,
+		vulkanCommandBuffer,
+		vulkanRegion->buffer,
+		vulkanRegion->offset,
+		vulkanBuffer,
+		vulkanBuffer->offset + offsetInBytes,
+		vulkanRegion->size
+	);
 
+	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
+}
 
-			colorAttachmentReferences[colorAttachmentReferenceCount].attachment = attachmentDescriptionCount;
-			colorAttachmentReferences[colorAttachmentReferenceCount].layout =
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+static void VULKAN_CommitUploadRegionToTexture(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_UploadRegion *region,
+	Refresh_TextureSlice *textureSlice
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanUploadRegion *vulkanRegion = (VulkanUploadRegion*) region;
+	VulkanTexture *vulkanTexture = ((VulkanTextureContainer*) textureSlice->texture)->vulkanTexture;
 
-			attachmentDescriptionCount += 1;
-			colorAttachmentReferenceCount += 1;
-		}
+	if (vulkanRegion->size < VULKAN_INTERNAL_BytesPerImage(
+		textureSlice->rectangle.w,
+		textureSlice->rectangle.h,
+		vulkanTexture->format
+	)) {
+		Refresh_LogError("Upload region is too small for the texture slice!");
+		return;
 	}
 
-	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-	subpass.flags = 0;
-	subpass.inputAttachmentCount = 0;
-	subpass.pInputAttachments = NULL;
-	subpass.colorAttachmentCount = attachmentInfo.colorAttachmentCount;
-	subpass.pColorAttachments = colorAttachmentReferences;
-	subpass.preserveAttachmentCount = 0;
-	subpass.pPreserveAttachments = NULL;
-
-	if (attachmentInfo.hasDepthStencilAttachment)
-	{
-		attachmentDescriptions[attachmentDescriptionCount].flags = 0;
-		attachmentDescriptions[attachmentDescriptionCount].format = RefreshToVK_DepthFormat(
-			renderer,
-			attachmentInfo.depthStencilFormat
-		);
-		attachmentDescriptions[attachmentDescriptionCount].samples = RefreshToVK_SampleCount[
-			sampleCount
-		];
-		attachmentDescriptions[attachmentDescriptionCount].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-		attachmentDescriptions[attachmentDescriptionCount].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-		attachmentDescriptions[attachmentDescriptionCount].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-		attachmentDescriptions[attachmentDescriptionCount].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-		attachmentDescriptions[attachmentDescriptionCount].initialLayout =
-			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-		attachmentDescriptions[attachmentDescriptionCount].finalLayout =
-			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-		depthStencilAttachmentReference.attachment =
-			attachmentDescriptionCount;
-		depthStencilAttachmentReference.layout =
-			VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+	VULKAN_INTERNAL_CopyStagingToTexture(
+		renderer,
+		(VulkanCommandBuffer*) commandBuffer,
+		vulkanRegion->buffer,
+		&vulkanRegion->offset,
+		NULL,
+		textureSlice,
+		1
+	);
+}
 
-		subpass.pDepthStencilAttachment =
-			&depthStencilAttachmentReference;
+/* FIXME: this should return uint64_t */
+static uint32_t VULKAN_PushVertexShaderUniforms(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	void *data,
+	uint32_t dataLengthInBytes
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer* vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanGraphicsPipeline* graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
+	uint32_t offset;
 
-		attachmentDescriptionCount += 1;
-	}
-	else
+	if (graphicsPipeline == NULL)
 	{
-		subpass.pDepthStencilAttachment = NULL;
+		Refresh_LogError("Cannot push uniforms if a pipeline is not bound!");
+		return 0;
 	}
 
-	if (multisampling)
+	if (graphicsPipeline->vertexPushConstantSize > 0)
 	{
-		subpass.pResolveAttachments = resolveReferences;
+		if (dataLengthInBytes > graphicsPipeline->vertexPushConstantSize || dataLengthInBytes % 4 != 0)
+		{
+			Refresh_LogError("Vertex uniform data does not fit the push constant block!");
+			return 0;
+		}
+
+		renderer->vkCmdPushConstants(
+			vulkanCommandBuffer->commandBuffer,
+			graphicsPipeline->pipelineLayout->pipelineLayout,
+			VK_SHADER_STAGE_VERTEX_BIT,
+			0,
+			dataLengthInBytes,
+			data
+		);
+
+		return 0;
 	}
-	else
+
+	if (graphicsPipeline->vertexUniformBlockSize == 0)
 	{
-		subpass.pResolveAttachments = NULL;
+		Refresh_LogError("Bound pipeline's vertex stage does not declare uniforms!");
+		return 0;
 	}
 
-	renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-	renderPassCreateInfo.pNext = NULL;
-	renderPassCreateInfo.flags = 0;
-	renderPassCreateInfo.pAttachments = attachmentDescriptions;
-	renderPassCreateInfo.attachmentCount = attachmentDescriptionCount;
-	renderPassCreateInfo.subpassCount = 1;
-	renderPassCreateInfo.pSubpasses = &subpass;
-	renderPassCreateInfo.dependencyCount = 0;
-	renderPassCreateInfo.pDependencies = NULL;
-
-	result = renderer->vkCreateRenderPass(
-		renderer->logicalDevice,
-		&renderPassCreateInfo,
-		NULL,
-		&renderPass
+	if (
+		vulkanCommandBuffer->vertexUniformBuffer->offset +
+		graphicsPipeline->vertexUniformBlockSize >=
+		UBO_SECTION_SIZE
+	) {
+		/* We're out of space in this buffer, bind the old one and acquire a new one */
+		VULKAN_INTERNAL_BindUniformBuffer(
+			renderer,
+			vulkanCommandBuffer,
+			vulkanCommandBuffer->vertexUniformBuffer
+		);
+		vulkanCommandBuffer->vertexUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+			renderer,
+			renderer->vertexUniformBufferPool
+		);
+	}
+
+	/* The buffer's descriptor starts at offset 0, so the dynamic offset is absolute */
+	offset = (uint32_t) (
+		vulkanCommandBuffer->vertexUniformBuffer->poolOffset +
+		vulkanCommandBuffer->vertexUniformBuffer->offset
 	);
 
-	if (result != VK_SUCCESS)
-	{
-		renderPass = VK_NULL_HANDLE;
-		LogVulkanResultAsError("vkCreateRenderPass", result);
-	}
+	VULKAN_INTERNAL_SetBufferData(
+		vulkanCommandBuffer->vertexUniformBuffer->buffer,
+		vulkanCommandBuffer->vertexUniformBuffer->poolOffset + vulkanCommandBuffer->vertexUniformBuffer->offset,
+		data,
+		dataLengthInBytes
+	);
 
-	return renderPass;
+	vulkanCommandBuffer->vertexUniformBuffer->offset += graphicsPipeline->vertexUniformBlockSize;
+
+	return offset;
 }
 
-static Refresh_GraphicsPipeline* VULKAN_CreateGraphicsPipeline(
+/* FIXME: this should return uint64_t */
+static uint32_t VULKAN_PushFragmentShaderUniforms(
 	Refresh_Renderer *driverData,
-	Refresh_GraphicsPipelineCreateInfo *pipelineCreateInfo
+	Refresh_CommandBuffer *commandBuffer,
+	void *data,
+	uint32_t dataLengthInBytes
 ) {
-	VkResult vulkanResult;
-	uint32_t i;
-	Refresh_SampleCount actualSampleCount;
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer* vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanGraphicsPipeline* graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
+	uint32_t offset;
 
-	VulkanGraphicsPipeline *graphicsPipeline = (VulkanGraphicsPipeline*) SDL_malloc(sizeof(VulkanGraphicsPipeline));
-	VkGraphicsPipelineCreateInfo vkPipelineCreateInfo;
+	if (graphicsPipeline == NULL)
+	{
+		Refresh_LogError("Cannot push uniforms if a pipeline is not bound!");
+		return 0;
+	}
 
-	VkPipelineShaderStageCreateInfo shaderStageCreateInfos[2];
+	if (graphicsPipeline->fragmentPushConstantSize > 0)
+	{
+		if (dataLengthInBytes > graphicsPipeline->fragmentPushConstantSize || dataLengthInBytes % 4 != 0)
+		{
+			Refresh_LogError("Fragment uniform data does not fit the push constant block!");
+			return 0;
+		}
 
-	VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo;
-	VkVertexInputBindingDescription *vertexInputBindingDescriptions = SDL_stack_alloc(VkVertexInputBindingDescription, pipelineCreateInfo->vertexInputState.vertexBindingCount);
-	VkVertexInputAttributeDescription *vertexInputAttributeDescriptions = SDL_stack_alloc(VkVertexInputAttributeDescription, pipelineCreateInfo->vertexInputState.vertexAttributeCount);
+		renderer->vkCmdPushConstants(
+			vulkanCommandBuffer->commandBuffer,
+			graphicsPipeline->pipelineLayout->pipelineLayout,
+			VK_SHADER_STAGE_FRAGMENT_BIT,
+			FRAGMENT_PUSH_CONSTANT_OFFSET,
+			dataLengthInBytes,
+			data
+		);
 
-	VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCreateInfo;
+		return 0;
+	}
 
-	VkPipelineViewportStateCreateInfo viewportStateCreateInfo;
+	if (
+		vulkanCommandBuffer->fragmentUniformBuffer->offset +
+		graphicsPipeline->fragmentUniformBlockSize >=
+		UBO_SECTION_SIZE
+	) {
+		/* We're out of space in this buffer, bind the old one and acquire a new one */
+		VULKAN_INTERNAL_BindUniformBuffer(
+			renderer,
+			vulkanCommandBuffer,
+			vulkanCommandBuffer->fragmentUniformBuffer
+		);
+		vulkanCommandBuffer->fragmentUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+			renderer,
+			renderer->fragmentUniformBufferPool
+		);
+	}
 
-	VkPipelineRasterizationStateCreateInfo rasterizationStateCreateInfo;
+	/* The buffer's descriptor starts at offset 0, so the dynamic offset is absolute */
+	offset = (uint32_t) (
+		vulkanCommandBuffer->fragmentUniformBuffer->poolOffset +
+		vulkanCommandBuffer->fragmentUniformBuffer->offset
+	);
 
-	VkPipelineMultisampleStateCreateInfo multisampleStateCreateInfo;
+	VULKAN_INTERNAL_SetBufferData(
+		vulkanCommandBuffer->fragmentUniformBuffer->buffer,
+		vulkanCommandBuffer->fragmentUniformBuffer->poolOffset + vulkanCommandBuffer->fragmentUniformBuffer->offset,
+		data,
+		dataLengthInBytes
+	);
 
-	VkPipelineDepthStencilStateCreateInfo depthStencilStateCreateInfo;
-	VkStencilOpState frontStencilState;
-	VkStencilOpState backStencilState;
+	vulkanCommandBuffer->fragmentUniformBuffer->offset += graphicsPipeline->fragmentUniformBlockSize;
 
-	VkPipelineColorBlendStateCreateInfo colorBlendStateCreateInfo;
-	VkPipelineColorBlendAttachmentState *colorBlendAttachmentStates = SDL_stack_alloc(
-		VkPipelineColorBlendAttachmentState,
-		pipelineCreateInfo->attachmentInfo.colorAttachmentCount
-	);
+	return offset;
+}
 
-	static const VkDynamicState dynamicStates[] =
-	{
-		VK_DYNAMIC_STATE_VIEWPORT,
-		VK_DYNAMIC_STATE_SCISSOR
-	};
-	VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo;
+static uint32_t VULKAN_PushComputeShaderUniforms(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	void *data,
+	uint32_t dataLengthInBytes
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer* vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanComputePipeline* computePipeline = vulkanCommandBuffer->currentComputePipeline;
+	uint32_t offset;
 
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	if (
+		vulkanCommandBuffer->computeUniformBuffer->offset +
+		computePipeline->uniformBlockSize >=
+		UBO_SECTION_SIZE
+	) {
+		/* We're out of space in this buffer, bind the old one and acquire a new one */
+		VULKAN_INTERNAL_BindUniformBuffer(
+			renderer,
+			vulkanCommandBuffer,
+			vulkanCommandBuffer->computeUniformBuffer
+		);
+		vulkanCommandBuffer->computeUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+			renderer,
+			renderer->computeUniformBufferPool
+		);
+	}
 
-	/* Find a compatible sample count to use */
+	/* The buffer's descriptor starts at offset 0, so the dynamic offset is absolute */
+	offset = (uint32_t) (
+		vulkanCommandBuffer->computeUniformBuffer->poolOffset +
+		vulkanCommandBuffer->computeUniformBuffer->offset
+	);
 
-	actualSampleCount = VULKAN_INTERNAL_GetMaxMultiSampleCount(
-		renderer,
-		pipelineCreateInfo->multisampleState.multisampleCount
+	VULKAN_INTERNAL_SetBufferData(
+		vulkanCommandBuffer->computeUniformBuffer->buffer,
+		vulkanCommandBuffer->computeUniformBuffer->poolOffset + vulkanCommandBuffer->computeUniformBuffer->offset,
+		data,
+		dataLengthInBytes
 	);
 
-	/* Create a "compatible" render pass */
+	vulkanCommandBuffer->computeUniformBuffer->offset += computePipeline->uniformBlockSize;
 
-	VkRenderPass transientRenderPass = VULKAN_INTERNAL_CreateTransientRenderPass(
-		renderer,
-		pipelineCreateInfo->attachmentInfo,
-		actualSampleCount
-	);
+	return offset;
+}
 
-	/* Dynamic state */
+/* If fetching an image descriptor, descriptorImageInfos must not be NULL.
+ * If fetching a buffer descriptor, descriptorBufferInfos must not be NULL.
+ */
+static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *vulkanCommandBuffer,
+	DescriptorSetCache *descriptorSetCache,
+	VkDescriptorImageInfo *descriptorImageInfos, /* Can be NULL */
+	VkDescriptorBufferInfo *descriptorBufferInfos /* Can be NULL */
+) {
+	uint32_t i;
+	VkDescriptorSet descriptorSet;
+	VkWriteDescriptorSet writeDescriptorSets[MAX_TEXTURE_SAMPLERS];
+	uint8_t isImage;
 
-	dynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-	dynamicStateCreateInfo.pNext = NULL;
-	dynamicStateCreateInfo.flags = 0;
-	dynamicStateCreateInfo.dynamicStateCount = SDL_arraysize(dynamicStates);
-	dynamicStateCreateInfo.pDynamicStates = dynamicStates;
+	if (descriptorImageInfos == NULL && descriptorBufferInfos == NULL)
+	{
+		Refresh_LogError("descriptorImageInfos and descriptorBufferInfos cannot both be NULL!");
+		return VK_NULL_HANDLE;
+	}
+	else if (descriptorImageInfos != NULL && descriptorBufferInfos != NULL)
+	{
+		Refresh_LogError("descriptorImageInfos and descriptorBufferInfos cannot both be set!");
+		return VK_NULL_HANDLE;
+	}
 
-	/* Shader stages */
+	isImage = descriptorImageInfos != NULL;
 
-	graphicsPipeline->vertexShaderModule = (VulkanShaderModule*) pipelineCreateInfo->vertexShaderInfo.shaderModule;
-	SDL_AtomicIncRef(&graphicsPipeline->vertexShaderModule->referenceCount);
+	SDL_LockMutex(descriptorSetCache->lock);
 
-	shaderStageCreateInfos[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-	shaderStageCreateInfos[0].pNext = NULL;
-	shaderStageCreateInfos[0].flags = 0;
-	shaderStageCreateInfos[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-	shaderStageCreateInfos[0].module = graphicsPipeline->vertexShaderModule->shaderModule;
-	shaderStageCreateInfos[0].pName = pipelineCreateInfo->vertexShaderInfo.entryPointName;
-	shaderStageCreateInfos[0].pSpecializationInfo = NULL;
+	/* If no inactive descriptor sets remain, create a new pool and allocate new inactive sets */
 
-	graphicsPipeline->vertexUniformBlockSize =
-		VULKAN_INTERNAL_NextHighestAlignment(
-			pipelineCreateInfo->vertexShaderInfo.uniformBufferSize,
-			renderer->minUBOAlignment
+	if (descriptorSetCache->inactiveDescriptorSetCount == 0)
+	{
+		descriptorSetCache->descriptorPoolCount += 1;
+		descriptorSetCache->descriptorPools = SDL_realloc(
+			descriptorSetCache->descriptorPools,
+			sizeof(VkDescriptorPool) * descriptorSetCache->descriptorPoolCount
 		);
 
-	graphicsPipeline->fragmentShaderModule = (VulkanShaderModule*) pipelineCreateInfo->fragmentShaderInfo.shaderModule;
-	SDL_AtomicIncRef(&graphicsPipeline->fragmentShaderModule->referenceCount);
+		if (!VULKAN_INTERNAL_CreateDescriptorPool(
+			renderer,
+			descriptorSetCache->descriptorType,
+			descriptorSetCache->nextPoolSize,
+			descriptorSetCache->nextPoolSize * descriptorSetCache->descriptorCount,
+			&descriptorSetCache->descriptorPools[descriptorSetCache->descriptorPoolCount - 1]
+		)) {
+			SDL_UnlockMutex(descriptorSetCache->lock);
+			Refresh_LogError("Failed to create descriptor pool!");
+			return VK_NULL_HANDLE;
+		}
 
-	shaderStageCreateInfos[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-	shaderStageCreateInfos[1].pNext = NULL;
-	shaderStageCreateInfos[1].flags = 0;
-	shaderStageCreateInfos[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-	shaderStageCreateInfos[1].module = graphicsPipeline->fragmentShaderModule->shaderModule;
-	shaderStageCreateInfos[1].pName = pipelineCreateInfo->fragmentShaderInfo.entryPointName;
-	shaderStageCreateInfos[1].pSpecializationInfo = NULL;
+		descriptorSetCache->inactiveDescriptorSetCapacity += descriptorSetCache->nextPoolSize;
 
-	graphicsPipeline->fragmentUniformBlockSize =
-		VULKAN_INTERNAL_NextHighestAlignment(
-			pipelineCreateInfo->fragmentShaderInfo.uniformBufferSize,
-			renderer->minUBOAlignment
+		descriptorSetCache->inactiveDescriptorSets = SDL_realloc(
+			descriptorSetCache->inactiveDescriptorSets,
+			sizeof(VkDescriptorSet) * descriptorSetCache->inactiveDescriptorSetCapacity
 		);
 
-	/* Vertex input */
+		if (!VULKAN_INTERNAL_AllocateDescriptorSets(
+			renderer,
+			descriptorSetCache->descriptorPools[descriptorSetCache->descriptorPoolCount - 1],
+			descriptorSetCache->descriptorSetLayout,
+			descriptorSetCache->nextPoolSize,
+			descriptorSetCache->inactiveDescriptorSets
+		)) {
+			SDL_UnlockMutex(descriptorSetCache->lock);
+			Refresh_LogError("Failed to allocate descriptor sets!");
+			return VK_NULL_HANDLE;
+		}
 
-	for (i = 0; i < pipelineCreateInfo->vertexInputState.vertexBindingCount; i += 1)
-	{
-		vertexInputBindingDescriptions[i].binding = pipelineCreateInfo->vertexInputState.vertexBindings[i].binding;
-		vertexInputBindingDescriptions[i].inputRate = RefreshToVK_VertexInputRate[
-			pipelineCreateInfo->vertexInputState.vertexBindings[i].inputRate
-		];
-		vertexInputBindingDescriptions[i].stride = pipelineCreateInfo->vertexInputState.vertexBindings[i].stride;
+		descriptorSetCache->inactiveDescriptorSetCount = descriptorSetCache->nextPoolSize;
+
+		descriptorSetCache->nextPoolSize *= 2;
 	}
 
-	for (i = 0; i < pipelineCreateInfo->vertexInputState.vertexAttributeCount; i += 1)
+	descriptorSet = descriptorSetCache->inactiveDescriptorSets[descriptorSetCache->inactiveDescriptorSetCount - 1];
+	descriptorSetCache->inactiveDescriptorSetCount -= 1;
+
+	for (i = 0; i < descriptorSetCache->bindingCount; i += 1)
 	{
-		vertexInputAttributeDescriptions[i].binding = pipelineCreateInfo->vertexInputState.vertexAttributes[i].binding;
-		vertexInputAttributeDescriptions[i].format = RefreshToVK_VertexFormat[
-			pipelineCreateInfo->vertexInputState.vertexAttributes[i].format
-		];
-		vertexInputAttributeDescriptions[i].location = pipelineCreateInfo->vertexInputState.vertexAttributes[i].location;
-		vertexInputAttributeDescriptions[i].offset = pipelineCreateInfo->vertexInputState.vertexAttributes[i].offset;
-	}
+		writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSets[i].pNext = NULL;
+		writeDescriptorSets[i].descriptorCount = 1;
+		writeDescriptorSets[i].descriptorType = descriptorSetCache->descriptorType;
+		writeDescriptorSets[i].dstArrayElement = 0;
+		writeDescriptorSets[i].dstBinding = i;
+		writeDescriptorSets[i].dstSet = descriptorSet;
+		writeDescriptorSets[i].pTexelBufferView = NULL;
 
-	vertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	vertexInputStateCreateInfo.pNext = NULL;
-	vertexInputStateCreateInfo.flags = 0;
-	vertexInputStateCreateInfo.vertexBindingDescriptionCount = pipelineCreateInfo->vertexInputState.vertexBindingCount;
-	vertexInputStateCreateInfo.pVertexBindingDescriptions = vertexInputBindingDescriptions;
-	vertexInputStateCreateInfo.vertexAttributeDescriptionCount = pipelineCreateInfo->vertexInputState.vertexAttributeCount;
-	vertexInputStateCreateInfo.pVertexAttributeDescriptions = vertexInputAttributeDescriptions;
+		if (isImage)
+		{
+			writeDescriptorSets[i].pImageInfo = &descriptorImageInfos[i];
+			writeDescriptorSets[i].pBufferInfo = NULL;
 
-	/* Topology */
+		}
+		else
+		{
+			writeDescriptorSets[i].pBufferInfo = &descriptorBufferInfos[i];
+			writeDescriptorSets[i].pImageInfo = NULL;
+		}
+	}
 
-	inputAssemblyStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-	inputAssemblyStateCreateInfo.pNext = NULL;
-	inputAssemblyStateCreateInfo.flags = 0;
-	inputAssemblyStateCreateInfo.primitiveRestartEnable = VK_FALSE;
-	inputAssemblyStateCreateInfo.topology = RefreshToVK_PrimitiveType[
-		pipelineCreateInfo->primitiveType
-	];
+	renderer->vkUpdateDescriptorSets(
+		renderer->logicalDevice,
+		descriptorSetCache->bindingCount,
+		writeDescriptorSets,
+		0,
+		NULL
+	);
 
-	graphicsPipeline->primitiveType = pipelineCreateInfo->primitiveType;
+	SDL_UnlockMutex(descriptorSetCache->lock);
 
-	/* Viewport */
+	if (vulkanCommandBuffer->boundDescriptorSetDataCount == vulkanCommandBuffer->boundDescriptorSetDataCapacity)
+	{
+		vulkanCommandBuffer->boundDescriptorSetDataCapacity *= 2;
+		vulkanCommandBuffer->boundDescriptorSetDatas = SDL_realloc(
+			vulkanCommandBuffer->boundDescriptorSetDatas,
+			vulkanCommandBuffer->boundDescriptorSetDataCapacity * sizeof(DescriptorSetData)
+		);
+	}
 
-	/* NOTE: viewport and scissor are dynamic, and must be set using the command buffer */
+	vulkanCommandBuffer->boundDescriptorSetDatas[vulkanCommandBuffer->boundDescriptorSetDataCount].descriptorSet = descriptorSet;
+	vulkanCommandBuffer->boundDescriptorSetDatas[vulkanCommandBuffer->boundDescriptorSetDataCount].descriptorSetCache = descriptorSetCache;
+	vulkanCommandBuffer->boundDescriptorSetDataCount += 1;
 
-	viewportStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-	viewportStateCreateInfo.pNext = NULL;
-	viewportStateCreateInfo.flags = 0;
-	viewportStateCreateInfo.viewportCount = 1;
-	viewportStateCreateInfo.pViewports = NULL;
-	viewportStateCreateInfo.scissorCount = 1;
-	viewportStateCreateInfo.pScissors = NULL;
+	return descriptorSet;
+}
 
-	/* Rasterization */
+static void VULKAN_BindVertexSamplers(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Texture **pTextures,
+	Refresh_Sampler **pSamplers
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanGraphicsPipeline *graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
 
-	rasterizationStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-	rasterizationStateCreateInfo.pNext = NULL;
-	rasterizationStateCreateInfo.flags = 0;
-	rasterizationStateCreateInfo.depthClampEnable = VK_FALSE;
-	rasterizationStateCreateInfo.rasterizerDiscardEnable = VK_FALSE;
-	rasterizationStateCreateInfo.polygonMode = RefreshToVK_PolygonMode[
-		pipelineCreateInfo->rasterizerState.fillMode
-	];
-	rasterizationStateCreateInfo.cullMode = RefreshToVK_CullMode[
-		pipelineCreateInfo->rasterizerState.cullMode
-	];
-	rasterizationStateCreateInfo.frontFace = RefreshToVK_FrontFace[
-		pipelineCreateInfo->rasterizerState.frontFace
-	];
-	rasterizationStateCreateInfo.depthBiasEnable =
-		pipelineCreateInfo->rasterizerState.depthBiasEnable;
-	rasterizationStateCreateInfo.depthBiasConstantFactor =
-		pipelineCreateInfo->rasterizerState.depthBiasConstantFactor;
-	rasterizationStateCreateInfo.depthBiasClamp =
-		pipelineCreateInfo->rasterizerState.depthBiasClamp;
-	rasterizationStateCreateInfo.depthBiasSlopeFactor =
-		pipelineCreateInfo->rasterizerState.depthBiasSlopeFactor;
-	rasterizationStateCreateInfo.lineWidth = 1.0f;
+	VulkanTexture *currentTexture;
+	VulkanSampler *currentSampler;
+	uint32_t i, samplerCount;
+	VkDescriptorImageInfo descriptorImageInfos[MAX_TEXTURE_SAMPLERS];
 
-	/* Multisample */
+	if (graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCache == NULL)
+	{
+		return;
+	}
 
-	multisampleStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-	multisampleStateCreateInfo.pNext = NULL;
-	multisampleStateCreateInfo.flags = 0;
-	multisampleStateCreateInfo.rasterizationSamples = RefreshToVK_SampleCount[actualSampleCount];
-	multisampleStateCreateInfo.sampleShadingEnable = VK_FALSE;
-	multisampleStateCreateInfo.minSampleShading = 1.0f;
-	multisampleStateCreateInfo.pSampleMask =
-		&pipelineCreateInfo->multisampleState.sampleMask;
-	multisampleStateCreateInfo.alphaToCoverageEnable = VK_FALSE;
-	multisampleStateCreateInfo.alphaToOneEnable = VK_FALSE;
+	samplerCount = graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCache->bindingCount;
 
-	/* Depth Stencil State */
+	for (i = 0; i < samplerCount; i += 1)
+	{
+		currentTexture = ((VulkanTextureContainer*) pTextures[i])->vulkanTexture;
+		currentSampler = (VulkanSampler*) pSamplers[i];
+		descriptorImageInfos[i].imageView = currentTexture->view;
+		descriptorImageInfos[i].sampler = currentSampler->sampler;
+		descriptorImageInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-	frontStencilState.failOp = RefreshToVK_StencilOp[
-		pipelineCreateInfo->depthStencilState.frontStencilState.failOp
-	];
-	frontStencilState.passOp = RefreshToVK_StencilOp[
-		pipelineCreateInfo->depthStencilState.frontStencilState.passOp
-	];
-	frontStencilState.depthFailOp = RefreshToVK_StencilOp[
-		pipelineCreateInfo->depthStencilState.frontStencilState.depthFailOp
-	];
-	frontStencilState.compareOp = RefreshToVK_CompareOp[
-		pipelineCreateInfo->depthStencilState.frontStencilState.compareOp
-	];
-	frontStencilState.compareMask =
-		pipelineCreateInfo->depthStencilState.frontStencilState.compareMask;
-	frontStencilState.writeMask =
-		pipelineCreateInfo->depthStencilState.frontStencilState.writeMask;
-	frontStencilState.reference =
-		pipelineCreateInfo->depthStencilState.frontStencilState.reference;
+		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, currentTexture);
+		VULKAN_INTERNAL_TrackSampler(renderer, vulkanCommandBuffer, currentSampler);
+	}
 
-	backStencilState.failOp = RefreshToVK_StencilOp[
-		pipelineCreateInfo->depthStencilState.backStencilState.failOp
-	];
-	backStencilState.passOp = RefreshToVK_StencilOp[
-		pipelineCreateInfo->depthStencilState.backStencilState.passOp
-	];
-	backStencilState.depthFailOp = RefreshToVK_StencilOp[
-		pipelineCreateInfo->depthStencilState.backStencilState.depthFailOp
-	];
-	backStencilState.compareOp = RefreshToVK_CompareOp[
-		pipelineCreateInfo->depthStencilState.backStencilState.compareOp
-	];
-	backStencilState.compareMask =
-		pipelineCreateInfo->depthStencilState.backStencilState.compareMask;
-	backStencilState.writeMask =
-		pipelineCreateInfo->depthStencilState.backStencilState.writeMask;
-	backStencilState.reference =
-		pipelineCreateInfo->depthStencilState.backStencilState.reference;
+	vulkanCommandBuffer->vertexSamplerDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
+		renderer,
+		vulkanCommandBuffer,
+		graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCache,
+		descriptorImageInfos,
+		NULL
+	);
+}
 
+static void VULKAN_BindFragmentSamplers(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Texture **pTextures,
+	Refresh_Sampler **pSamplers
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanGraphicsPipeline *graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
 
-	depthStencilStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-	depthStencilStateCreateInfo.pNext = NULL;
-	depthStencilStateCreateInfo.flags = 0;
-	depthStencilStateCreateInfo.depthTestEnable =
-		pipelineCreateInfo->depthStencilState.depthTestEnable;
-	depthStencilStateCreateInfo.depthWriteEnable =
-		pipelineCreateInfo->depthStencilState.depthWriteEnable;
-	depthStencilStateCreateInfo.depthCompareOp = RefreshToVK_CompareOp[
-		pipelineCreateInfo->depthStencilState.compareOp
-	];
-	depthStencilStateCreateInfo.depthBoundsTestEnable =
-		pipelineCreateInfo->depthStencilState.depthBoundsTestEnable;
-	depthStencilStateCreateInfo.stencilTestEnable =
-		pipelineCreateInfo->depthStencilState.stencilTestEnable;
-	depthStencilStateCreateInfo.front = frontStencilState;
-	depthStencilStateCreateInfo.back = backStencilState;
-	depthStencilStateCreateInfo.minDepthBounds =
-		pipelineCreateInfo->depthStencilState.minDepthBounds;
-	depthStencilStateCreateInfo.maxDepthBounds =
-		pipelineCreateInfo->depthStencilState.maxDepthBounds;
+	VulkanTexture *currentTexture;
+	VulkanSampler *currentSampler;
+	uint32_t i, samplerCount;
+	VkDescriptorImageInfo descriptorImageInfos[MAX_TEXTURE_SAMPLERS];
 
-	/* Color Blend */
+	if (graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCache == NULL)
+	{
+		return;
+	}
 
-	for (i = 0; i < pipelineCreateInfo->attachmentInfo.colorAttachmentCount; i += 1)
+	samplerCount = graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCache->bindingCount;
+
+	for (i = 0; i < samplerCount; i += 1)
 	{
-		Refresh_ColorAttachmentBlendState blendState = pipelineCreateInfo->attachmentInfo.colorAttachmentDescriptions[i].blendState;
+		currentTexture = ((VulkanTextureContainer*) pTextures[i])->vulkanTexture;
+		descriptorImageInfos[i].imageView = currentTexture->view;
+		descriptorImageInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-		colorBlendAttachmentStates[i].blendEnable =
-			blendState.blendEnable;
-		colorBlendAttachmentStates[i].srcColorBlendFactor = RefreshToVK_BlendFactor[
-			blendState.srcColorBlendFactor
-		];
-		colorBlendAttachmentStates[i].dstColorBlendFactor = RefreshToVK_BlendFactor[
-			blendState.dstColorBlendFactor
-		];
-		colorBlendAttachmentStates[i].colorBlendOp = RefreshToVK_BlendOp[
-			blendState.colorBlendOp
-		];
-		colorBlendAttachmentStates[i].srcAlphaBlendFactor = RefreshToVK_BlendFactor[
-			blendState.srcAlphaBlendFactor
-		];
-		colorBlendAttachmentStates[i].dstAlphaBlendFactor = RefreshToVK_BlendFactor[
-			blendState.dstAlphaBlendFactor
-		];
-		colorBlendAttachmentStates[i].alphaBlendOp = RefreshToVK_BlendOp[
-			blendState.alphaBlendOp
-		];
-		colorBlendAttachmentStates[i].colorWriteMask =
-			blendState.colorWriteMask;
-	}
+		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, currentTexture);
 
-	colorBlendStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-	colorBlendStateCreateInfo.pNext = NULL;
-	colorBlendStateCreateInfo.flags = 0;
-	colorBlendStateCreateInfo.attachmentCount =
-		pipelineCreateInfo->attachmentInfo.colorAttachmentCount;
-	colorBlendStateCreateInfo.pAttachments =
-		colorBlendAttachmentStates;
-	colorBlendStateCreateInfo.blendConstants[0] =
-		pipelineCreateInfo->blendConstants[0];
-	colorBlendStateCreateInfo.blendConstants[1] =
-		pipelineCreateInfo->blendConstants[1];
-	colorBlendStateCreateInfo.blendConstants[2] =
-		pipelineCreateInfo->blendConstants[2];
-	colorBlendStateCreateInfo.blendConstants[3] =
-		pipelineCreateInfo->blendConstants[3];
+		/* The layout already holds the conversion sampler, pSamplers[i] is ignored */
+		if (graphicsPipeline->pipelineLayout->fragmentYCbCrSamplerMask & (1u << i))
+		{
+			descriptorImageInfos[i].sampler = graphicsPipeline->pipelineLayout->fragmentYCbCrSampler;
+			continue;
+		}
 
-	/* We don't support LogicOp, so this is easy. */
-	colorBlendStateCreateInfo.logicOpEnable = VK_FALSE;
-	colorBlendStateCreateInfo.logicOp = 0;
+		currentSampler = (VulkanSampler*) pSamplers[i];
+		descriptorImageInfos[i].sampler = currentSampler->sampler;
 
-	/* Pipeline Layout */
+		VULKAN_INTERNAL_TrackSampler(renderer, vulkanCommandBuffer, currentSampler);
+	}
 
-	graphicsPipeline->pipelineLayout = VULKAN_INTERNAL_FetchGraphicsPipelineLayout(
+	vulkanCommandBuffer->fragmentSamplerDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
 		renderer,
-		pipelineCreateInfo->vertexShaderInfo.samplerBindingCount,
-		pipelineCreateInfo->fragmentShaderInfo.samplerBindingCount
+		vulkanCommandBuffer,
+		graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCache,
+		descriptorImageInfos,
+		NULL
 	);
+}
 
-	/* Pipeline */
+static void VULKAN_INTERNAL_InvalidateBufferRange(
+	VulkanRenderer *renderer,
+	VulkanBuffer *buffer,
+	VkDeviceSize offset,
+	VkDeviceSize size
+) {
+	VulkanMemoryAllocation *allocation = buffer->usedRegion->allocation;
+	VkDeviceSize atomSize = renderer->physicalDeviceProperties.properties.limits.nonCoherentAtomSize;
+	VkMappedMemoryRange mappedMemoryRange;
+	VkDeviceSize start, end;
+	VkResult result;
 
-	vkPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-	vkPipelineCreateInfo.pNext = NULL;
-	vkPipelineCreateInfo.flags = 0;
-	vkPipelineCreateInfo.stageCount = 2;
-	vkPipelineCreateInfo.pStages = shaderStageCreateInfos;
-	vkPipelineCreateInfo.pVertexInputState = &vertexInputStateCreateInfo;
-	vkPipelineCreateInfo.pInputAssemblyState = &inputAssemblyStateCreateInfo;
-	vkPipelineCreateInfo.pTessellationState = VK_NULL_HANDLE;
-	vkPipelineCreateInfo.pViewportState = &viewportStateCreateInfo;
-	vkPipelineCreateInfo.pRasterizationState = &rasterizationStateCreateInfo;
-	vkPipelineCreateInfo.pMultisampleState = &multisampleStateCreateInfo;
-	vkPipelineCreateInfo.pDepthStencilState = &depthStencilStateCreateInfo;
-	vkPipelineCreateInfo.pColorBlendState = &colorBlendStateCreateInfo;
-	vkPipelineCreateInfo.pDynamicState = &dynamicStateCreateInfo;
-	vkPipelineCreateInfo.layout = graphicsPipeline->pipelineLayout->pipelineLayout;
-	vkPipelineCreateInfo.renderPass = transientRenderPass;
-	vkPipelineCreateInfo.subpass = 0;
-	vkPipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
-	vkPipelineCreateInfo.basePipelineIndex = 0;
+	if (	renderer->memoryProperties.memoryTypes[allocation->allocator->memoryTypeIndex].propertyFlags &
+		VK_MEMORY_PROPERTY_HOST_COHERENT_BIT	)
+	{
+		return;
+	}
 
-	/* TODO: enable pipeline caching */
-	vulkanResult = renderer->vkCreateGraphicsPipelines(
-		renderer->logicalDevice,
-		VK_NULL_HANDLE,
-		1,
-		&vkPipelineCreateInfo,
-		NULL,
-		&graphicsPipeline->pipeline
-	);
+	/* Ranges must be aligned to the atom size or end at the end of the memory */
 
-	SDL_stack_free(vertexInputBindingDescriptions);
-	SDL_stack_free(vertexInputAttributeDescriptions);
-	SDL_stack_free(colorBlendAttachmentStates);
+	start = buffer->usedRegion->resourceOffset + buffer->offset + offset;
+	end = start + size;
 
-	renderer->vkDestroyRenderPass(
+	start -= start % atomSize;
+	end = SDL_min(end + atomSize - 1 - ((end + atomSize - 1) % atomSize), allocation->size);
+
+	mappedMemoryRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+	mappedMemoryRange.pNext = NULL;
+	mappedMemoryRange.memory = allocation->memory;
+	mappedMemoryRange.offset = start;
+	mappedMemoryRange.size = end - start;
+
+	result = renderer->vkInvalidateMappedMemoryRanges(
 		renderer->logicalDevice,
-		transientRenderPass,
-		NULL
+		1,
+		&mappedMemoryRange
 	);
 
-	if (vulkanResult != VK_SUCCESS)
+	if (result != VK_SUCCESS)
 	{
-		SDL_free(graphicsPipeline);
-		LogVulkanResultAsError("vkCreateGraphicsPipelines", vulkanResult);
-		Refresh_LogError("Failed to create graphics pipeline!");
-		return NULL;
+		LogVulkanResultAsError("vkInvalidateMappedMemoryRanges", result);
 	}
-
-	SDL_AtomicSet(&graphicsPipeline->referenceCount, 0);
-
-	return (Refresh_GraphicsPipeline*) graphicsPipeline;
 }
 
-static VulkanComputePipelineLayout* VULKAN_INTERNAL_FetchComputePipelineLayout(
-	VulkanRenderer *renderer,
-	uint32_t bufferBindingCount,
-	uint32_t imageBindingCount
+static void VULKAN_GetBufferData(
+	Refresh_Renderer *driverData,
+	Refresh_Buffer *buffer,
+	void *data,
+	uint32_t dataLengthInBytes
 ) {
-	VkResult vulkanResult;
-	VkDescriptorSetLayout setLayouts[3];
-	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
-	ComputePipelineLayoutHash pipelineLayoutHash;
-	VulkanComputePipelineLayout *vulkanComputePipelineLayout;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanBuffer* vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
+	uint8_t *dataPtr = (uint8_t*) data;
+	uint8_t *mapPointer;
 
-	pipelineLayoutHash.bufferLayout = VULKAN_INTERNAL_FetchDescriptorSetLayout(
+	VULKAN_INTERNAL_InvalidateBufferRange(
 		renderer,
-		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-		bufferBindingCount,
-		VK_SHADER_STAGE_COMPUTE_BIT
+		vulkanBuffer,
+		0,
+		dataLengthInBytes
 	);
 
-	pipelineLayoutHash.imageLayout = VULKAN_INTERNAL_FetchDescriptorSetLayout(
-		renderer,
-		VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-		imageBindingCount,
-		VK_SHADER_STAGE_COMPUTE_BIT
+	mapPointer =
+		vulkanBuffer->usedRegion->allocation->mapPointer +
+		vulkanBuffer->usedRegion->resourceOffset +
+		vulkanBuffer->offset;
+
+	SDL_memcpy(
+		dataPtr,
+		mapPointer,
+		dataLengthInBytes
 	);
+}
 
-	pipelineLayoutHash.uniformLayout = renderer->computeUniformDescriptorSetLayout;
+static void* VULKAN_MapDynamicBuffer(
+	Refresh_Renderer *driverData,
+	Refresh_Buffer *buffer,
+	uint8_t cycle
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanBufferContainer *container = (VulkanBufferContainer*) buffer;
+	VulkanBuffer *vulkanBuffer;
+	uint32_t i;
 
-	vulkanComputePipelineLayout = ComputePipelineLayoutHashArray_Fetch(
-		&renderer->computePipelineLayoutHashTable,
-		pipelineLayoutHash
-	);
+	if (!container->dynamic)
+	{
+		Refresh_LogError("Buffer was not created with REFRESH_BUFFERUSAGE_DYNAMIC_BIT!");
+		return NULL;
+	}
 
-	if (vulkanComputePipelineLayout != NULL)
+	if (cycle && SDL_AtomicGet(&container->vulkanBuffer->referenceCount) > 0)
 	{
-		return vulkanComputePipelineLayout;
+		vulkanBuffer = NULL;
+
+		for (i = 0; i < container->versionCount; i += 1)
+		{
+			if (SDL_AtomicGet(&container->versions[i]->referenceCount) == 0)
+			{
+				vulkanBuffer = container->versions[i];
+				break;
+			}
+		}
+
+		/* Every version is in flight, add another */
+		if (vulkanBuffer == NULL)
+		{
+			vulkanBuffer = VULKAN_INTERNAL_CreateBuffer(
+				renderer,
+				container->vulkanBuffer->size,
+				container->vulkanBuffer->resourceAccessType,
+				container->vulkanBuffer->usage,
+				1,
+				container->vulkanBuffer->preferDeviceLocal,
+				container->vulkanBuffer->preferHostCached,
+				1,
+				0
+			);
+
+			if (vulkanBuffer == NULL)
+			{
+				Refresh_LogError("Failed to create dynamic buffer version!");
+				return NULL;
+			}
+
+			vulkanBuffer->container = container;
+
+			container->versions = SDL_realloc(
+				container->versions,
+				sizeof(VulkanBuffer*) * (container->versionCount + 1)
+			);
+			container->versions[container->versionCount] = vulkanBuffer;
+			container->versionCount += 1;
+		}
+
+		container->vulkanBuffer = vulkanBuffer;
 	}
 
-	vulkanComputePipelineLayout = SDL_malloc(sizeof(VulkanComputePipelineLayout));
+	vulkanBuffer = container->vulkanBuffer;
 
-	setLayouts[0] = pipelineLayoutHash.bufferLayout;
-	setLayouts[1] = pipelineLayoutHash.imageLayout;
-	setLayouts[2] = pipelineLayoutHash.uniformLayout;
+	return
+		vulkanBuffer->usedRegion->allocation->mapPointer +
+		vulkanBuffer->usedRegion->resourceOffset +
+		vulkanBuffer->offset;
+}
 
-	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-	pipelineLayoutCreateInfo.pNext = NULL;
-	pipelineLayoutCreateInfo.flags = 0;
-	pipelineLayoutCreateInfo.setLayoutCount = 3;
-	pipelineLayoutCreateInfo.pSetLayouts = setLayouts;
-	pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-	pipelineLayoutCreateInfo.pPushConstantRanges = NULL;
+/* Readbacks */
 
-	vulkanResult = renderer->vkCreatePipelineLayout(
-		renderer->logicalDevice,
-		&pipelineLayoutCreateInfo,
-		NULL,
-		&vulkanComputePipelineLayout->pipelineLayout
-	);
+static void VULKAN_INTERNAL_RetireReadbacks(
+	VulkanRenderer *renderer
+) {
+	VulkanReadbackRing *ring = &renderer->readbackRing;
+	VulkanReadback *readback;
 
-	if (vulkanResult != VK_SUCCESS)
+	/* Caller must hold the ring lock */
+
+	while (ring->readbackCount > 0)
 	{
-		LogVulkanResultAsError("vkCreatePipelineLayout", vulkanResult);
-		return NULL;
+		readback = ring->readbacks[ring->readbackStart];
+
+		if (!readback->released || readback->commandBuffer != NULL)
+		{
+			break;
+		}
+
+		ring->tail = readback->ringEnd;
+		ring->readbackStart = (ring->readbackStart + 1) % ring->readbackCapacity;
+		ring->readbackCount -= 1;
+
+		SDL_free(readback);
 	}
+}
 
-	ComputePipelineLayoutHashArray_Insert(
-		&renderer->computePipelineLayoutHashTable,
-		pipelineLayoutHash,
-		vulkanComputePipelineLayout
-	);
+static void VULKAN_INTERNAL_FreeReadback(
+	VulkanRenderer *renderer,
+	VulkanReadback *readback
+) {
+	VulkanReadbackRing *ring = &renderer->readbackRing;
+	uint32_t i;
 
-	/* If the binding count is 0
-	 * we can just bind the same descriptor set
-	 * so no cache is needed
-	 */
+	/* Caller must hold the ring lock */
 
-	if (bufferBindingCount == 0)
+	if (readback->fromRing)
 	{
-		vulkanComputePipelineLayout->bufferDescriptorSetCache = NULL;
+		/* Ring readbacks are freed in order */
+		VULKAN_INTERNAL_RetireReadbacks(renderer);
 	}
 	else
 	{
-		vulkanComputePipelineLayout->bufferDescriptorSetCache =
-			VULKAN_INTERNAL_CreateDescriptorSetCache(
-				renderer,
-				VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-				pipelineLayoutHash.bufferLayout,
-				bufferBindingCount
-			);
+		for (i = 0; i < ring->dedicatedReadbackCount; i += 1)
+		{
+			if (ring->dedicatedReadbacks[i] == readback)
+			{
+				ring->dedicatedReadbacks[i] = ring->dedicatedReadbacks[ring->dedicatedReadbackCount - 1];
+				ring->dedicatedReadbackCount -= 1;
+				break;
+			}
+		}
+
+		VULKAN_INTERNAL_QueueDestroyBuffer(renderer, readback->buffer);
+		SDL_free(readback);
 	}
+}
 
-	if (imageBindingCount == 0)
+static VulkanReadback* VULKAN_INTERNAL_AcquireReadback(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VkDeviceSize size
+) {
+	VulkanReadbackRing *ring = &renderer->readbackRing;
+	VulkanReadback *readback;
+	VkDeviceSize alignment;
+	uint64_t start;
+	uint64_t end;
+
+	/* Satisfies both buffer copies and texel block alignment */
+	alignment = SDL_max(
+		renderer->physicalDeviceProperties.properties.limits.optimalBufferCopyOffsetAlignment,
+		16
+	);
+
+	readback = SDL_malloc(sizeof(VulkanReadback));
+	readback->size = size;
+	readback->fromRing = 0;
+	readback->ringEnd = 0;
+	readback->commandBuffer = commandBuffer;
+	readback->fence = VK_NULL_HANDLE;
+	readback->released = 0;
+
+	SDL_LockMutex(ring->lock);
+
+	if (ring->buffer != NULL && size <= ring->size)
 	{
-		vulkanComputePipelineLayout->imageDescriptorSetCache = NULL;
+		VULKAN_INTERNAL_RetireReadbacks(renderer);
+
+		start = ring->head + alignment - 1;
+		start -= start % alignment;
+
+		/* Allocations never straddle the end of the buffer */
+
+		if ((start % ring->size) + size > ring->size)
+		{
+			start += ring->size - (start % ring->size);
+		}
+
+		end = start + size;
+
+		if (ring->readbackCount == 0)
+		{
+			/* Nothing is outstanding, only skipped space remains */
+			ring->tail = start;
+		}
+
+		if (end - ring->tail <= ring->size)
+		{
+			if (ring->readbackCount == ring->readbackCapacity)
+			{
+				ring->readbacks = SDL_realloc(
+					ring->readbacks,
+					ring->readbackCapacity * 2 * sizeof(VulkanReadback*)
+				);
+
+				/* Unwrap the entries that sat before the old end */
+				SDL_memcpy(
+					ring->readbacks + ring->readbackCapacity,
+					ring->readbacks,
+					ring->readbackStart * sizeof(VulkanReadback*)
+				);
+
+				ring->readbackCapacity *= 2;
+			}
+
+			ring->readbacks[
+				(ring->readbackStart + ring->readbackCount) % ring->readbackCapacity
+			] = readback;
+			ring->readbackCount += 1;
+
+			readback->buffer = ring->buffer;
+			readback->offset = start % ring->size;
+			readback->fromRing = 1;
+			readback->ringEnd = end;
+
+			ring->head = end;
+		}
 	}
-	else
+
+	SDL_UnlockMutex(ring->lock);
+
+	/* The ring is full or held up by an unreleased readback */
+
+	if (!readback->fromRing)
 	{
-		vulkanComputePipelineLayout->imageDescriptorSetCache =
-			VULKAN_INTERNAL_CreateDescriptorSetCache(
-				renderer,
-				VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-				pipelineLayoutHash.imageLayout,
-				imageBindingCount
-			);
-	}
+		readback->buffer = VULKAN_INTERNAL_CreateBuffer(
+			renderer,
+			size,
+			RESOURCE_ACCESS_TRANSFER_WRITE,
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			1,
+			0,
+			1,
+			1,
+			0
+		);
+
+		if (readback->buffer == NULL)
+		{
+			Refresh_LogError("Failed to create readback buffer!");
+			SDL_free(readback);
+			return NULL;
+		}
+
+		readback->offset = 0;
+
+		SDL_LockMutex(ring->lock);
 
-	return vulkanComputePipelineLayout;
-}
+		EXPAND_ARRAY_IF_NEEDED(
+			ring->dedicatedReadbacks,
+			VulkanReadback*,
+			ring->dedicatedReadbackCount + 1,
+			ring->dedicatedReadbackCapacity,
+			ring->dedicatedReadbackCapacity * 2
+		)
 
-static Refresh_ComputePipeline* VULKAN_CreateComputePipeline(
-	Refresh_Renderer *driverData,
-	Refresh_ComputeShaderInfo *computeShaderInfo
-) {
-	VkComputePipelineCreateInfo computePipelineCreateInfo;
-	VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo;
+		ring->dedicatedReadbacks[ring->dedicatedReadbackCount] = readback;
+		ring->dedicatedReadbackCount += 1;
 
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanComputePipeline *vulkanComputePipeline = SDL_malloc(sizeof(VulkanComputePipeline));
+		SDL_UnlockMutex(ring->lock);
+	}
 
-	vulkanComputePipeline->computeShaderModule = (VulkanShaderModule*) computeShaderInfo->shaderModule;
-	SDL_AtomicIncRef(&vulkanComputePipeline->computeShaderModule->referenceCount);
+	EXPAND_ARRAY_IF_NEEDED(
+		commandBuffer->readbacks,
+		VulkanReadback*,
+		commandBuffer->readbackCount + 1,
+		commandBuffer->readbackCapacity,
+		commandBuffer->readbackCapacity + 4
+	)
 
-	pipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-	pipelineShaderStageCreateInfo.pNext = NULL;
-	pipelineShaderStageCreateInfo.flags = 0;
-	pipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-	pipelineShaderStageCreateInfo.module = vulkanComputePipeline->computeShaderModule->shaderModule;
-	pipelineShaderStageCreateInfo.pName = computeShaderInfo->entryPointName;
-	pipelineShaderStageCreateInfo.pSpecializationInfo = NULL;
+	commandBuffer->readbacks[commandBuffer->readbackCount] = readback;
+	commandBuffer->readbackCount += 1;
 
-	vulkanComputePipeline->pipelineLayout = VULKAN_INTERNAL_FetchComputePipelineLayout(
-		renderer,
-		computeShaderInfo->bufferBindingCount,
-		computeShaderInfo->imageBindingCount
-	);
+	return readback;
+}
 
-	computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-	computePipelineCreateInfo.pNext = NULL;
-	computePipelineCreateInfo.flags = 0;
-	computePipelineCreateInfo.stage = pipelineShaderStageCreateInfo;
-	computePipelineCreateInfo.layout =
-		vulkanComputePipeline->pipelineLayout->pipelineLayout;
-	computePipelineCreateInfo.basePipelineHandle = NULL;
-	computePipelineCreateInfo.basePipelineIndex = 0;
+static void VULKAN_INTERNAL_ReadbackHostBarrier(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VulkanReadback *readback
+) {
+	VkBufferMemoryBarrier memoryBarrier;
 
-	renderer->vkCreateComputePipelines(
-		renderer->logicalDevice,
+	/* Makes the copy visible to the host once the fence signals */
+
+	memoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	memoryBarrier.pNext = NULL;
+	memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+	memoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	memoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	memoryBarrier.buffer = readback->buffer->buffer;
+	memoryBarrier.offset = readback->offset;
+	memoryBarrier.size = readback->size;
+
+	renderer->vkCmdPipelineBarrier(
+		commandBuffer->commandBuffer,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_HOST_BIT,
+		0,
+		0,
 		NULL,
 		1,
-		&computePipelineCreateInfo,
-		NULL,
-		&vulkanComputePipeline->pipeline
+		&memoryBarrier,
+		0,
+		NULL
 	);
-
-	vulkanComputePipeline->uniformBlockSize =
-		VULKAN_INTERNAL_NextHighestAlignment(
-			computeShaderInfo->uniformBufferSize,
-			renderer->minUBOAlignment
-		);
-
-	SDL_AtomicSet(&vulkanComputePipeline->referenceCount, 0);
-
-	return (Refresh_ComputePipeline*) vulkanComputePipeline;
 }
 
-static Refresh_Sampler* VULKAN_CreateSampler(
+static Refresh_Readback* VULKAN_DownloadBuffer(
 	Refresh_Renderer *driverData,
-	Refresh_SamplerStateCreateInfo *samplerStateCreateInfo
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t sizeInBytes
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
-	VulkanSampler *vulkanSampler = SDL_malloc(sizeof(VulkanSampler));
-	VkResult vulkanResult;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
+	VulkanReadback *readback;
+	VulkanResourceAccessType prevResourceAccess;
+	VkBufferCopy bufferCopy;
 
-	VkSamplerCreateInfo vkSamplerCreateInfo;
-	vkSamplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-	vkSamplerCreateInfo.pNext = NULL;
-	vkSamplerCreateInfo.flags = 0;
-	vkSamplerCreateInfo.magFilter = RefreshToVK_Filter[
-		samplerStateCreateInfo->magFilter
-	];
-	vkSamplerCreateInfo.minFilter = RefreshToVK_Filter[
-		samplerStateCreateInfo->minFilter
-	];
-	vkSamplerCreateInfo.mipmapMode = RefreshToVK_SamplerMipmapMode[
-		samplerStateCreateInfo->mipmapMode
-	];
-	vkSamplerCreateInfo.addressModeU = RefreshToVK_SamplerAddressMode[
-		samplerStateCreateInfo->addressModeU
-	];
-	vkSamplerCreateInfo.addressModeV = RefreshToVK_SamplerAddressMode[
-		samplerStateCreateInfo->addressModeV
-	];
-	vkSamplerCreateInfo.addressModeW = RefreshToVK_SamplerAddressMode[
-		samplerStateCreateInfo->addressModeW
-	];
-	vkSamplerCreateInfo.mipLodBias = samplerStateCreateInfo->mipLodBias;
-	vkSamplerCreateInfo.anisotropyEnable = samplerStateCreateInfo->anisotropyEnable;
-	vkSamplerCreateInfo.maxAnisotropy = samplerStateCreateInfo->maxAnisotropy;
-	vkSamplerCreateInfo.compareEnable = samplerStateCreateInfo->compareEnable;
-	vkSamplerCreateInfo.compareOp = RefreshToVK_CompareOp[
-		samplerStateCreateInfo->compareOp
-	];
-	vkSamplerCreateInfo.minLod = samplerStateCreateInfo->minLod;
-	vkSamplerCreateInfo.maxLod = samplerStateCreateInfo->maxLod;
-	vkSamplerCreateInfo.borderColor = RefreshToVK_BorderColor[
-		samplerStateCreateInfo->borderColor
-	];
-	vkSamplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+	if (vulkanCommandBuffer->isTransfer)
+	{
+		Refresh_LogError("Readbacks must be recorded on a graphics command buffer!");
+		return NULL;
+	}
 
-	vulkanResult = renderer->vkCreateSampler(
-		renderer->logicalDevice,
-		&vkSamplerCreateInfo,
-		NULL,
-		&vulkanSampler->sampler
+	readback = VULKAN_INTERNAL_AcquireReadback(
+		renderer,
+		vulkanCommandBuffer,
+		sizeInBytes
 	);
 
-	if (vulkanResult != VK_SUCCESS)
+	if (readback == NULL)
 	{
-		SDL_free(vulkanSampler);
-		LogVulkanResultAsError("vkCreateSampler", vulkanResult);
 		return NULL;
 	}
 
-	SDL_AtomicSet(&vulkanSampler->referenceCount, 0);
+	VULKAN_INTERNAL_FlushBufferUploads(renderer, vulkanCommandBuffer);
 
-	return (Refresh_Sampler*) vulkanSampler;
-}
+	/* Cache this so we can restore it later */
+	prevResourceAccess = vulkanBuffer->resourceAccessType;
 
-static Refresh_ShaderModule* VULKAN_CreateShaderModule(
-	Refresh_Renderer *driverData,
-	Refresh_ShaderModuleCreateInfo *shaderModuleCreateInfo
-) {
-	VulkanShaderModule *vulkanShaderModule = SDL_malloc(sizeof(VulkanShaderModule));
-	VkResult vulkanResult;
-	VkShaderModuleCreateInfo vkShaderModuleCreateInfo;
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_READ,
+		vulkanBuffer
+	);
 
-	vkShaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-	vkShaderModuleCreateInfo.pNext = NULL;
-	vkShaderModuleCreateInfo.flags = 0;
-	vkShaderModuleCreateInfo.codeSize = shaderModuleCreateInfo->codeSize;
-	vkShaderModuleCreateInfo.pCode = (uint32_t*) shaderModuleCreateInfo->byteCode;
+	bufferCopy.srcOffset = vulkanBuffer->offset + offsetInBytes;
+	bufferCopy.dstOffset = readback->offset;
+	bufferCopy.size = sizeInBytes;
 
-	vulkanResult = renderer->vkCreateShaderModule(
-		renderer->logicalDevice,
-		&vkShaderModuleCreateInfo,
-		NULL,
-		&vulkanShaderModule->shaderModule
+	renderer->vkCmdCopyBuffer(
+		vulkanCommandBuffer->commandBuffer,
+		vulkanBuffer->buffer,
+		readback->buffer->buffer,
+		1,
+		&bufferCopy
 	);
 
-	if (vulkanResult != VK_SUCCESS)
-	{
-		SDL_free(vulkanShaderModule);
-		LogVulkanResultAsError("vkCreateShaderModule", vulkanResult);
-		Refresh_LogError("Failed to create shader module!");
-		return NULL;
-	}
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		prevResourceAccess,
+		vulkanBuffer
+	);
 
-	SDL_AtomicSet(&vulkanShaderModule->referenceCount, 0);
+	VULKAN_INTERNAL_ReadbackHostBarrier(renderer, vulkanCommandBuffer, readback);
 
-	return (Refresh_ShaderModule*) vulkanShaderModule;
+	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
+
+	return (Refresh_Readback*) readback;
 }
 
-static Refresh_Texture* VULKAN_CreateTexture(
+static Refresh_Readback* VULKAN_DownloadTexture(
 	Refresh_Renderer *driverData,
-	Refresh_TextureCreateInfo *textureCreateInfo
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlice
 ) {
 	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VkImageUsageFlags imageUsageFlags = (
-		VK_IMAGE_USAGE_TRANSFER_DST_BIT |
-		VK_IMAGE_USAGE_TRANSFER_SRC_BIT
-	);
-	VkImageAspectFlags imageAspectFlags;
-	uint8_t isDepthFormat = IsRefreshDepthFormat(textureCreateInfo->format);
-	VkFormat format;
-	VulkanTextureContainer *container;
-	VulkanTexture *vulkanTexture;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanTexture *vulkanTexture = ((VulkanTextureContainer*) textureSlice->texture)->vulkanTexture;
+	VulkanReadback *readback;
+	VulkanResourceAccessType prevResourceAccess;
+	VkBufferImageCopy imageCopy;
 
-	if (isDepthFormat)
-	{
-		format = RefreshToVK_DepthFormat(renderer, textureCreateInfo->format);
-	}
-	else
+	if (vulkanCommandBuffer->isTransfer)
 	{
-		format = RefreshToVK_SurfaceFormat[textureCreateInfo->format];
+		Refresh_LogError("Readbacks must be recorded on a graphics command buffer!");
+		return NULL;
 	}
 
-	if (textureCreateInfo->usageFlags & REFRESH_TEXTUREUSAGE_SAMPLER_BIT)
-	{
-		imageUsageFlags |= VK_IMAGE_USAGE_SAMPLED_BIT;
-	}
+	readback = VULKAN_INTERNAL_AcquireReadback(
+		renderer,
+		vulkanCommandBuffer,
+		VULKAN_INTERNAL_BytesPerImage(
+			textureSlice->rectangle.w,
+			textureSlice->rectangle.h,
+			vulkanTexture->format
+		)
+	);
 
-	if (textureCreateInfo->usageFlags & REFRESH_TEXTUREUSAGE_COLOR_TARGET_BIT)
+	if (readback == NULL)
 	{
-		imageUsageFlags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		return NULL;
 	}
 
-	if (textureCreateInfo->usageFlags & REFRESH_TEXTUREUSAGE_DEPTH_STENCIL_TARGET_BIT)
-	{
-		imageUsageFlags |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-	}
+	VULKAN_INTERNAL_FlushBufferUploads(renderer, vulkanCommandBuffer);
 
-	if (textureCreateInfo->usageFlags & REFRESH_TEXTUREUSAGE_COMPUTE_BIT)
-	{
-		imageUsageFlags |= VK_IMAGE_USAGE_STORAGE_BIT;
-	}
+	/* Cache this so we can restore it later */
+	prevResourceAccess = *VULKAN_INTERNAL_SubresourceAccessType(
+		vulkanTexture,
+		textureSlice->layer,
+		textureSlice->level
+	);
 
-	if (isDepthFormat)
-	{
-		imageAspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
+	VULKAN_INTERNAL_ImageMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_READ,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		textureSlice->layer,
+		1,
+		textureSlice->level,
+		1,
+		0,
+		vulkanTexture
+	);
+
+	imageCopy.imageExtent.width = textureSlice->rectangle.w;
+	imageCopy.imageExtent.height = textureSlice->rectangle.h;
+	imageCopy.imageExtent.depth = 1;
+	imageCopy.bufferRowLength = textureSlice->rectangle.w;
+	imageCopy.bufferImageHeight = textureSlice->rectangle.h;
+	imageCopy.imageOffset.x = textureSlice->rectangle.x;
+	imageCopy.imageOffset.y = textureSlice->rectangle.y;
+	imageCopy.imageOffset.z = textureSlice->depth;
+	imageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	imageCopy.imageSubresource.baseArrayLayer = textureSlice->layer;
+	imageCopy.imageSubresource.layerCount = 1;
+	imageCopy.imageSubresource.mipLevel = textureSlice->level;
+	imageCopy.bufferOffset = readback->offset;
 
-		if (IsStencilFormat(format))
-		{
-			imageAspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
-		}
-	}
-	else
-	{
-		imageAspectFlags = VK_IMAGE_ASPECT_COLOR_BIT;
-	}
+	renderer->vkCmdCopyImageToBuffer(
+		vulkanCommandBuffer->commandBuffer,
+		vulkanTexture->image,
+		AccessMap[RESOURCE_ACCESS_TRANSFER_READ].imageLayout,
+		readback->buffer->buffer,
+		1,
+		&imageCopy
+	);
 
-	vulkanTexture = VULKAN_INTERNAL_CreateTexture(
+	/* Restore the image layout */
+
+	VULKAN_INTERNAL_ImageMemoryBarrier(
 		renderer,
-		textureCreateInfo->width,
-		textureCreateInfo->height,
-		textureCreateInfo->depth,
-		textureCreateInfo->isCube,
-		textureCreateInfo->levelCount,
-		isDepthFormat ?
-			textureCreateInfo->sampleCount : /* depth textures do not have a separate msaaTex */
-			REFRESH_SAMPLECOUNT_1,
-		format,
-		imageAspectFlags,
-		imageUsageFlags
+		vulkanCommandBuffer->commandBuffer,
+		prevResourceAccess,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		textureSlice->layer,
+		1,
+		textureSlice->level,
+		1,
+		0,
+		vulkanTexture
 	);
 
-	/* create the MSAA texture for color attachments, if needed */
-	if (	vulkanTexture != NULL &&
-		!isDepthFormat &&
-		textureCreateInfo->sampleCount > REFRESH_SAMPLECOUNT_1	)
-	{
-		vulkanTexture->msaaTex = VULKAN_INTERNAL_CreateTexture(
-			renderer,
-			textureCreateInfo->width,
-			textureCreateInfo->height,
-			textureCreateInfo->depth,
-			textureCreateInfo->isCube,
-			textureCreateInfo->levelCount,
-			textureCreateInfo->sampleCount,
-			format,
-			imageAspectFlags,
-			imageUsageFlags
-		);
-	}
+	VULKAN_INTERNAL_ReadbackHostBarrier(renderer, vulkanCommandBuffer, readback);
 
-	container = SDL_malloc(sizeof(VulkanTextureContainer));
-	container->vulkanTexture = vulkanTexture;
-	vulkanTexture->container = container;
+	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, vulkanTexture);
 
-	return (Refresh_Texture*) container;
+	return (Refresh_Readback*) readback;
 }
 
-static Refresh_Buffer* VULKAN_CreateBuffer(
+static int VULKAN_QueryReadback(
 	Refresh_Renderer *driverData,
-	Refresh_BufferUsageFlags usageFlags,
-	uint32_t sizeInBytes
+	Refresh_Readback *readback
 ) {
-	VulkanResourceAccessType resourceAccessType;
-	VkBufferUsageFlags vulkanUsageFlags =
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanReadback *vulkanReadback = (VulkanReadback*) readback;
+	VkResult result;
+	int status;
 
-	if (usageFlags == 0)
-	{
-		resourceAccessType = RESOURCE_ACCESS_TRANSFER_READ_WRITE;
-	}
+	/* The fence is only valid until the command buffer is cleaned */
+	SDL_LockMutex(renderer->submitLock);
 
-	if (usageFlags & REFRESH_BUFFERUSAGE_VERTEX_BIT)
+	if (vulkanReadback->commandBuffer == NULL)
 	{
-		vulkanUsageFlags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-		resourceAccessType = RESOURCE_ACCESS_VERTEX_BUFFER;
+		status = 1;
 	}
-
-	if (usageFlags & REFRESH_BUFFERUSAGE_INDEX_BIT)
+	else if (vulkanReadback->fence == VK_NULL_HANDLE)
 	{
-		vulkanUsageFlags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
-		resourceAccessType = RESOURCE_ACCESS_INDEX_BUFFER;
+		status = 0;
 	}
-
-	if (usageFlags & REFRESH_BUFFERUSAGE_COMPUTE_BIT)
+	else
 	{
-		vulkanUsageFlags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-		resourceAccessType = RESOURCE_ACCESS_COMPUTE_SHADER_BUFFER_READ_WRITE;
-	}
+		result = renderer->vkGetFenceStatus(
+			renderer->logicalDevice,
+			vulkanReadback->fence
+		);
 
-	if (usageFlags & REFRESH_BUFFERUSAGE_INDIRECT_BIT)
-	{
-		vulkanUsageFlags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
-		resourceAccessType = RESOURCE_ACCESS_INDIRECT_BUFFER;
+		if (result == VK_SUCCESS)
+		{
+			status = 1;
+		}
+		else if (result == VK_NOT_READY)
+		{
+			status = 0;
+		}
+		else
+		{
+			LogVulkanResultAsError("vkGetFenceStatus", result);
+			status = -1;
+		}
 	}
 
-	return (Refresh_Buffer*) VULKAN_INTERNAL_CreateBufferContainer(
-		(VulkanRenderer*) driverData,
-		sizeInBytes,
-		resourceAccessType,
-		vulkanUsageFlags
-	);
-}
+	SDL_UnlockMutex(renderer->submitLock);
 
-/* Setters */
+	return status;
+}
 
-static VulkanTransferBuffer* VULKAN_INTERNAL_AcquireTransferBuffer(
-	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
-	VkDeviceSize requiredSize,
-	VkDeviceSize alignment
+static void VULKAN_WaitForReadback(
+	Refresh_Renderer *driverData,
+	Refresh_Readback *readback
 ) {
-	VkDeviceSize size;
-	VkDeviceSize offset;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanReadback *vulkanReadback = (VulkanReadback*) readback;
+	VkFence fence;
+	VkResult result;
 	uint32_t i;
-	VulkanTransferBuffer *transferBuffer;
 
-	/* Search the command buffer's current transfer buffers */
+	/* Rather than holding the submit lock for the whole wait we wait in
+	 * slices and check again. Cleaning the command buffer would normally
+	 * recycle its fence, so while we wait the fence is held back instead,
+	 * otherwise a resubmitted fence could keep us waiting on unrelated work.
+	 */
+	SDL_LockMutex(renderer->submitLock);
 
-	for (i = 0; i < commandBuffer->transferBufferCount; i += 1)
+	if (vulkanReadback->commandBuffer == NULL)
 	{
-		transferBuffer = commandBuffer->transferBuffers[i];
-		offset = transferBuffer->offset + alignment - (transferBuffer->offset % alignment);
-
-		if (offset + requiredSize <= transferBuffer->buffer->size)
-		{
-			transferBuffer->offset = offset;
-			return transferBuffer;
-		}
+		SDL_UnlockMutex(renderer->submitLock);
+		return;
 	}
 
-	/* Nothing fits, can we get a transfer buffer from the pool? */
-
-	SDL_LockMutex(renderer->transferBufferPool.lock);
+	fence = vulkanReadback->fence;
 
-	for (i = 0; i < renderer->transferBufferPool.availableBufferCount; i += 1)
+	if (fence == VK_NULL_HANDLE)
 	{
-		transferBuffer = renderer->transferBufferPool.availableBuffers[i];
-		offset = transferBuffer->offset + alignment - (transferBuffer->offset % alignment);
+		SDL_UnlockMutex(renderer->submitLock);
+		Refresh_LogError("Readback command buffer has not been submitted!");
+		return;
+	}
 
-		if (offset + requiredSize <= transferBuffer->buffer->size)
-		{
-			if (commandBuffer->transferBufferCount == commandBuffer->transferBufferCapacity)
-			{
-				commandBuffer->transferBufferCapacity *= 2;
-				commandBuffer->transferBuffers = SDL_realloc(
-					commandBuffer->transferBuffers,
-					commandBuffer->transferBufferCapacity * sizeof(VulkanTransferBuffer*)
-				);
-			}
+	renderer->readbackWaiterCount += 1;
 
-			commandBuffer->transferBuffers[commandBuffer->transferBufferCount] = transferBuffer;
-			commandBuffer->transferBufferCount += 1;
+	SDL_UnlockMutex(renderer->submitLock);
 
-			renderer->transferBufferPool.availableBuffers[i] = renderer->transferBufferPool.availableBuffers[renderer->transferBufferPool.availableBufferCount - 1];
-			renderer->transferBufferPool.availableBufferCount -= 1;
-			SDL_UnlockMutex(renderer->transferBufferPool.lock);
+	do
+	{
+		result = renderer->vkWaitForFences(
+			renderer->logicalDevice,
+			1,
+			&fence,
+			VK_TRUE,
+			READBACK_WAIT_SLICE
+		);
+	} while (result == VK_TIMEOUT);
 
-			transferBuffer->offset = offset;
-			return transferBuffer;
-		}
+	if (result != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkWaitForFences", result);
 	}
 
-	SDL_UnlockMutex(renderer->transferBufferPool.lock);
-
-	/* Nothing fits, so let's create a new transfer buffer */
+	SDL_LockMutex(renderer->submitLock);
 
-	size = TRANSFER_BUFFER_STARTING_SIZE;
+	renderer->readbackWaiterCount -= 1;
 
-	while (size < requiredSize)
+	if (renderer->readbackWaiterCount == 0)
 	{
-		size *= 2;
+		for (i = 0; i < renderer->deferredReadbackFenceCount; i += 1)
+		{
+			VULKAN_INTERNAL_ReturnFenceToPool(
+				renderer,
+				renderer->deferredReadbackFences[i]
+			);
+		}
+
+		renderer->deferredReadbackFenceCount = 0;
 	}
 
-	transferBuffer = SDL_malloc(sizeof(VulkanTransferBuffer));
-	transferBuffer->offset = 0;
-	transferBuffer->buffer = VULKAN_INTERNAL_CreateBuffer(
+	SDL_UnlockMutex(renderer->submitLock);
+}
+
+static void* VULKAN_GetReadbackData(
+	Refresh_Renderer *driverData,
+	Refresh_Readback *readback
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanReadback *vulkanReadback = (VulkanReadback*) readback;
+
+	VULKAN_INTERNAL_InvalidateBufferRange(
 		renderer,
-		size,
-		RESOURCE_ACCESS_TRANSFER_READ_WRITE,
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-		1,
-		0,
-		1
+		vulkanReadback->buffer,
+		vulkanReadback->offset,
+		vulkanReadback->size
 	);
-	transferBuffer->fromPool = 0;
 
-	if (transferBuffer->buffer == NULL)
-	{
-		Refresh_LogError("Failed to allocate transfer buffer!");
-		SDL_free(transferBuffer);
-		return NULL;
-	}
+	return
+		vulkanReadback->buffer->usedRegion->allocation->mapPointer +
+		vulkanReadback->buffer->usedRegion->resourceOffset +
+		vulkanReadback->offset;
+}
 
-	if (commandBuffer->transferBufferCount == commandBuffer->transferBufferCapacity)
+static void VULKAN_ReleaseReadback(
+	Refresh_Renderer *driverData,
+	Refresh_Readback *readback
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanReadback *vulkanReadback = (VulkanReadback*) readback;
+
+	SDL_LockMutex(renderer->readbackRing.lock);
+
+	vulkanReadback->released = 1;
+
+	/* Otherwise the command buffer frees it when it is cleaned */
+	if (vulkanReadback->commandBuffer == NULL)
 	{
-		commandBuffer->transferBufferCapacity *= 2;
-		commandBuffer->transferBuffers = SDL_realloc(
-			commandBuffer->transferBuffers,
-			commandBuffer->transferBufferCapacity * sizeof(VulkanTransferBuffer*)
-		);
+		VULKAN_INTERNAL_FreeReadback(renderer, vulkanReadback);
 	}
 
-	commandBuffer->transferBuffers[commandBuffer->transferBufferCount] = transferBuffer;
-	commandBuffer->transferBufferCount += 1;
-
-	return transferBuffer;
+	SDL_UnlockMutex(renderer->readbackRing.lock);
 }
 
-static void VULKAN_SetTextureData(
+static void VULKAN_CopyTextureToBuffer(
 	Refresh_Renderer *driverData,
 	Refresh_CommandBuffer *commandBuffer,
 	Refresh_TextureSlice *textureSlice,
-	void *data,
-	uint32_t dataLengthInBytes
+	Refresh_Buffer *buffer
 ) {
 	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanTexture *vulkanTexture = ((VulkanTextureContainer*) textureSlice->texture)->vulkanTexture;
 	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanTransferBuffer *transferBuffer;
-	VkBufferImageCopy imageCopy;
-	uint8_t *stagingBufferPointer;
-	uint32_t blockSize = VULKAN_INTERNAL_TextureBlockSize(vulkanTexture->format);
-	uint32_t bufferRowLength;
-	uint32_t bufferImageHeight;
-
-	transferBuffer = VULKAN_INTERNAL_AcquireTransferBuffer(
-		renderer,
-		vulkanCommandBuffer,
-		VULKAN_INTERNAL_BytesPerImage(
-			textureSlice->rectangle.w,
-			textureSlice->rectangle.h,
-			vulkanTexture->format
-		),
-		VULKAN_INTERNAL_BytesPerPixel(vulkanTexture->format)
-	);
+	VulkanTexture *vulkanTexture = ((VulkanTextureContainer*) textureSlice->texture)->vulkanTexture;
+	VulkanBuffer* vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
 
-	if (transferBuffer == NULL)
-	{
-		return;
-	}
+	VulkanResourceAccessType prevResourceAccess;
+	VkBufferImageCopy imageCopy;
 
-	stagingBufferPointer =
-		transferBuffer->buffer->usedRegion->allocation->mapPointer +
-		transferBuffer->buffer->usedRegion->resourceOffset +
-		transferBuffer->offset;
+	VULKAN_INTERNAL_FlushBufferUploads(renderer, vulkanCommandBuffer);
 
-	SDL_memcpy(
-		stagingBufferPointer,
-		data,
-		dataLengthInBytes
+	/* Cache this so we can restore it later */
+	prevResourceAccess = *VULKAN_INTERNAL_SubresourceAccessType(
+		vulkanTexture,
+		textureSlice->layer,
+		textureSlice->level
 	);
 
-	/* TODO: is it worth it to only transition the specific subresource? */
 	VULKAN_INTERNAL_ImageMemoryBarrier(
 		renderer,
 		vulkanCommandBuffer->commandBuffer,
-		RESOURCE_ACCESS_TRANSFER_WRITE,
+		RESOURCE_ACCESS_TRANSFER_READ,
 		VK_IMAGE_ASPECT_COLOR_BIT,
+		textureSlice->layer,
+		1,
+		textureSlice->level,
+		1,
 		0,
-		vulkanTexture->layerCount,
-		0,
-		vulkanTexture->levelCount,
-		0,
-		vulkanTexture->image,
-		&vulkanTexture->resourceAccessType
+		vulkanTexture
 	);
 
-	bufferRowLength = SDL_max(blockSize, textureSlice->rectangle.w);
-	bufferImageHeight = SDL_max(blockSize, textureSlice->rectangle.h);
+	/* Save texture data to buffer */
 
 	imageCopy.imageExtent.width = textureSlice->rectangle.w;
 	imageCopy.imageExtent.height = textureSlice->rectangle.h;
 	imageCopy.imageExtent.depth = 1;
+	imageCopy.bufferRowLength = textureSlice->rectangle.w;
+	imageCopy.bufferImageHeight = textureSlice->rectangle.h;
 	imageCopy.imageOffset.x = textureSlice->rectangle.x;
 	imageCopy.imageOffset.y = textureSlice->rectangle.y;
 	imageCopy.imageOffset.z = textureSlice->depth;
@@ -7301,3489 +12858,3718 @@ static void VULKAN_SetTextureData(
 	imageCopy.imageSubresource.baseArrayLayer = textureSlice->layer;
 	imageCopy.imageSubresource.layerCount = 1;
 	imageCopy.imageSubresource.mipLevel = textureSlice->level;
-	imageCopy.bufferOffset = transferBuffer->offset;
-	imageCopy.bufferRowLength = bufferRowLength;
-	imageCopy.bufferImageHeight = bufferImageHeight;
+	imageCopy.bufferOffset = vulkanBuffer->offset;
 
-	renderer->vkCmdCopyBufferToImage(
+	renderer->vkCmdCopyImageToBuffer(
 		vulkanCommandBuffer->commandBuffer,
-		transferBuffer->buffer->buffer,
 		vulkanTexture->image,
-		AccessMap[vulkanTexture->resourceAccessType].imageLayout,
+		AccessMap[RESOURCE_ACCESS_TRANSFER_READ].imageLayout,
+		vulkanBuffer->buffer,
 		1,
 		&imageCopy
 	);
 
-	transferBuffer->offset += dataLengthInBytes;
+	/* Restore the image layout */
 
-	if (vulkanTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
-	{
-		/* TODO: is it worth it to only transition the specific subresource? */
-		VULKAN_INTERNAL_ImageMemoryBarrier(
-			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
-			VK_IMAGE_ASPECT_COLOR_BIT,
-			0,
-			vulkanTexture->layerCount,
-			0,
-			vulkanTexture->levelCount,
-			0,
-			vulkanTexture->image,
-			&vulkanTexture->resourceAccessType
-		);
-	}
+	VULKAN_INTERNAL_ImageMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		prevResourceAccess,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		textureSlice->layer,
+		1,
+		textureSlice->level,
+		1,
+		0,
+		vulkanTexture
+	);
 
+	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
 	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, vulkanTexture);
 }
 
-static void VULKAN_SetTextureDataYUV(
+static void VULKAN_CopyBufferToBuffer(
 	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer* commandBuffer,
-	Refresh_Texture *y,
-	Refresh_Texture *u,
-	Refresh_Texture *v,
-	uint32_t yWidth,
-	uint32_t yHeight,
-	uint32_t uvWidth,
-	uint32_t uvHeight,
-	void *yDataPtr,
-	void *uDataPtr,
-	void *vDataPtr,
-	uint32_t yDataLength,
-	uint32_t uvDataLength,
-	uint32_t yStride,
-	uint32_t uvStride
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *source,
+	Refresh_Buffer *destination,
+	Refresh_BufferCopy *regions,
+	uint32_t regionCount
 ) {
 	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanTexture *tex = ((VulkanTextureContainer*) y)->vulkanTexture;
-
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*)commandBuffer;
-	VulkanTransferBuffer *transferBuffer;
-	VkBufferImageCopy imageCopy;
-	uint8_t * stagingBufferPointer;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer *sourceBuffer = ((VulkanBufferContainer*) source)->vulkanBuffer;
+	VulkanBuffer *destinationBuffer = ((VulkanBufferContainer*) destination)->vulkanBuffer;
+	VulkanResourceAccessType prevSourceAccess;
+	VulkanResourceAccessType prevDestinationAccess;
+	VkBufferCopy *bufferCopies;
+	uint32_t i;
 
-	transferBuffer = VULKAN_INTERNAL_AcquireTransferBuffer(
-		renderer,
-		vulkanCommandBuffer,
-		yDataLength + uvDataLength,
-		VULKAN_INTERNAL_BytesPerPixel(tex->format)
-	);
+	if (vulkanCommandBuffer->isTransfer)
+	{
+		Refresh_LogError("GPU copies must be recorded on a graphics command buffer!");
+		return;
+	}
 
-	if (transferBuffer == NULL)
+	if (regionCount == 0)
 	{
 		return;
 	}
 
-	stagingBufferPointer =
-		transferBuffer->buffer->usedRegion->allocation->mapPointer +
-		transferBuffer->buffer->usedRegion->resourceOffset +
-		transferBuffer->offset;
+	/* Queued client uploads land before anything reads or overwrites them */
+	VULKAN_INTERNAL_FlushBufferUploads(renderer, vulkanCommandBuffer);
 
-	/* Initialize values that are the same for Y, U, and V */
+	/* Cache these so we can restore them later */
+	prevSourceAccess = sourceBuffer->resourceAccessType;
+	prevDestinationAccess = destinationBuffer->resourceAccessType;
 
-	imageCopy.imageExtent.depth = 1;
-	imageCopy.imageOffset.x = 0;
-	imageCopy.imageOffset.y = 0;
-	imageCopy.imageOffset.z = 0;
-	imageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	imageCopy.imageSubresource.baseArrayLayer = 0;
-	imageCopy.imageSubresource.layerCount = 1;
-	imageCopy.imageSubresource.mipLevel = 0;
+	if (sourceBuffer == destinationBuffer)
+	{
+		VULKAN_INTERNAL_BufferMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_READ_WRITE,
+			sourceBuffer
+		);
+	}
+	else
+	{
+		VULKAN_INTERNAL_BufferMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_READ,
+			sourceBuffer
+		);
+
+		VULKAN_INTERNAL_BufferMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_WRITE,
+			destinationBuffer
+		);
+	}
 
-	/* Y */
+	bufferCopies = SDL_stack_alloc(VkBufferCopy, regionCount);
 
-	SDL_memcpy(
-		stagingBufferPointer,
-		yDataPtr,
-		yDataLength
-	);
+	for (i = 0; i < regionCount; i += 1)
+	{
+		bufferCopies[i].srcOffset = sourceBuffer->offset + regions[i].sourceOffset;
+		bufferCopies[i].dstOffset = destinationBuffer->offset + regions[i].destinationOffset;
+		bufferCopies[i].size = regions[i].size;
+	}
 
-	VULKAN_INTERNAL_ImageMemoryBarrier(
-		renderer,
+	renderer->vkCmdCopyBuffer(
 		vulkanCommandBuffer->commandBuffer,
-		RESOURCE_ACCESS_TRANSFER_WRITE,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		0,
-		tex->layerCount,
-		0,
-		tex->levelCount,
-		0,
-		tex->image,
-		&tex->resourceAccessType
+		sourceBuffer->buffer,
+		destinationBuffer->buffer,
+		regionCount,
+		bufferCopies
 	);
 
+	SDL_stack_free(bufferCopies);
 
-	imageCopy.imageExtent.width = yWidth;
-	imageCopy.imageExtent.height = yHeight;
-	imageCopy.bufferOffset = transferBuffer->offset;
-	imageCopy.bufferRowLength = yStride;
-	imageCopy.bufferImageHeight = yHeight;
+	/* Restore the usage states so binds see the new contents */
 
-	renderer->vkCmdCopyBufferToImage(
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
 		vulkanCommandBuffer->commandBuffer,
-		transferBuffer->buffer->buffer,
-		tex->image,
-		AccessMap[tex->resourceAccessType].imageLayout,
-		1,
-		&imageCopy
+		prevDestinationAccess,
+		destinationBuffer
 	);
 
-	if (tex->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+	if (sourceBuffer != destinationBuffer)
 	{
-		/* TODO: is it worth it to only transition the specific subresource? */
-		VULKAN_INTERNAL_ImageMemoryBarrier(
+		VULKAN_INTERNAL_BufferMemoryBarrier(
 			renderer,
 			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
-			VK_IMAGE_ASPECT_COLOR_BIT,
-			0,
-			tex->layerCount,
-			0,
-			tex->levelCount,
-			0,
-			tex->image,
-			&tex->resourceAccessType
+			prevSourceAccess,
+			sourceBuffer
 		);
 	}
 
-	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, tex);
-
-	/* These apply to both U and V */
-
-	imageCopy.imageExtent.width = uvWidth;
-	imageCopy.imageExtent.height = uvHeight;
-	imageCopy.bufferRowLength = uvStride;
-	imageCopy.bufferImageHeight = uvHeight;
-
-	/* U */
-
-	imageCopy.bufferOffset = transferBuffer->offset + yDataLength;
-
-	tex = ((VulkanTextureContainer*) u)->vulkanTexture;
-
-	SDL_memcpy(
-		stagingBufferPointer + yDataLength,
-		uDataPtr,
-		uvDataLength
-	);
+	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, sourceBuffer);
+	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, destinationBuffer);
+}
 
-	VULKAN_INTERNAL_ImageMemoryBarrier(
-		renderer,
-		vulkanCommandBuffer->commandBuffer,
-		RESOURCE_ACCESS_TRANSFER_WRITE,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		0,
-		tex->layerCount,
-		0,
-		tex->levelCount,
-		0,
-		tex->image,
-		&tex->resourceAccessType
-	);
+static void VULKAN_CopyBufferToTexture(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	Refresh_BufferImageCopy *regions,
+	uint32_t regionCount
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
+	VulkanTexture *vulkanTexture;
+	VulkanResourceAccessType prevResourceAccess;
+	Refresh_TextureSlice *textureSlices;
+	VkDeviceSize *bufferOffsets;
+	uint32_t *bufferRowLengths;
+	uint32_t bytesPerBlock;
+	uint32_t i, runStart;
 
-	renderer->vkCmdCopyBufferToImage(
-		vulkanCommandBuffer->commandBuffer,
-		transferBuffer->buffer->buffer,
-		tex->image,
-		AccessMap[tex->resourceAccessType].imageLayout,
-		1,
-		&imageCopy
-	);
+	if (vulkanCommandBuffer->isTransfer)
+	{
+		Refresh_LogError("GPU copies must be recorded on a graphics command buffer!");
+		return;
+	}
 
-	if (tex->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+	if (regionCount == 0)
 	{
-		/* TODO: is it worth it to only transition the specific subresource? */
-		VULKAN_INTERNAL_ImageMemoryBarrier(
-			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
-			VK_IMAGE_ASPECT_COLOR_BIT,
-			0,
-			tex->layerCount,
-			0,
-			tex->levelCount,
-			0,
-			tex->image,
-			&tex->resourceAccessType
-		);
+		return;
 	}
 
-	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, tex);
+	textureSlices = SDL_stack_alloc(Refresh_TextureSlice, regionCount);
+	bufferOffsets = SDL_stack_alloc(VkDeviceSize, regionCount);
+	bufferRowLengths = SDL_stack_alloc(uint32_t, regionCount);
 
-	/* V */
+	for (i = 0; i < regionCount; i += 1)
+	{
+		vulkanTexture = ((VulkanTextureContainer*) regions[i].textureSlice.texture)->vulkanTexture;
+		bytesPerBlock = VULKAN_INTERNAL_BytesPerPixel(vulkanTexture->format);
+
+		if (bytesPerBlock == 0 || regions[i].bufferOffset % bytesPerBlock != 0)
+		{
+			Refresh_LogError("Buffer offset must be a multiple of the texture block size!");
+			SDL_stack_free(bufferRowLengths);
+			SDL_stack_free(bufferOffsets);
+			SDL_stack_free(textureSlices);
+			return;
+		}
 
-	imageCopy.bufferOffset = transferBuffer->offset + yDataLength + uvDataLength;
+		textureSlices[i] = regions[i].textureSlice;
+		bufferOffsets[i] = vulkanBuffer->offset + regions[i].bufferOffset;
+		bufferRowLengths[i] = regions[i].bufferRowLength;
+	}
 
-	tex = ((VulkanTextureContainer*) v)->vulkanTexture;
+	VULKAN_INTERNAL_FlushBufferUploads(renderer, vulkanCommandBuffer);
 
-	SDL_memcpy(
-		stagingBufferPointer + yDataLength + uvDataLength,
-		vDataPtr,
-		uvDataLength
-	);
+	/* Cache this so we can restore it later */
+	prevResourceAccess = vulkanBuffer->resourceAccessType;
 
-	VULKAN_INTERNAL_ImageMemoryBarrier(
+	VULKAN_INTERNAL_BufferMemoryBarrier(
 		renderer,
 		vulkanCommandBuffer->commandBuffer,
-		RESOURCE_ACCESS_TRANSFER_WRITE,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		0,
-		tex->layerCount,
-		0,
-		tex->levelCount,
-		0,
-		tex->image,
-		&tex->resourceAccessType
-	);
-
-	renderer->vkCmdCopyBufferToImage(
-		vulkanCommandBuffer->commandBuffer,
-		transferBuffer->buffer->buffer,
-		tex->image,
-		AccessMap[tex->resourceAccessType].imageLayout,
-		1,
-		&imageCopy
+		RESOURCE_ACCESS_TRANSFER_READ,
+		vulkanBuffer
 	);
 
-	transferBuffer->offset += yDataLength + uvDataLength;
-
-	if (tex->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+	/* Consecutive regions of the same texture share one copy command */
+	runStart = 0;
+	for (i = 1; i <= regionCount; i += 1)
 	{
-		/* TODO: is it worth it to only transition the specific subresource? */
-		VULKAN_INTERNAL_ImageMemoryBarrier(
+		if (	i < regionCount &&
+			textureSlices[i].texture == textureSlices[runStart].texture	)
+		{
+			continue;
+		}
+
+		VULKAN_INTERNAL_CopyStagingToTexture(
 			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
-			VK_IMAGE_ASPECT_COLOR_BIT,
-			0,
-			tex->layerCount,
-			0,
-			tex->levelCount,
-			0,
-			tex->image,
-			&tex->resourceAccessType
+			vulkanCommandBuffer,
+			vulkanBuffer,
+			&bufferOffsets[runStart],
+			&bufferRowLengths[runStart],
+			&textureSlices[runStart],
+			i - runStart
 		);
-	}
-
-	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, tex);
-}
-
-static void VULKAN_INTERNAL_BlitImage(
-	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
-	Refresh_TextureSlice *sourceTextureSlice,
-	Refresh_TextureSlice *destinationTextureSlice,
-	VkFilter filter
-) {
-	VkImageBlit blit;
-	VulkanTexture *sourceTexture = ((VulkanTextureContainer*) sourceTextureSlice->texture)->vulkanTexture;
-	VulkanTexture *destinationTexture = ((VulkanTextureContainer*) destinationTextureSlice->texture)->vulkanTexture;
 
-	VulkanResourceAccessType originalSourceAccessType = sourceTexture->resourceAccessType;
-	VulkanResourceAccessType originalDestinationAccessType = destinationTexture->resourceAccessType;
-
-	if (originalDestinationAccessType == RESOURCE_ACCESS_NONE)
-	{
-		originalDestinationAccessType = RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE;
+		runStart = i;
 	}
 
-	/* TODO: is it worth it to only transition the specific subresource? */
-	VULKAN_INTERNAL_ImageMemoryBarrier(
+	VULKAN_INTERNAL_BufferMemoryBarrier(
 		renderer,
-		commandBuffer->commandBuffer,
-		RESOURCE_ACCESS_TRANSFER_READ,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		0,
-		sourceTexture->layerCount,
-		0,
-		sourceTexture->levelCount,
-		0,
-		sourceTexture->image,
-		&sourceTexture->resourceAccessType
+		vulkanCommandBuffer->commandBuffer,
+		prevResourceAccess,
+		vulkanBuffer
 	);
 
-	VULKAN_INTERNAL_ImageMemoryBarrier(
-		renderer,
-		commandBuffer->commandBuffer,
-		RESOURCE_ACCESS_TRANSFER_WRITE,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		0,
-		destinationTexture->layerCount,
-		0,
-		destinationTexture->levelCount,
-		0,
-		destinationTexture->image,
-		&destinationTexture->resourceAccessType
-	);
+	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
+
+	SDL_stack_free(bufferRowLengths);
+	SDL_stack_free(bufferOffsets);
+	SDL_stack_free(textureSlices);
+}
+
+static void VULKAN_INTERNAL_QueueDestroyTexture(
+	VulkanRenderer *renderer,
+	VulkanTexture *vulkanTexture
+) {
+	SDL_LockMutex(renderer->disposeLock);
 
-	blit.srcOffsets[0].x = sourceTextureSlice->rectangle.x;
-	blit.srcOffsets[0].y = sourceTextureSlice->rectangle.y;
-	blit.srcOffsets[0].z = sourceTextureSlice->depth;
-	blit.srcOffsets[1].x = sourceTextureSlice->rectangle.x + sourceTextureSlice->rectangle.w;
-	blit.srcOffsets[1].y = sourceTextureSlice->rectangle.y + sourceTextureSlice->rectangle.h;
-	blit.srcOffsets[1].z = 1;
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->texturesToDestroy,
+		VulkanTexture*,
+		renderer->texturesToDestroyCount + 1,
+		renderer->texturesToDestroyCapacity,
+		renderer->texturesToDestroyCapacity * 2
+	)
 
-	blit.srcSubresource.mipLevel = sourceTextureSlice->level;
-	blit.srcSubresource.baseArrayLayer = sourceTextureSlice->layer;
-	blit.srcSubresource.layerCount = 1;
-	blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	renderer->texturesToDestroy[
+		renderer->texturesToDestroyCount
+	] = vulkanTexture;
+	renderer->texturesToDestroyCount += 1;
 
-	blit.dstOffsets[0].x = destinationTextureSlice->rectangle.x;
-	blit.dstOffsets[0].y = destinationTextureSlice->rectangle.y;
-	blit.dstOffsets[0].z = destinationTextureSlice->depth;
-	blit.dstOffsets[1].x = destinationTextureSlice->rectangle.x + destinationTextureSlice->rectangle.w;
-	blit.dstOffsets[1].y = destinationTextureSlice->rectangle.y + destinationTextureSlice->rectangle.h;
-	blit.dstOffsets[1].z = 1;
+	SDL_UnlockMutex(renderer->disposeLock);
+}
 
-	blit.dstSubresource.mipLevel = destinationTextureSlice->level;
-	blit.dstSubresource.baseArrayLayer = destinationTextureSlice->layer;
-	blit.dstSubresource.layerCount = 1;
-	blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+static void VULKAN_QueueDestroyTexture(
+	Refresh_Renderer *driverData,
+	Refresh_Texture *texture
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanTextureContainer *vulkanTextureContainer = (VulkanTextureContainer *)texture;
+	VulkanTexture *vulkanTexture = vulkanTextureContainer->vulkanTexture;
 
-	renderer->vkCmdBlitImage(
-		commandBuffer->commandBuffer,
-		sourceTexture->image,
-		VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-		destinationTexture->image,
-		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-		1,
-		&blit,
-		filter
-	);
+	SDL_LockMutex(renderer->disposeLock);
 
-	/* TODO: is it worth it to only transition the specific subresource? */
-	VULKAN_INTERNAL_ImageMemoryBarrier(
-		renderer,
-		commandBuffer->commandBuffer,
-		originalSourceAccessType,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		0,
-		sourceTexture->layerCount,
-		0,
-		sourceTexture->levelCount,
-		0,
-		sourceTexture->image,
-		&sourceTexture->resourceAccessType
-	);
+	VULKAN_INTERNAL_QueueDestroyTexture(renderer, vulkanTexture);
 
-	VULKAN_INTERNAL_ImageMemoryBarrier(
-		renderer,
-		commandBuffer->commandBuffer,
-		originalDestinationAccessType,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		0,
-		destinationTexture->layerCount,
-		0,
-		destinationTexture->levelCount,
-		0,
-		destinationTexture->image,
-		&destinationTexture->resourceAccessType
-	);
+	/* Containers are just client handles, so we can destroy immediately */
+	SDL_free(vulkanTextureContainer);
 
-	VULKAN_INTERNAL_TrackTexture(renderer, commandBuffer, sourceTexture);
-	VULKAN_INTERNAL_TrackTexture(renderer, commandBuffer, destinationTexture);
+	SDL_UnlockMutex(renderer->disposeLock);
 }
 
-REFRESHAPI void VULKAN_CopyTextureToTexture(
+static void VULKAN_QueueDestroySampler(
 	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_TextureSlice *sourceTextureSlice,
-	Refresh_TextureSlice *destinationTextureSlice,
-	Refresh_Filter filter
+	Refresh_Sampler *sampler
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*)driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanSampler* vulkanSampler = (VulkanSampler*) sampler;
 
-	VULKAN_INTERNAL_BlitImage(
-		renderer,
-		vulkanCommandBuffer,
-		sourceTextureSlice,
-		destinationTextureSlice,
-		RefreshToVK_Filter[filter]
-	);
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->samplersToDestroy,
+		VulkanSampler*,
+		renderer->samplersToDestroyCount + 1,
+		renderer->samplersToDestroyCapacity,
+		renderer->samplersToDestroyCapacity * 2
+	)
+
+	renderer->samplersToDestroy[renderer->samplersToDestroyCount] = vulkanSampler;
+	renderer->samplersToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
 }
 
-static void VULKAN_INTERNAL_SetBufferData(
-	VulkanBuffer* vulkanBuffer,
-	VkDeviceSize offsetInBytes,
-	void* data,
-	uint32_t dataLength
+static void VULKAN_INTERNAL_QueueDestroyBuffer(
+	VulkanRenderer *renderer,
+	VulkanBuffer *vulkanBuffer
 ) {
-	SDL_memcpy(
-		vulkanBuffer->usedRegion->allocation->mapPointer + vulkanBuffer->usedRegion->resourceOffset + offsetInBytes,
-		data,
-		dataLength
-	);
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->buffersToDestroy,
+		VulkanBuffer*,
+		renderer->buffersToDestroyCount + 1,
+		renderer->buffersToDestroyCapacity,
+		renderer->buffersToDestroyCapacity * 2
+	)
+
+	renderer->buffersToDestroy[
+		renderer->buffersToDestroyCount
+	] = vulkanBuffer;
+	renderer->buffersToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
 }
 
-static void VULKAN_SetBufferData(
+static void VULKAN_QueueDestroyBuffer(
 	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Buffer *buffer,
-	uint32_t offsetInBytes,
-	void* data,
-	uint32_t dataLength
+	Refresh_Buffer *buffer
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer* vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanBuffer* vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
-	VulkanTransferBuffer* transferBuffer;
-	uint8_t* transferBufferPointer;
-	VkBufferCopy bufferCopy;
-	VulkanResourceAccessType accessType = vulkanBuffer->resourceAccessType;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanBufferContainer *vulkanBufferContainer = (VulkanBufferContainer*) buffer;
+	VulkanBuffer *vulkanBuffer = vulkanBufferContainer->vulkanBuffer;
+	uint32_t i;
 
-	transferBuffer = VULKAN_INTERNAL_AcquireTransferBuffer(
-		renderer,
-		vulkanCommandBuffer,
-		dataLength,
-		renderer->physicalDeviceProperties.properties.limits.optimalBufferCopyOffsetAlignment
-	);
+	SDL_LockMutex(renderer->disposeLock);
 
-	if (transferBuffer == NULL)
+	if (vulkanBufferContainer->dynamic)
 	{
-		return;
+		for (i = 0; i < vulkanBufferContainer->versionCount; i += 1)
+		{
+			vulkanBufferContainer->versions[i]->container = NULL;
+			VULKAN_INTERNAL_QueueDestroyBuffer(renderer, vulkanBufferContainer->versions[i]);
+		}
+
+		SDL_free(vulkanBufferContainer->versions);
+	}
+	else
+	{
+		VULKAN_INTERNAL_QueueDestroyBuffer(renderer, vulkanBuffer);
 	}
 
-	transferBufferPointer =
-		transferBuffer->buffer->usedRegion->allocation->mapPointer +
-		transferBuffer->buffer->usedRegion->resourceOffset +
-		transferBuffer->offset;
+	/* Containers are just client handles, so we can destroy immediately */
+	SDL_free(vulkanBufferContainer);
 
-	SDL_memcpy(
-		transferBufferPointer,
-		data,
-		dataLength
-	);
+	SDL_UnlockMutex(renderer->disposeLock);
+}
 
-	VULKAN_INTERNAL_BufferMemoryBarrier(
-		renderer,
-		vulkanCommandBuffer->commandBuffer,
-		RESOURCE_ACCESS_TRANSFER_READ,
-		transferBuffer->buffer
-	);
+static void VULKAN_QueueDestroyShaderModule(
+	Refresh_Renderer *driverData,
+	Refresh_ShaderModule *shaderModule
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanShaderModule *vulkanShaderModule = (VulkanShaderModule*) shaderModule;
 
-	VULKAN_INTERNAL_BufferMemoryBarrier(
-		renderer,
-		vulkanCommandBuffer->commandBuffer,
-		RESOURCE_ACCESS_TRANSFER_WRITE,
-		vulkanBuffer
-	);
+	SDL_LockMutex(renderer->disposeLock);
 
-	bufferCopy.srcOffset = transferBuffer->offset;
-	bufferCopy.dstOffset = offsetInBytes;
-	bufferCopy.size = (VkDeviceSize) dataLength;
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->shaderModulesToDestroy,
+		VulkanShaderModule*,
+		renderer->shaderModulesToDestroyCount + 1,
+		renderer->shaderModulesToDestroyCapacity,
+		renderer->shaderModulesToDestroyCapacity * 2
+	)
 
-	renderer->vkCmdCopyBuffer(
-		vulkanCommandBuffer->commandBuffer,
-		transferBuffer->buffer->buffer,
-		vulkanBuffer->buffer,
-		1,
-		&bufferCopy
-	);
+	renderer->shaderModulesToDestroy[renderer->shaderModulesToDestroyCount] = vulkanShaderModule;
+	renderer->shaderModulesToDestroyCount += 1;
 
-	VULKAN_INTERNAL_BufferMemoryBarrier(
-		renderer,
-		vulkanCommandBuffer->commandBuffer,
-		accessType,
-		vulkanBuffer
-	);
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_QueueDestroyComputePipeline(
+	Refresh_Renderer *driverData,
+	Refresh_ComputePipeline *computePipeline
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanComputePipeline *vulkanComputePipeline = (VulkanComputePipeline*) computePipeline;
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->computePipelinesToDestroy,
+		VulkanComputePipeline*,
+		renderer->computePipelinesToDestroyCount + 1,
+		renderer->computePipelinesToDestroyCapacity,
+		renderer->computePipelinesToDestroyCapacity * 2
+	)
+
+	renderer->computePipelinesToDestroy[renderer->computePipelinesToDestroyCount] = vulkanComputePipeline;
+	renderer->computePipelinesToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_QueueDestroyGraphicsPipeline(
+	Refresh_Renderer *driverData,
+	Refresh_GraphicsPipeline *graphicsPipeline
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanGraphicsPipeline *vulkanGraphicsPipeline = (VulkanGraphicsPipeline*) graphicsPipeline;
 
-	transferBuffer->offset += dataLength;
+	SDL_LockMutex(renderer->disposeLock);
 
-	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->graphicsPipelinesToDestroy,
+		VulkanGraphicsPipeline*,
+		renderer->graphicsPipelinesToDestroyCount + 1,
+		renderer->graphicsPipelinesToDestroyCapacity,
+		renderer->graphicsPipelinesToDestroyCapacity * 2
+	)
+
+	renderer->graphicsPipelinesToDestroy[renderer->graphicsPipelinesToDestroyCount] = vulkanGraphicsPipeline;
+	renderer->graphicsPipelinesToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
 }
 
-/* FIXME: this should return uint64_t */
-static uint32_t VULKAN_PushVertexShaderUniforms(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	void *data,
-	uint32_t dataLengthInBytes
+/* Command Buffer render state */
+
+static VkRenderPass VULKAN_INTERNAL_FetchRenderPass(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+	uint32_t colorAttachmentCount,
+	Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer* vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanGraphicsPipeline* graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
-	uint32_t offset;
+	VkRenderPass renderPass;
+	RenderPassHash hash;
+	uint32_t i;
+	VulkanTexture *texture;
 
-	if (graphicsPipeline == NULL)
+	SDL_LockMutex(renderer->renderPassFetchLock);
+
+	for (i = 0; i < colorAttachmentCount; i += 1)
 	{
-		Refresh_LogError("Cannot push uniforms if a pipeline is not bound!");
-		return 0;
+		hash.colorTargetDescriptions[i].format = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture->format;
+		hash.colorTargetDescriptions[i].clearColor = colorAttachmentInfos[i].clearColor;
+		hash.colorTargetDescriptions[i].loadOp = colorAttachmentInfos[i].loadOp;
+		hash.colorTargetDescriptions[i].storeOp = colorAttachmentInfos[i].storeOp;
 	}
 
-	if (graphicsPipeline->vertexUniformBlockSize == 0)
+	hash.colorAttachmentSampleCount = REFRESH_SAMPLECOUNT_1;
+	if (colorAttachmentCount > 0)
 	{
-		Refresh_LogError("Bound pipeline's vertex stage does not declare uniforms!");
-		return 0;
+		texture = ((VulkanTextureContainer*) colorAttachmentInfos[0].texture)->vulkanTexture;
+		if (texture->msaaTex != NULL)
+		{
+			hash.colorAttachmentSampleCount = texture->msaaTex->sampleCount;
+		}
 	}
 
-	if (
-		vulkanCommandBuffer->vertexUniformBuffer->offset +
-		graphicsPipeline->vertexUniformBlockSize >=
-		UBO_SECTION_SIZE
-	) {
-		/* We're out of space in this buffer, bind the old one and acquire a new one */
-		VULKAN_INTERNAL_BindUniformBuffer(
-			renderer,
-			vulkanCommandBuffer,
-			vulkanCommandBuffer->vertexUniformBuffer
-		);
-		vulkanCommandBuffer->vertexUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
-			renderer,
-			renderer->vertexUniformBufferPool,
-			graphicsPipeline->vertexUniformBlockSize
-		);
-	}
+	hash.colorAttachmentCount = colorAttachmentCount;
 
-	offset = vulkanCommandBuffer->vertexUniformBuffer->offset;
+	if (depthStencilAttachmentInfo == NULL)
+	{
+		hash.depthStencilTargetDescription.format = 0;
+		hash.depthStencilTargetDescription.loadOp = REFRESH_LOADOP_DONT_CARE;
+		hash.depthStencilTargetDescription.storeOp = REFRESH_STOREOP_DONT_CARE;
+		hash.depthStencilTargetDescription.stencilLoadOp = REFRESH_LOADOP_DONT_CARE;
+		hash.depthStencilTargetDescription.stencilStoreOp = REFRESH_STOREOP_DONT_CARE;
+	}
+	else
+	{
+		hash.depthStencilTargetDescription.format = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture->format;
+		hash.depthStencilTargetDescription.loadOp = depthStencilAttachmentInfo->loadOp;
+		hash.depthStencilTargetDescription.storeOp = depthStencilAttachmentInfo->storeOp;
+		hash.depthStencilTargetDescription.stencilLoadOp = depthStencilAttachmentInfo->stencilLoadOp;
+		hash.depthStencilTargetDescription.stencilStoreOp = depthStencilAttachmentInfo->stencilStoreOp;
+	}
 
-	VULKAN_INTERNAL_SetBufferData(
-		vulkanCommandBuffer->vertexUniformBuffer->pool->buffer,
-		vulkanCommandBuffer->vertexUniformBuffer->poolOffset + vulkanCommandBuffer->vertexUniformBuffer->offset,
-		data,
-		dataLengthInBytes
+	renderPass = RenderPassHashArray_Fetch(
+		&renderer->renderPassHashArray,
+		&hash
 	);
 
-	vulkanCommandBuffer->vertexUniformBuffer->offset += graphicsPipeline->vertexUniformBlockSize;
-
-	return offset;
-}
-
-/* FIXME: this should return uint64_t */
-static uint32_t VULKAN_PushFragmentShaderUniforms(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	void *data,
-	uint32_t dataLengthInBytes
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer* vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanGraphicsPipeline* graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
-	uint32_t offset;
-
-	if (
-		vulkanCommandBuffer->fragmentUniformBuffer->offset +
-		graphicsPipeline->fragmentUniformBlockSize >=
-		UBO_SECTION_SIZE
-	) {
-		/* We're out of space in this buffer, bind the old one and acquire a new one */
-		VULKAN_INTERNAL_BindUniformBuffer(
-			renderer,
-			vulkanCommandBuffer,
-			vulkanCommandBuffer->fragmentUniformBuffer
-		);
-		vulkanCommandBuffer->fragmentUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
-			renderer,
-			renderer->fragmentUniformBufferPool,
-			graphicsPipeline->fragmentUniformBlockSize
-		);
+	if (renderPass != VK_NULL_HANDLE)
+	{
+		SDL_UnlockMutex(renderer->renderPassFetchLock);
+		return renderPass;
 	}
 
-	offset = vulkanCommandBuffer->fragmentUniformBuffer->offset;
-
-	VULKAN_INTERNAL_SetBufferData(
-		vulkanCommandBuffer->fragmentUniformBuffer->pool->buffer,
-		vulkanCommandBuffer->fragmentUniformBuffer->poolOffset + vulkanCommandBuffer->fragmentUniformBuffer->offset,
-		data,
-		dataLengthInBytes
+	renderPass = VULKAN_INTERNAL_CreateRenderPass(
+		renderer,
+		commandBuffer,
+		colorAttachmentInfos,
+		colorAttachmentCount,
+		depthStencilAttachmentInfo
 	);
 
-	vulkanCommandBuffer->fragmentUniformBuffer->offset += graphicsPipeline->fragmentUniformBlockSize;
+	if (renderPass != VK_NULL_HANDLE)
+	{
+		RenderPassHashArray_Insert(
+			&renderer->renderPassHashArray,
+			hash,
+			renderPass
+		);
+	}
 
-	return offset;
+	SDL_UnlockMutex(renderer->renderPassFetchLock);
+	return renderPass;
 }
 
-static uint32_t VULKAN_PushComputeShaderUniforms(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	void *data,
-	uint32_t dataLengthInBytes
+static VulkanFramebuffer* VULKAN_INTERNAL_FetchFramebuffer(
+	VulkanRenderer *renderer,
+	VkRenderPass renderPass,
+	Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+	uint32_t colorAttachmentCount,
+	Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo,
+	uint32_t width,
+	uint32_t height
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer* vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanComputePipeline* computePipeline = vulkanCommandBuffer->currentComputePipeline;
-	uint32_t offset;
+	VulkanFramebuffer *vulkanFramebuffer;
+	VkFramebufferCreateInfo framebufferInfo;
+	VkResult result;
+	VkImageView imageViewAttachments[2 * MAX_COLOR_TARGET_BINDINGS + 1];
+	FramebufferHash hash;
+	VulkanTexture *texture;
+	VulkanRenderTarget *renderTarget;
+	uint32_t attachmentCount = 0;
+	uint32_t i;
 
-	if (
-		vulkanCommandBuffer->computeUniformBuffer->offset +
-		computePipeline->uniformBlockSize >=
-		UBO_SECTION_SIZE
-	) {
-		/* We're out of space in this buffer, bind the old one and acquire a new one */
-		VULKAN_INTERNAL_BindUniformBuffer(
-			renderer,
-			vulkanCommandBuffer,
-			vulkanCommandBuffer->computeUniformBuffer
-		);
-		vulkanCommandBuffer->computeUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
-			renderer,
-			renderer->computeUniformBufferPool,
-			computePipeline->uniformBlockSize
-		);
+	for (i = 0; i < MAX_COLOR_TARGET_BINDINGS; i += 1)
+	{
+		hash.colorAttachmentViews[i] = VK_NULL_HANDLE;
+		hash.colorMultiSampleAttachmentViews[i] = VK_NULL_HANDLE;
 	}
 
-	offset = vulkanCommandBuffer->computeUniformBuffer->offset;
+	hash.colorAttachmentCount = colorAttachmentCount;
 
-	VULKAN_INTERNAL_SetBufferData(
-		vulkanCommandBuffer->computeUniformBuffer->pool->buffer,
-		vulkanCommandBuffer->computeUniformBuffer->poolOffset + vulkanCommandBuffer->computeUniformBuffer->offset,
-		data,
-		dataLengthInBytes
-	);
+	for (i = 0; i < colorAttachmentCount; i += 1)
+	{
+		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
 
-	vulkanCommandBuffer->computeUniformBuffer->offset += computePipeline->uniformBlockSize;
+		renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
+			renderer,
+			texture,
+			colorAttachmentInfos[i].depth,
+			colorAttachmentInfos[i].layer,
+			colorAttachmentInfos[i].level
+		);
 
-	return offset;
-}
+		hash.colorAttachmentViews[i] = (
+			renderTarget->view
+		);
 
-/* If fetching an image descriptor, descriptorImageInfos must not be NULL.
- * If fetching a buffer descriptor, descriptorBufferInfos must not be NULL.
- */
-static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
-	VulkanRenderer *renderer,
-	VulkanCommandBuffer *vulkanCommandBuffer,
-	DescriptorSetCache *descriptorSetCache,
-	VkDescriptorImageInfo *descriptorImageInfos, /* Can be NULL */
-	VkDescriptorBufferInfo *descriptorBufferInfos /* Can be NULL */
-) {
-	uint32_t i;
-	VkDescriptorSet descriptorSet;
-	VkWriteDescriptorSet writeDescriptorSets[MAX_TEXTURE_SAMPLERS];
-	uint8_t isImage;
+		if (texture->msaaTex != NULL)
+		{
+			renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
+				renderer,
+				texture->msaaTex,
+				colorAttachmentInfos[i].depth,
+				colorAttachmentInfos[i].layer,
+				colorAttachmentInfos[i].level
+			);
 
-	if (descriptorImageInfos == NULL && descriptorBufferInfos == NULL)
+			hash.colorMultiSampleAttachmentViews[i] = (
+				renderTarget->view
+			);
+		}
+	}
+
+	if (depthStencilAttachmentInfo == NULL)
+	{
+		hash.depthStencilAttachmentView = VK_NULL_HANDLE;
+	}
+	else
 	{
-		Refresh_LogError("descriptorImageInfos and descriptorBufferInfos cannot both be NULL!");
-		return VK_NULL_HANDLE;
+		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
+		renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
+			renderer,
+			texture,
+			depthStencilAttachmentInfo->depth,
+			depthStencilAttachmentInfo->layer,
+			depthStencilAttachmentInfo->level
+		);
+		hash.depthStencilAttachmentView = renderTarget->view;
 	}
-	else if (descriptorImageInfos != NULL && descriptorBufferInfos != NULL)
+
+	hash.width = width;
+	hash.height = height;
+
+	SDL_LockMutex(renderer->framebufferFetchLock);
+
+	vulkanFramebuffer = FramebufferHashArray_Fetch(
+		&renderer->framebufferHashArray,
+		&hash
+	);
+
+	SDL_UnlockMutex(renderer->framebufferFetchLock);
+
+	if (vulkanFramebuffer != NULL)
 	{
-		Refresh_LogError("descriptorImageInfos and descriptorBufferInfos cannot both be set!");
-		return VK_NULL_HANDLE;
+		return vulkanFramebuffer;
 	}
 
-	isImage = descriptorImageInfos != NULL;
+	vulkanFramebuffer = SDL_malloc(sizeof(VulkanFramebuffer));
 
-	SDL_LockMutex(descriptorSetCache->lock);
+	SDL_AtomicSet(&vulkanFramebuffer->referenceCount, 0);
 
-	/* If no inactive descriptor sets remain, create a new pool and allocate new inactive sets */
+	/* Create a new framebuffer */
 
-	if (descriptorSetCache->inactiveDescriptorSetCount == 0)
+	for (i = 0; i < colorAttachmentCount; i += 1)
 	{
-		descriptorSetCache->descriptorPoolCount += 1;
-		descriptorSetCache->descriptorPools = SDL_realloc(
-			descriptorSetCache->descriptorPools,
-			sizeof(VkDescriptorPool) * descriptorSetCache->descriptorPoolCount
-		);
+		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
 
-		if (!VULKAN_INTERNAL_CreateDescriptorPool(
+		renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
 			renderer,
-			descriptorSetCache->descriptorType,
-			descriptorSetCache->nextPoolSize,
-			descriptorSetCache->nextPoolSize * descriptorSetCache->bindingCount,
-			&descriptorSetCache->descriptorPools[descriptorSetCache->descriptorPoolCount - 1]
-		)) {
-			SDL_UnlockMutex(descriptorSetCache->lock);
-			Refresh_LogError("Failed to create descriptor pool!");
-			return VK_NULL_HANDLE;
-		}
+			texture,
+			colorAttachmentInfos[i].depth,
+			colorAttachmentInfos[i].layer,
+			colorAttachmentInfos[i].level
+		);
 
-		descriptorSetCache->inactiveDescriptorSetCapacity += descriptorSetCache->nextPoolSize;
+		imageViewAttachments[attachmentCount] =
+			renderTarget->view;
 
-		descriptorSetCache->inactiveDescriptorSets = SDL_realloc(
-			descriptorSetCache->inactiveDescriptorSets,
-			sizeof(VkDescriptorSet) * descriptorSetCache->inactiveDescriptorSetCapacity
-		);
+		attachmentCount += 1;
 
-		if (!VULKAN_INTERNAL_AllocateDescriptorSets(
-			renderer,
-			descriptorSetCache->descriptorPools[descriptorSetCache->descriptorPoolCount - 1],
-			descriptorSetCache->descriptorSetLayout,
-			descriptorSetCache->nextPoolSize,
-			descriptorSetCache->inactiveDescriptorSets
-		)) {
-			SDL_UnlockMutex(descriptorSetCache->lock);
-			Refresh_LogError("Failed to allocate descriptor sets!");
-			return VK_NULL_HANDLE;
-		}
+		if (texture->msaaTex != NULL)
+		{
+			renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
+				renderer,
+				texture->msaaTex,
+				colorAttachmentInfos[i].depth,
+				colorAttachmentInfos[i].layer,
+				colorAttachmentInfos[i].level
+			);
 
-		descriptorSetCache->inactiveDescriptorSetCount = descriptorSetCache->nextPoolSize;
+			imageViewAttachments[attachmentCount] =
+				renderTarget->view;
 
-		descriptorSetCache->nextPoolSize *= 2;
+			attachmentCount += 1;
+		}
 	}
 
-	descriptorSet = descriptorSetCache->inactiveDescriptorSets[descriptorSetCache->inactiveDescriptorSetCount - 1];
-	descriptorSetCache->inactiveDescriptorSetCount -= 1;
-
-	for (i = 0; i < descriptorSetCache->bindingCount; i += 1)
+	if (depthStencilAttachmentInfo != NULL)
 	{
-		writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		writeDescriptorSets[i].pNext = NULL;
-		writeDescriptorSets[i].descriptorCount = 1;
-		writeDescriptorSets[i].descriptorType = descriptorSetCache->descriptorType;
-		writeDescriptorSets[i].dstArrayElement = 0;
-		writeDescriptorSets[i].dstBinding = i;
-		writeDescriptorSets[i].dstSet = descriptorSet;
-		writeDescriptorSets[i].pTexelBufferView = NULL;
+		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
+		renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
+			renderer,
+			texture,
+			depthStencilAttachmentInfo->depth,
+			depthStencilAttachmentInfo->layer,
+			depthStencilAttachmentInfo->level
+		);
 
-		if (isImage)
-		{
-			writeDescriptorSets[i].pImageInfo = &descriptorImageInfos[i];
-			writeDescriptorSets[i].pBufferInfo = NULL;
+		imageViewAttachments[attachmentCount] = renderTarget->view;
 
-		}
-		else
-		{
-			writeDescriptorSets[i].pBufferInfo = &descriptorBufferInfos[i];
-			writeDescriptorSets[i].pImageInfo = NULL;
-		}
+		attachmentCount += 1;
 	}
 
-	renderer->vkUpdateDescriptorSets(
+	framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+	framebufferInfo.pNext = NULL;
+	framebufferInfo.flags = 0;
+	framebufferInfo.renderPass = renderPass;
+	framebufferInfo.attachmentCount = attachmentCount;
+	framebufferInfo.pAttachments = imageViewAttachments;
+	framebufferInfo.width = hash.width;
+	framebufferInfo.height = hash.height;
+	framebufferInfo.layers = 1;
+
+	result = renderer->vkCreateFramebuffer(
 		renderer->logicalDevice,
-		descriptorSetCache->bindingCount,
-		writeDescriptorSets,
-		0,
-		NULL
+		&framebufferInfo,
+		NULL,
+		&vulkanFramebuffer->framebuffer
 	);
 
-	SDL_UnlockMutex(descriptorSetCache->lock);
-
-	if (vulkanCommandBuffer->boundDescriptorSetDataCount == vulkanCommandBuffer->boundDescriptorSetDataCapacity)
+	if (result == VK_SUCCESS)
 	{
-		vulkanCommandBuffer->boundDescriptorSetDataCapacity *= 2;
-		vulkanCommandBuffer->boundDescriptorSetDatas = SDL_realloc(
-			vulkanCommandBuffer->boundDescriptorSetDatas,
-			vulkanCommandBuffer->boundDescriptorSetDataCapacity * sizeof(DescriptorSetData)
+		SDL_LockMutex(renderer->framebufferFetchLock);
+
+		FramebufferHashArray_Insert(
+			&renderer->framebufferHashArray,
+			hash,
+			vulkanFramebuffer
 		);
+
+		SDL_UnlockMutex(renderer->framebufferFetchLock);
+	}
+	else
+	{
+		LogVulkanResultAsError("vkCreateFramebuffer", result);
+		SDL_free(vulkanFramebuffer);
+		vulkanFramebuffer = NULL;
 	}
 
-	vulkanCommandBuffer->boundDescriptorSetDatas[vulkanCommandBuffer->boundDescriptorSetDataCount].descriptorSet = descriptorSet;
-	vulkanCommandBuffer->boundDescriptorSetDatas[vulkanCommandBuffer->boundDescriptorSetDataCount].descriptorSetCache = descriptorSetCache;
-	vulkanCommandBuffer->boundDescriptorSetDataCount += 1;
+	return vulkanFramebuffer;
+}
 
-	return descriptorSet;
+static void VULKAN_INTERNAL_SetCurrentViewport(
+	VulkanCommandBuffer *commandBuffer,
+	Refresh_Viewport *viewport
+) {
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+
+	vulkanCommandBuffer->currentViewport.x = viewport->x;
+	vulkanCommandBuffer->currentViewport.y = viewport->y;
+	vulkanCommandBuffer->currentViewport.width = viewport->w;
+	vulkanCommandBuffer->currentViewport.height = viewport->h;
+	vulkanCommandBuffer->currentViewport.minDepth = viewport->minDepth;
+	vulkanCommandBuffer->currentViewport.maxDepth = viewport->maxDepth;
 }
 
-static void VULKAN_BindVertexSamplers(
+static void VULKAN_SetViewport(
 	Refresh_Renderer *driverData,
 	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Texture **pTextures,
-	Refresh_Sampler **pSamplers
+	Refresh_Viewport *viewport
 ) {
 	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
 	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanGraphicsPipeline *graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
 
-	VulkanTexture *currentTexture;
-	VulkanSampler *currentSampler;
-	uint32_t i, samplerCount;
-	VkDescriptorImageInfo descriptorImageInfos[MAX_TEXTURE_SAMPLERS];
+	VULKAN_INTERNAL_SetCurrentViewport(
+		vulkanCommandBuffer,
+		viewport
+	);
+
+	renderer->vkCmdSetViewport(
+		vulkanCommandBuffer->commandBuffer,
+		0,
+		1,
+		&vulkanCommandBuffer->currentViewport
+	);
+}
+
+static void VULKAN_INTERNAL_SetCurrentScissor(
+	VulkanCommandBuffer *vulkanCommandBuffer,
+	Refresh_Rect *scissor
+) {
+	vulkanCommandBuffer->currentScissor.offset.x = scissor->x;
+	vulkanCommandBuffer->currentScissor.offset.y = scissor->y;
+	vulkanCommandBuffer->currentScissor.extent.width = scissor->w;
+	vulkanCommandBuffer->currentScissor.extent.height = scissor->h;
+}
+
+static void VULKAN_SetScissor(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Rect *scissor
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+
+	VULKAN_INTERNAL_SetCurrentScissor(
+		vulkanCommandBuffer,
+		scissor
+	);
+
+	renderer->vkCmdSetScissor(
+		vulkanCommandBuffer->commandBuffer,
+		0,
+		1,
+		&vulkanCommandBuffer->currentScissor
+	);
+}
+
+static void VULKAN_BeginRenderPass(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_ColorAttachmentInfo *colorAttachmentInfos,
+	uint32_t colorAttachmentCount,
+	Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VkRenderPass renderPass;
+	VulkanFramebuffer *framebuffer;
+
+	VulkanTexture *texture;
+	uint32_t w, h;
+	VkClearValue *clearValues;
+	uint32_t clearCount = colorAttachmentCount;
+	uint32_t multisampleAttachmentCount = 0;
+	uint32_t totalColorAttachmentCount = 0;
+	uint32_t i, layer;
+	uint8_t discardContents;
+	VkImageAspectFlags depthAspectFlags;
+	Refresh_Viewport defaultViewport;
+	Refresh_Rect defaultScissor;
+	uint32_t framebufferWidth = UINT32_MAX;
+	uint32_t framebufferHeight = UINT32_MAX;
+
+	/* Copies are not allowed inside a render pass */
+	VULKAN_INTERNAL_FlushBufferUploads(renderer, vulkanCommandBuffer);
 
-	if (graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCache == NULL)
+	/* The framebuffer cannot be larger than the smallest attachment. */
+
+	for (i = 0; i < colorAttachmentCount; i += 1)
 	{
-		return;
-	}
+		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
+		w = texture->dimensions.width >> colorAttachmentInfos[i].level;
+		h = texture->dimensions.height >> colorAttachmentInfos[i].level;
 
-	samplerCount = graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCache->bindingCount;
+		if (w < framebufferWidth)
+		{
+			framebufferWidth = w;
+		}
 
-	for (i = 0; i < samplerCount; i += 1)
+		if (h < framebufferHeight)
+		{
+			framebufferHeight = h;
+		}
+	}
+
+	if (depthStencilAttachmentInfo != NULL)
 	{
-		currentTexture = ((VulkanTextureContainer*) pTextures[i])->vulkanTexture;
-		currentSampler = (VulkanSampler*) pSamplers[i];
-		descriptorImageInfos[i].imageView = currentTexture->view;
-		descriptorImageInfos[i].sampler = currentSampler->sampler;
-		descriptorImageInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
+		w = texture->dimensions.width >> depthStencilAttachmentInfo->level;
+		h = texture->dimensions.height >> depthStencilAttachmentInfo->level;
 
-		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, currentTexture);
-		VULKAN_INTERNAL_TrackSampler(renderer, vulkanCommandBuffer, currentSampler);
+		if (w < framebufferWidth)
+		{
+			framebufferWidth = w;
+		}
+
+		if (h < framebufferHeight)
+		{
+			framebufferHeight = h;
+		}
 	}
 
-	vulkanCommandBuffer->vertexSamplerDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
+	/* Fetch required render objects */
+
+	renderPass = VULKAN_INTERNAL_FetchRenderPass(
 		renderer,
 		vulkanCommandBuffer,
-		graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCache,
-		descriptorImageInfos,
-		NULL
+		colorAttachmentInfos,
+		colorAttachmentCount,
+		depthStencilAttachmentInfo
 	);
-}
 
-static void VULKAN_BindFragmentSamplers(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Texture **pTextures,
-	Refresh_Sampler **pSamplers
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanGraphicsPipeline *graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
+	framebuffer = VULKAN_INTERNAL_FetchFramebuffer(
+		renderer,
+		renderPass,
+		colorAttachmentInfos,
+		colorAttachmentCount,
+		depthStencilAttachmentInfo,
+		framebufferWidth,
+		framebufferHeight
+	);
 
-	VulkanTexture *currentTexture;
-	VulkanSampler *currentSampler;
-	uint32_t i, samplerCount;
-	VkDescriptorImageInfo descriptorImageInfos[MAX_TEXTURE_SAMPLERS];
+	VULKAN_INTERNAL_TrackFramebuffer(renderer, vulkanCommandBuffer, framebuffer);
 
-	if (graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCache == NULL)
+	/* Layout transitions */
+
+	for (i = 0; i < colorAttachmentCount; i += 1)
 	{
-		return;
-	}
+		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
 
-	samplerCount = graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCache->bindingCount;
+		/* Aliased memory may hold another texture's contents from earlier in the frame,
+		 * so wait on everything before it and throw the old contents away.
+		 */
+		discardContents =
+			VULKAN_INTERNAL_IsAliasedTexture(texture) &&
+			colorAttachmentInfos[i].loadOp != REFRESH_LOADOP_LOAD;
 
-	for (i = 0; i < samplerCount; i += 1)
-	{
-		currentTexture = ((VulkanTextureContainer*) pTextures[i])->vulkanTexture;
-		currentSampler = (VulkanSampler*) pSamplers[i];
-		descriptorImageInfos[i].imageView = currentTexture->view;
-		descriptorImageInfos[i].sampler = currentSampler->sampler;
-		descriptorImageInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		/* Only the attached subresource changes layout, so other levels stay sampleable */
+		layer = texture->isCube ? colorAttachmentInfos[i].layer : 0;
 
-		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, currentTexture);
-		VULKAN_INTERNAL_TrackSampler(renderer, vulkanCommandBuffer, currentSampler);
+		if (discardContents)
+		{
+			*VULKAN_INTERNAL_SubresourceAccessType(
+				texture,
+				layer,
+				colorAttachmentInfos[i].level
+			) = RESOURCE_ACCESS_GENERAL;
+		}
+
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_COLOR_ATTACHMENT_READ_WRITE,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			layer,
+			1,
+			colorAttachmentInfos[i].level,
+			1,
+			discardContents,
+			texture
+		);
+
+		if (texture->msaaTex != NULL)
+		{
+			clearCount += 1;
+			multisampleAttachmentCount += 1;
+		}
+
+		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, texture);
 	}
 
-	vulkanCommandBuffer->fragmentSamplerDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-		renderer,
-		vulkanCommandBuffer,
-		graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCache,
-		descriptorImageInfos,
-		NULL
-	);
-}
+	if (depthStencilAttachmentInfo != NULL)
+	{
+		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
+		depthAspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
 
-static void VULKAN_GetBufferData(
-	Refresh_Renderer *driverData,
-	Refresh_Buffer *buffer,
-	void *data,
-	uint32_t dataLengthInBytes
-) {
-	VulkanBuffer* vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
-	uint8_t *dataPtr = (uint8_t*) data;
-	uint8_t *mapPointer;
+		if (IsStencilFormat(texture->format))
+		{
+			depthAspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
+		}
 
-	mapPointer =
-		vulkanBuffer->usedRegion->allocation->mapPointer +
-		vulkanBuffer->usedRegion->resourceOffset;
+		discardContents =
+			VULKAN_INTERNAL_IsAliasedTexture(texture) &&
+			depthStencilAttachmentInfo->loadOp != REFRESH_LOADOP_LOAD &&
+			(	!IsStencilFormat(texture->format) ||
+				depthStencilAttachmentInfo->stencilLoadOp != REFRESH_LOADOP_LOAD	);
 
-	SDL_memcpy(
-		dataPtr,
-		mapPointer,
-		dataLengthInBytes
-	);
-}
+		layer = texture->isCube ? depthStencilAttachmentInfo->layer : 0;
 
-static void VULKAN_CopyTextureToBuffer(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_TextureSlice *textureSlice,
-	Refresh_Buffer *buffer
-) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanTexture *vulkanTexture = ((VulkanTextureContainer*) textureSlice->texture)->vulkanTexture;
-	VulkanBuffer* vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
+		if (discardContents)
+		{
+			*VULKAN_INTERNAL_SubresourceAccessType(
+				texture,
+				layer,
+				depthStencilAttachmentInfo->level
+			) = RESOURCE_ACCESS_GENERAL;
+		}
 
-	VulkanResourceAccessType prevResourceAccess;
-	VkBufferImageCopy imageCopy;
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_WRITE,
+			depthAspectFlags,
+			layer,
+			1,
+			depthStencilAttachmentInfo->level,
+			1,
+			discardContents,
+			texture
+		);
 
-	/* Cache this so we can restore it later */
-	prevResourceAccess = vulkanTexture->resourceAccessType;
+		clearCount += 1;
 
-	VULKAN_INTERNAL_ImageMemoryBarrier(
-		renderer,
-		vulkanCommandBuffer->commandBuffer,
-		RESOURCE_ACCESS_TRANSFER_READ,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		textureSlice->layer,
-		1,
-		textureSlice->level,
-		1,
-		0,
-		vulkanTexture->image,
-		&vulkanTexture->resourceAccessType
-	);
+		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, texture);
+	}
 
-	/* Save texture data to buffer */
+	/* Set clear values */
 
-	imageCopy.imageExtent.width = textureSlice->rectangle.w;
-	imageCopy.imageExtent.height = textureSlice->rectangle.h;
-	imageCopy.imageExtent.depth = 1;
-	imageCopy.bufferRowLength = textureSlice->rectangle.w;
-	imageCopy.bufferImageHeight = textureSlice->rectangle.h;
-	imageCopy.imageOffset.x = textureSlice->rectangle.x;
-	imageCopy.imageOffset.y = textureSlice->rectangle.y;
-	imageCopy.imageOffset.z = textureSlice->depth;
-	imageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	imageCopy.imageSubresource.baseArrayLayer = textureSlice->layer;
-	imageCopy.imageSubresource.layerCount = 1;
-	imageCopy.imageSubresource.mipLevel = textureSlice->level;
-	imageCopy.bufferOffset = 0;
+	clearValues = SDL_stack_alloc(VkClearValue, clearCount);
 
-	renderer->vkCmdCopyImageToBuffer(
-		vulkanCommandBuffer->commandBuffer,
-		vulkanTexture->image,
-		AccessMap[vulkanTexture->resourceAccessType].imageLayout,
-		vulkanBuffer->buffer,
-		1,
-		&imageCopy
-	);
+	totalColorAttachmentCount = colorAttachmentCount + multisampleAttachmentCount;
 
-	/* Restore the image layout */
+	for (i = 0; i < totalColorAttachmentCount; i += 1)
+	{
+		clearValues[i].color.float32[0] = colorAttachmentInfos[i].clearColor.x;
+		clearValues[i].color.float32[1] = colorAttachmentInfos[i].clearColor.y;
+		clearValues[i].color.float32[2] = colorAttachmentInfos[i].clearColor.z;
+		clearValues[i].color.float32[3] = colorAttachmentInfos[i].clearColor.w;
 
-	VULKAN_INTERNAL_ImageMemoryBarrier(
-		renderer,
+		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
+		if (texture->msaaTex != NULL)
+		{
+			clearValues[i+1].color.float32[0] = colorAttachmentInfos[i].clearColor.x;
+			clearValues[i+1].color.float32[1] = colorAttachmentInfos[i].clearColor.y;
+			clearValues[i+1].color.float32[2] = colorAttachmentInfos[i].clearColor.z;
+			clearValues[i+1].color.float32[3] = colorAttachmentInfos[i].clearColor.w;
+			i += 1;
+		}
+	}
+
+	if (depthStencilAttachmentInfo != NULL)
+	{
+		clearValues[totalColorAttachmentCount].depthStencil.depth =
+			depthStencilAttachmentInfo->depthStencilClearValue.depth;
+		clearValues[totalColorAttachmentCount].depthStencil.stencil =
+			depthStencilAttachmentInfo->depthStencilClearValue.stencil;
+	}
+
+	VkRenderPassBeginInfo renderPassBeginInfo;
+	renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+	renderPassBeginInfo.pNext = NULL;
+	renderPassBeginInfo.renderPass = renderPass;
+	renderPassBeginInfo.framebuffer = framebuffer->framebuffer;
+	renderPassBeginInfo.pClearValues = clearValues;
+	renderPassBeginInfo.clearValueCount = clearCount;
+	renderPassBeginInfo.renderArea.extent.width = framebufferWidth;
+	renderPassBeginInfo.renderArea.extent.height = framebufferHeight;
+	renderPassBeginInfo.renderArea.offset.x = 0;
+	renderPassBeginInfo.renderArea.offset.y = 0;
+
+	renderer->vkCmdBeginRenderPass(
 		vulkanCommandBuffer->commandBuffer,
-		prevResourceAccess,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		textureSlice->layer,
-		1,
-		textureSlice->level,
-		1,
-		0,
-		vulkanTexture->image,
-		&vulkanTexture->resourceAccessType
+		&renderPassBeginInfo,
+		VK_SUBPASS_CONTENTS_INLINE
 	);
 
-	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
-	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, vulkanTexture);
-}
-
-static void VULKAN_INTERNAL_QueueDestroyTexture(
-	VulkanRenderer *renderer,
-	VulkanTexture *vulkanTexture
-) {
-	SDL_LockMutex(renderer->disposeLock);
-
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->texturesToDestroy,
-		VulkanTexture*,
-		renderer->texturesToDestroyCount + 1,
-		renderer->texturesToDestroyCapacity,
-		renderer->texturesToDestroyCapacity * 2
-	)
+	SDL_stack_free(clearValues);
 
-	renderer->texturesToDestroy[
-		renderer->texturesToDestroyCount
-	] = vulkanTexture;
-	renderer->texturesToDestroyCount += 1;
+	for (i = 0; i < colorAttachmentCount; i += 1)
+	{
+		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
+		vulkanCommandBuffer->renderPassColorTargetTextures[i] = texture;
+		vulkanCommandBuffer->renderPassColorTargetLayers[i] = texture->isCube ? colorAttachmentInfos[i].layer : 0;
+		vulkanCommandBuffer->renderPassColorTargetLevels[i] = colorAttachmentInfos[i].level;
+	}
+	vulkanCommandBuffer->renderPassColorTargetCount = colorAttachmentCount;
 
-	SDL_UnlockMutex(renderer->disposeLock);
-}
+	if (depthStencilAttachmentInfo != NULL)
+	{
+		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
+		vulkanCommandBuffer->renderPassDepthTexture = texture;
+		vulkanCommandBuffer->renderPassDepthLayer = texture->isCube ? depthStencilAttachmentInfo->layer : 0;
+		vulkanCommandBuffer->renderPassDepthLevel = depthStencilAttachmentInfo->level;
+	}
 
-static void VULKAN_QueueDestroyTexture(
-	Refresh_Renderer *driverData,
-	Refresh_Texture *texture
-) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanTextureContainer *vulkanTextureContainer = (VulkanTextureContainer *)texture;
-	VulkanTexture *vulkanTexture = vulkanTextureContainer->vulkanTexture;
+	/* Set sensible default viewport state */
 
-	SDL_LockMutex(renderer->disposeLock);
+	defaultViewport.x = 0;
+	defaultViewport.y = 0;
+	defaultViewport.w = framebufferWidth;
+	defaultViewport.h = framebufferHeight;
+	defaultViewport.minDepth = 0;
+	defaultViewport.maxDepth = 1;
 
-	VULKAN_INTERNAL_QueueDestroyTexture(renderer, vulkanTexture);
+	VULKAN_INTERNAL_SetCurrentViewport(
+		vulkanCommandBuffer,
+		&defaultViewport
+	);
 
-	/* Containers are just client handles, so we can destroy immediately */
-	SDL_free(vulkanTextureContainer);
+	defaultScissor.x = 0;
+	defaultScissor.y = 0;
+	defaultScissor.w = framebufferWidth;
+	defaultScissor.h = framebufferHeight;
 
-	SDL_UnlockMutex(renderer->disposeLock);
+	VULKAN_INTERNAL_SetCurrentScissor(
+		vulkanCommandBuffer,
+		&defaultScissor
+	);
 }
 
-static void VULKAN_QueueDestroySampler(
+static void VULKAN_EndRenderPass(
 	Refresh_Renderer *driverData,
-	Refresh_Sampler *sampler
+	Refresh_CommandBuffer *commandBuffer
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanSampler* vulkanSampler = (VulkanSampler*) sampler;
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanTexture *currentTexture;
+	uint32_t i;
 
-	SDL_LockMutex(renderer->disposeLock);
+	renderer->vkCmdEndRenderPass(
+		vulkanCommandBuffer->commandBuffer
+	);
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->samplersToDestroy,
-		VulkanSampler*,
-		renderer->samplersToDestroyCount + 1,
-		renderer->samplersToDestroyCapacity,
-		renderer->samplersToDestroyCapacity * 2
-	)
+	/* If the render targets can be sampled, transition them to sample layout */
+	for (i = 0; i < vulkanCommandBuffer->renderPassColorTargetCount; i += 1)
+	{
+		currentTexture = vulkanCommandBuffer->renderPassColorTargetTextures[i];
 
-	renderer->samplersToDestroy[renderer->samplersToDestroyCount] = vulkanSampler;
-	renderer->samplersToDestroyCount += 1;
+		if (currentTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+		{
+			VULKAN_INTERNAL_ImageMemoryBarrier(
+				renderer,
+				vulkanCommandBuffer->commandBuffer,
+				RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
+				currentTexture->aspectFlags,
+				vulkanCommandBuffer->renderPassColorTargetLayers[i],
+				1,
+				vulkanCommandBuffer->renderPassColorTargetLevels[i],
+				1,
+				0,
+				currentTexture
+			);
+		}
+		else if (currentTexture->usageFlags & VK_IMAGE_USAGE_STORAGE_BIT)
+		{
+			VULKAN_INTERNAL_ImageMemoryBarrier(
+				renderer,
+				vulkanCommandBuffer->commandBuffer,
+				RESOURCE_ACCESS_COMPUTE_SHADER_STORAGE_IMAGE_READ_WRITE,
+				currentTexture->aspectFlags,
+				vulkanCommandBuffer->renderPassColorTargetLayers[i],
+				1,
+				vulkanCommandBuffer->renderPassColorTargetLevels[i],
+				1,
+				0,
+				currentTexture
+			);
+		}
+	}
+	vulkanCommandBuffer->renderPassColorTargetCount = 0;
 
-	SDL_UnlockMutex(renderer->disposeLock);
+	if (vulkanCommandBuffer->renderPassDepthTexture != NULL)
+	{
+		currentTexture = vulkanCommandBuffer->renderPassDepthTexture;
+
+		if (currentTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+		{
+			VULKAN_INTERNAL_ImageMemoryBarrier(
+				renderer,
+				vulkanCommandBuffer->commandBuffer,
+				RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
+				currentTexture->aspectFlags,
+				vulkanCommandBuffer->renderPassDepthLayer,
+				1,
+				vulkanCommandBuffer->renderPassDepthLevel,
+				1,
+				0,
+				currentTexture
+			);
+		}
+	}
+	vulkanCommandBuffer->renderPassDepthTexture = NULL;
+
+	vulkanCommandBuffer->currentGraphicsPipeline = NULL;
 }
 
-static void VULKAN_INTERNAL_QueueDestroyBuffer(
-	VulkanRenderer *renderer,
-	VulkanBuffer *vulkanBuffer
+static void VULKAN_BindGraphicsPipeline(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_GraphicsPipeline *graphicsPipeline
 ) {
-	SDL_LockMutex(renderer->disposeLock);
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanGraphicsPipeline* pipeline = (VulkanGraphicsPipeline*) graphicsPipeline;
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->buffersToDestroy,
-		VulkanBuffer*,
-		renderer->buffersToDestroyCount + 1,
-		renderer->buffersToDestroyCapacity,
-		renderer->buffersToDestroyCapacity * 2
-	)
+	/* A section is kept across pipelines, it is only replaced once full */
+	if (	vulkanCommandBuffer->vertexUniformBuffer == renderer->dummyVertexUniformBuffer ||
+		vulkanCommandBuffer->vertexUniformBuffer == NULL
+	) {
+		if (pipeline->vertexUniformBlockSize == 0)
+		{
+			vulkanCommandBuffer->vertexUniformBuffer = renderer->dummyVertexUniformBuffer;
+		}
+		else
+		{
+			vulkanCommandBuffer->vertexUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+				renderer,
+				renderer->vertexUniformBufferPool
+			);
+		}
+	}
 
-	renderer->buffersToDestroy[
-		renderer->buffersToDestroyCount
-	] = vulkanBuffer;
-	renderer->buffersToDestroyCount += 1;
+	/* A section is kept across pipelines, it is only replaced once full */
+	if (	vulkanCommandBuffer->fragmentUniformBuffer == renderer->dummyFragmentUniformBuffer ||
+		vulkanCommandBuffer->fragmentUniformBuffer == NULL
+	) {
+		if (pipeline->fragmentUniformBlockSize == 0)
+		{
+			vulkanCommandBuffer->fragmentUniformBuffer = renderer->dummyFragmentUniformBuffer;
+		}
+		else
+		{
+			vulkanCommandBuffer->fragmentUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+				renderer,
+				renderer->fragmentUniformBufferPool
+			);
+		}
+	}
 
-	SDL_UnlockMutex(renderer->disposeLock);
-}
+	/* bind dummy sets if necessary */
+	if (pipeline->pipelineLayout->vertexSamplerDescriptorSetCache == NULL)
+	{
+		vulkanCommandBuffer->vertexSamplerDescriptorSet = renderer->emptyVertexSamplerDescriptorSet;
+	}
 
-static void VULKAN_QueueDestroyBuffer(
-	Refresh_Renderer *driverData,
-	Refresh_Buffer *buffer
-) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanBufferContainer *vulkanBufferContainer = (VulkanBufferContainer*) buffer;
-	VulkanBuffer *vulkanBuffer = vulkanBufferContainer->vulkanBuffer;
+	if (pipeline->pipelineLayout->fragmentSamplerDescriptorSetCache == NULL)
+	{
+		vulkanCommandBuffer->fragmentSamplerDescriptorSet = renderer->emptyFragmentSamplerDescriptorSet;
+	}
 
-	SDL_LockMutex(renderer->disposeLock);
+	renderer->vkCmdBindPipeline(
+		vulkanCommandBuffer->commandBuffer,
+		VK_PIPELINE_BIND_POINT_GRAPHICS,
+		pipeline->pipeline
+	);
 
-	VULKAN_INTERNAL_QueueDestroyBuffer(renderer, vulkanBuffer);
+	vulkanCommandBuffer->currentGraphicsPipeline = pipeline;
+	vulkanCommandBuffer->graphicsDescriptorSetsBound = 0;
 
-	/* Containers are just client handles, so we can destroy immediately */
-	SDL_free(vulkanBufferContainer);
+	VULKAN_INTERNAL_TrackGraphicsPipeline(renderer, vulkanCommandBuffer, pipeline);
 
-	SDL_UnlockMutex(renderer->disposeLock);
+	renderer->vkCmdSetViewport(
+		vulkanCommandBuffer->commandBuffer,
+		0,
+		1,
+		&vulkanCommandBuffer->currentViewport
+	);
+
+	renderer->vkCmdSetScissor(
+		vulkanCommandBuffer->commandBuffer,
+		0,
+		1,
+		&vulkanCommandBuffer->currentScissor
+	);
 }
 
-static void VULKAN_QueueDestroyShaderModule(
+static void VULKAN_BindVertexBuffers(
 	Refresh_Renderer *driverData,
-	Refresh_ShaderModule *shaderModule
+	Refresh_CommandBuffer *commandBuffer,
+	uint32_t firstBinding,
+	uint32_t bindingCount,
+	Refresh_Buffer **pBuffers,
+	uint64_t *pOffsets
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanShaderModule *vulkanShaderModule = (VulkanShaderModule*) shaderModule;
-
-	SDL_LockMutex(renderer->disposeLock);
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer *currentVulkanBuffer;
+	VkBuffer *buffers = SDL_stack_alloc(VkBuffer, bindingCount);
+	VkDeviceSize *offsets = SDL_stack_alloc(VkDeviceSize, bindingCount);
+	uint32_t i;
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->shaderModulesToDestroy,
-		VulkanShaderModule*,
-		renderer->shaderModulesToDestroyCount + 1,
-		renderer->shaderModulesToDestroyCapacity,
-		renderer->shaderModulesToDestroyCapacity * 2
-	)
+	for (i = 0; i < bindingCount; i += 1)
+	{
+		currentVulkanBuffer = ((VulkanBufferContainer*) pBuffers[i])->vulkanBuffer;
+		buffers[i] = currentVulkanBuffer->buffer;
+		offsets[i] = currentVulkanBuffer->offset + pOffsets[i];
+		VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, currentVulkanBuffer);
+	}
 
-	renderer->shaderModulesToDestroy[renderer->shaderModulesToDestroyCount] = vulkanShaderModule;
-	renderer->shaderModulesToDestroyCount += 1;
+	renderer->vkCmdBindVertexBuffers(
+		vulkanCommandBuffer->commandBuffer,
+		firstBinding,
+		bindingCount,
+		buffers,
+		offsets
+	);
 
-	SDL_UnlockMutex(renderer->disposeLock);
+	SDL_stack_free(buffers);
+	SDL_stack_free(offsets);
 }
 
-static void VULKAN_QueueDestroyComputePipeline(
+static void VULKAN_BindIndexBuffer(
 	Refresh_Renderer *driverData,
-	Refresh_ComputePipeline *computePipeline
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint64_t offset,
+	Refresh_IndexElementSize indexElementSize
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanComputePipeline *vulkanComputePipeline = (VulkanComputePipeline*) computePipeline;
-
-	SDL_LockMutex(renderer->disposeLock);
-
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->computePipelinesToDestroy,
-		VulkanComputePipeline*,
-		renderer->computePipelinesToDestroyCount + 1,
-		renderer->computePipelinesToDestroyCapacity,
-		renderer->computePipelinesToDestroyCapacity * 2
-	)
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer* vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
 
-	renderer->computePipelinesToDestroy[renderer->computePipelinesToDestroyCount] = vulkanComputePipeline;
-	renderer->computePipelinesToDestroyCount += 1;
+	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
 
-	SDL_UnlockMutex(renderer->disposeLock);
+	renderer->vkCmdBindIndexBuffer(
+		vulkanCommandBuffer->commandBuffer,
+		vulkanBuffer->buffer,
+		vulkanBuffer->offset + offset,
+		RefreshToVK_IndexType[indexElementSize]
+	);
 }
 
-static void VULKAN_QueueDestroyGraphicsPipeline(
+static void VULKAN_BindComputePipeline(
 	Refresh_Renderer *driverData,
-	Refresh_GraphicsPipeline *graphicsPipeline
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_ComputePipeline *computePipeline
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanGraphicsPipeline *vulkanGraphicsPipeline = (VulkanGraphicsPipeline*) graphicsPipeline;
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanComputePipeline *vulkanComputePipeline = (VulkanComputePipeline*) computePipeline;
 
-	SDL_LockMutex(renderer->disposeLock);
+	/* bind dummy sets */
+	if (vulkanComputePipeline->pipelineLayout->bufferDescriptorSetCache == NULL)
+	{
+		vulkanCommandBuffer->bufferDescriptorSet = renderer->emptyComputeBufferDescriptorSet;
+	}
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->graphicsPipelinesToDestroy,
-		VulkanGraphicsPipeline*,
-		renderer->graphicsPipelinesToDestroyCount + 1,
-		renderer->graphicsPipelinesToDestroyCapacity,
-		renderer->graphicsPipelinesToDestroyCapacity * 2
-	)
+	if (vulkanComputePipeline->pipelineLayout->imageDescriptorSetCache == NULL)
+	{
+		vulkanCommandBuffer->imageDescriptorSet = renderer->emptyComputeImageDescriptorSet;
+	}
 
-	renderer->graphicsPipelinesToDestroy[renderer->graphicsPipelinesToDestroyCount] = vulkanGraphicsPipeline;
-	renderer->graphicsPipelinesToDestroyCount += 1;
+	renderer->vkCmdBindPipeline(
+		vulkanCommandBuffer->commandBuffer,
+		VK_PIPELINE_BIND_POINT_COMPUTE,
+		vulkanComputePipeline->pipeline
+	);
 
-	SDL_UnlockMutex(renderer->disposeLock);
-}
+	vulkanCommandBuffer->currentComputePipeline = vulkanComputePipeline;
 
-/* Command Buffer render state */
+	/* A section is kept across pipelines, it is only replaced once full */
+	if (	vulkanCommandBuffer->computeUniformBuffer == renderer->dummyComputeUniformBuffer ||
+		vulkanCommandBuffer->computeUniformBuffer == NULL
+	) {
+		if (vulkanComputePipeline->uniformBlockSize == 0)
+		{
+			vulkanCommandBuffer->computeUniformBuffer = renderer->dummyComputeUniformBuffer;
+		}
+		else
+		{
+			vulkanCommandBuffer->computeUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
+				renderer,
+				renderer->computeUniformBufferPool
+			);
+		}
+	}
 
-static VkRenderPass VULKAN_INTERNAL_FetchRenderPass(
-	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer,
-	Refresh_ColorAttachmentInfo *colorAttachmentInfos,
-	uint32_t colorAttachmentCount,
-	Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo
+	VULKAN_INTERNAL_TrackComputePipeline(renderer, vulkanCommandBuffer, vulkanComputePipeline);
+}
+
+static void VULKAN_BindComputeBuffers(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer **pBuffers
 ) {
-	VkRenderPass renderPass;
-	RenderPassHash hash;
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
+
+	VulkanBuffer *currentVulkanBuffer;
+	VkDescriptorBufferInfo descriptorBufferInfos[MAX_BUFFER_BINDINGS];
 	uint32_t i;
-	VulkanTexture *texture;
 
-	SDL_LockMutex(renderer->renderPassFetchLock);
+	/* Uploads must land before the compute barriers below */
+	VULKAN_INTERNAL_FlushBufferUploads(renderer, vulkanCommandBuffer);
 
-	for (i = 0; i < colorAttachmentCount; i += 1)
+	if (computePipeline->pipelineLayout->bufferDescriptorSetCache == NULL)
 	{
-		hash.colorTargetDescriptions[i].format = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture->format;
-		hash.colorTargetDescriptions[i].clearColor = colorAttachmentInfos[i].clearColor;
-		hash.colorTargetDescriptions[i].loadOp = colorAttachmentInfos[i].loadOp;
-		hash.colorTargetDescriptions[i].storeOp = colorAttachmentInfos[i].storeOp;
+		return;
 	}
 
-	hash.colorAttachmentSampleCount = REFRESH_SAMPLECOUNT_1;
-	if (colorAttachmentCount > 0)
+	for (i = 0; i < computePipeline->pipelineLayout->bufferDescriptorSetCache->bindingCount; i += 1)
 	{
-		texture = ((VulkanTextureContainer*) colorAttachmentInfos[0].texture)->vulkanTexture;
-		if (texture->msaaTex != NULL)
-		{
-			hash.colorAttachmentSampleCount = texture->msaaTex->sampleCount;
-		}
-	}
-
-	hash.colorAttachmentCount = colorAttachmentCount;
+		currentVulkanBuffer = ((VulkanBufferContainer*) pBuffers[i])->vulkanBuffer;
 
-	if (depthStencilAttachmentInfo == NULL)
-	{
-		hash.depthStencilTargetDescription.format = 0;
-		hash.depthStencilTargetDescription.loadOp = REFRESH_LOADOP_DONT_CARE;
-		hash.depthStencilTargetDescription.storeOp = REFRESH_STOREOP_DONT_CARE;
-		hash.depthStencilTargetDescription.stencilLoadOp = REFRESH_LOADOP_DONT_CARE;
-		hash.depthStencilTargetDescription.stencilStoreOp = REFRESH_STOREOP_DONT_CARE;
-	}
-	else
-	{
-		hash.depthStencilTargetDescription.format = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture->format;
-		hash.depthStencilTargetDescription.loadOp = depthStencilAttachmentInfo->loadOp;
-		hash.depthStencilTargetDescription.storeOp = depthStencilAttachmentInfo->storeOp;
-		hash.depthStencilTargetDescription.stencilLoadOp = depthStencilAttachmentInfo->stencilLoadOp;
-		hash.depthStencilTargetDescription.stencilStoreOp = depthStencilAttachmentInfo->stencilStoreOp;
-	}
+		descriptorBufferInfos[i].buffer = currentVulkanBuffer->buffer;
+		descriptorBufferInfos[i].offset = currentVulkanBuffer->offset;
+		descriptorBufferInfos[i].range = currentVulkanBuffer->size;
 
-	renderPass = RenderPassHashArray_Fetch(
-		&renderer->renderPassHashArray,
-		&hash
-	);
+		VULKAN_INTERNAL_BufferMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_COMPUTE_SHADER_BUFFER_READ_WRITE,
+			currentVulkanBuffer
+		);
 
-	if (renderPass != VK_NULL_HANDLE)
-	{
-		SDL_UnlockMutex(renderer->renderPassFetchLock);
-		return renderPass;
+		VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, currentVulkanBuffer);
 	}
 
-	renderPass = VULKAN_INTERNAL_CreateRenderPass(
-		renderer,
-		commandBuffer,
-		colorAttachmentInfos,
-		colorAttachmentCount,
-		depthStencilAttachmentInfo
-	);
+	vulkanCommandBuffer->bufferDescriptorSet =
+		VULKAN_INTERNAL_FetchDescriptorSet(
+			renderer,
+			vulkanCommandBuffer,
+			computePipeline->pipelineLayout->bufferDescriptorSetCache,
+			NULL,
+			descriptorBufferInfos
+		);
 
-	if (renderPass != VK_NULL_HANDLE)
+	if (vulkanCommandBuffer->boundComputeBufferCount == vulkanCommandBuffer->boundComputeBufferCapacity)
 	{
-		RenderPassHashArray_Insert(
-			&renderer->renderPassHashArray,
-			hash,
-			renderPass
+		vulkanCommandBuffer->boundComputeBufferCapacity *= 2;
+		vulkanCommandBuffer->boundComputeBuffers = SDL_realloc(
+			vulkanCommandBuffer->boundComputeBuffers,
+			vulkanCommandBuffer->boundComputeBufferCapacity * sizeof(VulkanBuffer*)
 		);
 	}
 
-	SDL_UnlockMutex(renderer->renderPassFetchLock);
-	return renderPass;
+	vulkanCommandBuffer->boundComputeBuffers[vulkanCommandBuffer->boundComputeBufferCount] = currentVulkanBuffer;
+	vulkanCommandBuffer->boundComputeBufferCount += 1;
 }
 
-static VulkanFramebuffer* VULKAN_INTERNAL_FetchFramebuffer(
-	VulkanRenderer *renderer,
-	VkRenderPass renderPass,
-	Refresh_ColorAttachmentInfo *colorAttachmentInfos,
-	uint32_t colorAttachmentCount,
-	Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo,
-	uint32_t width,
-	uint32_t height
+static void VULKAN_BindComputeTextures(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Texture **pTextures
 ) {
-	VulkanFramebuffer *vulkanFramebuffer;
-	VkFramebufferCreateInfo framebufferInfo;
-	VkResult result;
-	VkImageView imageViewAttachments[2 * MAX_COLOR_TARGET_BINDINGS + 1];
-	FramebufferHash hash;
-	VulkanTexture *texture;
-	VulkanRenderTarget *renderTarget;
-	uint32_t attachmentCount = 0;
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
+
+	VulkanTexture *currentTexture;
+	VkDescriptorImageInfo descriptorImageInfos[MAX_TEXTURE_SAMPLERS];
 	uint32_t i;
 
-	for (i = 0; i < MAX_COLOR_TARGET_BINDINGS; i += 1)
+	if (computePipeline->pipelineLayout->imageDescriptorSetCache == NULL)
 	{
-		hash.colorAttachmentViews[i] = VK_NULL_HANDLE;
-		hash.colorMultiSampleAttachmentViews[i] = VK_NULL_HANDLE;
+		return;
 	}
 
-	hash.colorAttachmentCount = colorAttachmentCount;
-
-	for (i = 0; i < colorAttachmentCount; i += 1)
+	for (i = 0; i < computePipeline->pipelineLayout->imageDescriptorSetCache->bindingCount; i += 1)
 	{
-		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
+		currentTexture = ((VulkanTextureContainer*) pTextures[i])->vulkanTexture;
+		descriptorImageInfos[i].imageView = currentTexture->view;
+		descriptorImageInfos[i].sampler = VK_NULL_HANDLE;
+		descriptorImageInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
-		renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
+		VULKAN_INTERNAL_ImageMemoryBarrier(
 			renderer,
-			texture,
-			colorAttachmentInfos[i].depth,
-			colorAttachmentInfos[i].layer,
-			colorAttachmentInfos[i].level
-		);
-
-		hash.colorAttachmentViews[i] = (
-			renderTarget->view
-		);
-
-		if (texture->msaaTex != NULL)
-		{
-			renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
-				renderer,
-				texture->msaaTex,
-				colorAttachmentInfos[i].depth,
-				colorAttachmentInfos[i].layer,
-				colorAttachmentInfos[i].level
-			);
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_COMPUTE_SHADER_STORAGE_IMAGE_READ_WRITE,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			0,
+			currentTexture->layerCount,
+			0,
+			currentTexture->levelCount,
+			0,
+			currentTexture
+		);
 
-			hash.colorMultiSampleAttachmentViews[i] = (
-				renderTarget->view
+		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, currentTexture);
+
+		if (vulkanCommandBuffer->boundComputeTextureCount == vulkanCommandBuffer->boundComputeTextureCapacity)
+		{
+			vulkanCommandBuffer->boundComputeTextureCapacity *= 2;
+			vulkanCommandBuffer->boundComputeTextures = SDL_realloc(
+				vulkanCommandBuffer->boundComputeTextures,
+				vulkanCommandBuffer->boundComputeTextureCapacity * sizeof(VulkanTexture *)
 			);
 		}
-	}
 
-	if (depthStencilAttachmentInfo == NULL)
-	{
-		hash.depthStencilAttachmentView = VK_NULL_HANDLE;
+		vulkanCommandBuffer->boundComputeTextures[i] = currentTexture;
+		vulkanCommandBuffer->boundComputeTextureCount += 1;
 	}
-	else
-	{
-		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
-		renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
+
+	vulkanCommandBuffer->imageDescriptorSet =
+		VULKAN_INTERNAL_FetchDescriptorSet(
 			renderer,
-			texture,
-			depthStencilAttachmentInfo->depth,
-			depthStencilAttachmentInfo->layer,
-			depthStencilAttachmentInfo->level
+			vulkanCommandBuffer,
+			computePipeline->pipelineLayout->imageDescriptorSetCache,
+			descriptorImageInfos,
+			NULL
 		);
-		hash.depthStencilAttachmentView = renderTarget->view;
-	}
+}
 
-	hash.width = width;
-	hash.height = height;
+static void VULKAN_INTERNAL_AllocateCommandBuffers(
+	VulkanRenderer *renderer,
+	VulkanCommandPool *vulkanCommandPool,
+	uint32_t allocateCount
+) {
+	VkCommandBufferAllocateInfo allocateInfo;
+	VkResult vulkanResult;
+	uint32_t i;
+	VkCommandBuffer *commandBuffers = SDL_stack_alloc(VkCommandBuffer, allocateCount);
+	VulkanCommandBuffer *commandBuffer;
 
-	SDL_LockMutex(renderer->framebufferFetchLock);
+	vulkanCommandPool->inactiveCommandBufferCapacity += allocateCount;
 
-	vulkanFramebuffer = FramebufferHashArray_Fetch(
-		&renderer->framebufferHashArray,
-		&hash
+	vulkanCommandPool->inactiveCommandBuffers = SDL_realloc(
+		vulkanCommandPool->inactiveCommandBuffers,
+		sizeof(VulkanCommandBuffer*) *
+		vulkanCommandPool->inactiveCommandBufferCapacity
 	);
 
-	SDL_UnlockMutex(renderer->framebufferFetchLock);
+	allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocateInfo.pNext = NULL;
+	allocateInfo.commandPool = vulkanCommandPool->commandPool;
+	allocateInfo.commandBufferCount = allocateCount;
+	allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 
-	if (vulkanFramebuffer != NULL)
+	vulkanResult = renderer->vkAllocateCommandBuffers(
+		renderer->logicalDevice,
+		&allocateInfo,
+		commandBuffers
+	);
+
+	if (vulkanResult != VK_SUCCESS)
 	{
-		return vulkanFramebuffer;
+		LogVulkanResultAsError("vkAllocateCommandBuffers", vulkanResult);
+		SDL_stack_free(commandBuffers);
+		return;
 	}
 
-	vulkanFramebuffer = SDL_malloc(sizeof(VulkanFramebuffer));
+	for (i = 0; i < allocateCount; i += 1)
+	{
+		commandBuffer = SDL_malloc(sizeof(VulkanCommandBuffer));
+		commandBuffer->commandPool = vulkanCommandPool;
+		commandBuffer->commandBuffer = commandBuffers[i];
 
-	SDL_AtomicSet(&vulkanFramebuffer->referenceCount, 0);
+		commandBuffer->inFlightFence = VK_NULL_HANDLE;
+		commandBuffer->renderPassDepthTexture = NULL;
 
-	/* Create a new framebuffer */
+		/* Presentation tracking */
 
-	for (i = 0; i < colorAttachmentCount; i += 1)
-	{
-		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
+		commandBuffer->presentDataCapacity = 1;
+		commandBuffer->presentDataCount = 0;
+		commandBuffer->presentDatas = SDL_malloc(
+			commandBuffer->presentDataCapacity * sizeof(VkPresentInfoKHR)
+		);
 
-		renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
-			renderer,
-			texture,
-			colorAttachmentInfos[i].depth,
-			colorAttachmentInfos[i].layer,
-			colorAttachmentInfos[i].level
+		commandBuffer->waitSemaphoreCapacity = 1;
+		commandBuffer->waitSemaphoreCount = 0;
+		commandBuffer->waitSemaphores = SDL_malloc(
+			commandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore)
+		);
+		commandBuffer->waitSemaphoreStages = SDL_malloc(
+			commandBuffer->waitSemaphoreCapacity * sizeof(VkPipelineStageFlags)
 		);
 
-		imageViewAttachments[attachmentCount] =
-			renderTarget->view;
+		commandBuffer->signalSemaphoreCapacity = 1;
+		commandBuffer->signalSemaphoreCount = 0;
+		commandBuffer->signalSemaphores = SDL_malloc(
+			commandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore)
+		);
 
-		attachmentCount += 1;
+		/* Queue ownership transfers */
 
-		if (texture->msaaTex != NULL)
-		{
-			renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
-				renderer,
-				texture->msaaTex,
-				colorAttachmentInfos[i].depth,
-				colorAttachmentInfos[i].layer,
-				colorAttachmentInfos[i].level
-			);
+		commandBuffer->transferSemaphoreCapacity = 0;
+		commandBuffer->transferSemaphoreCount = 0;
+		commandBuffer->transferSemaphores = NULL;
 
-			imageViewAttachments[attachmentCount] =
-				renderTarget->view;
+		commandBuffer->isTransfer = vulkanCommandPool->isTransfer;
 
-			attachmentCount += 1;
-		}
-	}
+		commandBuffer->releaseBufferCapacity = 0;
+		commandBuffer->releaseBufferCount = 0;
+		commandBuffer->releaseBuffers = NULL;
+		commandBuffer->releaseBufferAccessTypes = NULL;
 
-	if (depthStencilAttachmentInfo != NULL)
-	{
-		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
-		renderTarget = VULKAN_INTERNAL_FetchRenderTarget(
-			renderer,
-			texture,
-			depthStencilAttachmentInfo->depth,
-			depthStencilAttachmentInfo->layer,
-			depthStencilAttachmentInfo->level
+		commandBuffer->releaseTextureCapacity = 0;
+		commandBuffer->releaseTextureCount = 0;
+		commandBuffer->releaseTextures = NULL;
+
+		commandBuffer->graphicsReleaseBufferBarrierCapacity = 0;
+		commandBuffer->graphicsReleaseBufferBarrierCount = 0;
+		commandBuffer->graphicsReleaseBufferBarriers = NULL;
+
+		commandBuffer->graphicsReleaseImageBarrierCapacity = 0;
+		commandBuffer->graphicsReleaseImageBarrierCount = 0;
+		commandBuffer->graphicsReleaseImageBarriers = NULL;
+
+		/* Transfer buffer tracking */
+
+		commandBuffer->transferBufferCapacity = 4;
+		commandBuffer->transferBufferCount = 0;
+		commandBuffer->transferBuffers = SDL_malloc(
+			commandBuffer->transferBufferCapacity * sizeof(VulkanTransferBuffer*)
 		);
 
-		imageViewAttachments[attachmentCount] = renderTarget->view;
+		commandBuffer->uploadRingTransferBuffer.buffer = NULL;
+		commandBuffer->uploadRingTransferBuffer.offset = 0;
+		commandBuffer->uploadRingTransferBuffer.fromPool = 0;
+		commandBuffer->usedUploadRing = 0;
 
-		attachmentCount += 1;
-	}
+		commandBuffer->uploadRegionCapacity = 0;
+		commandBuffer->uploadRegionCount = 0;
+		commandBuffer->uploadRegions = NULL;
 
-	framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-	framebufferInfo.pNext = NULL;
-	framebufferInfo.flags = 0;
-	framebufferInfo.renderPass = renderPass;
-	framebufferInfo.attachmentCount = attachmentCount;
-	framebufferInfo.pAttachments = imageViewAttachments;
-	framebufferInfo.width = hash.width;
-	framebufferInfo.height = hash.height;
-	framebufferInfo.layers = 1;
+		commandBuffer->pendingBufferUploadCapacity = 16;
+		commandBuffer->pendingBufferUploadCount = 0;
+		commandBuffer->pendingBufferUploads = SDL_malloc(
+			commandBuffer->pendingBufferUploadCapacity * sizeof(VulkanBufferUpload)
+		);
 
-	result = renderer->vkCreateFramebuffer(
-		renderer->logicalDevice,
-		&framebufferInfo,
-		NULL,
-		&vulkanFramebuffer->framebuffer
-	);
+		commandBuffer->readbackCapacity = 0;
+		commandBuffer->readbackCount = 0;
+		commandBuffer->readbacks = NULL;
 
-	if (result == VK_SUCCESS)
-	{
-		SDL_LockMutex(renderer->framebufferFetchLock);
+		/* Bound buffer tracking */
 
-		FramebufferHashArray_Insert(
-			&renderer->framebufferHashArray,
-			hash,
-			vulkanFramebuffer
+		commandBuffer->boundUniformBufferCapacity = 16;
+		commandBuffer->boundUniformBufferCount = 0;
+		commandBuffer->boundUniformBuffers = SDL_malloc(
+			commandBuffer->boundUniformBufferCapacity * sizeof(VulkanUniformBuffer*)
 		);
 
-		SDL_UnlockMutex(renderer->framebufferFetchLock);
-	}
-	else
-	{
-		LogVulkanResultAsError("vkCreateFramebuffer", result);
-		SDL_free(vulkanFramebuffer);
-		vulkanFramebuffer = NULL;
-	}
+		/* Descriptor set tracking */
 
-	return vulkanFramebuffer;
-}
+		commandBuffer->boundDescriptorSetDataCapacity = 16;
+		commandBuffer->boundDescriptorSetDataCount = 0;
+		commandBuffer->boundDescriptorSetDatas = SDL_malloc(
+			commandBuffer->boundDescriptorSetDataCapacity * sizeof(DescriptorSetData)
+		);
 
-static void VULKAN_INTERNAL_SetCurrentViewport(
-	VulkanCommandBuffer *commandBuffer,
-	Refresh_Viewport *viewport
-) {
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+		/* Bound compute resource tracking */
 
-	vulkanCommandBuffer->currentViewport.x = viewport->x;
-	vulkanCommandBuffer->currentViewport.y = viewport->y;
-	vulkanCommandBuffer->currentViewport.width = viewport->w;
-	vulkanCommandBuffer->currentViewport.height = viewport->h;
-	vulkanCommandBuffer->currentViewport.minDepth = viewport->minDepth;
-	vulkanCommandBuffer->currentViewport.maxDepth = viewport->maxDepth;
-}
+		commandBuffer->boundComputeBufferCapacity = 16;
+		commandBuffer->boundComputeBufferCount = 0;
+		commandBuffer->boundComputeBuffers = SDL_malloc(
+			commandBuffer->boundComputeBufferCapacity * sizeof(VulkanBuffer*)
+		);
 
-static void VULKAN_SetViewport(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Viewport *viewport
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+		commandBuffer->boundComputeTextureCapacity = 16;
+		commandBuffer->boundComputeTextureCount = 0;
+		commandBuffer->boundComputeTextures = SDL_malloc(
+			commandBuffer->boundComputeTextureCapacity * sizeof(VulkanTexture*)
+		);
 
-	VULKAN_INTERNAL_SetCurrentViewport(
-		vulkanCommandBuffer,
-		viewport
-	);
+		/* Resource tracking */
 
-	renderer->vkCmdSetViewport(
-		vulkanCommandBuffer->commandBuffer,
-		0,
-		1,
-		&vulkanCommandBuffer->currentViewport
-	);
-}
+		commandBuffer->usedBufferCapacity = 4;
+		commandBuffer->usedBufferCount = 0;
+		commandBuffer->usedBuffers = SDL_malloc(
+			commandBuffer->usedBufferCapacity * sizeof(VulkanBuffer*)
+		);
+
+		commandBuffer->usedTextureCapacity = 4;
+		commandBuffer->usedTextureCount = 0;
+		commandBuffer->usedTextures = SDL_malloc(
+			commandBuffer->usedTextureCapacity * sizeof(VulkanTexture*)
+		);
+
+		commandBuffer->usedSamplerCapacity = 4;
+		commandBuffer->usedSamplerCount = 0;
+		commandBuffer->usedSamplers = SDL_malloc(
+			commandBuffer->usedSamplerCapacity * sizeof(VulkanSampler*)
+		);
+
+		commandBuffer->usedGraphicsPipelineCapacity = 4;
+		commandBuffer->usedGraphicsPipelineCount = 0;
+		commandBuffer->usedGraphicsPipelines = SDL_malloc(
+			commandBuffer->usedGraphicsPipelineCapacity * sizeof(VulkanGraphicsPipeline*)
+		);
 
-static void VULKAN_INTERNAL_SetCurrentScissor(
-	VulkanCommandBuffer *vulkanCommandBuffer,
-	Refresh_Rect *scissor
-) {
-	vulkanCommandBuffer->currentScissor.offset.x = scissor->x;
-	vulkanCommandBuffer->currentScissor.offset.y = scissor->y;
-	vulkanCommandBuffer->currentScissor.extent.width = scissor->w;
-	vulkanCommandBuffer->currentScissor.extent.height = scissor->h;
-}
+		commandBuffer->usedComputePipelineCapacity = 4;
+		commandBuffer->usedComputePipelineCount = 0;
+		commandBuffer->usedComputePipelines = SDL_malloc(
+			commandBuffer->usedComputePipelineCapacity * sizeof(VulkanComputePipeline*)
+		);
 
-static void VULKAN_SetScissor(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Rect *scissor
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+		commandBuffer->usedFramebufferCapacity = 4;
+		commandBuffer->usedFramebufferCount = 0;
+		commandBuffer->usedFramebuffers = SDL_malloc(
+			commandBuffer->usedFramebufferCapacity * sizeof(VulkanFramebuffer*)
+		);
 
-	VULKAN_INTERNAL_SetCurrentScissor(
-		vulkanCommandBuffer,
-		scissor
-	);
+		vulkanCommandPool->inactiveCommandBuffers[
+			vulkanCommandPool->inactiveCommandBufferCount
+		] = commandBuffer;
+		vulkanCommandPool->inactiveCommandBufferCount += 1;
+	}
 
-	renderer->vkCmdSetScissor(
-		vulkanCommandBuffer->commandBuffer,
-		0,
-		1,
-		&vulkanCommandBuffer->currentScissor
-	);
+	SDL_stack_free(commandBuffers);
 }
 
-static void VULKAN_BeginRenderPass(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_ColorAttachmentInfo *colorAttachmentInfos,
-	uint32_t colorAttachmentCount,
-	Refresh_DepthStencilAttachmentInfo *depthStencilAttachmentInfo
+static VulkanCommandPool* VULKAN_INTERNAL_FetchCommandPool(
+	VulkanRenderer *renderer,
+	SDL_threadID threadID,
+	uint8_t isTransfer
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VkRenderPass renderPass;
-	VulkanFramebuffer *framebuffer;
+	VulkanCommandPool *vulkanCommandPool;
+	VkCommandPoolCreateInfo commandPoolCreateInfo;
+	VkResult vulkanResult;
+	CommandPoolHash commandPoolHash;
 
-	VulkanTexture *texture;
-	uint32_t w, h;
-	VkClearValue *clearValues;
-	uint32_t clearCount = colorAttachmentCount;
-	uint32_t multisampleAttachmentCount = 0;
-	uint32_t totalColorAttachmentCount = 0;
-	uint32_t i;
-	VkImageAspectFlags depthAspectFlags;
-	Refresh_Viewport defaultViewport;
-	Refresh_Rect defaultScissor;
-	uint32_t framebufferWidth = UINT32_MAX;
-	uint32_t framebufferHeight = UINT32_MAX;
+	commandPoolHash.threadID = threadID;
+	commandPoolHash.isTransfer = isTransfer;
 
-	/* The framebuffer cannot be larger than the smallest attachment. */
+	vulkanCommandPool = CommandPoolHashTable_Fetch(
+		&renderer->commandPoolHashTable,
+		commandPoolHash
+	);
 
-	for (i = 0; i < colorAttachmentCount; i += 1)
+	if (vulkanCommandPool != NULL)
 	{
-		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
-		w = texture->dimensions.width >> colorAttachmentInfos[i].level;
-		h = texture->dimensions.height >> colorAttachmentInfos[i].level;
-
-		if (w < framebufferWidth)
-		{
-			framebufferWidth = w;
-		}
-
-		if (h < framebufferHeight)
-		{
-			framebufferHeight = h;
-		}
+		return vulkanCommandPool;
 	}
 
-	if (depthStencilAttachmentInfo != NULL)
-	{
-		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
-		w = texture->dimensions.width >> depthStencilAttachmentInfo->level;
-		h = texture->dimensions.height >> depthStencilAttachmentInfo->level;
+	vulkanCommandPool = (VulkanCommandPool*) SDL_malloc(sizeof(VulkanCommandPool));
 
-		if (w < framebufferWidth)
-		{
-			framebufferWidth = w;
-		}
+	commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	commandPoolCreateInfo.pNext = NULL;
+	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	commandPoolCreateInfo.queueFamilyIndex = isTransfer ?
+		renderer->transferQueueFamilyIndex :
+		renderer->queueFamilyIndex;
 
-		if (h < framebufferHeight)
-		{
-			framebufferHeight = h;
-		}
+	vulkanResult = renderer->vkCreateCommandPool(
+		renderer->logicalDevice,
+		&commandPoolCreateInfo,
+		NULL,
+		&vulkanCommandPool->commandPool
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		Refresh_LogError("Failed to create command pool!");
+		LogVulkanResultAsError("vkCreateCommandPool", vulkanResult);
+		return NULL;
 	}
 
-	/* Fetch required render objects */
+	vulkanCommandPool->threadID = threadID;
+	vulkanCommandPool->isTransfer = isTransfer;
 
-	renderPass = VULKAN_INTERNAL_FetchRenderPass(
+	vulkanCommandPool->inactiveCommandBufferCapacity = 0;
+	vulkanCommandPool->inactiveCommandBufferCount = 0;
+	vulkanCommandPool->inactiveCommandBuffers = NULL;
+
+	VULKAN_INTERNAL_AllocateCommandBuffers(
 		renderer,
-		vulkanCommandBuffer,
-		colorAttachmentInfos,
-		colorAttachmentCount,
-		depthStencilAttachmentInfo
+		vulkanCommandPool,
+		2
 	);
 
-	framebuffer = VULKAN_INTERNAL_FetchFramebuffer(
-		renderer,
-		renderPass,
-		colorAttachmentInfos,
-		colorAttachmentCount,
-		depthStencilAttachmentInfo,
-		framebufferWidth,
-		framebufferHeight
+	CommandPoolHashTable_Insert(
+		&renderer->commandPoolHashTable,
+		commandPoolHash,
+		vulkanCommandPool
 	);
 
-	VULKAN_INTERNAL_TrackFramebuffer(renderer, vulkanCommandBuffer, framebuffer);
+	return vulkanCommandPool;
+}
 
-	/* Layout transitions */
+static VulkanCommandBuffer* VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
+	VulkanRenderer *renderer,
+	SDL_threadID threadID,
+	uint8_t isTransfer
+) {
+	VulkanCommandPool *commandPool =
+		VULKAN_INTERNAL_FetchCommandPool(renderer, threadID, isTransfer);
+	VulkanCommandBuffer *commandBuffer;
 
-	for (i = 0; i < colorAttachmentCount; i += 1)
+	if (commandPool->inactiveCommandBufferCount == 0)
 	{
-		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
-
-		VULKAN_INTERNAL_ImageMemoryBarrier(
+		VULKAN_INTERNAL_AllocateCommandBuffers(
 			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_COLOR_ATTACHMENT_READ_WRITE,
-			VK_IMAGE_ASPECT_COLOR_BIT,
-			0,
-			texture->layerCount,
-			0,
-			texture->levelCount,
-			0,
-			texture->image,
-			&texture->resourceAccessType
+			commandPool,
+			commandPool->inactiveCommandBufferCapacity
 		);
-
-		if (texture->msaaTex != NULL)
-		{
-			clearCount += 1;
-			multisampleAttachmentCount += 1;
-		}
-
-		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, texture);
 	}
 
-	if (depthStencilAttachmentInfo != NULL)
-	{
-		texture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
-		depthAspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
-
-		if (IsStencilFormat(texture->format))
-		{
-			depthAspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
-		}
-
-		VULKAN_INTERNAL_ImageMemoryBarrier(
-			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_WRITE,
-			depthAspectFlags,
-			0,
-			texture->layerCount,
-			0,
-			texture->levelCount,
-			0,
-			texture->image,
-			&texture->resourceAccessType
-		);
-
-		clearCount += 1;
+	commandBuffer = commandPool->inactiveCommandBuffers[commandPool->inactiveCommandBufferCount - 1];
+	commandPool->inactiveCommandBufferCount -= 1;
 
-		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, texture);
-	}
+	return commandBuffer;
+}
 
-	/* Set clear values */
+static VulkanCommandBuffer* VULKAN_INTERNAL_AcquireCommandBuffer(
+	VulkanRenderer *renderer,
+	uint8_t isTransfer
+) {
+	VkResult result;
 
-	clearValues = SDL_stack_alloc(VkClearValue, clearCount);
+	SDL_threadID threadID = SDL_ThreadID();
 
-	totalColorAttachmentCount = colorAttachmentCount + multisampleAttachmentCount;
+	SDL_LockMutex(renderer->acquireCommandBufferLock);
 
-	for (i = 0; i < totalColorAttachmentCount; i += 1)
-	{
-		clearValues[i].color.float32[0] = colorAttachmentInfos[i].clearColor.x;
-		clearValues[i].color.float32[1] = colorAttachmentInfos[i].clearColor.y;
-		clearValues[i].color.float32[2] = colorAttachmentInfos[i].clearColor.z;
-		clearValues[i].color.float32[3] = colorAttachmentInfos[i].clearColor.w;
+	VulkanCommandBuffer *commandBuffer =
+		VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID, isTransfer);
 
-		texture = ((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
-		if (texture->msaaTex != NULL)
-		{
-			clearValues[i+1].color.float32[0] = colorAttachmentInfos[i].clearColor.x;
-			clearValues[i+1].color.float32[1] = colorAttachmentInfos[i].clearColor.y;
-			clearValues[i+1].color.float32[2] = colorAttachmentInfos[i].clearColor.z;
-			clearValues[i+1].color.float32[3] = colorAttachmentInfos[i].clearColor.w;
-			i += 1;
-		}
-	}
+	SDL_UnlockMutex(renderer->acquireCommandBufferLock);
 
-	if (depthStencilAttachmentInfo != NULL)
-	{
-		clearValues[totalColorAttachmentCount].depthStencil.depth =
-			depthStencilAttachmentInfo->depthStencilClearValue.depth;
-		clearValues[totalColorAttachmentCount].depthStencil.stencil =
-			depthStencilAttachmentInfo->depthStencilClearValue.stencil;
-	}
+	/* Reset state */
 
-	VkRenderPassBeginInfo renderPassBeginInfo;
-	renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-	renderPassBeginInfo.pNext = NULL;
-	renderPassBeginInfo.renderPass = renderPass;
-	renderPassBeginInfo.framebuffer = framebuffer->framebuffer;
-	renderPassBeginInfo.pClearValues = clearValues;
-	renderPassBeginInfo.clearValueCount = clearCount;
-	renderPassBeginInfo.renderArea.extent.width = framebufferWidth;
-	renderPassBeginInfo.renderArea.extent.height = framebufferHeight;
-	renderPassBeginInfo.renderArea.offset.x = 0;
-	renderPassBeginInfo.renderArea.offset.y = 0;
+	commandBuffer->currentComputePipeline = NULL;
+	commandBuffer->currentGraphicsPipeline = NULL;
 
-	renderer->vkCmdBeginRenderPass(
-		vulkanCommandBuffer->commandBuffer,
-		&renderPassBeginInfo,
-		VK_SUBPASS_CONTENTS_INLINE
-	);
+	commandBuffer->vertexUniformBuffer = NULL;
+	commandBuffer->fragmentUniformBuffer = NULL;
+	commandBuffer->computeUniformBuffer = NULL;
 
-	SDL_stack_free(clearValues);
+	commandBuffer->graphicsDescriptorSetsBound = 0;
 
-	for (i = 0; i < colorAttachmentCount; i += 1)
+	commandBuffer->renderPassColorTargetCount = 0;
+
+	/* Reset the command buffer here to avoid resets being called
+	 * from a separate thread than where the command buffer was acquired
+	 */
+	result = renderer->vkResetCommandBuffer(
+		commandBuffer->commandBuffer,
+		VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT
+	);
+
+	if (result != VK_SUCCESS)
 	{
-		vulkanCommandBuffer->renderPassColorTargetTextures[i] =
-			((VulkanTextureContainer*) colorAttachmentInfos[i].texture)->vulkanTexture;
+		LogVulkanResultAsError("vkResetCommandBuffer", result);
 	}
-	vulkanCommandBuffer->renderPassColorTargetCount = colorAttachmentCount;
 
-	if (depthStencilAttachmentInfo != NULL)
+	VULKAN_INTERNAL_BeginCommandBuffer(renderer, commandBuffer);
+
+	if (!isTransfer)
 	{
-		vulkanCommandBuffer->renderPassDepthTexture = ((VulkanTextureContainer*) depthStencilAttachmentInfo->texture)->vulkanTexture;
+		VULKAN_INTERNAL_AcquireFromTransferQueue(renderer, commandBuffer);
 	}
 
-	/* Set sensible default viewport state */
-
-	defaultViewport.x = 0;
-	defaultViewport.y = 0;
-	defaultViewport.w = framebufferWidth;
-	defaultViewport.h = framebufferHeight;
-	defaultViewport.minDepth = 0;
-	defaultViewport.maxDepth = 1;
+	return commandBuffer;
+}
 
-	VULKAN_INTERNAL_SetCurrentViewport(
-		vulkanCommandBuffer,
-		&defaultViewport
+static Refresh_CommandBuffer* VULKAN_AcquireCommandBuffer(
+	Refresh_Renderer *driverData
+) {
+	return (Refresh_CommandBuffer*) VULKAN_INTERNAL_AcquireCommandBuffer(
+		(VulkanRenderer*) driverData,
+		0
 	);
+}
 
-	defaultScissor.x = 0;
-	defaultScissor.y = 0;
-	defaultScissor.w = framebufferWidth;
-	defaultScissor.h = framebufferHeight;
-
-	VULKAN_INTERNAL_SetCurrentScissor(
-		vulkanCommandBuffer,
-		&defaultScissor
+static Refresh_CommandBuffer* VULKAN_AcquireTransferCommandBuffer(
+	Refresh_Renderer *driverData
+) {
+	return (Refresh_CommandBuffer*) VULKAN_INTERNAL_AcquireCommandBuffer(
+		(VulkanRenderer*) driverData,
+		1
 	);
 }
 
-static void VULKAN_EndRenderPass(
+static WindowData* VULKAN_INTERNAL_FetchWindowData(
+	void *windowHandle
+) {
+	return (WindowData*) SDL_GetWindowData(windowHandle, WINDOW_DATA);
+}
+
+static uint8_t VULKAN_ClaimWindow(
 	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer
+	void *windowHandle,
+	Refresh_PresentMode presentMode
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanTexture *currentTexture;
-	uint32_t i;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(windowHandle);
 
-	renderer->vkCmdEndRenderPass(
-		vulkanCommandBuffer->commandBuffer
-	);
+	if (windowData == NULL)
+	{
+		windowData = SDL_malloc(sizeof(WindowData));
+		windowData->windowHandle = windowHandle;
+		windowData->preferredPresentMode = presentMode;
 
-	if (	vulkanCommandBuffer->vertexUniformBuffer != renderer->dummyVertexUniformBuffer &&
-		vulkanCommandBuffer->vertexUniformBuffer != NULL
-	) {
-		VULKAN_INTERNAL_BindUniformBuffer(
-			renderer,
-			vulkanCommandBuffer,
-			vulkanCommandBuffer->vertexUniformBuffer
-		);
-	}
-	vulkanCommandBuffer->vertexUniformBuffer = NULL;
+		if (VULKAN_INTERNAL_CreateSwapchain(renderer, windowData))
+		{
+			SDL_SetWindowData((SDL_Window*) windowHandle, WINDOW_DATA, windowData);
 
-	if (	vulkanCommandBuffer->fragmentUniformBuffer != renderer->dummyFragmentUniformBuffer &&
-		vulkanCommandBuffer->fragmentUniformBuffer != NULL
-	) {
-		VULKAN_INTERNAL_BindUniformBuffer(
-			renderer,
-			vulkanCommandBuffer,
-			vulkanCommandBuffer->fragmentUniformBuffer
-		);
-	}
-	vulkanCommandBuffer->fragmentUniformBuffer = NULL;
+			if (renderer->claimedWindowCount >= renderer->claimedWindowCapacity)
+			{
+				renderer->claimedWindowCapacity *= 2;
+				renderer->claimedWindows = SDL_realloc(
+					renderer->claimedWindows,
+					renderer->claimedWindowCapacity * sizeof(WindowData*)
+				);
+			}
 
-	/* If the render targets can be sampled, transition them to sample layout */
-	for (i = 0; i < vulkanCommandBuffer->renderPassColorTargetCount; i += 1)
-	{
-		currentTexture = vulkanCommandBuffer->renderPassColorTargetTextures[i];
+			renderer->claimedWindows[renderer->claimedWindowCount] = windowData;
+			renderer->claimedWindowCount += 1;
 
-		if (currentTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
-		{
-			VULKAN_INTERNAL_ImageMemoryBarrier(
-				renderer,
-				vulkanCommandBuffer->commandBuffer,
-				RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
-				currentTexture->aspectFlags,
-				0,
-				currentTexture->layerCount,
-				0,
-				currentTexture->levelCount,
-				0,
-				currentTexture->image,
-				&currentTexture->resourceAccessType
-			);
+			return 1;
 		}
-		else if (currentTexture->usageFlags & VK_IMAGE_USAGE_STORAGE_BIT)
+		else
 		{
-			VULKAN_INTERNAL_ImageMemoryBarrier(
-				renderer,
-				vulkanCommandBuffer->commandBuffer,
-				RESOURCE_ACCESS_COMPUTE_SHADER_STORAGE_IMAGE_READ_WRITE,
-				currentTexture->aspectFlags,
-				0,
-				currentTexture->layerCount,
-				0,
-				currentTexture->levelCount,
-				0,
-				currentTexture->image,
-				&currentTexture->resourceAccessType
-			);
+			Refresh_LogError("Could not create swapchain, failed to claim window!");
+			SDL_free(windowData);
+			return 0;
 		}
 	}
-	vulkanCommandBuffer->renderPassColorTargetCount = 0;
+	else
+	{
+		Refresh_LogWarn("Window already claimed!");
+		return 0;
+	}
+}
 
-	if (vulkanCommandBuffer->renderPassDepthTexture != NULL)
+static void VULKAN_UnclaimWindow(
+	Refresh_Renderer *driverData,
+	void *windowHandle
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(windowHandle);
+	uint32_t i;
+
+	if (windowData == NULL)
 	{
-		currentTexture = vulkanCommandBuffer->renderPassDepthTexture;
+		return;
+	}
 
-		if (currentTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+	if (windowData->swapchainData != NULL)
+	{
+		VULKAN_Wait(driverData);
+		VULKAN_INTERNAL_DestroySwapchain(
+			(VulkanRenderer*) driverData,
+			windowData
+		);
+	}
+
+	for (i = 0; i < renderer->claimedWindowCount; i += 1)
+	{
+		if (renderer->claimedWindows[i]->windowHandle == windowHandle)
 		{
-			VULKAN_INTERNAL_ImageMemoryBarrier(
-				renderer,
-				vulkanCommandBuffer->commandBuffer,
-				RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
-				currentTexture->aspectFlags,
-				0,
-				currentTexture->layerCount,
-				0,
-				currentTexture->levelCount,
-				0,
-				currentTexture->image,
-				&currentTexture->resourceAccessType
-			);
+			renderer->claimedWindows[i] = renderer->claimedWindows[renderer->claimedWindowCount - 1];
+			renderer->claimedWindowCount -= 1;
+			break;
 		}
 	}
-	vulkanCommandBuffer->renderPassDepthTexture = NULL;
 
-	vulkanCommandBuffer->currentGraphicsPipeline = NULL;
+	SDL_free(windowData);
+	SDL_SetWindowData((SDL_Window*) windowHandle, WINDOW_DATA, NULL);
 }
 
-static void VULKAN_BindGraphicsPipeline(
+static Refresh_Texture* VULKAN_AcquireSwapchainTexture(
 	Refresh_Renderer *driverData,
 	Refresh_CommandBuffer *commandBuffer,
-	Refresh_GraphicsPipeline *graphicsPipeline
+	void *windowHandle,
+	uint32_t *pWidth,
+	uint32_t *pHeight
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
 	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanGraphicsPipeline* pipeline = (VulkanGraphicsPipeline*) graphicsPipeline;
-
-	if (	vulkanCommandBuffer->vertexUniformBuffer != renderer->dummyVertexUniformBuffer &&
-		vulkanCommandBuffer->vertexUniformBuffer != NULL
-	) {
-		VULKAN_INTERNAL_BindUniformBuffer(
-			renderer,
-			vulkanCommandBuffer,
-			vulkanCommandBuffer->vertexUniformBuffer
-		);
-	}
+	uint32_t swapchainImageIndex;
+	WindowData *windowData;
+	VulkanSwapchainData *swapchainData;
+	VkResult acquireResult = VK_SUCCESS;
+	VulkanTextureContainer *swapchainTextureContainer = NULL;
+	VulkanPresentData *presentData;
 
-	if (pipeline->vertexUniformBlockSize == 0)
-	{
-		vulkanCommandBuffer->vertexUniformBuffer = renderer->dummyVertexUniformBuffer;
-	}
-	else
+	windowData = VULKAN_INTERNAL_FetchWindowData(windowHandle);
+	if (windowData == NULL)
 	{
-		vulkanCommandBuffer->vertexUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
-			renderer,
-			renderer->vertexUniformBufferPool,
-			pipeline->vertexUniformBlockSize
-		);
+		return NULL;
 	}
 
-	if (	vulkanCommandBuffer->fragmentUniformBuffer != renderer->dummyFragmentUniformBuffer &&
-		vulkanCommandBuffer->fragmentUniformBuffer != NULL
-	) {
-		VULKAN_INTERNAL_BindUniformBuffer(
-			renderer,
-			vulkanCommandBuffer,
-			vulkanCommandBuffer->fragmentUniformBuffer
-		);
-	}
+	swapchainData = windowData->swapchainData;
 
-	if (pipeline->fragmentUniformBlockSize == 0)
-	{
-		vulkanCommandBuffer->fragmentUniformBuffer = renderer->dummyFragmentUniformBuffer;
-	}
-	else
+	/* Window is claimed but swapchain is invalid! */
+	if (swapchainData == NULL)
 	{
-		vulkanCommandBuffer->fragmentUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
-			renderer,
-			renderer->fragmentUniformBufferPool,
-			pipeline->fragmentUniformBlockSize
-		);
-	}
+		if (SDL_GetWindowFlags(windowHandle) & SDL_WINDOW_MINIMIZED)
+		{
+			/* Window is minimized, don't bother */
+			return NULL;
+		}
 
-	/* bind dummy sets if necessary */
-	if (pipeline->pipelineLayout->vertexSamplerDescriptorSetCache == NULL)
-	{
-		vulkanCommandBuffer->vertexSamplerDescriptorSet = renderer->emptyVertexSamplerDescriptorSet;
+		/* Let's try to recreate */
+		VULKAN_INTERNAL_RecreateSwapchain(renderer, windowData);
+		swapchainData = windowData->swapchainData;
+
+		if (swapchainData == NULL)
+		{
+			Refresh_LogWarn("Failed to recreate swapchain!");
+			return NULL;
+		}
 	}
 
-	if (pipeline->pipelineLayout->fragmentSamplerDescriptorSetCache == NULL)
+	acquireResult = renderer->vkAcquireNextImageKHR(
+		renderer->logicalDevice,
+		swapchainData->swapchain,
+		UINT64_MAX,
+		swapchainData->imageAvailableSemaphore,
+		VK_NULL_HANDLE,
+		&swapchainImageIndex
+	);
+
+	/* Acquisition is invalid, let's try to recreate */
+	if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR)
 	{
-		vulkanCommandBuffer->fragmentSamplerDescriptorSet = renderer->emptyFragmentSamplerDescriptorSet;
-	}
+		VULKAN_INTERNAL_RecreateSwapchain(renderer, windowData);
+		swapchainData = windowData->swapchainData;
 
-	renderer->vkCmdBindPipeline(
-		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,
-		pipeline->pipeline
-	);
+		if (swapchainData == NULL)
+		{
+			Refresh_LogWarn("Failed to recreate swapchain!");
+			return NULL;
+		}
 
-	vulkanCommandBuffer->currentGraphicsPipeline = pipeline;
+		acquireResult = renderer->vkAcquireNextImageKHR(
+			renderer->logicalDevice,
+			swapchainData->swapchain,
+			UINT64_MAX,
+			swapchainData->imageAvailableSemaphore,
+			VK_NULL_HANDLE,
+			&swapchainImageIndex
+		);
 
-	VULKAN_INTERNAL_TrackGraphicsPipeline(renderer, vulkanCommandBuffer, pipeline);
+		if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR)
+		{
+			Refresh_LogWarn("Failed to acquire swapchain texture!");
+			return NULL;
+		}
+	}
 
-	renderer->vkCmdSetViewport(
+	swapchainTextureContainer = &swapchainData->textureContainers[swapchainImageIndex];
+
+	VULKAN_INTERNAL_ImageMemoryBarrier(
+		renderer,
 		vulkanCommandBuffer->commandBuffer,
+		RESOURCE_ACCESS_COLOR_ATTACHMENT_WRITE,
+		VK_IMAGE_ASPECT_COLOR_BIT,
 		0,
 		1,
-		&vulkanCommandBuffer->currentViewport
-	);
-
-	renderer->vkCmdSetScissor(
-		vulkanCommandBuffer->commandBuffer,
 		0,
 		1,
-		&vulkanCommandBuffer->currentScissor
+		0,
+		swapchainTextureContainer->vulkanTexture
 	);
-}
 
-static void VULKAN_BindVertexBuffers(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	uint32_t firstBinding,
-	uint32_t bindingCount,
-	Refresh_Buffer **pBuffers,
-	uint64_t *pOffsets
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanBuffer *currentVulkanBuffer;
-	VkBuffer *buffers = SDL_stack_alloc(VkBuffer, bindingCount);
-	uint32_t i;
+	/* Set up present struct */
 
-	for (i = 0; i < bindingCount; i += 1)
+	if (vulkanCommandBuffer->presentDataCount == vulkanCommandBuffer->presentDataCapacity)
 	{
-		currentVulkanBuffer = ((VulkanBufferContainer*) pBuffers[i])->vulkanBuffer;
-		buffers[i] = currentVulkanBuffer->buffer;
-		VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, currentVulkanBuffer);
+		vulkanCommandBuffer->presentDataCapacity += 1;
+		vulkanCommandBuffer->presentDatas = SDL_realloc(
+			vulkanCommandBuffer->presentDatas,
+			vulkanCommandBuffer->presentDataCapacity * sizeof(VkPresentInfoKHR)
+		);
 	}
 
-	renderer->vkCmdBindVertexBuffers(
-		vulkanCommandBuffer->commandBuffer,
-		firstBinding,
-		bindingCount,
-		buffers,
-		pOffsets
-	);
-
-	SDL_stack_free(buffers);
-}
-
-static void VULKAN_BindIndexBuffer(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Buffer *buffer,
-	uint64_t offset,
-	Refresh_IndexElementSize indexElementSize
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanBuffer* vulkanBuffer = ((VulkanBufferContainer*) buffer)->vulkanBuffer;
-
-	VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, vulkanBuffer);
-
-	renderer->vkCmdBindIndexBuffer(
-		vulkanCommandBuffer->commandBuffer,
-		vulkanBuffer->buffer,
-		offset,
-		RefreshToVK_IndexType[indexElementSize]
-	);
-}
+	presentData = &vulkanCommandBuffer->presentDatas[vulkanCommandBuffer->presentDataCount];
+	vulkanCommandBuffer->presentDataCount += 1;
 
-static void VULKAN_BindComputePipeline(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_ComputePipeline *computePipeline
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanComputePipeline *vulkanComputePipeline = (VulkanComputePipeline*) computePipeline;
+	presentData->windowData = windowData;
+	presentData->swapchainImageIndex = swapchainImageIndex;
 
-	/* bind dummy sets */
-	if (vulkanComputePipeline->pipelineLayout->bufferDescriptorSetCache == NULL)
-	{
-		vulkanCommandBuffer->bufferDescriptorSet = renderer->emptyComputeBufferDescriptorSet;
-	}
+	/* Set up present semaphores */
 
-	if (vulkanComputePipeline->pipelineLayout->imageDescriptorSetCache == NULL)
+	if (vulkanCommandBuffer->waitSemaphoreCount == vulkanCommandBuffer->waitSemaphoreCapacity)
 	{
-		vulkanCommandBuffer->imageDescriptorSet = renderer->emptyComputeImageDescriptorSet;
-	}
-
-	if (	vulkanCommandBuffer->computeUniformBuffer != renderer->dummyComputeUniformBuffer &&
-		vulkanCommandBuffer->computeUniformBuffer != NULL
-	) {
-		VULKAN_INTERNAL_BindUniformBuffer(
-			renderer,
-			vulkanCommandBuffer,
-			vulkanCommandBuffer->computeUniformBuffer
+		vulkanCommandBuffer->waitSemaphoreCapacity += 1;
+		vulkanCommandBuffer->waitSemaphores = SDL_realloc(
+			vulkanCommandBuffer->waitSemaphores,
+			vulkanCommandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore)
+		);
+		vulkanCommandBuffer->waitSemaphoreStages = SDL_realloc(
+			vulkanCommandBuffer->waitSemaphoreStages,
+			vulkanCommandBuffer->waitSemaphoreCapacity * sizeof(VkPipelineStageFlags)
 		);
 	}
-	renderer->vkCmdBindPipeline(
-		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_COMPUTE,
-		vulkanComputePipeline->pipeline
-	);
 
-	vulkanCommandBuffer->currentComputePipeline = vulkanComputePipeline;
+	vulkanCommandBuffer->waitSemaphores[vulkanCommandBuffer->waitSemaphoreCount] = swapchainData->imageAvailableSemaphore;
+	vulkanCommandBuffer->waitSemaphoreStages[vulkanCommandBuffer->waitSemaphoreCount] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	vulkanCommandBuffer->waitSemaphoreCount += 1;
 
-	if (vulkanComputePipeline->uniformBlockSize == 0)
-	{
-		vulkanCommandBuffer->computeUniformBuffer = renderer->dummyComputeUniformBuffer;
-	}
-	else
+	if (vulkanCommandBuffer->signalSemaphoreCount == vulkanCommandBuffer->signalSemaphoreCapacity)
 	{
-		vulkanCommandBuffer->computeUniformBuffer = VULKAN_INTERNAL_AcquireUniformBufferFromPool(
-			renderer,
-			renderer->computeUniformBufferPool,
-			vulkanComputePipeline->uniformBlockSize
+		vulkanCommandBuffer->signalSemaphoreCapacity += 1;
+		vulkanCommandBuffer->signalSemaphores = SDL_realloc(
+			vulkanCommandBuffer->signalSemaphores,
+			vulkanCommandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore)
 		);
 	}
 
-	VULKAN_INTERNAL_TrackComputePipeline(renderer, vulkanCommandBuffer, vulkanComputePipeline);
+	vulkanCommandBuffer->signalSemaphores[vulkanCommandBuffer->signalSemaphoreCount] = swapchainData->renderFinishedSemaphore;
+	vulkanCommandBuffer->signalSemaphoreCount += 1;
+
+	*pWidth = swapchainData->extent.width;
+	*pHeight = swapchainData->extent.height;
+
+	return (Refresh_Texture*) swapchainTextureContainer;
 }
 
-static void VULKAN_BindComputeBuffers(
+static Refresh_TextureFormat VULKAN_GetSwapchainFormat(
 	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Buffer **pBuffers
+	void *windowHandle
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
-
-	VulkanBuffer *currentVulkanBuffer;
-	VkDescriptorBufferInfo descriptorBufferInfos[MAX_BUFFER_BINDINGS];
-	uint32_t i;
+	WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(windowHandle);
 
-	if (computePipeline->pipelineLayout->bufferDescriptorSetCache == NULL)
+	if (windowData == NULL)
 	{
-		return;
+		Refresh_LogWarn("Cannot get swapchain format, window has not been claimed!");
+		return 0;
 	}
 
-	for (i = 0; i < computePipeline->pipelineLayout->bufferDescriptorSetCache->bindingCount; i += 1)
+	if (windowData->swapchainData == NULL)
 	{
-		currentVulkanBuffer = ((VulkanBufferContainer*) pBuffers[i])->vulkanBuffer;
-
-		descriptorBufferInfos[i].buffer = currentVulkanBuffer->buffer;
-		descriptorBufferInfos[i].offset = 0;
-		descriptorBufferInfos[i].range = currentVulkanBuffer->size;
-
-		VULKAN_INTERNAL_BufferMemoryBarrier(
-			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_COMPUTE_SHADER_BUFFER_READ_WRITE,
-			currentVulkanBuffer
-		);
-
-		VULKAN_INTERNAL_TrackBuffer(renderer, vulkanCommandBuffer, currentVulkanBuffer);
+		Refresh_LogWarn("Cannot get swapchain format, swapchain is currently invalid!");
+		return 0;
 	}
 
-	vulkanCommandBuffer->bufferDescriptorSet =
-		VULKAN_INTERNAL_FetchDescriptorSet(
-			renderer,
-			vulkanCommandBuffer,
-			computePipeline->pipelineLayout->bufferDescriptorSetCache,
-			NULL,
-			descriptorBufferInfos
-		);
-
-	if (vulkanCommandBuffer->boundComputeBufferCount == vulkanCommandBuffer->boundComputeBufferCapacity)
+	if (windowData->swapchainData->swapchainFormat == VK_FORMAT_R8G8B8A8_UNORM)
 	{
-		vulkanCommandBuffer->boundComputeBufferCapacity *= 2;
-		vulkanCommandBuffer->boundComputeBuffers = SDL_realloc(
-			vulkanCommandBuffer->boundComputeBuffers,
-			vulkanCommandBuffer->boundComputeBufferCapacity * sizeof(VulkanBuffer*)
-		);
+		return REFRESH_TEXTUREFORMAT_R8G8B8A8;
+	}
+	else if (windowData->swapchainData->swapchainFormat == VK_FORMAT_B8G8R8A8_UNORM)
+	{
+		return REFRESH_TEXTUREFORMAT_B8G8R8A8;
+	}
+	else
+	{
+		Refresh_LogWarn("Unrecognized swapchain format!");
+		return 0;
 	}
-
-	vulkanCommandBuffer->boundComputeBuffers[vulkanCommandBuffer->boundComputeBufferCount] = currentVulkanBuffer;
-	vulkanCommandBuffer->boundComputeBufferCount += 1;
 }
 
-static void VULKAN_BindComputeTextures(
+static void VULKAN_SetSwapchainPresentMode(
 	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Texture **pTextures
+	void *windowHandle,
+	Refresh_PresentMode presentMode
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
+	WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(windowHandle);
 
-	VulkanTexture *currentTexture;
-	VkDescriptorImageInfo descriptorImageInfos[MAX_TEXTURE_SAMPLERS];
-	uint32_t i;
+	if (windowData == NULL)
+	{
+		Refresh_LogWarn("Cannot set present mode, window has not been claimed!");
+		return;
+	}
+
+	VULKAN_INTERNAL_RecreateSwapchain(
+		(VulkanRenderer *)driverData,
+		windowData
+	);
+}
 
-	if (computePipeline->pipelineLayout->imageDescriptorSetCache == NULL)
-	{
-		return;
-	}
+/* Submission structure */
 
-	for (i = 0; i < computePipeline->pipelineLayout->imageDescriptorSetCache->bindingCount; i += 1)
+static VkFence VULKAN_INTERNAL_AcquireFenceFromPool(
+	VulkanRenderer *renderer
+) {
+	VkFenceCreateInfo fenceCreateInfo;
+	VkFence fence;
+	VkResult vulkanResult;
+
+	if (renderer->fencePool.availableFenceCount == 0)
 	{
-		currentTexture = ((VulkanTextureContainer*) pTextures[i])->vulkanTexture;
-		descriptorImageInfos[i].imageView = currentTexture->view;
-		descriptorImageInfos[i].sampler = VK_NULL_HANDLE;
-		descriptorImageInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+		/* Create fence */
+		fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fenceCreateInfo.pNext = NULL;
+		fenceCreateInfo.flags = 0;
 
-		VULKAN_INTERNAL_ImageMemoryBarrier(
-			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_COMPUTE_SHADER_STORAGE_IMAGE_READ_WRITE,
-			VK_IMAGE_ASPECT_COLOR_BIT,
-			0,
-			currentTexture->layerCount,
-			0,
-			currentTexture->levelCount,
-			0,
-			currentTexture->image,
-			&currentTexture->resourceAccessType
+		vulkanResult = renderer->vkCreateFence(
+			renderer->logicalDevice,
+			&fenceCreateInfo,
+			NULL,
+			&fence
 		);
 
-		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, currentTexture);
-
-		if (vulkanCommandBuffer->boundComputeTextureCount == vulkanCommandBuffer->boundComputeTextureCapacity)
+		if (vulkanResult != VK_SUCCESS)
 		{
-			vulkanCommandBuffer->boundComputeTextureCapacity *= 2;
-			vulkanCommandBuffer->boundComputeTextures = SDL_realloc(
-				vulkanCommandBuffer->boundComputeTextures,
-				vulkanCommandBuffer->boundComputeTextureCapacity * sizeof(VulkanTexture *)
-			);
+			LogVulkanResultAsError("vkCreateFence", vulkanResult);
+			return NULL;
 		}
 
-		vulkanCommandBuffer->boundComputeTextures[i] = currentTexture;
-		vulkanCommandBuffer->boundComputeTextureCount += 1;
+		return fence;
 	}
 
-	vulkanCommandBuffer->imageDescriptorSet =
-		VULKAN_INTERNAL_FetchDescriptorSet(
-			renderer,
-			vulkanCommandBuffer,
-			computePipeline->pipelineLayout->imageDescriptorSetCache,
-			descriptorImageInfos,
-			NULL
-		);
-}
-
-static void VULKAN_INTERNAL_AllocateCommandBuffers(
-	VulkanRenderer *renderer,
-	VulkanCommandPool *vulkanCommandPool,
-	uint32_t allocateCount
-) {
-	VkCommandBufferAllocateInfo allocateInfo;
-	VkResult vulkanResult;
-	uint32_t i;
-	VkCommandBuffer *commandBuffers = SDL_stack_alloc(VkCommandBuffer, allocateCount);
-	VulkanCommandBuffer *commandBuffer;
-
-	vulkanCommandPool->inactiveCommandBufferCapacity += allocateCount;
-
-	vulkanCommandPool->inactiveCommandBuffers = SDL_realloc(
-		vulkanCommandPool->inactiveCommandBuffers,
-		sizeof(VulkanCommandBuffer*) *
-		vulkanCommandPool->inactiveCommandBufferCapacity
-	);
+	SDL_LockMutex(renderer->fencePool.lock);
 
-	allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-	allocateInfo.pNext = NULL;
-	allocateInfo.commandPool = vulkanCommandPool->commandPool;
-	allocateInfo.commandBufferCount = allocateCount;
-	allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	fence = renderer->fencePool.availableFences[renderer->fencePool.availableFenceCount - 1];
+	renderer->fencePool.availableFenceCount -= 1;
 
-	vulkanResult = renderer->vkAllocateCommandBuffers(
+	vulkanResult = renderer->vkResetFences(
 		renderer->logicalDevice,
-		&allocateInfo,
-		commandBuffers
+		1,
+		&fence
 	);
 
 	if (vulkanResult != VK_SUCCESS)
 	{
-		LogVulkanResultAsError("vkAllocateCommandBuffers", vulkanResult);
-		SDL_stack_free(commandBuffers);
-		return;
+		LogVulkanResultAsError("vkResetFences", vulkanResult);
 	}
 
-	for (i = 0; i < allocateCount; i += 1)
-	{
-		commandBuffer = SDL_malloc(sizeof(VulkanCommandBuffer));
-		commandBuffer->commandPool = vulkanCommandPool;
-		commandBuffer->commandBuffer = commandBuffers[i];
-
-		commandBuffer->inFlightFence = VK_NULL_HANDLE;
-		commandBuffer->renderPassDepthTexture = NULL;
-
-		/* Presentation tracking */
+	SDL_UnlockMutex(renderer->fencePool.lock);
 
-		commandBuffer->presentDataCapacity = 1;
-		commandBuffer->presentDataCount = 0;
-		commandBuffer->presentDatas = SDL_malloc(
-			commandBuffer->presentDataCapacity * sizeof(VkPresentInfoKHR)
-		);
+	return fence;
+}
 
-		commandBuffer->waitSemaphoreCapacity = 1;
-		commandBuffer->waitSemaphoreCount = 0;
-		commandBuffer->waitSemaphores = SDL_malloc(
-			commandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore)
-		);
+static void VULKAN_INTERNAL_ReturnFenceToPool(
+	VulkanRenderer *renderer,
+	VkFence fence
+) {
+	SDL_LockMutex(renderer->fencePool.lock);
 
-		commandBuffer->signalSemaphoreCapacity = 1;
-		commandBuffer->signalSemaphoreCount = 0;
-		commandBuffer->signalSemaphores = SDL_malloc(
-			commandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore)
-		);
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->fencePool.availableFences,
+		VkFence,
+		renderer->fencePool.availableFenceCount + 1,
+		renderer->fencePool.availableFenceCapacity,
+		renderer->fencePool.availableFenceCapacity * 2
+	);
 
-		/* Transfer buffer tracking */
+	renderer->fencePool.availableFences[renderer->fencePool.availableFenceCount] = fence;
+	renderer->fencePool.availableFenceCount += 1;
 
-		commandBuffer->transferBufferCapacity = 4;
-		commandBuffer->transferBufferCount = 0;
-		commandBuffer->transferBuffers = SDL_malloc(
-			commandBuffer->transferBufferCapacity * sizeof(VulkanTransferBuffer*)
-		);
+	SDL_UnlockMutex(renderer->fencePool.lock);
+}
 
-		/* Bound buffer tracking */
+static void VULKAN_INTERNAL_PerformPendingDestroys(
+	VulkanRenderer *renderer
+) {
+	int32_t i;
 
-		commandBuffer->boundUniformBufferCapacity = 16;
-		commandBuffer->boundUniformBufferCount = 0;
-		commandBuffer->boundUniformBuffers = SDL_malloc(
-			commandBuffer->boundUniformBufferCapacity * sizeof(VulkanUniformBuffer*)
-		);
+	SDL_LockMutex(renderer->disposeLock);
 
-		/* Descriptor set tracking */
+	for (i = renderer->texturesToDestroyCount - 1; i >= 0; i -= 1)
+	{
+		if (SDL_AtomicGet(&renderer->texturesToDestroy[i]->referenceCount) == 0)
+		{
+			VULKAN_INTERNAL_DestroyTexture(
+				renderer,
+				renderer->texturesToDestroy[i]
+			);
 
-		commandBuffer->boundDescriptorSetDataCapacity = 16;
-		commandBuffer->boundDescriptorSetDataCount = 0;
-		commandBuffer->boundDescriptorSetDatas = SDL_malloc(
-			commandBuffer->boundDescriptorSetDataCapacity * sizeof(DescriptorSetData)
-		);
+			renderer->texturesToDestroy[i] = renderer->texturesToDestroy[renderer->texturesToDestroyCount - 1];
+			renderer->texturesToDestroyCount -= 1;
+		}
+	}
 
-		/* Bound compute resource tracking */
+	for (i = renderer->buffersToDestroyCount - 1; i >= 0; i -= 1)
+	{
+		if (SDL_AtomicGet(&renderer->buffersToDestroy[i]->referenceCount) == 0)
+		{
+			VULKAN_INTERNAL_DestroyBuffer(
+				renderer,
+				renderer->buffersToDestroy[i]);
 
-		commandBuffer->boundComputeBufferCapacity = 16;
-		commandBuffer->boundComputeBufferCount = 0;
-		commandBuffer->boundComputeBuffers = SDL_malloc(
-			commandBuffer->boundComputeBufferCapacity * sizeof(VulkanBuffer*)
-		);
+			renderer->buffersToDestroy[i] = renderer->buffersToDestroy[renderer->buffersToDestroyCount - 1];
+			renderer->buffersToDestroyCount -= 1;
+		}
+	}
 
-		commandBuffer->boundComputeTextureCapacity = 16;
-		commandBuffer->boundComputeTextureCount = 0;
-		commandBuffer->boundComputeTextures = SDL_malloc(
-			commandBuffer->boundComputeTextureCapacity * sizeof(VulkanTexture*)
-		);
+	for (i = renderer->graphicsPipelinesToDestroyCount - 1; i >= 0; i -= 1)
+	{
+		if (SDL_AtomicGet(&renderer->graphicsPipelinesToDestroy[i]->referenceCount) == 0)
+		{
+			VULKAN_INTERNAL_DestroyGraphicsPipeline(
+				renderer,
+				renderer->graphicsPipelinesToDestroy[i]
+			);
 
-		/* Resource tracking */
+			renderer->graphicsPipelinesToDestroy[i] = renderer->graphicsPipelinesToDestroy[renderer->graphicsPipelinesToDestroyCount - 1];
+			renderer->graphicsPipelinesToDestroyCount -= 1;
+		}
+	}
 
-		commandBuffer->usedBufferCapacity = 4;
-		commandBuffer->usedBufferCount = 0;
-		commandBuffer->usedBuffers = SDL_malloc(
-			commandBuffer->usedBufferCapacity * sizeof(VulkanBuffer*)
-		);
+	for (i = renderer->computePipelinesToDestroyCount - 1; i >= 0; i -= 1)
+	{
+		if (SDL_AtomicGet(&renderer->computePipelinesToDestroy[i]->referenceCount) == 0)
+		{
+			VULKAN_INTERNAL_DestroyComputePipeline(
+				renderer,
+				renderer->computePipelinesToDestroy[i]
+			);
 
-		commandBuffer->usedTextureCapacity = 4;
-		commandBuffer->usedTextureCount = 0;
-		commandBuffer->usedTextures = SDL_malloc(
-			commandBuffer->usedTextureCapacity * sizeof(VulkanTexture*)
-		);
+			renderer->computePipelinesToDestroy[i] = renderer->computePipelinesToDestroy[renderer->computePipelinesToDestroyCount - 1];
+			renderer->computePipelinesToDestroyCount -= 1 ;
+		}
+	}
 
-		commandBuffer->usedSamplerCapacity = 4;
-		commandBuffer->usedSamplerCount = 0;
-		commandBuffer->usedSamplers = SDL_malloc(
-			commandBuffer->usedSamplerCapacity * sizeof(VulkanSampler*)
-		);
+	for (i = renderer->shaderModulesToDestroyCount - 1; i >= 0; i -= 1)
+	{
+		if (SDL_AtomicGet(&renderer->shaderModulesToDestroy[i]->referenceCount) == 0)
+		{
+			VULKAN_INTERNAL_DestroyShaderModule(
+				renderer,
+				renderer->shaderModulesToDestroy[i]
+			);
 
-		commandBuffer->usedGraphicsPipelineCapacity = 4;
-		commandBuffer->usedGraphicsPipelineCount = 0;
-		commandBuffer->usedGraphicsPipelines = SDL_malloc(
-			commandBuffer->usedGraphicsPipelineCapacity * sizeof(VulkanGraphicsPipeline*)
-		);
+			renderer->shaderModulesToDestroy[i] = renderer->shaderModulesToDestroy[renderer->shaderModulesToDestroyCount - 1];
+			renderer->shaderModulesToDestroyCount -= 1;
+		}
+	}
 
-		commandBuffer->usedComputePipelineCapacity = 4;
-		commandBuffer->usedComputePipelineCount = 0;
-		commandBuffer->usedComputePipelines = SDL_malloc(
-			commandBuffer->usedComputePipelineCapacity * sizeof(VulkanComputePipeline*)
-		);
+	for (i = renderer->samplersToDestroyCount - 1; i >= 0; i -= 1)
+	{
+		if (SDL_AtomicGet(&renderer->samplersToDestroy[i]->referenceCount) == 0)
+		{
+			VULKAN_INTERNAL_DestroySampler(
+				renderer,
+				renderer->samplersToDestroy[i]
+			);
 
-		commandBuffer->usedFramebufferCapacity = 4;
-		commandBuffer->usedFramebufferCount = 0;
-		commandBuffer->usedFramebuffers = SDL_malloc(
-			commandBuffer->usedFramebufferCapacity * sizeof(VulkanFramebuffer*)
-		);
+			renderer->samplersToDestroy[i] = renderer->samplersToDestroy[renderer->samplersToDestroyCount - 1];
+			renderer->samplersToDestroyCount -= 1;
+		}
+	}
 
-		vulkanCommandPool->inactiveCommandBuffers[
-			vulkanCommandPool->inactiveCommandBufferCount
-		] = commandBuffer;
-		vulkanCommandPool->inactiveCommandBufferCount += 1;
+	for (i = renderer->framebuffersToDestroyCount - 1; i >= 0; i -= 1)
+	{
+		if (SDL_AtomicGet(&renderer->framebuffersToDestroy[i]->referenceCount) == 0)
+		{
+			VULKAN_INTERNAL_DestroyFramebuffer(
+				renderer,
+				renderer->framebuffersToDestroy[i]
+			);
+
+			renderer->framebuffersToDestroy[i] = renderer->framebuffersToDestroy[renderer->framebuffersToDestroyCount - 1];
+			renderer->framebuffersToDestroyCount -= 1;
+		}
 	}
 
-	SDL_stack_free(commandBuffers);
+	SDL_UnlockMutex(renderer->disposeLock);
 }
 
-static VulkanCommandPool* VULKAN_INTERNAL_FetchCommandPool(
+static void VULKAN_INTERNAL_CleanCommandBuffer(
 	VulkanRenderer *renderer,
-	SDL_threadID threadID
+	VulkanCommandBuffer *commandBuffer
 ) {
-	VulkanCommandPool *vulkanCommandPool;
-	VkCommandPoolCreateInfo commandPoolCreateInfo;
-	VkResult vulkanResult;
-	CommandPoolHash commandPoolHash;
-
-	commandPoolHash.threadID = threadID;
+	uint32_t i;
+	VulkanUniformBuffer *uniformBuffer;
+	DescriptorSetData *descriptorSetData;
+	uint8_t hadReadbacks = commandBuffer->readbackCount > 0;
 
-	vulkanCommandPool = CommandPoolHashTable_Fetch(
-		&renderer->commandPoolHashTable,
-		commandPoolHash
-	);
+	/* Upload ring space must be reclaimed before the fence can be reused */
 
-	if (vulkanCommandPool != NULL)
+	if (commandBuffer->usedUploadRing)
 	{
-		return vulkanCommandPool;
-	}
+		SDL_LockMutex(renderer->uploadRing.lock);
+		VULKAN_INTERNAL_RetireUploadRingRanges(renderer, commandBuffer);
+		SDL_UnlockMutex(renderer->uploadRing.lock);
 
-	vulkanCommandPool = (VulkanCommandPool*) SDL_malloc(sizeof(VulkanCommandPool));
+		commandBuffer->uploadRingTransferBuffer.buffer = NULL;
+		commandBuffer->usedUploadRing = 0;
+	}
 
-	commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-	commandPoolCreateInfo.pNext = NULL;
-	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-	commandPoolCreateInfo.queueFamilyIndex = renderer->queueFamilyIndex;
+	commandBuffer->uploadRegionCount = 0;
 
-	vulkanResult = renderer->vkCreateCommandPool(
-		renderer->logicalDevice,
-		&commandPoolCreateInfo,
-		NULL,
-		&vulkanCommandPool->commandPool
-	);
+	/* Readbacks are complete, the client may have released some already */
 
-	if (vulkanResult != VK_SUCCESS)
+	if (commandBuffer->readbackCount > 0)
 	{
-		Refresh_LogError("Failed to create command pool!");
-		LogVulkanResultAsError("vkCreateCommandPool", vulkanResult);
-		return NULL;
-	}
-
-	vulkanCommandPool->threadID = threadID;
-
-	vulkanCommandPool->inactiveCommandBufferCapacity = 0;
-	vulkanCommandPool->inactiveCommandBufferCount = 0;
-	vulkanCommandPool->inactiveCommandBuffers = NULL;
+		SDL_LockMutex(renderer->readbackRing.lock);
 
-	VULKAN_INTERNAL_AllocateCommandBuffers(
-		renderer,
-		vulkanCommandPool,
-		2
-	);
+		for (i = 0; i < commandBuffer->readbackCount; i += 1)
+		{
+			commandBuffer->readbacks[i]->commandBuffer = NULL;
+			commandBuffer->readbacks[i]->fence = VK_NULL_HANDLE;
 
-	CommandPoolHashTable_Insert(
-		&renderer->commandPoolHashTable,
-		commandPoolHash,
-		vulkanCommandPool
-	);
+			if (commandBuffer->readbacks[i]->released)
+			{
+				VULKAN_INTERNAL_FreeReadback(renderer, commandBuffer->readbacks[i]);
+			}
+		}
 
-	return vulkanCommandPool;
-}
+		SDL_UnlockMutex(renderer->readbackRing.lock);
 
-static VulkanCommandBuffer* VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
-	VulkanRenderer *renderer,
-	SDL_threadID threadID
-) {
-	VulkanCommandPool *commandPool =
-		VULKAN_INTERNAL_FetchCommandPool(renderer, threadID);
-	VulkanCommandBuffer *commandBuffer;
+		commandBuffer->readbackCount = 0;
+	}
 
-	if (commandPool->inactiveCommandBufferCount == 0)
+	if (commandBuffer->autoReleaseFence)
 	{
-		VULKAN_INTERNAL_AllocateCommandBuffers(
-			renderer,
-			commandPool,
-			commandPool->inactiveCommandBufferCapacity
-		);
-	}
+		if (hadReadbacks && renderer->readbackWaiterCount > 0)
+		{
+			/* A readback waiter may still hold this fence */
+			EXPAND_ARRAY_IF_NEEDED(
+				renderer->deferredReadbackFences,
+				VkFence,
+				renderer->deferredReadbackFenceCount + 1,
+				renderer->deferredReadbackFenceCapacity,
+				renderer->deferredReadbackFenceCapacity * 2
+			)
+
+			renderer->deferredReadbackFences[renderer->deferredReadbackFenceCount] = commandBuffer->inFlightFence;
+			renderer->deferredReadbackFenceCount += 1;
+		}
+		else
+		{
+			VULKAN_INTERNAL_ReturnFenceToPool(
+				renderer,
+				commandBuffer->inFlightFence
+			);
+		}
 
-	commandBuffer = commandPool->inactiveCommandBuffers[commandPool->inactiveCommandBufferCount - 1];
-	commandPool->inactiveCommandBufferCount -= 1;
+		commandBuffer->inFlightFence = VK_NULL_HANDLE;
+	}
 
-	return commandBuffer;
-}
+	/* Bound uniform buffers are now available */
 
-static Refresh_CommandBuffer* VULKAN_AcquireCommandBuffer(
-	Refresh_Renderer *driverData
-) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VkResult result;
+	for (i = 0; i < commandBuffer->boundUniformBufferCount; i += 1)
+	{
+		uniformBuffer = commandBuffer->boundUniformBuffers[i];
 
-	SDL_threadID threadID = SDL_ThreadID();
+		SDL_LockMutex(uniformBuffer->pool->lock);
+		if (uniformBuffer->pool->availableBufferCount == uniformBuffer->pool->availableBufferCapacity)
+		{
+			uniformBuffer->pool->availableBufferCapacity *= 2;
+			uniformBuffer->pool->availableBuffers = SDL_realloc(
+				uniformBuffer->pool->availableBuffers,
+				uniformBuffer->pool->availableBufferCapacity * sizeof(VulkanUniformBuffer*)
+			);
+		}
 
-	SDL_LockMutex(renderer->acquireCommandBufferLock);
+		uniformBuffer->pool->availableBuffers[uniformBuffer->pool->availableBufferCount] = uniformBuffer;
+		uniformBuffer->pool->availableBufferCount += 1;
+		SDL_UnlockMutex(uniformBuffer->pool->lock);
+	}
 
-	VulkanCommandBuffer *commandBuffer =
-		VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID);
+	commandBuffer->boundUniformBufferCount = 0;
 
-	SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+	/* Clean up transfer buffers */
 
-	/* Reset state */
+	for (i = 0; i < commandBuffer->transferBufferCount; i += 1)
+	{
+		if (commandBuffer->transferBuffers[i]->fromPool)
+		{
+			SDL_LockMutex(renderer->transferBufferPool.lock);
 
-	commandBuffer->currentComputePipeline = NULL;
-	commandBuffer->currentGraphicsPipeline = NULL;
+			commandBuffer->transferBuffers[i]->offset = 0;
+			renderer->transferBufferPool.availableBuffers[renderer->transferBufferPool.availableBufferCount] = commandBuffer->transferBuffers[i];
+			renderer->transferBufferPool.availableBufferCount += 1;
 
-	commandBuffer->vertexUniformBuffer = NULL;
-	commandBuffer->fragmentUniformBuffer = NULL;
-	commandBuffer->computeUniformBuffer = NULL;
+			SDL_UnlockMutex(renderer->transferBufferPool.lock);
+		}
+		else
+		{
+			VULKAN_INTERNAL_QueueDestroyBuffer(renderer, commandBuffer->transferBuffers[i]->buffer);
+			SDL_free(commandBuffer->transferBuffers[i]);
+			commandBuffer->transferBuffers[i] = NULL;
+		}
+	}
 
-	commandBuffer->renderPassColorTargetCount = 0;
+	commandBuffer->transferBufferCount = 0;
 
-	/* Reset the command buffer here to avoid resets being called
-	 * from a separate thread than where the command buffer was acquired
-	 */
-	result = renderer->vkResetCommandBuffer(
-		commandBuffer->commandBuffer,
-		VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT
-	);
+	/* Bound descriptor sets are now available */
 
-	if (result != VK_SUCCESS)
+	for (i = 0; i < commandBuffer->boundDescriptorSetDataCount; i += 1)
 	{
-		LogVulkanResultAsError("vkResetCommandBuffer", result);
-	}
+		descriptorSetData = &commandBuffer->boundDescriptorSetDatas[i];
 
-	VULKAN_INTERNAL_BeginCommandBuffer(renderer, commandBuffer);
+		SDL_LockMutex(descriptorSetData->descriptorSetCache->lock);
 
-	return (Refresh_CommandBuffer*) commandBuffer;
-}
+		if (descriptorSetData->descriptorSetCache->inactiveDescriptorSetCount == descriptorSetData->descriptorSetCache->inactiveDescriptorSetCapacity)
+		{
+			descriptorSetData->descriptorSetCache->inactiveDescriptorSetCapacity *= 2;
+			descriptorSetData->descriptorSetCache->inactiveDescriptorSets = SDL_realloc(
+				descriptorSetData->descriptorSetCache->inactiveDescriptorSets,
+				descriptorSetData->descriptorSetCache->inactiveDescriptorSetCapacity * sizeof(VkDescriptorSet)
+			);
+		}
 
-static WindowData* VULKAN_INTERNAL_FetchWindowData(
-	void *windowHandle
-) {
-	return (WindowData*) SDL_GetWindowData(windowHandle, WINDOW_DATA);
-}
+		descriptorSetData->descriptorSetCache->inactiveDescriptorSets[descriptorSetData->descriptorSetCache->inactiveDescriptorSetCount] = descriptorSetData->descriptorSet;
+		descriptorSetData->descriptorSetCache->inactiveDescriptorSetCount += 1;
 
-static uint8_t VULKAN_ClaimWindow(
-	Refresh_Renderer *driverData,
-	void *windowHandle,
-	Refresh_PresentMode presentMode
-) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(windowHandle);
+		SDL_UnlockMutex(descriptorSetData->descriptorSetCache->lock);
+	}
 
-	if (windowData == NULL)
+	commandBuffer->boundDescriptorSetDataCount = 0;
+
+	/* Decrement reference counts */
+
+	for (i = 0; i < commandBuffer->usedBufferCount; i += 1)
 	{
-		windowData = SDL_malloc(sizeof(WindowData));
-		windowData->windowHandle = windowHandle;
-		windowData->preferredPresentMode = presentMode;
+		SDL_AtomicDecRef(&commandBuffer->usedBuffers[i]->referenceCount);
+	}
+	commandBuffer->usedBufferCount = 0;
 
-		if (VULKAN_INTERNAL_CreateSwapchain(renderer, windowData))
-		{
-			SDL_SetWindowData((SDL_Window*) windowHandle, WINDOW_DATA, windowData);
+	for (i = 0; i < commandBuffer->usedTextureCount; i += 1)
+	{
+		SDL_AtomicDecRef(&commandBuffer->usedTextures[i]->referenceCount);
+	}
+	commandBuffer->usedTextureCount = 0;
 
-			if (renderer->claimedWindowCount >= renderer->claimedWindowCapacity)
-			{
-				renderer->claimedWindowCapacity *= 2;
-				renderer->claimedWindows = SDL_realloc(
-					renderer->claimedWindows,
-					renderer->claimedWindowCapacity * sizeof(WindowData*)
-				);
-			}
+	for (i = 0; i < commandBuffer->usedSamplerCount; i += 1)
+	{
+		SDL_AtomicDecRef(&commandBuffer->usedSamplers[i]->referenceCount);
+	}
+	commandBuffer->usedSamplerCount = 0;
 
-			renderer->claimedWindows[renderer->claimedWindowCount] = windowData;
-			renderer->claimedWindowCount += 1;
+	for (i = 0; i < commandBuffer->usedGraphicsPipelineCount; i += 1)
+	{
+		SDL_AtomicDecRef(&commandBuffer->usedGraphicsPipelines[i]->referenceCount);
+	}
+	commandBuffer->usedGraphicsPipelineCount = 0;
 
-			return 1;
-		}
-		else
-		{
-			Refresh_LogError("Could not create swapchain, failed to claim window!");
-			SDL_free(windowData);
-			return 0;
-		}
+	for (i = 0; i < commandBuffer->usedComputePipelineCount; i += 1)
+	{
+		SDL_AtomicDecRef(&commandBuffer->usedComputePipelines[i]->referenceCount);
 	}
-	else
+	commandBuffer->usedComputePipelineCount = 0;
+
+	for (i = 0; i < commandBuffer->usedFramebufferCount; i += 1)
 	{
-		Refresh_LogWarn("Window already claimed!");
-		return 0;
+		SDL_AtomicDecRef(&commandBuffer->usedFramebuffers[i]->referenceCount);
 	}
-}
+	commandBuffer->usedFramebufferCount = 0;
 
-static void VULKAN_UnclaimWindow(
-	Refresh_Renderer *driverData,
-	void *windowHandle
-) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(windowHandle);
-	uint32_t i;
+	/* Transfer semaphores have been waited on and can be destroyed */
 
-	if (windowData == NULL)
+	for (i = 0; i < commandBuffer->transferSemaphoreCount; i += 1)
 	{
-		return;
+		renderer->vkDestroySemaphore(
+			renderer->logicalDevice,
+			commandBuffer->transferSemaphores[i],
+			NULL
+		);
 	}
+	commandBuffer->transferSemaphoreCount = 0;
 
-	if (windowData->swapchainData != NULL)
+	/* Reset presentation data */
+
+	commandBuffer->presentDataCount = 0;
+	commandBuffer->waitSemaphoreCount = 0;
+	commandBuffer->signalSemaphoreCount = 0;
+
+	/* Return command buffer to pool */
+
+	SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+	if (commandBuffer->commandPool->inactiveCommandBufferCount == commandBuffer->commandPool->inactiveCommandBufferCapacity)
 	{
-		VULKAN_Wait(driverData);
-		VULKAN_INTERNAL_DestroySwapchain(
-			(VulkanRenderer*) driverData,
-			windowData
+		commandBuffer->commandPool->inactiveCommandBufferCapacity += 1;
+		commandBuffer->commandPool->inactiveCommandBuffers = SDL_realloc(
+			commandBuffer->commandPool->inactiveCommandBuffers,
+			commandBuffer->commandPool->inactiveCommandBufferCapacity * sizeof(VulkanCommandBuffer*)
 		);
 	}
 
-	for (i = 0; i < renderer->claimedWindowCount; i += 1)
+	commandBuffer->commandPool->inactiveCommandBuffers[
+		commandBuffer->commandPool->inactiveCommandBufferCount
+	] = commandBuffer;
+	commandBuffer->commandPool->inactiveCommandBufferCount += 1;
+
+	SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+
+	/* Remove this command buffer from the submitted list */
+	for (i = 0; i < renderer->submittedCommandBufferCount; i += 1)
 	{
-		if (renderer->claimedWindows[i]->windowHandle == windowHandle)
+		if (renderer->submittedCommandBuffers[i] == commandBuffer)
 		{
-			renderer->claimedWindows[i] = renderer->claimedWindows[renderer->claimedWindowCount - 1];
-			renderer->claimedWindowCount -= 1;
-			break;
+			renderer->submittedCommandBuffers[i] = renderer->submittedCommandBuffers[renderer->submittedCommandBufferCount - 1];
+			renderer->submittedCommandBufferCount -= 1;
 		}
 	}
-
-	SDL_free(windowData);
-	SDL_SetWindowData((SDL_Window*) windowHandle, WINDOW_DATA, NULL);
 }
 
-static Refresh_Texture* VULKAN_AcquireSwapchainTexture(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	void *windowHandle,
-	uint32_t *pWidth,
-	uint32_t *pHeight
+static void VULKAN_Wait(
+	Refresh_Renderer *driverData
 ) {
 	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	uint32_t swapchainImageIndex;
-	WindowData *windowData;
-	VulkanSwapchainData *swapchainData;
-	VkResult acquireResult = VK_SUCCESS;
-	VulkanTextureContainer *swapchainTextureContainer = NULL;
-	VulkanPresentData *presentData;
+	VulkanCommandBuffer *commandBuffer;
+	VkResult result;
+	int32_t i;
 
-	windowData = VULKAN_INTERNAL_FetchWindowData(windowHandle);
-	if (windowData == NULL)
+	result = renderer->vkDeviceWaitIdle(renderer->logicalDevice);
+
+	if (result != VK_SUCCESS)
 	{
-		return NULL;
+		LogVulkanResultAsError("vkDeviceWaitIdle", result);
+		return;
 	}
 
-	swapchainData = windowData->swapchainData;
+	SDL_LockMutex(renderer->submitLock);
 
-	/* Window is claimed but swapchain is invalid! */
-	if (swapchainData == NULL)
+	for (i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1)
 	{
-		if (SDL_GetWindowFlags(windowHandle) & SDL_WINDOW_MINIMIZED)
-		{
-			/* Window is minimized, don't bother */
-			return NULL;
-		}
-
-		/* Let's try to recreate */
-		VULKAN_INTERNAL_RecreateSwapchain(renderer, windowData);
-		swapchainData = windowData->swapchainData;
-
-		if (swapchainData == NULL)
-		{
-			Refresh_LogWarn("Failed to recreate swapchain!");
-			return NULL;
-		}
+		commandBuffer = renderer->submittedCommandBuffers[i];
+		VULKAN_INTERNAL_CleanCommandBuffer(renderer, commandBuffer);
 	}
 
-	acquireResult = renderer->vkAcquireNextImageKHR(
-		renderer->logicalDevice,
-		swapchainData->swapchain,
-		UINT64_MAX,
-		swapchainData->imageAvailableSemaphore,
-		VK_NULL_HANDLE,
-		&swapchainImageIndex
-	);
-
-	/* Acquisition is invalid, let's try to recreate */
-	if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR)
-	{
-		VULKAN_INTERNAL_RecreateSwapchain(renderer, windowData);
-		swapchainData = windowData->swapchainData;
+	VULKAN_INTERNAL_PerformPendingDestroys(renderer);
 
-		if (swapchainData == NULL)
-		{
-			Refresh_LogWarn("Failed to recreate swapchain!");
-			return NULL;
-		}
+	SDL_UnlockMutex(renderer->submitLock);
+}
 
-		acquireResult = renderer->vkAcquireNextImageKHR(
-			renderer->logicalDevice,
-			swapchainData->swapchain,
-			UINT64_MAX,
-			swapchainData->imageAvailableSemaphore,
-			VK_NULL_HANDLE,
-			&swapchainImageIndex
-		);
+static Refresh_Fence* VULKAN_SubmitAndAcquireFence(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer
+) {
+	VulkanCommandBuffer *vulkanCommandBuffer;
 
-		if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR)
-		{
-			Refresh_LogWarn("Failed to acquire swapchain texture!");
-			return NULL;
-		}
-	}
+	VULKAN_Submit(driverData, commandBuffer);
 
-	swapchainTextureContainer = &swapchainData->textureContainers[swapchainImageIndex];
+	vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	vulkanCommandBuffer->autoReleaseFence = 0;
 
-	VULKAN_INTERNAL_ImageMemoryBarrier(
-		renderer,
-		vulkanCommandBuffer->commandBuffer,
-		RESOURCE_ACCESS_COLOR_ATTACHMENT_WRITE,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		0,
-		1,
-		0,
-		1,
-		0,
-		swapchainTextureContainer->vulkanTexture->image,
-		&swapchainTextureContainer->vulkanTexture->resourceAccessType
-	);
+	return (Refresh_Fence*) vulkanCommandBuffer->inFlightFence;
+}
 
-	/* Set up present struct */
+/* Resources the graphics queue has used are released by it before a
+ * transfer command buffer writes them. The release goes on its own
+ * graphics submission, after all graphics work submitted so far, and the
+ * transfer submission waits for it. Caller must hold the submit lock.
+ */
+static void VULKAN_INTERNAL_SubmitGraphicsRelease(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *transferCommandBuffer
+) {
+	VulkanCommandBuffer *commandBuffer;
+	VkSemaphoreCreateInfo semaphoreCreateInfo;
+	VkSemaphore semaphore;
+	VkSubmitInfo submitInfo;
+	VkResult vulkanResult;
 
-	if (vulkanCommandBuffer->presentDataCount == vulkanCommandBuffer->presentDataCapacity)
+	if (	transferCommandBuffer->graphicsReleaseBufferBarrierCount == 0 &&
+		transferCommandBuffer->graphicsReleaseImageBarrierCount == 0	)
 	{
-		vulkanCommandBuffer->presentDataCapacity += 1;
-		vulkanCommandBuffer->presentDatas = SDL_realloc(
-			vulkanCommandBuffer->presentDatas,
-			vulkanCommandBuffer->presentDataCapacity * sizeof(VkPresentInfoKHR)
-		);
+		return;
 	}
 
-	presentData = &vulkanCommandBuffer->presentDatas[vulkanCommandBuffer->presentDataCount];
-	vulkanCommandBuffer->presentDataCount += 1;
-
-	presentData->windowData = windowData;
-	presentData->swapchainImageIndex = swapchainImageIndex;
+	semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	semaphoreCreateInfo.pNext = NULL;
+	semaphoreCreateInfo.flags = 0;
 
-	/* Set up present semaphores */
+	vulkanResult = renderer->vkCreateSemaphore(
+		renderer->logicalDevice,
+		&semaphoreCreateInfo,
+		NULL,
+		&semaphore
+	);
 
-	if (vulkanCommandBuffer->waitSemaphoreCount == vulkanCommandBuffer->waitSemaphoreCapacity)
+	if (vulkanResult != VK_SUCCESS)
 	{
-		vulkanCommandBuffer->waitSemaphoreCapacity += 1;
-		vulkanCommandBuffer->waitSemaphores = SDL_realloc(
-			vulkanCommandBuffer->waitSemaphores,
-			vulkanCommandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore)
-		);
+		LogVulkanResultAsError("vkCreateSemaphore", vulkanResult);
+		transferCommandBuffer->graphicsReleaseBufferBarrierCount = 0;
+		transferCommandBuffer->graphicsReleaseImageBarrierCount = 0;
+		return;
 	}
 
-	vulkanCommandBuffer->waitSemaphores[vulkanCommandBuffer->waitSemaphoreCount] = swapchainData->imageAvailableSemaphore;
-	vulkanCommandBuffer->waitSemaphoreCount += 1;
+	commandBuffer = VULKAN_INTERNAL_AcquireCommandBuffer(renderer, 0);
 
-	if (vulkanCommandBuffer->signalSemaphoreCount == vulkanCommandBuffer->signalSemaphoreCapacity)
+	/* The first scope covers every earlier submission on the graphics queue */
+	renderer->vkCmdPipelineBarrier(
+		commandBuffer->commandBuffer,
+		VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+		VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		0,
+		0,
+		NULL,
+		transferCommandBuffer->graphicsReleaseBufferBarrierCount,
+		transferCommandBuffer->graphicsReleaseBufferBarriers,
+		transferCommandBuffer->graphicsReleaseImageBarrierCount,
+		transferCommandBuffer->graphicsReleaseImageBarriers
+	);
+
+	transferCommandBuffer->graphicsReleaseBufferBarrierCount = 0;
+	transferCommandBuffer->graphicsReleaseImageBarrierCount = 0;
+
+	if (commandBuffer->signalSemaphoreCount == commandBuffer->signalSemaphoreCapacity)
 	{
-		vulkanCommandBuffer->signalSemaphoreCapacity += 1;
-		vulkanCommandBuffer->signalSemaphores = SDL_realloc(
-			vulkanCommandBuffer->signalSemaphores,
-			vulkanCommandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore)
+		commandBuffer->signalSemaphoreCapacity += 1;
+		commandBuffer->signalSemaphores = SDL_realloc(
+			commandBuffer->signalSemaphores,
+			commandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore)
 		);
 	}
 
-	vulkanCommandBuffer->signalSemaphores[vulkanCommandBuffer->signalSemaphoreCount] = swapchainData->renderFinishedSemaphore;
-	vulkanCommandBuffer->signalSemaphoreCount += 1;
+	commandBuffer->signalSemaphores[commandBuffer->signalSemaphoreCount] = semaphore;
+	commandBuffer->signalSemaphoreCount += 1;
 
-	*pWidth = swapchainData->extent.width;
-	*pHeight = swapchainData->extent.height;
+	VULKAN_INTERNAL_EndCommandBuffer(renderer, commandBuffer);
 
-	return (Refresh_Texture*) swapchainTextureContainer;
-}
+	commandBuffer->autoReleaseFence = 1;
+	commandBuffer->inFlightFence = VULKAN_INTERNAL_AcquireFenceFromPool(renderer);
 
-static Refresh_TextureFormat VULKAN_GetSwapchainFormat(
-	Refresh_Renderer *driverData,
-	void *windowHandle
-) {
-	WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(windowHandle);
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.pNext = NULL;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer->commandBuffer;
+	submitInfo.pWaitDstStageMask = commandBuffer->waitSemaphoreStages;
+	submitInfo.pWaitSemaphores = commandBuffer->waitSemaphores;
+	submitInfo.waitSemaphoreCount = commandBuffer->waitSemaphoreCount;
+	submitInfo.pSignalSemaphores = commandBuffer->signalSemaphores;
+	submitInfo.signalSemaphoreCount = commandBuffer->signalSemaphoreCount;
 
-	if (windowData == NULL)
-	{
-		Refresh_LogWarn("Cannot get swapchain format, window has not been claimed!");
-		return 0;
-	}
+	vulkanResult = renderer->vkQueueSubmit(
+		renderer->unifiedQueue,
+		1,
+		&submitInfo,
+		commandBuffer->inFlightFence
+	);
 
-	if (windowData->swapchainData == NULL)
+	if (vulkanResult != VK_SUCCESS)
 	{
-		Refresh_LogWarn("Cannot get swapchain format, swapchain is currently invalid!");
-		return 0;
+		LogVulkanResultAsError("vkQueueSubmit", vulkanResult);
 	}
 
-	if (windowData->swapchainData->swapchainFormat == VK_FORMAT_R8G8B8A8_UNORM)
+	if (renderer->submittedCommandBufferCount + 1 >= renderer->submittedCommandBufferCapacity)
 	{
-		return REFRESH_TEXTUREFORMAT_R8G8B8A8;
+		renderer->submittedCommandBufferCapacity = renderer->submittedCommandBufferCount + 1;
+
+		renderer->submittedCommandBuffers = SDL_realloc(
+			renderer->submittedCommandBuffers,
+			sizeof(VulkanCommandBuffer*) * renderer->submittedCommandBufferCapacity
+		);
 	}
-	else if (windowData->swapchainData->swapchainFormat == VK_FORMAT_B8G8R8A8_UNORM)
+
+	renderer->submittedCommandBuffers[renderer->submittedCommandBufferCount] = commandBuffer;
+	renderer->submittedCommandBufferCount += 1;
+
+	/* The transfer waits before its first copy and destroys the semaphore once done */
+
+	if (transferCommandBuffer->waitSemaphoreCount == transferCommandBuffer->waitSemaphoreCapacity)
 	{
-		return REFRESH_TEXTUREFORMAT_B8G8R8A8;
+		transferCommandBuffer->waitSemaphoreCapacity += 1;
+		transferCommandBuffer->waitSemaphores = SDL_realloc(
+			transferCommandBuffer->waitSemaphores,
+			transferCommandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore)
+		);
+		transferCommandBuffer->waitSemaphoreStages = SDL_realloc(
+			transferCommandBuffer->waitSemaphoreStages,
+			transferCommandBuffer->waitSemaphoreCapacity * sizeof(VkPipelineStageFlags)
+		);
 	}
-	else
+
+	transferCommandBuffer->waitSemaphores[transferCommandBuffer->waitSemaphoreCount] = semaphore;
+	transferCommandBuffer->waitSemaphoreStages[transferCommandBuffer->waitSemaphoreCount] = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	transferCommandBuffer->waitSemaphoreCount += 1;
+
+	if (transferCommandBuffer->transferSemaphoreCount == transferCommandBuffer->transferSemaphoreCapacity)
 	{
-		Refresh_LogWarn("Unrecognized swapchain format!");
-		return 0;
+		transferCommandBuffer->transferSemaphoreCapacity += 1;
+		transferCommandBuffer->transferSemaphores = SDL_realloc(
+			transferCommandBuffer->transferSemaphores,
+			transferCommandBuffer->transferSemaphoreCapacity * sizeof(VkSemaphore)
+		);
 	}
+
+	transferCommandBuffer->transferSemaphores[transferCommandBuffer->transferSemaphoreCount] = semaphore;
+	transferCommandBuffer->transferSemaphoreCount += 1;
 }
 
-static void VULKAN_SetSwapchainPresentMode(
+static void VULKAN_Submit(
 	Refresh_Renderer *driverData,
-	void *windowHandle,
-	Refresh_PresentMode presentMode
+	Refresh_CommandBuffer *commandBuffer
 ) {
-	WindowData *windowData = VULKAN_INTERNAL_FetchWindowData(windowHandle);
-
-	if (windowData == NULL)
-	{
-		Refresh_LogWarn("Cannot set present mode, window has not been claimed!");
-		return;
-	}
+	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
+	VkSubmitInfo submitInfo;
+	VkPresentInfoKHR presentInfo;
+	VulkanPresentData *presentData;
+	VkResult vulkanResult, presentResult = VK_SUCCESS;
+	VulkanCommandBuffer *vulkanCommandBuffer;
+	uint32_t swapchainImageIndex;
+	VulkanUploadRingRange *uploadRingRange;
+	uint32_t rangeIndex;
+	uint8_t asyncTransfer;
+	uint8_t commandBufferCleaned = 0;
+	uint8_t shouldDefrag;
+	VulkanMemoryPressureReport memoryPressureReport;
+	int32_t i, j;
 
-	VULKAN_INTERNAL_RecreateSwapchain(
-		(VulkanRenderer *)driverData,
-		windowData
-	);
-}
+	SDL_LockMutex(renderer->submitLock);
 
-/* Submission structure */
+	vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	asyncTransfer = VULKAN_INTERNAL_IsAsyncTransfer(renderer, vulkanCommandBuffer);
 
-static VkFence VULKAN_INTERNAL_AcquireFenceFromPool(
-	VulkanRenderer *renderer
-) {
-	VkFenceCreateInfo fenceCreateInfo;
-	VkFence fence;
-	VkResult vulkanResult;
+	VULKAN_INTERNAL_FlushBufferUploads(renderer, vulkanCommandBuffer);
+	VULKAN_INTERNAL_ReleaseUniformBuffers(renderer, vulkanCommandBuffer);
 
-	if (renderer->fencePool.availableFenceCount == 0)
+	for (j = 0; j < vulkanCommandBuffer->presentDataCount; j += 1)
 	{
-		/* Create fence */
-		fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-		fenceCreateInfo.pNext = NULL;
-		fenceCreateInfo.flags = 0;
+		swapchainImageIndex = vulkanCommandBuffer->presentDatas[j].swapchainImageIndex;
 
-		vulkanResult = renderer->vkCreateFence(
-			renderer->logicalDevice,
-			&fenceCreateInfo,
-			NULL,
-			&fence
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_PRESENT,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			0,
+			1,
+			0,
+			1,
+			0,
+			vulkanCommandBuffer->presentDatas[j].windowData->swapchainData->textureContainers[swapchainImageIndex].vulkanTexture
 		);
+	}
 
-		if (vulkanResult != VK_SUCCESS)
-		{
-			LogVulkanResultAsError("vkCreateFence", vulkanResult);
-			return NULL;
-		}
+	if (asyncTransfer)
+	{
+		VULKAN_INTERNAL_SubmitGraphicsRelease(renderer, vulkanCommandBuffer);
+	}
 
-		return fence;
+	/* Held until the submit so no graphics command buffer can wait on an unsubmitted semaphore */
+	if (asyncTransfer)
+	{
+		SDL_LockMutex(renderer->pendingTransferLock);
+		VULKAN_INTERNAL_ReleaseToGraphicsQueue(renderer, vulkanCommandBuffer);
 	}
 
-	SDL_LockMutex(renderer->fencePool.lock);
+	VULKAN_INTERNAL_EndCommandBuffer(renderer, vulkanCommandBuffer);
 
-	fence = renderer->fencePool.availableFences[renderer->fencePool.availableFenceCount - 1];
-	renderer->fencePool.availableFenceCount -= 1;
+	vulkanCommandBuffer->autoReleaseFence = 1;
+	vulkanCommandBuffer->inFlightFence = VULKAN_INTERNAL_AcquireFenceFromPool(renderer);
 
-	vulkanResult = renderer->vkResetFences(
-		renderer->logicalDevice,
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.pNext = NULL;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &vulkanCommandBuffer->commandBuffer;
+
+	submitInfo.pWaitDstStageMask = vulkanCommandBuffer->waitSemaphoreStages;
+	submitInfo.pWaitSemaphores = vulkanCommandBuffer->waitSemaphores;
+	submitInfo.waitSemaphoreCount = vulkanCommandBuffer->waitSemaphoreCount;
+	submitInfo.pSignalSemaphores = vulkanCommandBuffer->signalSemaphores;
+	submitInfo.signalSemaphoreCount = vulkanCommandBuffer->signalSemaphoreCount;
+
+	vulkanResult = renderer->vkQueueSubmit(
+		vulkanCommandBuffer->isTransfer ? renderer->transferQueue : renderer->unifiedQueue,
 		1,
-		&fence
+		&submitInfo,
+		vulkanCommandBuffer->inFlightFence
 	);
 
-	if (vulkanResult != VK_SUCCESS)
+	if (asyncTransfer)
 	{
-		LogVulkanResultAsError("vkResetFences", vulkanResult);
+		SDL_UnlockMutex(renderer->pendingTransferLock);
 	}
 
-	SDL_UnlockMutex(renderer->fencePool.lock);
-
-	return fence;
-}
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkQueueSubmit", vulkanResult);
+	}
 
-static void VULKAN_INTERNAL_ReturnFenceToPool(
-	VulkanRenderer *renderer,
-	VkFence fence
-) {
-	SDL_LockMutex(renderer->fencePool.lock);
+	/* Upload ring space used by this command buffer can now be polled */
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->fencePool.availableFences,
-		VkFence,
-		renderer->fencePool.availableFenceCount + 1,
-		renderer->fencePool.availableFenceCapacity,
-		renderer->fencePool.availableFenceCapacity * 2
-	);
+	if (vulkanCommandBuffer->usedUploadRing)
+	{
+		SDL_LockMutex(renderer->uploadRing.lock);
 
-	renderer->fencePool.availableFences[renderer->fencePool.availableFenceCount] = fence;
-	renderer->fencePool.availableFenceCount += 1;
+		for (rangeIndex = 0; rangeIndex < renderer->uploadRing.rangeCount; rangeIndex += 1)
+		{
+			uploadRingRange = &renderer->uploadRing.ranges[
+				(renderer->uploadRing.rangeStart + rangeIndex) % renderer->uploadRing.rangeCapacity
+			];
 
-	SDL_UnlockMutex(renderer->fencePool.lock);
-}
+			if (uploadRingRange->commandBuffer == vulkanCommandBuffer)
+			{
+				uploadRingRange->fence = vulkanCommandBuffer->inFlightFence;
+			}
+		}
 
-static void VULKAN_INTERNAL_PerformPendingDestroys(
-	VulkanRenderer *renderer
-) {
-	int32_t i;
+		SDL_UnlockMutex(renderer->uploadRing.lock);
+	}
 
-	SDL_LockMutex(renderer->disposeLock);
+	/* Readbacks can now be polled, the submit lock guards their fences */
 
-	for (i = renderer->texturesToDestroyCount - 1; i >= 0; i -= 1)
+	for (rangeIndex = 0; rangeIndex < vulkanCommandBuffer->readbackCount; rangeIndex += 1)
 	{
-		if (SDL_AtomicGet(&renderer->texturesToDestroy[i]->referenceCount) == 0)
-		{
-			VULKAN_INTERNAL_DestroyTexture(
-				renderer,
-				renderer->texturesToDestroy[i]
-			);
-
-			renderer->texturesToDestroy[i] = renderer->texturesToDestroy[renderer->texturesToDestroyCount - 1];
-			renderer->texturesToDestroyCount -= 1;
-		}
+		vulkanCommandBuffer->readbacks[rangeIndex]->fence = vulkanCommandBuffer->inFlightFence;
 	}
 
-	for (i = renderer->buffersToDestroyCount - 1; i >= 0; i -= 1)
+	/* Mark command buffers as submitted */
+
+	if (renderer->submittedCommandBufferCount + 1 >= renderer->submittedCommandBufferCapacity)
 	{
-		if (SDL_AtomicGet(&renderer->buffersToDestroy[i]->referenceCount) == 0)
-		{
-			VULKAN_INTERNAL_DestroyBuffer(
-				renderer,
-				renderer->buffersToDestroy[i]);
+		renderer->submittedCommandBufferCapacity = renderer->submittedCommandBufferCount + 1;
 
-			renderer->buffersToDestroy[i] = renderer->buffersToDestroy[renderer->buffersToDestroyCount - 1];
-			renderer->buffersToDestroyCount -= 1;
-		}
+		renderer->submittedCommandBuffers = SDL_realloc(
+			renderer->submittedCommandBuffers,
+			sizeof(VulkanCommandBuffer*) * renderer->submittedCommandBufferCapacity
+		);
 	}
 
-	for (i = renderer->graphicsPipelinesToDestroyCount - 1; i >= 0; i -= 1)
-	{
-		if (SDL_AtomicGet(&renderer->graphicsPipelinesToDestroy[i]->referenceCount) == 0)
-		{
-			VULKAN_INTERNAL_DestroyGraphicsPipeline(
-				renderer,
-				renderer->graphicsPipelinesToDestroy[i]
-			);
+	renderer->submittedCommandBuffers[renderer->submittedCommandBufferCount] = vulkanCommandBuffer;
+	renderer->submittedCommandBufferCount += 1;
 
-			renderer->graphicsPipelinesToDestroy[i] = renderer->graphicsPipelinesToDestroy[renderer->graphicsPipelinesToDestroyCount - 1];
-			renderer->graphicsPipelinesToDestroyCount -= 1;
-		}
-	}
+	/* Present, if applicable */
 
-	for (i = renderer->computePipelinesToDestroyCount - 1; i >= 0; i -= 1)
+	for (j = 0; j < vulkanCommandBuffer->presentDataCount; j += 1)
 	{
-		if (SDL_AtomicGet(&renderer->computePipelinesToDestroy[i]->referenceCount) == 0)
-		{
-			VULKAN_INTERNAL_DestroyComputePipeline(
-				renderer,
-				renderer->computePipelinesToDestroy[i]
-			);
+		presentData = &vulkanCommandBuffer->presentDatas[j];
 
-			renderer->computePipelinesToDestroy[i] = renderer->computePipelinesToDestroy[renderer->computePipelinesToDestroyCount - 1];
-			renderer->computePipelinesToDestroyCount -= 1 ;
-		}
-	}
+		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+		presentInfo.pNext = NULL;
+		presentInfo.pWaitSemaphores = &presentData->windowData->swapchainData->renderFinishedSemaphore;
+		presentInfo.waitSemaphoreCount = 1;
+		presentInfo.pSwapchains = &presentData->windowData->swapchainData->swapchain;
+		presentInfo.swapchainCount = 1;
+		presentInfo.pImageIndices = &presentData->swapchainImageIndex;
+		presentInfo.pResults = NULL;
 
-	for (i = renderer->shaderModulesToDestroyCount - 1; i >= 0; i -= 1)
-	{
-		if (SDL_AtomicGet(&renderer->shaderModulesToDestroy[i]->referenceCount) == 0)
+		presentResult = renderer->vkQueuePresentKHR(
+			renderer->unifiedQueue,
+			&presentInfo
+		);
+
+		if (presentResult != VK_SUCCESS)
 		{
-			VULKAN_INTERNAL_DestroyShaderModule(
+			VULKAN_INTERNAL_RecreateSwapchain(
 				renderer,
-				renderer->shaderModulesToDestroy[i]
+				presentData->windowData
 			);
-
-			renderer->shaderModulesToDestroy[i] = renderer->shaderModulesToDestroy[renderer->shaderModulesToDestroyCount - 1];
-			renderer->shaderModulesToDestroyCount -= 1;
 		}
 	}
 
-	for (i = renderer->samplersToDestroyCount - 1; i >= 0; i -= 1)
+	/* Check if we can perform any cleanups */
+
+	for (i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1)
 	{
-		if (SDL_AtomicGet(&renderer->samplersToDestroy[i]->referenceCount) == 0)
+		vulkanResult = renderer->vkGetFenceStatus(
+			renderer->logicalDevice,
+			renderer->submittedCommandBuffers[i]->inFlightFence
+		);
+
+		if (vulkanResult == VK_SUCCESS)
 		{
-			VULKAN_INTERNAL_DestroySampler(
+			VULKAN_INTERNAL_CleanCommandBuffer(
 				renderer,
-				renderer->samplersToDestroy[i]
+				renderer->submittedCommandBuffers[i]
 			);
 
-			renderer->samplersToDestroy[i] = renderer->samplersToDestroy[renderer->samplersToDestroyCount - 1];
-			renderer->samplersToDestroyCount -= 1;
+			commandBufferCleaned = 1;
 		}
 	}
 
-	for (i = renderer->framebuffersToDestroyCount - 1; i >= 0; i -= 1)
+	renderer->submitIndex += 1;
+
+	/* retained blocks can expire without any command buffer completing */
+	if (commandBufferCleaned || renderer->retainedEmptyBlocksPerType > 0)
+	{
+		VULKAN_INTERNAL_ReleaseEmptyMemory(renderer);
+	}
+
+	/* Check pending destroys */
+
+	VULKAN_INTERNAL_PerformPendingDestroys(renderer);
+
+	/* Check budgets after frees so the pressure level reflects them */
+	VULKAN_INTERNAL_UpdateMemoryPressure(renderer, &memoryPressureReport);
+
+	/* Defrag! Once a block is being emptied it continues every submit. */
+	if (!renderer->defragInProgress)
 	{
-		if (SDL_AtomicGet(&renderer->framebuffersToDestroy[i]->referenceCount) == 0)
-		{
-			VULKAN_INTERNAL_DestroyFramebuffer(
-				renderer,
-				renderer->framebuffersToDestroy[i]
-			);
+		SDL_LockMutex(renderer->allocatorLock);
+		shouldDefrag =
+			renderer->defragAllocation != NULL ||
+			(renderer->needDefrag && SDL_GetTicks64() >= renderer->defragTimestamp);
+		SDL_UnlockMutex(renderer->allocatorLock);
 
-			renderer->framebuffersToDestroy[i] = renderer->framebuffersToDestroy[renderer->framebuffersToDestroyCount - 1];
-			renderer->framebuffersToDestroyCount -= 1;
+		if (shouldDefrag)
+		{
+			VULKAN_INTERNAL_DefragmentMemory(renderer);
 		}
 	}
 
-	SDL_UnlockMutex(renderer->disposeLock);
+	SDL_UnlockMutex(renderer->submitLock);
+
+	VULKAN_INTERNAL_ReportMemoryPressure(&memoryPressureReport);
 }
 
-static void VULKAN_INTERNAL_CleanCommandBuffer(
+static uint8_t VULKAN_INTERNAL_DefragmentUsedRegion(
 	VulkanRenderer *renderer,
-	VulkanCommandBuffer *commandBuffer
+	VulkanCommandBuffer *commandBuffer,
+	VulkanMemoryUsedRegion *currentRegion
 ) {
-	uint32_t i;
-	VulkanUniformBuffer *uniformBuffer;
-	DescriptorSetData *descriptorSetData;
+	VulkanBuffer* newBuffer;
+	VulkanTexture* newTexture;
+	VkBufferCopy bufferCopy;
+	VkImageCopy *imageCopyRegions;
+	uint32_t imageCopyRegionCount;
+	uint32_t planeCount;
+	uint32_t layer, level, runStart, i;
+	VulkanResourceAccessType originalResourceAccessType;
+	VulkanResourceAccessType *originalResourceAccessTypes;
 
-	if (commandBuffer->autoReleaseFence)
+	if (currentRegion->isBuffer)
 	{
-		VULKAN_INTERNAL_ReturnFenceToPool(
+		currentRegion->vulkanBuffer->usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+		newBuffer = VULKAN_INTERNAL_CreateBuffer(
 			renderer,
-			commandBuffer->inFlightFence
+			currentRegion->vulkanBuffer->size,
+			RESOURCE_ACCESS_NONE,
+			currentRegion->vulkanBuffer->usage,
+			currentRegion->vulkanBuffer->requireHostVisible,
+			currentRegion->vulkanBuffer->preferDeviceLocal,
+			currentRegion->vulkanBuffer->preferHostCached,
+			0,
+			0
 		);
 
-		commandBuffer->inFlightFence = VK_NULL_HANDLE;
-	}
+		if (newBuffer == NULL)
+		{
+			Refresh_LogError("Failed to create defrag buffer!");
+			return 0;
+		}
 
-	/* Bound uniform buffers are now available */
+		originalResourceAccessType = currentRegion->vulkanBuffer->resourceAccessType;
 
-	for (i = 0; i < commandBuffer->boundUniformBufferCount; i += 1)
-	{
-		uniformBuffer = commandBuffer->boundUniformBuffers[i];
+		VULKAN_INTERNAL_BufferMemoryBarrier(
+			renderer,
+			commandBuffer->commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_READ,
+			currentRegion->vulkanBuffer
+		);
 
-		SDL_LockMutex(uniformBuffer->pool->lock);
-		if (uniformBuffer->pool->availableBufferCount == uniformBuffer->pool->availableBufferCapacity)
+		VULKAN_INTERNAL_BufferMemoryBarrier(
+			renderer,
+			commandBuffer->commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_WRITE,
+			newBuffer
+		);
+
+		bufferCopy.srcOffset = 0;
+		bufferCopy.dstOffset = 0;
+		bufferCopy.size = currentRegion->resourceSize;
+
+		renderer->vkCmdCopyBuffer(
+			commandBuffer->commandBuffer,
+			currentRegion->vulkanBuffer->buffer,
+			newBuffer->buffer,
+			1,
+			&bufferCopy
+		);
+
+		VULKAN_INTERNAL_BufferMemoryBarrier(
+			renderer,
+			commandBuffer->commandBuffer,
+			originalResourceAccessType,
+			newBuffer
+		);
+
+		VULKAN_INTERNAL_TrackBuffer(renderer, commandBuffer, currentRegion->vulkanBuffer);
+		VULKAN_INTERNAL_TrackBuffer(renderer, commandBuffer, newBuffer);
+
+		/* re-point original container to new buffer */
+		if (currentRegion->vulkanBuffer->container != NULL)
 		{
-			uniformBuffer->pool->availableBufferCapacity *= 2;
-			uniformBuffer->pool->availableBuffers = SDL_realloc(
-				uniformBuffer->pool->availableBuffers,
-				uniformBuffer->pool->availableBufferCapacity * sizeof(VulkanUniformBuffer*)
-			);
+			newBuffer->container = currentRegion->vulkanBuffer->container;
+			newBuffer->container->vulkanBuffer = newBuffer;
+			currentRegion->vulkanBuffer->container = NULL;
 		}
 
-		uniformBuffer->pool->availableBuffers[uniformBuffer->pool->availableBufferCount] = uniformBuffer;
-		uniformBuffer->pool->availableBufferCount += 1;
-		SDL_UnlockMutex(uniformBuffer->pool->lock);
+		VULKAN_INTERNAL_QueueDestroyBuffer(renderer, currentRegion->vulkanBuffer);
 	}
+	else
+	{
+		newTexture = VULKAN_INTERNAL_CreateTexture(
+			renderer,
+			currentRegion->vulkanTexture->dimensions.width,
+			currentRegion->vulkanTexture->dimensions.height,
+			currentRegion->vulkanTexture->depth,
+			currentRegion->vulkanTexture->isCube,
+			currentRegion->vulkanTexture->levelCount,
+			currentRegion->vulkanTexture->sampleCount,
+			currentRegion->vulkanTexture->format,
+			currentRegion->vulkanTexture->aspectFlags,
+			currentRegion->vulkanTexture->usageFlags,
+			0
+		);
 
-	commandBuffer->boundUniformBufferCount = 0;
+		if (newTexture == NULL)
+		{
+			Refresh_LogError("Failed to create defrag texture!");
+			return 0;
+		}
 
-	/* Clean up transfer buffers */
+		originalResourceAccessTypes = SDL_stack_alloc(
+			VulkanResourceAccessType,
+			currentRegion->vulkanTexture->layerCount * currentRegion->vulkanTexture->levelCount
+		);
 
-	for (i = 0; i < commandBuffer->transferBufferCount; i += 1)
-	{
-		if (commandBuffer->transferBuffers[i]->fromPool)
+		SDL_memcpy(
+			originalResourceAccessTypes,
+			currentRegion->vulkanTexture->subresourceAccessTypes,
+			currentRegion->vulkanTexture->layerCount * currentRegion->vulkanTexture->levelCount * sizeof(VulkanResourceAccessType)
+		);
+
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			commandBuffer->commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_READ,
+			currentRegion->vulkanTexture->aspectFlags,
+			0,
+			currentRegion->vulkanTexture->layerCount,
+			0,
+			currentRegion->vulkanTexture->levelCount,
+			0,
+			currentRegion->vulkanTexture
+		);
+
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			commandBuffer->commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_WRITE,
+			currentRegion->vulkanTexture->aspectFlags,
+			0,
+			currentRegion->vulkanTexture->layerCount,
+			0,
+			currentRegion->vulkanTexture->levelCount,
+			0,
+			newTexture
+		);
+
+		/* Multi-planar textures have one level, but each plane is copied on its own */
+		planeCount = VULKAN_INTERNAL_PlaneCount(currentRegion->vulkanTexture->format);
+		imageCopyRegionCount = SDL_max(currentRegion->vulkanTexture->levelCount, planeCount);
+		imageCopyRegions = SDL_stack_alloc(VkImageCopy, imageCopyRegionCount);
+
+		for (level = 0; level < currentRegion->vulkanTexture->levelCount; level += 1)
 		{
-			SDL_LockMutex(renderer->transferBufferPool.lock);
+			imageCopyRegions[level].srcOffset.x = 0;
+			imageCopyRegions[level].srcOffset.y = 0;
+			imageCopyRegions[level].srcOffset.z = 0;
+			imageCopyRegions[level].srcSubresource.aspectMask = currentRegion->vulkanTexture->aspectFlags;
+			imageCopyRegions[level].srcSubresource.baseArrayLayer = 0;
+			imageCopyRegions[level].srcSubresource.layerCount = currentRegion->vulkanTexture->layerCount;
+			imageCopyRegions[level].srcSubresource.mipLevel = level;
+			imageCopyRegions[level].extent.width = SDL_max(1, currentRegion->vulkanTexture->dimensions.width >> level);
+			imageCopyRegions[level].extent.height = SDL_max(1, currentRegion->vulkanTexture->dimensions.height >> level);
+			imageCopyRegions[level].extent.depth = currentRegion->vulkanTexture->depth;
+			imageCopyRegions[level].dstOffset.x = 0;
+			imageCopyRegions[level].dstOffset.y = 0;
+			imageCopyRegions[level].dstOffset.z = 0;
+			imageCopyRegions[level].dstSubresource.aspectMask = currentRegion->vulkanTexture->aspectFlags;
+			imageCopyRegions[level].dstSubresource.baseArrayLayer = 0;
+			imageCopyRegions[level].dstSubresource.layerCount = currentRegion->vulkanTexture->layerCount;
+			imageCopyRegions[level].dstSubresource.mipLevel = level;
+		}
 
-			commandBuffer->transferBuffers[i]->offset = 0;
-			renderer->transferBufferPool.availableBuffers[renderer->transferBufferPool.availableBufferCount] = commandBuffer->transferBuffers[i];
-			renderer->transferBufferPool.availableBufferCount += 1;
+		if (planeCount > 1)
+		{
+			for (i = 0; i < planeCount; i += 1)
+			{
+				imageCopyRegions[i] = imageCopyRegions[0];
+				imageCopyRegions[i].srcSubresource.aspectMask = VK_IMAGE_ASPECT_PLANE_0_BIT << i;
+				imageCopyRegions[i].dstSubresource.aspectMask = VK_IMAGE_ASPECT_PLANE_0_BIT << i;
 
-			SDL_UnlockMutex(renderer->transferBufferPool.lock);
+				/* 4:2:0 chroma planes are half size */
+				if (i > 0)
+				{
+					imageCopyRegions[i].extent.width /= 2;
+					imageCopyRegions[i].extent.height /= 2;
+				}
+			}
 		}
 		else
 		{
-			VULKAN_INTERNAL_QueueDestroyBuffer(renderer, commandBuffer->transferBuffers[i]->buffer);
-			SDL_free(commandBuffer->transferBuffers[i]);
-			commandBuffer->transferBuffers[i] = NULL;
+			imageCopyRegionCount = currentRegion->vulkanTexture->levelCount;
 		}
-	}
 
-	commandBuffer->transferBufferCount = 0;
+		renderer->vkCmdCopyImage(
+			commandBuffer->commandBuffer,
+			currentRegion->vulkanTexture->image,
+			AccessMap[RESOURCE_ACCESS_TRANSFER_READ].imageLayout,
+			newTexture->image,
+			AccessMap[RESOURCE_ACCESS_TRANSFER_WRITE].imageLayout,
+			imageCopyRegionCount,
+			imageCopyRegions
+		);
 
-	/* Bound descriptor sets are now available */
+		/* Give each run of levels back the access it had on the old texture */
+		for (layer = 0; layer < newTexture->layerCount; layer += 1)
+		{
+			level = 0;
 
-	for (i = 0; i < commandBuffer->boundDescriptorSetDataCount; i += 1)
-	{
-		descriptorSetData = &commandBuffer->boundDescriptorSetDatas[i];
+			while (level < newTexture->levelCount)
+			{
+				runStart = level;
+				originalResourceAccessType = originalResourceAccessTypes[layer * newTexture->levelCount + level];
 
-		SDL_LockMutex(descriptorSetData->descriptorSetCache->lock);
+				while (	level < newTexture->levelCount &&
+					originalResourceAccessTypes[layer * newTexture->levelCount + level] == originalResourceAccessType	)
+				{
+					level += 1;
+				}
 
-		if (descriptorSetData->descriptorSetCache->inactiveDescriptorSetCount == descriptorSetData->descriptorSetCache->inactiveDescriptorSetCapacity)
-		{
-			descriptorSetData->descriptorSetCache->inactiveDescriptorSetCapacity *= 2;
-			descriptorSetData->descriptorSetCache->inactiveDescriptorSets = SDL_realloc(
-				descriptorSetData->descriptorSetCache->inactiveDescriptorSets,
-				descriptorSetData->descriptorSetCache->inactiveDescriptorSetCapacity * sizeof(VkDescriptorSet)
-			);
-		}
+				if (originalResourceAccessType == RESOURCE_ACCESS_NONE)
+				{
+					continue;
+				}
 
-		descriptorSetData->descriptorSetCache->inactiveDescriptorSets[descriptorSetData->descriptorSetCache->inactiveDescriptorSetCount] = descriptorSetData->descriptorSet;
-		descriptorSetData->descriptorSetCache->inactiveDescriptorSetCount += 1;
+				VULKAN_INTERNAL_ImageMemoryBarrier(
+					renderer,
+					commandBuffer->commandBuffer,
+					originalResourceAccessType,
+					newTexture->aspectFlags,
+					layer,
+					1,
+					runStart,
+					level - runStart,
+					0,
+					newTexture
+				);
+			}
+		}
 
-		SDL_UnlockMutex(descriptorSetData->descriptorSetCache->lock);
-	}
+		SDL_stack_free(originalResourceAccessTypes);
+		SDL_stack_free(imageCopyRegions);
 
-	commandBuffer->boundDescriptorSetDataCount = 0;
+		VULKAN_INTERNAL_TrackTexture(renderer, commandBuffer, currentRegion->vulkanTexture);
+		VULKAN_INTERNAL_TrackTexture(renderer, commandBuffer, newTexture);
 
-	/* Decrement reference counts */
+		/* re-point original container to new texture */
+		newTexture->container = currentRegion->vulkanTexture->container;
+		newTexture->container->vulkanTexture = newTexture;
+		currentRegion->vulkanTexture->container = NULL;
 
-	for (i = 0; i < commandBuffer->usedBufferCount; i += 1)
-	{
-		SDL_AtomicDecRef(&commandBuffer->usedBuffers[i]->referenceCount);
+		VULKAN_INTERNAL_QueueDestroyTexture(renderer, currentRegion->vulkanTexture);
 	}
-	commandBuffer->usedBufferCount = 0;
 
-	for (i = 0; i < commandBuffer->usedTextureCount; i += 1)
-	{
-		SDL_AtomicDecRef(&commandBuffer->usedTextures[i]->referenceCount);
-	}
-	commandBuffer->usedTextureCount = 0;
+	currentRegion->defragMoved = 1;
+	return 1;
+}
 
-	for (i = 0; i < commandBuffer->usedSamplerCount; i += 1)
-	{
-		SDL_AtomicDecRef(&commandBuffer->usedSamplers[i]->referenceCount);
-	}
-	commandBuffer->usedSamplerCount = 0;
+/* Moves resources out of one memory block per call, bounded by the
+ * per-submit budget. The block stays unavailable for new allocations
+ * and is picked up again on the next submit until it is empty.
+ */
+static uint8_t VULKAN_INTERNAL_DefragmentMemory(
+	VulkanRenderer *renderer
+) {
+	VulkanMemoryAllocation *allocation;
+	VulkanMemoryUsedRegion *currentRegion;
+	VulkanCommandBuffer *commandBuffer;
+	VkDeviceSize bytesMoved = 0;
+	VkDeviceSize bytesRemaining = 0;
+	uint32_t resourcesMoved = 0;
+	uint32_t resourcesRemaining = 0;
+	uint8_t failed = 0;
+	uint32_t i;
 
-	for (i = 0; i < commandBuffer->usedGraphicsPipelineCount; i += 1)
-	{
-		SDL_AtomicDecRef(&commandBuffer->usedGraphicsPipelines[i]->referenceCount);
-	}
-	commandBuffer->usedGraphicsPipelineCount = 0;
+	renderer->defragInProgress = 1;
 
-	for (i = 0; i < commandBuffer->usedComputePipelineCount; i += 1)
+	SDL_LockMutex(renderer->allocatorLock);
+	allocation = renderer->defragAllocation;
+	if (allocation == NULL)
 	{
-		SDL_AtomicDecRef(&commandBuffer->usedComputePipelines[i]->referenceCount);
+		renderer->needDefrag = 0;
 	}
-	commandBuffer->usedComputePipelineCount = 0;
+	SDL_UnlockMutex(renderer->allocatorLock);
 
-	for (i = 0; i < commandBuffer->usedFramebufferCount; i += 1)
+	if (allocation == NULL)
 	{
-		SDL_AtomicDecRef(&commandBuffer->usedFramebuffers[i]->referenceCount);
-	}
-	commandBuffer->usedFramebufferCount = 0;
-
-	/* Reset presentation data */
-
-	commandBuffer->presentDataCount = 0;
-	commandBuffer->waitSemaphoreCount = 0;
-	commandBuffer->signalSemaphoreCount = 0;
-
-	/* Return command buffer to pool */
-
-	SDL_LockMutex(renderer->acquireCommandBufferLock);
+		if (!VULKAN_INTERNAL_FindAllocationToDefragment(
+			renderer,
+			&allocation
+		)) {
+			renderer->defragInProgress = 0;
+			return 1;
+		}
 
-	if (commandBuffer->commandPool->inactiveCommandBufferCount == commandBuffer->commandPool->inactiveCommandBufferCapacity)
-	{
-		commandBuffer->commandPool->inactiveCommandBufferCapacity += 1;
-		commandBuffer->commandPool->inactiveCommandBuffers = SDL_realloc(
-			commandBuffer->commandPool->inactiveCommandBuffers,
-			commandBuffer->commandPool->inactiveCommandBufferCapacity * sizeof(VulkanCommandBuffer*)
+		SDL_LockMutex(allocation->allocator->lock);
+		VULKAN_INTERNAL_MakeMemoryUnavailable(
+			renderer,
+			allocation
 		);
+		SDL_UnlockMutex(allocation->allocator->lock);
 	}
 
-	commandBuffer->commandPool->inactiveCommandBuffers[
-		commandBuffer->commandPool->inactiveCommandBufferCount
-	] = commandBuffer;
-	commandBuffer->commandPool->inactiveCommandBufferCount += 1;
+	commandBuffer = (VulkanCommandBuffer*) VULKAN_AcquireCommandBuffer((Refresh_Renderer *) renderer);
 
-	SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+	/* Only this block's type stays locked while we move resources.
+	 * Creating the replacements takes other sub-allocator locks inside it,
+	 * which is safe because every other path holds at most one of them.
+	 */
+	SDL_LockMutex(allocation->allocator->lock);
 
-	/* Remove this command buffer from the submitted list */
-	for (i = 0; i < renderer->submittedCommandBufferCount; i += 1)
+	/* For each used region in the allocation
+	 * create a new resource, copy the data
+	 * and re-point the resource containers
+	 */
+	for (i = 0; i < allocation->usedRegionCount; i += 1)
 	{
-		if (renderer->submittedCommandBuffers[i] == commandBuffer)
+		currentRegion = allocation->usedRegions[i];
+
+		if (currentRegion->defragMoved)
 		{
-			renderer->submittedCommandBuffers[i] = renderer->submittedCommandBuffers[renderer->submittedCommandBufferCount - 1];
-			renderer->submittedCommandBufferCount -= 1;
+			continue;
 		}
-	}
-}
 
-static void VULKAN_Wait(
-	Refresh_Renderer *driverData
-) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *commandBuffer;
-	VkResult result;
-	int32_t i;
+		/* always move at least one resource so large ones make progress */
+		if (	resourcesMoved > 0 &&
+			(	(renderer->defragBytesPerSubmit > 0 && bytesMoved + currentRegion->resourceSize > renderer->defragBytesPerSubmit) ||
+				(renderer->defragResourcesPerSubmit > 0 && resourcesMoved >= renderer->defragResourcesPerSubmit)	)	)
+		{
+			bytesRemaining += currentRegion->resourceSize;
+			resourcesRemaining += 1;
+			continue;
+		}
 
-	result = renderer->vkDeviceWaitIdle(renderer->logicalDevice);
+		if (!VULKAN_INTERNAL_DefragmentUsedRegion(
+			renderer,
+			commandBuffer,
+			currentRegion
+		)) {
+			/* Retrying would fail the same way every submit, give up on this block */
+			failed = 1;
+			break;
+		}
 
-	if (result != VK_SUCCESS)
+		bytesMoved += currentRegion->resourceSize;
+		resourcesMoved += 1;
+	}
+
+	allocation->allocator->defragBytesMoved += bytesMoved;
+	allocation->allocator->defragResourcesMoved += resourcesMoved;
+
+	if (failed)
 	{
-		LogVulkanResultAsError("vkDeviceWaitIdle", result);
-		return;
+		/* Resources already moved still free their regions as usual */
+		allocation->defragSkipped = 1;
+		VULKAN_INTERNAL_MakeMemoryAvailable(renderer, allocation);
+		bytesRemaining = 0;
+		resourcesRemaining = 0;
 	}
 
-	SDL_LockMutex(renderer->submitLock);
+	SDL_UnlockMutex(allocation->allocator->lock);
+
+	SDL_LockMutex(renderer->allocatorLock);
 
-	for (i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1)
+	renderer->defragAllocation = allocation;
+	renderer->defragBytesRemaining = bytesRemaining;
+	renderer->defragResourcesRemaining = resourcesRemaining;
+	renderer->defragTotalBytesMoved += bytesMoved;
+	renderer->defragTotalResourcesMoved += resourcesMoved;
+
+	if (resourcesRemaining == 0)
 	{
-		commandBuffer = renderer->submittedCommandBuffers[i];
-		VULKAN_INTERNAL_CleanCommandBuffer(renderer, commandBuffer);
+		/* Block is drained, it will be freed once the old resources
+		 * are destroyed. Look for another block after the timer.
+		 */
+		renderer->defragAllocation = NULL;
+		renderer->needDefrag = 1;
 	}
 
-	VULKAN_INTERNAL_PerformPendingDestroys(renderer);
+	renderer->defragTimestamp = SDL_GetTicks64() + DEFRAG_TIME;
 
-	SDL_UnlockMutex(renderer->submitLock);
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	VULKAN_Submit(
+		(Refresh_Renderer*) renderer,
+		(Refresh_CommandBuffer*) commandBuffer
+	);
+
+	renderer->defragInProgress = 0;
+
+	return 1;
 }
 
-static Refresh_Fence* VULKAN_SubmitAndAcquireFence(
+static void VULKAN_SetDefragmentationBudget(
 	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer
+	uint64_t maxBytesPerSubmit,
+	uint32_t maxResourcesPerSubmit
 ) {
-	VulkanCommandBuffer *vulkanCommandBuffer;
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
 
-	VULKAN_Submit(driverData, commandBuffer);
+	SDL_LockMutex(renderer->allocatorLock);
+	renderer->defragBytesPerSubmit = maxBytesPerSubmit;
+	renderer->defragResourcesPerSubmit = maxResourcesPerSubmit;
+	SDL_UnlockMutex(renderer->allocatorLock);
+}
 
-	vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	vulkanCommandBuffer->autoReleaseFence = 0;
+static void VULKAN_GetDefragmentationProgress(
+	Refresh_Renderer *driverData,
+	Refresh_DefragmentationProgress *progress
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
 
-	return (Refresh_Fence*) vulkanCommandBuffer->inFlightFence;
+	SDL_LockMutex(renderer->allocatorLock);
+	progress->inProgress = renderer->defragAllocation != NULL;
+	progress->bytesRemaining = renderer->defragBytesRemaining;
+	progress->resourcesRemaining = renderer->defragResourcesRemaining;
+	progress->totalBytesMoved = renderer->defragTotalBytesMoved;
+	progress->totalResourcesMoved = renderer->defragTotalResourcesMoved;
+	SDL_UnlockMutex(renderer->allocatorLock);
 }
 
-static void VULKAN_Submit(
+static uint32_t VULKAN_GetMemoryBudget(
 	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer
+	Refresh_MemoryHeapBudget *heapBudgets,
+	uint32_t heapBudgetCount
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
-	VkSubmitInfo submitInfo;
-	VkPresentInfoKHR presentInfo;
-	VulkanPresentData *presentData;
-	VkResult vulkanResult, presentResult = VK_SUCCESS;
-	VulkanCommandBuffer *vulkanCommandBuffer;
-	VkPipelineStageFlags waitStages[MAX_PRESENT_COUNT];
-	uint32_t swapchainImageIndex;
-	uint8_t commandBufferCleaned = 0;
-	VulkanMemorySubAllocator *allocator;
-	int32_t i, j;
-
-	SDL_LockMutex(renderer->submitLock);
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	uint32_t i;
 
-	/* FIXME: Can this just be permanent? */
-	for (i = 0; i < MAX_PRESENT_COUNT; i += 1)
+	if (heapBudgets == NULL)
 	{
-		waitStages[i] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		return renderer->memoryProperties.memoryHeapCount;
 	}
 
-	vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	SDL_LockMutex(renderer->allocatorLock);
 
-	for (j = 0; j < vulkanCommandBuffer->presentDataCount; j += 1)
-	{
-		swapchainImageIndex = vulkanCommandBuffer->presentDatas[j].swapchainImageIndex;
+	VULKAN_INTERNAL_QueryMemoryBudget(renderer);
 
-		VULKAN_INTERNAL_ImageMemoryBarrier(
-			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_PRESENT,
-			VK_IMAGE_ASPECT_COLOR_BIT,
-			0,
-			1,
-			0,
-			1,
-			0,
-			vulkanCommandBuffer->presentDatas[j].windowData->swapchainData->textureContainers[swapchainImageIndex].vulkanTexture->image,
-			&vulkanCommandBuffer->presentDatas[j].windowData->swapchainData->textureContainers[swapchainImageIndex].vulkanTexture->resourceAccessType
-		);
+	for (i = 0; i < heapBudgetCount && i < renderer->memoryProperties.memoryHeapCount; i += 1)
+	{
+		heapBudgets[i].budget = renderer->heapBudget[i];
+		heapBudgets[i].usage = VULKAN_INTERNAL_GetHeapUsage(renderer, i);
+		heapBudgets[i].size = renderer->memoryProperties.memoryHeaps[i].size;
+		heapBudgets[i].isDeviceLocal =
+			(renderer->memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
 	}
 
-	VULKAN_INTERNAL_EndCommandBuffer(renderer, vulkanCommandBuffer);
-
-	vulkanCommandBuffer->autoReleaseFence = 1;
-	vulkanCommandBuffer->inFlightFence = VULKAN_INTERNAL_AcquireFenceFromPool(renderer);
-
-	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-	submitInfo.pNext = NULL;
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers = &vulkanCommandBuffer->commandBuffer;
+	SDL_UnlockMutex(renderer->allocatorLock);
 
-	submitInfo.pWaitDstStageMask = waitStages;
-	submitInfo.pWaitSemaphores = vulkanCommandBuffer->waitSemaphores;
-	submitInfo.waitSemaphoreCount = vulkanCommandBuffer->waitSemaphoreCount;
-	submitInfo.pSignalSemaphores = vulkanCommandBuffer->signalSemaphores;
-	submitInfo.signalSemaphoreCount = vulkanCommandBuffer->signalSemaphoreCount;
+	return renderer->memoryProperties.memoryHeapCount;
+}
 
-	vulkanResult = renderer->vkQueueSubmit(
-		renderer->unifiedQueue,
-		1,
-		&submitInfo,
-		vulkanCommandBuffer->inFlightFence
-	);
+static void VULKAN_SetMemoryPressureCallback(
+	Refresh_Renderer *driverData,
+	Refresh_MemoryPressureFunc callback,
+	const float *thresholds,
+	uint32_t thresholdCount,
+	void *userdata
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	uint32_t i;
 
-	if (vulkanResult != VK_SUCCESS)
+	if (thresholdCount > MAX_MEMORY_PRESSURE_THRESHOLDS)
 	{
-		LogVulkanResultAsError("vkQueueSubmit", vulkanResult);
+		Refresh_LogWarn(
+			"Only %d memory pressure thresholds are supported, ignoring the rest",
+			MAX_MEMORY_PRESSURE_THRESHOLDS
+		);
+		thresholdCount = MAX_MEMORY_PRESSURE_THRESHOLDS;
 	}
 
-	/* Mark command buffers as submitted */
+	SDL_LockMutex(renderer->allocatorLock);
 
-	if (renderer->submittedCommandBufferCount + 1 >= renderer->submittedCommandBufferCapacity)
+	renderer->memoryPressureCallback = callback;
+	renderer->memoryPressureUserdata = userdata;
+	renderer->memoryPressureThresholdCount = (callback != NULL) ? thresholdCount : 0;
+
+	for (i = 0; i < renderer->memoryPressureThresholdCount; i += 1)
 	{
-		renderer->submittedCommandBufferCapacity = renderer->submittedCommandBufferCount + 1;
+		renderer->memoryPressureThresholds[i] = thresholds[i];
+	}
 
-		renderer->submittedCommandBuffers = SDL_realloc(
-			renderer->submittedCommandBuffers,
-			sizeof(VulkanCommandBuffer*) * renderer->submittedCommandBufferCapacity
-		);
+	/* new thresholds, so report the current level on the next submit */
+	for (i = 0; i < VK_MAX_MEMORY_HEAPS; i += 1)
+	{
+		renderer->memoryPressureLevels[i] = 0;
 	}
 
-	renderer->submittedCommandBuffers[renderer->submittedCommandBufferCount] = vulkanCommandBuffer;
-	renderer->submittedCommandBufferCount += 1;
+	SDL_UnlockMutex(renderer->allocatorLock);
+}
 
-	/* Present, if applicable */
+static void VULKAN_SetMemoryRetentionPolicy(
+	Refresh_Renderer *driverData,
+	uint32_t maxRetainedBlocks,
+	uint32_t releaseAfterSubmits,
+	uint32_t releaseAfterMilliseconds
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
 
-	for (j = 0; j < vulkanCommandBuffer->presentDataCount; j += 1)
-	{
-		presentData = &vulkanCommandBuffer->presentDatas[j];
+	SDL_LockMutex(renderer->allocatorLock);
+	renderer->retainedEmptyBlocksPerType = maxRetainedBlocks;
+	renderer->emptyBlockReleaseSubmits = releaseAfterSubmits;
+	renderer->emptyBlockReleaseMilliseconds = releaseAfterMilliseconds;
+	SDL_UnlockMutex(renderer->allocatorLock);
+}
 
-		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-		presentInfo.pNext = NULL;
-		presentInfo.pWaitSemaphores = &presentData->windowData->swapchainData->renderFinishedSemaphore;
-		presentInfo.waitSemaphoreCount = 1;
-		presentInfo.pSwapchains = &presentData->windowData->swapchainData->swapchain;
-		presentInfo.swapchainCount = 1;
-		presentInfo.pImageIndices = &presentData->swapchainImageIndex;
-		presentInfo.pResults = NULL;
+static void VULKAN_INTERNAL_GetMemoryTypeStatistics(
+	VulkanRenderer *renderer,
+	uint32_t memoryTypeIndex,
+	Refresh_MemoryTypeStatistics *statistics
+) {
+	VulkanMemorySubAllocator *allocator = &renderer->memoryAllocator->subAllocators[memoryTypeIndex];
+	VkMemoryPropertyFlags propertyFlags = renderer->memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
+	VulkanMemoryAllocation *allocation;
+	VkDeviceSize freeBytes;
+	uint32_t i, j;
 
-		presentResult = renderer->vkQueuePresentKHR(
-			renderer->unifiedQueue,
-			&presentInfo
-		);
+	SDL_zerop(statistics);
 
-		if (presentResult != VK_SUCCESS)
-		{
-			VULKAN_INTERNAL_RecreateSwapchain(
-				renderer,
-				presentData->windowData
-			);
-		}
-	}
+	statistics->heapIndex = renderer->memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+	statistics->isDeviceLocal = (propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0;
+	statistics->isHostVisible = (propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
 
-	/* Check if we can perform any cleanups */
+	SDL_LockMutex(allocator->lock);
 
-	for (i = renderer->submittedCommandBufferCount - 1; i >= 0; i -= 1)
+	statistics->blockCount = allocator->allocationCount;
+	statistics->defragBytesMoved = allocator->defragBytesMoved;
+	statistics->defragResourcesMoved = allocator->defragResourcesMoved;
+
+	for (i = 0; i < allocator->allocationCount; i += 1)
 	{
-		vulkanResult = renderer->vkGetFenceStatus(
-			renderer->logicalDevice,
-			renderer->submittedCommandBuffers[i]->inFlightFence
-		);
+		allocation = allocator->allocations[i];
 
-		if (vulkanResult == VK_SUCCESS)
-		{
-			VULKAN_INTERNAL_CleanCommandBuffer(
-				renderer,
-				renderer->submittedCommandBuffers[i]
-			);
+		statistics->blockBytes += allocation->size;
+		statistics->usedBytes += allocation->usedSpace;
+		statistics->usedRegionCount += allocation->usedRegionCount;
 
-			commandBufferCleaned = 1;
+		if (allocation->dedicated)
+		{
+			statistics->dedicatedBlockCount += 1;
 		}
-	}
-
-	if (commandBufferCleaned)
-	{
-		SDL_LockMutex(renderer->allocatorLock);
 
-		for (i = 0; i < VK_MAX_MEMORY_TYPES; i += 1)
+		/* the tail of an arena block is its only free region */
+		if (allocation->transient)
 		{
-			allocator = &renderer->memoryAllocator->subAllocators[i];
+			statistics->transientBlockCount += 1;
+
+			freeBytes = allocation->size - allocation->transientOffset;
+			statistics->freeBytes += freeBytes;
 
-			for (j = allocator->allocationCount - 1; j >= 0; j -= 1)
+			if (freeBytes > 0)
 			{
-				if (allocator->allocations[j]->usedRegionCount == 0)
-				{
-					VULKAN_INTERNAL_DeallocateMemory(
-						renderer,
-						allocator,
-						j
-					);
-				}
+				statistics->freeRegionCount += 1;
+				statistics->largestFreeRegion = SDL_max(statistics->largestFreeRegion, freeBytes);
 			}
-		}
-
-		SDL_UnlockMutex(renderer->allocatorLock);
-	}
 
-	/* Check pending destroys */
+			continue;
+		}
 
-	VULKAN_INTERNAL_PerformPendingDestroys(renderer);
+		statistics->freeBytes += allocation->freeSpace;
+		statistics->freeRegionCount += allocation->freeRegionCount;
 
-	/* Defrag! */
-	if (renderer->needDefrag && !renderer->defragInProgress)
-	{
-		if (SDL_GetTicks64() >= renderer->defragTimestamp)
+		for (j = 0; j < allocation->freeRegionCount; j += 1)
 		{
-			VULKAN_INTERNAL_DefragmentMemory(renderer);
+			statistics->largestFreeRegion = SDL_max(
+				statistics->largestFreeRegion,
+				allocation->freeRegions[j]->size
+			);
 		}
 	}
 
-	SDL_UnlockMutex(renderer->submitLock);
+	SDL_UnlockMutex(allocator->lock);
 }
 
-static uint8_t VULKAN_INTERNAL_DefragmentMemory(
-	VulkanRenderer *renderer
+static uint32_t VULKAN_GetMemoryStatistics(
+	Refresh_Renderer *driverData,
+	Refresh_MemoryTypeStatistics *statistics,
+	uint32_t statisticsCount
 ) {
-	VulkanMemorySubAllocator allocator;
-	VulkanMemoryAllocation *allocation;
-	uint32_t allocationIndexToDefrag;
-	VulkanMemoryUsedRegion *currentRegion;
-	VulkanBuffer* newBuffer;
-	VulkanTexture* newTexture;
-	VkBufferCopy bufferCopy;
-	VkImageCopy *imageCopyRegions;
-	VulkanCommandBuffer *commandBuffer;
-	uint32_t i, level;
-	VulkanResourceAccessType copyResourceAccessType = RESOURCE_ACCESS_NONE;
-	VulkanResourceAccessType originalResourceAccessType;
-
-	SDL_LockMutex(renderer->allocatorLock);
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	uint32_t i;
 
-	renderer->needDefrag = 0;
-	renderer->defragInProgress = 1;
+	if (statistics == NULL)
+	{
+		return renderer->memoryProperties.memoryTypeCount;
+	}
 
-	commandBuffer = (VulkanCommandBuffer*) VULKAN_AcquireCommandBuffer((Refresh_Renderer *) renderer);
+	for (i = 0; i < statisticsCount && i < renderer->memoryProperties.memoryTypeCount; i += 1)
+	{
+		VULKAN_INTERNAL_GetMemoryTypeStatistics(
+			renderer,
+			i,
+			&statistics[i]
+		);
+	}
 
-	if (VULKAN_INTERNAL_FindAllocationToDefragment(
-		renderer,
-		&allocator,
-		&allocationIndexToDefrag
-	)) {
-		allocation = allocator.allocations[allocationIndexToDefrag];
+	return renderer->memoryProperties.memoryTypeCount;
+}
 
-		VULKAN_INTERNAL_MakeMemoryUnavailable(
-			renderer,
-			allocation
+typedef struct VulkanStringBuilder
+{
+	char *data;
+	size_t length;
+	size_t capacity;
+	uint8_t failed;
+} VulkanStringBuilder;
+
+static void VULKAN_INTERNAL_AppendString(
+	VulkanStringBuilder *builder,
+	const char *fmt,
+	...
+) {
+	va_list ap;
+	char *newData;
+	int written;
+
+	while (!builder->failed)
+	{
+		va_start(ap, fmt);
+		written = SDL_vsnprintf(
+			builder->data + builder->length,
+			builder->capacity - builder->length,
+			fmt,
+			ap
 		);
+		va_end(ap);
 
-		/* For each used region in the allocation
-		 * create a new resource, copy the data
-		 * and re-point the resource containers
-		 */
-		for (i = 0; i < allocation->usedRegionCount; i += 1)
+		if (written < 0)
 		{
-			currentRegion = allocation->usedRegions[i];
-			copyResourceAccessType = RESOURCE_ACCESS_NONE;
+			builder->failed = 1;
+			return;
+		}
 
-			if (currentRegion->isBuffer)
-			{
-				currentRegion->vulkanBuffer->usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		if ((size_t) written < builder->capacity - builder->length)
+		{
+			builder->length += written;
+			return;
+		}
 
-				newBuffer = VULKAN_INTERNAL_CreateBuffer(
-					renderer,
-					currentRegion->vulkanBuffer->size,
-					RESOURCE_ACCESS_NONE,
-					currentRegion->vulkanBuffer->usage,
-					currentRegion->vulkanBuffer->requireHostVisible,
-					currentRegion->vulkanBuffer->preferDeviceLocal,
-					0
-				);
+		/* didn't fit, grow and format again */
+		newData = SDL_realloc(builder->data, builder->capacity * 2 + written);
+		if (newData == NULL)
+		{
+			builder->failed = 1;
+			return;
+		}
 
-				if (newBuffer == NULL)
-				{
-					Refresh_LogError("Failed to create defrag buffer!");
-					return 0;
-				}
+		builder->data = newData;
+		builder->capacity = builder->capacity * 2 + written;
+	}
+}
+
+static char* VULKAN_BuildMemoryStatisticsString(
+	Refresh_Renderer *driverData
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanStringBuilder builder;
+	Refresh_MemoryTypeStatistics statistics;
+	VulkanMemorySubAllocator *allocator;
+	VulkanMemoryAllocation *allocation;
+	VulkanMemoryUsedRegion *usedRegion;
+	VulkanMemoryFreeRegion *freeRegion;
+	uint32_t i, j, k;
 
-				originalResourceAccessType = currentRegion->vulkanBuffer->resourceAccessType;
+	builder.capacity = 4096;
+	builder.length = 0;
+	builder.failed = 0;
+	builder.data = SDL_malloc(builder.capacity);
 
-				VULKAN_INTERNAL_BufferMemoryBarrier(
-					renderer,
-					commandBuffer->commandBuffer,
-					RESOURCE_ACCESS_TRANSFER_READ,
-					currentRegion->vulkanBuffer
-				);
+	if (builder.data == NULL)
+	{
+		return NULL;
+	}
+
+	builder.data[0] = '\0';
+
+	VULKAN_INTERNAL_AppendString(&builder, "{\n\t\"memoryTypes\": [");
+
+	for (i = 0; i < renderer->memoryProperties.memoryTypeCount; i += 1)
+	{
+		allocator = &renderer->memoryAllocator->subAllocators[i];
 
-				VULKAN_INTERNAL_BufferMemoryBarrier(
-					renderer,
-					commandBuffer->commandBuffer,
-					RESOURCE_ACCESS_TRANSFER_WRITE,
-					newBuffer
-				);
+		VULKAN_INTERNAL_GetMemoryTypeStatistics(renderer, i, &statistics);
+
+		VULKAN_INTERNAL_AppendString(
+			&builder,
+			"%s\n\t\t{\n"
+			"\t\t\t\"index\": %u,\n"
+			"\t\t\t\"heapIndex\": %u,\n"
+			"\t\t\t\"propertyFlags\": %u,\n"
+			"\t\t\t\"blockCount\": %u,\n"
+			"\t\t\t\"dedicatedBlockCount\": %u,\n"
+			"\t\t\t\"transientBlockCount\": %u,\n"
+			"\t\t\t\"blockBytes\": %llu,\n"
+			"\t\t\t\"usedBytes\": %llu,\n"
+			"\t\t\t\"freeBytes\": %llu,\n"
+			"\t\t\t\"largestFreeRegion\": %llu,\n"
+			"\t\t\t\"usedRegionCount\": %u,\n"
+			"\t\t\t\"freeRegionCount\": %u,\n"
+			"\t\t\t\"defragBytesMoved\": %llu,\n"
+			"\t\t\t\"defragResourcesMoved\": %u,\n"
+			"\t\t\t\"blocks\": [",
+			(i > 0) ? "," : "",
+			i,
+			statistics.heapIndex,
+			renderer->memoryProperties.memoryTypes[i].propertyFlags,
+			statistics.blockCount,
+			statistics.dedicatedBlockCount,
+			statistics.transientBlockCount,
+			(unsigned long long) statistics.blockBytes,
+			(unsigned long long) statistics.usedBytes,
+			(unsigned long long) statistics.freeBytes,
+			(unsigned long long) statistics.largestFreeRegion,
+			statistics.usedRegionCount,
+			statistics.freeRegionCount,
+			(unsigned long long) statistics.defragBytesMoved,
+			statistics.defragResourcesMoved
+		);
 
-				bufferCopy.srcOffset = 0;
-				bufferCopy.dstOffset = 0;
-				bufferCopy.size = currentRegion->resourceSize;
+		SDL_LockMutex(allocator->lock);
 
-				renderer->vkCmdCopyBuffer(
-					commandBuffer->commandBuffer,
-					currentRegion->vulkanBuffer->buffer,
-					newBuffer->buffer,
-					1,
-					&bufferCopy
-				);
+		for (j = 0; j < allocator->allocationCount; j += 1)
+		{
+			allocation = allocator->allocations[j];
+
+			VULKAN_INTERNAL_AppendString(
+				&builder,
+				"%s\n\t\t\t\t{\n"
+				"\t\t\t\t\t\"size\": %llu,\n"
+				"\t\t\t\t\t\"usedBytes\": %llu,\n"
+				"\t\t\t\t\t\"dedicated\": %s,\n"
+				"\t\t\t\t\t\"transient\": %s,\n"
+				"\t\t\t\t\t\"aliased\": %s,\n"
+				"\t\t\t\t\t\"availableForAllocation\": %s,\n"
+				"\t\t\t\t\t\"usedRegions\": [",
+				(j > 0) ? "," : "",
+				(unsigned long long) allocation->size,
+				(unsigned long long) allocation->usedSpace,
+				allocation->dedicated ? "true" : "false",
+				allocation->transient ? "true" : "false",
+				allocation->aliased ? "true" : "false",
+				allocation->availableForAllocation ? "true" : "false"
+			);
 
-				VULKAN_INTERNAL_BufferMemoryBarrier(
-					renderer,
-					commandBuffer->commandBuffer,
-					originalResourceAccessType,
-					newBuffer
+			/* arena and aliased blocks don't keep their used regions */
+			for (k = 0; !allocation->transient && !allocation->aliased && k < allocation->usedRegionCount; k += 1)
+			{
+				usedRegion = allocation->usedRegions[k];
+
+				VULKAN_INTERNAL_AppendString(
+					&builder,
+					"%s\n\t\t\t\t\t\t{ \"offset\": %llu, \"size\": %llu, \"resourceSize\": %llu, \"type\": \"%s\" }",
+					(k > 0) ? "," : "",
+					(unsigned long long) usedRegion->offset,
+					(unsigned long long) usedRegion->size,
+					(unsigned long long) usedRegion->resourceSize,
+					usedRegion->isBuffer ? "buffer" : "texture"
 				);
+			}
 
-				VULKAN_INTERNAL_TrackBuffer(renderer, commandBuffer, currentRegion->vulkanBuffer);
-				VULKAN_INTERNAL_TrackBuffer(renderer, commandBuffer, newBuffer);
+			VULKAN_INTERNAL_AppendString(&builder, "\n\t\t\t\t\t],\n\t\t\t\t\t\"freeRegions\": [");
 
-				/* re-point original container to new buffer */
-				if (currentRegion->vulkanBuffer->container != NULL)
+			if (allocation->transient)
+			{
+				if (allocation->transientOffset < allocation->size)
 				{
-					newBuffer->container = currentRegion->vulkanBuffer->container;
-					newBuffer->container->vulkanBuffer = newBuffer;
-					currentRegion->vulkanBuffer->container = NULL;
+					VULKAN_INTERNAL_AppendString(
+						&builder,
+						"\n\t\t\t\t\t\t{ \"offset\": %llu, \"size\": %llu }",
+						(unsigned long long) allocation->transientOffset,
+						(unsigned long long) (allocation->size - allocation->transientOffset)
+					);
 				}
-
-				VULKAN_INTERNAL_QueueDestroyBuffer(renderer, currentRegion->vulkanBuffer);
-
-				renderer->needDefrag = 1;
 			}
 			else
 			{
-				newTexture = VULKAN_INTERNAL_CreateTexture(
-					renderer,
-					currentRegion->vulkanTexture->dimensions.width,
-					currentRegion->vulkanTexture->dimensions.height,
-					currentRegion->vulkanTexture->depth,
-					currentRegion->vulkanTexture->isCube,
-					currentRegion->vulkanTexture->levelCount,
-					currentRegion->vulkanTexture->sampleCount,
-					currentRegion->vulkanTexture->format,
-					currentRegion->vulkanTexture->aspectFlags,
-					currentRegion->vulkanTexture->usageFlags
-				);
-
-				if (newTexture == NULL)
-				{
-					Refresh_LogError("Failed to create defrag texture!");
-					return 0;
-				}
-
-				originalResourceAccessType = currentRegion->vulkanTexture->resourceAccessType;
-
-				VULKAN_INTERNAL_ImageMemoryBarrier(
-					renderer,
-					commandBuffer->commandBuffer,
-					RESOURCE_ACCESS_TRANSFER_READ,
-					currentRegion->vulkanTexture->aspectFlags,
-					0,
-					currentRegion->vulkanTexture->layerCount,
-					0,
-					currentRegion->vulkanTexture->levelCount,
-					0,
-					currentRegion->vulkanTexture->image,
-					&currentRegion->vulkanTexture->resourceAccessType
-				);
-
-				VULKAN_INTERNAL_ImageMemoryBarrier(
-					renderer,
-					commandBuffer->commandBuffer,
-					RESOURCE_ACCESS_TRANSFER_WRITE,
-					currentRegion->vulkanTexture->aspectFlags,
-					0,
-					currentRegion->vulkanTexture->layerCount,
-					0,
-					currentRegion->vulkanTexture->levelCount,
-					0,
-					newTexture->image,
-					&copyResourceAccessType
-				);
-
-				imageCopyRegions = SDL_stack_alloc(VkImageCopy, currentRegion->vulkanTexture->levelCount);
-
-				for (level = 0; level < currentRegion->vulkanTexture->levelCount; level += 1)
+				for (k = 0; k < allocation->freeRegionCount; k += 1)
 				{
-					imageCopyRegions[level].srcOffset.x = 0;
-					imageCopyRegions[level].srcOffset.y = 0;
-					imageCopyRegions[level].srcOffset.z = 0;
-					imageCopyRegions[level].srcSubresource.aspectMask = currentRegion->vulkanTexture->aspectFlags;
-					imageCopyRegions[level].srcSubresource.baseArrayLayer = 0;
-					imageCopyRegions[level].srcSubresource.layerCount = currentRegion->vulkanTexture->layerCount;
-					imageCopyRegions[level].srcSubresource.mipLevel = level;
-					imageCopyRegions[level].extent.width = SDL_max(1, currentRegion->vulkanTexture->dimensions.width >> level);
-					imageCopyRegions[level].extent.height = SDL_max(1, currentRegion->vulkanTexture->dimensions.height >> level);
-					imageCopyRegions[level].extent.depth = currentRegion->vulkanTexture->depth;
-					imageCopyRegions[level].dstOffset.x = 0;
-					imageCopyRegions[level].dstOffset.y = 0;
-					imageCopyRegions[level].dstOffset.z = 0;
-					imageCopyRegions[level].dstSubresource.aspectMask = currentRegion->vulkanTexture->aspectFlags;
-					imageCopyRegions[level].dstSubresource.baseArrayLayer = 0;
-					imageCopyRegions[level].dstSubresource.layerCount = currentRegion->vulkanTexture->layerCount;
-					imageCopyRegions[level].dstSubresource.mipLevel = level;
+					freeRegion = allocation->freeRegions[k];
+
+					VULKAN_INTERNAL_AppendString(
+						&builder,
+						"%s\n\t\t\t\t\t\t{ \"offset\": %llu, \"size\": %llu }",
+						(k > 0) ? "," : "",
+						(unsigned long long) freeRegion->offset,
+						(unsigned long long) freeRegion->size
+					);
 				}
+			}
 
-				renderer->vkCmdCopyImage(
-					commandBuffer->commandBuffer,
-					currentRegion->vulkanTexture->image,
-					AccessMap[currentRegion->vulkanTexture->resourceAccessType].imageLayout,
-					newTexture->image,
-					AccessMap[copyResourceAccessType].imageLayout,
-					currentRegion->vulkanTexture->levelCount,
-					imageCopyRegions
-				);
-
-				VULKAN_INTERNAL_ImageMemoryBarrier(
-					renderer,
-					commandBuffer->commandBuffer,
-					originalResourceAccessType,
-					currentRegion->vulkanTexture->aspectFlags,
-					0,
-					currentRegion->vulkanTexture->layerCount,
-					0,
-					currentRegion->vulkanTexture->levelCount,
-					0,
-					newTexture->image,
-					&copyResourceAccessType
-				);
-
-				SDL_stack_free(imageCopyRegions);
-
-				VULKAN_INTERNAL_TrackTexture(renderer, commandBuffer, currentRegion->vulkanTexture);
-				VULKAN_INTERNAL_TrackTexture(renderer, commandBuffer, newTexture);
-
-				/* re-point original container to new texture */
-				newTexture->container = currentRegion->vulkanTexture->container;
-				newTexture->container->vulkanTexture = newTexture;
-				currentRegion->vulkanTexture->container = NULL;
+			VULKAN_INTERNAL_AppendString(&builder, "\n\t\t\t\t\t]\n\t\t\t\t}");
+		}
 
-				VULKAN_INTERNAL_QueueDestroyTexture(renderer, currentRegion->vulkanTexture);
+		SDL_UnlockMutex(allocator->lock);
 
-				renderer->needDefrag = 1;
-			}
-		}
+		VULKAN_INTERNAL_AppendString(&builder, "\n\t\t\t]\n\t\t}");
 	}
 
+	SDL_LockMutex(renderer->allocatorLock);
+	VULKAN_INTERNAL_AppendString(
+		&builder,
+		"\n\t],\n\t\"defragmentation\": {\n"
+		"\t\t\"inProgress\": %s,\n"
+		"\t\t\"bytesRemaining\": %llu,\n"
+		"\t\t\"resourcesRemaining\": %u,\n"
+		"\t\t\"totalBytesMoved\": %llu,\n"
+		"\t\t\"totalResourcesMoved\": %u\n"
+		"\t}\n}\n",
+		(renderer->defragAllocation != NULL) ? "true" : "false",
+		(unsigned long long) renderer->defragBytesRemaining,
+		renderer->defragResourcesRemaining,
+		(unsigned long long) renderer->defragTotalBytesMoved,
+		renderer->defragTotalResourcesMoved
+	);
 	SDL_UnlockMutex(renderer->allocatorLock);
 
-	renderer->defragTimestamp = SDL_GetTicks64() + DEFRAG_TIME;
+	if (builder.failed)
+	{
+		SDL_free(builder.data);
+		return NULL;
+	}
 
-	VULKAN_Submit(
-		(Refresh_Renderer*) renderer,
-		(Refresh_CommandBuffer*) commandBuffer
-	);
+	return builder.data;
+}
 
-	renderer->defragInProgress = 0;
+static void VULKAN_SetUploadRingSize(
+	Refresh_Renderer *driverData,
+	uint32_t sizeInBytes
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
 
-	return 1;
+	SDL_LockMutex(renderer->uploadRing.lock);
+	renderer->uploadRing.requestedSize = sizeInBytes;
+	VULKAN_INTERNAL_RetireUploadRingRanges(renderer, NULL);
+	SDL_UnlockMutex(renderer->uploadRing.lock);
 }
 
 static void VULKAN_WaitForFences(
@@ -10864,8 +16650,11 @@ static inline uint8_t CheckDeviceExtensions(
 		CHECK(KHR_swapchain)
 		else CHECK(KHR_maintenance1)
 		else CHECK(KHR_get_memory_requirements2)
+		else CHECK(KHR_bind_memory2)
+		else CHECK(KHR_sampler_ycbcr_conversion)
 		else CHECK(KHR_driver_properties)
 		else CHECK(EXT_vertex_attribute_divisor)
+		else CHECK(EXT_memory_budget)
 		else CHECK(KHR_portability_subset)
 		#undef CHECK
 	}
@@ -10881,8 +16670,11 @@ static inline uint32_t GetDeviceExtensionCount(VulkanExtensions *supports)
 		supports->KHR_swapchain +
 		supports->KHR_maintenance1 +
 		supports->KHR_get_memory_requirements2 +
+		supports->KHR_bind_memory2 +
+		supports->KHR_sampler_ycbcr_conversion +
 		supports->KHR_driver_properties +
 		supports->EXT_vertex_attribute_divisor +
+		supports->EXT_memory_budget +
 		supports->KHR_portability_subset
 	);
 }
@@ -10900,8 +16692,11 @@ static inline void CreateDeviceExtensionArray(
 	CHECK(KHR_swapchain)
 	CHECK(KHR_maintenance1)
 	CHECK(KHR_get_memory_requirements2)
+	CHECK(KHR_bind_memory2)
+	CHECK(KHR_sampler_ycbcr_conversion)
 	CHECK(KHR_driver_properties)
 	CHECK(EXT_vertex_attribute_divisor)
+	CHECK(EXT_memory_budget)
 	CHECK(KHR_portability_subset)
 	#undef CHECK
 }
@@ -11472,19 +17267,70 @@ static uint8_t VULKAN_INTERNAL_CreateLogicalDevice(
 	VkResult vulkanResult;
 	VkDeviceCreateInfo deviceCreateInfo;
 	VkPhysicalDeviceFeatures deviceFeatures;
+	VkPhysicalDeviceFeatures2 supportedFeatures;
+	VkPhysicalDeviceSamplerYcbcrConversionFeatures ycbcrFeatures;
 	VkPhysicalDevicePortabilitySubsetFeaturesKHR portabilityFeatures;
 	const char **deviceExtensions;
 
-	VkDeviceQueueCreateInfo queueCreateInfo;
+	VkDeviceQueueCreateInfo queueCreateInfos[2];
+	uint32_t queueCreateInfoCount = 1;
 	float queuePriority = 1.0f;
+	VkQueueFamilyProperties *queueProps;
+	uint32_t queueFamilyCount;
+	uint32_t i;
 
-	queueCreateInfo.sType =
+	queueCreateInfos[0].sType =
 		VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-	queueCreateInfo.pNext = NULL;
-	queueCreateInfo.flags = 0;
-	queueCreateInfo.queueFamilyIndex = renderer->queueFamilyIndex;
-	queueCreateInfo.queueCount = 1;
-	queueCreateInfo.pQueuePriorities = &queuePriority;
+	queueCreateInfos[0].pNext = NULL;
+	queueCreateInfos[0].flags = 0;
+	queueCreateInfos[0].queueFamilyIndex = renderer->queueFamilyIndex;
+	queueCreateInfos[0].queueCount = 1;
+	queueCreateInfos[0].pQueuePriorities = &queuePriority;
+
+	/* Look for a transfer-only family, usually a DMA engine, for async uploads.
+	 * Uploads can target any texel, so the family must not have a
+	 * coarser transfer granularity than a single texel.
+	 */
+
+	renderer->transferQueueFamilyIndex = renderer->queueFamilyIndex;
+
+	renderer->vkGetPhysicalDeviceQueueFamilyProperties(
+		renderer->physicalDevice,
+		&queueFamilyCount,
+		NULL
+	);
+	queueProps = SDL_stack_alloc(
+		VkQueueFamilyProperties,
+		queueFamilyCount
+	);
+	renderer->vkGetPhysicalDeviceQueueFamilyProperties(
+		renderer->physicalDevice,
+		&queueFamilyCount,
+		queueProps
+	);
+
+	for (i = 0; i < queueFamilyCount; i += 1)
+	{
+		if (	queueProps[i].queueCount > 0 &&
+			(queueProps[i].queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+			!(queueProps[i].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) &&
+			queueProps[i].minImageTransferGranularity.width == 1 &&
+			queueProps[i].minImageTransferGranularity.height == 1 &&
+			queueProps[i].minImageTransferGranularity.depth == 1	)
+		{
+			renderer->transferQueueFamilyIndex = i;
+			break;
+		}
+	}
+
+	SDL_stack_free(queueProps);
+
+	if (renderer->transferQueueFamilyIndex != renderer->queueFamilyIndex)
+	{
+		queueCreateInfos[1] = queueCreateInfos[0];
+		queueCreateInfos[1].queueFamilyIndex = renderer->transferQueueFamilyIndex;
+		queueCreateInfoCount = 2;
+	}
 
 	/* specifying used device features */
 
@@ -11494,13 +17340,46 @@ static uint8_t VULKAN_INTERNAL_CreateLogicalDevice(
 	deviceFeatures.multiDrawIndirect = VK_TRUE;
 	deviceFeatures.independentBlend = VK_TRUE;
 
+	/* Multi-planar textures need the conversion extension, its
+	 * dependencies, and the feature itself. Otherwise leave it off and
+	 * let YUV uploads go to separate R8 textures.
+	 */
+	if (renderer->supports.KHR_sampler_ycbcr_conversion)
+	{
+		ycbcrFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SAMPLER_YCBCR_CONVERSION_FEATURES;
+		ycbcrFeatures.pNext = NULL;
+		ycbcrFeatures.samplerYcbcrConversion = VK_FALSE;
+
+		supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		supportedFeatures.pNext = &ycbcrFeatures;
+
+		renderer->vkGetPhysicalDeviceFeatures2KHR(
+			renderer->physicalDevice,
+			&supportedFeatures
+		);
+
+		if (	!ycbcrFeatures.samplerYcbcrConversion ||
+			!renderer->supports.KHR_bind_memory2 ||
+			!renderer->supports.KHR_get_memory_requirements2	)
+		{
+			renderer->supports.KHR_sampler_ycbcr_conversion = 0;
+		}
+	}
+
 	/* creating the logical device */
 
 	deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+	deviceCreateInfo.pNext = NULL;
+	if (renderer->supports.KHR_sampler_ycbcr_conversion)
+	{
+		ycbcrFeatures.pNext = NULL;
+		ycbcrFeatures.samplerYcbcrConversion = VK_TRUE;
+		deviceCreateInfo.pNext = &ycbcrFeatures;
+	}
 	if (renderer->supports.KHR_portability_subset)
 	{
 		portabilityFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PORTABILITY_SUBSET_FEATURES_KHR;
-		portabilityFeatures.pNext = NULL;
+		portabilityFeatures.pNext = (void*) deviceCreateInfo.pNext;
 		portabilityFeatures.constantAlphaColorBlendFactors = VK_FALSE;
 		portabilityFeatures.events = VK_FALSE;
 		portabilityFeatures.imageViewFormatReinterpretation = VK_FALSE;
@@ -11518,13 +17397,9 @@ static uint8_t VULKAN_INTERNAL_CreateLogicalDevice(
 		portabilityFeatures.vertexAttributeAccessBeyondStride = VK_FALSE;
 		deviceCreateInfo.pNext = &portabilityFeatures;
 	}
-	else
-	{
-		deviceCreateInfo.pNext = NULL;
-	}
 	deviceCreateInfo.flags = 0;
-	deviceCreateInfo.queueCreateInfoCount = 1;
-	deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+	deviceCreateInfo.queueCreateInfoCount = queueCreateInfoCount;
+	deviceCreateInfo.pQueueCreateInfos = queueCreateInfos;
 	deviceCreateInfo.enabledLayerCount = 0;
 	deviceCreateInfo.ppEnabledLayerNames = NULL;
 	deviceCreateInfo.enabledExtensionCount = GetDeviceExtensionCount(
@@ -11564,9 +17439,202 @@ static uint8_t VULKAN_INTERNAL_CreateLogicalDevice(
 		&renderer->unifiedQueue
 	);
 
+	if (renderer->transferQueueFamilyIndex != renderer->queueFamilyIndex)
+	{
+		renderer->vkGetDeviceQueue(
+			renderer->logicalDevice,
+			renderer->transferQueueFamilyIndex,
+			0,
+			&renderer->transferQueue
+		);
+	}
+	else
+	{
+		renderer->transferQueue = renderer->unifiedQueue;
+	}
+
 	return 1;
 }
 
+/* Creates a conversion and an immutable sampler for each multi-planar
+ * format the device can sample and copy. Formats without them are
+ * reported as unsupported, and apps fall back to separate R8 planes.
+ */
+static void VULKAN_INTERNAL_CreateYCbCrSamplers(
+	VulkanRenderer *renderer
+) {
+	const VkFormatFeatureFlags requiredFeatures = (
+		VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+		VK_FORMAT_FEATURE_TRANSFER_SRC_BIT |
+		VK_FORMAT_FEATURE_TRANSFER_DST_BIT
+	);
+	VkFormatProperties formatProperties;
+	VkPhysicalDeviceImageFormatInfo2 imageFormatInfo;
+	VkSamplerYcbcrConversionImageFormatProperties conversionFormatProperties;
+	VkImageFormatProperties2 imageFormatProperties;
+	VkSamplerYcbcrConversionCreateInfo conversionCreateInfo;
+	VkSamplerYcbcrConversionInfo conversionInfo;
+	VkSamplerCreateInfo samplerCreateInfo;
+	VkChromaLocation chromaLocation;
+	VkFilter chromaFilter;
+	VkResult vulkanResult;
+	uint32_t i;
+
+	for (i = 0; i < YCBCR_FORMAT_COUNT; i += 1)
+	{
+		renderer->ycbcrConversions[i] = VK_NULL_HANDLE;
+		renderer->ycbcrSamplers[i] = VK_NULL_HANDLE;
+		renderer->ycbcrDescriptorCounts[i] = 1;
+	}
+
+	if (!renderer->supports.KHR_sampler_ycbcr_conversion)
+	{
+		return;
+	}
+
+	for (i = 0; i < YCBCR_FORMAT_COUNT; i += 1)
+	{
+		renderer->vkGetPhysicalDeviceFormatProperties(
+			renderer->physicalDevice,
+			YCbCrFormats[i],
+			&formatProperties
+		);
+
+		if (	(formatProperties.optimalTilingFeatures & requiredFeatures) != requiredFeatures ||
+			!(formatProperties.optimalTilingFeatures & (VK_FORMAT_FEATURE_MIDPOINT_CHROMA_SAMPLES_BIT | VK_FORMAT_FEATURE_COSITED_CHROMA_SAMPLES_BIT))	)
+		{
+			continue;
+		}
+
+		/* Sets with these samplers may take more than one descriptor each */
+		imageFormatInfo.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2;
+		imageFormatInfo.pNext = NULL;
+		imageFormatInfo.format = YCbCrFormats[i];
+		imageFormatInfo.type = VK_IMAGE_TYPE_2D;
+		imageFormatInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageFormatInfo.usage = (
+			VK_IMAGE_USAGE_SAMPLED_BIT |
+			VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+			VK_IMAGE_USAGE_TRANSFER_DST_BIT
+		);
+		imageFormatInfo.flags = 0;
+
+		conversionFormatProperties.sType = VK_STRUCTURE_TYPE_SAMPLER_YCBCR_CONVERSION_IMAGE_FORMAT_PROPERTIES;
+		conversionFormatProperties.pNext = NULL;
+		conversionFormatProperties.combinedImageSamplerDescriptorCount = 1;
+
+		imageFormatProperties.sType = VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2;
+		imageFormatProperties.pNext = &conversionFormatProperties;
+
+		vulkanResult = renderer->vkGetPhysicalDeviceImageFormatProperties2KHR(
+			renderer->physicalDevice,
+			&imageFormatInfo,
+			&imageFormatProperties
+		);
+
+		if (vulkanResult != VK_SUCCESS)
+		{
+			continue;
+		}
+
+		/* Centered chroma like JPEG and Theora, if the device can do it */
+		if (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_MIDPOINT_CHROMA_SAMPLES_BIT)
+		{
+			chromaLocation = VK_CHROMA_LOCATION_MIDPOINT;
+		}
+		else
+		{
+			chromaLocation = VK_CHROMA_LOCATION_COSITED_EVEN;
+		}
+
+		if (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_YCBCR_CONVERSION_LINEAR_FILTER_BIT)
+		{
+			chromaFilter = VK_FILTER_LINEAR;
+		}
+		else
+		{
+			chromaFilter = VK_FILTER_NEAREST;
+		}
+
+		conversionCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_YCBCR_CONVERSION_CREATE_INFO;
+		conversionCreateInfo.pNext = NULL;
+		conversionCreateInfo.format = YCbCrFormats[i];
+		conversionCreateInfo.ycbcrModel = VK_SAMPLER_YCBCR_MODEL_CONVERSION_YCBCR_601;
+		conversionCreateInfo.ycbcrRange = VK_SAMPLER_YCBCR_RANGE_ITU_NARROW;
+		conversionCreateInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+		conversionCreateInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+		conversionCreateInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+		conversionCreateInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+		conversionCreateInfo.xChromaOffset = chromaLocation;
+		conversionCreateInfo.yChromaOffset = chromaLocation;
+		conversionCreateInfo.chromaFilter = chromaFilter;
+		conversionCreateInfo.forceExplicitReconstruction = VK_FALSE;
+
+		vulkanResult = renderer->vkCreateSamplerYcbcrConversionKHR(
+			renderer->logicalDevice,
+			&conversionCreateInfo,
+			NULL,
+			&renderer->ycbcrConversions[i]
+		);
+
+		if (vulkanResult != VK_SUCCESS)
+		{
+			LogVulkanResultAsError("vkCreateSamplerYcbcrConversionKHR", vulkanResult);
+			renderer->ycbcrConversions[i] = VK_NULL_HANDLE;
+			continue;
+		}
+
+		conversionInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_YCBCR_CONVERSION_INFO;
+		conversionInfo.pNext = NULL;
+		conversionInfo.conversion = renderer->ycbcrConversions[i];
+
+		/* Without separate reconstruction filters these must match chromaFilter */
+		samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerCreateInfo.pNext = &conversionInfo;
+		samplerCreateInfo.flags = 0;
+		samplerCreateInfo.magFilter = chromaFilter;
+		samplerCreateInfo.minFilter = chromaFilter;
+		samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.mipLodBias = 0.0f;
+		samplerCreateInfo.anisotropyEnable = VK_FALSE;
+		samplerCreateInfo.maxAnisotropy = 1.0f;
+		samplerCreateInfo.compareEnable = VK_FALSE;
+		samplerCreateInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+		samplerCreateInfo.minLod = 0.0f;
+		samplerCreateInfo.maxLod = 0.0f;
+		samplerCreateInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK;
+		samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+
+		vulkanResult = renderer->vkCreateSampler(
+			renderer->logicalDevice,
+			&samplerCreateInfo,
+			NULL,
+			&renderer->ycbcrSamplers[i]
+		);
+
+		if (vulkanResult != VK_SUCCESS)
+		{
+			LogVulkanResultAsError("vkCreateSampler", vulkanResult);
+			renderer->vkDestroySamplerYcbcrConversionKHR(
+				renderer->logicalDevice,
+				renderer->ycbcrConversions[i],
+				NULL
+			);
+			renderer->ycbcrConversions[i] = VK_NULL_HANDLE;
+			renderer->ycbcrSamplers[i] = VK_NULL_HANDLE;
+			continue;
+		}
+
+		renderer->ycbcrDescriptorCounts[i] = SDL_max(
+			1,
+			conversionFormatProperties.combinedImageSamplerDescriptorCount
+		);
+	}
+}
+
 static void VULKAN_INTERNAL_LoadEntryPoints(void)
 {
 	/* Required for MoltenVK support */
@@ -11771,9 +17839,11 @@ static Refresh_Device* VULKAN_CreateDevice(
 	/* Threading */
 
 	renderer->allocatorLock = SDL_CreateMutex();
+	renderer->bufferSlabLock = SDL_CreateMutex();
 	renderer->disposeLock = SDL_CreateMutex();
 	renderer->submitLock = SDL_CreateMutex();
 	renderer->acquireCommandBufferLock = SDL_CreateMutex();
+	renderer->pendingTransferLock = SDL_CreateMutex();
 	renderer->renderPassFetchLock = SDL_CreateMutex();
 	renderer->framebufferFetchLock = SDL_CreateMutex();
 	renderer->renderTargetFetchLock = SDL_CreateMutex();
@@ -11786,6 +17856,19 @@ static Refresh_Device* VULKAN_CreateDevice(
 	renderer->submittedCommandBufferCount = 0;
 	renderer->submittedCommandBuffers = SDL_malloc(sizeof(VulkanCommandBuffer*) * renderer->submittedCommandBufferCapacity);
 
+	/* Pending queue ownership transfers */
+
+	renderer->pendingTransferSemaphores = NULL;
+	renderer->pendingTransferSemaphoreCount = 0;
+	renderer->pendingTransferSemaphoreCapacity = 0;
+	renderer->pendingAcquireBufferBarriers = NULL;
+	renderer->pendingAcquireBufferBarrierCount = 0;
+	renderer->pendingAcquireBufferBarrierCapacity = 0;
+	renderer->pendingAcquireImageBarriers = NULL;
+	renderer->pendingAcquireImageBarrierCount = 0;
+	renderer->pendingAcquireImageBarrierCapacity = 0;
+	renderer->pendingAcquireStages = 0;
+
 	/* Memory Allocator */
 
 	renderer->memoryAllocator = (VulkanMemoryAllocator*) SDL_malloc(
@@ -11798,11 +17881,16 @@ static Refresh_Device* VULKAN_CreateDevice(
 		renderer->memoryAllocator->subAllocators[i].nextAllocationSize = STARTING_ALLOCATION_SIZE;
 		renderer->memoryAllocator->subAllocators[i].allocations = NULL;
 		renderer->memoryAllocator->subAllocators[i].allocationCount = 0;
-		renderer->memoryAllocator->subAllocators[i].sortedFreeRegions = SDL_malloc(
-			sizeof(VulkanMemoryFreeRegion*) * 4
-		);
-		renderer->memoryAllocator->subAllocators[i].sortedFreeRegionCount = 0;
-		renderer->memoryAllocator->subAllocators[i].sortedFreeRegionCapacity = 4;
+		renderer->memoryAllocator->subAllocators[i].freeListFirstLevelBitmask = 0;
+		SDL_zero(renderer->memoryAllocator->subAllocators[i].freeListSecondLevelBitmasks);
+		SDL_zero(renderer->memoryAllocator->subAllocators[i].freeLists);
+		renderer->memoryAllocator->subAllocators[i].freeRegionCount = 0;
+		renderer->memoryAllocator->subAllocators[i].transientBlocks = NULL;
+		renderer->memoryAllocator->subAllocators[i].transientBlockCount = 0;
+		renderer->memoryAllocator->subAllocators[i].currentTransientBlock = 0;
+		renderer->memoryAllocator->subAllocators[i].defragBytesMoved = 0;
+		renderer->memoryAllocator->subAllocators[i].defragResourcesMoved = 0;
+		renderer->memoryAllocator->subAllocators[i].lock = SDL_CreateMutex();
 	}
 
 	/* Set up UBO layouts */
@@ -12006,7 +18094,9 @@ static Refresh_Device* VULKAN_CreateDevice(
 		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 		0,
 		0,
-		1
+		0,
+		1,
+		0
 	);
 
 	renderer->dummyVertexUniformBuffer = VULKAN_INTERNAL_CreateDummyUniformBuffer(
@@ -12059,6 +18149,14 @@ static Refresh_Device* VULKAN_CreateDevice(
 		UNIFORM_BUFFER_COMPUTE
 	);
 
+	if (	renderer->vertexUniformBufferPool == NULL ||
+		renderer->fragmentUniformBufferPool == NULL ||
+		renderer->computeUniformBufferPool == NULL	)
+	{
+		Refresh_LogError("Failed to create uniform buffer pools!");
+		return NULL;
+	}
+
 	/* Initialize caches */
 
 	for (i = 0; i < NUM_COMMAND_POOL_BUCKETS; i += 1)
@@ -12123,7 +18221,9 @@ static Refresh_Device* VULKAN_CreateDevice(
 			VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 			1,
 			0,
-			1
+			0,
+			1,
+			0
 		);
 
 		if (transferBuffer->buffer == NULL)
@@ -12136,6 +18236,69 @@ static Refresh_Device* VULKAN_CreateDevice(
 		renderer->transferBufferPool.availableBufferCount += 1;
 	}
 
+	/* Initialize upload ring */
+
+	renderer->uploadRing.lock = SDL_CreateMutex();
+	renderer->uploadRing.buffer = NULL;
+	renderer->uploadRing.size = 0;
+	renderer->uploadRing.requestedSize = UPLOAD_RING_SIZE;
+	renderer->uploadRing.head = 0;
+	renderer->uploadRing.tail = 0;
+	renderer->uploadRing.rangeStart = 0;
+	renderer->uploadRing.rangeCount = 0;
+	renderer->uploadRing.rangeCapacity = 16;
+	renderer->uploadRing.ranges = SDL_malloc(
+		renderer->uploadRing.rangeCapacity * sizeof(VulkanUploadRingRange)
+	);
+
+	VULKAN_INTERNAL_RetireUploadRingRanges(renderer, NULL);
+
+	/* Initialize readback ring */
+
+	renderer->readbackRing.lock = SDL_CreateMutex();
+	renderer->readbackRing.head = 0;
+	renderer->readbackRing.tail = 0;
+	renderer->readbackRing.readbackStart = 0;
+	renderer->readbackRing.readbackCount = 0;
+	renderer->readbackRing.readbackCapacity = 16;
+	renderer->readbackRing.readbacks = SDL_malloc(
+		renderer->readbackRing.readbackCapacity * sizeof(VulkanReadback*)
+	);
+	renderer->readbackRing.dedicatedReadbackCount = 0;
+	renderer->readbackRing.dedicatedReadbackCapacity = 4;
+	renderer->readbackRing.dedicatedReadbacks = SDL_malloc(
+		renderer->readbackRing.dedicatedReadbackCapacity * sizeof(VulkanReadback*)
+	);
+
+	renderer->readbackWaiterCount = 0;
+	renderer->deferredReadbackFenceCount = 0;
+	renderer->deferredReadbackFenceCapacity = 4;
+	renderer->deferredReadbackFences = SDL_malloc(
+		renderer->deferredReadbackFenceCapacity * sizeof(VkFence)
+	);
+
+	renderer->readbackRing.buffer = VULKAN_INTERNAL_CreateBuffer(
+		renderer,
+		READBACK_RING_SIZE,
+		RESOURCE_ACCESS_TRANSFER_WRITE,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		1,
+		0,
+		1,
+		1,
+		0
+	);
+
+	if (renderer->readbackRing.buffer == NULL)
+	{
+		Refresh_LogWarn("Failed to allocate readback ring, falling back to dedicated buffers");
+		renderer->readbackRing.size = 0;
+	}
+	else
+	{
+		renderer->readbackRing.size = READBACK_RING_SIZE;
+	}
+
 	/* Initialize fence pool */
 
 	renderer->fencePool.lock = SDL_CreateMutex();
@@ -12186,6 +18349,10 @@ static Refresh_Device* VULKAN_CreateDevice(
 		renderer->D16S8Format = VK_FORMAT_D16_UNORM_S8_UINT;
 	}
 
+	/* Multi-planar formats, if the conversion extension was enabled */
+
+	VULKAN_INTERNAL_CreateYCbCrSamplers(renderer);
+
 	/* Deferred destroy storage */
 
 	renderer->texturesToDestroyCapacity = 16;
@@ -12246,6 +18413,39 @@ static Refresh_Device* VULKAN_CreateDevice(
 	renderer->needDefrag = 0;
 	renderer->defragTimestamp = 0;
 	renderer->defragInProgress = 0;
+	renderer->defragAllocation = NULL;
+	renderer->defragBytesPerSubmit = DEFRAG_BYTES_PER_SUBMIT;
+	renderer->defragResourcesPerSubmit = DEFRAG_RESOURCES_PER_SUBMIT;
+	renderer->defragBytesRemaining = 0;
+	renderer->defragResourcesRemaining = 0;
+	renderer->defragTotalBytesMoved = 0;
+	renderer->defragTotalResourcesMoved = 0;
+
+	renderer->retainedEmptyBlocksPerType = 0;
+	renderer->emptyBlockReleaseSubmits = 0;
+	renderer->emptyBlockReleaseMilliseconds = 0;
+	renderer->submitIndex = 0;
+
+	/* Buffer slabs */
+
+	for (i = 0; i < BUFFER_SLAB_CLASS_COUNT; i += 1)
+	{
+		renderer->bufferSlabs[i] = NULL;
+		renderer->bufferSlabCounts[i] = 0;
+	}
+
+	/* Memory budget */
+
+	for (i = 0; i < VK_MAX_MEMORY_HEAPS; i += 1)
+	{
+		renderer->heapAllocatedBytes[i] = 0;
+		renderer->memoryPressureLevels[i] = 0;
+	}
+	renderer->memoryPressureCallback = NULL;
+	renderer->memoryPressureUserdata = NULL;
+	renderer->memoryPressureThresholdCount = 0;
+
+	VULKAN_INTERNAL_QueryMemoryBudget(renderer);
 
 	return result;
 }